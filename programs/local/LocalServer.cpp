@@ -630,7 +630,13 @@ void LocalServer::processConfig()
         uncompressed_cache_size = max_cache_size;
         LOG_INFO(log, "Lowered uncompressed cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(uncompressed_cache_size));
     }
-    global_context->setUncompressedCache(uncompressed_cache_policy, uncompressed_cache_size, uncompressed_cache_size_ratio);
+    size_t compressed_block_cache_size = config().getUInt64("compressed_block_cache_size", 0);
+    if (compressed_block_cache_size > max_cache_size)
+    {
+        compressed_block_cache_size = max_cache_size;
+        LOG_INFO(log, "Lowered compressed block cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(compressed_block_cache_size));
+    }
+    global_context->setUncompressedCache(uncompressed_cache_policy, uncompressed_cache_size, uncompressed_cache_size_ratio, compressed_block_cache_size);
 
     String mark_cache_policy = config().getString("mark_cache_policy", DEFAULT_MARK_CACHE_POLICY);
     size_t mark_cache_size = config().getUInt64("mark_cache_size", DEFAULT_MARK_CACHE_MAX_SIZE);
@@ -664,6 +670,16 @@ void LocalServer::processConfig()
     }
     global_context->setIndexMarkCache(index_mark_cache_policy, index_mark_cache_size, index_mark_cache_size_ratio);
 
+    String skipping_index_result_cache_policy = config().getString("skipping_index_result_cache_policy", DEFAULT_SKIPPING_INDEX_RESULT_CACHE_POLICY);
+    size_t skipping_index_result_cache_size = config().getUInt64("skipping_index_result_cache_size", DEFAULT_SKIPPING_INDEX_RESULT_CACHE_MAX_SIZE);
+    double skipping_index_result_cache_size_ratio = config().getDouble("skipping_index_result_cache_size_ratio", DEFAULT_SKIPPING_INDEX_RESULT_CACHE_SIZE_RATIO);
+    if (skipping_index_result_cache_size > max_cache_size)
+    {
+        skipping_index_result_cache_size = max_cache_size;
+        LOG_INFO(log, "Lowered skipping index result cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(skipping_index_result_cache_size));
+    }
+    global_context->setSkippingIndexResultCache(skipping_index_result_cache_policy, skipping_index_result_cache_size, skipping_index_result_cache_size_ratio);
+
     size_t mmap_cache_size = config().getUInt64("mmap_cache_size", DEFAULT_MMAP_CACHE_MAX_SIZE);
     if (mmap_cache_size > max_cache_size)
     {
@@ -59,6 +59,7 @@
 #include <Interpreters/ServerAsynchronousMetrics.h>
 #include <Interpreters/DDLWorker.h>
 #include <Interpreters/DNSCacheUpdater.h>
+#include <Client/ReplicaHealthMonitor.h>
 #include <Interpreters/DatabaseCatalog.h>
 #include <Interpreters/ExternalDictionariesLoader.h>
 #include <Interpreters/ProcessList.h>
@@ -849,7 +850,8 @@ try
             for (const auto & server : servers)
                 metrics.emplace_back(ProtocolServerMetrics{server.getPortName(), server.currentThreads()});
             return metrics;
-        }
+        },
+        server_settings.memory_allocator_purge_rss_excess_ratio
     );
 
     /// NOTE: global context should be destroyed *before* GlobalThreadPool::shutdown()
@@ -1313,7 +1315,13 @@ try
         uncompressed_cache_size = max_cache_size;
         LOG_INFO(log, "Lowered uncompressed cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(uncompressed_cache_size));
     }
-    global_context->setUncompressedCache(uncompressed_cache_policy, uncompressed_cache_size, uncompressed_cache_size_ratio);
+    size_t compressed_block_cache_size = server_settings.compressed_block_cache_size;
+    if (compressed_block_cache_size > max_cache_size)
+    {
+        compressed_block_cache_size = max_cache_size;
+        LOG_INFO(log, "Lowered compressed block cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(compressed_block_cache_size));
+    }
+    global_context->setUncompressedCache(uncompressed_cache_policy, uncompressed_cache_size, uncompressed_cache_size_ratio, compressed_block_cache_size);
 
     String mark_cache_policy = server_settings.mark_cache_policy;
     size_t mark_cache_size = server_settings.mark_cache_size;
@@ -1352,6 +1360,36 @@ try
     }
     global_context->setIndexMarkCache(index_mark_cache_policy, index_mark_cache_size, index_mark_cache_size_ratio);
 
+    String skipping_index_result_cache_policy = server_settings.skipping_index_result_cache_policy;
+    size_t skipping_index_result_cache_size = server_settings.skipping_index_result_cache_size;
+    double skipping_index_result_cache_size_ratio = server_settings.skipping_index_result_cache_size_ratio;
+    if (skipping_index_result_cache_size > max_cache_size)
+    {
+        skipping_index_result_cache_size = max_cache_size;
+        LOG_INFO(log, "Lowered skipping index result cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(skipping_index_result_cache_size));
+    }
+    global_context->setSkippingIndexResultCache(skipping_index_result_cache_policy, skipping_index_result_cache_size, skipping_index_result_cache_size_ratio);
+
+    String filtered_granule_cache_policy = server_settings.filtered_granule_cache_policy;
+    size_t filtered_granule_cache_size = server_settings.filtered_granule_cache_size;
+    double filtered_granule_cache_size_ratio = server_settings.filtered_granule_cache_size_ratio;
+    if (filtered_granule_cache_size > max_cache_size)
+    {
+        filtered_granule_cache_size = max_cache_size;
+        LOG_INFO(log, "Lowered filtered granule cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(filtered_granule_cache_size));
+    }
+    global_context->setFilteredGranuleCache(filtered_granule_cache_policy, filtered_granule_cache_size, filtered_granule_cache_size_ratio);
+
+    String ann_index_cache_policy = server_settings.approximate_nearest_neighbor_index_cache_policy;
+    size_t ann_index_cache_size = server_settings.approximate_nearest_neighbor_index_cache_size;
+    double ann_index_cache_size_ratio = server_settings.approximate_nearest_neighbor_index_cache_size_ratio;
+    if (ann_index_cache_size > max_cache_size)
+    {
+        ann_index_cache_size = max_cache_size;
+        LOG_INFO(log, "Lowered approximate nearest neighbor index cache size to {} because the system has limited RAM", formatReadableSizeWithBinarySuffix(ann_index_cache_size));
+    }
+    global_context->setApproximateNearestNeighborIndexCache(ann_index_cache_policy, ann_index_cache_size, ann_index_cache_size_ratio);
+
     size_t mmap_cache_size = server_settings.mmap_cache_size;
     if (mmap_cache_size > max_cache_size)
     {
@@ -1452,6 +1490,20 @@ try
             total_memory_tracker.setDescription("(total)");
             total_memory_tracker.setMetric(CurrentMetrics::MemoryTracking);
 
+            double max_server_memory_usage_soft_limit_ratio = new_server_settings.max_server_memory_usage_soft_limit_ratio;
+            if (max_server_memory_usage_soft_limit_ratio > 0)
+            {
+                size_t soft_limit = static_cast<size_t>(max_server_memory_usage * max_server_memory_usage_soft_limit_ratio);
+                LOG_INFO(log, "Spillable operators will be asked to move data to disk above {}"
+                    " ({} max_server_memory_usage * {:.2f} max_server_memory_usage_soft_limit_ratio)",
+                    formatReadableSizeWithBinarySuffix(soft_limit),
+                    formatReadableSizeWithBinarySuffix(max_server_memory_usage),
+                    max_server_memory_usage_soft_limit_ratio);
+                total_memory_tracker.setSoftLimit(soft_limit);
+            }
+            else
+                total_memory_tracker.setSoftLimit(0);
+
             if (cgroups_memory_usage_observer)
             {
                 double hard_limit_ratio = new_server_settings.cgroup_memory_watcher_hard_limit_ratio;
@@ -1526,7 +1578,9 @@ try
                 concurrent_threads_soft_limit = new_server_settings.concurrent_threads_soft_limit_num;
             if (new_server_settings.concurrent_threads_soft_limit_ratio_to_cores > 0)
             {
-                auto value = new_server_settings.concurrent_threads_soft_limit_ratio_to_cores * std::thread::hardware_concurrency();
+                /// Use the core count limited by the cgroup CPU quota (re-read on every reload),
+                /// so the limit follows vertical scaling of a container.
+                auto value = new_server_settings.concurrent_threads_soft_limit_ratio_to_cores * getNumberOfPhysicalCPUCoresUncached();
                 if (value > 0 && value < concurrent_threads_soft_limit)
                     concurrent_threads_soft_limit = value;
             }
@@ -1550,6 +1604,7 @@ try
                 auto new_ratio = new_server_settings.background_merges_mutations_concurrency_ratio;
                 global_context->getMergeMutateExecutor()->increaseThreadsAndMaxTasksCount(new_pool_size, static_cast<size_t>(new_pool_size * new_ratio));
                 global_context->getMergeMutateExecutor()->updateSchedulingPolicy(new_server_settings.background_merges_mutations_scheduling_policy.toString());
+                global_context->getMergeMutateExecutor()->setConcurrencyLimit(new_server_settings.background_merges_mutations_concurrency_limit);
             }
 
             if (global_context->areBackgroundExecutorsInitialized())
@@ -1639,6 +1694,9 @@ try
             global_context->updateMarkCacheConfiguration(*config);
             global_context->updateIndexUncompressedCacheConfiguration(*config);
             global_context->updateIndexMarkCacheConfiguration(*config);
+            global_context->updateSkippingIndexResultCacheConfiguration(*config);
+            global_context->updateFilteredGranuleCacheConfiguration(*config);
+            global_context->updateApproximateNearestNeighborIndexCacheConfiguration(*config);
             global_context->updateMMappedFileCacheConfiguration(*config);
             global_context->updateQueryCacheConfiguration(*config);
 
@@ -1835,6 +1893,10 @@ try
     if (cgroups_memory_usage_observer)
     {
         cgroups_memory_usage_observer->setOnMemoryAmountAvailableChangedFn([&]() { main_config_reloader->reload(); });
+        /// Reloading the configuration recalculates limits that are derived from the number
+        /// of cores (e.g. concurrent_threads_soft_limit_ratio_to_cores), so thread pools
+        /// follow changes of the cgroup CPU quota at runtime.
+        cgroups_memory_usage_observer->setOnCPUAmountAvailableChangedFn([&]() { main_config_reloader->reload(); });
         cgroups_memory_usage_observer->startThread();
     }
 
@@ -1929,6 +1991,12 @@ try
     if (dns_cache_updater)
         dns_cache_updater->start();
 
+    /// Background TCP health probes of the replicas known to connection pools, so that
+    /// query dispatching does not discover dead replicas by timing out.
+    if (server_settings.replica_health_probe_period_sec)
+        ReplicaHealthMonitor::instance().start(
+            server_settings.replica_health_probe_period_sec, server_settings.replica_health_probe_connect_timeout_ms);
+
     /// Set current database name before loading tables and databases because
     /// system logs may copy global context.
     std::string default_database = server_settings.default_database.toString();
@@ -2192,6 +2260,7 @@ try
                 LOG_INFO(log, "Closed connections.");
 
             dns_cache_updater.reset();
+            ReplicaHealthMonitor::instance().shutdown();
 
             if (current_connections)
             {
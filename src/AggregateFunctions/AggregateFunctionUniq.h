@@ -11,6 +11,8 @@
 #include <IO/WriteHelpers.h>
 #include <IO/ReadHelpers.h>
 
+#include <Core/ProtocolDefines.h>
+
 #include <DataTypes/DataTypesNumber.h>
 #include <DataTypes/DataTypeTuple.h>
 
@@ -19,6 +21,7 @@
 #include <Common/CombinedCardinalityEstimator.h>
 #include <Common/HashTable/Hash.h>
 #include <Common/HashTable/HashSet.h>
+#include <Common/HashTable/Prefetching.h>
 #include <Common/HyperLogLogWithSmallSetOptimization.h>
 #include <Common/assert_cast.h>
 #include <Common/typeid_cast.h>
@@ -250,6 +253,15 @@ struct IsUniqExactSet<UniqExactSet<T1, T2>> : std::true_type
 {
 };
 
+template <typename Set>
+constexpr bool hasCompactSerialization()
+{
+    if constexpr (IsUniqExactSet<Set>::value)
+        return Set::has_compact_serialization;
+    else
+        return false;
+}
+
 
 /** Hash function for uniq.
   */
@@ -360,12 +372,41 @@ private:
     static void ALWAYS_INLINE
     addImpl(Data & data, const IColumn ** columns, size_t num_args, size_t row_begin, size_t row_end, const char8_t * flags, const UInt8 * null_map)
     {
+        /// For uniqExact over a plain column the key is the column value itself, so the hash
+        /// table cell of a row a few iterations ahead can be prefetched cheaply, the same way
+        /// the Aggregator does for GROUP BY states. For strings and variadic arguments the
+        /// key is an expensive hash of the row, computing it twice would negate the gain.
+        constexpr bool can_prefetch = std::is_same_v<Data, AggregateFunctionUniqExactData<T, Data::is_able_to_parallelize_merge>>
+            && !std::is_same_v<T, String> && !std::is_same_v<T, IPv6>;
+
         if (!flags)
         {
             if (!null_map)
             {
-                for (size_t row = row_begin; row < row_end; ++row)
-                    add<use_single_level_hash_table>(data, columns, num_args, row);
+                if constexpr (can_prefetch)
+                {
+                    const auto & keys = assert_cast<const ColumnVector<T> &>(*columns[0]).getData();
+
+                    /// During processing of row #i we prefetch the cell for row #(i + prefetch_look_ahead).
+                    PrefetchingHelper prefetching;
+                    size_t prefetch_look_ahead = PrefetchingHelper::getInitialLookAheadValue();
+
+                    for (size_t row = row_begin; row < row_end; ++row)
+                    {
+                        if (row == row_begin + PrefetchingHelper::iterationsToMeasure())
+                            prefetch_look_ahead = prefetching.calcPrefetchLookAhead();
+
+                        if (row + prefetch_look_ahead < row_end)
+                            data.set.template prefetch<const T &, use_single_level_hash_table>(keys[row + prefetch_look_ahead]);
+
+                        add<use_single_level_hash_table>(data, columns, num_args, row);
+                    }
+                }
+                else
+                {
+                    for (size_t row = row_begin; row < row_end; ++row)
+                        add<use_single_level_hash_table>(data, columns, num_args, row);
+                }
             }
             else
             {
@@ -405,6 +446,10 @@ private:
     static constexpr bool is_able_to_parallelize_merge = Data::is_able_to_parallelize_merge;
     static constexpr bool is_parallelize_merge_prepare_needed = Data::is_parallelize_merge_prepare_needed;
 
+    /// uniqExact over small enough keys supports the compact (sorted, delta-encoded)
+    /// serialization of the state, see UniqExactSet::writeCompact.
+    static constexpr bool has_compact_state = detail::hasCompactSerialization<DataSet>();
+
 public:
     explicit AggregateFunctionUniq(const DataTypes & argument_types_)
         : IAggregateFunctionDataHelper<Data, AggregateFunctionUniq<T, Data>>(argument_types_, {}, std::make_shared<DataTypeUInt64>())
@@ -493,13 +538,48 @@ public:
             this->data(place).set.merge(this->data(rhs).set);
     }
 
-    void serialize(ConstAggregateDataPtr __restrict place, WriteBuffer & buf, std::optional<size_t> /* version */) const override
+    bool isVersioned() const override { return has_compact_state; }
+
+    size_t getDefaultVersion() const override { return has_compact_state ? 1 : 0; }
+
+    size_t getVersionFromRevision(size_t revision) const override
     {
+        if (has_compact_state && revision >= DBMS_MIN_REVISION_WITH_UNIQ_EXACT_COMPACT_STATE)
+            return 1;
+        return 0;
+    }
+
+    void serialize(ConstAggregateDataPtr __restrict place, WriteBuffer & buf, std::optional<size_t> version) const override
+    {
+        if constexpr (has_compact_state)
+        {
+            if (!version)
+                version = getDefaultVersion();
+
+            if (*version >= 1)
+            {
+                this->data(place).set.writeCompact(buf);
+                return;
+            }
+        }
+
         this->data(place).set.write(buf);
     }
 
-    void deserialize(AggregateDataPtr __restrict place, ReadBuffer & buf, std::optional<size_t> /* version */, Arena *) const override
+    void deserialize(AggregateDataPtr __restrict place, ReadBuffer & buf, std::optional<size_t> version, Arena *) const override
     {
+        if constexpr (has_compact_state)
+        {
+            if (!version)
+                version = getDefaultVersion();
+
+            if (*version >= 1)
+            {
+                this->data(place).set.readCompact(buf);
+                return;
+            }
+        }
+
         this->data(place).set.read(buf);
     }
 
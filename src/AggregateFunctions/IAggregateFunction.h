@@ -612,8 +612,8 @@ public:
 
         size_t i = row_begin;
 
-        size_t size_unrolled = (row_end - row_begin) / UNROLL_COUNT * UNROLL_COUNT;
-        for (; i < size_unrolled; i += UNROLL_COUNT)
+        size_t unrolled_end = row_begin + (row_end - row_begin) / UNROLL_COUNT * UNROLL_COUNT;
+        for (; i < unrolled_end; i += UNROLL_COUNT)
         {
             AggregateDataPtr places[UNROLL_COUNT];
             for (size_t j = 0; j < UNROLL_COUNT; ++j)
@@ -763,8 +763,8 @@ public:
 
         /// Aggregate data into different lookup tables.
 
-        size_t size_unrolled = (row_end - row_begin) / UNROLL_COUNT * UNROLL_COUNT;
-        for (; i < size_unrolled; i += UNROLL_COUNT)
+        size_t unrolled_end = row_begin + (row_end - row_begin) / UNROLL_COUNT * UNROLL_COUNT;
+        for (; i < unrolled_end; i += UNROLL_COUNT)
         {
             for (size_t j = 0; j < UNROLL_COUNT; ++j)
             {
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <bit>
 #include <exception>
+#include <vector>
 #include <Common/CurrentThread.h>
 #include <Common/HashTable/HashSet.h>
 #include <Common/ThreadPool.h>
 #include <Common/scope_guard_safe.h>
 #include <Common/setThreadName.h>
+#include <Common/sort.h>
 
 
 namespace DB
@@ -34,6 +37,16 @@ public:
             asTwoLevel().insert(std::forward<Arg>(arg));
     }
 
+    /// Prefetch the cell where the key would be inserted, see HashTable::prefetch().
+    template <typename Arg, bool use_single_level_hash_table = true>
+    void ALWAYS_INLINE prefetch(Arg && arg) const
+    {
+        if constexpr (use_single_level_hash_table)
+            asSingleLevel().prefetch(std::forward<Arg>(arg));
+        else
+            asTwoLevel().prefetch(std::forward<Arg>(arg));
+    }
+
     /// In merge, if one of the lhs and rhs is twolevelset and the other is singlelevelset, then the singlelevelset will need to convertToTwoLevel().
     /// It's not in parallel and will cost extra large time if the thread_num is large.
     /// This method will convert all the SingleLevelSet to TwoLevelSet in parallel if the hashsets are not all singlelevel or not all twolevel.
@@ -201,6 +214,69 @@ public:
             asTwoLevel().writeAsSingleLevel(out);
     }
 
+    /// Whether the set can be written in the compact format (version 1 of uniqExact state).
+    static constexpr bool has_compact_serialization = sizeof(value_type) <= sizeof(UInt64);
+
+    /** Writes the set as a sorted sequence of keys, where each key is encoded as VarUInt
+      * delta to the previous one. Keys of real datasets are usually not uniformly spread
+      * over the whole range of the type, so after sorting the deltas are small and the
+      * representation is much more compact than raw keys.
+      */
+    void writeCompact(WriteBuffer & out) const
+    {
+        std::vector<UInt64> keys;
+        keys.reserve(size());
+
+        if (isSingleLevel())
+        {
+            for (const auto & x : asSingleLevel())
+                keys.push_back(keyToBits(x.getValue()));
+        }
+        else
+        {
+            for (const auto & x : asTwoLevel())
+                keys.push_back(keyToBits(x.getValue()));
+        }
+
+        ::sort(keys.begin(), keys.end());
+
+        writeVarUInt(keys.size(), out);
+
+        UInt64 prev = 0;
+        for (UInt64 key : keys)
+        {
+            writeVarUInt(key - prev, out);
+            prev = key;
+        }
+    }
+
+    void readCompact(ReadBuffer & in)
+    {
+        size_t new_size = 0;
+        readVarUInt(new_size, in);
+        if (new_size > 100'000'000'000)
+            throw DB::Exception(
+                DB::ErrorCodes::TOO_LARGE_ARRAY_SIZE, "The size of serialized hash table is suspiciously large: {}", new_size);
+
+        if (worthConvertingToTwoLevel(new_size))
+            two_level_set = std::make_shared<TwoLevelSet>(new_size);
+        else
+            asSingleLevel().reserve(new_size);
+
+        UInt64 prev = 0;
+        for (size_t i = 0; i < new_size; ++i)
+        {
+            UInt64 delta = 0;
+            readVarUInt(delta, in);
+            prev += delta;
+
+            if (isTwoLevel())
+                asTwoLevel().insert(keyFromBits(prev));
+            else
+                asSingleLevel().insert(keyFromBits(prev));
+        }
+    }
+
     size_t size() const { return isSingleLevel() ? asSingleLevel().size() : asTwoLevel().size(); }
 
     /// To convert set to two level before merging (we cannot just call convertToTwoLevel() on right hand side set, because it is declared const).
@@ -221,6 +297,31 @@ public:
     bool isTwoLevel() const { return !!two_level_set; }
 
 private:
+    /// The compact format treats keys as raw bits, the order of keys is not significant.
+    static UInt64 keyToBits(value_type key)
+    {
+        if constexpr (sizeof(value_type) == 1)
+            return std::bit_cast<UInt8>(key);
+        else if constexpr (sizeof(value_type) == 2)
+            return std::bit_cast<UInt16>(key);
+        else if constexpr (sizeof(value_type) == 4)
+            return std::bit_cast<UInt32>(key);
+        else
+            return std::bit_cast<UInt64>(key);
+    }
+
+    static value_type keyFromBits(UInt64 bits)
+    {
+        if constexpr (sizeof(value_type) == 1)
+            return std::bit_cast<value_type>(static_cast<UInt8>(bits));
+        else if constexpr (sizeof(value_type) == 2)
+            return std::bit_cast<value_type>(static_cast<UInt16>(bits));
+        else if constexpr (sizeof(value_type) == 4)
+            return std::bit_cast<value_type>(static_cast<UInt32>(bits));
+        else
+            return std::bit_cast<value_type>(bits);
+    }
+
     SingleLevelSet & asSingleLevel() { return single_level_set; }
     const SingleLevelSet & asSingleLevel() const { return single_level_set; }
 
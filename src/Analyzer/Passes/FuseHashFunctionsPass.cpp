@@ -0,0 +1,177 @@
+#include <Analyzer/Passes/FuseHashFunctionsPass.h>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include <Core/Field.h>
+
+#include <DataTypes/IDataType.h>
+
+#include <Functions/FunctionFactory.h>
+#include <Functions/fusedHashes.h>
+
+#include <Interpreters/Context.h>
+
+#include <Analyzer/ConstantNode.h>
+#include <Analyzer/FunctionNode.h>
+#include <Analyzer/HashUtils.h>
+#include <Analyzer/InDepthQueryTreeVisitor.h>
+
+namespace DB
+{
+
+namespace
+{
+
+/// The hash functions applied to one argument. The indices are 1-based,
+/// matching the element positions of the tuple returned by fusedHashes.
+struct HashFunctionsGroup
+{
+    Array function_names;
+    std::unordered_map<String, UInt64> function_name_to_index;
+};
+
+using HashFunctionsGroups = QueryTreeNodePtrWithHashMap<HashFunctionsGroup>;
+
+/// Returns the name of a fusable hash function call, or nothing if the node is not such a call.
+/// fusedHashes computes the hashes of raw string data, so only single String/FixedString
+/// arguments are fused: hashes of other types and of multiple arguments go through
+/// per-type serialization and hash combining that fusedHashes does not reproduce.
+std::optional<String> getFusableHashFunctionName(const FunctionNode & function_node)
+{
+    const auto & function_name = function_node.getFunctionName();
+    if (!isFusableHashFunction(function_name))
+        return {};
+
+    const auto & arguments = function_node.getArguments().getNodes();
+    if (arguments.size() != 1)
+        return {};
+
+    if (!isStringOrFixedString(arguments[0]->getResultType()))
+        return {};
+
+    return function_name;
+}
+
+class CollectHashFunctionsVisitor : public InDepthQueryTreeVisitorWithContext<CollectHashFunctionsVisitor>
+{
+public:
+    using Base = InDepthQueryTreeVisitorWithContext<CollectHashFunctionsVisitor>;
+    using Base::Base;
+
+    explicit CollectHashFunctionsVisitor(HashFunctionsGroups & groups_, ContextPtr context)
+        : Base(std::move(context))
+        , groups(groups_)
+    {}
+
+    bool needChildVisit(VisitQueryTreeNodeType &, VisitQueryTreeNodeType &)
+    {
+        return getSettings().optimize_fuse_hash_functions;
+    }
+
+    void enterImpl(QueryTreeNodePtr & node)
+    {
+        auto * function_node = node->as<FunctionNode>();
+        if (!function_node)
+            return;
+
+        auto function_name = getFusableHashFunctionName(*function_node);
+        if (!function_name)
+            return;
+
+        auto & group = groups[function_node->getArguments().getNodes()[0]];
+
+        auto [it, inserted] = group.function_name_to_index.emplace(*function_name, group.function_names.size() + 1);
+        if (inserted)
+            group.function_names.push_back(std::move(*function_name));
+    }
+
+private:
+    HashFunctionsGroups & groups;
+};
+
+class FuseHashFunctionsVisitor : public InDepthQueryTreeVisitorWithContext<FuseHashFunctionsVisitor>
+{
+public:
+    using Base = InDepthQueryTreeVisitorWithContext<FuseHashFunctionsVisitor>;
+    using Base::Base;
+
+    explicit FuseHashFunctionsVisitor(const HashFunctionsGroups & groups_,
+        FunctionOverloadResolverPtr fused_hashes_function_resolver_,
+        FunctionOverloadResolverPtr tuple_element_function_resolver_,
+        ContextPtr context)
+        : Base(std::move(context))
+        , groups(groups_)
+        , fused_hashes_function_resolver(std::move(fused_hashes_function_resolver_))
+        , tuple_element_function_resolver(std::move(tuple_element_function_resolver_))
+    {}
+
+    bool needChildVisit(VisitQueryTreeNodeType &, VisitQueryTreeNodeType &)
+    {
+        return getSettings().optimize_fuse_hash_functions;
+    }
+
+    void enterImpl(QueryTreeNodePtr & node)
+    {
+        auto * function_node = node->as<FunctionNode>();
+        if (!function_node)
+            return;
+
+        auto function_name = getFusableHashFunctionName(*function_node);
+        if (!function_name)
+            return;
+
+        const auto & argument = function_node->getArguments().getNodes()[0];
+
+        auto it = groups.find(argument);
+        if (it == groups.end())
+            return;
+
+        const auto & group = it->second;
+
+        /// A lone hash function gains nothing from the rewrite.
+        if (group.function_names.size() < 2)
+            return;
+
+        auto fused_hashes_function = std::make_shared<FunctionNode>("fusedHashes");
+        auto & fused_hashes_arguments = fused_hashes_function->getArguments().getNodes();
+        fused_hashes_arguments.push_back(argument);
+        fused_hashes_arguments.push_back(std::make_shared<ConstantNode>(Field{group.function_names}));
+        fused_hashes_function->resolveAsFunction(fused_hashes_function_resolver);
+
+        auto tuple_element_function = std::make_shared<FunctionNode>("tupleElement");
+        auto & tuple_element_arguments = tuple_element_function->getArguments().getNodes();
+        tuple_element_arguments.push_back(std::move(fused_hashes_function));
+        tuple_element_arguments.push_back(std::make_shared<ConstantNode>(group.function_name_to_index.at(*function_name)));
+        tuple_element_function->resolveAsFunction(tuple_element_function_resolver->build(tuple_element_function->getArgumentColumns()));
+
+        node = std::move(tuple_element_function);
+    }
+
+private:
+    const HashFunctionsGroups & groups;
+    const FunctionOverloadResolverPtr fused_hashes_function_resolver;
+    const FunctionOverloadResolverPtr tuple_element_function_resolver;
+};
+
+}
+
+void FuseHashFunctionsPass::run(QueryTreeNodePtr & query_tree_node, ContextPtr context)
+{
+    HashFunctionsGroups groups;
+
+    CollectHashFunctionsVisitor collect_visitor(groups, context);
+    collect_visitor.visit(query_tree_node);
+
+    if (groups.empty())
+        return;
+
+    auto fused_hashes_function_resolver = createInternalFusedHashesOverloadResolver();
+    auto tuple_element_function_resolver = FunctionFactory::instance().get("tupleElement", context);
+
+    FuseHashFunctionsVisitor visitor(groups, std::move(fused_hashes_function_resolver), std::move(tuple_element_function_resolver), std::move(context));
+    visitor.visit(query_tree_node);
+}
+
+}
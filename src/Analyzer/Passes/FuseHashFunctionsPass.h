@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Analyzer/IQueryTreePass.h>
+
+namespace DB
+{
+
+/** Fuses multiple 64-bit hash functions applied to the same argument into a single fusedHashes call.
+  *
+  * Example: SELECT cityHash64(s), sipHash64(s), xxHash64(s) FROM t;
+  * Result: SELECT tupleElement(fusedHashes(s, ['cityHash64', 'sipHash64', 'xxHash64']), 1), ... FROM t;
+  *
+  * The identical fusedHashes nodes are collapsed into a single actions DAG node,
+  * so all the hashes are computed in one pass over the data.
+  */
+class FuseHashFunctionsPass final : public IQueryTreePass
+{
+public:
+    String getName() override { return "FuseHashFunctions"; }
+
+    String getDescription() override { return "Fuses multiple 64-bit hash functions applied to the same argument into a single fusedHashes call"; }
+
+    void run(QueryTreeNodePtr & query_tree_node, ContextPtr context) override;
+};
+
+}
@@ -0,0 +1,190 @@
+#include <Analyzer/Passes/FuseJSONExtractPass.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <Core/Field.h>
+
+#include <DataTypes/IDataType.h>
+
+#include <Functions/FunctionFactory.h>
+#include <Functions/fusedJSONExtract.h>
+
+#include <Interpreters/Context.h>
+
+#include <Analyzer/ConstantNode.h>
+#include <Analyzer/FunctionNode.h>
+#include <Analyzer/HashUtils.h>
+#include <Analyzer/InDepthQueryTreeVisitor.h>
+
+namespace DB
+{
+
+namespace
+{
+
+/// An extraction is a (function name, key) pair, e.g. ("JSONExtractString", "a").
+using Extraction = std::pair<String, String>;
+
+/// The extractions applied to one document. The indices are 1-based,
+/// matching the element positions of the tuple returned by fusedJSONExtract.
+struct JSONExtractGroup
+{
+    std::vector<Extraction> extractions;
+    std::map<Extraction, UInt64> extraction_to_index;
+};
+
+using JSONExtractGroups = QueryTreeNodePtrWithHashMap<JSONExtractGroup>;
+
+/// Returns the extraction performed by a fusable JSON function call, or nothing if the node is not
+/// such a call. Only single-key extractions from a plain String document are fused: Nullable and
+/// LowCardinality documents go through the special null and dictionary handling of the standalone
+/// functions that fusedJSONExtract does not reproduce.
+std::optional<Extraction> getFusableExtraction(const FunctionNode & function_node)
+{
+    const auto & function_name = function_node.getFunctionName();
+    if (!isFusableJSONExtractFunction(function_name))
+        return {};
+
+    const auto & arguments = function_node.getArguments().getNodes();
+    if (arguments.size() != 2)
+        return {};
+
+    if (!isString(arguments[0]->getResultType()))
+        return {};
+
+    const auto * key = arguments[1]->as<ConstantNode>();
+    if (!key || !isString(key->getResultType()))
+        return {};
+
+    return Extraction{function_name, key->getValue().get<String>()};
+}
+
+class CollectJSONExtractFunctionsVisitor : public InDepthQueryTreeVisitorWithContext<CollectJSONExtractFunctionsVisitor>
+{
+public:
+    using Base = InDepthQueryTreeVisitorWithContext<CollectJSONExtractFunctionsVisitor>;
+    using Base::Base;
+
+    explicit CollectJSONExtractFunctionsVisitor(JSONExtractGroups & groups_, ContextPtr context)
+        : Base(std::move(context))
+        , groups(groups_)
+    {}
+
+    bool needChildVisit(VisitQueryTreeNodeType &, VisitQueryTreeNodeType &)
+    {
+        return getSettings().optimize_fuse_json_extract_functions;
+    }
+
+    void enterImpl(QueryTreeNodePtr & node)
+    {
+        auto * function_node = node->as<FunctionNode>();
+        if (!function_node)
+            return;
+
+        auto extraction = getFusableExtraction(*function_node);
+        if (!extraction)
+            return;
+
+        auto & group = groups[function_node->getArguments().getNodes()[0]];
+
+        auto [it, inserted] = group.extraction_to_index.emplace(*extraction, group.extractions.size() + 1);
+        if (inserted)
+            group.extractions.push_back(std::move(*extraction));
+    }
+
+private:
+    JSONExtractGroups & groups;
+};
+
+class FuseJSONExtractVisitor : public InDepthQueryTreeVisitorWithContext<FuseJSONExtractVisitor>
+{
+public:
+    using Base = InDepthQueryTreeVisitorWithContext<FuseJSONExtractVisitor>;
+    using Base::Base;
+
+    explicit FuseJSONExtractVisitor(const JSONExtractGroups & groups_,
+        FunctionOverloadResolverPtr fused_json_extract_function_resolver_,
+        FunctionOverloadResolverPtr tuple_element_function_resolver_,
+        ContextPtr context)
+        : Base(std::move(context))
+        , groups(groups_)
+        , fused_json_extract_function_resolver(std::move(fused_json_extract_function_resolver_))
+        , tuple_element_function_resolver(std::move(tuple_element_function_resolver_))
+    {}
+
+    bool needChildVisit(VisitQueryTreeNodeType &, VisitQueryTreeNodeType &)
+    {
+        return getSettings().optimize_fuse_json_extract_functions;
+    }
+
+    void enterImpl(QueryTreeNodePtr & node)
+    {
+        auto * function_node = node->as<FunctionNode>();
+        if (!function_node)
+            return;
+
+        auto extraction = getFusableExtraction(*function_node);
+        if (!extraction)
+            return;
+
+        const auto & argument = function_node->getArguments().getNodes()[0];
+
+        auto it = groups.find(argument);
+        if (it == groups.end())
+            return;
+
+        const auto & group = it->second;
+
+        /// A lone extraction gains nothing from the rewrite.
+        if (group.extractions.size() < 2)
+            return;
+
+        auto fused_json_extract_function = std::make_shared<FunctionNode>("fusedJSONExtract");
+        auto & fused_json_extract_arguments = fused_json_extract_function->getArguments().getNodes();
+        fused_json_extract_arguments.push_back(argument);
+        for (const auto & group_extraction : group.extractions)
+        {
+            fused_json_extract_arguments.push_back(std::make_shared<ConstantNode>(group_extraction.first));
+            fused_json_extract_arguments.push_back(std::make_shared<ConstantNode>(group_extraction.second));
+        }
+        fused_json_extract_function->resolveAsFunction(fused_json_extract_function_resolver);
+
+        auto tuple_element_function = std::make_shared<FunctionNode>("tupleElement");
+        auto & tuple_element_arguments = tuple_element_function->getArguments().getNodes();
+        tuple_element_arguments.push_back(std::move(fused_json_extract_function));
+        tuple_element_arguments.push_back(std::make_shared<ConstantNode>(group.extraction_to_index.at(*extraction)));
+        tuple_element_function->resolveAsFunction(tuple_element_function_resolver->build(tuple_element_function->getArgumentColumns()));
+
+        node = std::move(tuple_element_function);
+    }
+
+private:
+    const JSONExtractGroups & groups;
+    const FunctionOverloadResolverPtr fused_json_extract_function_resolver;
+    const FunctionOverloadResolverPtr tuple_element_function_resolver;
+};
+
+}
+
+void FuseJSONExtractPass::run(QueryTreeNodePtr & query_tree_node, ContextPtr context)
+{
+    JSONExtractGroups groups;
+
+    CollectJSONExtractFunctionsVisitor collect_visitor(groups, context);
+    collect_visitor.visit(query_tree_node);
+
+    if (groups.empty())
+        return;
+
+    auto fused_json_extract_function_resolver = createInternalFusedJSONExtractOverloadResolver(context->getSettingsRef().allow_simdjson);
+    auto tuple_element_function_resolver = FunctionFactory::instance().get("tupleElement", context);
+
+    FuseJSONExtractVisitor visitor(groups, std::move(fused_json_extract_function_resolver), std::move(tuple_element_function_resolver), std::move(context));
+    visitor.visit(query_tree_node);
+}
+
+}
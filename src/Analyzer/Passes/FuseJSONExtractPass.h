@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Analyzer/IQueryTreePass.h>
+
+namespace DB
+{
+
+/** Fuses multiple single-key JSON extraction functions applied to the same document into a single
+  * fusedJSONExtract call.
+  *
+  * Example: SELECT JSONExtractString(json, 'a'), JSONExtractInt(json, 'b') FROM t;
+  * Result: SELECT tupleElement(fusedJSONExtract(json, 'JSONExtractString', 'a', 'JSONExtractInt', 'b'), 1), ... FROM t;
+  *
+  * The identical fusedJSONExtract nodes are collapsed into a single actions DAG node,
+  * so every document is parsed once instead of once per extracted field.
+  */
+class FuseJSONExtractPass final : public IQueryTreePass
+{
+public:
+    String getName() override { return "FuseJSONExtract"; }
+
+    String getDescription() override { return "Fuses multiple single-key JSON extraction functions applied to the same document into a single fusedJSONExtract call"; }
+
+    void run(QueryTreeNodePtr & query_tree_node, ContextPtr context) override;
+};
+
+}
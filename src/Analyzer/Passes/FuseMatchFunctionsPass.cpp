@@ -0,0 +1,207 @@
+#include <Analyzer/Passes/FuseMatchFunctionsPass.h>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include <Common/likePatternToRegexp.h>
+
+#include <Core/Field.h>
+
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypeNullable.h>
+
+#include <Functions/FunctionFactory.h>
+#include <Functions/multiMatchAllIndices.h>
+#include <Functions/array/has.h>
+
+#include <Interpreters/Context.h>
+
+#include <Analyzer/ConstantNode.h>
+#include <Analyzer/FunctionNode.h>
+#include <Analyzer/HashUtils.h>
+#include <Analyzer/InDepthQueryTreeVisitor.h>
+
+namespace DB
+{
+
+namespace
+{
+
+/// The regular expressions applied to one haystack. The indices are 1-based,
+/// matching the pattern ids reported by multiMatchAllIndices.
+struct RegexpGroup
+{
+    Array patterns;
+    std::unordered_map<String, UInt64> pattern_to_index;
+};
+
+using RegexpGroups = QueryTreeNodePtrWithHashMap<RegexpGroup>;
+
+/// Returns the regexp of a match/{i}like predicate with a constant pattern, or nothing if the node is not such a predicate.
+std::optional<String> getPredicateRegexp(const FunctionNode & function_node)
+{
+    const auto & function_name = function_node.getFunctionName();
+
+    const bool is_match = function_name == "match";
+    const bool is_like  = function_name == "like";
+    const bool is_ilike = function_name == "ilike";
+
+    if (!is_match && !is_like && !is_ilike)
+        return {};
+
+    const auto & arguments = function_node.getArguments().getNodes();
+    if (arguments.size() != 2)
+        return {};
+
+    /// multiMatchAllIndices accepts only String haystacks.
+    if (!isString(removeNullable(removeLowCardinality(arguments[0]->getResultType()))))
+        return {};
+
+    const auto * pattern = arguments[1]->as<ConstantNode>();
+    if (!pattern || !isString(pattern->getResultType()))
+        return {};
+
+    if (is_match)
+        return pattern->getValue().get<String>();
+
+    auto regexp = likePatternToRegexp(pattern->getValue().get<String>());
+    /// Case insensitive. Works with UTF-8 as well.
+    if (is_ilike)
+        regexp = "(?i)" + regexp;
+
+    return regexp;
+}
+
+class CollectMatchFunctionsVisitor : public InDepthQueryTreeVisitorWithContext<CollectMatchFunctionsVisitor>
+{
+public:
+    using Base = InDepthQueryTreeVisitorWithContext<CollectMatchFunctionsVisitor>;
+    using Base::Base;
+
+    explicit CollectMatchFunctionsVisitor(RegexpGroups & regexp_groups_, ContextPtr context)
+        : Base(std::move(context))
+        , regexp_groups(regexp_groups_)
+    {}
+
+    bool needChildVisit(VisitQueryTreeNodeType &, VisitQueryTreeNodeType &)
+    {
+        const auto & settings = getSettings();
+
+        return settings.optimize_fuse_match_functions
+            && settings.allow_hyperscan
+            && settings.max_hyperscan_regexp_length == 0
+            && settings.max_hyperscan_regexp_total_length == 0;
+    }
+
+    void enterImpl(QueryTreeNodePtr & node)
+    {
+        auto * function_node = node->as<FunctionNode>();
+        if (!function_node)
+            return;
+
+        auto regexp = getPredicateRegexp(*function_node);
+        if (!regexp)
+            return;
+
+        auto & group = regexp_groups[function_node->getArguments().getNodes()[0]];
+
+        auto [it, inserted] = group.pattern_to_index.emplace(*regexp, group.patterns.size() + 1);
+        if (inserted)
+            group.patterns.push_back(std::move(*regexp));
+    }
+
+private:
+    RegexpGroups & regexp_groups;
+};
+
+class FuseMatchFunctionsVisitor : public InDepthQueryTreeVisitorWithContext<FuseMatchFunctionsVisitor>
+{
+public:
+    using Base = InDepthQueryTreeVisitorWithContext<FuseMatchFunctionsVisitor>;
+    using Base::Base;
+
+    explicit FuseMatchFunctionsVisitor(const RegexpGroups & regexp_groups_,
+        FunctionOverloadResolverPtr multi_match_function_resolver_,
+        FunctionOverloadResolverPtr has_function_resolver_,
+        ContextPtr context)
+        : Base(std::move(context))
+        , regexp_groups(regexp_groups_)
+        , multi_match_function_resolver(std::move(multi_match_function_resolver_))
+        , has_function_resolver(std::move(has_function_resolver_))
+    {}
+
+    bool needChildVisit(VisitQueryTreeNodeType &, VisitQueryTreeNodeType &)
+    {
+        const auto & settings = getSettings();
+
+        return settings.optimize_fuse_match_functions
+            && settings.allow_hyperscan
+            && settings.max_hyperscan_regexp_length == 0
+            && settings.max_hyperscan_regexp_total_length == 0;
+    }
+
+    void enterImpl(QueryTreeNodePtr & node)
+    {
+        auto * function_node = node->as<FunctionNode>();
+        if (!function_node)
+            return;
+
+        auto regexp = getPredicateRegexp(*function_node);
+        if (!regexp)
+            return;
+
+        const auto & haystack = function_node->getArguments().getNodes()[0];
+
+        auto it = regexp_groups.find(haystack);
+        if (it == regexp_groups.end())
+            return;
+
+        const auto & group = it->second;
+
+        /// A lone pattern is left as is: identical `match` nodes are already collapsed by the actions DAG.
+        if (group.patterns.size() < 2)
+            return;
+
+        auto multi_match_function = std::make_shared<FunctionNode>("multiMatchAllIndices");
+        auto & multi_match_arguments = multi_match_function->getArguments().getNodes();
+        multi_match_arguments.push_back(haystack);
+        multi_match_arguments.push_back(std::make_shared<ConstantNode>(Field{group.patterns}));
+        multi_match_function->resolveAsFunction(multi_match_function_resolver);
+
+        auto has_function = std::make_shared<FunctionNode>("has");
+        auto & has_arguments = has_function->getArguments().getNodes();
+        has_arguments.push_back(std::move(multi_match_function));
+        has_arguments.push_back(std::make_shared<ConstantNode>(group.pattern_to_index.at(*regexp)));
+        has_function->resolveAsFunction(has_function_resolver->build(has_function->getArgumentColumns()));
+
+        node = std::move(has_function);
+    }
+
+private:
+    const RegexpGroups & regexp_groups;
+    const FunctionOverloadResolverPtr multi_match_function_resolver;
+    const FunctionOverloadResolverPtr has_function_resolver;
+};
+
+}
+
+void FuseMatchFunctionsPass::run(QueryTreeNodePtr & query_tree_node, ContextPtr context)
+{
+    RegexpGroups regexp_groups;
+
+    CollectMatchFunctionsVisitor collect_visitor(regexp_groups, context);
+    collect_visitor.visit(query_tree_node);
+
+    if (regexp_groups.empty())
+        return;
+
+    const auto & settings = context->getSettingsRef();
+    auto multi_match_function_resolver = createInternalMultiMatchAllIndicesOverloadResolver(settings.allow_hyperscan, settings.max_hyperscan_regexp_length, settings.max_hyperscan_regexp_total_length, settings.reject_expensive_hyperscan_regexps);
+    auto has_function_resolver = createInternalFunctionHasOverloadResolver();
+
+    FuseMatchFunctionsVisitor visitor(regexp_groups, std::move(multi_match_function_resolver), std::move(has_function_resolver), std::move(context));
+    visitor.visit(query_tree_node);
+}
+
+}
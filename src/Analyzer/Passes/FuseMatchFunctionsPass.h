@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Analyzer/IQueryTreePass.h>
+
+namespace DB
+{
+
+/** Fuses multiple match/{i}like predicates over the same column into a single multiMatchAllIndices scan.
+  *
+  * Example: SELECT match(s, 'a.c'), match(s, 'x+y') FROM t;
+  * Result: SELECT has(multiMatchAllIndices(s, ['a.c', 'x+y']), 1), has(multiMatchAllIndices(s, ['a.c', 'x+y']), 2) FROM t;
+  *
+  * All the regular expressions are compiled into one shared vectorscan database and the data
+  * is scanned once per block; the identical multiMatchAllIndices nodes are collapsed into
+  * a single actions DAG node, and the cheap `has` calls fan the result out to the predicates.
+  */
+class FuseMatchFunctionsPass final : public IQueryTreePass
+{
+public:
+    String getName() override { return "FuseMatchFunctions"; }
+
+    String getDescription() override { return "Fuses multiple match/{i}like predicates over the same column into a single multiMatchAllIndices scan"; }
+
+    void run(QueryTreeNodePtr & query_tree_node, ContextPtr context) override;
+};
+
+}
@@ -60,6 +60,9 @@ public:
                 {
                     if (isRedundantExpression(order_by_expr))
                         continue;
+                    /// A kept sort expression is itself a key: rows reaching any later key are
+                    /// already equal on it, so deterministic functions of it are redundant too.
+                    existing_keys.insert(order_by_expr);
                     break;
                 }
                 case QueryTreeNodeType::COLUMN:
@@ -90,7 +93,11 @@ private:
             auto node = nodes_to_process.back();
             nodes_to_process.pop_back();
 
-            // TODO: handle constants here
+            /// A subexpression that is an earlier sort key needs no expansion:
+            /// its value is fixed within every group of rows the later keys may reorder.
+            if (existing_keys.contains(node))
+                continue;
+
             switch (node->getNodeType())
             {
                 case QueryTreeNodeType::FUNCTION:
@@ -110,8 +117,11 @@ private:
                 }
                 case QueryTreeNodeType::COLUMN:
                 {
-                    if (!existing_keys.contains(node))
-                        return false;
+                    /// Not an earlier sort key (checked above).
+                    return false;
+                }
+                case QueryTreeNodeType::CONSTANT:
+                {
                     break;
                 }
                 default:
@@ -0,0 +1,161 @@
+#include <Analyzer/QueryTreeCache.h>
+
+#include <Analyzer/ConstantNode.h>
+#include <Analyzer/TableNode.h>
+#include <Common/SipHash.h>
+#include <Core/Settings.h>
+#include <Core/UUID.h>
+#include <Interpreters/Context.h>
+#include <Interpreters/DatabaseCatalog.h>
+#include <Parsers/IAST.h>
+#include <Storages/IStorage.h>
+
+namespace DB
+{
+
+namespace
+{
+
+/// Collect the table nodes of the tree. Returns false if the tree is not cacheable:
+/// it reads from a table function, or contains a constant folded from an expression
+/// (e.g. an evaluated scalar subquery) which may produce a different value on the next run.
+bool collectTableNodes(const QueryTreeNodePtr & node, QueryTreeNodes & table_nodes)
+{
+    if (!node)
+        return true;
+
+    switch (node->getNodeType())
+    {
+        case QueryTreeNodeType::TABLE:
+        {
+            table_nodes.push_back(node);
+            break;
+        }
+        case QueryTreeNodeType::TABLE_FUNCTION:
+        {
+            return false;
+        }
+        case QueryTreeNodeType::CONSTANT:
+        {
+            if (node->as<ConstantNode>()->hasSourceExpression())
+                return false;
+            break;
+        }
+        default:
+            break;
+    }
+
+    for (const auto & child : node->getChildren())
+        if (!collectTableNodes(child, table_nodes))
+            return false;
+
+    return true;
+}
+
+}
+
+QueryTreeCache::QueryTreeCache(size_t max_entries)
+    : cache(max_entries, max_entries)
+{
+}
+
+QueryTreeCache::Key QueryTreeCache::makeKey(const ASTPtr & query, const ContextPtr & context)
+{
+    SipHash hash;
+
+    const auto ast_hash = query->getTreeHash(/*ignore_aliases=*/ false);
+    hash.update(ast_hash.low64);
+    hash.update(ast_hash.high64);
+
+    hash.update(context->getCurrentDatabase());
+
+    if (const auto user_id = context->getUserID())
+    {
+        hash.update(UUIDHelpers::getHighBytes(*user_id));
+        hash.update(UUIDHelpers::getLowBytes(*user_id));
+    }
+
+    for (const auto & role : context->getCurrentRoles())
+    {
+        hash.update(UUIDHelpers::getHighBytes(role));
+        hash.update(UUIDHelpers::getLowBytes(role));
+    }
+
+    /// Analyzer passes shape the tree and its result types based on settings (e.g.
+    /// group_by_use_nulls or transform_null_in), so trees analyzed under different
+    /// settings must not be shared. Hash the changed settings; allChanged() returns
+    /// them in random order, so sort first. The cache's own toggle is skipped: it does
+    /// not affect analysis.
+    std::vector<std::pair<String, String>> changed_settings;
+    for (const auto & setting : context->getSettingsRef().allChanged())
+    {
+        const String & name = setting.getName();
+        if (name != "use_query_tree_cache")
+            changed_settings.emplace_back(name, setting.getValueString());
+    }
+    std::sort(changed_settings.begin(), changed_settings.end());
+    for (const auto & [name, value] : changed_settings)
+    {
+        hash.update(name);
+        hash.update(value);
+    }
+
+    return hash.get128();
+}
+
+QueryTreeNodePtr QueryTreeCache::find(const Key & key, const ContextPtr & context)
+{
+    auto entry = cache.get(key);
+    if (!entry)
+        return nullptr;
+
+    auto query_tree = entry->query_tree->clone();
+
+    QueryTreeNodes table_nodes;
+    collectTableNodes(query_tree, table_nodes);
+
+    for (auto & node : table_nodes)
+    {
+        auto & table_node = node->as<TableNode &>();
+
+        auto table = DatabaseCatalog::instance().tryGetTable(table_node.getStorageID(), context);
+        auto it = entry->table_metadata.find(table_node.getStorageID().getFullNameNotQuoted());
+
+        if (!table || it == entry->table_metadata.end() || table->getInMemoryMetadataPtr() != it->second)
+        {
+            /// The table was dropped, renamed or altered, the tree has to be analyzed from scratch.
+            cache.remove(key);
+            return nullptr;
+        }
+
+        table_node.updateStorage(std::move(table), context);
+    }
+
+    return query_tree;
+}
+
+void QueryTreeCache::add(const Key & key, const QueryTreeNodePtr & query_tree)
+{
+    {
+        QueryTreeNodes table_nodes;
+        if (!collectTableNodes(query_tree, table_nodes))
+            return;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->query_tree = query_tree->clone();
+
+    QueryTreeNodes table_nodes;
+    collectTableNodes(entry->query_tree, table_nodes);
+
+    for (auto & node : table_nodes)
+    {
+        auto & table_node = node->as<TableNode &>();
+        entry->table_metadata[table_node.getStorageID().getFullNameNotQuoted()] = table_node.getStorage()->getInMemoryMetadataPtr();
+        table_node.releaseStorageResources();
+    }
+
+    cache.set(key, std::move(entry));
+}
+
+}
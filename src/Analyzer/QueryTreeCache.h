@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Analyzer/IQueryTreeNode.h>
+#include <Common/CacheBase.h>
+#include <Interpreters/Context_fwd.h>
+#include <Parsers/IAST_fwd.h>
+#include <Storages/StorageInMemoryMetadata.h>
+
+#include <map>
+
+namespace DB
+{
+
+/** Server-wide cache of analyzed query trees, enabled by the setting 'use_query_tree_cache'.
+  * Repeated queries (e.g. periodically refreshed dashboards) skip the whole analysis pass stack
+  * and go straight to planning.
+  *
+  * A cached tree must not pin table locks and data snapshots between queries, so they are released
+  * before the tree is stored (see TableNode::releaseStorageResources()) and re-acquired on every
+  * lookup via TableNode::updateStorage(). A lookup fails if any referenced table was altered or
+  * dropped since the tree was analyzed (detected by comparing the in-memory metadata pointers),
+  * in which case the query is analyzed from scratch and the entry is replaced.
+  *
+  * Trees that read from table functions or contain constants folded from expressions (evaluated
+  * scalar subqueries, non-literal constant expressions) are not cached because their analysis
+  * result may differ between runs.
+  */
+class QueryTreeCache
+{
+public:
+    explicit QueryTreeCache(size_t max_entries);
+
+    using Key = UInt128;
+
+    /// The key covers the query AST, the current database and the user with the current roles.
+    static Key makeKey(const ASTPtr & query, const ContextPtr & context);
+
+    /// Returns a fresh clone of the cached tree with storages, locks and snapshots re-acquired,
+    /// or nullptr if there is no entry or it is not valid anymore.
+    QueryTreeNodePtr find(const Key & key, const ContextPtr & context);
+
+    /// Stores an analyzed tree. Does nothing if the tree is not cacheable.
+    void add(const Key & key, const QueryTreeNodePtr & query_tree);
+
+private:
+    struct Entry
+    {
+        /// Storage locks and snapshots of the table nodes are released.
+        QueryTreeNodePtr query_tree;
+
+        /// In-memory metadata of each referenced table at analysis time, by full table name.
+        std::map<String, StorageMetadataPtr> table_metadata;
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key & key) const { return key.items[0]; }
+    };
+
+    /// Entries have unit weight, the cache is bounded by the number of entries.
+    CacheBase<Key, Entry, KeyHasher> cache;
+};
+
+using QueryTreeCachePtr = std::shared_ptr<QueryTreeCache>;
+
+}
@@ -37,6 +37,9 @@
 #include <Analyzer/Passes/OptimizeGroupByFunctionKeysPass.h>
 #include <Analyzer/Passes/IfTransformStringsToEnumPass.h>
 #include <Analyzer/Passes/ConvertOrLikeChainPass.h>
+#include <Analyzer/Passes/FuseMatchFunctionsPass.h>
+#include <Analyzer/Passes/FuseHashFunctionsPass.h>
+#include <Analyzer/Passes/FuseJSONExtractPass.h>
 #include <Analyzer/Passes/OptimizeRedundantFunctionsInOrderByPass.h>
 #include <Analyzer/Passes/GroupingFunctionsResolvePass.h>
 #include <Analyzer/Passes/AutoFinalOnQueryPass.h>
@@ -293,6 +296,12 @@ void addQueryTreePasses(QueryTreePassManager & manager, bool only_analyze)
 
     manager.addPass(std::make_unique<ConvertOrLikeChainPass>());
 
+    manager.addPass(std::make_unique<FuseMatchFunctionsPass>());
+
+    manager.addPass(std::make_unique<FuseHashFunctionsPass>());
+
+    manager.addPass(std::make_unique<FuseJSONExtractPass>());
+
     manager.addPass(std::make_unique<LogicalExpressionOptimizerPass>());
 
     manager.addPass(std::make_unique<CrossToInnerJoinPass>());
@@ -21,6 +21,7 @@
 #include <Storages/StorageJoin.h>
 
 #include <Interpreters/misc.h>
+#include <Interpreters/Cache/ScalarSubqueryCache.h>
 #include <Interpreters/convertFieldToType.h>
 #include <Interpreters/ExternalDictionariesLoader.h>
 #include <Interpreters/InterpreterSelectQueryAnalyzer.h>
@@ -67,6 +68,8 @@ namespace ProfileEvents
     extern const Event ScalarSubqueriesGlobalCacheHit;
     extern const Event ScalarSubqueriesLocalCacheHit;
     extern const Event ScalarSubqueriesCacheMiss;
+    extern const Event QueryAnalyzerColumnsCacheHits;
+    extern const Event QueryAnalyzerColumnsCacheMisses;
 }
 
 namespace DB
@@ -106,6 +109,58 @@ namespace ErrorCodes
     extern const int INVALID_IDENTIFIER;
 }
 
+namespace
+{
+
+/** Cache of table column lists used for identifier resolution, shared between queries.
+  *
+  * For wide tables, enumerating all columns with their subcolumns and types in
+  * StorageSnapshot::getColumns dominates the analysis time of short queries, and its
+  * result only changes together with the table metadata. Entries are keyed by the
+  * table name and validated by the identity of the metadata snapshot: any ALTER
+  * installs a new metadata object, so a stale entry simply stops matching and is
+  * replaced on the next query.
+  */
+struct TableColumnsCache
+{
+    struct Entry
+    {
+        StorageMetadataPtr metadata;
+        NamesAndTypes column_names_and_types;
+        std::unordered_set<std::string> subcolumn_names;
+    };
+
+    std::optional<Entry> get(const String & table_name, const StorageMetadataPtr & metadata)
+    {
+        std::lock_guard lock(mutex);
+        auto it = entries.find(table_name);
+        if (it == entries.end() || it->second.metadata != metadata)
+            return {};
+        return it->second;
+    }
+
+    void set(const String & table_name, Entry entry)
+    {
+        std::lock_guard lock(mutex);
+        /// Short queries touch a limited set of hot tables, so on overflow dropping
+        /// everything is cheaper than maintaining an eviction order.
+        if (entries.size() >= 1024)
+            entries.clear();
+        entries[table_name] = std::move(entry);
+    }
+
+    std::mutex mutex;
+    std::unordered_map<String, Entry> entries;
+};
+
+TableColumnsCache & tableColumnsCache()
+{
+    static TableColumnsCache cache;
+    return cache;
+}
+
+}
+
 QueryAnalyzer::QueryAnalyzer(bool only_analyze_)
     : identifier_resolver(ctes_in_resolve_process, node_to_projection_name)
     , only_analyze(only_analyze_)
@@ -479,6 +534,11 @@ void QueryAnalyzer::evaluateScalarSubqueryIfNeeded(QueryTreeNodePtr & node, Iden
 
     auto & scalars_cache = can_use_global_scalars ? scalar_subquery_to_scalar_value_global : scalar_subquery_to_scalar_value_local;
 
+    /// The server-wide cache shares scalar results across queries (see ScalarSubqueryCache.h). Its entries are
+    /// validated against the current partition versions of the tables the subquery reads, which needs the AST form.
+    const bool use_scalar_subquery_cache = can_use_global_scalars && context->getSettingsRef().use_scalar_subquery_cache;
+    ASTPtr subquery_ast = use_scalar_subquery_cache ? node_without_alias->toAST() : nullptr;
+
     if (scalars_cache.contains(node_with_hash))
     {
         if (can_use_global_scalars)
@@ -494,6 +554,15 @@ void QueryAnalyzer::evaluateScalarSubqueryIfNeeded(QueryTreeNodePtr & node, Iden
         scalar_subquery_to_scalar_value_global.emplace(node_with_hash, scalar_block);
         ProfileEvents::increment(ProfileEvents::ScalarSubqueriesGlobalCacheHit);
     }
+    else if (auto server_cached_scalar = use_scalar_subquery_cache
+                 ? ScalarSubqueryCache::instance().get(str_hash, subquery_ast, context)
+                 : std::optional<Block>{})
+    {
+        scalar_block = std::move(*server_cached_scalar);
+        scalar_subquery_to_scalar_value_global.emplace(node_with_hash, scalar_block);
+        if (context->hasQueryContext())
+            context->getQueryContext()->addScalar(str_hash, scalar_block);
+    }
     else
     {
         ProfileEvents::increment(ProfileEvents::ScalarSubqueriesCacheMiss);
@@ -605,6 +674,9 @@ void QueryAnalyzer::evaluateScalarSubqueryIfNeeded(QueryTreeNodePtr & node, Iden
             }
         }
 
+        if (use_scalar_subquery_cache)
+            ScalarSubqueryCache::instance().set(str_hash, subquery_ast, scalar_block, context);
+
         scalars_cache.emplace(node_with_hash, scalar_block);
         if (can_use_global_scalars && context->hasQueryContext())
             context->getQueryContext()->addScalar(str_hash, scalar_block);
@@ -4362,8 +4434,40 @@ void QueryAnalyzer::initializeTableExpressionData(const QueryTreeNodePtr & table
         if (storage_snapshot->storage.supportsSubcolumns())
             get_column_options.withSubcolumns();
 
-        auto column_names_and_types = storage_snapshot->getColumns(get_column_options);
-        table_expression_data.column_names_and_types = NamesAndTypes(column_names_and_types.begin(), column_names_and_types.end());
+        /// Table functions, temporary tables and snapshots with dynamic object columns
+        /// are not cached: their column set is not a function of the table metadata.
+        bool use_columns_cache = table_node && table_node->getTemporaryTableName().empty() && storage_snapshot->object_columns.empty();
+        String columns_cache_key;
+        std::optional<TableColumnsCache::Entry> cached_columns;
+        if (use_columns_cache)
+        {
+            columns_cache_key = table_node->getStorageID().getFullNameNotQuoted();
+            cached_columns = tableColumnsCache().get(columns_cache_key, storage_snapshot->metadata);
+        }
+
+        if (cached_columns)
+        {
+            ProfileEvents::increment(ProfileEvents::QueryAnalyzerColumnsCacheHits);
+            table_expression_data.column_names_and_types = cached_columns->column_names_and_types;
+            table_expression_data.subcolumn_names = cached_columns->subcolumn_names;
+        }
+        else
+        {
+            auto column_names_and_types = storage_snapshot->getColumns(get_column_options);
+            table_expression_data.column_names_and_types = NamesAndTypes(column_names_and_types.begin(), column_names_and_types.end());
+
+            for (const auto & column_name_and_type : table_expression_data.column_names_and_types)
+                for (const auto & subcolumn : storage_snapshot->metadata->getColumns().getSubcolumns(column_name_and_type.name))
+                    table_expression_data.subcolumn_names.insert(subcolumn.name);
+
+            if (use_columns_cache)
+            {
+                ProfileEvents::increment(ProfileEvents::QueryAnalyzerColumnsCacheMisses);
+                tableColumnsCache().set(
+                    columns_cache_key,
+                    {storage_snapshot->metadata, table_expression_data.column_names_and_types, table_expression_data.subcolumn_names});
+            }
+        }
 
         const auto & columns_description = storage_snapshot->metadata->getColumns();
 
@@ -4380,8 +4484,6 @@ void QueryAnalyzer::initializeTableExpressionData(const QueryTreeNodePtr & table
           */
         for (const auto & column_name_and_type : table_expression_data.column_names_and_types)
         {
-            for (const auto & subcolumn : columns_description.getSubcolumns(column_name_and_type.name))
-                table_expression_data.subcolumn_names.insert(subcolumn.name);
             const auto & column_default = columns_description.getDefault(column_name_and_type.name);
 
             if (column_default && column_default->kind == ColumnDefaultKind::Alias)
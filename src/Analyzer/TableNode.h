@@ -37,6 +37,17 @@ public:
       */
     void updateStorage(StoragePtr storage_value, const ContextPtr & context);
 
+    /** Release the storage, storage lock and storage snapshot, e.g. before the node is stored in
+      * a cross-query cache. Only the storage id is kept. The node must not be used for planning
+      * again until updateStorage() is called.
+      */
+    void releaseStorageResources()
+    {
+        storage = {};
+        storage_lock = {};
+        storage_snapshot = {};
+    }
+
     /// Get storage
     const StoragePtr & getStorage() const
     {
@@ -31,23 +31,31 @@ namespace
 
 BackupEntryFromSmallFile::BackupEntryFromSmallFile(const String & file_path_, const ReadSettings & read_settings_)
     : file_path(file_path_)
+    , read_settings(read_settings_)
     , data_source_description(DiskLocal::getLocalDataSourceDescription(file_path_))
-    , data(readFile(file_path_, read_settings_))
 {
 }
 
 BackupEntryFromSmallFile::BackupEntryFromSmallFile(const DiskPtr & disk_, const String & file_path_, const ReadSettings & read_settings_, bool copy_encrypted_)
     : disk(disk_)
     , file_path(file_path_)
+    , read_settings(read_settings_)
     , data_source_description(disk_->getDataSourceDescription())
     , copy_encrypted(copy_encrypted_ && data_source_description.is_encrypted)
-    , data(readFile(disk_, file_path, read_settings_, copy_encrypted))
 {
 }
 
+const String & BackupEntryFromSmallFile::getData() const
+{
+    std::lock_guard lock{data_mutex};
+    if (!data)
+        data = disk ? readFile(disk, file_path, read_settings, copy_encrypted) : readFile(file_path, read_settings);
+    return *data;
+}
+
 std::unique_ptr<SeekableReadBuffer> BackupEntryFromSmallFile::getReadBuffer(const ReadSettings &) const
 {
-    return std::make_unique<ReadBufferFromString>(data);
+    return std::make_unique<ReadBufferFromString>(getData());
 }
 
 }
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <Backups/BackupEntryWithChecksumCalculation.h>
+#include <IO/ReadSettings.h>
+
+#include <mutex>
+#include <optional>
 
 
 namespace DB
@@ -17,7 +21,7 @@ public:
     BackupEntryFromSmallFile(const DiskPtr & disk_, const String & file_path_, const ReadSettings & read_settings_, bool copy_encrypted_ = false);
 
     std::unique_ptr<SeekableReadBuffer> getReadBuffer(const ReadSettings &) const override;
-    UInt64 getSize() const override { return data.size(); }
+    UInt64 getSize() const override { return getData().size(); }
 
     DataSourceDescription getDataSourceDescription() const override { return data_source_description; }
     bool isEncryptedByDisk() const override { return copy_encrypted; }
@@ -27,11 +31,19 @@ public:
     String getFilePath() const override { return file_path; }
 
 private:
+    const String & getData() const;
+
     const DiskPtr disk;
     const String file_path;
+    const ReadSettings read_settings;
     const DataSourceDescription data_source_description;
     const bool copy_encrypted = false;
-    const String data;
+
+    /// The file is read lazily, on the first use of the entry. Thus collecting backup entries
+    /// (which is sequential within a table) doesn't do any reads, they're performed later by
+    /// the backup thread pool along with checksum calculation.
+    mutable std::optional<String> data;
+    mutable std::mutex data_mutex;
 };
 
 }
@@ -449,6 +449,10 @@ void ClientBase::onData(Block & block, ASTPtr parsed_query)
     if (!block)
         return;
 
+    /// If remote_exchange_lazy_decompression is enabled, the block may hold lazily
+    /// compressed columns, and we are about to use all of them.
+    decompressBlockColumns(block);
+
     processed_rows += block.rows();
     /// Even if all blocks are empty, we still need to initialize the output stream to write empty resultset.
     initOutputFormat(block, parsed_query);
@@ -5,6 +5,7 @@
 #include <Compression/CompressedReadBuffer.h>
 #include <Compression/CompressedWriteBuffer.h>
 #include <IO/ReadBufferFromPocoSocket.h>
+#include <IO/ReadBufferFromString.h>
 #include <IO/WriteBufferFromPocoSocket.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteHelpers.h>
@@ -25,6 +26,8 @@
 #include <Common/randomSeed.h>
 #include <Common/logger_useful.h>
 #include <Core/Block.h>
+#include <Columns/ColumnCompressed.h>
+#include <DataTypes/DataTypeFactory.h>
 #include <Interpreters/ClientInfo.h>
 #include <Interpreters/OpenTelemetrySpanLog.h>
 #include <Compression/CompressionFactory.h>
@@ -32,6 +35,8 @@
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Processors/ISink.h>
 #include <Processors/Executors/PipelineExecutor.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <Common/SipHash.h>
 #include <pcg_random.hpp>
 #include <base/scope_guard.h>
 #include <Common/FailPoint.h>
@@ -207,6 +212,7 @@ void Connection::connect(const ConnectionTimeouts & timeouts)
 
         sendHello();
         receiveHello(timeouts.handshake_timeout);
+        last_packet_receive_time = time(nullptr);
 
         if (server_revision >= DBMS_MIN_PROTOCOL_VERSION_WITH_ADDENDUM)
             sendAddendum();
@@ -278,6 +284,7 @@ void Connection::disconnect()
         socket->close();
     socket = nullptr;
     connected = false;
+    last_packet_receive_time = 0;
     nonce.reset();
 
     if (finalize_exception)
@@ -544,8 +551,30 @@ void Connection::forceConnected(const ConnectionTimeouts & timeouts)
     if (!connected)
     {
         connect(timeouts);
+        return;
+    }
+
+    /// A connection that received a packet moments ago is almost surely still usable, and a
+    /// server-side close since then would be pending on the socket. Skipping the ping here saves
+    /// a round-trip per pooled acquisition, which adds up during distributed query fan-outs.
+    /// Pending data (late packets, EOF) still goes through the full ping that drains or detects it.
+    static constexpr time_t skip_ping_after_packet_receive_seconds = 5;
+    if (time(nullptr) - last_packet_receive_time < skip_ping_after_packet_receive_seconds)
+    {
+        bool socket_has_pending_input = true;
+        try
+        {
+            socket_has_pending_input = in->hasPendingData() || socket->poll(0, Poco::Net::Socket::SELECT_READ);
+        }
+        catch (const Poco::Exception &)
+        {
+        }
+
+        if (!socket_has_pending_input)
+            return;
     }
-    else if (!ping(timeouts))
+
+    if (!ping(timeouts))
     {
         LOG_TRACE(log_wrapper.get(), "Connection was closed, will reconnect.");
         connect(timeouts);
@@ -593,6 +622,8 @@ bool Connection::ping(const ConnectionTimeouts & timeouts)
 
         if (pong != Protocol::Server::Pong)
             throwUnexpectedPacket(pong, "Pong");
+
+        last_packet_receive_time = time(nullptr);
     }
     catch (const Poco::Exception & e)
     {
@@ -675,6 +706,10 @@ void Connection::sendQuery(
     socket->setReceiveTimeout(timeouts.receive_timeout);
     socket->setSendTimeout(timeouts.send_timeout);
 
+    external_tables_dedup_enabled = settings && settings->external_tables_dedup;
+    lazy_exchange_blocks_enabled = settings && settings->remote_exchange_lazy_decompression
+        && server_revision >= DBMS_MIN_REVISION_WITH_LAZY_EXCHANGE_BLOCKS;
+
     if (settings)
     {
         std::optional<int> level;
@@ -845,6 +880,18 @@ void Connection::sendMergeTreeReadTaskResponse(const ParallelReadResponse & resp
     out->next();
 }
 
+void Connection::sendSortThreshold(const Block & block)
+{
+    if (server_revision < DBMS_MIN_REVISION_WITH_SORT_THRESHOLD)
+        return;
+
+    writeVarUInt(Protocol::Client::SortThreshold, *out);
+    /// The threshold is a single row, it is not worth compressing.
+    NativeWriter writer(*out, server_revision, block.cloneEmpty());
+    writer.write(block);
+    out->next();
+}
+
 void Connection::sendPreparedData(ReadBuffer & input, size_t size, const String & name)
 {
     /// NOTE 'Throttler' is not used in this method (could use, but it's not important right now).
@@ -950,6 +997,79 @@ private:
 };
 }
 
+NameSet Connection::negotiateExternalTablesToSend(ExternalTablesData & data, std::vector<std::pair<String, Blocks>> & materialized)
+{
+    /// Materialize every table and announce its content hash, so that the server can
+    /// request only the tables missing from its content-addressed cache.
+    writeVarUInt(Protocol::Client::ExternalTablesHashes, *out);
+    writeVarUInt(data.size(), *out);
+
+    for (auto & elem : data)
+    {
+        if (!elem->pipe)
+            elem->pipe = elem->creating_pipe_callback();
+
+        auto pipeline = QueryPipelineBuilder::getPipeline(std::move(*elem->pipe));
+        elem->pipe.reset();
+
+        PullingPipelineExecutor executor(pipeline);
+        Blocks blocks;
+        SipHash hash;
+        hash.update(executor.getHeader().dumpStructure());
+
+        Block block;
+        while (executor.pull(block))
+        {
+            if (!block.rows())
+                continue;
+
+            hash.update(block.rows());
+            for (const auto & column : block.getColumns())
+                column->updateHashFast(hash);
+            blocks.emplace_back(std::move(block));
+        }
+
+        /// If the table is empty, keep the header so that the receiving side knows the structure.
+        if (blocks.empty())
+            blocks.emplace_back(executor.getHeader().cloneEmpty());
+
+        writeStringBinary(elem->table_name, *out);
+        writePODBinary(hash.get128(), *out);
+        materialized.emplace_back(elem->table_name, std::move(blocks));
+    }
+    out->next();
+
+    UInt64 response_type = 0;
+    while (true)
+    {
+        readVarUInt(response_type, *in);
+
+        if (response_type == Protocol::Server::ExternalTablesRequest)
+            break;
+
+        if (response_type == Protocol::Server::Exception)
+            receiveException()->rethrow();
+        else if (response_type == Protocol::Server::Log)
+            /// The server may flush pending logs before reading our announcement.
+            /// There is nobody to deliver them to at this point, so just skip them.
+            receiveLogData();
+        else
+            throwUnexpectedPacket(response_type, "ExternalTablesRequest");
+    }
+
+    size_t count = 0;
+    readVarUInt(count, *in);
+    NameSet tables_to_send;
+    for (size_t i = 0; i < count; ++i)
+    {
+        String table_name;
+        readStringBinary(table_name, *in);
+        tables_to_send.insert(table_name);
+    }
+    return tables_to_send;
+}
+
+
 void Connection::sendExternalTablesData(ExternalTablesData & data)
 {
     if (data.empty())
@@ -966,6 +1086,24 @@ void Connection::sendExternalTablesData(ExternalTablesData & data)
 
     CurrentMetrics::Increment metric_increment{CurrentMetrics::SendExternalTables};
 
+    if (external_tables_dedup_enabled && server_revision >= DBMS_MIN_REVISION_WITH_EXTERNAL_TABLES_DEDUP)
+    {
+        std::vector<std::pair<String, Blocks>> materialized;
+        NameSet tables_to_send = negotiateExternalTablesToSend(data, materialized);
+
+        for (auto & [table_name, blocks] : materialized)
+        {
+            if (!tables_to_send.contains(table_name))
+                continue;
+
+            for (const auto & block : blocks)
+            {
+                rows += block.rows();
+                sendData(block, table_name, false);
+            }
+        }
+    }
+    else
     for (auto & elem : data)
     {
         PipelineExecutorPtr executor;
@@ -1074,9 +1212,16 @@ Packet Connection::receivePacket()
             readVarUInt(res.type, *in);
         }
 
+        last_packet_receive_time = time(nullptr);
+
         switch (res.type)
         {
             case Protocol::Server::Data:
+                /// Totals and extremes are always sent in the regular format, only the main
+                /// data stream may use per-column compressed chunks.
+                res.block = lazy_exchange_blocks_enabled ? receiveLazyData() : receiveData();
+                return res;
+
             case Protocol::Server::Totals:
             case Protocol::Server::Extremes:
                 res.block = receiveData();
@@ -1157,6 +1302,64 @@ Block Connection::receiveData()
 }
 
 
+Block Connection::receiveLazyData()
+{
+    String external_table_name;
+    readStringBinary(external_table_name, *in);
+
+    size_t prev_bytes = in->count();
+
+    Block res;
+    res.info.read(*in);
+
+    size_t num_columns = 0;
+    size_t num_rows = 0;
+    readVarUInt(num_columns, *in);
+    readVarUInt(num_rows, *in);
+
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        ColumnWithTypeAndName column;
+        readStringBinary(column.name, *in);
+
+        String type_name;
+        readStringBinary(type_name, *in);
+        column.type = DataTypeFactory::instance().get(type_name);
+
+        auto chunk = std::make_shared<String>();
+        readStringBinary(*chunk, *in);
+
+        if (num_rows == 0)
+        {
+            /// Header blocks are inspected column by column, laziness buys nothing here.
+            column.column = column.type->createColumn();
+        }
+        else
+        {
+            auto type = column.type;
+            column.column = ColumnCompressed::create(
+                num_rows,
+                chunk->size(),
+                [type, chunk, num_rows]() -> ColumnPtr
+                {
+                    ReadBufferFromString chunk_in(*chunk);
+                    CompressedReadBuffer decompressing_in(chunk_in);
+                    ColumnPtr read_column = type->createColumn();
+                    NativeReader::readData(*type->getDefaultSerialization(), read_column, decompressing_in, num_rows, 0);
+                    return read_column;
+                });
+        }
+
+        res.insert(std::move(column));
+    }
+
+    if (throttler)
+        throttler->add(in->count() - prev_bytes);
+
+    return res;
+}
+
+
 Block Connection::receiveLogData()
 {
     initBlockLogsInput();
@@ -1201,7 +1404,9 @@ void Connection::initBlockInput()
         if (!maybe_compressed_in)
         {
             if (compression == Protocol::Compression::Enable)
-                maybe_compressed_in = std::make_shared<CompressedReadBuffer>(*in);
+                /// The server may switch codecs between frames when it does adaptive network
+                /// compression (it checks our revision before doing so).
+                maybe_compressed_in = std::make_shared<CompressedReadBuffer>(*in, /* allow_different_codecs */ true);
             else
                 maybe_compressed_in = in;
         }
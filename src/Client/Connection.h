@@ -14,6 +14,8 @@
 #include <Interpreters/TablesStatus.h>
 #include <Interpreters/Context_fwd.h>
 
+#include <Core/Names.h>
+
 #include <Compression/ICompressionCodec.h>
 
 #include <Storages/MergeTree/RequestResponse.h>
@@ -142,6 +144,9 @@ public:
     void sendScalarsData(Scalars & data);
     /// Send parts' uuids to excluded them from query processing
     void sendIgnoredPartUUIDs(const std::vector<UUID> & uuids);
+    /// Send the current k-th sort key of a distributed ORDER BY ... LIMIT query.
+    /// Does nothing if the server is too old to understand the packet.
+    void sendSortThreshold(const Block & block);
 
     TablesStatusResponse getTablesStatus(const ConnectionTimeouts & timeouts,
                                          const TablesStatusRequest & request);
@@ -198,6 +203,20 @@ private:
 
     bool connected = false;
 
+    /// When a packet was last successfully received from the server. A recently active connection
+    /// taken from a pool is not pinged again (see forceConnected()).
+    time_t last_packet_receive_time = 0;
+
+    /// Whether to announce content hashes of external tables before sending them,
+    /// so that the server can skip transfers of tables it already holds in its cache.
+    /// Set from the external_tables_dedup setting on each sendQuery().
+    bool external_tables_dedup_enabled = false;
+
+    /// Whether the server sends Data packets as per-column compressed chunks that we wrap
+    /// into lazily decompressed columns. Set from the remote_exchange_lazy_decompression
+    /// setting on each sendQuery().
+    bool lazy_exchange_blocks_enabled = false;
+
     String server_name;
     UInt64 server_version_major = 0;
     UInt64 server_version_minor = 0;
@@ -280,7 +299,15 @@ private:
 #endif
     bool ping(const ConnectionTimeouts & timeouts);
 
+    /// Announce the content hashes of the external tables and return the names of the tables
+    /// the server asked to send (the rest it takes from its content-addressed cache).
+    /// Fills `materialized` with the blocks of every table, in the order of `data`.
+    NameSet negotiateExternalTablesToSend(ExternalTablesData & data, std::vector<std::pair<String, Blocks>> & materialized);
+
     Block receiveData();
+    /// Receive a Data packet written as per-column compressed chunks and wrap the columns
+    /// into lazily decompressed ones (see TCPHandler::writeLazyExchangeBlock()).
+    Block receiveLazyData();
     Block receiveLogData();
     Block receiveDataImpl(NativeReader & reader);
     Block receiveProfileEvents();
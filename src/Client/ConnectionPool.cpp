@@ -1,4 +1,5 @@
 #include <Client/ConnectionPool.h>
+#include <Client/ReplicaHealthMonitor.h>
 
 #include <boost/functional/hash.hpp>
 
@@ -55,6 +56,11 @@ ConnectionPoolPtr ConnectionPoolFactory::get(
         }
     };
     it->second = ConnectionPoolWeakPtr(ret);
+
+    /// Let the background health probes cover this endpoint (a no-op unless the
+    /// monitor was started, see ReplicaHealthMonitor).
+    ReplicaHealthMonitor::instance().addEndpoint(host, port);
+
     return ret;
 }
 
@@ -7,6 +7,8 @@
 #include <Core/Settings.h>
 #include <base/defines.h>
 
+#include <atomic>
+
 namespace DB
 {
 
@@ -47,11 +49,28 @@ public:
     const String & getAddress() const { return address; }
     Priority getConfigPriority() const { return config_priority; }
 
+    /// Process-wide moving average of the time from sending a query over a connection
+    /// from this pool to receiving the first data packet. Zero means "no samples yet".
+    /// It is used to arm adaptive hedge timeouts (see HedgedConnections).
+    UInt64 getTimeToFirstDataEWMAMicroseconds() const { return time_to_first_data_ewma_microseconds.load(std::memory_order_relaxed); }
+
+    void updateTimeToFirstDataEWMA(UInt64 elapsed_microseconds)
+    {
+        UInt64 current = time_to_first_data_ewma_microseconds.load(std::memory_order_relaxed);
+        /// Weight 1/4 for the new sample: enough history to smooth out single outliers,
+        /// but fast enough to track a replica that became slow or recovered.
+        UInt64 updated = current ? current - current / 4 + elapsed_microseconds / 4 : elapsed_microseconds;
+        time_to_first_data_ewma_microseconds.store(updated, std::memory_order_relaxed);
+    }
+
 protected:
     const String host;
     const UInt16 port = 0;
     const String address;
     const Priority config_priority;
+
+private:
+    std::atomic<UInt64> time_to_first_data_ewma_microseconds{0};
 };
 
 using ConnectionPoolPtr = std::shared_ptr<IConnectionPool>;
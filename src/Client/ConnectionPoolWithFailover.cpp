@@ -1,5 +1,6 @@
 #include <Client/ConnectionPoolWithFailover.h>
 #include <Client/ConnectionEstablisher.h>
+#include <Client/ReplicaHealthMonitor.h>
 
 #include <Poco/Net/NetException.h>
 #include <Poco/Net/DNS.h>
@@ -76,7 +77,7 @@ IConnectionPool::Entry ConnectionPoolWithFailover::get(const ConnectionTimeouts
     const UInt64 max_ignored_errors = settings.distributed_replica_max_ignored_errors;
     const bool fallback_to_stale_replicas = settings.fallback_to_stale_replicas_for_distributed_queries;
 
-    return Base::get(max_ignored_errors, fallback_to_stale_replicas, try_get_entry, get_priority);
+    return Base::get(max_ignored_errors, fallback_to_stale_replicas, try_get_entry, get_priority, makeCheckUnreachableFunc());
 }
 
 ConnectionPoolWithFailover::Status ConnectionPoolWithFailover::getStatus() const
@@ -181,6 +182,20 @@ ConnectionPoolWithFailover::Base::GetPriorityFunc ConnectionPoolWithFailover::ma
     return get_priority_load_balancing.getPriorityFunc(load_balancing, offset, nested_pools.size());
 }
 
+ConnectionPoolWithFailover::Base::CheckUnreachableFunc ConnectionPoolWithFailover::makeCheckUnreachableFunc() const
+{
+    auto snapshot = ReplicaHealthMonitor::instance().getSnapshot();
+    if (!snapshot || snapshot->empty())
+        return {};
+
+    /// The snapshot is immutable and shared with the probing thread, lookups are lock-free.
+    return [snapshot = std::move(snapshot), this](size_t index)
+    {
+        const auto & pool = nested_pools[index];
+        return snapshot->contains(ReplicaHealthMonitor::endpointKey(pool->getHost(), pool->getPort()));
+    };
+}
+
 std::vector<ConnectionPoolWithFailover::TryResult> ConnectionPoolWithFailover::getManyImpl(
     const Settings & settings,
     PoolMode pool_mode,
@@ -225,7 +240,16 @@ std::vector<ConnectionPoolWithFailover::TryResult> ConnectionPoolWithFailover::g
     UInt64 max_ignored_errors = settings.distributed_replica_max_ignored_errors.value;
     bool fallback_to_stale_replicas = settings.fallback_to_stale_replicas_for_distributed_queries.value;
 
-    return Base::getMany(min_entries, max_entries, max_tries, max_ignored_errors, fallback_to_stale_replicas, skip_read_only_replicas, try_get_entry, priority_func);
+    return Base::getMany(
+        min_entries,
+        max_entries,
+        max_tries,
+        max_ignored_errors,
+        fallback_to_stale_replicas,
+        skip_read_only_replicas,
+        try_get_entry,
+        priority_func,
+        makeCheckUnreachableFunc());
 }
 
 ConnectionPoolWithFailover::TryResult
@@ -273,7 +297,7 @@ ConnectionPoolWithFailover::getShuffledPools(const Settings & settings, GetPrior
         priority_func = makeGetPriorityFunc(settings);
 
     UInt64 max_ignored_errors = settings.distributed_replica_max_ignored_errors.value;
-    return Base::getShuffledPools(max_ignored_errors, priority_func, use_slowdown_count);
+    return Base::getShuffledPools(max_ignored_errors, priority_func, use_slowdown_count, makeCheckUnreachableFunc());
 }
 
 }
@@ -129,6 +129,11 @@ private:
 
     GetPriorityForLoadBalancing::Func makeGetPriorityFunc(const Settings & settings);
 
+    /// Builds a functor over the current ReplicaHealthMonitor snapshot, so that replicas
+    /// that failed their last background probe are tried last. Returns an empty functor
+    /// if all registered endpoints are reachable (or probing is not enabled).
+    Base::CheckUnreachableFunc makeCheckUnreachableFunc() const;
+
     GetPriorityForLoadBalancing get_priority_load_balancing;
 };
 
@@ -139,6 +139,20 @@ void HedgedConnections::sendIgnoredPartUUIDs(const std::vector<UUID> & uuids)
     pipeline_for_new_replicas.add(send_ignored_part_uuids);
 }
 
+void HedgedConnections::sendSortThreshold(const Block & block)
+{
+    std::lock_guard lock(cancel_mutex);
+
+    if (!sent_query || cancelled)
+        return;
+
+    /// Replicas that start later will get the next threshold update.
+    for (auto & offset_state : offset_states)
+        for (auto & replica : offset_state.replicas)
+            if (replica.connection)
+                replica.connection->sendSortThreshold(block);
+}
+
 void HedgedConnections::sendQuery(
     const ConnectionTimeouts & timeouts,
     const String & query,
@@ -196,7 +210,8 @@ void HedgedConnections::sendQuery(
         }
 
         replica.connection->sendQuery(timeouts, query, /* query_parameters */ {}, query_id, stage, &modified_settings, &client_info, with_pending_data, {});
-        replica.change_replica_timeout.setRelative(timeouts.receive_data_timeout);
+        replica.time_to_first_data_watch.restart();
+        replica.change_replica_timeout.setRelative(getChangeReplicaTimeout(replica));
         replica.packet_receiver->setTimeout(hedged_connections_factory.getConnectionTimeouts().receive_timeout);
     };
 
@@ -418,7 +433,13 @@ Packet HedgedConnections::receivePacketFromReplica(const ReplicaLocation & repli
             /// If we received the first not empty data packet and still can change replica,
             /// disable changing replica with this offset.
             if (offset_states[replica_location.offset].can_change_replica && packet.block.rows() > 0)
+            {
+                /// The replica delivered the first data packet: account its time to first data,
+                /// so the next queries can use it to arm adaptive hedge timeouts.
+                if (auto replica_pool = hedged_connections_factory.getPoolForConnection(*replica.connection))
+                    replica_pool->updateTimeToFirstDataEWMA(replica.time_to_first_data_watch.elapsedMicroseconds());
                 disableChangingReplica(replica_location);
+            }
             replica_with_last_received_packet = replica_location;
             break;
         case Protocol::Server::Progress:
@@ -428,7 +449,7 @@ Packet HedgedConnections::receivePacketFromReplica(const ReplicaLocation & repli
                 /// If we are allowed to change replica until the first data packet,
                 /// just restart timeout (if it hasn't expired yet). Otherwise disable changing replica with this offset.
                 if (settings.allow_changing_replica_until_first_data_packet && !replica.is_change_replica_timeout_expired)
-                    replica.change_replica_timeout.setRelative(hedged_connections_factory.getConnectionTimeouts().receive_data_timeout);
+                    replica.change_replica_timeout.setRelative(getChangeReplicaTimeout(replica));
                 else
                     disableChangingReplica(replica_location);
             }
@@ -467,6 +488,27 @@ Packet HedgedConnections::receivePacketFromReplica(const ReplicaLocation & repli
     return packet;
 }
 
+Poco::Timespan HedgedConnections::getChangeReplicaTimeout(const ReplicaState & replica) const
+{
+    Poco::Timespan configured_timeout = hedged_connections_factory.getConnectionTimeouts().receive_data_timeout;
+    if (!settings.use_adaptive_hedged_requests)
+        return configured_timeout;
+
+    auto replica_pool = hedged_connections_factory.getPoolForConnection(*replica.connection);
+    if (!replica_pool)
+        return configured_timeout;
+
+    UInt64 ewma_microseconds = replica_pool->getTimeToFirstDataEWMAMicroseconds();
+    if (!ewma_microseconds)
+        return configured_timeout;
+
+    /// Hedge when the replica is well past its typical time to the first data packet,
+    /// but never later than the configured fixed timeout.
+    UInt64 adaptive_timeout_microseconds
+        = std::min(ewma_microseconds * 2, static_cast<UInt64>(configured_timeout.totalMicroseconds()));
+    return Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(adaptive_timeout_microseconds));
+}
+
 void HedgedConnections::disableChangingReplica(const ReplicaLocation & replica_location)
 {
     /// Stop working with replicas, that are responsible for the same offset.
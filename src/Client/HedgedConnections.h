@@ -8,6 +8,7 @@
 #include <Client/HedgedConnectionsFactory.h>
 #include <Client/IConnections.h>
 #include <Client/PacketReceiver.h>
+#include <Common/Stopwatch.h>
 
 
 namespace DB
@@ -40,6 +41,9 @@ public:
         PacketReceiverPtr packet_receiver;
         TimerDescriptor change_replica_timeout;
         bool is_change_replica_timeout_expired = false;
+        /// Time elapsed since the query was sent to this replica, to account
+        /// the time to the first data packet in the replica latency statistics.
+        Stopwatch time_to_first_data_watch;
     };
 
     struct OffsetState
@@ -112,6 +116,8 @@ public:
 
     void sendIgnoredPartUUIDs(const std::vector<UUID> & uuids) override;
 
+    void sendSortThreshold(const Block & block) override;
+
     Packet drain() override;
 
     std::string dumpAddresses() const override;
@@ -149,6 +155,11 @@ private:
 
     void disableChangingReplica(const ReplicaLocation & replica_location);
 
+    /// The timeout after which we try to get a new replica. With adaptive hedged
+    /// requests it is derived from the replica latency statistics, otherwise it
+    /// is the configured receive_data_timeout.
+    Poco::Timespan getChangeReplicaTimeout(const ReplicaState & replica) const;
+
     void startNewReplica();
 
     void checkNewReplica();
@@ -392,6 +392,18 @@ size_t HedgedConnectionsFactory::numberOfProcessingReplicas() const
     return requested_connections_count - ready_replicas_count;
 }
 
+ConnectionPoolPtr HedgedConnectionsFactory::getPoolForConnection(const Connection & connection) const
+{
+    for (size_t i = 0; i != replicas.size(); ++i)
+    {
+        TryResult result = replicas[i].connection_establisher->getResult();
+        if (!result.entry.isNull() && &*result.entry == &connection)
+            return shuffled_pools[i].pool;
+    }
+
+    return nullptr;
+}
+
 HedgedConnectionsFactory::State HedgedConnectionsFactory::setBestUsableReplica(Connection *& connection_out)
 {
     std::vector<int> indexes;
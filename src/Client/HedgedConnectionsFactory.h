@@ -76,6 +76,10 @@ public:
 
     const ConnectionTimeouts & getConnectionTimeouts() const { return timeouts; }
 
+    /// Return the pool the connection of a ready replica was taken from
+    /// (to read/update per-replica latency statistics), nullptr if not found.
+    ConnectionPoolPtr getPoolForConnection(const Connection & connection) const;
+
     size_t numberOfProcessingReplicas() const;
 
     /// Tell Factory to not return connections with two level aggregation incompatibility.
@@ -43,6 +43,9 @@ public:
     /// Send parts' uuids to replicas to exclude them from query processing
     virtual void sendIgnoredPartUUIDs(const std::vector<UUID> & uuids) = 0;
 
+    /// Send the current k-th sort key of a distributed ORDER BY ... LIMIT query to replicas
+    virtual void sendSortThreshold(const Block & block) = 0;
+
     /** On each replica, read and skip all packets to EndOfStream or Exception.
       * Returns EndOfStream if no exception has been received. Otherwise
       * returns the last received packet of type Exception.
@@ -53,6 +53,8 @@ public:
     /// Send parts' uuids to replicas to exclude them from query processing
     void sendIgnoredPartUUIDs(const std::vector<UUID> & uuids) override;
 
+    void sendSortThreshold(const Block & block) override;
+
     Packet drain() override;
 
     std::string dumpAddresses() const override;
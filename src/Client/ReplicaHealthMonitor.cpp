@@ -0,0 +1,118 @@
+#include <Client/ReplicaHealthMonitor.h>
+
+#include <Common/DNSResolver.h>
+#include <Common/Exception.h>
+#include <Common/logger_useful.h>
+#include <Common/setThreadName.h>
+#include <IO/WriteHelpers.h>
+
+#include <Poco/Net/StreamSocket.h>
+
+namespace DB
+{
+
+ReplicaHealthMonitor & ReplicaHealthMonitor::instance()
+{
+    static ReplicaHealthMonitor ret;
+    return ret;
+}
+
+String ReplicaHealthMonitor::endpointKey(const String & host, UInt16 port)
+{
+    return host + ':' + toString(port);
+}
+
+void ReplicaHealthMonitor::start(UInt64 probe_period_seconds_, UInt64 connect_timeout_ms_)
+{
+    std::lock_guard lock(control_mutex);
+    if (started)
+        return;
+
+    probe_period_seconds = probe_period_seconds_;
+    connect_timeout_ms = connect_timeout_ms_;
+    started = true;
+    thread = ThreadFromGlobalPool([this] { run(); });
+    LOG_INFO(log, "Started, probe period {} seconds", probe_period_seconds);
+}
+
+void ReplicaHealthMonitor::shutdown()
+{
+    {
+        std::lock_guard lock(control_mutex);
+        if (!started || need_shutdown)
+            return;
+        need_shutdown = true;
+    }
+    wake_up.notify_all();
+    if (thread.joinable())
+        thread.join();
+}
+
+void ReplicaHealthMonitor::addEndpoint(const String & host, UInt16 port)
+{
+    std::lock_guard lock(endpoints_mutex);
+    endpoints.emplace(endpointKey(host, port), std::make_pair(host, port));
+}
+
+bool ReplicaHealthMonitor::isUnreachable(const String & host, UInt16 port) const
+{
+    auto snapshot = unreachable.get();
+    return snapshot && snapshot->contains(endpointKey(host, port));
+}
+
+void ReplicaHealthMonitor::run()
+{
+    setThreadName("ReplicaProbes");
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(control_mutex);
+            wake_up.wait_for(lock, std::chrono::seconds(probe_period_seconds), [this]() TSA_REQUIRES(control_mutex) { return need_shutdown; });
+            if (need_shutdown)
+                return;
+        }
+
+        std::map<String, std::pair<String, UInt16>> endpoints_to_probe;
+        {
+            std::lock_guard lock(endpoints_mutex);
+            endpoints_to_probe = endpoints;
+        }
+
+        auto new_unreachable = std::make_unique<UnreachableEndpoints>();
+        for (const auto & [key, endpoint] : endpoints_to_probe)
+        {
+            try
+            {
+                /// Name resolution happens here, in the background, and goes through the
+                /// common DNS cache, keeping it warm for the query threads.
+                auto address = DNSResolver::instance().resolveAddress(endpoint.first, endpoint.second);
+                Poco::Net::StreamSocket socket;
+                socket.connect(address, Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(connect_timeout_ms) * 1000));
+            }
+            catch (...)
+            {
+                new_unreachable->insert(key);
+            }
+        }
+
+        if (!new_unreachable->empty())
+            LOG_DEBUG(log, "{} of {} probed endpoints are unreachable", new_unreachable->size(), endpoints_to_probe.size());
+
+        unreachable.set(std::move(new_unreachable));
+    }
+}
+
+ReplicaHealthMonitor::~ReplicaHealthMonitor()
+{
+    try
+    {
+        shutdown();
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log, __PRETTY_FUNCTION__);
+    }
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <base/defines.h>
+#include <base/types.h>
+#include <Common/Logger.h>
+#include <Common/MultiVersion.h>
+#include <Common/ThreadPool.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+
+namespace DB
+{
+
+/** Background watcher of replica reachability.
+  *
+  * Connection pools register their endpoints here (see ConnectionPoolFactory::get()) and a
+  * background thread periodically probes them with a cheap TCP connect, resolving host names
+  * through the common DNS cache along the way. The set of endpoints that failed their last
+  * probe is published as an immutable snapshot (MultiVersion), so query threads consult the
+  * reachability state with a single shared_ptr load: dispatching never blocks on name
+  * resolution or on a probe and does not have to discover a dead replica by timing out.
+  * ConnectionPoolWithFailover orders replicas that are known to be unreachable last
+  * (they are still tried if nothing else is left - the probe state may be stale).
+  *
+  * The monitor is passive until start() is called; the server does it at startup when
+  * replica_health_probe_period_sec is set. Without start() the endpoints are only collected
+  * and isUnreachable() always returns false, which keeps clients and tools free of the
+  * background thread.
+  */
+class ReplicaHealthMonitor : private boost::noncopyable
+{
+public:
+    /// Endpoint keys (see endpointKey()) that failed their last probe.
+    using UnreachableEndpoints = std::unordered_set<String>;
+    using Snapshot = MultiVersion<UnreachableEndpoints>::Version;
+
+    static ReplicaHealthMonitor & instance();
+
+    /// Starts the background probing thread. Does nothing if already started.
+    void start(UInt64 probe_period_seconds_, UInt64 connect_timeout_ms_);
+    void shutdown();
+
+    /// Registers an endpoint for probing.
+    void addEndpoint(const String & host, UInt16 port);
+
+    /// The current snapshot. May be nullptr if no probing cycle has finished yet.
+    Snapshot getSnapshot() const { return unreachable.get(); }
+
+    /// An endpoint that was never probed (or the monitor is not started) is reachable.
+    bool isUnreachable(const String & host, UInt16 port) const;
+
+    static String endpointKey(const String & host, UInt16 port);
+
+    ~ReplicaHealthMonitor();
+
+private:
+    ReplicaHealthMonitor() = default;
+
+    void run();
+
+    mutable std::mutex endpoints_mutex;
+    std::map<String, std::pair<String, UInt16>> endpoints TSA_GUARDED_BY(endpoints_mutex);
+
+    /// Replaced wholesale after every probing cycle; readers keep the version they grabbed.
+    MultiVersion<UnreachableEndpoints> unreachable;
+
+    std::mutex control_mutex;
+    std::condition_variable wake_up;
+    bool started TSA_GUARDED_BY(control_mutex) = false;
+    bool need_shutdown TSA_GUARDED_BY(control_mutex) = false;
+    UInt64 probe_period_seconds = 0;
+    UInt64 connect_timeout_ms = 0;
+    ThreadFromGlobalPool thread;
+
+    LoggerPtr log = getLogger("ReplicaHealthMonitor");
+};
+
+}
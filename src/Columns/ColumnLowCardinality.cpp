@@ -203,12 +203,32 @@ void ColumnLowCardinality::insertRangeFrom(const IColumn & src, size_t start, si
     {
         compactIfSharedDictionary();
 
+        auto src_nested = low_cardinality_src->getDictionary().getNestedColumn();
+        auto sub_idx = IColumn::mutate(low_cardinality_src->getIndexes().cut(start, length));
+
+        if (remap_src_dictionary.get() == src_nested.get())
+        {
+            /// The same source dictionary is inserted repeatedly: translate positions through
+            /// the memoized mapping and skip re-indexing of the keys.
+            /// The mapping over the whole source dictionary is built on the second occurrence,
+            /// so that a one-off insertion does not pay for keys it does not use.
+            /// The source dictionary object may have been appended to since the mapping was built.
+            if (remap_positions && remap_positions->size() != src_nested->size())
+                remap_positions = nullptr;
+
+            if (!remap_positions)
+                remap_positions = getDictionary().uniqueInsertRangeFrom(*src_nested, 0, src_nested->size());
+
+            idx.insertPositionsRange(*remap_positions->index(*sub_idx, 0), 0, length);
+            return;
+        }
+
+        remap_src_dictionary = src_nested;
+        remap_positions = nullptr;
+
         /// TODO: Support native insertion from other unique column. It will help to avoid null map creation.
 
-        auto sub_idx = IColumn::mutate(low_cardinality_src->getIndexes().cut(start, length));
         auto idx_map = mapUniqueIndex(*sub_idx);
-
-        auto src_nested = low_cardinality_src->getDictionary().getNestedColumn();
         auto used_keys = src_nested->index(*idx_map, 0);
 
         auto inserted_indexes = getDictionary().uniqueInsertRangeFrom(*used_keys, 0, used_keys->size());
@@ -522,6 +542,9 @@ void ColumnLowCardinality::setSharedDictionary(const ColumnPtr & column_unique)
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Can't set ColumnUnique for "
                         "ColumnLowCardinality because is't not empty.");
 
+    remap_src_dictionary = nullptr;
+    remap_positions = nullptr;
+
     dictionary.setShared(column_unique);
 }
 
@@ -534,6 +557,10 @@ ColumnLowCardinality::MutablePtr ColumnLowCardinality::cutAndCompact(size_t star
 
 void ColumnLowCardinality::compactInplace()
 {
+    /// Compaction renumbers dictionary positions, the memoized mapping becomes stale.
+    remap_src_dictionary = nullptr;
+    remap_positions = nullptr;
+
     auto positions = idx.detachPositions();
     dictionary.compact(positions);
     idx.attachPositions(std::move(positions));
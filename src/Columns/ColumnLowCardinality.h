@@ -369,6 +369,16 @@ private:
     Dictionary dictionary;
     Index idx;
 
+    /// Memoized re-indexing state for insertRangeFrom.
+    /// When a column is built by concatenating many chunks that reference the same source
+    /// dictionary (typical for chunks read from one part), the mapping from source dictionary
+    /// positions to our dictionary positions is computed once and reused, instead of
+    /// re-indexing the keys of every inserted range.
+    /// remap_positions is filled lazily on the second range from the same dictionary;
+    /// it stays valid while our dictionary is only appended to and is dropped on compaction.
+    ColumnPtr remap_src_dictionary;
+    ColumnPtr remap_positions;
+
     void compactInplace();
     void compactIfSharedDictionary();
 
@@ -4,6 +4,7 @@
 #include <Common/assert_cast.h>
 #include <Common/WeakHash.h>
 #include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsCommon.h>
 #include <Columns/ColumnConst.h>
 #include <Columns/ColumnString.h>
 #include <Columns/ColumnCompressed.h>
@@ -300,6 +301,14 @@ void ColumnNullable::popBack(size_t n)
 ColumnPtr ColumnNullable::filter(const Filter & filt, ssize_t result_size_hint) const
 {
     ColumnPtr filtered_data = getNestedColumn().filter(filt, result_size_hint);
+
+    /// A fully non-null column is a common case (e.g. Nullable metrics that rarely contain NULL).
+    /// Then there is no need to run the filter over the null map: the result is all zeros
+    /// of the size we already know from the filtered nested column.
+    const auto & null_map_data = getNullMapData();
+    if (memoryIsZero(null_map_data.data(), 0, null_map_data.size()))
+        return ColumnNullable::create(filtered_data, ColumnUInt8::create(filtered_data->size(), 0));
+
     ColumnPtr filtered_null_map = getNullMapColumn().filter(filt, result_size_hint);
     return ColumnNullable::create(filtered_data, filtered_null_map);
 }
@@ -12,6 +12,7 @@
 #include <Interpreters/castColumn.h>
 #include <Interpreters/convertFieldToType.h>
 #include <Common/HashTable/HashSet.h>
+#include <algorithm>
 #include <numeric>
 
 
@@ -1070,6 +1071,15 @@ bool ColumnObject::isFinalized() const
 
 void ColumnObject::finalize()
 {
+    /// Columns deserialized from a part are already finalized and rebuilding
+    /// the subcolumns tree for them on every granule is a waste of time,
+    /// especially for objects with hundreds of paths. We can skip the work
+    /// unless there are subcolumns of type Nothing, which finalize must drop.
+    if (isFinalized()
+        && std::none_of(subcolumns.begin(), subcolumns.end(),
+            [](const auto & entry) { return isNothing(getBaseTypeOfArray(entry->data.getLeastCommonType())); }))
+        return;
+
     size_t old_size = size();
     Subcolumns new_subcolumns;
     for (auto && entry : subcolumns)
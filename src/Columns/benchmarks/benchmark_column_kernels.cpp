@@ -0,0 +1,206 @@
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
+#include <Columns/IColumn.h>
+#include <Common/assert_cast.h>
+#include <Core/Field.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/IDataType.h>
+#include <base/types.h>
+#include <benchmark/benchmark.h>
+
+#include <pcg_random.hpp>
+
+using namespace DB;
+
+/// Micro-benchmarks for the hot per-column kernels: filter at various selectivities,
+/// permute (gather), replicate, insertRangeFrom and null-mask application, across the
+/// column representations that behave differently (flat numbers, strings with offsets,
+/// nullable pairs, low cardinality indexes, arrays).
+///
+/// To catch regressions between two builds, run the comparison script:
+///     utils/column-benchmarks-compare/compare-column-benchmarks.sh
+
+static constexpr size_t ROWS = 65536;
+
+static ColumnPtr mockColumn(const DataTypePtr & type, size_t rows)
+{
+    pcg64 rng(42);
+
+    auto nested_type = removeNullable(removeLowCardinality(type));
+    auto column = type->createColumn();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        /// Some nulls / defaults interleaved, as in real data.
+        if (rng() % 100 == 0)
+        {
+            column->insertDefault();
+        }
+        else if (isStringOrFixedString(nested_type))
+        {
+            /// A small alphabet of values keeps low cardinality dictionaries realistic;
+            /// the lengths still vary enough to exercise the offsets arithmetic.
+            size_t max_length = isFixedString(nested_type) ? 16 : 32;
+            String s(1 + rng() % max_length, 'a' + static_cast<char>(rng() % 26));
+            column->insert(s);
+        }
+        else if (isFloat(nested_type))
+        {
+            column->insert(static_cast<Float64>(rng() % 10000));
+        }
+        else if (isArray(nested_type))
+        {
+            Array array(rng() % 8, static_cast<UInt64>(i));
+            column->insert(array);
+        }
+        else
+        {
+            column->insert(static_cast<UInt64>(rng() % 10000));
+        }
+    }
+    return column;
+}
+
+template <const String & str_type>
+static void BM_filter(benchmark::State & state)
+{
+    auto type = DataTypeFactory::instance().get(str_type);
+    auto src = mockColumn(type, ROWS);
+
+    const auto selectivity = static_cast<size_t>(state.range(0));
+    pcg64 rng(42);
+    IColumn::Filter filt(ROWS);
+    for (auto & value : filt)
+        value = rng() % 100 < selectivity;
+
+    for (auto _ : state)
+    {
+        auto res = src->filter(filt, -1);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+template <const String & str_type>
+static void BM_permute(benchmark::State & state)
+{
+    auto type = DataTypeFactory::instance().get(str_type);
+    auto src = mockColumn(type, ROWS);
+
+    /// A random permutation is the worst case for the gather: every access misses.
+    pcg64 rng(42);
+    IColumn::Permutation perm(ROWS);
+    for (size_t i = 0; i < ROWS; ++i)
+        perm[i] = i;
+    for (size_t i = ROWS; i > 1; --i)
+        std::swap(perm[i - 1], perm[rng() % i]);
+
+    for (auto _ : state)
+    {
+        auto res = src->permute(perm, 0);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+template <const String & str_type>
+static void BM_replicate(benchmark::State & state)
+{
+    auto type = DataTypeFactory::instance().get(str_type);
+    auto src = mockColumn(type, ROWS);
+
+    /// Offsets as produced by ARRAY JOIN: every row repeated 0..3 times.
+    pcg64 rng(42);
+    IColumn::Offsets offsets(ROWS);
+    IColumn::Offset current = 0;
+    for (auto & offset : offsets)
+    {
+        current += rng() % 4;
+        offset = current;
+    }
+
+    for (auto _ : state)
+    {
+        auto res = src->replicate(offsets);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+template <const String & str_type>
+static void BM_insertRangeFrom(benchmark::State & state)
+{
+    auto type = DataTypeFactory::instance().get(str_type);
+    auto src = mockColumn(type, ROWS);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto dst = type->createColumn();
+        dst->reserve(ROWS / 2);
+        state.ResumeTiming();
+
+        dst->insertRangeFrom(*src, ROWS / 4, ROWS / 2);
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * (ROWS / 2));
+}
+
+template <const String & str_type>
+static void BM_applyNullMap(benchmark::State & state)
+{
+    auto type = DataTypeFactory::instance().get(str_type);
+    auto src = mockColumn(type, ROWS);
+
+    pcg64 rng(42);
+    auto null_map = ColumnUInt8::create(ROWS);
+    for (auto & value : null_map->getData())
+        value = rng() % 100 < 10;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto dst = IColumn::mutate(src);
+        state.ResumeTiming();
+
+        assert_cast<ColumnNullable &>(*dst).applyNullMap(*null_map);
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+static const String type_int64 = "Int64";
+static const String type_float64 = "Float64";
+static const String type_nullable_int64 = "Nullable(Int64)";
+static const String type_string = "String";
+static const String type_fixed_string = "FixedString(16)";
+static const String type_nullable_string = "Nullable(String)";
+static const String type_low_cardinality_string = "LowCardinality(String)";
+static const String type_array_int64 = "Array(Int64)";
+
+#define FOR_EACH_MOCKED_TYPE(M) \
+    M(type_int64) \
+    M(type_float64) \
+    M(type_nullable_int64) \
+    M(type_string) \
+    M(type_fixed_string) \
+    M(type_nullable_string) \
+    M(type_low_cardinality_string) \
+    M(type_array_int64)
+
+#define REGISTER_FILTER(type_name) \
+    BENCHMARK_TEMPLATE(BM_filter, type_name)->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(99);
+FOR_EACH_MOCKED_TYPE(REGISTER_FILTER)
+
+#define REGISTER_PERMUTE(type_name) BENCHMARK_TEMPLATE(BM_permute, type_name);
+FOR_EACH_MOCKED_TYPE(REGISTER_PERMUTE)
+
+#define REGISTER_REPLICATE(type_name) BENCHMARK_TEMPLATE(BM_replicate, type_name);
+FOR_EACH_MOCKED_TYPE(REGISTER_REPLICATE)
+
+#define REGISTER_INSERT_RANGE_FROM(type_name) BENCHMARK_TEMPLATE(BM_insertRangeFrom, type_name);
+FOR_EACH_MOCKED_TYPE(REGISTER_INSERT_RANGE_FROM)
+
+BENCHMARK_TEMPLATE(BM_applyNullMap, type_nullable_int64);
+BENCHMARK_TEMPLATE(BM_applyNullMap, type_nullable_string);
@@ -0,0 +1,92 @@
+#include <vector>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/Exception.h>
+#include <Common/assert_cast.h>
+#include <Common/randomSeed.h>
+#include <Common/thread_local_rng.h>
+#include <gtest/gtest.h>
+
+using namespace DB;
+
+static pcg64 rng(randomSeed());
+static constexpr int error_code = 12345;
+static constexpr size_t TEST_RUNS = 100;
+static constexpr size_t MAX_ROWS = 10000;
+static const std::vector<size_t> filter_ratios = {1, 2, 5, 11, 32, 64, 100, 1000};
+
+/// null_ratio == 0 produces a column without a single NULL, which takes the fast path
+/// that skips filtering the null map altogether.
+static MutableColumnPtr createColumn(size_t n, size_t null_ratio)
+{
+    auto nested = ColumnUInt32::create();
+    auto null_map = ColumnUInt8::create();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        nested->insertValue(static_cast<UInt32>(i));
+        null_map->insertValue(null_ratio != 0 && rng() % null_ratio == 0);
+    }
+
+    return ColumnNullable::create(std::move(nested), std::move(null_map));
+}
+
+static bool checkFilter(const PaddedPODArray<UInt8> & filt, const IColumn & src, const IColumn & dst)
+{
+    size_t n = filt.size();
+    size_t dst_size = dst.size();
+    size_t j = 0;   /// index of dest
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (filt[i] != 0)
+        {
+            if ((dst_size <= j) || (src.compareAt(i, j, dst, 1) != 0))
+                return false;
+            j++;
+        }
+    }
+    return dst_size == j;   /// filtered size check
+}
+
+static void testFilter(size_t rows, size_t null_ratio, size_t filter_ratio)
+{
+    auto column = createColumn(rows, null_ratio);
+    PaddedPODArray<UInt8> filt(rows);
+    for (size_t i = 0; i < rows; ++i)
+        filt[i] = rng() % filter_ratio == 0;
+
+    for (ssize_t result_size_hint : {-1, 0, static_cast<ssize_t>(rows)})
+    {
+        auto res_column = column->filter(filt, result_size_hint);
+
+        const auto & res_nullable = assert_cast<const ColumnNullable &>(*res_column);
+        if (res_nullable.getNullMapData().size() != res_nullable.getNestedColumn().size())
+            throw Exception(error_code, "ColumnNullable filter produced a null map of wrong size, {} rows, null ratio {}",
+                rows, null_ratio);
+
+        if (!checkFilter(filt, *column, *res_column))
+            throw Exception(error_code, "ColumnNullable filter failure, {} rows, null ratio {}, filter ratio {}",
+                rows, null_ratio, filter_ratio);
+    }
+}
+
+TEST(ColumnNullable, Filter)
+{
+    try
+    {
+        for (size_t i = 0; i < TEST_RUNS; ++i)
+        {
+            size_t rows = rng() % MAX_ROWS + 1;
+            size_t filter_ratio = filter_ratios[rng() % filter_ratios.size()];
+
+            /// No NULLs at all, sparse NULLs and every second row NULL.
+            testFilter(rows, 0, filter_ratio);
+            testFilter(rows, 100, filter_ratio);
+            testFilter(rows, 2, filter_ratio);
+        }
+    }
+    catch (const Exception & e)
+    {
+        FAIL() << e.displayText();
+    }
+}
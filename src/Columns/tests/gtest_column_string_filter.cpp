@@ -0,0 +1,91 @@
+#include <limits>
+#include <vector>
+#include <Columns/ColumnString.h>
+#include <Common/Exception.h>
+#include <Common/randomSeed.h>
+#include <Common/thread_local_rng.h>
+#include <gtest/gtest.h>
+
+using namespace DB;
+
+static pcg64 rng(randomSeed());
+static constexpr int error_code = 12345;
+static constexpr size_t TEST_RUNS = 100;
+static constexpr size_t MAX_ROWS = 10000;
+static const std::vector<size_t> filter_ratios = {1, 2, 5, 11, 32, 64, 100, 1000};
+static const std::vector<size_t> max_lengths = {0, 1, 7, 8, 64, 300};
+
+static MutableColumnPtr createColumn(size_t n, size_t max_length)
+{
+    auto column = ColumnString::create();
+    String value;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        value.resize(rng() % (max_length + 1));
+        for (auto & c : value)
+            c = static_cast<char>('a' + rng() % 26);
+        column->insertData(value.data(), value.size());
+    }
+
+    return column;
+}
+
+static bool checkFilter(const PaddedPODArray<UInt8> & filt, const IColumn & src, const IColumn & dst)
+{
+    size_t n = filt.size();
+    size_t dst_size = dst.size();
+    size_t j = 0;   /// index of dest
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (filt[i] != 0)
+        {
+            if ((dst_size <= j) || (src.compareAt(i, j, dst, 0) != 0))
+                return false;
+            j++;
+        }
+    }
+    return dst_size == j;   /// filtered size check
+}
+
+/// The filter kernel processes the mask in 64-row blocks with special cases for
+/// fully zero and fully set blocks, so it is tested with degenerate filters too.
+static void testFilter(size_t rows, size_t max_length, size_t filter_ratio)
+{
+    auto column = createColumn(rows, max_length);
+    PaddedPODArray<UInt8> filt(rows);
+    for (size_t i = 0; i < rows; ++i)
+        filt[i] = filter_ratio == 0 ? 1 : (rng() % filter_ratio == 0);
+
+    for (ssize_t result_size_hint : {-1, 0, static_cast<ssize_t>(rows)})
+    {
+        auto res_column = column->filter(filt, result_size_hint);
+
+        if (!checkFilter(filt, *column, *res_column))
+            throw Exception(error_code, "ColumnString filter failure, {} rows, max length {}, filter ratio {}",
+                rows, max_length, filter_ratio);
+    }
+}
+
+TEST(ColumnString, Filter)
+{
+    try
+    {
+        for (size_t i = 0; i < TEST_RUNS; ++i)
+        {
+            size_t rows = rng() % MAX_ROWS + 1;
+            size_t max_length = max_lengths[rng() % max_lengths.size()];
+            size_t filter_ratio = filter_ratios[rng() % filter_ratios.size()];
+
+            testFilter(rows, max_length, filter_ratio);
+
+            /// All rows pass (blocks of fully set mask bits) and no rows pass (fully zero blocks).
+            testFilter(rows, max_length, 0);
+            testFilter(rows, max_length, std::numeric_limits<size_t>::max());
+        }
+    }
+    catch (const Exception & e)
+    {
+        FAIL() << e.displayText();
+    }
+}
@@ -17,6 +17,7 @@
 #include "config.h"
 
 #if USE_JEMALLOC
+#    include <Common/Jemalloc.h>
 #    include <jemalloc/jemalloc.h>
 #endif
 
@@ -57,10 +58,12 @@ static std::unique_ptr<ReadBufferFromFilePRead> openFileIfExists(const std::stri
 
 AsynchronousMetrics::AsynchronousMetrics(
     unsigned update_period_seconds,
-    const ProtocolServerMetricsFunc & protocol_server_metrics_func_)
+    const ProtocolServerMetricsFunc & protocol_server_metrics_func_,
+    double allocator_purge_rss_excess_ratio_)
     : update_period(update_period_seconds)
     , log(getLogger("AsynchronousMetrics"))
     , protocol_server_metrics_func(protocol_server_metrics_func_)
+    , allocator_purge_rss_excess_ratio(allocator_purge_rss_excess_ratio_)
 {
 #if defined(OS_LINUX)
     openFileIfExists("/proc/meminfo", meminfo);
@@ -597,8 +600,8 @@ void AsynchronousMetrics::update(TimePoint update_time, bool force_update)
     new_values["jemalloc.epoch"] = { epoch, "An internal incremental update number of the statistics of jemalloc (Jason Evans' memory allocator), used in all other `jemalloc` metrics." };
 
     // Collect the statistics themselves.
-    saveJemallocMetric<size_t>(new_values, "allocated");
-    saveJemallocMetric<size_t>(new_values, "active");
+    size_t je_malloc_allocated = saveJemallocMetric<size_t>(new_values, "allocated");
+    size_t je_malloc_active = saveJemallocMetric<size_t>(new_values, "active");
     saveJemallocMetric<size_t>(new_values, "metadata");
     saveJemallocMetric<size_t>(new_values, "metadata_thp");
     saveJemallocMetric<size_t>(new_values, "resident");
@@ -612,6 +615,11 @@ void AsynchronousMetrics::update(TimePoint update_time, bool force_update)
     [[maybe_unused]] size_t je_malloc_pmuzzy = saveAllArenasMetric<size_t>(new_values, "pmuzzy");
     saveAllArenasMetric<size_t>(new_values, "dirty_purged");
     saveAllArenasMetric<size_t>(new_values, "muzzy_purged");
+
+    if (je_malloc_active >= je_malloc_allocated)
+        new_values["jemalloc.fragmentation_bytes"] = { je_malloc_active - je_malloc_allocated,
+            "The amount of memory in pages actively used by jemalloc but not occupied by application allocations (stats.active minus stats.allocated), in bytes."
+            " This memory is invisible to the server memory tracker and is the allocator fragmentation component of the difference between process RSS and the MemoryTracking metric." };
 #endif
 
     /// Process process memory usage according to OS
@@ -672,6 +680,22 @@ void AsynchronousMetrics::update(TimePoint update_time, bool force_update)
                     ReadableSize(difference));
 
             MemoryTracker::setRSS(rss, free_memory_in_allocator_arenas);
+
+#if USE_JEMALLOC
+            /// A simple feedback loop for the allocator: the part of RSS that is not
+            /// accounted by the memory tracker is fragmentation and decayed pages held
+            /// by jemalloc. Purging returns them to the OS without waiting for the decay
+            /// timers, which matters most when the server is close to the OOM killer.
+            if (allocator_purge_rss_excess_ratio > 0.
+                && rss - amount > static_cast<Int64>(allocator_purge_rss_excess_ratio * static_cast<double>(rss))
+                && update_time - last_allocator_purge_time >= allocator_purge_cooldown)
+            {
+                LOG_INFO(log, "RSS ({}) exceeds tracked memory ({}) by more than {} of RSS, purging unused allocator memory",
+                    ReadableSize(rss), ReadableSize(amount), allocator_purge_rss_excess_ratio);
+                purgeJemallocArenas();
+                last_allocator_purge_time = update_time;
+            }
+#endif
         }
     }
 
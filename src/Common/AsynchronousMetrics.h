@@ -68,7 +68,8 @@ public:
 
     AsynchronousMetrics(
         unsigned update_period_seconds,
-        const ProtocolServerMetricsFunc & protocol_server_metrics_func_);
+        const ProtocolServerMetricsFunc & protocol_server_metrics_func_,
+        double allocator_purge_rss_excess_ratio_ = 0.);
 
     virtual ~AsynchronousMetrics();
 
@@ -105,6 +106,12 @@ private:
     bool first_run TSA_GUARDED_BY(data_mutex) = true;
     TimePoint previous_update_time TSA_GUARDED_BY(data_mutex);
 
+    /// If positive, unused allocator memory is purged back to the OS when the part of RSS
+    /// that is not accounted by the memory tracker exceeds this ratio of RSS. See update().
+    const double allocator_purge_rss_excess_ratio = 0.;
+    static constexpr auto allocator_purge_cooldown = std::chrono::seconds(60);
+    TimePoint last_allocator_purge_time TSA_GUARDED_BY(data_mutex);
+
     AsynchronousMetricValues values TSA_GUARDED_BY(data_mutex);
 
 #if defined(OS_LINUX) || defined(OS_FREEBSD)
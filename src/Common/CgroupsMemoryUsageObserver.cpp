@@ -5,6 +5,7 @@
 #include <Common/setThreadName.h>
 #include <Common/logger_useful.h>
 #include <Common/formatReadable.h>
+#include <Common/getNumberOfPhysicalCPUCores.h>
 #include <IO/ReadBufferFromFile.h>
 #include <IO/ReadBufferFromFileDescriptor.h>
 #include <IO/ReadHelpers.h>
@@ -104,6 +105,12 @@ void CgroupsMemoryUsageObserver::setOnMemoryAmountAvailableChangedFn(OnMemoryAmo
     on_memory_amount_available_changed = on_memory_amount_available_changed_;
 }
 
+void CgroupsMemoryUsageObserver::setOnCPUAmountAvailableChangedFn(OnCPUAmountAvailableChangedFn on_cpu_amount_available_changed_)
+{
+    std::lock_guard<std::mutex> cpu_amount_available_changed_lock(cpu_amount_available_changed_mutex);
+    on_cpu_amount_available_changed = on_cpu_amount_available_changed_;
+}
+
 namespace
 {
 
@@ -281,6 +288,9 @@ void CgroupsMemoryUsageObserver::runThread()
     last_available_memory_amount = getMemoryAmount();
     LOG_INFO(log, "Memory amount initially available to the process is {}", ReadableSize(last_available_memory_amount));
 
+    last_available_cpu_cores = getNumberOfPhysicalCPUCoresUncached();
+    LOG_INFO(log, "Number of CPU cores initially available to the process is {}", last_available_cpu_cores);
+
     std::unique_lock lock(thread_mutex);
     while (true)
     {
@@ -298,6 +308,16 @@ void CgroupsMemoryUsageObserver::runThread()
                 on_memory_amount_available_changed();
             }
 
+            unsigned available_cpu_cores = getNumberOfPhysicalCPUCoresUncached();
+            if (available_cpu_cores != last_available_cpu_cores)
+            {
+                LOG_INFO(log, "Number of CPU cores available to the process changed from {} to {}", last_available_cpu_cores, available_cpu_cores);
+                last_available_cpu_cores = available_cpu_cores;
+                std::lock_guard<std::mutex> cpu_amount_available_changed_lock(cpu_amount_available_changed_mutex);
+                if (on_cpu_amount_available_changed)
+                    on_cpu_amount_available_changed();
+            }
+
             std::lock_guard<std::mutex> limit_lock(limit_mutex);
             if (soft_limit > 0 && hard_limit > 0)
             {
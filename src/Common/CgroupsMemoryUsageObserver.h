@@ -23,12 +23,16 @@ namespace DB
 ///    The goal of this is to provide elasticity when the container is scaled-up/scaled-down. The mechanism (polling
 ///    cgroups) is quite implicit, unfortunately there is currently no better way to communicate memory threshold changes
 ///    to the database.
+/// 3. Periodically reads the number of CPU cores available to the process (CFS quota and cpuset can also change at
+///    runtime due to cgroups settings). The callback typically reloads the configuration as well, so thread pool and
+///    concurrency limits derived from the core count follow vertical scaling of the container.
 #if defined(OS_LINUX)
 class CgroupsMemoryUsageObserver
 {
 public:
     using OnMemoryLimitFn = std::function<void(bool)>;
     using OnMemoryAmountAvailableChangedFn = std::function<void()>;
+    using OnCPUAmountAvailableChangedFn = std::function<void()>;
 
     enum class CgroupsVersion : uint8_t
     {
@@ -41,6 +45,7 @@ public:
 
     void setMemoryUsageLimits(uint64_t hard_limit_, uint64_t soft_limit_);
     void setOnMemoryAmountAvailableChangedFn(OnMemoryAmountAvailableChangedFn on_memory_amount_available_changed_);
+    void setOnCPUAmountAvailableChangedFn(OnCPUAmountAvailableChangedFn on_cpu_amount_available_changed_);
 
     void startThread();
 
@@ -58,8 +63,12 @@ private:
     std::mutex memory_amount_available_changed_mutex;
     OnMemoryAmountAvailableChangedFn on_memory_amount_available_changed TSA_GUARDED_BY(memory_amount_available_changed_mutex);
 
+    std::mutex cpu_amount_available_changed_mutex;
+    OnCPUAmountAvailableChangedFn on_cpu_amount_available_changed TSA_GUARDED_BY(cpu_amount_available_changed_mutex);
+
     uint64_t last_memory_usage = 0;        /// how much memory does the process use
     uint64_t last_available_memory_amount; /// how much memory can the process use
+    unsigned last_available_cpu_cores = 0; /// how many CPU cores can the process use
 
     /// Represents the cgroup virtual file that shows the memory consumption of the process's cgroup.
     struct MemoryUsageFile
@@ -92,11 +101,13 @@ private:
 class CgroupsMemoryUsageObserver
 {
     using OnMemoryAmountAvailableChangedFn = std::function<void()>;
+    using OnCPUAmountAvailableChangedFn = std::function<void()>;
 public:
     explicit CgroupsMemoryUsageObserver(std::chrono::seconds) {}
 
     void setMemoryUsageLimits(uint64_t, uint64_t) {}
     void setOnMemoryAmountAvailableChangedFn(OnMemoryAmountAvailableChangedFn) {}
+    void setOnCPUAmountAvailableChangedFn(OnCPUAmountAvailableChangedFn) {}
     void startThread() {}
 };
 #endif
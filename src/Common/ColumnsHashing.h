@@ -699,6 +699,19 @@ struct HashMethodSerialized
     std::vector<const UInt8 *> null_maps;
     PaddedPODArray<UInt64> row_sizes;
 
+    /// Packing plan specialized for the concrete key column types: when every key column is
+    /// either fixed-size-and-contiguous or a plain String, keys are packed with raw memcpy
+    /// from these precomputed pointers instead of a virtual serialization call per key per row.
+    struct FlatKeyDescriptor
+    {
+        const char * data = nullptr;                    /// for fixed-size values
+        const ColumnString::Char * chars = nullptr;     /// for strings
+        const ColumnString::Offset * offsets = nullptr;
+        size_t fixed_size = 0;                          /// zero for strings
+    };
+    std::vector<FlatKeyDescriptor> flat_keys;
+    bool use_flat_pack = false;
+
     HashMethodSerialized(const ColumnRawPtrs & key_columns_, const Sizes & /*key_sizes*/, const HashMethodContextPtr &)
         : key_columns(key_columns_), keys_size(key_columns_.size())
     {
@@ -720,6 +733,32 @@ struct HashMethodSerialized
             null_maps.resize(keys_size);
             for (size_t i = 0; i < keys_size; ++i)
                 key_columns[i]->collectSerializedValueSizes(row_sizes, null_maps[i]);
+
+            if constexpr (!nullable)
+            {
+                use_flat_pack = true;
+                flat_keys.reserve(keys_size);
+                for (size_t i = 0; i < keys_size; ++i)
+                {
+                    FlatKeyDescriptor descriptor;
+                    if (const auto * column_string = checkAndGetColumn<ColumnString>(key_columns[i]))
+                    {
+                        descriptor.chars = column_string->getChars().data();
+                        descriptor.offsets = column_string->getOffsets().data();
+                    }
+                    else if (key_columns[i]->isFixedAndContiguous())
+                    {
+                        descriptor.data = key_columns[i]->getRawData().data();
+                        descriptor.fixed_size = key_columns[i]->sizeOfValueIfFixed();
+                    }
+                    else
+                    {
+                        use_flat_pack = false;
+                        break;
+                    }
+                    flat_keys.push_back(descriptor);
+                }
+            }
         }
     }
 
@@ -733,6 +772,31 @@ struct HashMethodSerialized
 
             char * memory = pool.allocContinue(row_sizes[row], begin);
             StringRef key(memory, row_sizes[row]);
+
+            if (use_flat_pack)
+            {
+                for (const auto & descriptor : flat_keys)
+                {
+                    if (descriptor.fixed_size)
+                    {
+                        memcpy(memory, descriptor.data + row * descriptor.fixed_size, descriptor.fixed_size);
+                        memory += descriptor.fixed_size;
+                    }
+                    else
+                    {
+                        /// The same format as ColumnString::serializeValueIntoMemory:
+                        /// length (including the terminating zero byte), then the bytes.
+                        size_t string_size = descriptor.offsets[row] - descriptor.offsets[row - 1];
+                        memcpy(memory, &string_size, sizeof(string_size));
+                        memory += sizeof(string_size);
+                        memcpy(memory, &descriptor.chars[descriptor.offsets[row - 1]], string_size);
+                        memory += string_size;
+                    }
+                }
+
+                return SerializedKeyHolder{key, pool};
+            }
+
             for (size_t j = 0; j < keys_size; ++j)
             {
                 if constexpr (nullable)
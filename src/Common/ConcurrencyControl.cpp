@@ -52,6 +52,21 @@ SlotCount ConcurrencyControl::Allocation::allocatedCount() const
     return allocated;
 }
 
+bool ConcurrencyControl::Allocation::isPreemptionRequested() const
+{
+    // Lock-free fast path for the common case of no waiters
+    size_t waiter_count = parent.waiter_count.load(std::memory_order_relaxed);
+    if (waiter_count == 0)
+        return false;
+
+    // An allocation that is waiting itself should not release slots: through the round-robin
+    // they would only be churned between the waiters without helping anyone.
+    std::unique_lock lock{mutex};
+    if (allocated < limit)
+        return waiter_count > 1;
+    return true;
+}
+
 ConcurrencyControl::Allocation::Allocation(ConcurrencyControl & parent_, SlotCount limit_, SlotCount granted_, Waiters::iterator waiter_)
     : parent(parent_)
     , limit(limit_)
@@ -106,8 +121,11 @@ ConcurrencyControl::~ConcurrencyControl()
 
     // Create allocation and start waiting if more slots are required
     if (granted < max)
-        return SlotAllocationPtr(new Allocation(*this, max, granted,
-            waiters.insert(cur_waiter, nullptr /* pointer is set by Allocation ctor */)));
+    {
+        auto waiter = waiters.insert(cur_waiter, nullptr /* pointer is set by Allocation ctor */);
+        waiter_count.store(waiters.size(), std::memory_order_relaxed);
+        return SlotAllocationPtr(new Allocation(*this, max, granted, waiter));
+    }
     else
         return SlotAllocationPtr(new Allocation(*this, max, granted));
 }
@@ -119,6 +137,12 @@ void ConcurrencyControl::setMaxConcurrency(SlotCount value)
     schedule(lock);
 }
 
+SlotCount ConcurrencyControl::getAvailableSlots()
+{
+    std::unique_lock lock{mutex};
+    return available(lock);
+}
+
 ConcurrencyControl & ConcurrencyControl::instance()
 {
     static ConcurrencyControl result;
@@ -141,6 +165,7 @@ void ConcurrencyControl::free(Allocation * allocation)
             cur_waiter = waiters.erase(*waiter);
         else
             waiters.erase(*waiter);
+        waiter_count.store(waiters.size(), std::memory_order_relaxed);
     }
     schedule(lock);
 }
@@ -164,7 +189,10 @@ void ConcurrencyControl::schedule(std::unique_lock<std::mutex> &)
         if (allocation->grant())
             ++cur_waiter;
         else
+        {
             cur_waiter = waiters.erase(cur_waiter); // last required slot has just been granted -- stop waiting
+            waiter_count.store(waiters.size(), std::memory_order_relaxed);
+        }
     }
 }
 
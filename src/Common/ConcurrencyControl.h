@@ -32,6 +32,8 @@ namespace DB
  * (both functions are non-blocking)
  *
  * Released slots are distributed between waiting allocations in a round-robin manner to provide fairness.
+ * While allocations are waiting, `Allocation::isPreemptionRequested()` returns true for the other allocations,
+ * asking cooperative slot holders to release acquired slots early (see `PipelineExecutor`).
  * Oversubscription is possible: total amount of allocated slots can exceed `setMaxConcurrency(limit)`
  * because `min` amount of slots is allocated for each query unconditionally.
  */
@@ -65,6 +67,9 @@ public:
         SlotCount grantedCount() const override;
         SlotCount allocatedCount() const override;
 
+        // True if other allocations are waiting for slots and this one could help by releasing an acquired slot
+        bool isPreemptionRequested() const override;
+
     private:
         friend struct Slot; // for release()
         friend class ConcurrencyControl; // for grant(), free() and ctor
@@ -111,6 +116,11 @@ public:
 
     void setMaxConcurrency(SlotCount value);
 
+    // Best-effort snapshot of the number of currently free slots. Used to size IO pipelines
+    // (e.g. prefetch depth) to the concurrency a query can realistically achieve, not to
+    // reserve anything: the returned value may be outdated immediately.
+    SlotCount getAvailableSlots();
+
     static ConcurrencyControl & instance();
 
 private:
@@ -130,6 +140,10 @@ private:
     Waiters::iterator cur_waiter; // round-robin pointer
     SlotCount max_concurrency = UnlimitedSlots;
     SlotCount cur_concurrency = 0;
+
+    // Number of elements in `waiters`, duplicated into an atomic for the lock-free
+    // fast path of Allocation::isPreemptionRequested(), which is polled by executors.
+    std::atomic<size_t> waiter_count{0};
 };
 
 }
@@ -80,12 +80,18 @@
     M(MergeTreeDataSelectExecutorThreads, "Number of threads in the MergeTreeDataSelectExecutor thread pool.") \
     M(MergeTreeDataSelectExecutorThreadsActive, "Number of threads in the MergeTreeDataSelectExecutor thread pool running a task.") \
     M(MergeTreeDataSelectExecutorThreadsScheduled, "Number of queued or active jobs in the MergeTreeDataSelectExecutor thread pool.") \
+    M(MergeTreeVerticalMergeThreads, "Number of threads in the thread pool gathering columns of a Vertical merge.") \
+    M(MergeTreeVerticalMergeThreadsActive, "Number of threads in the thread pool gathering columns of a Vertical merge running a task.") \
+    M(MergeTreeVerticalMergeThreadsScheduled, "Number of queued or active jobs in the thread pool gathering columns of a Vertical merge.") \
     M(BackupsThreads, "Number of threads in the thread pool for BACKUP.") \
     M(BackupsThreadsActive, "Number of threads in thread pool for BACKUP running a task.") \
     M(BackupsThreadsScheduled, "Number of queued or active jobs for BACKUP.") \
     M(RestoreThreads, "Number of threads in the thread pool for RESTORE.") \
     M(RestoreThreadsActive, "Number of threads in the thread pool for RESTORE running a task.") \
     M(RestoreThreadsScheduled, "Number of queued or active jobs for RESTORE.") \
+    M(StorageSetOrJoinRestoreThreads, "Number of threads in the thread pool restoring Set/Join storages from backup files.") \
+    M(StorageSetOrJoinRestoreThreadsActive, "Number of threads in the thread pool restoring Set/Join storages from backup files running a task.") \
+    M(StorageSetOrJoinRestoreThreadsScheduled, "Number of queued or active jobs in the thread pool restoring Set/Join storages from backup files.") \
     M(MarksLoaderThreads, "Number of threads in thread pool for loading marks.") \
     M(MarksLoaderThreadsActive, "Number of threads in the thread pool for loading marks running a task.") \
     M(MarksLoaderThreadsScheduled, "Number of queued or active jobs in the thread pool for loading marks.") \
@@ -95,6 +101,9 @@
     M(IOWriterThreads, "Number of threads in the IO writer thread pool.") \
     M(IOWriterThreadsActive, "Number of threads in the IO writer thread pool running a task.") \
     M(IOWriterThreadsScheduled, "Number of queued or active jobs in the IO writer thread pool.") \
+    M(MergeTreePartFinalizeThreads, "Number of threads in the MergeTree part finalize thread pool.") \
+    M(MergeTreePartFinalizeThreadsActive, "Number of threads in the MergeTree part finalize thread pool running a task.") \
+    M(MergeTreePartFinalizeThreadsScheduled, "Number of queued or active jobs in the MergeTree part finalize thread pool.") \
     M(IOThreads, "Number of threads in the IO thread pool.") \
     M(IOThreadsActive, "Number of threads in the IO thread pool running a task.") \
     M(IOThreadsScheduled, "Number of queued or active jobs in the IO thread pool.") \
@@ -215,6 +224,15 @@
     M(ParquetEncoderThreads, "Number of threads in ParquetBlockOutputFormat thread pool.") \
     M(ParquetEncoderThreadsActive, "Number of threads in ParquetBlockOutputFormat thread pool running a task.") \
     M(ParquetEncoderThreadsScheduled, "Number of queued or active jobs in ParquetBlockOutputFormat thread pool.") \
+    M(AvroDecoderThreads, "Number of threads in the AvroParallelBlockInputFormat thread pool.") \
+    M(AvroDecoderThreadsActive, "Number of threads in the AvroParallelBlockInputFormat thread pool running a task.") \
+    M(AvroDecoderThreadsScheduled, "Number of queued or active jobs in the AvroParallelBlockInputFormat thread pool.") \
+    M(ORCDecoderThreads, "Number of threads in the ORCBlockInputFormat thread pool.") \
+    M(ORCDecoderThreadsActive, "Number of threads in the ORCBlockInputFormat thread pool running a task.") \
+    M(ORCDecoderThreadsScheduled, "Number of queued or active jobs in the ORCBlockInputFormat thread pool.") \
+    M(ExternalSortReadAheadThreads, "Number of threads in the external sort spill read-ahead thread pool.") \
+    M(ExternalSortReadAheadThreadsActive, "Number of threads in the external sort spill read-ahead thread pool running a task.") \
+    M(ExternalSortReadAheadThreadsScheduled, "Number of queued or active jobs in the external sort spill read-ahead thread pool.") \
     M(DWARFReaderThreads, "Number of threads in the DWARFBlockInputFormat thread pool.") \
     M(DWARFReaderThreadsActive, "Number of threads in the DWARFBlockInputFormat thread pool running a task.") \
     M(DWARFReaderThreadsScheduled, "Number of queued or active jobs in the DWARFBlockInputFormat thread pool.") \
@@ -242,6 +260,9 @@
     M(PartsDeleteOnDestroy, "Part was moved to another disk and should be deleted in own destructor.") \
     M(PartsWide, "Wide parts.") \
     M(PartsCompact, "Compact parts.") \
+    M(MergeTreeActiveDataBytes, "Total size in bytes (compressed, including data and indices) of active parts across all tables of MergeTree family. Maintained incrementally on part state changes, so reading it does not require iterating over tables.") \
+    M(MergeTreeActiveDataRows, "Total number of rows in active parts across all tables of MergeTree family. Maintained incrementally on part state changes.") \
+    M(MergeTreeActiveDataParts, "Total number of active parts across all tables of MergeTree family. Maintained incrementally on part state changes.") \
     M(MMappedFiles, "Total number of mmapped files.") \
     M(MMappedFileBytes, "Sum size of mmapped file regions.") \
     M(AsynchronousReadWait, "Number of threads waiting for asynchronous read.") \
@@ -267,6 +288,9 @@
     M(S3Requests, "S3 requests count") \
     M(KeeperAliveConnections, "Number of alive connections") \
     M(KeeperOutstandingRequets, "Number of outstanding requests") \
+    M(KeeperSnapshotSerializationThreads, "Number of threads in the Keeper snapshot serialization thread pool.") \
+    M(KeeperSnapshotSerializationThreadsActive, "Number of threads in the Keeper snapshot serialization thread pool running a task.") \
+    M(KeeperSnapshotSerializationThreadsScheduled, "Number of queued or active jobs in the Keeper snapshot serialization thread pool.") \
     M(ThreadsInOvercommitTracker, "Number of waiting threads inside of OvercommitTracker") \
     M(IOUringPendingEvents, "Number of io_uring SQEs waiting to be submitted") \
     M(IOUringInFlightEvents, "Number of io_uring SQEs in flight") \
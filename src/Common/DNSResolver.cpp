@@ -11,6 +11,7 @@
 #include <Poco/NumberParser.h>
 #include <atomic>
 #include <optional>
+#include <random>
 #include <string_view>
 #include <unordered_set>
 #include "DNSPTRResolverProvider.h"
@@ -196,6 +197,10 @@ struct DNSResolver::Impl
 
     /// If disabled, will not make cache lookups, will resolve addresses manually on each call
     std::atomic<bool> disable_cache{false};
+
+    /// The period of updateCache() calls; used to skip recently resolved hosts with a
+    /// randomized threshold. Written and read only under update_mutex.
+    Int32 cache_refresh_period_seconds = 0;
 };
 
 
@@ -380,7 +385,7 @@ bool DNSResolver::updateCacheImpl(
     return updated;
 }
 
-bool DNSResolver::updateCache(UInt32 max_consecutive_failures)
+bool DNSResolver::updateCache(UInt32 max_consecutive_failures, Int32 refresh_period_seconds)
 {
     LOG_DEBUG(log, "Updating DNS cache");
 
@@ -404,6 +409,8 @@ bool DNSResolver::updateCache(UInt32 max_consecutive_failures)
     /// DROP DNS CACHE will wait on update_mutex (possibly while holding drop_mutex)
     std::lock_guard lock(impl->update_mutex);
 
+    impl->cache_refresh_period_seconds = refresh_period_seconds;
+
     bool hosts_updated = updateCacheImpl(
         &DNSResolver::updateHost, impl->known_hosts, max_consecutive_failures, "Cached hosts not found: {}", "Cached hosts dropped: {}");
     updateCacheImpl(
@@ -419,6 +426,20 @@ bool DNSResolver::updateCache(UInt32 max_consecutive_failures)
 
 bool DNSResolver::updateHost(const String & host)
 {
+    /// Skip hosts that were resolved recently. The threshold is randomized per host and
+    /// per cycle ("TTL jitter"), so that the refreshes of different hosts spread out in
+    /// time instead of hitting the resolvers all at once on every update.
+    if (impl->cache_refresh_period_seconds > 0)
+    {
+        if (auto entry = impl->cache_host.get(host))
+        {
+            const auto age = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - entry->cached_at).count();
+            std::uniform_real_distribution<double> min_age_fraction(0.5, 1.0);
+            if (age < impl->cache_refresh_period_seconds * min_age_fraction(thread_local_rng))
+                return false;
+        }
+    }
+
     const auto old_value = resolveIPAddressWithCache(impl->cache_host, host);
     auto new_value = resolveIPAddressImpl(host);
     const bool result = old_value != new_value;
@@ -65,8 +65,11 @@ public:
     void removeHostFromCache(const std::string & host);
 
     /// Updates all known hosts in cache.
+    /// If refresh_period_seconds is non-zero, hosts whose entries are younger than a
+    /// randomized fraction of the period are skipped, so that refreshes of different hosts
+    /// spread out in time instead of all expiring at once ("TTL jitter").
     /// Returns true if IP of any host has been changed or an element was dropped (too many failures)
-    bool updateCache(UInt32 max_consecutive_failures);
+    bool updateCache(UInt32 max_consecutive_failures, Int32 refresh_period_seconds = 0);
 
     /// Returns a copy of cache entries
     std::vector<std::pair<std::string, CacheEntry>> cacheEntries() const;
@@ -577,6 +577,20 @@ public:
         return res + offset_at_start_of_epoch;
     }
 
+    /** Fills [range_begin, range_end) - the timestamps belonging to the calendar day of `t` in this
+      * time zone. Within this range the in-day interval transforms (toStartOfHour and friends) are
+      * plain arithmetic anchored at range_begin (see toStartOfMinuteInterval and roundDown), so
+      * consecutive timestamps of sorted data can be transformed without further lookups. An empty
+      * range (range_end <= t) is returned for the values saturated at the LUT boundaries.
+      */
+    void getDayRange(Time t, Time & range_begin, Time & range_end) const
+    {
+        const LUTIndex index = findIndex(t);
+
+        range_begin = lut[index].date;
+        range_end = lut[index + 1].date;
+    }
+
 
     unsigned toSecond(Time t) const
     {
@@ -602,6 +602,7 @@
     M(721, DEPRECATED_FUNCTION) \
     M(722, ASYNC_LOAD_WAIT_FAILED) \
     M(723, PARQUET_EXCEPTION) \
+    M(724, CANNOT_SET_THREAD_AFFINITY) \
     \
     M(900, DISTRIBUTED_CACHE_ERROR) \
     M(901, CANNOT_USE_DISTRIBUTED_CACHE) \
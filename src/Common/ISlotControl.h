@@ -59,6 +59,11 @@ public:
 
     /// Returns the total number of slots allocated at the moment (acquired and granted)
     virtual SlotCount allocatedCount() const = 0;
+
+    /// Returns true if the controller wants a slot back for another waiting allocation.
+    /// A cooperative holder releases one of its acquired slots at the next natural boundary
+    /// (e.g. after the current task), keeping at least one slot to guarantee progress.
+    virtual bool isPreemptionRequested() const { return false; }
 };
 
 using SlotAllocationPtr = std::shared_ptr<ISlotAllocation>;
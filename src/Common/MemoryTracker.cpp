@@ -7,6 +7,7 @@
 #include <Common/MemoryTrackerBlockerInThread.h>
 #include <Common/OvercommitTracker.h>
 #include <Common/ProfileEvents.h>
+#include <Common/SpillManager.h>
 #include <Common/Stopwatch.h>
 #include <Common/ThreadStatus.h>
 #include <Common/TraceSender.h>
@@ -320,6 +321,19 @@ AllocationTrace MemoryTracker::allocImpl(Int64 size, bool throw_if_memory_exceed
     }
 #endif
 
+    /// Above the soft limit, ask spillable operators (aggregations, sorts) to move data
+    /// to disk cooperatively before the hard limit turns allocations into exceptions.
+    if (level == VariableContext::Global)
+    {
+        Int64 current_soft_limit = soft_limit.load(std::memory_order_relaxed);
+        if (unlikely(current_soft_limit && will_be > current_soft_limit))
+        {
+            /// Prevent recursion: the manager itself allocates.
+            MemoryTrackerBlockerInThread blocker(VariableContext::Global);
+            DB::SpillManager::instance().onMemoryPressure(will_be - current_soft_limit);
+        }
+    }
+
     if (unlikely(current_hard_limit && will_be > limit_to_check))
     {
         if (memoryTrackerCanThrow(level, false) && throw_if_memory_exceeded)
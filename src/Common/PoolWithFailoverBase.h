@@ -106,6 +106,11 @@ public:
     /// this functor. The pools with lower result value will be tried first.
     using GetPriorityFunc = std::function<Priority(size_t index)>;
 
+    /// The client can provide this functor to report pools whose endpoints are known to be
+    /// unreachable (e.g. from background health probes). Such pools are tried last, but are
+    /// not excluded: the reachability state may be stale.
+    using CheckUnreachableFunc = std::function<bool(size_t index)>;
+
     /// Returns at least min_entries and at most max_entries connections (at most one connection per nested pool).
     /// The method will throw if it is unable to get min_entries alive connections or
     /// if fallback_to_stale_replicas is false and it is unable to get min_entries connections to up-to-date replicas.
@@ -115,7 +120,8 @@ public:
             bool fallback_to_stale_replicas,
             bool skip_read_only_replicas,
             const TryGetEntryFunc & try_get_entry,
-            const GetPriorityFunc & get_priority);
+            const GetPriorityFunc & get_priority,
+            const CheckUnreachableFunc & is_unreachable = {});
 
     size_t getPoolSize() const { return nested_pools.size(); }
 
@@ -123,14 +129,19 @@ protected:
 
     /// Returns a single connection.
     Entry get(size_t max_ignored_errors, bool fallback_to_stale_replicas,
-        const TryGetEntryFunc & try_get_entry, const GetPriorityFunc & get_priority = GetPriorityFunc());
+        const TryGetEntryFunc & try_get_entry, const GetPriorityFunc & get_priority = GetPriorityFunc(),
+        const CheckUnreachableFunc & is_unreachable = {});
 
     /// This function returns a copy of pool states to avoid race conditions when modifying shared pool states.
     PoolStates updatePoolStates(size_t max_ignored_errors);
 
     void updateErrorCounts(PoolStates & states, time_t & last_decrease_time) const;
 
-    std::vector<ShuffledPool> getShuffledPools(size_t max_ignored_errors, const GetPriorityFunc & get_priority, bool use_slowdown_count = false);
+    std::vector<ShuffledPool> getShuffledPools(
+        size_t max_ignored_errors,
+        const GetPriorityFunc & get_priority,
+        bool use_slowdown_count = false,
+        const CheckUnreachableFunc & is_unreachable = {});
 
     inline void updateSharedErrorCounts(std::vector<ShuffledPool> & shuffled_pools);
 
@@ -157,7 +168,10 @@ protected:
 template <typename TNestedPool>
 std::vector<typename PoolWithFailoverBase<TNestedPool>::ShuffledPool>
 PoolWithFailoverBase<TNestedPool>::getShuffledPools(
-    size_t max_ignored_errors, const PoolWithFailoverBase::GetPriorityFunc & get_priority, bool use_slowdown_count)
+    size_t max_ignored_errors,
+    const PoolWithFailoverBase::GetPriorityFunc & get_priority,
+    bool use_slowdown_count,
+    const PoolWithFailoverBase::CheckUnreachableFunc & is_unreachable)
 {
     /// Update random numbers and error counts.
     PoolStates pool_states = updatePoolStates(max_ignored_errors);
@@ -166,6 +180,11 @@ PoolWithFailoverBase<TNestedPool>::getShuffledPools(
         for (size_t i = 0; i < pool_states.size(); ++i)
             pool_states[i].priority = get_priority(i);
     }
+    if (is_unreachable)
+    {
+        for (size_t i = 0; i < pool_states.size(); ++i)
+            pool_states[i].unreachable = is_unreachable(i);
+    }
 
     /// Sort the pools into order in which they will be tried (based on respective PoolStates).
     /// Note that `error_count` and `slowdown_count` are used for ordering, but set to zero in the resulting ShuffledPool
@@ -199,7 +218,8 @@ inline void PoolWithFailoverBase<TNestedPool>::updateSharedErrorCounts(std::vect
 template <typename TNestedPool>
 typename TNestedPool::Entry
 PoolWithFailoverBase<TNestedPool>::get(size_t max_ignored_errors, bool fallback_to_stale_replicas,
-    const TryGetEntryFunc & try_get_entry, const GetPriorityFunc & get_priority)
+    const TryGetEntryFunc & try_get_entry, const GetPriorityFunc & get_priority,
+    const CheckUnreachableFunc & is_unreachable)
 {
     std::vector<TryResult> results = getMany(
         /* min_entries= */ 1,
@@ -208,7 +228,7 @@ PoolWithFailoverBase<TNestedPool>::get(size_t max_ignored_errors, bool fallback_
         max_ignored_errors,
         fallback_to_stale_replicas,
         /* skip_read_only_replicas= */ false,
-        try_get_entry, get_priority);
+        try_get_entry, get_priority, is_unreachable);
     if (results.empty() || results[0].entry.isNull())
         throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR,
                 "PoolWithFailoverBase::getMany() returned less than min_entries entries.");
@@ -223,9 +243,10 @@ PoolWithFailoverBase<TNestedPool>::getMany(
         bool fallback_to_stale_replicas,
         bool skip_read_only_replicas,
         const TryGetEntryFunc & try_get_entry,
-        const GetPriorityFunc & get_priority)
+        const GetPriorityFunc & get_priority,
+        const CheckUnreachableFunc & is_unreachable)
 {
-    std::vector<ShuffledPool> shuffled_pools = getShuffledPools(max_ignored_errors, get_priority);
+    std::vector<ShuffledPool> shuffled_pools = getShuffledPools(max_ignored_errors, get_priority, /* use_slowdown_count= */ false, is_unreachable);
 
     /// Limit `max_tries` value by `max_error_cap` to avoid unlimited number of retries
     max_tries = std::min(max_tries, max_error_cap);
@@ -336,6 +357,9 @@ PoolWithFailoverBase<TNestedPool>::getMany(
 template <typename TNestedPool>
 struct PoolWithFailoverBase<TNestedPool>::PoolState
 {
+    /// Whether the endpoint failed its last background health probe. Such pools are tried
+    /// after all others regardless of their error counts.
+    bool unreachable = false;
     UInt64 error_count = 0;
     /// The number of slowdowns that led to changing replica in HedgedRequestsFactory
     UInt64 slowdown_count = 0;
@@ -353,11 +377,11 @@ struct PoolWithFailoverBase<TNestedPool>::PoolState
     static bool compare(const PoolState & lhs, const PoolState & rhs, bool use_slowdown_count)
     {
         if (use_slowdown_count)
-            return std::forward_as_tuple(lhs.error_count, lhs.slowdown_count, lhs.config_priority, lhs.priority, lhs.random)
-                < std::forward_as_tuple(rhs.error_count, rhs.slowdown_count, rhs.config_priority, rhs.priority, rhs.random);
+            return std::forward_as_tuple(lhs.unreachable, lhs.error_count, lhs.slowdown_count, lhs.config_priority, lhs.priority, lhs.random)
+                < std::forward_as_tuple(rhs.unreachable, rhs.error_count, rhs.slowdown_count, rhs.config_priority, rhs.priority, rhs.random);
         else
-            return std::forward_as_tuple(lhs.error_count, lhs.config_priority, lhs.priority, lhs.random)
-                < std::forward_as_tuple(rhs.error_count, rhs.config_priority, rhs.priority, rhs.random);
+            return std::forward_as_tuple(lhs.unreachable, lhs.error_count, lhs.config_priority, lhs.priority, lhs.random)
+                < std::forward_as_tuple(rhs.unreachable, rhs.error_count, rhs.config_priority, rhs.priority, rhs.random);
     }
 
 private:
@@ -44,6 +44,8 @@
     M(UncompressedCacheHits, "Number of times a block of data has been found in the uncompressed cache (and decompression was avoided).") \
     M(UncompressedCacheMisses, "Number of times a block of data has not been found in the uncompressed cache (and required decompression).") \
     M(UncompressedCacheWeightLost, "Number of bytes evicted from the uncompressed cache.") \
+    M(CompressedFrameCacheHits, "Number of times a compressed block has been found in the in-memory compressed frame tier of the uncompressed cache (and decompressed from RAM instead of re-read from disk).") \
+    M(CompressedFrameCacheMisses, "Number of times a compressed block has not been found in the in-memory compressed frame tier of the uncompressed cache.") \
     M(MMappedFileCacheHits, "Number of times a file has been found in the MMap cache (for the 'mmap' read_method), so we didn't have to mmap it again.") \
     M(MMappedFileCacheMisses, "Number of times a file has not been found in the MMap cache (for the 'mmap' read_method), so we had to mmap it again.") \
     M(OpenedFileCacheHits, "Number of times a file has been found in the opened file cache, so we didn't have to open it again.") \
@@ -61,6 +63,12 @@
     M(TableFunctionExecute, "Number of table function calls.") \
     M(MarkCacheHits, "Number of times an entry has been found in the mark cache, so we didn't have to load a mark file.") \
     M(MarkCacheMisses, "Number of times an entry has not been found in the mark cache, so we had to load a mark file in memory, which is a costly operation, adding to query latency.") \
+    M(SkippingIndexResultCacheHits, "Number of times the result of evaluating a skipping index over a data part has been found in the skipping index result cache, so the index granules didn't have to be read and checked again.") \
+    M(SkippingIndexResultCacheMisses, "Number of times the result of evaluating a skipping index over a data part has not been found in the skipping index result cache.") \
+    M(FilteredGranuleCacheHits, "Number of times the decoded and filtered result of a MergeTree read task has been found in the filtered granule cache, so the granules didn't have to be read and filtered again.") \
+    M(FilteredGranuleCacheMisses, "Number of times the decoded and filtered result of a MergeTree read task has not been found in the filtered granule cache.") \
+    M(ApproximateNearestNeighborIndexCacheHits, "Number of times a deserialized granule of an approximate nearest neighbor index has been found in the cache, so the search structure didn't have to be rebuilt from disk.") \
+    M(ApproximateNearestNeighborIndexCacheMisses, "Number of times a deserialized granule of an approximate nearest neighbor index has not been found in the cache and had to be read and deserialized.") \
     M(QueryCacheHits, "Number of times a query result has been found in the query cache (and query computation was avoided). Only updated for SELECT queries with SETTING use_query_cache = 1.") \
     M(QueryCacheMisses, "Number of times a query result has not been found in the query cache (and required query computation). Only updated for SELECT queries with SETTING use_query_cache = 1.") \
     /* Each page cache chunk access increments exactly one of the following 5 PageCacheChunk* counters. */ \
@@ -184,6 +192,7 @@
     M(ExternalJoinMerge, "Number of times temporary files were merged for JOIN in external memory.") \
     M(ExternalJoinCompressedBytes, "Number of compressed bytes written for JOIN in external memory.") \
     M(ExternalJoinUncompressedBytes, "Amount of data (uncompressed, before compression) written for JOIN in external memory.") \
+    M(MemoryPressureSpillRequests, "Number of times the spill manager asked an operator (aggregation, sort) to move its in-memory state to disk because the server memory soft limit was exceeded.") \
     \
     M(SlowRead, "Number of reads from a file that were slow. This indicate system overload. Thresholds are controlled by read_backoff_* settings.") \
     M(ReadBackoff, "Number of times the number of query processing threads was lowered due to slow reads.") \
@@ -513,6 +522,8 @@ The server successfully detected this situation and will download merged part fr
     M(RemoteFSLazySeeks, "Number of lazy seeks") \
     M(RemoteFSSeeksWithReset, "Number of seeks which lead to a new connection") \
     M(RemoteFSBuffers, "Number of buffers created for asynchronous reading from remote filesystem") \
+    M(RemoteFSAdaptivePrefetchWindowGrows, "Number of times the adaptive remote prefetch window of a stream grew after a sequentially consumed prefetch") \
+    M(RemoteFSAdaptivePrefetchSkips, "Number of prefetches skipped because the access pattern of the stream looked random (recent prefetches were cancelled by seeks)") \
     M(MergeTreePrefetchedReadPoolInit, "Time spent preparing tasks in MergeTreePrefetchedReadPool") \
     M(WaitPrefetchTaskMicroseconds, "Time spend waiting for prefetched reader") \
     \
@@ -594,7 +605,10 @@ The server successfully detected this situation and will download merged part fr
     \
     M(ScalarSubqueriesGlobalCacheHit, "Number of times a read from a scalar subquery was done using the global cache") \
     M(ScalarSubqueriesLocalCacheHit, "Number of times a read from a scalar subquery was done using the local cache") \
-    M(ScalarSubqueriesCacheMiss, "Number of times a read from a scalar subquery was not cached and had to be calculated completely")                                                                                                                                                                                                 \
+    M(ScalarSubqueriesServerCacheHit, "Number of times a read from a scalar subquery was done using the server-wide scalar subquery cache") \
+    M(ScalarSubqueriesCacheMiss, "Number of times a read from a scalar subquery was not cached and had to be calculated completely")                                                                                                                                                                                               \
+    M(QueryAnalyzerColumnsCacheHits, "Number of times the column list of a table was taken from the analyzer's cross-query cache during identifier resolution") \
+    M(QueryAnalyzerColumnsCacheMisses, "Number of times the column list of a table had to be enumerated from the storage snapshot during identifier resolution") \
     \
     M(SchemaInferenceCacheHits, "Number of times the requested source is found in schema cache") \
     M(SchemaInferenceCacheSchemaHits, "Number of times the schema is found in schema cache during schema inference") \
@@ -0,0 +1,91 @@
+#include <Common/SpillManager.h>
+#include <Common/ProfileEvents.h>
+#include <Common/Stopwatch.h>
+
+#include <algorithm>
+
+namespace ProfileEvents
+{
+    extern const Event MemoryPressureSpillRequests;
+}
+
+namespace DB
+{
+
+SpillManager & SpillManager::instance()
+{
+    static SpillManager manager;
+    return manager;
+}
+
+SpillManager::ParticipantPtr SpillManager::enroll(Int64 priority)
+{
+    auto participant = std::make_shared<Participant>(std::max<Int64>(priority, 1));
+
+    std::lock_guard lock(mutex);
+    /// Reuse slots of participants that are already gone.
+    for (auto & slot : participants)
+    {
+        if (slot.expired())
+        {
+            slot = participant;
+            return participant;
+        }
+    }
+    participants.emplace_back(participant);
+    return participant;
+}
+
+Int64 SpillManager::onMemoryPressure(Int64 deficit)
+{
+    if (deficit <= 0)
+        return 0;
+
+    /// Spilling takes time. Re-signalling pressure on every allocation would flag
+    /// every participant long before the first victim manages to free anything.
+    static constexpr UInt64 request_interval_ns = 100'000'000;
+    UInt64 now_ns = clock_gettime_ns(CLOCK_MONOTONIC);
+    UInt64 last_ns = last_request_ns.load(std::memory_order_relaxed);
+    if (now_ns - last_ns < request_interval_ns
+        || !last_request_ns.compare_exchange_strong(last_ns, now_ns, std::memory_order_relaxed))
+        return 0;
+
+    std::unique_lock lock(mutex, std::defer_lock);
+    if (!lock.try_lock())
+        return 0;
+
+    Int64 requested = 0;
+    while (requested < deficit)
+    {
+        /// The cheapest victim is the one releasing the most bytes per unit of spill cost.
+        std::shared_ptr<Participant> victim;
+        Int64 victim_bytes = 0;
+        for (auto & slot : participants)
+        {
+            auto participant = slot.lock();
+            if (!participant || participant->spill_requested.load(std::memory_order_relaxed))
+                continue;
+
+            Int64 bytes = participant->reclaimable_bytes.load(std::memory_order_relaxed);
+            if (bytes <= 0)
+                continue;
+
+            if (!victim || bytes * victim->priority > victim_bytes * participant->priority)
+            {
+                victim = participant;
+                victim_bytes = bytes;
+            }
+        }
+
+        if (!victim)
+            break;
+
+        victim->spill_requested.store(true, std::memory_order_relaxed);
+        requested += victim_bytes;
+        ProfileEvents::increment(ProfileEvents::MemoryPressureSpillRequests);
+    }
+
+    return requested;
+}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <base/types.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace DB
+{
+
+/** Server-wide arbiter of memory spilling.
+  *
+  * Operators that can move their in-memory state to disk (aggregation, sort) enroll
+  * a Participant and keep its count of reclaimable bytes up to date. When the total
+  * memory tracker crosses its soft limit (see max_server_memory_usage_soft_limit_ratio),
+  * the manager marks the participants that can release the most memory at the lowest
+  * cost as requested to spill. This replaces the per-operator thresholds
+  * (max_bytes_before_external_*) as the only spill trigger: with several memory-hungry
+  * operators running concurrently, per-operator thresholds either overshoot the total
+  * budget or force premature spilling.
+  *
+  * The manager never releases memory itself and never calls into operator state:
+  * operator internals are only safe to touch from the thread that executes the
+  * operator. Spilling is cooperative - operators poll Participant::shouldSpill()
+  * at safe points (between processed blocks) and run their usual spill path when
+  * it returns true.
+  */
+class SpillManager
+{
+public:
+    /// Handle held by a spillable operator while it accumulates data in memory.
+    class Participant
+    {
+    public:
+        explicit Participant(Int64 priority_) : priority(priority_) {}
+
+        /// How much memory the operator can currently release by spilling.
+        void setReclaimableBytes(Int64 bytes) { reclaimable_bytes.store(bytes, std::memory_order_relaxed); }
+
+        /// Returns true once after the manager picked this operator as a spill victim.
+        /// Must be polled only at points where the operator is actually able to spill,
+        /// otherwise the request is lost and the manager has to issue it again.
+        bool shouldSpill() { return spill_requested.exchange(false, std::memory_order_relaxed); }
+
+    private:
+        friend class SpillManager;
+
+        /// Relative cost of spilling. Victims are ranked by reclaimable_bytes / priority,
+        /// so operators with a larger priority are spilled later.
+        const Int64 priority;
+        std::atomic<Int64> reclaimable_bytes{0};
+        std::atomic<bool> spill_requested{false};
+    };
+
+    using ParticipantPtr = std::shared_ptr<Participant>;
+
+    static SpillManager & instance();
+
+    /// Register a spillable operator. The participant is unregistered when the
+    /// returned handle is destroyed.
+    ParticipantPtr enroll(Int64 priority);
+
+    /// Called from the total memory tracker when usage exceeds the soft limit.
+    /// Requests spilling from the cheapest participants until the deficit is
+    /// covered. Returns the number of bytes requested to be spilled.
+    Int64 onMemoryPressure(Int64 deficit);
+
+private:
+    std::mutex mutex;
+    std::vector<std::weak_ptr<Participant>> participants;
+
+    /// Pressure is signalled from allocation paths, so requests are rate-limited
+    /// to let already issued requests take effect before more victims are picked.
+    std::atomic<UInt64> last_request_ns{0};
+};
+
+}
@@ -24,6 +24,7 @@
 #include <Common/ThreadPool.h>
 
 #include <Common/logger_useful.h>
+#include <base/getThreadId.h>
 #include <base/scope_guard.h>
 
 namespace DB
@@ -43,7 +44,8 @@ SystemLogQueue<LogElement>::SystemLogQueue(const SystemLogQueueSettings & settin
     , settings(settings_)
 
 {
-    queue.reserve(settings.reserved_size_rows);
+    for (auto & shard : shards)
+        shard.elements.reserve(settings.reserved_size_rows / NUM_SHARDS + 1);
 
     if (settings.turn_off_logger)
         log->setLevel(0);
@@ -61,65 +63,64 @@ void SystemLogQueue<LogElement>::push(LogElement&& element)
     recursive_push_call = true;
     SCOPE_EXIT({ recursive_push_call = false; });
 
-    /// Memory can be allocated while resizing on queue.push_back.
+    /// Memory can be allocated while resizing on push_back.
     /// The size of allocation can be in order of a few megabytes.
     /// But this should not be accounted for query memory usage.
     /// Otherwise the tests like 01017_uniqCombined_memory_usage.sql will be flacky.
     MemoryTrackerBlockerInThread temporarily_disable_memory_tracker;
 
-    /// Should not log messages under mutex.
-    bool buffer_size_rows_flush_threshold_exceeded = false;
-
-    {
-        std::unique_lock lock(mutex);
+    if (is_shutdown.load(std::memory_order_relaxed))
+        return;
 
-        if (is_shutdown)
-            return;
+    const Index popped = popped_count.load(std::memory_order_relaxed);
 
-        if (queue.size() == settings.buffer_size_rows_flush_threshold)
+    if (pushed_count.load(std::memory_order_relaxed) - popped >= settings.max_size_rows)
+    {
+        // Ignore all further entries until the queue is flushed.
+        // Log a message about that. Don't spam it -- this might be especially
+        // problematic in case of trace log. Remember how many elements were
+        // popped when we last logged the message. If it changed, it means the
+        // queue was flushed, and we can log again.
+        Index logged_at = logged_queue_full_at_index.load(std::memory_order_relaxed);
+        if (logged_at != popped && logged_queue_full_at_index.compare_exchange_strong(logged_at, popped))
         {
-            buffer_size_rows_flush_threshold_exceeded = true;
+            // TextLog sets its logger level to 0, so this log is a noop and
+            // there is no recursive logging.
+            LOG_ERROR(log, "Queue is full for system log '{}' at {}. max_size_rows {}",
+                      demangle(typeid(*this).name()),
+                      popped,
+                      settings.max_size_rows);
+        }
 
-            // The queue more than half full, time to flush.
-            // We only check for strict equality, because messages are added one
-            // by one, under exclusive lock, so we will see each message count.
-            // It is enough to only wake the flushing thread once, after the message
-            // count increases past half available size.
-            const uint64_t queue_end = queue_front_index + queue.size();
-            requested_flush_up_to = std::max(requested_flush_up_to, queue_end);
+        return;
+    }
 
-            flush_event.notify_all();
-        }
+    {
+        auto & shard = shards[getThreadId() % NUM_SHARDS];
+        std::lock_guard shard_lock(shard.mutex);
+        shard.elements.push_back(std::move(element));
+    }
+
+    /// The counter is incremented after the element is in the shard, so by the time
+    /// a flush request observes this count, a full drain of the shards is guaranteed
+    /// to pick the element up.
+    const Index pushed = pushed_count.fetch_add(1, std::memory_order_release) + 1;
 
-        if (queue.size() >= settings.max_size_rows)
+    if (pushed - popped == settings.buffer_size_rows_flush_threshold)
+    {
         {
-            // Ignore all further entries until the queue is flushed.
-            // Log a message about that. Don't spam it -- this might be especially
-            // problematic in case of trace log. Remember what the front index of the
-            // queue was when we last logged the message. If it changed, it means the
-            // queue was flushed, and we can log again.
-            if (queue_front_index != logged_queue_full_at_index)
-            {
-                logged_queue_full_at_index = queue_front_index;
-
-                // TextLog sets its logger level to 0, so this log is a noop and
-                // there is no recursive logging.
-                lock.unlock();
-                LOG_ERROR(log, "Queue is full for system log '{}' at {}. max_size_rows {}",
-                          demangle(typeid(*this).name()),
-                          queue_front_index,
-                          settings.max_size_rows);
-            }
-
-            return;
+            // The queue more than half full, time to flush. The counter returned by
+            // fetch_add is unique, so a single producer observes the crossing of the
+            // threshold and it is enough to wake the flushing thread once.
+            std::lock_guard lock(mutex);
+            requested_flush_up_to = std::max(requested_flush_up_to, pushed);
+            flush_event.notify_all();
         }
 
-        queue.push_back(std::move(element));
-    }
-
-    if (buffer_size_rows_flush_threshold_exceeded)
+        /// Should not log messages under mutex.
         LOG_INFO(log, "Queue is half full for system log '{}'. buffer_size_rows_flush_threshold {}",
                  demangle(typeid(*this).name()), settings.buffer_size_rows_flush_threshold);
+    }
 }
 
 template <typename LogElement>
@@ -159,7 +160,9 @@ uint64_t SystemLogQueue<LogElement>::notifyFlush(bool should_prepare_tables_anyw
         if (is_shutdown)
             return uint64_t(-1);
 
-        this_thread_requested_offset = queue_front_index + queue.size();
+        /// Everything counted in pushed_count is already in some shard,
+        /// so the next full drain collects at least that many elements.
+        this_thread_requested_offset = pushed_count.load(std::memory_order_acquire);
 
         // Publish our flush request, taking care not to overwrite the requests
         // made by other threads.
@@ -199,15 +202,33 @@ typename SystemLogQueue<LogElement>::Index SystemLogQueue<LogElement>::pop(std::
         }
     );
 
-    queue_front_index += queue.size();
-    // Swap with existing array from previous flush, to save memory
-    // allocations.
-    queue.swap(output);
+    /// Drain all the shards. Shard mutexes are only ever taken while holding
+    /// the global one here, and producers never take the global mutex while
+    /// holding a shard one, so the lock order is consistent.
+    for (auto & shard : shards)
+    {
+        std::lock_guard shard_lock(shard.mutex);
+        if (output.empty())
+        {
+            // Swap with existing array from previous flush, to save memory
+            // allocations.
+            output.swap(shard.elements);
+        }
+        else
+        {
+            for (auto & element : shard.elements)
+                output.push_back(std::move(element));
+            shard.elements.clear();
+        }
+    }
+
+    const Index popped = popped_count.load(std::memory_order_relaxed) + output.size();
+    popped_count.store(popped, std::memory_order_relaxed);
 
     should_prepare_tables_anyway = is_force_prepare_tables;
 
     exit_this_thread = is_shutdown;
-    return queue_front_index;
+    return popped;
 }
 
 template <typename LogElement>
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <memory>
@@ -118,28 +119,46 @@ public:
     void confirm(Index to_flush_end);
 
 private:
-    /// Data shared between callers of add()/flush()/shutdown(), and the saving thread
+    /// Coordinates flush requests between producers and the saving thread.
+    /// Protects the flush indexes and the condition variable, but not the queued
+    /// elements themselves: pushes go through a small number of independently
+    /// locked shards (chosen by producer thread id), so that a storm of producers
+    /// (e.g. trace log with the profiler enabled on many query threads) does not
+    /// serialize on a single queue mutex. The saving thread drains all shards at
+    /// once; the relative order of elements from different threads is not
+    /// significant for system logs, which are ordered by their time columns.
     std::mutex mutex;
 
     LoggerPtr log;
 
-    // Queue is bounded. But its size is quite large to not block in all normal cases.
-    std::vector<LogElement> queue;
-    // An always-incrementing index of the first message currently in the queue.
-    // We use it to give a global sequential index to every message, so that we
-    // can wait until a particular message is flushed. This is used to implement
-    // synchronous log flushing for SYSTEM FLUSH LOGS.
-    Index queue_front_index = 0;
+    static constexpr size_t NUM_SHARDS = 8;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::vector<LogElement> elements;
+    };
+
+    std::array<Shard, NUM_SHARDS> shards;
+
+    // Total number of elements ever pushed into any shard, and total number of
+    // elements ever taken out by the saving thread. They give a global sequential
+    // index to every message, so that we can wait until a particular message is
+    // flushed. This is used to implement synchronous log flushing for
+    // SYSTEM FLUSH LOGS. The queue is bounded by (pushed_count - popped_count).
+    std::atomic<Index> pushed_count = 0;
+    std::atomic<Index> popped_count = 0;
+
     // A flag that says we must create the tables even if the queue is empty.
     bool is_force_prepare_tables = false;
     // Requested to flush logs up to this index, exclusive
     Index requested_flush_up_to = 0;
     // Flushed log up to this index, exclusive
     Index flushed_up_to = 0;
-    // Logged overflow message at this queue front index
-    Index logged_queue_full_at_index = -1;
+    // Logged overflow message when popped_count was at this value
+    std::atomic<Index> logged_queue_full_at_index = -1;
 
-    bool is_shutdown = false;
+    std::atomic<bool> is_shutdown = false;
 
     std::condition_variable flush_event;
 
@@ -171,6 +171,8 @@ public:
     const UInt64 thread_id = 0;
     /// Also called "nice" value. If it was changed to non-zero (when attaching query) - will be reset to zero when query is detached.
     Int32 os_thread_priority = 0;
+    /// True if the thread was bound to the CPUs of one NUMA node (when attaching query) - the binding is undone when query is detached.
+    bool os_thread_numa_node_bound = false;
 
     /// TODO: merge them into common entity
     ProfileEvents::Counters performance_counters{VariableContext::Thread};
@@ -681,36 +681,60 @@ void ZooKeeper::sendThread()
                 RequestInfo info;
                 if (requests_queue.tryPop(info, max_wait))
                 {
-                    /// After we popped element from the queue, we must register callbacks (even in the case when expired == true right now),
-                    ///  because they must not be lost (callbacks must be called because the user will wait for them).
-
-                    if (info.request->xid != CLOSE_XID)
+                    /// Everything which is already waiting in the queue (independent requests
+                    /// from concurrent callers) is serialized into the output buffer and flushed
+                    /// with a single socket write. The server processes them in order and the
+                    /// responses are demultiplexed by xid in receiveThread, so batching is
+                    /// invisible to the callers but amortizes syscalls and network packets.
+                    static constexpr size_t max_requests_per_flush = 1000;
+                    size_t requests_written = 0;
+                    bool close_request_written = false;
+                    bool queue_finished = false;
+
+                    while (true)
                     {
-                        CurrentMetrics::add(CurrentMetrics::ZooKeeperRequest);
-                        std::lock_guard lock(operations_mutex);
-                        operations[info.request->xid] = info;
-                    }
+                        /// After we popped element from the queue, we must register callbacks (even in the case when expired == true right now),
+                        ///  because they must not be lost (callbacks must be called because the user will wait for them).
 
-                    if (info.watch)
-                    {
-                        info.request->has_watch = true;
-                    }
+                        if (info.request->xid != CLOSE_XID)
+                        {
+                            CurrentMetrics::add(CurrentMetrics::ZooKeeperRequest);
+                            std::lock_guard lock(operations_mutex);
+                            operations[info.request->xid] = info;
+                        }
 
-                    if (requests_queue.isFinished())
-                    {
-                        break;
-                    }
+                        if (info.watch)
+                        {
+                            info.request->has_watch = true;
+                        }
 
-                    info.request->addRootPath(args.chroot);
+                        if (requests_queue.isFinished())
+                        {
+                            queue_finished = true;
+                            break;
+                        }
 
-                    info.request->probably_sent = true;
-                    info.request->write(getWriteBuffer());
-                    flushWriteBuffer();
+                        info.request->addRootPath(args.chroot);
 
-                    logOperationIfNeeded(info.request);
+                        info.request->probably_sent = true;
+                        info.request->write(getWriteBuffer());
+
+                        logOperationIfNeeded(info.request);
+
+                        if (info.request->xid == CLOSE_XID)
+                        {
+                            close_request_written = true;
+                            break;
+                        }
+
+                        if (++requests_written >= max_requests_per_flush || !requests_queue.tryPop(info))
+                            break;
+                    }
+
+                    flushWriteBuffer();
 
-                    /// We sent close request, exit
-                    if (info.request->xid == CLOSE_XID)
+                    /// We sent close request or the session is finished, exit
+                    if (close_request_written || queue_finished)
                         break;
                 }
             }
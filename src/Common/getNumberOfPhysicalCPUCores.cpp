@@ -195,3 +195,8 @@ unsigned getNumberOfPhysicalCPUCores()
     static auto cores = getNumberOfPhysicalCPUCoresImpl();
     return cores;
 }
+
+unsigned getNumberOfPhysicalCPUCoresUncached()
+{
+    return getNumberOfPhysicalCPUCoresImpl();
+}
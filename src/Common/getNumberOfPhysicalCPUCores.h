@@ -2,3 +2,7 @@
 
 /// Get number of CPU cores without hyper-threading.
 unsigned getNumberOfPhysicalCPUCores();
+
+/// The same, but the result is not cached: the cgroup CPU quota is re-read, so changes
+/// of the quota at runtime (e.g. vertical autoscaling of a container) are visible.
+unsigned getNumberOfPhysicalCPUCoresUncached();
@@ -1,8 +1,11 @@
 #include "CachedCompressedReadBuffer.h"
 
+#include <base/hex.h>
 #include <IO/WriteHelpers.h>
+#include <Compression/CompressionFactory.h>
 #include <Compression/LZ4_decompress_faster.h>
 
+#include <cstring>
 #include <utility>
 
 
@@ -11,6 +14,7 @@ namespace DB
 
 namespace ErrorCodes
 {
+    extern const int CANNOT_DECOMPRESS;
     extern const int SEEK_POSITION_OUT_OF_BOUND;
 }
 
@@ -42,11 +46,40 @@ bool CachedCompressedReadBuffer::nextImpl()
 
     owned_cell = cache->getOrSet(key, [&]()
     {
+        auto cell = std::make_shared<UncompressedCacheCell>();
+
+        /// The second tier of the cache keeps compressed frames in memory (they were checksummed
+        /// when first read), so a hit there avoids touching the file entirely.
+        if (auto frame = cache->getCompressedFrame(key))
+        {
+            uint8_t method = ICompressionCodec::readMethod(frame->data.data());
+
+            if (!codec)
+                codec = CompressionCodecFactory::instance().get(method);
+            else if (method != codec->getMethodByte())
+            {
+                if (allow_different_codecs)
+                    codec = CompressionCodecFactory::instance().get(method);
+                else
+                    throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Data compressed with different methods, given method "
+                                    "byte 0x{}, previous method byte 0x{}",
+                                    getHexUIntLowercase(method), getHexUIntLowercase(codec->getMethodByte()));
+            }
+
+            size_t size_decompressed = codec->readDecompressedBlockSize(frame->data.data());
+            size_t size_compressed_without_checksum = codec->readCompressedBlockSize(frame->data.data());
+
+            cell->compressed_size = frame->compressed_size;
+            cell->additional_bytes = codec->getAdditionalSizeAtTheEndOfBuffer();
+            cell->data.resize(size_decompressed + cell->additional_bytes);
+            codec->decompress(frame->data.data(), static_cast<UInt32>(size_compressed_without_checksum), cell->data.data());
+
+            return cell;
+        }
+
         initInput();
         file_in->seek(file_pos, SEEK_SET);
 
-        auto cell = std::make_shared<UncompressedCacheCell>();
-
         size_t size_decompressed = 0;
         size_t size_compressed_without_checksum = 0;
         cell->compressed_size = readCompressedData(size_decompressed, size_compressed_without_checksum, false);
@@ -56,6 +89,17 @@ bool CachedCompressedReadBuffer::nextImpl()
             cell->additional_bytes = codec->getAdditionalSizeAtTheEndOfBuffer();
             cell->data.resize(size_decompressed + cell->additional_bytes);
             decompressTo(cell->data.data(), size_decompressed, size_compressed_without_checksum);
+
+            if (cache->hasCompressedFrameTier())
+            {
+                auto frame = std::make_shared<CompressedFrameCell>();
+                frame->compressed_size = cell->compressed_size;
+                /// Codecs may read a little beyond the end of the source buffer, so pad the frame the same way
+                /// as readCompressedData pads its own buffer.
+                frame->data.resize(size_compressed_without_checksum + cell->additional_bytes);
+                memcpy(frame->data.data(), compressed_buffer, size_compressed_without_checksum);
+                cache->setCompressedFrame(key, std::move(frame));
+            }
         }
 
         return cell;
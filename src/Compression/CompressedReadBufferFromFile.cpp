@@ -31,6 +31,10 @@ bool CompressedReadBufferFromFile::nextImpl()
     memory.resize(size_decompressed + additional_size_at_the_end_of_buffer);
     working_buffer = Buffer(memory.data(), &memory[size_decompressed]);
 
+    /// While this thread decompresses the current block, let the underlying reader fetch
+    /// the next compressed block in the background (no-op for synchronous readers).
+    file_in.prefetch(Priority{});
+
     decompress(working_buffer, size_decompressed, size_compressed_without_checksum);
 
     /// nextimpl_working_buffer_offset is set in the seek function (lazy seek). So we have to
@@ -133,6 +137,8 @@ size_t CompressedReadBufferFromFile::readBig(char * to, size_t n)
         /// need to skip some bytes in decompressed data (seek happened before readBig call).
         if (nextimpl_working_buffer_offset == 0 && size_decompressed + additional_size_at_the_end_of_buffer <= n - bytes_read)
         {
+            /// Overlap fetching of the next compressed block with decompression of the current one.
+            file_in.prefetch(Priority{});
             setDecompressMode(decompress_mode);
             decompressTo(to + bytes_read, size_decompressed, size_compressed_without_checksum);
             bytes_read += size_decompressed;
@@ -43,6 +43,14 @@ public:
         return offset();
     }
 
+    /// The codec may be changed between frames: every compressed frame records the codec
+    /// it was written with, so the reading side handles switches transparently.
+    /// Note that data already buffered will be compressed with the new codec too.
+    void setCodec(CompressionCodecPtr codec_)
+    {
+        codec = std::move(codec_);
+    }
+
 private:
     void nextImpl() override;
 
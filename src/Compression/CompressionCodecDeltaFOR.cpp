@@ -0,0 +1,329 @@
+#include <Compression/ICompressionCodec.h>
+#include <Compression/CompressionInfo.h>
+#include <Compression/CompressionFactory.h>
+#include <base/unaligned.h>
+#include <Parsers/IAST.h>
+#include <Parsers/ASTLiteral.h>
+
+#include <bit>
+
+
+namespace DB
+{
+
+/** DeltaFOR codec for monotonic integer sequences (timestamps, counters, offsets).
+  *
+  * Per block: the payload is delta-encoded, the frame minimum is subtracted from the deltas
+  * and the residuals are bit-packed with the minimal width that fits the frame range.
+  * A block of values with a constant stride (e.g. one-second timestamps) packs to a header
+  * and zero payload bits regardless of the stride.
+  *
+  * Block layout:
+  *   1 byte   value size (1, 2, 4 or 8)
+  *   1 byte   number of unaligned tail bytes copied verbatim
+  *   tail bytes
+  *   1 byte   bits per packed residual (0..value size in bits)
+  *   T        first value
+  *   T        frame minimum of the deltas
+  *   packed residuals, little-endian bit order
+  */
+class CompressionCodecDeltaFOR : public ICompressionCodec
+{
+public:
+    explicit CompressionCodecDeltaFOR(UInt8 bytes_size_);
+
+    uint8_t getMethodByte() const override;
+
+    void updateHash(SipHash & hash) const override;
+
+protected:
+    UInt32 doCompressData(const char * source, UInt32 source_size, char * dest) const override;
+    void doDecompressData(const char * source, UInt32 source_size, char * dest, UInt32 uncompressed_size) const override;
+
+    /// Worst case (incompressible data) is packing with the full value width
+    /// plus the per-block header, first value and frame minimum.
+    UInt32 getMaxCompressedDataSize(UInt32 uncompressed_size) const override { return uncompressed_size + 3 + 2 * 8; }
+
+    bool isCompression() const override { return true; }
+    bool isGenericCompression() const override { return false; }
+    bool isDeltaCompression() const override { return true; }
+
+private:
+    const UInt8 bytes_size;
+};
+
+
+namespace ErrorCodes
+{
+    extern const int CANNOT_COMPRESS;
+    extern const int CANNOT_DECOMPRESS;
+    extern const int ILLEGAL_SYNTAX_FOR_CODEC_TYPE;
+    extern const int ILLEGAL_CODEC_PARAMETER;
+    extern const int BAD_ARGUMENTS;
+}
+
+CompressionCodecDeltaFOR::CompressionCodecDeltaFOR(UInt8 bytes_size_)
+    : bytes_size(bytes_size_)
+{
+    setCodecDescription("DeltaFOR", {std::make_shared<ASTLiteral>(static_cast<UInt64>(bytes_size))});
+}
+
+uint8_t CompressionCodecDeltaFOR::getMethodByte() const
+{
+    return static_cast<uint8_t>(CompressionMethodByte::DeltaFOR);
+}
+
+void CompressionCodecDeltaFOR::updateHash(SipHash & hash) const
+{
+    getCodecDesc()->updateTreeHash(hash, /*ignore_aliases=*/ true);
+}
+
+namespace
+{
+
+/// Wide accumulator so that a 64-bit residual shifted by a partial-byte offset does not overflow.
+using BitAccumulator = unsigned __int128;
+
+template <typename T>
+UInt32 compressDataForType(const char * source, UInt32 source_size, char * dest)
+{
+    const UInt32 count = source_size / sizeof(T);
+    const char * dest_start = dest;
+
+    T first = unalignedLoadLittleEndian<T>(source);
+
+    /// First pass: frame minimum and maximum of the deltas.
+    T min_delta = 0;
+    T max_delta = 0;
+    {
+        T prev = first;
+        for (UInt32 i = 1; i < count; ++i)
+        {
+            T curr = unalignedLoadLittleEndian<T>(source + i * sizeof(T));
+            T delta = curr - prev;
+            if (i == 1 || delta < min_delta)
+                min_delta = delta;
+            if (i == 1 || delta > max_delta)
+                max_delta = delta;
+            prev = curr;
+        }
+    }
+
+    UInt64 range = static_cast<UInt64>(max_delta - min_delta);
+    UInt8 bits = range ? static_cast<UInt8>(64 - std::countl_zero(range)) : 0;
+
+    *dest++ = bits;
+    unalignedStoreLittleEndian<T>(dest, first);
+    dest += sizeof(T);
+    unalignedStoreLittleEndian<T>(dest, min_delta);
+    dest += sizeof(T);
+
+    /// Second pass: pack the residuals.
+    if (bits)
+    {
+        BitAccumulator accumulator = 0;
+        size_t accumulated_bits = 0;
+
+        T prev = first;
+        for (UInt32 i = 1; i < count; ++i)
+        {
+            T curr = unalignedLoadLittleEndian<T>(source + i * sizeof(T));
+            UInt64 residual = static_cast<UInt64>(static_cast<T>((curr - prev) - min_delta));
+            prev = curr;
+
+            accumulator |= static_cast<BitAccumulator>(residual) << accumulated_bits;
+            accumulated_bits += bits;
+            while (accumulated_bits >= 8)
+            {
+                *dest++ = static_cast<char>(static_cast<UInt8>(accumulator));
+                accumulator >>= 8;
+                accumulated_bits -= 8;
+            }
+        }
+
+        if (accumulated_bits)
+            *dest++ = static_cast<char>(static_cast<UInt8>(accumulator));
+    }
+
+    return static_cast<UInt32>(dest - dest_start);
+}
+
+template <typename T>
+void decompressDataForType(const char * source, UInt32 source_size, char * dest, UInt32 output_size)
+{
+    static constexpr size_t header_size = 1 + 2 * sizeof(T);
+
+    if (source_size < header_size)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress DeltaFOR-encoded data. File has wrong header");
+
+    const UInt32 count = output_size / sizeof(T);
+
+    UInt8 bits = static_cast<UInt8>(source[0]);
+    if (bits > sizeof(T) * 8)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress DeltaFOR-encoded data. File has wrong header");
+
+    T first = unalignedLoadLittleEndian<T>(source + 1);
+    T min_delta = unalignedLoadLittleEndian<T>(source + 1 + sizeof(T));
+
+    const char * packed = source + header_size;
+    const char * const packed_end = source + source_size;
+
+    if (bits && (count > 1))
+    {
+        size_t required_bytes = (static_cast<size_t>(count - 1) * bits + 7) / 8;
+        if (static_cast<size_t>(packed_end - packed) < required_bytes)
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress DeltaFOR-encoded data, too small packed payload");
+    }
+
+    const UInt64 mask = (bits == 64) ? ~UInt64{0} : ((UInt64{1} << bits) - 1);
+
+    unalignedStoreLittleEndian<T>(dest, first);
+
+    BitAccumulator accumulator = 0;
+    size_t accumulated_bits = 0;
+
+    T prev = first;
+    for (UInt32 i = 1; i < count; ++i)
+    {
+        while (accumulated_bits < bits)
+        {
+            accumulator |= static_cast<BitAccumulator>(static_cast<UInt8>(*packed++)) << accumulated_bits;
+            accumulated_bits += 8;
+        }
+
+        UInt64 residual = static_cast<UInt64>(accumulator) & mask;
+        accumulator >>= bits;
+        accumulated_bits -= bits;
+
+        T curr = static_cast<T>(prev + static_cast<T>(residual) + min_delta);
+        unalignedStoreLittleEndian<T>(dest + i * sizeof(T), curr);
+        prev = curr;
+    }
+}
+
+}
+
+UInt32 CompressionCodecDeltaFOR::doCompressData(const char * source, UInt32 source_size, char * dest) const
+{
+    UInt8 bytes_to_skip = source_size % bytes_size;
+    dest[0] = bytes_size;
+    dest[1] = bytes_to_skip;
+    memcpy(&dest[2], source, bytes_to_skip);
+    size_t start_pos = 2 + bytes_to_skip;
+
+    if (source_size == bytes_to_skip)
+        return static_cast<UInt32>(start_pos);
+
+    UInt32 compressed_size = 0;
+    switch (bytes_size) // NOLINT(bugprone-switch-missing-default-case)
+    {
+    case 1:
+        compressed_size = compressDataForType<UInt8>(&source[bytes_to_skip], source_size - bytes_to_skip, &dest[start_pos]);
+        break;
+    case 2:
+        compressed_size = compressDataForType<UInt16>(&source[bytes_to_skip], source_size - bytes_to_skip, &dest[start_pos]);
+        break;
+    case 4:
+        compressed_size = compressDataForType<UInt32>(&source[bytes_to_skip], source_size - bytes_to_skip, &dest[start_pos]);
+        break;
+    case 8:
+        compressed_size = compressDataForType<UInt64>(&source[bytes_to_skip], source_size - bytes_to_skip, &dest[start_pos]);
+        break;
+    }
+    return static_cast<UInt32>(start_pos) + compressed_size;
+}
+
+void CompressionCodecDeltaFOR::doDecompressData(const char * source, UInt32 source_size, char * dest, UInt32 uncompressed_size) const
+{
+    if (source_size < 2)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress DeltaFOR-encoded data. File has wrong header");
+
+    if (uncompressed_size == 0)
+        return;
+
+    UInt8 bytes_size_from_header = source[0];
+    if (!(bytes_size_from_header == 1 || bytes_size_from_header == 2 || bytes_size_from_header == 4 || bytes_size_from_header == 8))
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress DeltaFOR-encoded data. File has wrong header");
+
+    UInt8 bytes_to_skip = uncompressed_size % bytes_size_from_header;
+    UInt32 output_size = uncompressed_size - bytes_to_skip;
+
+    if (static_cast<UInt32>(2 + bytes_to_skip) > source_size)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress DeltaFOR-encoded data. File has wrong header");
+
+    memcpy(dest, &source[2], bytes_to_skip);
+
+    if (output_size == 0)
+        return;
+
+    UInt32 source_size_no_header = source_size - bytes_to_skip - 2;
+    switch (bytes_size_from_header) // NOLINT(bugprone-switch-missing-default-case)
+    {
+    case 1:
+        decompressDataForType<UInt8>(&source[2 + bytes_to_skip], source_size_no_header, &dest[bytes_to_skip], output_size);
+        break;
+    case 2:
+        decompressDataForType<UInt16>(&source[2 + bytes_to_skip], source_size_no_header, &dest[bytes_to_skip], output_size);
+        break;
+    case 4:
+        decompressDataForType<UInt32>(&source[2 + bytes_to_skip], source_size_no_header, &dest[bytes_to_skip], output_size);
+        break;
+    case 8:
+        decompressDataForType<UInt64>(&source[2 + bytes_to_skip], source_size_no_header, &dest[bytes_to_skip], output_size);
+        break;
+    }
+}
+
+namespace
+{
+
+UInt8 getBytesSize(const IDataType * column_type)
+{
+    if (!column_type->isValueUnambiguouslyRepresentedInFixedSizeContiguousMemoryRegion())
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Codec DeltaFOR is not applicable for {} because the data type is not of fixed size",
+            column_type->getName());
+
+    size_t max_size = column_type->getSizeOfValueInMemory();
+    if (max_size == 1 || max_size == 2 || max_size == 4 || max_size == 8)
+        return static_cast<UInt8>(max_size);
+    else
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Codec DeltaFOR is only applicable for data types of size 1, 2, 4, 8 bytes. Given type {}",
+            column_type->getName());
+}
+
+}
+
+void registerCodecDeltaFOR(CompressionCodecFactory & factory)
+{
+    UInt8 method_code = static_cast<UInt8>(CompressionMethodByte::DeltaFOR);
+    auto codec_builder = [&](const ASTPtr & arguments, const IDataType * column_type) -> CompressionCodecPtr
+    {
+        /// Default bytes size is 1.
+        UInt8 bytes_size = 1;
+
+        if (arguments && !arguments->children.empty())
+        {
+            if (arguments->children.size() > 1)
+                throw Exception(ErrorCodes::ILLEGAL_SYNTAX_FOR_CODEC_TYPE, "DeltaFOR codec must have 1 parameter, given {}", arguments->children.size());
+
+            const auto children = arguments->children;
+            const auto * literal = children[0]->as<ASTLiteral>();
+            if (!literal || literal->value.getType() != Field::Types::Which::UInt64)
+                throw Exception(ErrorCodes::ILLEGAL_CODEC_PARAMETER, "DeltaFOR codec argument must be unsigned integer");
+
+            size_t user_bytes_size = literal->value.safeGet<UInt64>();
+            if (user_bytes_size != 1 && user_bytes_size != 2 && user_bytes_size != 4 && user_bytes_size != 8)
+                throw Exception(ErrorCodes::ILLEGAL_CODEC_PARAMETER, "Value size for DeltaFOR codec can be 1, 2, 4 or 8, given {}", user_bytes_size);
+            bytes_size = static_cast<UInt8>(user_bytes_size);
+        }
+        else if (column_type)
+        {
+            bytes_size = getBytesSize(column_type);
+        }
+
+        return std::make_shared<CompressionCodecDeltaFOR>(bytes_size);
+    };
+    factory.registerCompressionCodecWithType("DeltaFOR", method_code, codec_builder);
+}
+
+}
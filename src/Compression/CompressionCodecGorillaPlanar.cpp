@@ -0,0 +1,351 @@
+#include <Compression/ICompressionCodec.h>
+#include <Compression/CompressionInfo.h>
+#include <Compression/CompressionFactory.h>
+#include <base/unaligned.h>
+#include <Parsers/IAST.h>
+#include <Parsers/ASTLiteral.h>
+
+#include <bit>
+#include <cstring>
+
+
+namespace DB
+{
+
+/** GorillaPlanar codec for floating point time series (gauges, sensor readings).
+  *
+  * Stores the same XOR diffs as the Gorilla codec, but in a planar per-block layout instead of an
+  * interleaved bit stream. Gorilla decodes bit by bit: every control bit determines how many bits
+  * to read next, so decoding is a long chain of data-dependent branches. Here the values are
+  * processed in blocks of 64 and the control information is stored separately from the payloads:
+  *
+  *   T        first value
+  *   then, per block of up to 64 XOR diffs:
+  *   UInt64   bitmap, bit i is set iff the i-th diff of the block is non-zero
+  *   if the bitmap is non-zero:
+  *     1 byte   trailing zero bits common to all diffs of the block
+  *     1 byte   payload width in bits (block width minus common leading and trailing zero bits)
+  *     payloads of the non-zero diffs, bit-packed with the fixed width, little-endian bit order
+  *
+  * Decoding a block is a fixed-width unpacking loop with no data-dependent control flow (the same
+  * shape of loop the compiler vectorizes for DeltaFOR), followed by an XOR-prefix pass over the
+  * block. The per-block common width loses a little compression to Gorilla's per-value widths, but
+  * the zero diffs of idle gauges still cost a single bitmap bit.
+  */
+class CompressionCodecGorillaPlanar : public ICompressionCodec
+{
+public:
+    explicit CompressionCodecGorillaPlanar(UInt8 bytes_size_);
+
+    uint8_t getMethodByte() const override;
+
+    void updateHash(SipHash & hash) const override;
+
+protected:
+    UInt32 doCompressData(const char * source, UInt32 source_size, char * dest) const override;
+    void doDecompressData(const char * source, UInt32 source_size, char * dest, UInt32 uncompressed_size) const override;
+
+    /// Worst case (incompressible data) is full-width payloads plus 10 bytes of bitmap and widths
+    /// per 64-value block, plus the first value and the common header.
+    UInt32 getMaxCompressedDataSize(UInt32 uncompressed_size) const override { return uncompressed_size + uncompressed_size / 16 + 2 + 8 + 16; }
+
+    bool isCompression() const override { return true; }
+    bool isGenericCompression() const override { return false; }
+    bool isFloatingPointTimeSeriesCodec() const override { return true; }
+
+private:
+    const UInt8 bytes_size;
+};
+
+
+namespace ErrorCodes
+{
+    extern const int CANNOT_COMPRESS;
+    extern const int CANNOT_DECOMPRESS;
+    extern const int ILLEGAL_SYNTAX_FOR_CODEC_TYPE;
+    extern const int ILLEGAL_CODEC_PARAMETER;
+    extern const int BAD_ARGUMENTS;
+}
+
+CompressionCodecGorillaPlanar::CompressionCodecGorillaPlanar(UInt8 bytes_size_)
+    : bytes_size(bytes_size_)
+{
+    setCodecDescription("GorillaPlanar", {std::make_shared<ASTLiteral>(static_cast<UInt64>(bytes_size))});
+}
+
+uint8_t CompressionCodecGorillaPlanar::getMethodByte() const
+{
+    return static_cast<uint8_t>(CompressionMethodByte::GorillaPlanar);
+}
+
+void CompressionCodecGorillaPlanar::updateHash(SipHash & hash) const
+{
+    getCodecDesc()->updateTreeHash(hash, /*ignore_aliases=*/ true);
+}
+
+namespace
+{
+
+constexpr UInt32 BLOCK_SIZE = 64;
+
+/// Wide accumulator so that a 64-bit payload shifted by a partial-byte offset does not overflow.
+using BitAccumulator = unsigned __int128;
+
+template <typename T>
+UInt32 compressDataForType(const char * source, UInt32 source_size, char * dest)
+{
+    if (source_size % sizeof(T) != 0)
+        throw Exception(ErrorCodes::CANNOT_COMPRESS, "Cannot compress with GorillaPlanar codec, data size {} is not aligned to {}", source_size, sizeof(T));
+
+    const UInt32 count = source_size / sizeof(T);
+    const char * dest_start = dest;
+
+    T prev = unalignedLoadLittleEndian<T>(source);
+    unalignedStoreLittleEndian<T>(dest, prev);
+    dest += sizeof(T);
+
+    T diffs[BLOCK_SIZE];
+
+    for (UInt32 pos = 1; pos < count;)
+    {
+        const UInt32 block_size = std::min(BLOCK_SIZE, count - pos);
+
+        UInt64 flags = 0;
+        T block_or = 0;
+        for (UInt32 i = 0; i < block_size; ++i)
+        {
+            T curr = unalignedLoadLittleEndian<T>(source + (pos + i) * sizeof(T));
+            T diff = curr ^ prev;
+            diffs[i] = diff;
+            block_or |= diff;
+            if (diff != 0)
+                flags |= UInt64{1} << i;
+            prev = curr;
+        }
+
+        unalignedStoreLittleEndian<UInt64>(dest, flags);
+        dest += sizeof(UInt64);
+
+        if (flags)
+        {
+            const UInt8 trailing = static_cast<UInt8>(std::countr_zero(block_or));
+            const UInt8 bits = static_cast<UInt8>(sizeof(T) * 8 - std::countl_zero(block_or) - trailing);
+
+            *dest++ = static_cast<char>(trailing);
+            *dest++ = static_cast<char>(bits);
+
+            BitAccumulator accumulator = 0;
+            size_t accumulated_bits = 0;
+            for (UInt32 i = 0; i < block_size; ++i)
+            {
+                if (!diffs[i])
+                    continue;
+
+                accumulator |= static_cast<BitAccumulator>(static_cast<UInt64>(diffs[i]) >> trailing) << accumulated_bits;
+                accumulated_bits += bits;
+                while (accumulated_bits >= 8)
+                {
+                    *dest++ = static_cast<char>(static_cast<UInt8>(accumulator));
+                    accumulator >>= 8;
+                    accumulated_bits -= 8;
+                }
+            }
+
+            if (accumulated_bits)
+                *dest++ = static_cast<char>(static_cast<UInt8>(accumulator));
+        }
+
+        pos += block_size;
+    }
+
+    return static_cast<UInt32>(dest - dest_start);
+}
+
+template <typename T>
+void decompressDataForType(const char * source, UInt32 source_size, char * dest, UInt32 output_size)
+{
+    const char * const source_end = source + source_size;
+    const UInt32 count = output_size / sizeof(T);
+
+    if (source + sizeof(T) > source_end || count == 0)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data. File has wrong header");
+
+    T prev = unalignedLoadLittleEndian<T>(source);
+    source += sizeof(T);
+    unalignedStoreLittleEndian<T>(dest, prev);
+
+    UInt64 payloads[BLOCK_SIZE];
+
+    for (UInt32 pos = 1; pos < count;)
+    {
+        const UInt32 block_size = std::min(BLOCK_SIZE, count - pos);
+
+        if (source + sizeof(UInt64) > source_end)
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data: corrupted input data.");
+
+        const UInt64 flags = unalignedLoadLittleEndian<UInt64>(source);
+        source += sizeof(UInt64);
+
+        if (block_size < BLOCK_SIZE && (flags >> block_size) != 0)
+            throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data: corrupted input data.");
+
+        if (flags)
+        {
+            if (source + 2 > source_end)
+                throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data: corrupted input data.");
+
+            const UInt8 trailing = static_cast<UInt8>(source[0]);
+            const UInt8 bits = static_cast<UInt8>(source[1]);
+            source += 2;
+
+            if (bits == 0 || bits + trailing > sizeof(T) * 8)
+                throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data: corrupted input data.");
+
+            const size_t num_payloads = std::popcount(flags);
+            if (static_cast<size_t>(source_end - source) < (num_payloads * bits + 7) / 8)
+                throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data: corrupted input data.");
+
+            /// Fixed-width unpacking, no data-dependent control flow.
+            const UInt64 mask = (bits == 64) ? ~UInt64{0} : ((UInt64{1} << bits) - 1);
+            BitAccumulator accumulator = 0;
+            size_t accumulated_bits = 0;
+            for (size_t i = 0; i < num_payloads; ++i)
+            {
+                while (accumulated_bits < bits)
+                {
+                    accumulator |= static_cast<BitAccumulator>(static_cast<UInt8>(*source++)) << accumulated_bits;
+                    accumulated_bits += 8;
+                }
+
+                payloads[i] = (static_cast<UInt64>(accumulator) & mask) << trailing;
+                accumulator >>= bits;
+                accumulated_bits -= bits;
+            }
+        }
+
+        size_t next_payload = 0;
+        for (UInt32 i = 0; i < block_size; ++i)
+        {
+            T diff = (flags >> i) & 1 ? static_cast<T>(payloads[next_payload++]) : T{0};
+            prev = prev ^ diff;
+            unalignedStoreLittleEndian<T>(dest + (pos + i) * sizeof(T), prev);
+        }
+
+        pos += block_size;
+    }
+}
+
+}
+
+UInt32 CompressionCodecGorillaPlanar::doCompressData(const char * source, UInt32 source_size, char * dest) const
+{
+    UInt8 bytes_to_skip = source_size % bytes_size;
+    dest[0] = bytes_size;
+    dest[1] = bytes_to_skip;
+    memcpy(&dest[2], source, bytes_to_skip);
+    size_t start_pos = 2 + bytes_to_skip;
+
+    if (source_size == bytes_to_skip)
+        return static_cast<UInt32>(start_pos);
+
+    UInt32 compressed_size = 0;
+    switch (bytes_size) // NOLINT(bugprone-switch-missing-default-case)
+    {
+    case 4:
+        compressed_size = compressDataForType<UInt32>(&source[bytes_to_skip], source_size - bytes_to_skip, &dest[start_pos]);
+        break;
+    case 8:
+        compressed_size = compressDataForType<UInt64>(&source[bytes_to_skip], source_size - bytes_to_skip, &dest[start_pos]);
+        break;
+    }
+    return static_cast<UInt32>(start_pos) + compressed_size;
+}
+
+void CompressionCodecGorillaPlanar::doDecompressData(const char * source, UInt32 source_size, char * dest, UInt32 uncompressed_size) const
+{
+    if (source_size < 2)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data. File has wrong header");
+
+    if (uncompressed_size == 0)
+        return;
+
+    UInt8 bytes_size_from_header = source[0];
+    if (!(bytes_size_from_header == 4 || bytes_size_from_header == 8))
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data. File has wrong header");
+
+    UInt8 bytes_to_skip = uncompressed_size % bytes_size_from_header;
+    UInt32 output_size = uncompressed_size - bytes_to_skip;
+
+    if (static_cast<UInt32>(2 + bytes_to_skip) > source_size)
+        throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress GorillaPlanar-encoded data. File has wrong header");
+
+    memcpy(dest, &source[2], bytes_to_skip);
+
+    if (output_size == 0)
+        return;
+
+    UInt32 source_size_no_header = source_size - bytes_to_skip - 2;
+    switch (bytes_size_from_header) // NOLINT(bugprone-switch-missing-default-case)
+    {
+    case 4:
+        decompressDataForType<UInt32>(&source[2 + bytes_to_skip], source_size_no_header, &dest[bytes_to_skip], output_size);
+        break;
+    case 8:
+        decompressDataForType<UInt64>(&source[2 + bytes_to_skip], source_size_no_header, &dest[bytes_to_skip], output_size);
+        break;
+    }
+}
+
+namespace
+{
+
+UInt8 getBytesSize(const IDataType * column_type)
+{
+    if (!column_type->isValueUnambiguouslyRepresentedInFixedSizeContiguousMemoryRegion())
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Codec GorillaPlanar is not applicable for {} because the data type is not of fixed size",
+            column_type->getName());
+
+    size_t max_size = column_type->getSizeOfValueInMemory();
+    if (max_size == 4 || max_size == 8)
+        return static_cast<UInt8>(max_size);
+    else
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Codec GorillaPlanar is only applicable for data types of size 4, 8 bytes. Given type {}",
+            column_type->getName());
+}
+
+}
+
+void registerCodecGorillaPlanar(CompressionCodecFactory & factory)
+{
+    UInt8 method_code = static_cast<UInt8>(CompressionMethodByte::GorillaPlanar);
+    auto codec_builder = [&](const ASTPtr & arguments, const IDataType * column_type) -> CompressionCodecPtr
+    {
+        /// Default bytes size is 8.
+        UInt8 bytes_size = 8;
+
+        if (arguments && !arguments->children.empty())
+        {
+            if (arguments->children.size() > 1)
+                throw Exception(ErrorCodes::ILLEGAL_SYNTAX_FOR_CODEC_TYPE, "GorillaPlanar codec must have 1 parameter, given {}", arguments->children.size());
+
+            const auto children = arguments->children;
+            const auto * literal = children[0]->as<ASTLiteral>();
+            if (!literal || literal->value.getType() != Field::Types::Which::UInt64)
+                throw Exception(ErrorCodes::ILLEGAL_CODEC_PARAMETER, "GorillaPlanar codec argument must be unsigned integer");
+
+            size_t user_bytes_size = literal->value.safeGet<UInt64>();
+            if (user_bytes_size != 4 && user_bytes_size != 8)
+                throw Exception(ErrorCodes::ILLEGAL_CODEC_PARAMETER, "Value size for GorillaPlanar codec can be 4 or 8, given {}", user_bytes_size);
+            bytes_size = static_cast<UInt8>(user_bytes_size);
+        }
+        else if (column_type)
+        {
+            bytes_size = getBytesSize(column_type);
+        }
+
+        return std::make_shared<CompressionCodecGorillaPlanar>(bytes_size);
+    };
+    factory.registerCompressionCodecWithType("GorillaPlanar", method_code, codec_builder);
+}
+
+}
@@ -22,6 +22,27 @@ namespace ErrorCodes
     extern const int ILLEGAL_CODEC_PARAMETER;
 }
 
+namespace
+{
+
+/// Creating a (de)compression context allocates a workspace of tens of kilobytes, which for the
+/// small blocks of repetitive data this codec often sees costs more than the (de)compression
+/// itself. Keep one context per thread; all parameters are set anew on every use, so contexts
+/// can be shared between codec instances with different settings.
+struct ZSTDCompressionContext
+{
+    ZSTD_CCtx * cctx = ZSTD_createCCtx();
+    ~ZSTDCompressionContext() { ZSTD_freeCCtx(cctx); }
+};
+
+struct ZSTDDecompressionContext
+{
+    ZSTD_DCtx * dctx = ZSTD_createDCtx();
+    ~ZSTDDecompressionContext() { ZSTD_freeDCtx(dctx); }
+};
+
+}
+
 uint8_t CompressionCodecZSTD::getMethodByte() const
 {
     return static_cast<uint8_t>(CompressionMethodByte::ZSTD);
@@ -40,15 +61,15 @@ UInt32 CompressionCodecZSTD::getMaxCompressedDataSize(UInt32 uncompressed_size)
 
 UInt32 CompressionCodecZSTD::doCompressData(const char * source, UInt32 source_size, char * dest) const
 {
-    ZSTD_CCtx * cctx = ZSTD_createCCtx();
+    static thread_local ZSTDCompressionContext context;
+    ZSTD_CCtx * cctx = context.cctx;
+
     ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
-    if (enable_long_range)
-    {
-        ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
-        ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, window_log); // NB zero window_log means "use default" for libzstd
-    }
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, enable_long_range ? 1 : 0);
+    // NB zero window_log means "use default" for libzstd
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, enable_long_range ? window_log : 0);
+
     size_t compressed_size = ZSTD_compress2(cctx, dest, ZSTD_compressBound(source_size), source, source_size);
-    ZSTD_freeCCtx(cctx);
 
     if (ZSTD_isError(compressed_size))
         throw Exception(ErrorCodes::CANNOT_COMPRESS, "Cannot compress with ZSTD codec: {}", ZSTD_getErrorName(compressed_size));
@@ -59,7 +80,9 @@ UInt32 CompressionCodecZSTD::doCompressData(const char * source, UInt32 source_s
 
 void CompressionCodecZSTD::doDecompressData(const char * source, UInt32 source_size, char * dest, UInt32 uncompressed_size) const
 {
-    size_t res = ZSTD_decompress(dest, uncompressed_size, source, source_size);
+    static thread_local ZSTDDecompressionContext context;
+
+    size_t res = ZSTD_decompressDCtx(context.dctx, dest, uncompressed_size, source, source_size);
 
     if (ZSTD_isError(res))
         throw Exception(ErrorCodes::CANNOT_DECOMPRESS, "Cannot decompress ZSTD-encoded data: {}", std::string(ZSTD_getErrorName(res)));
@@ -187,9 +187,11 @@ void registerCodecDeflateQpl(CompressionCodecFactory & factory);
 /// in standalone build
 #ifndef CLICKHOUSE_KEEPER_STANDALONE_BUILD
 void registerCodecDelta(CompressionCodecFactory & factory);
+void registerCodecDeltaFOR(CompressionCodecFactory & factory);
 void registerCodecT64(CompressionCodecFactory & factory);
 void registerCodecDoubleDelta(CompressionCodecFactory & factory);
 void registerCodecGorilla(CompressionCodecFactory & factory);
+void registerCodecGorillaPlanar(CompressionCodecFactory & factory);
 void registerCodecEncrypted(CompressionCodecFactory & factory);
 void registerCodecFPC(CompressionCodecFactory & factory);
 void registerCodecGCD(CompressionCodecFactory & factory);
@@ -207,9 +209,11 @@ CompressionCodecFactory::CompressionCodecFactory()
     registerCodecMultiple(*this);
 #ifndef CLICKHOUSE_KEEPER_STANDALONE_BUILD
     registerCodecDelta(*this);
+    registerCodecDeltaFOR(*this);
     registerCodecT64(*this);
     registerCodecDoubleDelta(*this);
     registerCodecGorilla(*this);
+    registerCodecGorillaPlanar(*this);
     registerCodecEncrypted(*this);
     registerCodecFPC(*this);
 #ifdef ENABLE_QPL_COMPRESSION
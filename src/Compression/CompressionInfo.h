@@ -49,6 +49,8 @@ enum class CompressionMethodByte : uint8_t
     DeflateQpl      = 0x99,
     GCD             = 0x9a,
     ZSTD_QPL        = 0x9b,
+    DeltaFOR        = 0x9c,
+    GorillaPlanar   = 0x9d,
 };
 
 }
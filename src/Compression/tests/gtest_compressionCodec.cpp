@@ -1118,6 +1118,202 @@ INSTANTIATE_TEST_SUITE_P(OverflowFloat,
     )
 );
 
+const auto DeltaFORCodecsToTest = ::testing::Values(
+    Codec("DeltaFOR"),
+    Codec("DeltaFOR, LZ4"),
+    Codec("DeltaFOR, ZSTD")
+);
+
+// Sequences of every length from 1 to 42 exercise the partially filled last frame.
+INSTANTIATE_TEST_SUITE_P(DeltaFORSmallSequences,
+    CodecTest,
+    ::testing::Combine(
+        DeltaFORCodecsToTest,
+        ::testing::ValuesIn(
+                  generatePyramidOfSequences<Int8 >(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<Int16 >(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<Int32 >(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<Int64 >(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<UInt8 >(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<UInt16>(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<UInt32>(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<UInt64>(42, G(SequentialGenerator(1)))
+        )
+    )
+);
+
+// All-equal deltas pack into frames of width 0.
+INSTANTIATE_TEST_SUITE_P(DeltaFORSameValueInt,
+    CodecTest,
+    ::testing::Combine(
+        DeltaFORCodecsToTest,
+        ::testing::Values(
+            generateSeq<Int8>(G(SameValueGenerator(42))),
+            generateSeq<Int16 >(G(SameValueGenerator(1000))),
+            generateSeq<Int32 >(G(SameValueGenerator(1000))),
+            generateSeq<Int64 >(G(SameValueGenerator(1000))),
+            generateSeq<UInt8 >(G(SameValueGenerator(42))),
+            generateSeq<UInt16>(G(SameValueGenerator(1000))),
+            generateSeq<UInt32>(G(SameValueGenerator(1000))),
+            generateSeq<UInt64>(G(SameValueGenerator(1000)))
+        )
+    )
+);
+
+INSTANTIATE_TEST_SUITE_P(DeltaFORMonotonicInt,
+    CodecTest,
+    ::testing::Combine(
+        DeltaFORCodecsToTest,
+        ::testing::Values(
+            generateSeq<Int8>(G(MonotonicGenerator(1, 5))),
+            generateSeq<Int16>(G(MonotonicGenerator(1, 5))),
+            generateSeq<Int32>(G(MonotonicGenerator(1, 5))),
+            generateSeq<Int64>(G(MonotonicGenerator(1, 5))),
+            generateSeq<UInt8 >(G(MonotonicGenerator(1, 5))),
+            generateSeq<UInt16>(G(MonotonicGenerator(1, 5))),
+            generateSeq<UInt32>(G(MonotonicGenerator(1, 5))),
+            generateSeq<UInt64>(G(MonotonicGenerator(1, 5)))
+        )
+    )
+);
+
+INSTANTIATE_TEST_SUITE_P(DeltaFORSequentialReverseInt,
+    CodecTest,
+    ::testing::Combine(
+        DeltaFORCodecsToTest,
+        ::testing::Values(
+            generateSeq<Int8>(G(SequentialGenerator(-1))),
+            generateSeq<Int16 >(G(SequentialGenerator(-1))),
+            generateSeq<Int32 >(G(SequentialGenerator(-1))),
+            generateSeq<Int64 >(G(SequentialGenerator(-1))),
+            generateSeq<UInt8 >(G(SequentialGenerator(-1))),
+            generateSeq<UInt16>(G(SequentialGenerator(-1))),
+            generateSeq<UInt32>(G(SequentialGenerator(-1))),
+            generateSeq<UInt64>(G(SequentialGenerator(-1)))
+        )
+    )
+);
+
+// Random deltas need the full bit width.
+INSTANTIATE_TEST_SUITE_P(DeltaFORRandomInt,
+    CodecTest,
+    ::testing::Combine(
+        DeltaFORCodecsToTest,
+        ::testing::Values(
+            generateSeq<UInt8 >(G(RandomGenerator<uint8_t>(0))),
+            generateSeq<UInt16>(G(RandomGenerator<UInt16>(0))),
+            generateSeq<UInt32>(G(RandomGenerator<UInt32>(0, 0, 1000'000'000))),
+            generateSeq<UInt64>(G(RandomGenerator<UInt64>(0, 0, 1000'000'000)))
+        )
+    )
+);
+
+// Deltas between extreme values wrap around in the unsigned domain.
+INSTANTIATE_TEST_SUITE_P(DeltaFOROverflowInt,
+    CodecTest,
+    ::testing::Combine(
+        DeltaFORCodecsToTest,
+        ::testing::Values(
+            generateSeq<UInt32>(G(MinMaxGenerator())),
+            generateSeq<Int32>(G(MinMaxGenerator())),
+            generateSeq<UInt64>(G(MinMaxGenerator())),
+            generateSeq<Int64>(G(MinMaxGenerator()))
+        )
+    )
+);
+
+const auto GorillaPlanarCodecsToTest = ::testing::Values(
+    Codec("GorillaPlanar"),
+    Codec("GorillaPlanar, LZ4"),
+    Codec("GorillaPlanar, ZSTD")
+);
+
+// Sequences of every length from 1 to 42 exercise the tail of the plane buffers.
+INSTANTIATE_TEST_SUITE_P(GorillaPlanarSmallSequences,
+    CodecTest,
+    ::testing::Combine(
+        GorillaPlanarCodecsToTest,
+        ::testing::ValuesIn(
+                  generatePyramidOfSequences<Float32>(42, G(SequentialGenerator(1)))
+                + generatePyramidOfSequences<Float64>(42, G(SequentialGenerator(1)))
+        )
+    )
+);
+
+// Equal values XOR to zero leading/meaningful bits.
+INSTANTIATE_TEST_SUITE_P(GorillaPlanarSameValueFloat,
+    CodecTest,
+    ::testing::Combine(
+        GorillaPlanarCodecsToTest,
+        ::testing::Values(
+            generateSeq<Float32>(G(SameValueGenerator(M_E))),
+            generateSeq<Float64>(G(SameValueGenerator(M_E))),
+            generateSeq<Float32>(G(SameValueGenerator(-1 * M_E))),
+            generateSeq<Float64>(G(SameValueGenerator(-1 * M_E)))
+        )
+    )
+);
+
+INSTANTIATE_TEST_SUITE_P(GorillaPlanarMonotonicFloat,
+    CodecTest,
+    ::testing::Combine(
+        GorillaPlanarCodecsToTest,
+        ::testing::Values(
+            generateSeq<Float32>(G(MonotonicGenerator<Float32>(static_cast<Float32>(M_E), 5))),
+            generateSeq<Float64>(G(MonotonicGenerator<Float64>(M_E, 5))),
+            generateSeq<Float32>(G(MonotonicGenerator<Float32>(static_cast<Float32>(-1 * M_E), 5))),
+            generateSeq<Float64>(G(MonotonicGenerator<Float64>(-1 * M_E, 5)))
+        )
+    )
+);
+
+INSTANTIATE_TEST_SUITE_P(GorillaPlanarRandomishFloat,
+    CodecTest,
+    ::testing::Combine(
+        GorillaPlanarCodecsToTest,
+        ::testing::Values(
+            generateSeq<Float32>(G(RandomishGenerator)),
+            generateSeq<Float64>(G(RandomishGenerator))
+        )
+    )
+);
+
+// Extreme and all-bits-set/zero patterns.
+INSTANTIATE_TEST_SUITE_P(GorillaPlanarOverflowFloat,
+    CodecTest,
+    ::testing::Combine(
+        GorillaPlanarCodecsToTest,
+        ::testing::Values(
+            generateSeq<Float32>(G(MinMaxGenerator())),
+            generateSeq<Float64>(G(MinMaxGenerator())),
+            generateSeq<Float32>(G(FFand0Generator())),
+            generateSeq<Float64>(G(FFand0Generator()))
+        )
+    )
+);
+
+// Special values: zeroes of both signs, subnormals, infinities, extremes of the exponent range.
+INSTANTIATE_TEST_SUITE_P(GorillaPlanarSpecialFloat,
+    CodecTest,
+    ::testing::Combine(
+        GorillaPlanarCodecsToTest,
+        ::testing::Values(
+            makeSeq<Float32>(
+                0.0, -0.0,
+                std::numeric_limits<Float32>::denorm_min(), -std::numeric_limits<Float32>::denorm_min(),
+                std::numeric_limits<Float32>::min(), std::numeric_limits<Float32>::max(),
+                std::numeric_limits<Float32>::lowest(), std::numeric_limits<Float32>::epsilon(),
+                std::numeric_limits<Float32>::infinity(), -std::numeric_limits<Float32>::infinity()),
+            makeSeq<Float64>(
+                0.0, -0.0,
+                std::numeric_limits<Float64>::denorm_min(), -std::numeric_limits<Float64>::denorm_min(),
+                std::numeric_limits<Float64>::min(), std::numeric_limits<Float64>::max(),
+                std::numeric_limits<Float64>::lowest(), std::numeric_limits<Float64>::epsilon(),
+                std::numeric_limits<Float64>::infinity(), -std::numeric_limits<Float64>::infinity())
+        )
+    )
+);
+
 template <typename ValueType>
 auto DDCompatibilityTestSequence()
 {
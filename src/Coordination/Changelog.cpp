@@ -220,6 +220,7 @@ public:
                     [latest_log_disk, path = current_file_description->path] { return latest_log_disk->readFile(path); });
 
             prealloc_done = false;
+            dirty = true;
         }
         catch (...)
         {
@@ -294,6 +295,7 @@ public:
         }
 
         last_index_written = record.header.index;
+        dirty = true;
 
         return true;
     }
@@ -301,13 +303,17 @@ public:
     void flush()
     {
         auto * file_buffer = tryGetFileBaseBuffer();
-        if (file_buffer)
+        /// If nothing was written since the previous flush, the file is already durable
+        /// and the expensive fsync can be skipped (NuRaft may issue back-to-back flushes).
+        if (file_buffer && dirty)
         {
             /// Fsync file system if needed
             if (log_file_settings.force_sync)
                 file_buffer->sync();
             else
                 file_buffer->next();
+
+            dirty = false;
         }
         entry_storage.addLogLocations(std::move(unflushed_indices_with_log_location));
         unflushed_indices_with_log_location.clear();
@@ -494,6 +500,9 @@ private:
 
     bool prealloc_done{false};
 
+    /// Whether anything was written to the current file since the last flush.
+    bool dirty{false};
+
     LogFileSettings log_file_settings;
 
     KeeperContextPtr keeper_context;
@@ -1988,6 +1997,14 @@ void Changelog::writeThread()
             last_durable_idx = flush.index;
         }
 
+        /// Group commit statistics, see getKeeperLogInfo().
+        if (pending_appends > 0)
+        {
+            last_flush_batch_size.store(pending_appends, std::memory_order_relaxed);
+            total_flushed_entries.fetch_add(pending_appends, std::memory_order_relaxed);
+            total_flushes.fetch_add(1, std::memory_order_relaxed);
+        }
+
         pending_appends = 0;
     };
 
@@ -2428,6 +2445,10 @@ void Changelog::getKeeperLogInfo(KeeperLogInfo & log_info) const
         log_info.last_log_term = termAt(log_info.last_log_idx);
     }
 
+    log_info.last_flush_batch_size = last_flush_batch_size.load(std::memory_order_relaxed);
+    if (auto flushes = total_flushes.load(std::memory_order_relaxed))
+        log_info.avg_flush_batch_size = total_flushed_entries.load(std::memory_order_relaxed) / flushes;
+
     entry_storage.getKeeperLogInfo(log_info);
 }
 
@@ -4,6 +4,7 @@
 #include <Common/ThreadPool_fwd.h>
 #include <Common/ConcurrentBoundedQueue.h>
 
+#include <atomic>
 #include <map>
 #include <unordered_set>
 #include <future>
@@ -407,6 +408,12 @@ private:
     LogEntryStorage entry_storage;
 
     uint64_t max_log_id = 0;
+
+    /// Group commit statistics: how many appended entries the last flush (fsync) covered
+    /// and the totals for computing the average. See getKeeperLogInfo().
+    std::atomic<uint64_t> last_flush_batch_size{0};
+    std::atomic<uint64_t> total_flushed_entries{0};
+    std::atomic<uint64_t> total_flushes{0};
     /// For compaction, queue of delete not used logs
     /// 128 is enough, even if log is not removed, it's not a problem
     ConcurrentBoundedQueue<std::pair<std::string, DiskPtr>> log_files_to_delete_queue{128};
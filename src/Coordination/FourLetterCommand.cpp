@@ -576,6 +576,9 @@ String LogInfoCommand::run()
 
     append("commit_logs_cache_entries", log_info.commit_logs_cache_entries);
     append("commit_logs_cache_size", log_info.commit_logs_cache_size);
+
+    append("last_flush_batch_size", log_info.last_flush_batch_size);
+    append("avg_flush_batch_size", log_info.avg_flush_batch_size);
     return ret.str();
 }
 
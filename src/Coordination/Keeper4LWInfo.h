@@ -80,6 +80,11 @@ struct KeeperLogInfo
 
     uint64_t commit_logs_cache_entries;
     uint64_t commit_logs_cache_size;
+
+    /// Group commit of log appends: how many entries the last fsync covered
+    /// and the average over all flushes.
+    uint64_t last_flush_batch_size{0};
+    uint64_t avg_flush_batch_size{0};
 };
 
 }
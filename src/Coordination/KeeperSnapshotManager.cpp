@@ -1,4 +1,6 @@
+#include <deque>
 #include <filesystem>
+#include <future>
 #include <memory>
 #include <Compression/CompressedReadBuffer.h>
 #include <Compression/CompressedWriteBuffer.h>
@@ -14,12 +16,23 @@
 #include <IO/ReadBufferFromFile.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteBufferFromFile.h>
+#include <IO/WriteBufferFromString.h>
 #include <IO/WriteHelpers.h>
+#include <IO/ZstdDeflatingWriteBuffer.h>
 #include <IO/copyData.h>
+#include <Common/CurrentMetrics.h>
+#include <Common/ThreadPool.h>
 #include <Common/ZooKeeper/ZooKeeperCommon.h>
 #include <Common/ZooKeeper/ZooKeeperIO.h>
 #include <Common/logger_useful.h>
 
+namespace CurrentMetrics
+{
+    extern const Metric KeeperSnapshotSerializationThreads;
+    extern const Metric KeeperSnapshotSerializationThreadsActive;
+    extern const Metric KeeperSnapshotSerializationThreadsScheduled;
+}
+
 namespace DB
 {
 
@@ -193,114 +206,246 @@ namespace
         buffer->pos(0);
         return SnapshotMetadata::deserialize(*buffer);
     }
-}
-
-void KeeperStorageSnapshot::serialize(const KeeperStorageSnapshot & snapshot, WriteBuffer & out, KeeperContextPtr keeper_context)
-{
-    writeBinary(static_cast<uint8_t>(snapshot.version), out);
-    serializeSnapshotMetadata(snapshot.snapshot_meta, out);
 
-    if (snapshot.version >= SnapshotVersion::V5)
+    /// Everything which goes before the data tree: snapshot version and metadata,
+    /// ZXID with digest, max session id, ACL map and the amount of nodes to follow.
+    void serializeSnapshotPrefix(const KeeperStorageSnapshot & snapshot, WriteBuffer & out, const KeeperContextPtr & keeper_context)
     {
-        writeBinary(snapshot.zxid, out);
-        if (keeper_context->digestEnabled())
+        writeBinary(static_cast<uint8_t>(snapshot.version), out);
+        serializeSnapshotMetadata(snapshot.snapshot_meta, out);
+
+        if (snapshot.version >= SnapshotVersion::V5)
         {
-            writeBinary(static_cast<uint8_t>(KeeperStorage::CURRENT_DIGEST_VERSION), out);
-            writeBinary(snapshot.nodes_digest, out);
+            writeBinary(snapshot.zxid, out);
+            if (keeper_context->digestEnabled())
+            {
+                writeBinary(static_cast<uint8_t>(KeeperStorage::CURRENT_DIGEST_VERSION), out);
+                writeBinary(snapshot.nodes_digest, out);
+            }
+            else
+                writeBinary(static_cast<uint8_t>(KeeperStorage::NO_DIGEST), out);
         }
-        else
-            writeBinary(static_cast<uint8_t>(KeeperStorage::NO_DIGEST), out);
-    }
 
-    writeBinary(snapshot.session_id, out);
+        writeBinary(snapshot.session_id, out);
 
-    /// Better to sort before serialization, otherwise snapshots can be different on different replicas
-    std::vector<std::pair<int64_t, Coordination::ACLs>> sorted_acl_map(snapshot.acl_map.begin(), snapshot.acl_map.end());
-    ::sort(sorted_acl_map.begin(), sorted_acl_map.end());
-    /// Serialize ACLs map
-    writeBinary(sorted_acl_map.size(), out);
-    for (const auto & [acl_id, acls] : sorted_acl_map)
-    {
-        writeBinary(acl_id, out);
-        writeBinary(acls.size(), out);
-        for (const auto & acl : acls)
+        /// Better to sort before serialization, otherwise snapshots can be different on different replicas
+        std::vector<std::pair<int64_t, Coordination::ACLs>> sorted_acl_map(snapshot.acl_map.begin(), snapshot.acl_map.end());
+        ::sort(sorted_acl_map.begin(), sorted_acl_map.end());
+        /// Serialize ACLs map
+        writeBinary(sorted_acl_map.size(), out);
+        for (const auto & [acl_id, acls] : sorted_acl_map)
         {
-            writeBinary(acl.permissions, out);
-            writeBinary(acl.scheme, out);
-            writeBinary(acl.id, out);
+            writeBinary(acl_id, out);
+            writeBinary(acls.size(), out);
+            for (const auto & acl : acls)
+            {
+                writeBinary(acl.permissions, out);
+                writeBinary(acl.scheme, out);
+                writeBinary(acl.id, out);
+            }
         }
+
+        writeBinary(snapshot.snapshot_container_size - keeper_context->getSystemNodesWithData().size(), out);
     }
 
-    /// Serialize data tree
-    writeBinary(snapshot.snapshot_container_size - keeper_context->getSystemNodesWithData().size(), out);
-    size_t counter = 0;
-    for (auto it = snapshot.begin; counter < snapshot.snapshot_container_size; ++counter)
+    /// Traversal of the data tree shared by the single-threaded and the multithreaded
+    /// serialization paths, preserving all quirks of the snapshot iterator.
+    template <typename OnNode>
+    void forEachSnapshotNode(const KeeperStorageSnapshot & snapshot, OnNode && on_node)
     {
-        const auto & path = it->key;
-
-        // write only the root system path because of digest
-        if (Coordination::matchPath(path.toView(), keeper_system_path) == Coordination::PathMatchResult::IS_CHILD)
+        size_t counter = 0;
+        for (auto it = snapshot.begin; counter < snapshot.snapshot_container_size; ++counter)
         {
+            const auto & path = it->key;
+
+            // write only the root system path because of digest
+            if (Coordination::matchPath(path.toView(), keeper_system_path) == Coordination::PathMatchResult::IS_CHILD)
+            {
+                if (counter == snapshot.snapshot_container_size - 1)
+                    break;
+
+                ++it;
+                continue;
+            }
+
+            const auto & node = it->value;
+
+            /// Benign race condition possible while taking snapshot: NuRaft decide to create snapshot at some log id
+            /// and only after some time we lock storage and enable snapshot mode. So snapshot_container_size can be
+            /// slightly bigger than required.
+            if (node.mzxid > snapshot.zxid)
+                break;
+
+            on_node(path, node);
+
+            /// Last iteration: check and exit here without iterator increment. Otherwise
+            /// false positive race condition on list end is possible.
             if (counter == snapshot.snapshot_container_size - 1)
                 break;
 
             ++it;
-            continue;
+        }
+    }
+
+    /// Everything which goes after the data tree: sessions and cluster config.
+    void serializeSnapshotSuffix(const KeeperStorageSnapshot & snapshot, WriteBuffer & out)
+    {
+        /// Session must be saved in a sorted order,
+        /// otherwise snapshots will be different
+        std::vector<std::pair<int64_t, int64_t>> sorted_session_and_timeout(
+            snapshot.session_and_timeout.begin(), snapshot.session_and_timeout.end());
+        ::sort(sorted_session_and_timeout.begin(), sorted_session_and_timeout.end());
+
+        /// Serialize sessions
+        size_t size = sorted_session_and_timeout.size();
+
+        writeBinary(size, out);
+        for (const auto & [session_id, timeout] : sorted_session_and_timeout)
+        {
+            writeBinary(session_id, out);
+            writeBinary(timeout, out);
+
+            KeeperStorage::AuthIDs ids;
+            if (snapshot.session_and_auth.contains(session_id))
+                ids = snapshot.session_and_auth.at(session_id);
+
+            writeBinary(ids.size(), out);
+            for (const auto & [scheme, id] : ids)
+            {
+                writeBinary(scheme, out);
+                writeBinary(id, out);
+            }
+        }
+
+        /// Serialize cluster config
+        if (snapshot.cluster_config)
+        {
+            auto buffer = snapshot.cluster_config->serialize();
+            writeVarUInt(buffer->size(), out);
+            out.write(reinterpret_cast<const char *>(buffer->data_begin()), buffer->size());
+        }
+    }
+
+    /// A self-contained compressed stream buffered in memory. Both ZstdInflatingReadBuffer
+    /// and CompressedReadBuffer decompress a concatenation of such streams as if the data
+    /// was compressed in one pass, which is what makes parallel compression possible.
+    struct CompressedSnapshotSegment
+    {
+        explicit CompressedSnapshotSegment(bool compress_zstd)
+        {
+            if (compress_zstd)
+                compressed_out = std::make_unique<ZstdDeflatingWriteBuffer>(&plain_out, /* compression_level */ 3);
+            else
+                compressed_out = std::make_unique<CompressedWriteBuffer>(plain_out);
+        }
+
+        String detach()
+        {
+            compressed_out->finalize();
+            return std::move(plain_out.str());
         }
 
-        const auto & node = it->value;
+        WriteBufferFromOwnString plain_out;
+        std::unique_ptr<WriteBuffer> compressed_out;
+    };
+}
 
-        /// Benign race condition possible while taking snapshot: NuRaft decide to create snapshot at some log id
-        /// and only after some time we lock storage and enable snapshot mode. So snapshot_container_size can be
-        /// slightly bigger than required.
-        if (node.mzxid > snapshot.zxid)
-            break;
+void KeeperStorageSnapshot::serialize(const KeeperStorageSnapshot & snapshot, WriteBuffer & out, KeeperContextPtr keeper_context)
+{
+    serializeSnapshotPrefix(snapshot, out, keeper_context);
 
+    /// Serialize data tree
+    forEachSnapshotNode(snapshot, [&](StringRef path, const KeeperStorage::Node & node)
+    {
         writeBinary(path, out);
         writeNode(node, snapshot.version, out);
+    });
 
-        /// Last iteration: check and exit here without iterator increment. Otherwise
-        /// false positive race condition on list end is possible.
-        if (counter == snapshot.snapshot_container_size - 1)
-            break;
+    serializeSnapshotSuffix(snapshot, out);
+}
 
-        ++it;
-    }
+void KeeperStorageSnapshot::serializeMultithreaded(
+    const KeeperStorageSnapshot & snapshot, WriteBuffer & out, KeeperContextPtr keeper_context, bool compress_zstd, size_t threads)
+{
+    /// Amount of nodes which one task serializes and compresses into its own segment.
+    static constexpr size_t NODES_PER_SEGMENT = 100000;
 
-    /// Session must be saved in a sorted order,
-    /// otherwise snapshots will be different
-    std::vector<std::pair<int64_t, int64_t>> sorted_session_and_timeout(
-        snapshot.session_and_timeout.begin(), snapshot.session_and_timeout.end());
-    ::sort(sorted_session_and_timeout.begin(), sorted_session_and_timeout.end());
+    ThreadPool pool(
+        CurrentMetrics::KeeperSnapshotSerializationThreads,
+        CurrentMetrics::KeeperSnapshotSerializationThreadsActive,
+        CurrentMetrics::KeeperSnapshotSerializationThreadsScheduled,
+        threads);
+
+    /// Compressed segments in the order they must appear in the snapshot file.
+    std::deque<std::future<String>> pending_segments;
+
+    auto write_finished_segment = [&]
+    {
+        auto segment = pending_segments.front().get();
+        pending_segments.pop_front();
+        out.write(segment.data(), segment.size());
+    };
 
-    /// Serialize sessions
-    size_t size = sorted_session_and_timeout.size();
+    auto schedule_segment = [&](std::function<void(WriteBuffer &)> fill_segment)
+    {
+        auto task = std::make_shared<std::packaged_task<String()>>(
+            [fill = std::move(fill_segment), compress_zstd]
+            {
+                CompressedSnapshotSegment segment(compress_zstd);
+                fill(*segment.compressed_out);
+                return segment.detach();
+            });
+        pending_segments.push_back(task->get_future());
+        pool.scheduleOrThrowOnError([task] { (*task)(); });
+
+        /// Bound the amount of segments buffered in memory. Finished segments are
+        /// streamed to disk while workers compress the following ones.
+        while (pending_segments.size() > threads * 2)
+            write_finished_segment();
+    };
 
-    writeBinary(size, out);
-    for (const auto & [session_id, timeout] : sorted_session_and_timeout)
+    schedule_segment([&snapshot, keeper_context](WriteBuffer & segment_out)
     {
-        writeBinary(session_id, out);
-        writeBinary(timeout, out);
+        serializeSnapshotPrefix(snapshot, segment_out, keeper_context);
+    });
 
-        KeeperStorage::AuthIDs ids;
-        if (snapshot.session_and_auth.contains(session_id))
-            ids = snapshot.session_and_auth.at(session_id);
+    /// Nodes are frozen by the snapshot mode of SnapshotableHashTable for the whole
+    /// lifetime of KeeperStorageSnapshot, so worker threads can read them while the
+    /// traversal continues.
+    std::vector<std::pair<StringRef, const KeeperStorage::Node *>> batch;
+    batch.reserve(NODES_PER_SEGMENT);
 
-        writeBinary(ids.size(), out);
-        for (const auto & [scheme, id] : ids)
+    auto flush_batch = [&]
+    {
+        schedule_segment([nodes = std::move(batch), version = snapshot.version](WriteBuffer & segment_out)
         {
-            writeBinary(scheme, out);
-            writeBinary(id, out);
-        }
-    }
+            for (const auto & [path, node] : nodes)
+            {
+                writeBinary(path, segment_out);
+                writeNode(*node, version, segment_out);
+            }
+        });
+        batch = {};
+        batch.reserve(NODES_PER_SEGMENT);
+    };
 
-    /// Serialize cluster config
-    if (snapshot.cluster_config)
+    forEachSnapshotNode(snapshot, [&](StringRef path, const KeeperStorage::Node & node)
     {
-        auto buffer = snapshot.cluster_config->serialize();
-        writeVarUInt(buffer->size(), out);
-        out.write(reinterpret_cast<const char *>(buffer->data_begin()), buffer->size());
-    }
+        batch.emplace_back(path, &node);
+        if (batch.size() == NODES_PER_SEGMENT)
+            flush_batch();
+    });
+
+    if (!batch.empty())
+        flush_batch();
+
+    schedule_segment([&snapshot](WriteBuffer & segment_out)
+    {
+        serializeSnapshotSuffix(snapshot, segment_out);
+    });
+
+    while (!pending_segments.empty())
+        write_finished_segment();
 }
 
 void KeeperStorageSnapshot::deserialize(SnapshotDeserializationResult & deserialization_result, ReadBuffer & in, KeeperContextPtr keeper_context)
@@ -836,15 +981,25 @@ SnapshotFileInfoPtr KeeperSnapshotManager::serializeSnapshotToDisk(const KeeperS
     }
 
     auto writer = disk->writeFile(snapshot_file_name);
-    std::unique_ptr<WriteBuffer> compressed_writer;
-    if (compress_snapshots_zstd)
-        compressed_writer = wrapWriteBufferWithCompressionMethod(std::move(writer), CompressionMethod::Zstd, 3);
+
+    if (size_t serialization_threads = keeper_context->getCoordinationSettings()->snapshot_serialization_threads; serialization_threads > 1)
+    {
+        KeeperStorageSnapshot::serializeMultithreaded(snapshot, *writer, keeper_context, compress_snapshots_zstd, serialization_threads);
+        writer->finalize();
+        writer->sync();
+    }
     else
-        compressed_writer = std::make_unique<CompressedWriteBuffer>(*writer);
+    {
+        std::unique_ptr<WriteBuffer> compressed_writer;
+        if (compress_snapshots_zstd)
+            compressed_writer = wrapWriteBufferWithCompressionMethod(std::move(writer), CompressionMethod::Zstd, 3);
+        else
+            compressed_writer = std::make_unique<CompressedWriteBuffer>(*writer);
 
-    KeeperStorageSnapshot::serialize(snapshot, *compressed_writer, keeper_context);
-    compressed_writer->finalize();
-    compressed_writer->sync();
+        KeeperStorageSnapshot::serialize(snapshot, *compressed_writer, keeper_context);
+        compressed_writer->finalize();
+        compressed_writer->sync();
+    }
 
     disk->removeFile(tmp_snapshot_file_name);
 
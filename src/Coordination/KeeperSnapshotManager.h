@@ -64,6 +64,14 @@ public:
 
     static void serialize(const KeeperStorageSnapshot & snapshot, WriteBuffer & out, KeeperContextPtr keeper_context);
 
+    /// Same result as serialize() followed by compression, but the data tree is split into
+    /// batches which are serialized and compressed by several threads into independent
+    /// compressed streams, concatenated into `out` in order. Both ZSTD and the custom LZ4
+    /// block format decompress concatenated streams transparently, so snapshots written
+    /// this way are readable by the usual sequential decompressing reader.
+    static void serializeMultithreaded(
+        const KeeperStorageSnapshot & snapshot, WriteBuffer & out, KeeperContextPtr keeper_context, bool compress_zstd, size_t threads);
+
     static void deserialize(SnapshotDeserializationResult & deserialization_result, ReadBuffer & in, KeeperContextPtr keeper_context);
 
     KeeperStorage * storage;
@@ -14,6 +14,7 @@
 #include <sys/mman.h>
 #include <Common/Exception.h>
 #include <Common/ProfileEvents.h>
+#include <Common/SharedLockGuard.h>
 #include <Common/ZooKeeper/ZooKeeperCommon.h>
 #include <Common/ZooKeeper/ZooKeeperIO.h>
 #include <Common/logger_useful.h>
@@ -763,8 +764,9 @@ int KeeperStateMachine::read_logical_snp_obj(
 
 void KeeperStateMachine::processReadRequest(const KeeperStorage::RequestForSession & request_for_session)
 {
-    /// Pure local request, just process it with storage
-    std::lock_guard lock(storage_and_responses_lock);
+    /// Pure local request, just process it with storage. Multiple read requests
+    /// can be processed in parallel, they only share the storage for reading.
+    SharedLockGuard lock(storage_and_responses_lock);
     auto responses = storage->processRequest(
         request_for_session.request, request_for_session.session_id, std::nullopt, true /*check_acl*/, true /*is_local*/);
     for (const auto & response : responses)
@@ -780,91 +782,91 @@ void KeeperStateMachine::shutdownStorage()
 
 std::vector<int64_t> KeeperStateMachine::getDeadSessions()
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getDeadSessions();
 }
 
 int64_t KeeperStateMachine::getNextZxid() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getNextZXID();
 }
 
 KeeperStorage::Digest KeeperStateMachine::getNodesDigest() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getNodesDigest(false);
 }
 
 uint64_t KeeperStateMachine::getLastProcessedZxid() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getZXID();
 }
 
 uint64_t KeeperStateMachine::getNodesCount() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getNodesCount();
 }
 
 uint64_t KeeperStateMachine::getTotalWatchesCount() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getTotalWatchesCount();
 }
 
 uint64_t KeeperStateMachine::getWatchedPathsCount() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getWatchedPathsCount();
 }
 
 uint64_t KeeperStateMachine::getSessionsWithWatchesCount() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getSessionsWithWatchesCount();
 }
 
 uint64_t KeeperStateMachine::getTotalEphemeralNodesCount() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getTotalEphemeralNodesCount();
 }
 
 uint64_t KeeperStateMachine::getSessionWithEphemeralNodesCount() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getSessionWithEphemeralNodesCount();
 }
 
 void KeeperStateMachine::dumpWatches(WriteBufferFromOwnString & buf) const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     storage->dumpWatches(buf);
 }
 
 void KeeperStateMachine::dumpWatchesByPath(WriteBufferFromOwnString & buf) const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     storage->dumpWatchesByPath(buf);
 }
 
 void KeeperStateMachine::dumpSessionsAndEphemerals(WriteBufferFromOwnString & buf) const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     storage->dumpSessionsAndEphemerals(buf);
 }
 
 uint64_t KeeperStateMachine::getApproximateDataSize() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getApproximateDataSize();
 }
 
 uint64_t KeeperStateMachine::getKeyArenaSize() const
 {
-    std::lock_guard lock(storage_and_responses_lock);
+    SharedLockGuard lock(storage_and_responses_lock);
     return storage->getArenaDataSize();
 }
 
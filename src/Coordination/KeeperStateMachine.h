@@ -8,6 +8,7 @@
 
 #include <libnuraft/nuraft.hxx>
 #include <Common/ConcurrentBoundedQueue.h>
+#include <Common/SharedMutex.h>
 
 
 namespace DB
@@ -158,7 +159,11 @@ private:
     /// we can get strange cases when, for example client send read request with
     /// watch and after that receive watch response and only receive response
     /// for request.
-    mutable std::mutex storage_and_responses_lock;
+    /// Commits and other state mutations take exclusive ownership, while local read
+    /// requests and introspection take shared ownership so they can run concurrently
+    /// and don't queue behind each other. The structures local reads still mutate
+    /// (watch lists, session expiry) are protected inside KeeperStorage.
+    mutable SharedMutex storage_and_responses_lock;
 
     std::unordered_map<int64_t, std::unordered_map<Coordination::XID, std::shared_ptr<KeeperStorage::RequestForSession>>> parsed_request_cache;
     uint64_t min_request_size_to_cache{0};
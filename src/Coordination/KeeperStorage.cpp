@@ -2142,9 +2142,12 @@ void KeeperStorage::finalize()
 
     ephemerals.clear();
 
-    watches.clear();
-    list_watches.clear();
-    sessions_and_watchers.clear();
+    {
+        std::lock_guard lock(watches_mutex);
+        watches.clear();
+        list_watches.clear();
+        sessions_and_watchers.clear();
+    }
     session_expiry_queue.clear();
 }
 
@@ -2409,22 +2412,28 @@ KeeperStorage::ResponsesForSessions KeeperStorage::processRequest(
 
     KeeperStorage::ResponsesForSessions results;
 
-    /// ZooKeeper update sessions expirity for each request, not only for heartbeats
-    session_expiry_queue.addNewSessionOrUpdate(session_id, session_and_timeout[session_id]);
+    /// ZooKeeper update sessions expirity for each request, not only for heartbeats.
+    /// Lookup without inserting: local read requests are processed under shared storage
+    /// ownership, and a read racing with session close must not revive the session.
+    if (auto session_it = session_and_timeout.find(session_id); session_it != session_and_timeout.end())
+        session_expiry_queue.addNewSessionOrUpdate(session_id, session_it->second);
 
     if (zk_request->getOpNum() == Coordination::OpNum::Close) /// Close request is special
     {
         commit(zxid);
 
-        for (const auto & delta : uncommitted_state.deltas)
         {
-            if (delta.zxid > zxid)
-                break;
-
-            if (std::holds_alternative<RemoveNodeDelta>(delta.operation))
+            std::lock_guard lock(watches_mutex);
+            for (const auto & delta : uncommitted_state.deltas)
             {
-                auto responses = processWatchesImpl(delta.path, watches, list_watches, Coordination::Event::DELETED);
-                results.insert(results.end(), responses.begin(), responses.end());
+                if (delta.zxid > zxid)
+                    break;
+
+                if (std::holds_alternative<RemoveNodeDelta>(delta.operation))
+                {
+                    auto responses = processWatchesImpl(delta.path, watches, list_watches, Coordination::Event::DELETED);
+                    results.insert(results.end(), responses.begin(), responses.end());
+                }
             }
         }
 
@@ -2477,37 +2486,41 @@ KeeperStorage::ResponsesForSessions KeeperStorage::processRequest(
             uncommitted_state.commit(zxid);
         }
 
-        /// Watches for this requests are added to the watches lists
-        if (zk_request->has_watch)
         {
-            if (response->error == Coordination::Error::ZOK)
+            std::lock_guard lock(watches_mutex);
+
+            /// Watches for this requests are added to the watches lists
+            if (zk_request->has_watch)
             {
-                static constexpr std::array list_requests{
-                    Coordination::OpNum::List, Coordination::OpNum::SimpleList, Coordination::OpNum::FilteredList};
+                if (response->error == Coordination::Error::ZOK)
+                {
+                    static constexpr std::array list_requests{
+                        Coordination::OpNum::List, Coordination::OpNum::SimpleList, Coordination::OpNum::FilteredList};
 
-                auto & watches_type = std::find(list_requests.begin(), list_requests.end(), zk_request->getOpNum()) != list_requests.end()
-                    ? list_watches
-                    : watches;
+                    auto & watches_type = std::find(list_requests.begin(), list_requests.end(), zk_request->getOpNum()) != list_requests.end()
+                        ? list_watches
+                        : watches;
 
-                auto add_watch_result = watches_type[zk_request->getPath()].emplace(session_id);
-                if (add_watch_result.second)
-                    sessions_and_watchers[session_id].emplace(zk_request->getPath());
+                    auto add_watch_result = watches_type[zk_request->getPath()].emplace(session_id);
+                    if (add_watch_result.second)
+                        sessions_and_watchers[session_id].emplace(zk_request->getPath());
+                }
+                else if (response->error == Coordination::Error::ZNONODE && zk_request->getOpNum() == Coordination::OpNum::Exists)
+                {
+                    auto add_watch_result = watches[zk_request->getPath()].emplace(session_id);
+                    if (add_watch_result.second)
+                        sessions_and_watchers[session_id].emplace(zk_request->getPath());
+                }
             }
-            else if (response->error == Coordination::Error::ZNONODE && zk_request->getOpNum() == Coordination::OpNum::Exists)
+
+            /// If this requests processed successfully we need to check watches
+            if (response->error == Coordination::Error::ZOK)
             {
-                auto add_watch_result = watches[zk_request->getPath()].emplace(session_id);
-                if (add_watch_result.second)
-                    sessions_and_watchers[session_id].emplace(zk_request->getPath());
+                auto watch_responses = request_processor->processWatches(watches, list_watches);
+                results.insert(results.end(), watch_responses.begin(), watch_responses.end());
             }
         }
 
-        /// If this requests processed successfully we need to check watches
-        if (response->error == Coordination::Error::ZOK)
-        {
-            auto watch_responses = request_processor->processWatches(watches, list_watches);
-            results.insert(results.end(), watch_responses.begin(), watch_responses.end());
-        }
-
         response->xid = zk_request->xid;
         response->zxid = getZXID();
 
@@ -2571,6 +2584,8 @@ void KeeperStorage::addDigest(const Node & node, const std::string_view path)
 
 void KeeperStorage::clearDeadWatches(int64_t session_id)
 {
+    std::lock_guard lock(watches_mutex);
+
     /// Clear all watches for this session
     auto watches_it = sessions_and_watchers.find(session_id);
     if (watches_it != sessions_and_watchers.end())
@@ -2604,6 +2619,7 @@ void KeeperStorage::clearDeadWatches(int64_t session_id)
 
 void KeeperStorage::dumpWatches(WriteBufferFromOwnString & buf) const
 {
+    std::lock_guard lock(watches_mutex);
     for (const auto & [session_id, watches_paths] : sessions_and_watchers)
     {
         buf << "0x" << getHexUIntLowercase(session_id) << "\n";
@@ -2622,6 +2638,7 @@ void KeeperStorage::dumpWatchesByPath(WriteBufferFromOwnString & buf) const
         }
     };
 
+    std::lock_guard lock(watches_mutex);
     for (const auto & [watch_path, sessions] : watches)
     {
         buf << watch_path << "\n";
@@ -2662,6 +2679,7 @@ void KeeperStorage::dumpSessionsAndEphemerals(WriteBufferFromOwnString & buf) co
 
 uint64_t KeeperStorage::getTotalWatchesCount() const
 {
+    std::lock_guard lock(watches_mutex);
     uint64_t ret = 0;
     for (const auto & [session, paths] : sessions_and_watchers)
         ret += paths.size();
@@ -2671,6 +2689,7 @@ uint64_t KeeperStorage::getTotalWatchesCount() const
 
 uint64_t KeeperStorage::getSessionsWithWatchesCount() const
 {
+    std::lock_guard lock(watches_mutex);
     return sessions_and_watchers.size();
 }
 
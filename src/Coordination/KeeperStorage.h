@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <Coordination/ACLMap.h>
@@ -455,6 +456,11 @@ public:
     Watches watches;
     Watches list_watches; /// Watches for 'list' request (watches on children).
 
+    /// Local read requests register watches while the state machine holds only shared
+    /// ownership of the storage, so the watch lists are protected by their own mutex
+    /// (it also covers sessions_and_watchers).
+    mutable std::mutex watches_mutex;
+
     void clearDeadWatches(int64_t session_id);
 
     /// Get current committed zxid
@@ -548,7 +554,11 @@ public:
 
     uint64_t getTotalWatchesCount() const;
 
-    uint64_t getWatchedPathsCount() const { return watches.size() + list_watches.size(); }
+    uint64_t getWatchedPathsCount() const
+    {
+        std::lock_guard lock(watches_mutex);
+        return watches.size() + list_watches.size();
+    }
 
     uint64_t getSessionsWithWatchesCount() const;
 
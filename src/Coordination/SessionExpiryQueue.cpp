@@ -6,6 +6,7 @@ namespace DB
 
 bool SessionExpiryQueue::remove(int64_t session_id)
 {
+    std::lock_guard lock(mutex);
     auto session_it = session_to_expiration_time.find(session_id);
     if (session_it != session_to_expiration_time.end())
     {
@@ -31,6 +32,7 @@ void SessionExpiryQueue::addNewSessionOrUpdate(int64_t session_id, int64_t timeo
     /// round up to next interval
     int64_t new_expiry_time = roundToNextInterval(now + timeout_ms);
 
+    std::lock_guard lock(mutex);
     auto session_it = session_to_expiration_time.find(session_id);
     /// We already registered this session
     if (session_it != session_to_expiration_time.end())
@@ -76,6 +78,7 @@ std::vector<int64_t> SessionExpiryQueue::getExpiredSessions() const
     int64_t now = getNowMilliseconds();
     std::vector<int64_t> result;
 
+    std::lock_guard lock(mutex);
     /// Check all buckets
     for (const auto & [expire_time, expired_sessions] : expiry_to_sessions)
     {
@@ -90,6 +93,7 @@ std::vector<int64_t> SessionExpiryQueue::getExpiredSessions() const
 
 void SessionExpiryQueue::clear()
 {
+    std::lock_guard lock(mutex);
     session_to_expiration_time.clear();
     expiry_to_sessions.clear();
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -20,6 +21,10 @@ namespace DB
 class SessionExpiryQueue
 {
 private:
+    /// Session expiry is refreshed on each request, including local read requests
+    /// which are processed concurrently, so the queue synchronizes itself.
+    mutable std::mutex mutex;
+
     /// Session -> timeout ms
     std::unordered_map<int64_t, int64_t> session_to_expiration_time;
 
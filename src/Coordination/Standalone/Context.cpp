@@ -309,7 +309,7 @@ IAsynchronousReader & Context::getThreadPoolReader(FilesystemReaderType type) co
 IOUringReader & Context::getIOUringReader() const
 {
     callOnce(shared->io_uring_reader_initialized, [&] {
-        shared->io_uring_reader = createIOUringReader();
+        shared->io_uring_reader = createIOUringReader(getConfigRef());
     });
 
     return *shared->io_uring_reader;
@@ -846,6 +846,12 @@ void materializeBlockInplace(Block & block)
         block.getByPosition(i).column = recursiveRemoveSparse(block.getByPosition(i).column->convertToFullColumnIfConst());
 }
 
+void decompressBlockColumns(Block & block)
+{
+    for (auto & column : block)
+        column.column = column.column->decompress();
+}
+
 Block concatenateBlocks(const std::vector<Block> & blocks)
 {
     if (blocks.empty())
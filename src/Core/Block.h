@@ -213,6 +213,9 @@ void convertToFullIfSparse(Block & block);
 Block materializeBlock(const Block & block);
 void materializeBlockInplace(Block & block);
 
+/// Decompresses lazily compressed columns (see ColumnCompressed). No-op for ordinary columns.
+void decompressBlockColumns(Block & block);
+
 Block concatenateBlocks(const std::vector<Block> & blocks);
 
 }
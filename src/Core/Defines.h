@@ -92,12 +92,23 @@ static constexpr auto DEFAULT_UNCOMPRESSED_CACHE_SIZE_RATIO = 0.5l;
 static constexpr auto DEFAULT_MARK_CACHE_POLICY = "SLRU";
 static constexpr auto DEFAULT_MARK_CACHE_MAX_SIZE = 5368_MiB;
 static constexpr auto DEFAULT_MARK_CACHE_SIZE_RATIO = 0.5l;
+static constexpr auto DEFAULT_EXTERNAL_TABLES_DEDUP_CACHE_MAX_SIZE = 4096_MiB;
 static constexpr auto DEFAULT_INDEX_UNCOMPRESSED_CACHE_POLICY = "SLRU";
 static constexpr auto DEFAULT_INDEX_UNCOMPRESSED_CACHE_MAX_SIZE = 0;
 static constexpr auto DEFAULT_INDEX_UNCOMPRESSED_CACHE_SIZE_RATIO = 0.5;
 static constexpr auto DEFAULT_INDEX_MARK_CACHE_POLICY = "SLRU";
 static constexpr auto DEFAULT_INDEX_MARK_CACHE_MAX_SIZE = 5368_MiB;
 static constexpr auto DEFAULT_INDEX_MARK_CACHE_SIZE_RATIO = 0.3;
+static constexpr auto DEFAULT_SKIPPING_INDEX_RESULT_CACHE_POLICY = "SLRU";
+static constexpr auto DEFAULT_SKIPPING_INDEX_RESULT_CACHE_MAX_SIZE = 128_MiB;
+static constexpr auto DEFAULT_SKIPPING_INDEX_RESULT_CACHE_SIZE_RATIO = 0.5;
+static constexpr auto DEFAULT_FILTERED_GRANULE_CACHE_POLICY = "SLRU";
+static constexpr auto DEFAULT_FILTERED_GRANULE_CACHE_MAX_SIZE = 256_MiB;
+static constexpr auto DEFAULT_FILTERED_GRANULE_CACHE_SIZE_RATIO = 0.5;
+
+static constexpr auto DEFAULT_ANN_INDEX_CACHE_POLICY = "SLRU";
+static constexpr auto DEFAULT_ANN_INDEX_CACHE_MAX_SIZE = 1_GiB;
+static constexpr auto DEFAULT_ANN_INDEX_CACHE_SIZE_RATIO = 0.5;
 static constexpr auto DEFAULT_MMAP_CACHE_MAX_SIZE = 1_KiB; /// chosen by rolling dice
 static constexpr auto DEFAULT_COMPILED_EXPRESSION_CACHE_MAX_SIZE = 128_MiB;
 static constexpr auto DEFAULT_COMPILED_EXPRESSION_CACHE_MAX_ENTRIES = 10'000;
@@ -93,7 +93,9 @@ namespace Protocol
             MergeTreeReadTaskRequest = 16,  /// Request from a MergeTree replica to a coordinator
             TimezoneUpdate = 17,            /// Receive server's (session-wide) default timezone
             SSHChallenge = 18,              /// Return challenge for SSH signature signing
-            MAX = SSHChallenge,
+            ExternalTablesRequest = 19,     /// Names of the external tables the server wants to receive
+                                            /// (the rest it already holds in its content-addressed cache).
+            MAX = ExternalTablesRequest,
 
         };
 
@@ -123,6 +125,7 @@ namespace Protocol
                 "MergeTreeReadTaskRequest",
                 "TimezoneUpdate",
                 "SSHChallenge",
+                "ExternalTablesRequest",
             };
             return packet <= MAX
                 ? data[packet]
@@ -163,7 +166,9 @@ namespace Protocol
 
             SSHChallengeRequest = 11,       /// Request SSH signature challenge
             SSHChallengeResponse = 12,      /// Reply to SSH signature challenge
-            MAX = SSHChallengeResponse,
+            ExternalTablesHashes = 13,      /// Content hashes of the external tables the client is about to send.
+            SortThreshold = 14,             /// The current k-th sort key of a distributed ORDER BY ... LIMIT query.
+            MAX = SortThreshold,
         };
 
         inline const char * toString(UInt64 packet)
@@ -181,7 +186,9 @@ namespace Protocol
                 "ReadTaskResponse",
                 "MergeTreeReadTaskResponse",
                 "SSHChallengeRequest",
-                "SSHChallengeResponse"
+                "SSHChallengeResponse",
+                "ExternalTablesHashes",
+                "SortThreshold",
             };
             return packet <= MAX
                 ? data[packet]
@@ -81,6 +81,28 @@ static constexpr auto DBMS_MIN_REVISION_WITH_TABLE_READ_ONLY_CHECK = 54467;
 
 static constexpr auto DBMS_MIN_REVISION_WITH_SYSTEM_KEYWORDS_TABLE = 54468;
 
+/// The client decompresses every frame of the result stream with the codec recorded in
+/// the frame header, so the server may switch codecs between frames (adaptive network compression).
+static constexpr auto DBMS_MIN_REVISION_WITH_ADAPTIVE_NETWORK_COMPRESSION = 54469;
+
+/// The client may announce content hashes of external tables before sending them, so that
+/// the server requests only the ones missing from its content-addressed cache.
+static constexpr auto DBMS_MIN_REVISION_WITH_EXTERNAL_TABLES_DEDUP = 54470;
+
+/// The server accepts SortThreshold packets during query execution: the initiator of
+/// a distributed ORDER BY ... LIMIT query pushes the current k-th sort key back to the
+/// shards, which use it to discard rows that cannot be a part of the result.
+static constexpr auto DBMS_MIN_REVISION_WITH_SORT_THRESHOLD = 54471;
+
+/// Data packets can be sent as per-column compressed chunks (if the
+/// remote_exchange_lazy_decompression setting is enabled), so that the receiver can
+/// decompress columns lazily. See Connection::receiveLazyData().
+static constexpr auto DBMS_MIN_REVISION_WITH_LAZY_EXCHANGE_BLOCKS = 54472;
+
+/// States of uniqExact over integral keys are serialized as a sorted,
+/// delta-encoded set (version 1 of the state).
+static constexpr auto DBMS_MIN_REVISION_WITH_UNIQ_EXACT_COMPACT_STATE = 54473;
+
 /// Version of ClickHouse TCP protocol.
 ///
 /// Should be incremented manually on protocol changes.
@@ -88,6 +110,6 @@ static constexpr auto DBMS_MIN_REVISION_WITH_SYSTEM_KEYWORDS_TABLE = 54468;
 /// NOTE: DBMS_TCP_PROTOCOL_VERSION has nothing common with VERSION_REVISION,
 /// later is just a number for server version (one number instead of commit SHA)
 /// for simplicity (sometimes it may be more convenient in some use cases).
-static constexpr auto DBMS_TCP_PROTOCOL_VERSION = 54468;
+static constexpr auto DBMS_TCP_PROTOCOL_VERSION = 54473;
 
 }
@@ -12,6 +12,7 @@ void ServerSettings::loadSettingsFromConfig(const Poco::Util::AbstractConfigurat
     std::unordered_set<std::string> settings_from_profile_allowlist = {
         "background_pool_size",
         "background_merges_mutations_concurrency_ratio",
+        "background_merges_mutations_concurrency_limit",
         "background_merges_mutations_scheduling_policy",
         "background_move_pool_size",
         "background_fetches_pool_size",
@@ -55,9 +55,11 @@ namespace DB
     M(GroupArrayActionWhenLimitReached, aggregate_function_group_array_action_when_limit_is_reached, GroupArrayActionWhenLimitReached::THROW, "Action to execute when max array element size is exceeded in groupArray: `throw` exception, or `discard` extra values", 0) \
     M(UInt64, max_server_memory_usage, 0, "Maximum total memory usage of the server in bytes. Zero means unlimited.", 0) \
     M(Double, max_server_memory_usage_to_ram_ratio, 0.9, "Same as max_server_memory_usage but in to RAM ratio. Allows to lower max memory on low-memory systems.", 0) \
+    M(Double, max_server_memory_usage_soft_limit_ratio, 0, "Fraction of the effective max_server_memory_usage above which spillable operators (aggregations, sorts) are cooperatively asked to move their in-memory state to disk. Zero means disabled.", 0) \
     M(UInt64, merges_mutations_memory_usage_soft_limit, 0, "Maximum total memory usage for merges and mutations in bytes. Zero means unlimited.", 0) \
     M(Double, merges_mutations_memory_usage_to_ram_ratio, 0.5, "Same as merges_mutations_memory_usage_soft_limit but in to RAM ratio. Allows to lower memory limit on low-memory systems.", 0) \
     M(Bool, allow_use_jemalloc_memory, true, "Allows to use jemalloc memory.", 0) \
+    M(Double, memory_allocator_purge_rss_excess_ratio, 0, "If positive and the part of RSS not accounted by the memory tracker exceeds this ratio of RSS, unused memory of the allocator is purged back to the OS. Zero means automatic purging is disabled.", 0) \
     M(UInt64, cgroups_memory_usage_observer_wait_time, 15, "Polling interval in seconds to read the current memory usage from cgroups. Zero means disabled.", 0) \
     M(Double, cgroup_memory_watcher_hard_limit_ratio, 0.95, "Hard memory limit ratio for cgroup memory usage observer", 0) \
     M(Double, cgroup_memory_watcher_soft_limit_ratio, 0.9, "Soft memory limit ratio limit for cgroup memory usage observer", 0) \
@@ -74,6 +76,7 @@ namespace DB
     M(String, uncompressed_cache_policy, DEFAULT_UNCOMPRESSED_CACHE_POLICY, "Uncompressed cache policy name.", 0) \
     M(UInt64, uncompressed_cache_size, DEFAULT_UNCOMPRESSED_CACHE_MAX_SIZE, "Size of cache for uncompressed blocks. Zero means disabled.", 0) \
     M(Double, uncompressed_cache_size_ratio, DEFAULT_UNCOMPRESSED_CACHE_SIZE_RATIO, "The size of the protected queue in the uncompressed cache relative to the cache's total size.", 0) \
+    M(UInt64, compressed_block_cache_size, 0, "Size of the second tier of the uncompressed cache that keeps blocks compressed in memory and decompresses them on hit. Zero means disabled.", 0) \
     M(String, mark_cache_policy, DEFAULT_MARK_CACHE_POLICY, "Mark cache policy name.", 0) \
     M(UInt64, mark_cache_size, DEFAULT_MARK_CACHE_MAX_SIZE, "Size of cache for marks (index of MergeTree family of tables).", 0) \
     M(Double, mark_cache_size_ratio, DEFAULT_MARK_CACHE_SIZE_RATIO, "The size of the protected queue in the mark cache relative to the cache's total size.", 0) \
@@ -83,6 +86,15 @@ namespace DB
     M(String, index_mark_cache_policy, DEFAULT_INDEX_MARK_CACHE_POLICY, "Secondary index mark cache policy name.", 0) \
     M(UInt64, index_mark_cache_size, DEFAULT_INDEX_MARK_CACHE_MAX_SIZE, "Size of cache for secondary index marks. Zero means disabled.", 0) \
     M(Double, index_mark_cache_size_ratio, DEFAULT_INDEX_MARK_CACHE_SIZE_RATIO, "The size of the protected queue in the secondary index mark cache relative to the cache's total size.", 0) \
+    M(String, skipping_index_result_cache_policy, DEFAULT_SKIPPING_INDEX_RESULT_CACHE_POLICY, "Skipping index result cache policy name.", 0) \
+    M(UInt64, skipping_index_result_cache_size, DEFAULT_SKIPPING_INDEX_RESULT_CACHE_MAX_SIZE, "Size of cache for the results of evaluating skipping indexes over data parts. Zero means disabled.", 0) \
+    M(Double, skipping_index_result_cache_size_ratio, DEFAULT_SKIPPING_INDEX_RESULT_CACHE_SIZE_RATIO, "The size of the protected queue in the skipping index result cache relative to the cache's total size.", 0) \
+    M(String, filtered_granule_cache_policy, DEFAULT_FILTERED_GRANULE_CACHE_POLICY, "Filtered granule cache policy name.", 0) \
+    M(UInt64, filtered_granule_cache_size, DEFAULT_FILTERED_GRANULE_CACHE_MAX_SIZE, "Size of cache for decoded and filtered results of MergeTree read tasks. Zero means disabled.", 0) \
+    M(Double, filtered_granule_cache_size_ratio, DEFAULT_FILTERED_GRANULE_CACHE_SIZE_RATIO, "The size of the protected queue in the filtered granule cache relative to the cache's total size.", 0) \
+    M(String, approximate_nearest_neighbor_index_cache_policy, DEFAULT_ANN_INDEX_CACHE_POLICY, "Approximate nearest neighbor index cache policy name.", 0) \
+    M(UInt64, approximate_nearest_neighbor_index_cache_size, DEFAULT_ANN_INDEX_CACHE_MAX_SIZE, "Size of cache for deserialized granules of approximate nearest neighbor indexes. Zero means disabled.", 0) \
+    M(Double, approximate_nearest_neighbor_index_cache_size_ratio, DEFAULT_ANN_INDEX_CACHE_SIZE_RATIO, "The size of the protected queue in the approximate nearest neighbor index cache relative to the cache's total size.", 0) \
     M(UInt64, page_cache_chunk_size, 2 << 20, "Bytes per chunk in userspace page cache. Rounded up to a multiple of page size (typically 4 KiB) or huge page size (typically 2 MiB, only if page_cache_use_thp is enabled).", 0) \
     M(UInt64, page_cache_mmap_size, 1 << 30, "Bytes per memory mapping in userspace page cache. Not important.", 0) \
     M(UInt64, page_cache_size, 10ul << 30, "Amount of virtual memory to map for userspace page cache. If page_cache_use_madv_free is enabled, it's recommended to set this higher than the machine's RAM size. Use 0 to disable userspace page cache.", 0) \
@@ -94,6 +106,8 @@ namespace DB
     M(UInt64, dns_cache_max_entries, 10000, "Internal DNS cache max entries.", 0) \
     M(Int32,  dns_cache_update_period, 15, "Internal DNS cache update period in seconds.", 0) \
     M(UInt32, dns_max_consecutive_failures, 10, "Max DNS resolve failures of a hostname before dropping the hostname from ClickHouse DNS cache.", 0) \
+    M(UInt64, replica_health_probe_period_sec, 0, "Period of background TCP health probes of the replicas known to connection pools, in seconds. Replicas that failed their last probe are tried last when dispatching distributed queries. 0 means probing is disabled.", 0) \
+    M(UInt64, replica_health_probe_connect_timeout_ms, 1000, "Connect timeout of a single background replica health probe, in milliseconds.", 0) \
     \
     M(UInt64, max_table_size_to_drop, 50000000000lu, "If size of a table is greater than this value (in bytes) than table could not be dropped with any DROP query.", 0) \
     M(UInt64, max_partition_size_to_drop, 50000000000lu, "Same as max_table_size_to_drop, but for the partitions.", 0) \
@@ -107,6 +121,7 @@ namespace DB
     \
     M(UInt64, background_pool_size, 16, "The maximum number of threads what will be used for merging or mutating data parts for *MergeTree-engine tables in a background.", 0) \
     M(Float, background_merges_mutations_concurrency_ratio, 2, "The number of part mutation tasks that can be executed concurrently by each thread in background pool.", 0) \
+    M(UInt64, background_merges_mutations_concurrency_limit, 0, "Limits how many threads of the background pool actually execute merges and mutations. Unlike 'background_pool_size' it can be both increased and decreased at runtime. Zero means limited only by 'background_pool_size'.", 0) \
     M(String, background_merges_mutations_scheduling_policy, "round_robin", "The policy on how to perform a scheduling for background merges and mutations. Possible values are: `round_robin` and `shortest_task_first`. ", 0) \
     M(UInt64, background_move_pool_size, 8, "The maximum number of threads that will be used for moving data parts to another disk or volume for *MergeTree-engine tables in a background.", 0) \
     M(UInt64, background_fetches_pool_size, 16, "The maximum number of threads that will be used for fetching data parts from another replica for *MergeTree-engine tables in a background.", 0) \
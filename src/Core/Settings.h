@@ -36,6 +36,7 @@ class IColumn;
     M(UInt64, min_compress_block_size, 65536, "The actual size of the block to compress, if the uncompressed data less than max_compress_block_size is no less than this value and no less than the volume of data for one mark.", 0) \
     M(UInt64, max_compress_block_size, 1048576, "The maximum size of blocks of uncompressed data before compressing for writing to a table.", 0) \
     M(UInt64, max_block_size, DEFAULT_BLOCK_SIZE, "Maximum block size for reading", 0) \
+    M(Bool, adaptive_block_splitting, false, "Feed expensive expression and filter transforms with smaller pieces of input blocks, based on the measured per-row cost, so that the produced data stays cache-resident for the next pipeline stage. Experimental", 0) \
     M(UInt64, max_insert_block_size, DEFAULT_INSERT_BLOCK_SIZE, "The maximum block size for insertion, if we control the creation of blocks for insertion.", 0) \
     M(UInt64, min_insert_block_size_rows, DEFAULT_INSERT_BLOCK_SIZE, "Squash blocks passed to INSERT query to specified size in rows, if blocks are not big enough.", 0) \
     M(UInt64, min_insert_block_size_bytes, (DEFAULT_INSERT_BLOCK_SIZE * 256), "Squash blocks passed to INSERT query to specified size in bytes, if blocks are not big enough.", 0) \
@@ -50,6 +51,8 @@ class IColumn;
     M(UInt64, max_threads_for_indexes, 0, "The maximum number of threads process indices.", 0) \
     M(MaxThreads, max_threads, 0, "The maximum number of threads to execute the request. By default, it is determined automatically.", 0) \
     M(Bool, use_concurrency_control, true, "Respect the server's concurrency control (see the `concurrent_threads_soft_limit_num` and `concurrent_threads_soft_limit_ratio_to_cores` global server settings). If disabled, it allows using a larger number of threads even if the server is overloaded (not recommended for normal usage, and needed mostly for tests).", 0) \
+    M(Bool, concurrency_control_preemption, false, "Cooperatively release CPU slots between pipeline tasks when other queries are waiting for slots in concurrency control, instead of keeping them until the query finishes. Lowers the latency of queries that start under load at the cost of the throughput of already running ones.", 0) \
+    M(Bool, recycle_chunk_buffers, false, "Reuse the column buffers of exhausted chunks for new chunks of the same layout within each pipeline thread instead of freeing and reallocating them. The pooled buffers are bounded in size and are freed when the query finishes. Experimental", 0) \
     M(MaxThreads, max_download_threads, 4, "The maximum number of threads to download data (e.g. for URL engine).", 0) \
     M(MaxThreads, max_parsing_threads, 0, "The maximum number of threads to parse data in input formats that support parallel parsing. By default, it is determined automatically", 0) \
     M(UInt64, max_download_buffer_size, 10*1024*1024, "The maximal size of buffer for parallel downloading (e.g. for URL engine) per each thread.", 0) \
@@ -69,6 +72,7 @@ class IColumn;
     M(Milliseconds, hedged_connection_timeout_ms, 50, "Connection timeout for establishing connection with replica for Hedged requests", 0) \
     M(Milliseconds, receive_data_timeout_ms, 2000, "Connection timeout for receiving first packet of data or packet with positive progress from replica", 0) \
     M(Bool, use_hedged_requests, true, "Use hedged requests for distributed queries", 0) \
+    M(Bool, use_adaptive_hedged_requests, false, "Derive the timeout for trying a new replica in hedged requests from the moving average of the replica time to first data packet, instead of the fixed receive_data_timeout. The configured receive_data_timeout stays an upper bound.", 0) \
     M(Bool, allow_changing_replica_until_first_data_packet, false, "Allow HedgedConnections to change replica until receiving first data packet", 0) \
     M(Milliseconds, queue_max_wait_ms, 0, "The wait time in the request queue, if the number of concurrent requests exceeds the maximum.", 0) \
     M(Milliseconds, connection_pool_max_wait_ms, 0, "The wait time when the connection pool is full.", 0) \
@@ -155,6 +159,7 @@ class IColumn;
     M(Milliseconds, distributed_background_insert_max_sleep_time_ms, 30000, "Maximum sleep time for background INSERTs into Distributed, it limits exponential growth too.", 0) ALIAS(distributed_directory_monitor_max_sleep_time_ms) \
     \
     M(Bool, distributed_background_insert_batch, false, "Should background INSERTs into Distributed be batched into bigger blocks.", 0) ALIAS(distributed_directory_monitor_batch_inserts) \
+    M(UInt64, distributed_background_insert_batch_bytes, 0, "Coalesce consecutive blocks of one INSERT going to the same shard into a single file for background INSERT into Distributed, flushing the file when the buffered blocks exceed this many uncompressed bytes. Fewer files mean fewer compression streams, fsyncs and sends of tiny batches. 0 - write one file per block.", 0) \
     M(Bool, distributed_background_insert_split_batch_on_failure, false, "Should batches of the background INSERT into Distributed be split into smaller batches in case of failures.", 0) ALIAS(distributed_directory_monitor_split_batch_on_failure) \
     \
     M(Bool, optimize_move_to_prewhere, true, "Allows disabling WHERE to PREWHERE optimization in SELECT queries from MergeTree.", 0) \
@@ -184,6 +189,7 @@ class IColumn;
     M(Bool, allow_suspicious_primary_key, false, "Forbid suspicious PRIMARY KEY/ORDER BY for MergeTree (i.e. SimpleAggregateFunction)", 0) \
     M(Bool, compile_expressions, false, "Compile some scalar functions and operators to native code.", 0) \
     M(UInt64, min_count_to_compile_expression, 3, "The number of identical expressions before they are JIT-compiled", 0) \
+    M(Bool, compile_expressions_for_materialized_views, false, "Compile the expressions of materialized view queries starting from the first insert, ignoring min_count_to_compile_expression. The compiled modules are shared across inserts through the compiled expression cache.", 0) \
     M(Bool, compile_aggregate_expressions, true, "Compile aggregate functions to native code.", 0) \
     M(UInt64, min_count_to_compile_aggregate_expression, 3, "The number of identical aggregate expressions before they are JIT-compiled", 0) \
     M(Bool, compile_sort_description, true, "Compile sort description to native code.", 0) \
@@ -216,12 +222,15 @@ class IColumn;
     M(UInt64, parallel_replicas_min_number_of_rows_per_replica, 0, "Limit the number of replicas used in a query to (estimated rows to read / min_number_of_rows_per_replica). The max is still limited by 'max_parallel_replicas'", 0) \
     M(Bool, parallel_replicas_prefer_local_join, true, "If true, and JOIN can be executed with parallel replicas algorithm, and all storages of right JOIN part are *MergeTree, local JOIN will be used instead of GLOBAL JOIN.", 0) \
     M(UInt64, parallel_replicas_mark_segment_size, 128, "Parts virtually divided into segments to be distributed between replicas for parallel reading. This setting controls the size of these segments. Not recommended to change until you're absolutely sure in what you're doing", 0) \
+    M(Bool, parallel_replicas_adaptive_scheduling, false, "Scale the number of marks the coordinator hands out per request by the observed throughput of each replica relative to the fastest one. Slow replicas pull smaller batches, leaving more work in the queues for faster replicas to steal. Helps on heterogeneous replica hardware.", 0) \
     \
     M(Bool, skip_unavailable_shards, false, "If true, ClickHouse silently skips unavailable shards. Shard is marked as unavailable when: 1) The shard cannot be reached due to a connection failure. 2) Shard is unresolvable through DNS. 3) Table does not exist on the shard.", 0) \
     \
     M(UInt64, parallel_distributed_insert_select, 0, "Process distributed INSERT SELECT query in the same cluster on local tables on every shard; if set to 1 - SELECT is executed on each shard; if set to 2 - SELECT and INSERT are executed on each shard", 0) \
     M(UInt64, distributed_group_by_no_merge, 0, "If 1, Do not merge aggregation states from different servers for distributed queries (shards will process query up to the Complete stage, initiator just proxies the data from the shards). If 2 the initiator will apply ORDER BY and LIMIT stages (it is not in case when shard process query up to the Complete stage)", 0) \
     M(UInt64, distributed_push_down_limit, 1, "If 1, LIMIT will be applied on each shard separately. Usually you don't need to use it, since this will be done automatically if it is possible, i.e. for simple query SELECT FROM LIMIT.", 0) \
+    M(Bool, distributed_sort_threshold_exchange, false, "For distributed ORDER BY ... LIMIT queries, periodically push the k-th sort key observed on the initiator back to the shards, so that they can discard rows that cannot be a part of the result early.", 0) \
+    M(Bool, remote_exchange_lazy_decompression, false, "Send data blocks of distributed queries as per-column compressed chunks, so that the initiator can decompress columns lazily and blocks that are thrown away (e.g. after the final LIMIT is reached) are never decompressed.", 0) \
     M(Bool, optimize_distributed_group_by_sharding_key, true, "Optimize GROUP BY sharding_key queries (by avoiding costly aggregation on the initiator server).", 0) \
     M(UInt64, optimize_skip_unused_shards_limit, 1000, "Limit for number of sharding key values, turns off optimize_skip_unused_shards if the limit is reached", 0) \
     M(Bool, optimize_skip_unused_shards, false, "Assumes that data is distributed by sharding_key. Optimization to skip unused shards if SELECT query filters by sharding_key.", 0) \
@@ -265,6 +274,9 @@ class IColumn;
     M(Bool, force_primary_key, false, "Throw an exception if there is primary key in a table, and it is not used.", 0) \
     M(Bool, use_skip_indexes, true, "Use data skipping indexes during query execution.", 0) \
     M(Bool, use_skip_indexes_if_final, false, "If query has FINAL, then skipping data based on indexes may produce incorrect result, hence disabled by default.", 0) \
+    M(Bool, use_skipping_index_result_cache, true, "Use the cache of mark ranges left after evaluating skipping indexes over data parts, so that repeated queries don't re-read the index granules.", 0) \
+    M(Bool, use_filtered_granule_cache, false, "Experimental. Use the cache of decoded and filtered results of MergeTree read tasks, so that repeated queries with the same filtering conditions over the same immutable parts don't read and filter the granules again.", 0) \
+    M(Bool, use_approximate_nearest_neighbor_index_cache, true, "Use the cache of deserialized granules of approximate nearest neighbor indexes (Annoy, USearch), so that repeated vector search queries don't rebuild the search structure from disk.", 0) \
     M(Bool, materialize_skip_indexes_on_insert, true, "If true skip indexes are calculated on inserts, otherwise skip indexes will be calculated only during merges", 0) \
     M(Bool, materialize_statistics_on_insert, true, "If true statistics are calculated on inserts, otherwise statistics will be calculated only during merges", 0) \
     M(String, ignore_data_skipping_indices, "", "Comma separated list of strings or literals with the name of the data skipping indices that should be excluded during query execution.", 0) \
@@ -275,6 +287,7 @@ class IColumn;
     M(Float, max_streams_multiplier_for_merge_tables, 5, "Ask more streams when reading from Merge table. Streams will be spread across tables that Merge table will use. This allows more even distribution of work across threads and especially helpful when merged tables differ in size.", 0) \
     \
     M(String, network_compression_method, "LZ4", "Allows you to select the method of data compression when writing.", 0) \
+    M(Bool, network_compression_adaptive, false, "Adapt the compression of outgoing result streams to the observed network throughput: skip compression when the link is clearly not the bottleneck, compress with ZSTD instead of the configured method when the link is saturated. The method chosen by network_compression_method is used in between.", 0) \
     \
     M(Int64, network_zstd_compression_level, 1, "Allows you to select the level of ZSTD compression.", 0) \
     \
@@ -282,6 +295,7 @@ class IColumn;
     \
     M(UInt64, priority, 0, "Priority of the query. 1 - the highest, higher value - lower priority; 0 - do not use priorities.", 0) \
     M(Int64, os_thread_priority, 0, "If non zero - set corresponding 'nice' value for query processing threads. Can be used to adjust query priority for OS scheduler.", 0) \
+    M(Int64, os_thread_numa_node, -1, "If non-negative - bind query processing threads to the CPUs of the given NUMA node, so that the memory they allocate and access stays local to it. Can be used to keep large memory-bound queries on one socket; spread different workloads over the nodes with settings profiles.", 0) \
     \
     M(Bool, log_queries, true, "Log requests and write the log to the system table.", 0) \
     M(Bool, log_formatted_queries, false, "Log formatted queries and write the log to the system table.", 0) \
@@ -360,6 +374,7 @@ class IColumn;
     M(Bool, final, false, "Query with the FINAL modifier by default. If the engine does not support final, it does not have any effect. On queries with multiple tables final is applied only on those that support it. It also works on distributed tables", 0) \
     \
     M(Bool, partial_result_on_first_cancel, false, "Allows query to return a partial result after cancel.", 0) \
+    M(UInt64, max_block_bytes_for_tcp_data_packet, 0, "If non-zero, result blocks larger than this are split by rows into several Data packets before sending over the native protocol, bounding per-connection memory on both ends. Zero means blocks are sent as is.", 0) \
     \
     M(Bool, ignore_on_cluster_for_replicated_udf_queries, false, "Ignore ON CLUSTER clause for replicated UDF management queries.", 0) \
     M(Bool, ignore_on_cluster_for_replicated_access_entities_queries, false, "Ignore ON CLUSTER clause for replicated access entities management queries.", 0) \
@@ -401,6 +416,7 @@ class IColumn;
     M(Bool, allow_experimental_analyzer, true, "Allow experimental analyzer.", 0) \
     M(Bool, analyzer_compatibility_join_using_top_level_identifier, false, "Force to resolve identifier in JOIN USING from projection (for example, in `SELECT a + 1 AS b FROM t1 JOIN t2 USING (b)` join will be performed by `t1.a + 1 = t2.b`, rather then `t1.b = t2.b`).", 0) \
     M(Bool, prefer_global_in_and_join, false, "If enabled, all IN/JOIN operators will be rewritten as GLOBAL IN/JOIN. It's useful when the to-be-joined tables are only available on the initiator and we need to always scatter their data on-the-fly during distributed processing with the GLOBAL keyword. It's also useful to reduce the need to access the external sources joining external tables.", 0) \
+    M(Bool, external_tables_dedup, false, "Announce content hashes of external tables (e.g. the right-hand side of a GLOBAL JOIN) before sending them to remote servers, so that servers that still hold identical data in their content-addressed cache skip the transfer. The cache size on the receiving side is controlled by the external_tables_dedup_cache_size server setting.", 0) \
     M(Bool, enable_vertical_final, true, "If enable, remove duplicated rows during FINAL by marking rows as deleted and filtering them later instead of merging rows", 0) \
     \
     \
@@ -545,12 +561,14 @@ class IColumn;
     M(Bool, enable_job_stack_trace, false, "Output stack trace of a job creator when job results in exception", 0) \
     M(Bool, allow_ddl, true, "If it is set to true, then a user is allowed to executed DDL queries.", 0) \
     M(Bool, parallel_view_processing, false, "Enables pushing to attached views concurrently instead of sequentially.", 0) \
+    M(UInt64, materialized_views_buffer_max_bytes, 0, "Buffer up to the specified amount of inserted data (in bytes) in front of each materialized view pipeline. Lets a slow view lag behind the insert and the other views until its buffer is full, instead of stalling them in lockstep. Zero disables buffering. Makes the most sense together with parallel_view_processing.", 0) \
     M(Bool, enable_unaligned_array_join, false, "Allow ARRAY JOIN with multiple arrays that have different sizes. When this settings is enabled, arrays will be resized to the longest one.", 0) \
     M(Bool, optimize_read_in_order, true, "Enable ORDER BY optimization for reading data in corresponding order in MergeTree tables.", 0) \
     M(Bool, optimize_read_in_window_order, true, "Enable ORDER BY optimization in window clause for reading data in corresponding order in MergeTree tables.", 0) \
     M(Bool, optimize_aggregation_in_order, false, "Enable GROUP BY optimization for aggregating data in corresponding order in MergeTree tables.", 0) \
     M(UInt64, aggregation_in_order_max_block_bytes, 50000000, "Maximal size of block in bytes accumulated during aggregation in order of primary key. Lower block size allows to parallelize more final merge stage of aggregation.", 0) \
     M(UInt64, read_in_order_two_level_merge_threshold, 100, "Minimal number of parts to read to run preliminary merge step during multithread reading in order of primary key.", 0) \
+    M(Bool, read_in_order_limit_pruning, false, "For ORDER BY primary key prefix LIMIT n queries reading in order, use the primary index to skip mark ranges that cannot contain any of the first n rows. Experimental", 0) \
     M(Bool, low_cardinality_allow_in_native_format, true, "Use LowCardinality type in Native format. Otherwise, convert LowCardinality columns to ordinary for select query, and convert ordinary columns to required LowCardinality for insert query.", 0) \
     M(Bool, cancel_http_readonly_queries_on_client_close, false, "Cancel HTTP readonly queries when a client closes the connection without waiting for response.", 0) \
     M(Bool, external_table_functions_use_nulls, true, "If it is set to true, external table functions will implicitly use Nullable type if needed. Otherwise NULLs will be substituted with default values. Currently supported only by 'mysql', 'postgresql' and 'odbc' table functions.", 0) \
@@ -612,11 +630,15 @@ class IColumn;
     M(Bool, enable_lightweight_delete, true, "Enable lightweight DELETE mutations for mergetree tables.", 0) ALIAS(allow_experimental_lightweight_delete) \
     M(UInt64, lightweight_deletes_sync, 2, "The same as 'mutation_sync', but controls only execution of lightweight deletes", 0) \
     M(Bool, apply_deleted_mask, true, "Enables filtering out rows deleted with lightweight DELETE. If disabled, a query will be able to read those rows. This is useful for debugging and \"undelete\" scenarios", 0) \
+    M(Bool, use_deleted_mask_summary, true, "Build a per-granule summary of the lightweight delete mask on the first read of a part and use it to skip granules where all rows are deleted and to avoid reading the mask in parts without deleted rows.", 0) \
     M(Bool, optimize_normalize_count_variants, true, "Rewrite aggregate functions that semantically equals to count() as count().", 0) \
     M(Bool, optimize_injective_functions_inside_uniq, true, "Delete injective functions of one argument inside uniq*() functions.", 0) \
     M(Bool, rewrite_count_distinct_if_with_count_distinct_implementation, false, "Rewrite countDistinctIf with count_distinct_implementation configuration", 0) \
     M(Bool, convert_query_to_cnf, false, "Convert SELECT query to CNF", 0) \
     M(Bool, optimize_or_like_chain, false, "Optimize multiple OR LIKE into multiMatchAny. This optimization should not be enabled by default, because it defies index analysis in some cases.", 0) \
+    M(Bool, optimize_fuse_match_functions, false, "Fuse multiple 'match' and LIKE predicates over the same column into a single multiMatchAllIndices call, so that all the regular expressions are compiled into one shared vectorscan database and evaluated in one pass over the data. This optimization should not be enabled by default, because vectorscan may treat corner-case regular expressions differently than re2 and the rewrite defies index analysis in some cases.", 0) \
+    M(Bool, optimize_fuse_hash_functions, false, "Fuse multiple 64-bit hash functions (cityHash64, sipHash64, xxHash64, ...) applied to the same String or FixedString argument into a single fusedHashes call that computes all of them in one pass over the data. The results are bit-identical to the standalone functions.", 0) \
+    M(Bool, optimize_fuse_json_extract_functions, false, "Fuse multiple single-key JSON extraction functions (JSONExtractString, JSONExtractInt, ...) applied to the same document into a single fusedJSONExtract call that parses every document once. The results are bit-identical to the standalone functions.", 0) \
     M(Bool, optimize_arithmetic_operations_in_aggregate_functions, true, "Move arithmetic operations out of aggregation functions", 0) \
     M(Bool, optimize_redundant_functions_in_order_by, true, "Remove functions from ORDER BY if its argument is also in ORDER BY", 0) \
     M(Bool, optimize_if_chain_to_multiif, false, "Replace if(cond1, then1, if(cond2, ...)) chains to multiIf. Currently it's not beneficial for numeric types.", 0) \
@@ -657,6 +679,7 @@ class IColumn;
     M(Bool, system_events_show_zero_values, false, "When querying system.events or system.metrics tables, include all metrics, even with zero values.", 0) \
     M(MySQLDataTypesSupport, mysql_datatypes_support_level, MySQLDataTypesSupportList{}, "Defines how MySQL types are converted to corresponding ClickHouse types. A comma separated list in any combination of 'decimal', 'datetime64', 'date2Date32' or 'date2String'. decimal: convert NUMERIC and DECIMAL types to Decimal when precision allows it. datetime64: convert DATETIME and TIMESTAMP types to DateTime64 instead of DateTime when precision is not 0. date2Date32: convert DATE to Date32 instead of Date. Takes precedence over date2String. date2String: convert DATE to String instead of Date. Overridden by datetime64.", 0) \
     M(Bool, optimize_trivial_insert_select, true, "Optimize trivial 'INSERT INTO table SELECT ... FROM TABLES' query", 0) \
+    M(Bool, insert_select_clone_parts, false, "For 'INSERT INTO table SELECT * FROM table' between MergeTree tables with identical structure and keys, attach cloned (hard-linked when on the same disk) parts to the destination table instead of reading and rewriting all data, like ALTER TABLE ... ATTACH PARTITION FROM does", 0) \
     M(Bool, allow_non_metadata_alters, true, "Allow to execute alters which affects not only tables metadata, but also data on disk", 0) \
     M(Bool, enable_global_with_statement, true, "Propagate WITH statements to UNION queries and all subqueries", 0) \
     M(Bool, aggregate_functions_null_for_empty, false, "Rewrite all aggregate functions in a query, adding -OrNull suffix to them", 0) \
@@ -697,8 +720,13 @@ class IColumn;
     M(Bool, query_cache_compress_entries, true, "Compress cache entries.", 0) \
     M(Bool, query_cache_squash_partial_results, true, "Squash partial result blocks to blocks of size 'max_block_size'. Reduces performance of inserts into the query cache but improves the compressability of cache entries.", 0) \
     M(Seconds, query_cache_ttl, 60, "After this time in seconds entries in the query cache become stale", 0) \
+    M(Bool, query_cache_partition_invalidation, false, "Experimental. Record the partitions of MergeTree tables read by a cached query and treat the entry as stale as soon as one of these partitions gains, loses or mutates data. Allows a much longer 'query_cache_ttl' for queries over append-only tables. Best-effort for non-MergeTree tables", 0) \
     M(Bool, query_cache_share_between_users, false, "Allow other users to read entry in the query cache", 0) \
     M(Bool, enable_sharing_sets_for_mutations, true, "Allow sharing set objects build for IN subqueries between different tasks of the same mutation. This reduces memory usage and CPU consumption", 0) \
+    M(Bool, use_subquery_set_cache, false, "Experimental. Reuse sets built from IN subqueries over MergeTree tables across queries via a server-wide cache. A cached set is reused while the partitions of its source tables are unchanged and is rebuilt transparently otherwise. Assumes the subqueries are deterministic", 0) \
+    M(Bool, use_query_tree_cache, false, "Experimental. Reuse analyzed query trees for repeated queries via a server-wide cache, skipping the analysis passes. Entries are invalidated when a referenced table is altered or dropped. Only with the analyzer enabled", 0) \
+    M(Bool, use_scalar_subquery_cache, false, "Experimental. Reuse results of scalar subqueries across queries via a server-wide cache. A cached result is reused while the partitions of the MergeTree tables the subquery reads are unchanged, and at most for 'scalar_subquery_cache_ttl' seconds. Non-deterministic subqueries may return stale results until the TTL expires", 0) \
+    M(Seconds, scalar_subquery_cache_ttl, 60, "After this time in seconds entries in the scalar subquery cache become stale", 0) \
     \
     M(Bool, optimize_rewrite_sum_if_to_count_if, true, "Rewrite sumIf() and sum(if()) function countIf() function when logically equivalent", 0) \
     M(Bool, optimize_rewrite_aggregate_function_with_if, true, "Rewrite aggregate functions with if expression as argument when logically equivalent. For example, avg(if(cond, col, null)) can be rewritten to avgIf(cond, col)", 0) \
@@ -711,6 +739,7 @@ class IColumn;
     \
     M(Bool, kafka_disable_num_consumers_limit, false, "Disable limit on kafka_num_consumers that depends on the number of available CPU cores", 0) \
     M(Bool, enable_software_prefetch_in_aggregation, true, "Enable use of software prefetch in aggregation", 0) \
+    M(Bool, enable_adaptive_aggregation_passthrough, false, "Allow the first stage of two-stage GROUP BY (e.g. on the shards of a Distributed table) to stop building its hash table mid-query when the observed reduction is poor (the number of groups is close to the number of input rows) and stream per-block aggregated data instead. Avoids the manual two-level subquery rewrite for high-cardinality keys", 0) \
     M(Bool, allow_aggregate_partitions_independently, false, "Enable independent aggregation of partitions on separate threads when partition key suits group by key. Beneficial when number of partitions close to number of cores and partitions have roughly the same size", 0) \
     M(Bool, force_aggregate_partitions_independently, false, "Force the use of optimization when it is applicable, but heuristics decided not to use it", 0) \
     M(UInt64, max_number_of_partitions_for_independent_aggregation, 128, "Maximal number of partitions in table to apply optimization", 0) \
@@ -756,17 +785,22 @@ class IColumn;
     M(Bool, query_plan_push_down_limit, true, "Allow to move LIMITs down in the query plan", 0) \
     M(Bool, query_plan_split_filter, true, "Allow to split filters in the query plan", 0) \
     M(Bool, query_plan_merge_expressions, true, "Allow to merge expressions in the query plan", 0) \
+    M(Bool, query_plan_merge_filters, false, "Allow to merge adjacent filters in the query plan into one, combining the conditions with AND. Avoids materializing the block between the two filter transforms. Experimental", 0) \
     M(Bool, query_plan_filter_push_down, true, "Allow to push down filter by predicate query plan step", 0) \
     M(Bool, query_plan_convert_outer_join_to_inner_join, true, "Allow to convert OUTER JOIN to INNER JOIN if filter after JOIN always filters default values", 0) \
+    M(Bool, query_plan_join_runtime_filter, false, "Prune probe-side MergeTree mark ranges using min/max of the hash join build-side keys. Applied only to INNER and RIGHT equi-joins by primary key columns. Experimental", 0) \
     M(Bool, query_plan_optimize_prewhere, true, "Allow to push down filter to PREWHERE expression for supported storages", 0) \
     M(Bool, query_plan_execute_functions_after_sorting, true, "Allow to re-order functions after sorting", 0) \
     M(Bool, query_plan_reuse_storage_ordering_for_window_functions, true, "Allow to use the storage sorting for window functions", 0) \
     M(Bool, query_plan_lift_up_union, true, "Allow to move UNIONs up so that more parts of the query plan can be optimized", 0) \
+    M(Bool, query_plan_merge_identical_union_branches, false, "Execute identical UNION ALL branches only once and duplicate the result. Branches are compared by their textual plan representation, so only subtrees of well-known steps are merged. Experimental", 0) \
     M(Bool, query_plan_read_in_order, true, "Use query plan for read-in-order optimization", 0) \
     M(Bool, query_plan_aggregation_in_order, true, "Use query plan for aggregation-in-order optimization", 0) \
     M(Bool, query_plan_remove_redundant_sorting, true, "Remove redundant sorting in query plan. For example, sorting steps related to ORDER BY clauses in subqueries", 0) \
     M(Bool, query_plan_remove_redundant_distinct, true, "Remove redundant Distinct step in query plan", 0) \
     M(Bool, query_plan_enable_multithreading_after_window_functions, true, "Enable multithreading after evaluating window functions to allow parallel stream processing", 0) \
+    M(Bool, window_functions_sliding_aggregation, false, "Evaluate aggregate functions over moving window frames with two stacks of partial aggregation states, so that functions that cannot subtract rows (like max) take amortized constant time per row instead of re-aggregating the whole frame. Experimental", 0) \
+    M(UInt64, max_bytes_to_buffer_while_creating_sets, 0, "If non-zero, start the main query pipeline while sets for IN and GLOBAL JOIN are still being built, buffering up to the specified number of bytes of its output per stream. Set application still waits for the sets to be fully built. 0 disables the overlap. Experimental", 0) \
     M(UInt64, regexp_max_matches_per_row, 1000, "Max matches of any single regexp per row, used to safeguard 'extractAllGroupsHorizontal' against consuming too much memory with greedy RE.", 0) \
     \
     M(UInt64, limit, 0, "Limit on read rows from the most 'end' result for select query, default 0 means no limit length", 0) \
@@ -786,6 +820,8 @@ class IColumn;
     M(UInt64, merge_tree_min_rows_for_concurrent_read_for_remote_filesystem, (20 * 8192), "If at least as many lines are read from one file, the reading can be parallelized, when reading from remote filesystem.", 0) \
     M(UInt64, merge_tree_min_bytes_for_concurrent_read_for_remote_filesystem, (24 * 10 * 1024 * 1024), "If at least as many bytes are read from one file, the reading can be parallelized, when reading from remote filesystem.", 0) \
     M(UInt64, remote_read_min_bytes_for_seek, 4 * DBMS_DEFAULT_BUFFER_SIZE, "Min bytes required for remote read (url, s3) to do seek, instead of read with ignore.", 0) \
+    M(Bool, remote_read_adaptive_min_bytes_for_seek, true, "Adaptively raise 'remote_read_min_bytes_for_seek' based on the observed latency and bandwidth of remote requests: a forward seek shorter than latency * bandwidth is served by reading through the gap instead of issuing a new ranged request. Lowers the number of requests for sparse reads from object storage.", 0) \
+    M(Bool, remote_read_adaptive_prefetch, true, "Adapt the prefetch window of each remote read stream to its observed access pattern: sequentially consumed prefetches double the window up to 32 MiB, and streams whose prefetches keep being cancelled by seeks pause prefetching until reads become sequential again.", 0) \
     M(UInt64, merge_tree_min_bytes_per_task_for_remote_reading, 4 * DBMS_DEFAULT_BUFFER_SIZE, "Min bytes to read per task.", 0) \
     M(Bool, merge_tree_use_const_size_tasks_for_remote_reading, true, "Whether to use constant size tasks for reading from a remote table.", 0) \
     M(Bool, merge_tree_determine_task_size_by_prewhere_columns, true, "Whether to use only prewhere columns size to determine reading task size.", 0) \
@@ -802,6 +838,8 @@ class IColumn;
     M(Milliseconds, async_insert_busy_timeout_max_ms, 200, "Maximum time to wait before dumping collected data per query since the first data appeared.", 0) ALIAS(async_insert_busy_timeout_ms) \
     M(Double, async_insert_busy_timeout_increase_rate, 0.2, "The exponential growth rate at which the adaptive asynchronous insert timeout increases", 0) \
     M(Double, async_insert_busy_timeout_decrease_rate, 0.2, "The exponential growth rate at which the adaptive asynchronous insert timeout decreases", 0) \
+    M(Bool, async_insert_busy_timeout_use_merge_backlog, false, "Stretch the asynchronous insert flush timeout towards async_insert_busy_timeout_max_ms proportionally to the number of active parts in the most loaded partition of the destination table (relative to parts_to_delay_insert), so that fewer parts are created when merges fall behind. Experimental", 0) \
+    M(Bool, async_insert_merge_formats, false, "Collect asynchronous inserts into the same table that differ only in data format into one buffer and flush them as a single insert. Experimental", 0) \
     \
     M(UInt64, remote_fs_read_max_backoff_ms, 10000, "Max wait time when trying to read data for remote disk", 0) \
     M(UInt64, remote_fs_read_backoff_max_tries, 5, "Max attempts to read with backoff", 0) \
@@ -813,6 +851,7 @@ class IColumn;
     M(UInt64, filesystem_cache_max_download_size, (128UL * 1024 * 1024 * 1024), "Max remote filesystem cache size that can be downloaded by a single query", 0) \
     M(Bool, throw_on_error_from_cache_on_write_operations, false, "Ignore error from cache when caching on write operations (INSERT, merges)", 0) \
     M(UInt64, filesystem_cache_segments_batch_size, 20, "Limit on size of a single batch of file segments that a read buffer can request from cache. Too low value will lead to excessive requests to cache, too large may slow down eviction from cache", 0) \
+    M(UInt64, filesystem_cache_scan_resistant_read_min_bytes, 0, "If a MergeTree read is estimated to read at least this number of bytes, treat it as a scan: cache segments it touches keep their eviction priority, so one large batch query cannot push the hot working set of point queries out of the filesystem cache. 0 disables the classification", 0) \
     M(UInt64, filesystem_cache_reserve_space_wait_lock_timeout_milliseconds, 1000, "Wait time to lock cache for space reservation in filesystem cache", 0) \
     M(UInt64, temporary_data_in_cache_reserve_space_wait_lock_timeout_milliseconds, (10 * 60 * 1000), "Wait time to lock cache for space reservation for temporary data in filesystem cache", 0) \
     \
@@ -1039,6 +1078,7 @@ class IColumn;
     M(Bool, input_format_orc_allow_missing_columns, true, "Allow missing columns while reading ORC input formats", 0) \
     M(Bool, input_format_orc_use_fast_decoder, true, "Use a faster ORC decoder implementation.", 0) \
     M(Bool, input_format_orc_filter_push_down, true, "When reading ORC files, skip whole stripes or row groups based on the WHERE/PREWHERE expressions, min/max statistics or bloom filter in the ORC metadata.", 0) \
+    M(Bool, input_format_orc_decode_stripe_ahead, true, "When reading ORC files with the arrow decoder, decode the next stripe in a background thread while the current one is being consumed.", 0) \
     M(Bool, input_format_parquet_allow_missing_columns, true, "Allow missing columns while reading Parquet input formats", 0) \
     M(UInt64, input_format_parquet_local_file_min_bytes_for_seek, 8192, "Min bytes required for local read (file) to do seek, instead of read with ignore in Parquet input format", 0) \
     M(Bool, input_format_arrow_allow_missing_columns, true, "Allow missing columns while reading Arrow input formats", 0) \
@@ -1120,6 +1160,7 @@ class IColumn;
     M(Bool, input_format_values_accurate_types_of_literals, true, "For Values format: when parsing and interpreting expressions using template, check actual type of literal to avoid possible overflow and precision issues.", 0) \
     M(Bool, input_format_values_allow_data_after_semicolon, false, "For Values format: allow extra data after semicolon (used by client to interpret comments).", 0) \
     M(Bool, input_format_avro_allow_missing_fields, false, "For Avro/AvroConfluent format: when field is not found in schema use default value instead of error", 0) \
+    M(Bool, input_format_avro_parallel_block_decoding, true, "For Avro format: decode the blocks of object container files in parallel, using up to max_threads threads", 0) \
     /** This setting is obsolete and do nothing, left for compatibility reasons. */ \
     M(Bool, input_format_avro_null_as_default, false, "For Avro/AvroConfluent format: insert default in case of null and non Nullable column", 0) \
     M(UInt64, format_binary_max_string_size, 1_GiB, "The maximum allowed size for String in RowBinary format. It prevents allocating large amount of memory in case of corrupted data. 0 means there is no limit", 0) \
@@ -85,7 +85,47 @@ namespace SettingsChangesHistory
 /// It's used to implement `compatibility` setting (see https://github.com/ClickHouse/ClickHouse/issues/35972)
 static const std::map<ClickHouseVersion, SettingsChangesHistory::SettingsChanges> settings_changes_history =
 {
-    {"24.6", {{"materialize_skip_indexes_on_insert", true, true, "Added new setting to allow to disable materialization of skip indexes on insert"},
+    {"24.6", {{"materialized_views_buffer_max_bytes", 0, 0, "Added new setting to buffer inserted data in front of each materialized view pipeline"},
+              {"remote_read_adaptive_min_bytes_for_seek", false, true, "Added new setting to adaptively coalesce close ranged requests to object storage"},
+              {"remote_read_adaptive_prefetch", false, true, "Added new setting to adapt the remote prefetch window to the access pattern of each stream"},
+              {"max_block_bytes_for_tcp_data_packet", 0, 0, "Added new setting to split oversized result blocks into several Data packets"},
+              {"input_format_orc_decode_stripe_ahead", true, true, "Added new setting to overlap ORC stripe decoding with consumption in the arrow decoder"},
+              {"input_format_avro_parallel_block_decoding", true, true, "Added new setting to decode blocks of Avro object container files in parallel"},
+              {"query_plan_merge_identical_union_branches", false, false, "Added new experimental setting to execute identical UNION ALL branches only once"},
+              {"recycle_chunk_buffers", false, false, "Added new experimental setting to reuse column buffers of exhausted chunks within pipeline threads"},
+              {"query_plan_join_runtime_filter", false, false, "Added new experimental setting to prune probe-side mark ranges with hash join build-side extremes"},
+              {"adaptive_block_splitting", false, false, "Added new experimental setting to split blocks fed into expensive transforms based on measured per-row cost"},
+              {"read_in_order_limit_pruning", false, false, "Added new experimental setting to prune mark ranges with the primary index for ORDER BY LIMIT queries reading in order"},
+              {"window_functions_sliding_aggregation", false, false, "Added new experimental setting to evaluate window aggregates over moving frames with two stacks of partial states"},
+              {"max_bytes_to_buffer_while_creating_sets", 0, 0, "Added new experimental setting to overlap building of sets for IN and GLOBAL JOIN with the main query pipeline"},
+              {"query_plan_merge_filters", false, false, "Added new experimental setting to merge adjacent filter steps in the query plan"},
+              {"async_insert_busy_timeout_use_merge_backlog", false, false, "Added new experimental setting to stretch asynchronous insert timeouts when the destination table accumulates too many parts"},
+              {"async_insert_merge_formats", false, false, "Added new experimental setting to batch asynchronous inserts that differ only in data format into one flush"},
+              {"query_cache_partition_invalidation", false, false, "Added new experimental setting to invalidate query cache entries when a read partition changes"},
+              {"use_subquery_set_cache", false, false, "Added new experimental setting to reuse sets built from IN subqueries across queries while the source tables are unchanged"},
+              {"use_query_tree_cache", false, false, "Added new experimental setting to reuse analyzed query trees for repeated queries"},
+              {"use_scalar_subquery_cache", false, false, "Added new experimental setting to reuse results of scalar subqueries across queries while the source tables are unchanged"},
+              {"scalar_subquery_cache_ttl", 60, 60, "Added new setting bounding the lifetime of scalar subquery cache entries"},
+              {"enable_adaptive_aggregation_passthrough", false, false, "Added new setting to let the first aggregation stage switch to streaming per-block aggregated data when the key cardinality is close to the number of input rows"},
+              {"use_filtered_granule_cache", false, false, "Added new experimental setting to cache decoded and filtered results of MergeTree read tasks"},
+              {"use_deleted_mask_summary", false, true, "Added new setting to skip fully deleted granules and the read of the lightweight delete mask in parts without deleted rows"},
+              {"compile_expressions_for_materialized_views", false, false, "Added new setting to compile materialized view expressions starting from the first insert"},
+              {"os_thread_numa_node", -1, -1, "Added new setting to bind query processing threads to one NUMA node"},
+              {"concurrency_control_preemption", false, false, "Added new setting to release CPU slots to waiting queries between pipeline tasks"},
+              {"optimize_fuse_match_functions", false, false, "Added new setting to evaluate multiple regexp predicates over one column with a single vectorscan scan"},
+              {"optimize_fuse_hash_functions", false, false, "Added new setting to compute multiple hash functions of one column in a single pass over the data"},
+              {"optimize_fuse_json_extract_functions", false, false, "Added new setting to extract multiple fields from one JSON column while parsing every document once"},
+              {"use_adaptive_hedged_requests", false, false, "Added new setting to derive hedged request timeouts from per-replica latency statistics"},
+              {"distributed_background_insert_batch_bytes", 0, 0, "Added new setting to coalesce consecutive blocks of one INSERT into a Distributed table into a single per-shard file"},
+              {"parallel_replicas_adaptive_scheduling", false, false, "Added new setting to scale parallel replicas work assignments by observed replica throughput"},
+              {"network_compression_adaptive", false, false, "Added new setting to adapt the compression of outgoing result streams to the observed network throughput"},
+              {"external_tables_dedup", false, false, "Added new setting to skip repeated transfers of identical external tables to remote servers"},
+              {"distributed_sort_threshold_exchange", false, false, "Added new setting to push sort key thresholds back to shards in distributed ORDER BY ... LIMIT queries"},
+              {"remote_exchange_lazy_decompression", false, false, "Added new setting to send data blocks of distributed queries as per-column compressed chunks that are decompressed lazily"},
+              {"use_skipping_index_result_cache", false, true, "Added new setting to allow to disable the cache of skipping index evaluation results"},
+              {"use_approximate_nearest_neighbor_index_cache", false, true, "Added new setting to allow to disable the cache of deserialized approximate nearest neighbor index granules"},
+              {"insert_select_clone_parts", false, false, "Added new setting to execute INSERT SELECT between compatible MergeTree tables by attaching cloned parts"},
+              {"materialize_skip_indexes_on_insert", true, true, "Added new setting to allow to disable materialization of skip indexes on insert"},
               {"materialize_statistics_on_insert", true, true, "Added new setting to allow to disable materialization of statistics on insert"},
               {"input_format_parquet_use_native_reader", false, false, "When reading Parquet files, to use native reader instead of arrow reader."},
               {"hdfs_throw_on_zero_files_match", false, false, "Allow to throw an error when ListObjects request cannot match any files in HDFS engine instead of empty query result"},
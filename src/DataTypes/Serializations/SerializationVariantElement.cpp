@@ -254,17 +254,50 @@ ColumnPtr SerializationVariantElement::VariantSubcolumnCreator::create(const DB:
     for (auto local_discr : local_discriminators_data)
         null_map.push_back(local_discr != local_variant_discriminator);
 
-    /// Now we can create new column from null-map and variant column using IColumn::expand.
-    auto res_column = IColumn::mutate(prev);
+    MutableColumnPtr res_column;
 
-    /// Special case for LowCardinality. We want the result to be LowCardinality(Nullable),
-    /// but we don't have a good way to apply null-mask for LowCardinality(), so, we first
-    /// convert our column to LowCardinality(Nullable()) and then use expand which will
-    /// fill rows with 0 in mask with default value (that is NULL).
     if (prev->lowCardinality())
+    {
+        /// Special case for LowCardinality. We want the result to be LowCardinality(Nullable),
+        /// but we don't have a good way to apply null-mask for LowCardinality(), so, we first
+        /// convert our column to LowCardinality(Nullable()) and then use expand which will
+        /// fill rows with 0 in mask with default value (that is NULL).
+        res_column = IColumn::mutate(prev);
         res_column = assert_cast<ColumnLowCardinality &>(*res_column).cloneNullable();
-
-    res_column->expand(null_map, /*inverted = */ true);
+        res_column->expand(null_map, /*inverted = */ true);
+    }
+    else
+    {
+        /// Values of one variant are stored densely in row order, so every run of equal
+        /// discriminators corresponds to a contiguous range of our variant. Gather the
+        /// result by copying those ranges in bulk and filling the rest with defaults.
+        /// This is much cheaper than copying the whole variant and expanding it row by
+        /// row, especially when one variant dominates the column.
+        res_column = prev->cloneEmpty();
+        res_column->reserve(local_discriminators_data.size());
+
+        /// Index in prev of the first row of the current run.
+        size_t prev_offset = 0;
+        size_t rows = local_discriminators_data.size();
+        size_t row = 0;
+        while (row < rows)
+        {
+            size_t run_begin = row;
+            if (local_discriminators_data[row] == local_variant_discriminator)
+            {
+                while (row < rows && local_discriminators_data[row] == local_variant_discriminator)
+                    ++row;
+                res_column->insertRangeFrom(*prev, prev_offset, row - run_begin);
+                prev_offset += row - run_begin;
+            }
+            else
+            {
+                while (row < rows && local_discriminators_data[row] != local_variant_discriminator)
+                    ++row;
+                res_column->insertManyDefaults(row - run_begin);
+            }
+        }
+    }
 
     if (res_column->canBeInsideNullable())
     {
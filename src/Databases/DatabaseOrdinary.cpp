@@ -434,6 +434,14 @@ void DatabaseOrdinary::waitTableStarted(const String & name) const
         waitLoad(currentPoolOr(TablesLoaderForegroundPoolId), task);
 }
 
+LoadTaskPtr DatabaseOrdinary::tryGetTableStartupTask(const String & name) const
+{
+    std::scoped_lock lock(mutex);
+    if (auto it = startup_table.find(name); it != startup_table.end())
+        return it->second;
+    return nullptr;
+}
+
 void DatabaseOrdinary::waitDatabaseStarted() const
 {
     /// Prioritize load and startup of all tables and database itself and wait for them synchronously
@@ -51,6 +51,8 @@ public:
 
     void waitTableStarted(const String & name) const override;
 
+    LoadTaskPtr tryGetTableStartupTask(const String & name) const override;
+
     void waitDatabaseStarted() const override;
     void stopLoading() override;
 
@@ -203,6 +203,10 @@ public:
     /// Waits for specific table to be started up, i.e. task returned by `startupTableAsync()` is done
     virtual void waitTableStarted(const String & /*name*/) const {}
 
+    /// Returns the task for async load and startup of the table, if there is one.
+    /// Can be used to boost the priority of a table without waiting for it.
+    virtual LoadTaskPtr tryGetTableStartupTask(const String & /*name*/) const { return nullptr; }
+
     /// Waits for the database to be started up, i.e. task returned by `startupDatabaseAsync()` is done
     virtual void waitDatabaseStarted() const {}
 
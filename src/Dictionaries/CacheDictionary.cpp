@@ -7,6 +7,7 @@
 #include <Common/HashTable/HashSet.h>
 #include <Common/ProfileEvents.h>
 #include <Common/ProfilingScopedRWLock.h>
+#include <Common/logger_useful.h>
 
 #include <Dictionaries/DictionarySource.h>
 #include <Dictionaries/DictionaryPipelineExecutor.h>
@@ -232,8 +233,13 @@ Columns CacheDictionary<dictionary_key_type>::getColumns(
 
     if (not_found_keys_size == 0 && expired_keys_size > 0 && configuration.allow_read_expired_keys)
     {
-        /// Start async update only if allow read expired keys and all keys are found
-        update_queue.tryPushToUpdateQueueOrThrow(update_unit);
+        /// Start async update only if allow read expired keys and all keys are found.
+        /// If the update queue is saturated the refresh is skipped, expired keys are
+        /// servable anyway and the next query will try to schedule refresh again.
+        if (!update_queue.tryPushToUpdateQueue(update_unit))
+            LOG_DEBUG(log,
+                "Cannot schedule background refresh of expired keys in cache dictionary {}, serving stale values",
+                getDictionaryID().getNameForLogs());
 
         if (source_returns_fetched_columns_in_order_of_keys)
             return request.filterRequestedColumns(fetched_columns_from_storage);
@@ -340,8 +346,12 @@ ColumnUInt8::Ptr CacheDictionary<dictionary_key_type>::hasKeys(const Columns & k
     }
     else if (not_found_keys_size == 0 && expired_keys_size > 0 && configuration.allow_read_expired_keys)
     {
-        /// Start async update only if allow read expired keys and all keys are found
-        update_queue.tryPushToUpdateQueueOrThrow(update_unit);
+        /// Start async update only if allow read expired keys and all keys are found.
+        /// Same as in getColumns, saturated update queue does not fail the query.
+        if (!update_queue.tryPushToUpdateQueue(update_unit))
+            LOG_DEBUG(log,
+                "Cannot schedule background refresh of expired keys in cache dictionary {}, serving stale values",
+                getDictionaryID().getNameForLogs());
 
         if (result_of_fetch_from_storage.default_keys_size == 0)
             return ColumnUInt8::create(keys.size(), true);
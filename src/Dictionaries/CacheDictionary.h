@@ -47,7 +47,8 @@ struct CacheDictionaryConfiguration
     3. If some data is not in storage cache dictionary try to perform update.
 
     If all keys are just expired and allow_read_expired_keys option is set dictionary starts asynchronous update and
-    return result to client.
+    return result to client. Scheduling of that update is best effort, if update queue is saturated
+    (for example because source is unavailable) stale result is returned anyway.
 
     If there are not found keys dictionary start synchronous update and wait for result.
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <limits>
 #include <variant>
 
 #include <pcg_random.hpp>
@@ -164,6 +165,10 @@ public:
 
 private:
 
+    /// Negative (default) cells are stored as a flag only and don't allocate slots
+    /// in attribute containers, see insertDefaultKeysImpl.
+    static constexpr size_t invalid_element_index = std::numeric_limits<size_t>::max();
+
     struct FetchedKey
     {
         FetchedKey(size_t element_index_, bool is_default_)
@@ -422,6 +427,19 @@ private:
                         cell.key = key;
                 }
 
+                /// Negative cell has no attribute slots, allocate them on promotion to a regular cell
+                if (cell.element_index == invalid_element_index)
+                {
+                    for (size_t attribute_index = 0; attribute_index < columns.size(); ++attribute_index)
+                    {
+                        getAttributeContainer(attribute_index, [&](auto & container)
+                        {
+                            container.emplace_back();
+                            cell.element_index = container.size() - 1;
+                        });
+                    }
+                }
+
                 /// Put values into existing index
                 size_t index_to_use = cell.element_index;
 
@@ -489,14 +507,9 @@ private:
                 else
                     cell.key = key;
 
-                for (size_t attribute_index = 0; attribute_index < attributes.size(); ++attribute_index)
-                {
-                    getAttributeContainer(attribute_index, [&](auto & container)
-                    {
-                        container.emplace_back();
-                        cell.element_index = container.size() - 1;
-                    });
-                }
+                /// Negative cell is a flag only, attribute slots are allocated lazily
+                /// if the key later appears in the source.
+                cell.element_index = invalid_element_index;
 
                 ++size;
             }
@@ -78,6 +78,15 @@ void CacheDictionaryUpdateQueue<dictionary_key_type>::tryPushToUpdateQueueOrThro
             std::to_string(update_queue.size()));
 }
 
+template <DictionaryKeyType dictionary_key_type>
+bool CacheDictionaryUpdateQueue<dictionary_key_type>::tryPushToUpdateQueue(CacheDictionaryUpdateUnitPtr<dictionary_key_type> & update_unit_ptr)
+{
+    if (update_queue.isFinished())
+        return false;
+
+    return update_queue.tryPush(update_unit_ptr, configuration.update_queue_push_timeout_milliseconds);
+}
+
 template <DictionaryKeyType dictionary_key_type>
 void CacheDictionaryUpdateQueue<dictionary_key_type>::waitForCurrentUpdateFinish(CacheDictionaryUpdateUnitPtr<dictionary_key_type> & update_unit_ptr) const
 {
@@ -138,6 +138,15 @@ public:
     */
     void tryPushToUpdateQueueOrThrow(CacheDictionaryUpdateUnitPtr<dictionary_key_type> & update_unit_ptr);
 
+    /** Try to add update unit into queue for background refresh of expired keys.
+
+        Unlike tryPushToUpdateQueueOrThrow returns false instead of throwing if queue
+        is full or finished. Callers that are allowed to read expired keys use it so
+        that saturation of the update queue (for example during source outage) does
+        not escalate into query failures while stale data is still servable.
+    */
+    bool tryPushToUpdateQueue(CacheDictionaryUpdateUnitPtr<dictionary_key_type> & update_unit_ptr);
+
     /** Try to synchronously wait for update completion.
 
         If exception was passed from update function during update it will be rethrowed.
@@ -17,6 +17,7 @@
 
 #include <Common/ArenaUtils.h>
 #include <Common/CurrentMetrics.h>
+#include <Common/HashTable/Prefetching.h>
 #include <Common/MemoryTrackerBlockerInThread.h>
 #include <Common/ThreadPool.h>
 #include <Common/logger_useful.h>
@@ -1068,9 +1069,8 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::getItemsImpl(
 
     size_t keys_found = 0;
 
-    for (size_t key_index = 0; key_index < keys_size; ++key_index)
+    auto process_key = [&](size_t key_index, KeyType key)
     {
-        auto key = keys_extractor.extractCurrentKey();
         auto shard = getShard(key);
 
         const auto & container = attribute_containers[shard];
@@ -1093,8 +1093,41 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::getItemsImpl(
                 set_value(key_index, default_value_extractor[key_index], false);
             }
         }
+    };
+
+    if constexpr (dictionary_key_type == DictionaryKeyType::Simple && !sparse)
+    {
+        /// Dictionary lookups usually miss all levels of cache because the table is much
+        /// bigger than the key block, so the probes dominate this loop. Extract all keys
+        /// upfront and prefetch the bucket a calibrated number of keys ahead of the one
+        /// being probed, same as HashMap::mergeToViaEmplace does.
+        auto keys = keys_extractor.extractAllKeys();
+
+        PrefetchingHelper prefetching;
+        size_t prefetch_look_ahead = PrefetchingHelper::getInitialLookAheadValue();
+
+        for (size_t key_index = 0; key_index < keys_size; ++key_index)
+        {
+            if (key_index == PrefetchingHelper::iterationsToMeasure())
+                prefetch_look_ahead = prefetching.calcPrefetchLookAhead();
+
+            if (key_index + prefetch_look_ahead < keys_size)
+            {
+                auto key_to_prefetch = keys[key_index + prefetch_look_ahead];
+                attribute_containers[getShard(key_to_prefetch)].prefetch(key_to_prefetch);
+            }
 
-        keys_extractor.rollbackCurrentKey();
+            process_key(key_index, keys[key_index]);
+        }
+    }
+    else
+    {
+        for (size_t key_index = 0; key_index < keys_size; ++key_index)
+        {
+            auto key = keys_extractor.extractCurrentKey();
+            process_key(key_index, key);
+            keys_extractor.rollbackCurrentKey();
+        }
     }
 
     query_count.fetch_add(keys_size, std::memory_order_relaxed);
@@ -1115,9 +1148,8 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::getItemsShortCircui
     default_mask.resize(keys_size);
     size_t keys_found = 0;
 
-    for (size_t key_index = 0; key_index < keys_size; ++key_index)
+    auto process_key = [&](size_t key_index, KeyType key)
     {
-        auto key = keys_extractor.extractCurrentKey();
         auto shard = getShard(key);
 
         const auto & container = attribute_containers[shard];
@@ -1143,8 +1175,38 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::getItemsShortCircui
             set_null_and_default(key_index);
             default_mask[key_index] = 1;
         }
+    };
+
+    if constexpr (dictionary_key_type == DictionaryKeyType::Simple && !sparse)
+    {
+        /// Same look-ahead prefetching as in getItemsImpl.
+        auto keys = keys_extractor.extractAllKeys();
+
+        PrefetchingHelper prefetching;
+        size_t prefetch_look_ahead = PrefetchingHelper::getInitialLookAheadValue();
+
+        for (size_t key_index = 0; key_index < keys_size; ++key_index)
+        {
+            if (key_index == PrefetchingHelper::iterationsToMeasure())
+                prefetch_look_ahead = prefetching.calcPrefetchLookAhead();
+
+            if (key_index + prefetch_look_ahead < keys_size)
+            {
+                auto key_to_prefetch = keys[key_index + prefetch_look_ahead];
+                attribute_containers[getShard(key_to_prefetch)].prefetch(key_to_prefetch);
+            }
 
-        keys_extractor.rollbackCurrentKey();
+            process_key(key_index, keys[key_index]);
+        }
+    }
+    else
+    {
+        for (size_t key_index = 0; key_index < keys_size; ++key_index)
+        {
+            auto key = keys_extractor.extractCurrentKey();
+            process_key(key_index, key);
+            keys_extractor.rollbackCurrentKey();
+        }
     }
 
     query_count.fetch_add(keys_size, std::memory_order_relaxed);
@@ -338,8 +338,11 @@ std::unique_ptr<WriteBufferFromFileBase>
 DiskLocal::writeFile(const String & path, size_t buf_size, WriteMode mode, const WriteSettings & settings)
 {
     int flags = (mode == WriteMode::Append) ? (O_APPEND | O_CREAT | O_WRONLY) : -1;
-    return std::make_unique<WriteBufferFromFile>(
+    auto res = std::make_unique<WriteBufferFromFile>(
         fs::path(disk_path) / path, buf_size, flags, settings.local_throttler);
+    if (settings.evict_written_data_from_page_cache)
+        res->setEvictWrittenDataFromPageCache();
+    return res;
 }
 
 std::vector<String> DiskLocal::getBlobPath(const String & path) const
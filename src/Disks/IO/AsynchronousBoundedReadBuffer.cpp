@@ -31,6 +31,8 @@ namespace ProfileEvents
     extern const Event RemoteFSLazySeeks;
     extern const Event RemoteFSSeeksWithReset;
     extern const Event RemoteFSBuffers;
+    extern const Event RemoteFSAdaptivePrefetchWindowGrows;
+    extern const Event RemoteFSAdaptivePrefetchSkips;
 }
 
 namespace DB
@@ -101,6 +103,26 @@ IAsynchronousReader::Result AsynchronousBoundedReadBuffer::readSync(char * data,
     return reader.execute(request);
 }
 
+size_t AsynchronousBoundedReadBuffer::choosePrefetchBufferSize() const
+{
+    size_t size = chooseBufferSizeForRemoteReading(read_settings, impl->getFileSize());
+
+    if (read_settings.remote_read_adaptive_prefetch)
+    {
+        /// Each sequentially consumed prefetch doubles the window, so a long streaming read
+        /// (e.g. a merge of a big part) quickly ramps up to a few large requests, while
+        /// mark-hopping point reads stay at the base size.
+        static constexpr size_t max_prefetch_window = 32 * 1024 * 1024;
+        size_t ramp_steps = std::min<size_t>(sequential_prefetch_reads, 10);
+        size = std::min(std::max(size << ramp_steps, size), max_prefetch_window);
+    }
+
+    if (read_until_position)
+        size = std::min(size, *read_until_position - file_offset_of_buffer_end);
+
+    return std::max<size_t>(size, 1);
+}
+
 void AsynchronousBoundedReadBuffer::prefetch(Priority priority)
 {
     if (prefetch_future.valid())
@@ -109,10 +131,19 @@ void AsynchronousBoundedReadBuffer::prefetch(Priority priority)
     if (!hasPendingDataToRead())
         return;
 
+    /// If the last prefetches in a row were all thrown away by seeks, this stream is doing
+    /// random access and prefetching only wastes requests and bandwidth. Pause it until the
+    /// reads become sequential again.
+    if (read_settings.remote_read_adaptive_prefetch && consecutive_cancelled_prefetches >= 2)
+    {
+        ProfileEvents::increment(ProfileEvents::RemoteFSAdaptivePrefetchSkips);
+        return;
+    }
+
     last_prefetch_info.submit_time = std::chrono::system_clock::now();
     last_prefetch_info.priority = priority;
 
-    prefetch_buffer.resize(chooseBufferSizeForRemoteReading(read_settings, impl->getFileSize()));
+    prefetch_buffer.resize(choosePrefetchBufferSize());
     prefetch_future = readAsync(prefetch_buffer.data(), prefetch_buffer.size(), priority);
     ProfileEvents::increment(ProfileEvents::RemoteFSPrefetches);
 }
@@ -206,11 +237,21 @@ bool AsynchronousBoundedReadBuffer::nextImpl()
 
         last_prefetch_info = {};
 
+        consecutive_cancelled_prefetches = 0;
+        if (read_settings.remote_read_adaptive_prefetch && sequential_prefetch_reads < 10)
+        {
+            ++sequential_prefetch_reads;
+            ProfileEvents::increment(ProfileEvents::RemoteFSAdaptivePrefetchWindowGrows);
+        }
+
         ProfileEvents::increment(ProfileEvents::RemoteFSPrefetchedReads);
         ProfileEvents::increment(ProfileEvents::RemoteFSPrefetchedBytes, result.size);
     }
     else
     {
+        if (consecutive_cancelled_prefetches)
+            --consecutive_cancelled_prefetches;
+
         memory.resize(chooseBufferSizeForRemoteReading(read_settings, impl->getFileSize()));
 
         {
@@ -305,6 +346,8 @@ off_t AsynchronousBoundedReadBuffer::seek(off_t offset, int whence)
         /// Prefetch is cancelled because of seek.
         if (read_from_prefetch)
         {
+            ++consecutive_cancelled_prefetches;
+            sequential_prefetch_reads = 0;
             ProfileEvents::increment(ProfileEvents::RemoteFSCancelledPrefetches);
             if (read_settings.enable_filesystem_read_prefetches_log)
             {
@@ -344,6 +387,7 @@ off_t AsynchronousBoundedReadBuffer::seek(off_t offset, int whence)
     {
         if (!impl->isSeekCheap())
             ProfileEvents::increment(ProfileEvents::RemoteFSSeeksWithReset);
+        sequential_prefetch_reads = 0;
         file_offset_of_buffer_end = new_pos;
         impl->seek(file_offset_of_buffer_end, SEEK_SET);
     }
@@ -79,12 +79,18 @@ private:
     };
     LastPrefetchInfo last_prefetch_info;
 
+    /// State of the adaptive prefetch window (see choosePrefetchBufferSize()).
+    size_t sequential_prefetch_reads = 0;
+    size_t consecutive_cancelled_prefetches = 0;
+
     bool nextImpl() override;
 
     void finalize();
 
     bool hasPendingDataToRead();
 
+    size_t choosePrefetchBufferSize() const;
+
     void appendToPrefetchLog(
         FilesystemPrefetchState state,
         int64_t size,
@@ -539,7 +539,8 @@ bool CachedOnDiskReadBufferFromFile::completeFileSegmentAndGetNext()
         return false;
 
     current_file_segment = &file_segments->front();
-    current_file_segment->increasePriority();
+    if (!settings.filesystem_cache_scan_resistant_read)
+        current_file_segment->increasePriority();
     implementation_buffer = getImplementationBuffer(*current_file_segment);
 
     LOG_TEST(
@@ -869,7 +870,8 @@ bool CachedOnDiskReadBufferFromFile::nextImplStep()
     else
     {
         implementation_buffer = getImplementationBuffer(file_segments->front());
-        file_segments->front().increasePriority();
+        if (!settings.filesystem_cache_scan_resistant_read)
+            file_segments->front().increasePriority();
     }
 
     chassert(!internal_buffer.empty());
@@ -46,7 +46,7 @@ namespace ErrorCodes
     extern const int IO_URING_SUBMIT_ERROR;
 }
 
-IOUringReader::IOUringReader(uint32_t entries_)
+IOUringReader::IOUringReader(uint32_t entries_, bool use_sqpoll_)
     : log(getLogger("IOUringReader"))
 {
     struct io_uring_probe * probe = io_uring_get_probe();
@@ -68,7 +68,7 @@ IOUringReader::IOUringReader(uint32_t entries_)
         .cq_entries = 0, // filled by the kernel, initializing to silence warning
         .flags = 0,
         .sq_thread_cpu = 0, // Unused (IORING_SETUP_SQ_AFF isn't set). Silences warning
-        .sq_thread_idle = 0, // Unused (IORING_SETUP_SQPOL isn't set). Silences warning
+        .sq_thread_idle = 0,
         .features = 0, // filled by the kernel, initializing to silence warning
         .wq_fd = 0, // Unused (IORING_SETUP_ATTACH_WQ isn't set). Silences warning.
         .resv = {0, 0, 0}, // "The resv array must be initialized to zero."
@@ -76,7 +76,24 @@ IOUringReader::IOUringReader(uint32_t entries_)
         .cq_off = {}, // filled by the kernel, initializing to silence warning
     };
 
+    if (use_sqpoll_)
+    {
+        /// With SQPOLL a kernel thread polls the submission queue, so io_uring_submit becomes
+        /// a plain memory write on the fast path - no syscall per read request.
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = 1000;
+    }
+
     int ret = io_uring_queue_init_params(entries_, &ring, &params);
+    if (ret < 0 && use_sqpoll_)
+    {
+        /// SQPOLL may be unavailable (e.g. it requires CAP_SYS_NICE on kernels before 5.11).
+        /// Fall back to the regular submission mode instead of failing all local reads.
+        LOG_WARNING(log, "Failed initializing io_uring with SQPOLL: {}, retrying without it", errnoToString(-ret));
+        params.flags &= ~IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = 0;
+        ret = io_uring_queue_init_params(entries_, &ring, &params);
+    }
     if (ret < 0)
         ErrnoException::throwWithErrno(ErrorCodes::IO_URING_INIT_FAILED, -ret, "Failed initializing io_uring");
 
@@ -76,7 +76,7 @@ private:
     const LoggerPtr log;
 
 public:
-    explicit IOUringReader(uint32_t entries_);
+    explicit IOUringReader(uint32_t entries_, bool use_sqpoll_ = false);
 
     bool isSupported() const { return is_supported; }
     std::future<Result> submit(Request request) override;
@@ -7,6 +7,7 @@
 #include <IO/ReadSettings.h>
 #include <IO/SwapHelper.h>
 #include <Interpreters/FilesystemCacheLog.h>
+#include <Common/Stopwatch.h>
 #include <Common/logger_useful.h>
 
 using namespace DB;
@@ -114,6 +115,9 @@ SeekableReadBufferPtr ReadBufferFromRemoteFSGather::createImplementationBuffer(c
     if (read_until_position > start_offset && read_until_position < start_offset + object.bytes_size)
         buf->setReadUntilPosition(read_until_position - start_offset);
 
+    /// The underlying buffer issues its remote request lazily on the first read.
+    expect_new_request = true;
+
     return buf;
 }
 
@@ -206,9 +210,14 @@ bool ReadBufferFromRemoteFSGather::readImpl()
 {
     SwapHelper swap(*this, *current_buf);
 
+    Stopwatch watch;
     bool result = current_buf->next();
+    watch.stop();
+
     if (result)
     {
+        updateReadStatistics(current_buf->available(), watch.elapsedSeconds());
+
         file_offset_of_buffer_end += current_buf->available();
         nextimpl_working_buffer_offset = current_buf->offset();
 
@@ -219,6 +228,38 @@ bool ReadBufferFromRemoteFSGather::readImpl()
     return result;
 }
 
+void ReadBufferFromRemoteFSGather::updateReadStatistics(size_t bytes, double elapsed_sec)
+{
+    /// Weight of the newest sample in the moving averages.
+    static constexpr double alpha = 0.3;
+
+    if (expect_new_request)
+    {
+        expect_new_request = false;
+        request_latency_sec = request_latency_sec > 0 ? alpha * elapsed_sec + (1 - alpha) * request_latency_sec : elapsed_sec;
+    }
+    else if (elapsed_sec > 0)
+    {
+        double bandwidth = bytes / elapsed_sec;
+        streaming_bandwidth_bytes_per_sec = streaming_bandwidth_bytes_per_sec > 0
+            ? alpha * bandwidth + (1 - alpha) * streaming_bandwidth_bytes_per_sec
+            : bandwidth;
+    }
+}
+
+size_t ReadBufferFromRemoteFSGather::adaptiveMinBytesForSeek() const
+{
+    if (!settings.remote_read_adaptive_min_bytes_for_seek || request_latency_sec <= 0 || streaming_bandwidth_bytes_per_sec <= 0)
+        return settings.remote_read_min_bytes_for_seek;
+
+    /// Reading through a gap of latency * bandwidth bytes takes about as long as setting up
+    /// a new ranged request, but saves the request. The upper bound protects against a noisy
+    /// latency sample making us stream arbitrary amounts of unneeded data.
+    static constexpr size_t max_read_through_gap = 64 * 1024 * 1024;
+    auto gap = static_cast<size_t>(request_latency_sec * streaming_bandwidth_bytes_per_sec);
+    return std::clamp(gap, settings.remote_read_min_bytes_for_seek, max_read_through_gap);
+}
+
 void ReadBufferFromRemoteFSGather::setReadUntilPosition(size_t position)
 {
     if (position == read_until_position)
@@ -265,7 +306,7 @@ off_t ReadBufferFromRemoteFSGather::seek(off_t offset, int whence)
         if (current_buf && offset > position)
         {
             size_t diff = offset - position;
-            if (diff < settings.remote_read_min_bytes_for_seek)
+            if (diff < adaptiveMinBytesForSeek())
             {
                 ignore(diff);
                 return offset;
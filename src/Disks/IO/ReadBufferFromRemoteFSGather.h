@@ -68,6 +68,10 @@ private:
 
     void reset();
 
+    void updateReadStatistics(size_t bytes, double elapsed_sec);
+
+    size_t adaptiveMinBytesForSeek() const;
+
     const ReadSettings settings;
     const StoredObjects blobs_to_read;
     const ReadBufferCreator read_buffer_creator;
@@ -85,6 +89,12 @@ private:
     size_t current_buf_idx = 0;
     SeekableReadBufferPtr current_buf;
 
+    /// Moving averages of the setup latency of a new remote request and of the streaming
+    /// bandwidth of an established one, used to tune the read-through-vs-seek threshold.
+    double request_latency_sec = 0;
+    double streaming_bandwidth_bytes_per_sec = 0;
+    bool expect_new_request = true;
+
     LoggerPtr log;
 };
 
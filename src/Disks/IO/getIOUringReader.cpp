@@ -4,6 +4,7 @@
 
 #include <Interpreters/Context.h>
 #include <Common/ErrorCodes.h>
+#include <Poco/Util/AbstractConfiguration.h>
 
 namespace DB
 {
@@ -14,9 +15,11 @@ namespace ErrorCodes
     extern const int UNSUPPORTED_METHOD;
 }
 
-std::unique_ptr<IOUringReader> createIOUringReader()
+std::unique_ptr<IOUringReader> createIOUringReader(const Poco::Util::AbstractConfiguration & config)
 {
-    return std::make_unique<IOUringReader>(512);
+    auto entries = config.getUInt("io_uring_queue_entries", 512);
+    auto use_sqpoll = config.getBool("io_uring_enable_sqpoll", false);
+    return std::make_unique<IOUringReader>(entries, use_sqpoll);
 }
 
 IOUringReader & getIOUringReaderOrThrow(ContextPtr context)
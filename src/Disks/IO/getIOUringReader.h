@@ -8,10 +8,12 @@
 #include <Disks/IO/IOUringReader.h>
 #include <memory>
 
+namespace Poco { namespace Util { class AbstractConfiguration; } }
+
 namespace DB
 {
 
-std::unique_ptr<IOUringReader> createIOUringReader();
+std::unique_ptr<IOUringReader> createIOUringReader(const Poco::Util::AbstractConfiguration & config);
 
 IOUringReader & getIOUringReaderOrThrow(ContextPtr);
 
@@ -143,6 +143,7 @@ struct FormatSettings
         bool allow_missing_fields = false;
         String string_column_pattern;
         UInt64 output_rows_in_file = 1;
+        bool parallel_block_decoding = true;
     } avro{};
 
     String bool_true_representation = "true";
@@ -399,6 +400,7 @@ struct FormatSettings
         bool use_fast_decoder = true;
         bool filter_push_down = true;
         UInt64 output_row_index_stride = 10'000;
+        bool decode_stripe_ahead = true;
     } orc{};
 
     /// For capnProto format we should determine how to
@@ -13,6 +13,18 @@
 
 #include <Common/logger_useful.h>
 
+#include <bit>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    include <base/simd.h>
+#    pragma clang diagnostic ignored "-Wreserved-identifier"
+#endif
+
 namespace DB
 {
 
@@ -71,6 +83,66 @@ namespace JSONUtils
             }
             else
             {
+#if defined(__SSE2__) || (defined(__aarch64__) && defined(__ARM_NEON))
+                /// Fast structural scan: a whole 16-byte block without quotes and escapes only
+                /// changes the bracket balance, so it can be consumed at once, visiting just the
+                /// bracket positions from the compare mask. Blocks with quotes or in which the
+                /// stop condition might fire are left to the precise loop below, so segment
+                /// boundaries are unchanged.
+                while (pos + 15 < in.buffer().end())
+                {
+#ifdef __SSE2__
+                    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+                    const UInt64 special_mask = static_cast<UInt64>(_mm_movemask_epi8(_mm_or_si128(
+                        _mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')))));
+                    if (special_mask)
+                        break;
+                    const UInt64 open_mask = static_cast<UInt64>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(opening_bracket))));
+                    const UInt64 close_mask = static_cast<UInt64>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(closing_bracket))));
+                    constexpr UInt64 bits_per_char = 1;
+#else
+                    const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t *>(pos));
+                    const UInt64 special_mask = getNibbleMask(vorrq_u8(
+                        vceqq_u8(bytes, vdupq_n_u8('"')), vceqq_u8(bytes, vdupq_n_u8('\\'))));
+                    if (special_mask)
+                        break;
+                    const UInt64 open_mask = getNibbleMask(vceqq_u8(bytes, vdupq_n_u8(opening_bracket)));
+                    const UInt64 close_mask = getNibbleMask(vceqq_u8(bytes, vdupq_n_u8(closing_bracket)));
+                    constexpr UInt64 bits_per_char = 4;
+#endif
+
+                    /// At most one row can end per closing bracket, so this bounds the rows the
+                    /// block may add; if the stop (or huge-object) condition might fire within it,
+                    /// let the precise loop find the exact position.
+                    const size_t max_rows_after = number_of_rows + std::popcount(close_mask) / bits_per_char;
+                    const size_t bytes_after = memory.size() + static_cast<size_t>(pos + 16 - in.position());
+                    if (max_rows_after >= min_rows && (bytes_after >= min_bytes || (max_rows && max_rows_after >= max_rows)))
+                        break;
+                    if (min_bytes != 0 && bytes_after > 10 * min_bytes)
+                        break;
+
+                    UInt64 brackets = open_mask | close_mask;
+                    while (brackets)
+                    {
+                        constexpr UInt64 char_bits = (1ULL << bits_per_char) - 1;
+                        const UInt64 bit_pos = std::countr_zero(brackets) / bits_per_char * bits_per_char;
+                        brackets &= ~(char_bits << bit_pos);
+                        if ((open_mask >> bit_pos) & 1)
+                        {
+                            ++balance;
+                        }
+                        else
+                        {
+                            --balance;
+                            if (balance == 0)
+                                ++number_of_rows;
+                        }
+                    }
+
+                    pos += 16;
+                }
+#endif
+
                 pos = find_first_symbols<opening_bracket, closing_bracket, '"'>(pos, in.buffer().end());
 
                 if (pos > in.buffer().end())
@@ -168,25 +168,42 @@ Block NativeReader::read()
         /// Type
         String type_name;
         readBinary(type_name, istr);
-        column.type = data_type_factory.get(type_name);
 
-        setVersionToAggregateFunctions(column.type, true, server_revision);
+        SerializationPtr default_serialization;
+        if (auto it = data_type_cache.find(type_name); it != data_type_cache.end())
+        {
+            column.type = it->second.type;
+            default_serialization = it->second.default_serialization;
+        }
+        else
+        {
+            column.type = data_type_factory.get(type_name);
+            setVersionToAggregateFunctions(column.type, true, server_revision);
+            default_serialization = column.type->getDefaultSerialization();
+            data_type_cache.emplace(type_name, TypeWithSerialization{column.type, default_serialization});
+        }
 
         SerializationPtr serialization;
         if (server_revision >= DBMS_MIN_REVISION_WITH_CUSTOM_SERIALIZATION)
         {
-            auto info = column.type->createSerializationInfo({});
-
             UInt8 has_custom;
             readBinary(has_custom, istr);
             if (has_custom)
+            {
+                /// A SerializationInfo with all-default kinds produces the default serialization,
+                /// so the tree of info objects is only needed when custom kinds were sent.
+                auto info = column.type->createSerializationInfo({});
                 info->deserializeFromKindsBinary(istr);
-
-            serialization = column.type->getSerialization(*info);
+                serialization = column.type->getSerialization(*info);
+            }
+            else
+            {
+                serialization = default_serialization;
+            }
         }
         else
         {
-            serialization = column.type->getDefaultSerialization();
+            serialization = default_serialization;
         }
 
         if (use_index)
@@ -5,6 +5,8 @@
 #include <Common/PODArray.h>
 #include <Core/Block.h>
 
+#include <unordered_map>
+
 namespace DB
 {
 
@@ -65,6 +67,19 @@ private:
 
     PODArray<double> avg_value_size_hints;
 
+    /// Creation of a data type from its name goes through the full data type parser,
+    /// and a default serialization is a freshly allocated tree of objects on every request.
+    /// All blocks of one stream almost always have the same structure, so cache resolved
+    /// types (with aggregate function versions already applied) and their default
+    /// serializations by type name. Matters for long-lived insert connections
+    /// that receive many small blocks.
+    struct TypeWithSerialization
+    {
+        DataTypePtr type;
+        SerializationPtr default_serialization;
+    };
+    std::unordered_map<String, TypeWithSerialization> data_type_cache;
+
     void updateAvgValueSizeHints(const Block & block);
 };
 
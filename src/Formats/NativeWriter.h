@@ -34,6 +34,9 @@ public:
 
     static String getContentType() { return "application/octet-stream"; }
 
+    /// Serializes the data of a single column (the counterpart of NativeReader::readData).
+    static void writeData(const ISerialization & serialization, const ColumnPtr & column, WriteBuffer & ostr, UInt64 offset, UInt64 limit);
+
 private:
     WriteBuffer & ostr;
     UInt64 client_revision;
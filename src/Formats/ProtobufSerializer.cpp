@@ -2440,6 +2440,15 @@ namespace
 
             for (size_t i : collections::range(field_infos.size()))
                 field_index_by_field_tag.emplace(field_infos[i].field_tag, i);
+
+            /// Most schemas use small field numbers, so the dispatch of out-of-order fields
+            /// can use a flat table indexed by tag instead of hashing.
+            if (!field_infos.empty() && field_infos.back().field_tag <= max_field_tag_for_flat_index)
+            {
+                field_index_by_small_field_tag.resize(field_infos.back().field_tag + 1, static_cast<size_t>(-1));
+                for (size_t i : collections::range(field_infos.size()))
+                    field_index_by_small_field_tag[field_infos[i].field_tag] = i;
+            }
         }
 
         void setHasEnvelopeAsParent()
@@ -2630,11 +2639,21 @@ namespace
                 last_field_tag = field_infos[last_field_index].field_tag;
             }
             last_field_tag = field_tag;
-            auto it = field_index_by_field_tag.find(field_tag);
-            if (it == field_index_by_field_tag.end())
-                last_field_index = static_cast<size_t>(-1);
+            if (!field_index_by_small_field_tag.empty())
+            {
+                if (field_tag >= 0 && static_cast<size_t>(field_tag) < field_index_by_small_field_tag.size())
+                    last_field_index = field_index_by_small_field_tag[field_tag];
+                else
+                    last_field_index = static_cast<size_t>(-1);
+            }
             else
-                last_field_index = it->second;
+            {
+                auto it = field_index_by_field_tag.find(field_tag);
+                if (it == field_index_by_field_tag.end())
+                    last_field_index = static_cast<size_t>(-1);
+                else
+                    last_field_index = it->second;
+            }
             return last_field_index;
         }
 
@@ -2683,8 +2702,12 @@ namespace
         const bool should_skip_if_empty;
         ProtobufReader * const reader;
         ProtobufWriter * const writer;
+        static constexpr int max_field_tag_for_flat_index = 1024;
+
         std::vector<FieldInfo> field_infos;
         std::unordered_map<int, size_t> field_index_by_field_tag;
+        /// Field index by tag for schemas whose largest tag is small; element is -1 for unknown tags.
+        std::vector<size_t> field_index_by_small_field_tag;
         MutableColumns mutable_columns;
         bool has_missing_columns = false;
         int last_field_tag = 0;
@@ -820,6 +820,8 @@ struct ToStartOfMinuteImpl
         throwDate32IsNotSupported(name);
     }
 
+    static constexpr Int64 offset_run_bucket = 60;
+
     using FactorTransform = ZeroTransform;
 };
 
@@ -1022,6 +1024,8 @@ struct ToStartOfFiveMinutesImpl
         throwDate32IsNotSupported(name);
     }
 
+    static constexpr Int64 offset_run_bucket = 300;
+
     using FactorTransform = ZeroTransform;
 };
 
@@ -1054,6 +1058,8 @@ struct ToStartOfTenMinutesImpl
         throwDate32IsNotSupported(name);
     }
 
+    static constexpr Int64 offset_run_bucket = 600;
+
     using FactorTransform = ZeroTransform;
 };
 
@@ -1086,6 +1092,8 @@ struct ToStartOfFifteenMinutesImpl
         throwDate32IsNotSupported(name);
     }
 
+    static constexpr Int64 offset_run_bucket = 900;
+
     using FactorTransform = ZeroTransform;
 };
 
@@ -1163,6 +1171,10 @@ struct ToStartOfHourImpl
         throwDate32IsNotSupported(name);
     }
 
+    /// Within a range of timestamps sharing one UTC offset the transform is a rounding of the local
+    /// time down to a multiple of this many seconds (see Transformer).
+    static constexpr Int64 offset_run_bucket = 3600;
+
     using FactorTransform = ZeroTransform;
 };
 
@@ -2137,6 +2149,51 @@ struct Transformer
         size_t size = vec_from.size();
         vec_to.resize(size);
 
+        /// The in-day interval transforms round the time down to a multiple of the interval counted
+        /// from the start of the day, so within one calendar day they are plain arithmetic. Real-life
+        /// data is nearly sorted in time: detect maximal runs of the input falling into one day and
+        /// transform the whole run with the arithmetic (which vectorizes) instead of going to the
+        /// date LUT for every value. The LUT is consulted once per run and at the day boundaries.
+        if constexpr (requires { Transform::offset_run_bucket; })
+        {
+            if constexpr (std::is_same_v<typename FromTypeVector::value_type, UInt32> && !is_extended_result
+                && std::is_same_v<Additions, void *>)
+            {
+                constexpr Int64 bucket = Transform::offset_run_bucket;
+
+                size_t i = 0;
+                while (i < size)
+                {
+                    const UInt32 run_value = vec_from[i];
+                    vec_to[i] = static_cast<ValueType>(transform.execute(run_value, time_zone));
+                    ++i;
+
+                    DateLUTImpl::Time range_begin;
+                    DateLUTImpl::Time range_end;
+                    time_zone.getDayRange(run_value, range_begin, range_end);
+                    if (range_end <= run_value || run_value < range_begin)
+                        continue;
+
+                    /// Verify the arithmetic against the LUT on the first value of the run.
+                    Int64 run_value_rounded = range_begin + (Int64(run_value) - range_begin) / bucket * bucket;
+                    if (run_value_rounded < 0)
+                        run_value_rounded = 0;
+                    if (static_cast<ValueType>(run_value_rounded) != vec_to[i - 1])
+                        continue;
+
+                    while (i < size && vec_from[i] >= range_begin && vec_from[i] < range_end)
+                    {
+                        Int64 rounded = range_begin + (Int64(vec_from[i]) - range_begin) / bucket * bucket;
+                        if (rounded < 0)
+                            rounded = 0;
+                        vec_to[i] = static_cast<ValueType>(rounded);
+                        ++i;
+                    }
+                }
+                return;
+            }
+        }
+
         for (size_t i = 0; i < size; ++i)
         {
             if constexpr (std::is_same_v<ToType, DataTypeDate> || std::is_same_v<ToType, DataTypeDateTime>)
@@ -561,6 +561,11 @@ public:
         else
             size = a.size();
 
+        /// Overflow is accumulated into a single flag over the whole batch and reported
+        /// once after the loop. Testing and throwing per element puts a branch into the
+        /// hot loop and prevents the compiler from vectorizing it.
+        bool overflow = false;
+
         if constexpr (is_plus_minus_compare)
         {
             if (scale_a != 1)
@@ -569,7 +574,8 @@ public:
                     c[i] = applyScaled<true>(
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::LeftConstant>(a, i)),
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::RightConstant>(b, i)),
-                        scale_a);
+                        scale_a, overflow);
+                reportOverflow(overflow);
                 return;
             }
             else if (scale_b != 1)
@@ -578,7 +584,8 @@ public:
                     c[i] = applyScaled<false>(
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::LeftConstant>(a, i)),
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::RightConstant>(b, i)),
-                        scale_b);
+                        scale_b, overflow);
+                reportOverflow(overflow);
                 return;
             }
         }
@@ -590,7 +597,8 @@ public:
                     c[i] = applyScaled<true, false>(
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::LeftConstant>(a, i)),
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::RightConstant>(b, i)),
-                        scale_a);
+                        scale_a, overflow);
+                reportOverflow(overflow);
                 return;
             }
             else if (scale_b != 1)
@@ -599,7 +607,8 @@ public:
                     c[i] = applyScaled<false, false>(
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::LeftConstant>(a, i)),
                         static_cast<NativeResultType>(unwrap<op_case, OpCase::RightConstant>(b, i)),
-                        scale_b);
+                        scale_b, overflow);
+                reportOverflow(overflow);
                 return;
             }
 
@@ -616,12 +625,14 @@ public:
 
         processWithRightNullmapImpl<op_case>(
             a, b, c, size, right_nullmap,
-            [](const auto & left, const auto & right)
+            [&overflow](const auto & left, const auto & right)
             {
                 return apply(
                     static_cast<NativeResultType>(left),
-                    static_cast<NativeResultType>(right));
+                    static_cast<NativeResultType>(right),
+                    overflow);
             });
+        reportOverflow(overflow);
     }
 
     template <bool is_decimal_a, bool is_decimal_b, class A, class B>
@@ -630,15 +641,29 @@ public:
     {
         if constexpr (is_division && is_decimal_b)
             return applyScaledDiv<is_decimal_a>(a, b, scale_a);
-        else if constexpr (is_plus_minus_compare)
+
+        bool overflow = false;
+        NativeResultType res;
+
+        if constexpr (is_plus_minus_compare)
         {
             if (scale_a != 1)
-                return applyScaled<true>(a, b, scale_a);
+            {
+                res = applyScaled<true>(a, b, scale_a, overflow);
+                reportOverflow(overflow);
+                return res;
+            }
             if (scale_b != 1)
-                return applyScaled<false>(a, b, scale_b);
+            {
+                res = applyScaled<false>(a, b, scale_b, overflow);
+                reportOverflow(overflow);
+                return res;
+            }
         }
 
-        return apply(a, b);
+        res = apply(a, b, overflow);
+        reportOverflow(overflow);
+        return res;
     }
 
 private:
@@ -700,14 +725,20 @@ private:
             return undec(elem[i]);
     }
 
+    static void reportOverflow(bool overflow)
+    {
+        if constexpr (check_overflow)
+            if (unlikely(overflow))
+                throw Exception(ErrorCodes::DECIMAL_OVERFLOW, "Decimal math overflow");
+    }
+
     /// there's implicit type conversion here
-    static NativeResultType apply(NativeResultType a, NativeResultType b)
+    static NativeResultType apply(NativeResultType a, NativeResultType b, bool & overflow)
     {
         if constexpr (can_overflow && check_overflow)
         {
             NativeResultType res;
-            if (Op::template apply<NativeResultType>(a, b, res))
-                throw Exception(ErrorCodes::DECIMAL_OVERFLOW, "Decimal math overflow");
+            overflow |= Op::template apply<NativeResultType>(a, b, res);
             return res;
         }
         else
@@ -715,15 +746,13 @@ private:
     }
 
     template <bool scale_left, bool may_check_overflow = true>
-    static NO_SANITIZE_UNDEFINED NativeResultType applyScaled(NativeResultType a, NativeResultType b, NativeResultType scale)
+    static NO_SANITIZE_UNDEFINED NativeResultType applyScaled(NativeResultType a, NativeResultType b, NativeResultType scale, bool & overflow)
     {
         static_assert(is_plus_minus_compare || is_multiply);
         NativeResultType res;
 
         if constexpr (check_overflow && may_check_overflow)
         {
-            bool overflow = false;
-
             if constexpr (scale_left)
                 overflow |= common::mulOverflow(a, scale, a);
             else
@@ -733,9 +762,6 @@ private:
                 overflow |= Op::template apply<NativeResultType>(a, b, res);
             else
                 res = Op::template apply<NativeResultType>(a, b);
-
-            if (overflow)
-                throw Exception(ErrorCodes::DECIMAL_OVERFLOW, "Decimal math overflow");
         }
         else
         {
@@ -170,6 +170,8 @@ public:
 
     bool isDeterministic() const override { return false; }
 
+    bool isSuitableForExecutionOnUniqueValues() const override { return true; }
+
     bool isSuitableForShortCircuitArgumentsExecution(const DataTypesWithConstInfo & /*arguments*/) const override { return true; }
 
     bool useDefaultImplementationForConstants() const final { return true; }
@@ -351,6 +353,8 @@ public:
 
     bool isDeterministic() const override { return false; }
 
+    bool isSuitableForExecutionOnUniqueValues() const override { return true; }
+
     bool isInjective(const ColumnsWithTypeAndName & sample_columns) const override
     {
         return helper.isDictGetFunctionInjective(sample_columns);
@@ -804,6 +808,8 @@ private:
 
     bool isDeterministic() const override { return false; }
 
+    bool isSuitableForExecutionOnUniqueValues() const override { return true; }
+
     bool isSuitableForShortCircuitArgumentsExecution(const DataTypesWithConstInfo & /*arguments*/) const override { return true; }
 
     ColumnNumbers getArgumentsThatAreAlwaysConstant() const final { return {0, 1}; }
@@ -163,6 +163,60 @@ public:
         }
     };
 
+    /// Executor for fusedJSONExtract: parses each document once and evaluates several single-key
+    /// extractions against it, one destination column per extraction. Each extraction behaves
+    /// exactly as the standalone function would: the same move by key and the same Impl insertion,
+    /// with a default value on parse or lookup failure.
+    template <class JSONParser>
+    class FusedExtractExecutor
+    {
+    public:
+        using InsertResultToColumn = bool (*)(IColumn &, const typename JSONParser::Element &, std::string_view);
+
+        static void run(
+            const ColumnString & col_json,
+            const std::vector<String> & keys,
+            const std::vector<InsertResultToColumn> & inserters,
+            MutableColumns & to,
+            size_t input_rows_count)
+        {
+            const ColumnString::Chars & chars = col_json.getChars();
+            const ColumnString::Offsets & offsets = col_json.getOffsets();
+
+            /// Preallocate memory in parser if necessary.
+            JSONParser parser;
+            if constexpr (has_member_function_reserve<void (JSONParser::*)(size_t)>::value)
+            {
+                size_t max_size = calculateMaxSize(offsets);
+                if (max_size)
+                    parser.reserve(max_size);
+            }
+
+            using Element = typename JSONParser::Element;
+
+            for (const auto i : collections::range(0, input_rows_count))
+            {
+                std::string_view json{reinterpret_cast<const char *>(&chars[offsets[i - 1]]), offsets[i] - offsets[i - 1] - 1};
+                Element document;
+                bool document_ok = parser.parse(json, document);
+
+                for (size_t j = 0; j != keys.size(); ++j)
+                {
+                    bool added_to_column = false;
+                    if (document_ok)
+                    {
+                        Element element = document;
+                        if (moveToElementByKey<JSONParser>(element, keys[j]))
+                            added_to_column = inserters[j](*to[j], element, keys[j]);
+                    }
+
+                    if (!added_to_column)
+                        to[j]->insertDefault();
+                }
+            }
+        }
+    };
+
 private:
     BOOST_TTI_HAS_MEMBER_FUNCTION(reserve)
     BOOST_TTI_HAS_MEMBER_FUNCTION(prepare)
@@ -16,6 +16,8 @@
 #include <DataTypes/Native.h>
 #include <DataTypes/DataTypeLowCardinality.h>
 #include <Functions/FunctionHelpers.h>
+#include <base/sort.h>
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 
@@ -240,6 +242,10 @@ ColumnPtr IExecutableFunction::executeWithoutLowCardinalityColumns(
     if (auto res = defaultImplementationForNulls(args, result_type, input_rows_count, dry_run))
         return res;
 
+    if (!dry_run && isSuitableForExecutionOnUniqueValues())
+        if (auto res = executeOnUniqueValues(args, result_type, input_rows_count))
+            return res;
+
     ColumnPtr res;
     if (dry_run)
         res = executeDryRunImpl(args, result_type, input_rows_count);
@@ -252,6 +258,69 @@ ColumnPtr IExecutableFunction::executeWithoutLowCardinalityColumns(
     return res;
 }
 
+ColumnPtr IExecutableFunction::executeOnUniqueValues(
+    const ColumnsWithTypeAndName & args, const DataTypePtr & result_type, size_t input_rows_count) const
+{
+    /// Building the per-block dictionary must be clearly cheaper than evaluating the function
+    /// on the repeated rows, so require a large enough block and a low enough distinct share.
+    static constexpr size_t min_rows_to_detect_cardinality = 512;
+    static constexpr size_t max_unique_values_ratio = 4;
+
+    if (input_rows_count < min_rows_to_detect_cardinality)
+        return nullptr;
+
+    /// ColumnFunction does not support getting specific values.
+    if (result_type->getTypeId() == TypeIndex::Function)
+        return nullptr;
+
+    /// Only the common shape of one full argument among constants is handled: the distinct
+    /// values of several full columns would require hashing the whole argument tuple.
+    ssize_t full_argument_position = -1;
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        if (isColumnConst(*args[i].column))
+            continue;
+
+        if (full_argument_position != -1)
+            return nullptr;
+
+        full_argument_position = i;
+    }
+
+    if (full_argument_position < 0)
+        return nullptr;
+
+    const auto & full_argument = args[full_argument_position];
+    if (!full_argument.type->canBeInsideLowCardinality())
+        return nullptr;
+
+    auto dictionary = DataTypeLowCardinality::createColumnUnique(*full_argument.type);
+    ColumnPtr indexes = dictionary->uniqueInsertRangeFrom(*full_argument.column, 0, input_rows_count);
+
+    const auto & unique_values = dictionary->getNestedColumn();
+    size_t unique_rows = unique_values->size();
+    if (unique_rows > input_rows_count / max_unique_values_ratio)
+        return nullptr;
+
+    ColumnsWithTypeAndName unique_args = args;
+    for (size_t i = 0; i < unique_args.size(); ++i)
+    {
+        if (static_cast<ssize_t>(i) == full_argument_position)
+            unique_args[i].column = unique_values;
+        else
+            unique_args[i].column = unique_args[i].column->cloneResized(unique_rows);
+    }
+
+    auto res = executeImpl(unique_args, result_type, unique_rows);
+    if (!res)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Empty column was returned by function {}", getName());
+
+    if (isColumnConst(*res))
+        return res->cloneResized(input_rows_count);
+
+    return res->index(*indexes, 0);
+}
+
 static void convertSparseColumnsToFull(ColumnsWithTypeAndName & args)
 {
     for (auto & column : args)
@@ -269,6 +338,36 @@ ColumnPtr IExecutableFunction::executeWithoutSparseColumns(const ColumnsWithType
         {
             bool can_be_executed_on_default_arguments = canBeExecutedOnDefaultArguments();
 
+            /// Try to reuse a memoized result over the same dictionary (see canCacheLowCardinalityResult()).
+            /// Only the path through full dictionaries qualifies: with can_be_executed_on_default_arguments == false
+            /// the function is evaluated on a per-block subset of the dictionary.
+            const ColumnLowCardinality * low_cardinality_argument = nullptr;
+            if (!dry_run && can_be_executed_on_default_arguments && canCacheLowCardinalityResult())
+            {
+                for (const auto & argument : arguments)
+                {
+                    if (const auto * low_cardinality_column = checkAndGetColumn<ColumnLowCardinality>(argument.column.get()))
+                    {
+                        low_cardinality_argument = low_cardinality_column;
+                        break;
+                    }
+                }
+            }
+
+            if (low_cardinality_argument)
+            {
+                std::lock_guard lock(low_cardinality_result_cache.mutex);
+                const auto & cache = low_cardinality_result_cache;
+                if (cache.dictionary.get() == low_cardinality_argument->getDictionaryPtr().get()
+                    && cache.dictionary_size == low_cardinality_argument->getDictionary().size())
+                {
+                    return ColumnLowCardinality::create(
+                        cache.result_dictionary,
+                        cache.result_indexes->index(*low_cardinality_argument->getIndexesPtr(), 0),
+                        /*is_shared*/ true);
+                }
+            }
+
             const auto & dictionary_type = res_low_cardinality_type->getDictionaryType();
             ColumnPtr indexes = replaceLowCardinalityColumnsByNestedAndGetDictionaryIndexes(
                     columns_without_low_cardinality, can_be_executed_on_default_arguments, input_rows_count);
@@ -290,7 +389,26 @@ ColumnPtr IExecutableFunction::executeWithoutSparseColumns(const ColumnsWithType
             ColumnUniquePtr res_dictionary = std::move(res_mut_dictionary);
 
             if (indexes && !res_is_constant)
-                result = ColumnLowCardinality::create(res_dictionary, res_indexes->index(*indexes, 0));
+            {
+                if (low_cardinality_argument)
+                {
+                    /// Memoize the per-dictionary result, so that subsequent blocks sharing the same
+                    /// dictionary skip the evaluation entirely. The dictionary pointer together with its
+                    /// size identifies the content: ColumnUnique is append-only and the owning pointer
+                    /// in the cache keeps the column alive, so the address cannot be reused.
+                    std::lock_guard lock(low_cardinality_result_cache.mutex);
+                    auto & cache = low_cardinality_result_cache;
+                    cache.dictionary = low_cardinality_argument->getDictionaryPtr();
+                    cache.dictionary_size = low_cardinality_argument->getDictionary().size();
+                    cache.result_dictionary = res_dictionary;
+                    cache.result_indexes = res_indexes;
+
+                    result = ColumnLowCardinality::create(
+                        cache.result_dictionary, cache.result_indexes->index(*indexes, 0), /*is_shared*/ true);
+                }
+                else
+                    result = ColumnLowCardinality::create(res_dictionary, res_indexes->index(*indexes, 0));
+            }
             else
                 result = ColumnLowCardinality::create(res_dictionary, res_indexes);
 
@@ -376,6 +494,55 @@ ColumnPtr IExecutableFunction::execute(const ColumnsWithTypeAndName & arguments,
             return ColumnSparse::create(res, sparse_offsets, input_rows_count);
         }
 
+        if (num_sparse_columns > 1 && num_full_columns == 0)
+        {
+            /// Several sparse arguments (and no full ones): execute the function only at the union
+            /// of their non-default rows. At position 0 of the values columns all sparse arguments
+            /// hold their defaults, so it evaluates the default of the result, as required above.
+            auto union_offsets_column = ColumnVector<UInt64>::create();
+            auto & union_offsets = union_offsets_column->getData();
+            for (const auto & argument : columns_without_sparse)
+            {
+                if (const auto * column_sparse = checkAndGetColumn<ColumnSparse>(argument.column.get()))
+                {
+                    const auto & offsets_data = assert_cast<const ColumnVector<UInt64> &>(*column_sparse->getOffsetsPtr()).getData();
+                    union_offsets.insert(offsets_data.begin(), offsets_data.end());
+                }
+            }
+
+            ::sort(union_offsets.begin(), union_offsets.end());
+            union_offsets.resize(std::unique(union_offsets.begin(), union_offsets.end()) - union_offsets.begin());
+
+            size_t values_size = union_offsets.size() + 1;
+            for (auto & argument : columns_without_sparse)
+            {
+                if (const auto * column_sparse = checkAndGetColumn<ColumnSparse>(argument.column.get()))
+                {
+                    auto value_indices = ColumnVector<UInt64>::create(values_size);
+                    auto & indices_data = value_indices->getData();
+                    indices_data[0] = 0;
+                    for (size_t i = 0; i < union_offsets.size(); ++i)
+                        indices_data[i + 1] = column_sparse->getValueIndex(union_offsets[i]);
+
+                    argument.column = column_sparse->getValuesPtr()->index(*value_indices, 0);
+                }
+                else
+                {
+                    argument.column = argument.column->cloneResized(values_size);
+                }
+            }
+
+            auto res = executeWithoutSparseColumns(columns_without_sparse, result_type, values_size, dry_run);
+
+            if (isColumnConst(*res))
+                return res->cloneResized(input_rows_count);
+
+            if (!result_type->canBeInsideSparseColumns() || !res->isDefaultAt(0) || res->getNumberOfDefaultRows() != 1)
+                return res->createWithOffsets(union_offsets, *createColumnConst(res, 0), input_rows_count, /*shift=*/ 1);
+
+            return ColumnSparse::create(res, std::move(union_offsets_column), input_rows_count);
+        }
+
         convertSparseColumnsToFull(columns_without_sparse);
         return executeWithoutSparseColumns(columns_without_sparse, result_type, input_rows_count, dry_run);
     }
@@ -13,6 +13,7 @@
 #include "config.h"
 
 #include <memory>
+#include <mutex>
 
 /// This file contains user interface for functions.
 
@@ -104,8 +105,35 @@ protected:
       */
     virtual bool canBeExecutedOnDefaultArguments() const { return true; }
 
+    /** True if the result computed over a LowCardinality dictionary may be memoized and reused for
+      * subsequent blocks that share the same dictionary. Requires the function to be deterministic
+      * in the scope of the query. Pays off for expensive functions (regexes, JSON paths) over
+      * streams of blocks sharing one dictionary, e.g. read from the native format or from MergeTree.
+      */
+    virtual bool canCacheLowCardinalityResult() const { return false; }
+
+    /** True if the function may be executed on the distinct values of its single full argument
+      * only, with the results scattered back, when a large enough block turns out to have few
+      * distinct values (see executeOnUniqueValues()). Worthwhile only for functions whose per-row
+      * cost clearly exceeds building a per-block dictionary of the argument, e.g. dictGet.
+      * Requires the function to be deterministic in the scope of the query.
+      */
+    virtual bool isSuitableForExecutionOnUniqueValues() const { return false; }
+
 private:
 
+    /// Single-entry memo for the result computed over a LowCardinality dictionary
+    /// (see canCacheLowCardinalityResult()).
+    struct LowCardinalityResultCache
+    {
+        std::mutex mutex;
+        ColumnPtr dictionary;          /// The dictionary of the source column, also keeps the key alive.
+        size_t dictionary_size = 0;
+        ColumnPtr result_dictionary;
+        ColumnPtr result_indexes;
+    };
+    mutable LowCardinalityResultCache low_cardinality_result_cache;
+
     ColumnPtr defaultImplementationForConstantArguments(
             const ColumnsWithTypeAndName & args, const DataTypePtr & result_type, size_t input_rows_count, bool dry_run) const;
 
@@ -118,6 +146,12 @@ private:
     ColumnPtr executeWithoutLowCardinalityColumns(
             const ColumnsWithTypeAndName & args, const DataTypePtr & result_type, size_t input_rows_count, bool dry_run) const;
 
+    /// Executes the function on the distinct values of its single full argument and scatters the
+    /// results, or returns nullptr when the block is too small, the argument shape does not fit
+    /// or the distinct share is too high (see isSuitableForExecutionOnUniqueValues()).
+    ColumnPtr executeOnUniqueValues(
+            const ColumnsWithTypeAndName & args, const DataTypePtr & result_type, size_t input_rows_count) const;
+
     ColumnPtr executeWithoutSparseColumns(
             const ColumnsWithTypeAndName & arguments, const DataTypePtr & result_type, size_t input_rows_count, bool dry_run) const;
 };
@@ -482,6 +516,13 @@ public:
       */
     virtual bool canBeExecutedOnDefaultArguments() const { return true; }
 
+    /** True if the function may be executed on the distinct values of its single full argument
+      * only, with the results scattered back, when a block turns out to have few distinct values.
+      * Worthwhile only for functions whose per-row cost clearly exceeds building a per-block
+      * dictionary of the argument, e.g. dictGet.
+      */
+    virtual bool isSuitableForExecutionOnUniqueValues() const { return false; }
+
     /// Properties from IFunctionBase (see IFunction.h)
     virtual bool isSuitableForConstantFolding() const { return true; }
     virtual ColumnPtr getConstantResultForNonConstArguments(const ColumnsWithTypeAndName & /*arguments*/, const DataTypePtr & /*result_type*/) const { return nullptr; }
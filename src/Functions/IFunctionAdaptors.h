@@ -35,6 +35,11 @@ protected:
     bool useDefaultImplementationForSparseColumns() const final { return function->useDefaultImplementationForSparseColumns(); }
     ColumnNumbers getArgumentsThatAreAlwaysConstant() const final { return function->getArgumentsThatAreAlwaysConstant(); }
     bool canBeExecutedOnDefaultArguments() const override { return function->canBeExecutedOnDefaultArguments(); }
+    bool canCacheLowCardinalityResult() const final { return function->isDeterministicInScopeOfQuery(); }
+    bool isSuitableForExecutionOnUniqueValues() const final
+    {
+        return function->isSuitableForExecutionOnUniqueValues() && function->isDeterministicInScopeOfQuery();
+    }
 
 private:
     std::shared_ptr<IFunction> function;
@@ -4,9 +4,15 @@
 #include <algorithm>
 #include <string>
 #include <vector>
+#include <Poco/Unicode.h>
 #include <Poco/UTF8String.h>
+#include <Common/UTF8Helpers.h>
 #include <Common/Volnitsky.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace DB
 {
 
@@ -54,6 +60,9 @@ struct PositionCaseSensitiveASCII
     /// Convert string to lowercase. Only for case-insensitive search.
     /// Implementation is permitted to be inefficient because it is called for single string.
     static void toLowerIfNeed(std::string &) { }
+
+    /// Whether a big haystack may be lowercased once and searched with a case-sensitive searcher.
+    static constexpr bool prelower_big_haystack = false;
 };
 
 
@@ -87,6 +96,8 @@ struct PositionCaseInsensitiveASCII
     static size_t countChars(const char * begin, const char * end) { return end - begin; }
 
     static void toLowerIfNeed(std::string & s) { std::transform(std::begin(s), std::end(s), std::begin(s), tolower); }
+
+    static constexpr bool prelower_big_haystack = false;
 };
 
 
@@ -135,6 +146,8 @@ struct PositionCaseSensitiveUTF8
     }
 
     static void toLowerIfNeed(std::string &) { }
+
+    static constexpr bool prelower_big_haystack = false;
 };
 
 
@@ -172,9 +185,81 @@ struct PositionCaseInsensitiveUTF8
     }
 
     static void toLowerIfNeed(std::string & s) { Poco::UTF8::toLowerInPlace(s); }
+
+    /// A non-ASCII needle may be searched in a lowercased copy of the haystack with the
+    /// case-sensitive searcher instead of lowercasing the code points of every candidate match.
+    static constexpr bool prelower_big_haystack = true;
+    using PreloweredSearcherInBigHaystack = VolnitskyUTF8;
 };
 
 
+/** Lowercases a UTF-8 buffer so that every byte position is preserved.
+  * Returns false (leaving the destination partially filled) if the buffer contains an invalid
+  * sequence or a code point whose lowercase form is encoded with a different number of bytes
+  * (e.g. ẞ or İ) - such data cannot be lowercased in place.
+  */
+inline bool lowerUTF8PreservingLength(const UInt8 * src, size_t size, UInt8 * dst)
+{
+    const UInt8 * src_end = src + size;
+
+#ifdef __SSE2__
+    const auto v_zero = _mm_setzero_si128();
+    const auto v_not_case_lower_bound = _mm_set1_epi8('A' - 1);
+    const auto v_not_case_upper_bound = _mm_set1_epi8('Z' + 1);
+    const auto v_flip_case_mask = _mm_set1_epi8('A' ^ 'a');
+#endif
+
+    while (src < src_end)
+    {
+#ifdef __SSE2__
+        /// Fast path for runs of ASCII.
+        while (src + sizeof(__m128i) <= src_end)
+        {
+            const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+            /// SSE2 packed comparison operates on signed types, hence compare (c < 0) instead of (c > 0x7f)
+            if (_mm_movemask_epi8(_mm_cmplt_epi8(chars, v_zero)))
+                break;
+
+            const auto is_not_case
+                = _mm_and_si128(_mm_cmpgt_epi8(chars, v_not_case_lower_bound), _mm_cmplt_epi8(chars, v_not_case_upper_bound));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_xor_si128(chars, _mm_and_si128(v_flip_case_mask, is_not_case)));
+
+            src += sizeof(__m128i);
+            dst += sizeof(__m128i);
+        }
+
+        if (src == src_end)
+            break;
+#endif
+
+        if (*src <= 0x7f)
+        {
+            *dst++ = (*src >= 'A' && *src <= 'Z') ? (*src ^ ('A' ^ 'a')) : *src;
+            ++src;
+            continue;
+        }
+
+        auto src_code_point = UTF8::convertUTF8ToCodePoint(src, src_end - src);
+        if (!src_code_point)
+            return false;
+
+        size_t src_sequence_length = UTF8::seqLength(*src);
+
+        UInt8 lower_seq[8];
+        size_t dst_sequence_length = UTF8::convertCodePointToUTF8(Poco::Unicode::toLower(*src_code_point), lower_seq, sizeof(lower_seq));
+        if (dst_sequence_length != src_sequence_length)
+            return false;
+
+        memcpy(dst, lower_seq, dst_sequence_length);
+        src += src_sequence_length;
+        dst += dst_sequence_length;
+    }
+
+    return true;
+}
+
+
 template <typename Name, typename Impl>
 struct PositionImpl
 {
@@ -249,10 +334,53 @@ struct PositionImpl
             }
         }
 
-        /// Current index in the array of strings.
-        size_t i = 0;
+        if constexpr (Impl::prelower_big_haystack)
+        {
+            /// For a non-ASCII needle it is faster to lowercase the needle and the whole haystack once
+            /// and run the case-sensitive searcher over them than to lowercase the code points of every
+            /// candidate match. Lowercasing preserves the byte positions (see lowerUTF8PreservingLength),
+            /// so the offsets and the found positions apply to the original data as well. If the needle or
+            /// the haystack contains a code point that cannot be lowercased in place, fall back to the
+            /// case-insensitive searcher.
+            if (std::any_of(needle.begin(), needle.end(), [](char c) { return static_cast<UInt8>(c) > 0x7f; }))
+            {
+                std::string lowered_needle(needle.size(), '\0');
+                if (lowerUTF8PreservingLength(
+                    reinterpret_cast<const UInt8 *>(needle.data()), needle.size(), reinterpret_cast<UInt8 *>(lowered_needle.data())))
+                {
+                    PaddedPODArray<UInt8> lowered_haystack(haystack_data.size());
+                    if (lowerUTF8PreservingLength(haystack_data.data(), haystack_data.size(), lowered_haystack.data()))
+                    {
+                        typename Impl::PreloweredSearcherInBigHaystack lowered_searcher(
+                            lowered_needle.data(), lowered_needle.size(), lowered_haystack.size());
+                        searchBigHaystack(
+                            lowered_haystack.data(), lowered_haystack.data() + lowered_haystack.size(),
+                            haystack_offsets, needle.size(), start_pos, res, lowered_searcher);
+                        return;
+                    }
+                }
+            }
+        }
 
         typename Impl::SearcherInBigHaystack searcher = Impl::createSearcherInBigHaystack(needle.data(), needle.size(), end - pos);
+        searchBigHaystack(begin, end, haystack_offsets, needle.size(), start_pos, res, searcher);
+    }
+
+    /// Find the occurrences of one needle in a contiguous buffer of many strings.
+    template <typename Searcher>
+    static void searchBigHaystack(
+        const UInt8 * const begin,
+        const UInt8 * const end,
+        const ColumnString::Offsets & haystack_offsets,
+        size_t needle_size,
+        const ColumnPtr & start_pos,
+        PaddedPODArray<UInt64> & res,
+        Searcher & searcher)
+    {
+        const UInt8 * pos = begin;
+
+        /// Current index in the array of strings.
+        size_t i = 0;
 
         /// We will search for the next occurrence in all strings at once.
         while (pos < end && end != (pos = searcher.search(pos, end - pos)))
@@ -266,7 +394,7 @@ struct PositionImpl
             auto start = start_pos != nullptr ? start_pos->getUInt(i) : 0;
 
             /// We check that the entry does not pass through the boundaries of strings.
-            if (pos + needle.size() < begin + haystack_offsets[i])
+            if (pos + needle_size < begin + haystack_offsets[i])
             {
                 auto res_pos = 1 + Impl::countChars(reinterpret_cast<const char *>(begin + haystack_offsets[i - 1]), reinterpret_cast<const char *>(pos));
                 if (res_pos < start)
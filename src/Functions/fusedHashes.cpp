@@ -0,0 +1,179 @@
+#include "FunctionsHashing.h"
+
+#include <Functions/FunctionFactory.h>
+#include <Functions/fusedHashes.h>
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int BAD_ARGUMENTS;
+    extern const int ILLEGAL_COLUMN;
+    extern const int ILLEGAL_TYPE_OF_ARGUMENT;
+}
+
+namespace
+{
+
+using FusedHashApplyFunc = UInt64 (*)(const char *, size_t);
+
+template <typename Impl>
+UInt64 applyHashImpl(const char * data, size_t size)
+{
+    return Impl::apply(data, size);
+}
+
+FusedHashApplyFunc tryGetFusedHashFunction(const String & name)
+{
+    if (name == ImplCityHash64::name) return applyHashImpl<ImplCityHash64>;
+    if (name == SipHash64Impl::name) return applyHashImpl<SipHash64Impl>;
+    if (name == ImplFarmFingerprint64::name) return applyHashImpl<ImplFarmFingerprint64>;
+    if (name == ImplFarmHash64::name) return applyHashImpl<ImplFarmHash64>;
+    if (name == ImplMetroHash64::name) return applyHashImpl<ImplMetroHash64>;
+    if (name == ImplXxHash64::name) return applyHashImpl<ImplXxHash64>;
+    if (name == ImplXXH3::name) return applyHashImpl<ImplXXH3>;
+    if (name == ImplWyHash64::name) return applyHashImpl<ImplWyHash64>;
+    return nullptr;
+}
+
+/** fusedHashes(data, ['cityHash64', 'xxHash64', ...]) - compute several 64-bit hash functions
+  * of one String or FixedString argument in a single pass over the data and return a tuple
+  * with one UInt64 element per requested function.
+  *
+  * Each element is bit-identical to the result of the corresponding standalone function, so
+  * expressions computing several hashes of the same column (deduplication + sharding + sampling
+  * keys is the typical combination) can be rewritten to traverse the data once instead of once
+  * per function (see FuseHashFunctionsPass).
+  */
+class FunctionFusedHashes : public IFunction
+{
+public:
+    static constexpr auto name = "fusedHashes";
+
+    static FunctionPtr create(ContextPtr) { return std::make_shared<FunctionFusedHashes>(); }
+
+    String getName() const override { return name; }
+    size_t getNumberOfArguments() const override { return 2; }
+    ColumnNumbers getArgumentsThatAreAlwaysConstant() const override { return {1}; }
+    bool useDefaultImplementationForConstants() const override { return true; }
+    bool isSuitableForShortCircuitArgumentsExecution(const DataTypesWithConstInfo & /*arguments*/) const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const ColumnsWithTypeAndName & arguments) const override
+    {
+        if (!isStringOrFixedString(arguments[0].type))
+            throw Exception(ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+                "Illegal type {} of first argument of function {}", arguments[0].type->getName(), getName());
+
+        auto hash_functions = getHashFunctions(arguments[1]);
+        return std::make_shared<DataTypeTuple>(DataTypes(hash_functions.size(), std::make_shared<DataTypeUInt64>()));
+    }
+
+    ColumnPtr executeImpl(const ColumnsWithTypeAndName & arguments, const DataTypePtr &, size_t input_rows_count) const override
+    {
+        auto hash_functions = getHashFunctions(arguments[1]);
+        const size_t num_functions = hash_functions.size();
+
+        MutableColumns results(num_functions);
+        std::vector<ColumnUInt64::Container *> vec_to(num_functions);
+        for (size_t j = 0; j < num_functions; ++j)
+        {
+            auto col_to = ColumnUInt64::create(input_rows_count);
+            vec_to[j] = &col_to->getData();
+            results[j] = std::move(col_to);
+        }
+
+        const IColumn * column = arguments[0].column.get();
+
+        if (const ColumnString * col_from = checkAndGetColumn<ColumnString>(column))
+        {
+            const ColumnString::Chars & data = col_from->getChars();
+            const ColumnString::Offsets & offsets = col_from->getOffsets();
+
+            ColumnString::Offset current_offset = 0;
+            for (size_t i = 0; i < input_rows_count; ++i)
+            {
+                const char * value_data = reinterpret_cast<const char *>(&data[current_offset]);
+                const size_t value_size = offsets[i] - current_offset - 1;
+
+                for (size_t j = 0; j < num_functions; ++j)
+                    (*vec_to[j])[i] = hash_functions[j](value_data, value_size);
+
+                current_offset = offsets[i];
+            }
+        }
+        else if (const ColumnFixedString * col_from_fixed = checkAndGetColumn<ColumnFixedString>(column))
+        {
+            const ColumnString::Chars & data = col_from_fixed->getChars();
+            const size_t n = col_from_fixed->getN();
+
+            for (size_t i = 0; i < input_rows_count; ++i)
+            {
+                const char * value_data = reinterpret_cast<const char *>(&data[i * n]);
+
+                for (size_t j = 0; j < num_functions; ++j)
+                    (*vec_to[j])[i] = hash_functions[j](value_data, n);
+            }
+        }
+        else
+            throw Exception(ErrorCodes::ILLEGAL_COLUMN,
+                "Illegal column {} of first argument of function {}", column->getName(), getName());
+
+        return ColumnTuple::create(std::move(results));
+    }
+
+private:
+    std::vector<FusedHashApplyFunc> getHashFunctions(const ColumnWithTypeAndName & argument) const
+    {
+        const DataTypeArray * array_type = checkAndGetDataType<DataTypeArray>(argument.type.get());
+        if (!array_type || !checkAndGetDataType<DataTypeString>(array_type->getNestedType().get()))
+            throw Exception(ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+                "Illegal type {} of second argument of function {}", argument.type->getName(), getName());
+
+        const ColumnConst * column = checkAndGetColumnConst<ColumnArray>(argument.column.get());
+        if (!column)
+            throw Exception(ErrorCodes::ILLEGAL_COLUMN,
+                "Second argument of function {} must be a constant array of hash function names", getName());
+
+        Array function_names = column->getValue<Array>();
+        if (function_names.empty())
+            throw Exception(ErrorCodes::BAD_ARGUMENTS,
+                "Second argument of function {} must contain at least one hash function name", getName());
+
+        std::vector<FusedHashApplyFunc> hash_functions;
+        hash_functions.reserve(function_names.size());
+        for (const auto & function_name : function_names)
+        {
+            FusedHashApplyFunc hash_function = tryGetFusedHashFunction(function_name.get<String>());
+            if (!hash_function)
+                throw Exception(ErrorCodes::BAD_ARGUMENTS,
+                    "Function {} cannot be computed by function {}", function_name.get<String>(), getName());
+            hash_functions.push_back(hash_function);
+        }
+
+        return hash_functions;
+    }
+};
+
+}
+
+bool isFusableHashFunction(const String & name)
+{
+    return tryGetFusedHashFunction(name) != nullptr;
+}
+
+REGISTER_FUNCTION(FusedHashes)
+{
+    factory.registerFunction<FunctionFusedHashes>(FunctionDocumentation{
+        .description = "Computes several 64-bit hash functions of one String or FixedString argument in a single pass over the data "
+                       "and returns a tuple with one UInt64 element per requested function.",
+        .examples{{"hash", "SELECT fusedHashes('foo', ['cityHash64', 'xxHash64'])", ""}},
+        .categories{"Hash"}});
+}
+
+FunctionOverloadResolverPtr createInternalFusedHashesOverloadResolver()
+{
+    return std::make_unique<FunctionToOverloadResolverAdaptor>(std::make_shared<FunctionFusedHashes>());
+}
+
+}
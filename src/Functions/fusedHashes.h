@@ -0,0 +1,17 @@
+#pragma once
+#include <memory>
+
+#include <base/types.h>
+
+namespace DB
+{
+
+class IFunctionOverloadResolver;
+using FunctionOverloadResolverPtr = std::shared_ptr<IFunctionOverloadResolver>;
+
+/// Whether `name` is a hash function that fusedHashes can compute in its single pass over the data.
+bool isFusableHashFunction(const String & name);
+
+FunctionOverloadResolverPtr createInternalFusedHashesOverloadResolver();
+
+}
@@ -0,0 +1,246 @@
+#include <Functions/FunctionsJSON.h>
+
+#include <Functions/FunctionFactory.h>
+#include <Functions/fusedJSONExtract.h>
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int BAD_ARGUMENTS;
+    extern const int ILLEGAL_COLUMN;
+}
+
+namespace
+{
+
+/// The extraction functions fusedJSONExtract can evaluate. Only functions whose result is fully
+/// determined by the element a single key lookup moves to are listed here, so every tuple element
+/// is bit-identical to the corresponding standalone call.
+enum class FusedExtractKind : uint8_t
+{
+    Int,
+    UInt,
+    Float,
+    Bool,
+    String,
+    Raw,
+};
+
+std::optional<FusedExtractKind> tryGetFusedExtractKind(const String & name)
+{
+    if (name == NameJSONExtractInt::name)
+        return FusedExtractKind::Int;
+    if (name == NameJSONExtractUInt::name)
+        return FusedExtractKind::UInt;
+    if (name == NameJSONExtractFloat::name)
+        return FusedExtractKind::Float;
+    if (name == NameJSONExtractBool::name)
+        return FusedExtractKind::Bool;
+    if (name == NameJSONExtractString::name)
+        return FusedExtractKind::String;
+    if (name == NameJSONExtractRaw::name)
+        return FusedExtractKind::Raw;
+    return {};
+}
+
+DataTypePtr getFusedExtractReturnType(FusedExtractKind kind, const char * function_name, const ColumnsWithTypeAndName & arguments)
+{
+    switch (kind)
+    {
+        case FusedExtractKind::Int:
+            return JSONExtractInt64Impl<DummyJSONParser>::getReturnType(function_name, arguments);
+        case FusedExtractKind::UInt:
+            return JSONExtractUInt64Impl<DummyJSONParser>::getReturnType(function_name, arguments);
+        case FusedExtractKind::Float:
+            return JSONExtractFloat64Impl<DummyJSONParser>::getReturnType(function_name, arguments);
+        case FusedExtractKind::Bool:
+            return JSONExtractBoolImpl<DummyJSONParser>::getReturnType(function_name, arguments);
+        case FusedExtractKind::String:
+            return JSONExtractStringImpl<DummyJSONParser>::getReturnType(function_name, arguments);
+        case FusedExtractKind::Raw:
+            return JSONExtractRawImpl<DummyJSONParser>::getReturnType(function_name, arguments);
+    }
+}
+
+template <typename JSONParser>
+typename FunctionJSONHelpers::FusedExtractExecutor<JSONParser>::InsertResultToColumn getFusedExtractInserter(FusedExtractKind kind)
+{
+    switch (kind)
+    {
+        case FusedExtractKind::Int:
+            return &JSONExtractInt64Impl<JSONParser>::insertResultToColumn;
+        case FusedExtractKind::UInt:
+            return &JSONExtractUInt64Impl<JSONParser>::insertResultToColumn;
+        case FusedExtractKind::Float:
+            return &JSONExtractFloat64Impl<JSONParser>::insertResultToColumn;
+        case FusedExtractKind::Bool:
+            return &JSONExtractBoolImpl<JSONParser>::insertResultToColumn;
+        case FusedExtractKind::String:
+            return &JSONExtractStringImpl<JSONParser>::insertResultToColumn;
+        case FusedExtractKind::Raw:
+            return &JSONExtractRawImpl<JSONParser>::insertResultToColumn;
+    }
+}
+
+/** fusedJSONExtract(json, 'JSONExtractString', 'a', 'JSONExtractInt', 'b', ...) - parse each
+  * document once and evaluate several single-key extractions against it, returning a tuple with
+  * one element per (function name, key) pair.
+  *
+  * Each element is bit-identical to the result of the corresponding standalone call, e.g.
+  * JSONExtractString(json, 'a'), so expressions extracting several fields from one JSON column
+  * can be rewritten to parse every document once instead of once per field
+  * (see FuseJSONExtractPass).
+  */
+class FunctionFusedJSONExtract : public IFunction
+{
+public:
+    static constexpr auto name = "fusedJSONExtract";
+
+    static FunctionPtr create(ContextPtr context) { return std::make_shared<FunctionFusedJSONExtract>(context->getSettingsRef().allow_simdjson); }
+
+    explicit FunctionFusedJSONExtract(bool allow_simdjson_) : allow_simdjson(allow_simdjson_) {}
+
+    String getName() const override { return name; }
+    bool isVariadic() const override { return true; }
+    size_t getNumberOfArguments() const override { return 0; }
+    bool useDefaultImplementationForConstants() const override { return true; }
+    bool isSuitableForShortCircuitArgumentsExecution(const DataTypesWithConstInfo & /*arguments*/) const override { return true; }
+
+    DataTypePtr getReturnTypeImpl(const ColumnsWithTypeAndName & arguments) const override
+    {
+        if (arguments.size() < 3 || arguments.size() % 2 == 0)
+            throw Exception(ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH,
+                "Function {} requires a JSON argument followed by one or more pairs of extraction function name and key", getName());
+
+        if (!isString(arguments[0].type))
+            throw Exception(ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+                "The first argument of function {} should be a string containing JSON, illegal type: {}",
+                getName(), arguments[0].type->getName());
+
+        auto extractions = getExtractions(arguments);
+
+        DataTypes elements;
+        elements.reserve(extractions.size());
+        for (const auto & extraction : extractions)
+            elements.push_back(getFusedExtractReturnType(extraction.first, name, arguments));
+
+        return std::make_shared<DataTypeTuple>(elements);
+    }
+
+    ColumnPtr executeImpl(const ColumnsWithTypeAndName & arguments, const DataTypePtr & result_type, size_t input_rows_count) const override
+    {
+        const auto * col_json = checkAndGetColumn<ColumnString>(arguments[0].column.get());
+        if (!col_json)
+            throw Exception(ErrorCodes::ILLEGAL_COLUMN,
+                "Illegal column {} of first argument of function {}", arguments[0].column->getName(), getName());
+
+        auto extractions = getExtractions(arguments);
+
+#if USE_SIMDJSON
+        if (allow_simdjson)
+            return executeWithParser<SimdJSONParser>(*col_json, extractions, result_type, input_rows_count);
+#endif
+
+#if USE_RAPIDJSON
+        return executeWithParser<RapidJSONParser>(*col_json, extractions, result_type, input_rows_count);
+#else
+        return executeWithParser<DummyJSONParser>(*col_json, extractions, result_type, input_rows_count);
+#endif
+    }
+
+private:
+    using Extractions = std::vector<std::pair<FusedExtractKind, String>>;
+
+    Extractions getExtractions(const ColumnsWithTypeAndName & arguments) const
+    {
+        Extractions extractions;
+        extractions.reserve((arguments.size() - 1) / 2);
+
+        for (size_t i = 1; i + 1 < arguments.size(); i += 2)
+        {
+            extractions.emplace_back(
+                *tryGetFusedExtractKindFromArgument(arguments[i]),
+                getConstStringArgument(arguments[i + 1], "key"));
+        }
+
+        return extractions;
+    }
+
+    std::optional<FusedExtractKind> tryGetFusedExtractKindFromArgument(const ColumnWithTypeAndName & argument) const
+    {
+        auto function_name = getConstStringArgument(argument, "extraction function name");
+        auto kind = tryGetFusedExtractKind(function_name);
+        if (!kind)
+            throw Exception(ErrorCodes::BAD_ARGUMENTS,
+                "Function {} cannot be evaluated by function {}", function_name, getName());
+        return kind;
+    }
+
+    String getConstStringArgument(const ColumnWithTypeAndName & argument, const char * argument_description) const
+    {
+        if (!isString(argument.type))
+            throw Exception(ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+                "Argument '{}' of function {} should be a string, illegal type: {}",
+                argument_description, getName(), argument.type->getName());
+
+        const ColumnConst * column = checkAndGetColumnConst<ColumnString>(argument.column.get());
+        if (!column)
+            throw Exception(ErrorCodes::ILLEGAL_COLUMN,
+                "Argument '{}' of function {} must be a constant string", argument_description, getName());
+
+        return column->getValue<String>();
+    }
+
+    template <typename JSONParser>
+    ColumnPtr executeWithParser(const ColumnString & col_json, const Extractions & extractions, const DataTypePtr & result_type, size_t input_rows_count) const
+    {
+        std::vector<String> keys;
+        std::vector<typename FunctionJSONHelpers::FusedExtractExecutor<JSONParser>::InsertResultToColumn> inserters;
+        keys.reserve(extractions.size());
+        inserters.reserve(extractions.size());
+        for (const auto & extraction : extractions)
+        {
+            keys.push_back(extraction.second);
+            inserters.push_back(getFusedExtractInserter<JSONParser>(extraction.first));
+        }
+
+        const auto & element_types = assert_cast<const DataTypeTuple &>(*result_type).getElements();
+        MutableColumns results(extractions.size());
+        for (size_t j = 0; j < extractions.size(); ++j)
+        {
+            results[j] = element_types[j]->createColumn();
+            results[j]->reserve(input_rows_count);
+        }
+
+        FunctionJSONHelpers::FusedExtractExecutor<JSONParser>::run(col_json, keys, inserters, results, input_rows_count);
+
+        return ColumnTuple::create(std::move(results));
+    }
+
+    bool allow_simdjson;
+};
+
+}
+
+bool isFusableJSONExtractFunction(const String & name)
+{
+    return tryGetFusedExtractKind(name).has_value();
+}
+
+REGISTER_FUNCTION(FusedJSONExtract)
+{
+    factory.registerFunction<FunctionFusedJSONExtract>(FunctionDocumentation{
+        .description = "Parses each JSON document once and evaluates several single-key extractions against it, "
+                       "returning a tuple with one element per pair of extraction function name and key.",
+        .examples{{"extract", "SELECT fusedJSONExtract('{\"a\": \"hello\", \"b\": 1}', 'JSONExtractString', 'a', 'JSONExtractInt', 'b')", ""}},
+        .categories{"JSON"}});
+}
+
+FunctionOverloadResolverPtr createInternalFusedJSONExtractOverloadResolver(bool allow_simdjson)
+{
+    return std::make_unique<FunctionToOverloadResolverAdaptor>(std::make_shared<FunctionFusedJSONExtract>(allow_simdjson));
+}
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <memory>
+
+#include <base/types.h>
+
+namespace DB
+{
+
+class IFunctionOverloadResolver;
+using FunctionOverloadResolverPtr = std::shared_ptr<IFunctionOverloadResolver>;
+
+/// Whether `name` is a JSON extraction function that fusedJSONExtract can evaluate
+/// against a document parsed once.
+bool isFusableJSONExtractFunction(const String & name);
+
+FunctionOverloadResolverPtr createInternalFusedJSONExtractOverloadResolver(bool allow_simdjson);
+
+}
@@ -22,4 +22,9 @@ REGISTER_FUNCTION(MultiMatchAllIndices)
     factory.registerFunction<FunctionMultiMatchAllIndices>();
 }
 
+FunctionOverloadResolverPtr createInternalMultiMatchAllIndicesOverloadResolver(bool allow_hyperscan, size_t max_hyperscan_regexp_length, size_t max_hyperscan_regexp_total_length, bool reject_expensive_hyperscan_regexps)
+{
+    return std::make_unique<FunctionToOverloadResolverAdaptor>(std::make_shared<FunctionMultiMatchAllIndices>(allow_hyperscan, max_hyperscan_regexp_length, max_hyperscan_regexp_total_length, reject_expensive_hyperscan_regexps));
+}
+
 }
@@ -101,6 +101,9 @@ struct ReadSettings
     bool enable_filesystem_cache_log = false;
     size_t filesystem_cache_segments_batch_size = 20;
     size_t filesystem_cache_reserve_space_wait_lock_timeout_milliseconds = 1000;
+    /// Set for reads classified as scans: such reads do not increase the cache priority
+    /// of the segments they touch, so they cannot flush the hot working set.
+    bool filesystem_cache_scan_resistant_read = false;
 
     bool use_page_cache_for_disks_without_file_cache = false;
     bool read_from_page_cache_if_exists_otherwise_bypass_cache = false;
@@ -111,6 +114,8 @@ struct ReadSettings
     bool skip_download_if_exceeds_query_cache = true;
 
     size_t remote_read_min_bytes_for_seek = DBMS_DEFAULT_BUFFER_SIZE;
+    bool remote_read_adaptive_min_bytes_for_seek = true;
+    bool remote_read_adaptive_prefetch = true;
 
     FileCachePtr remote_fs_cache;
 
@@ -3,9 +3,12 @@
 namespace DB
 {
 template class CacheBase<UInt128, UncompressedCacheCell, UInt128TrivialHash, UncompressedSizeWeightFunction>;
+template class CacheBase<UInt128, CompressedFrameCell, UInt128TrivialHash, CompressedFrameWeightFunction>;
 
-UncompressedCache::UncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio)
+UncompressedCache::UncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio, size_t compressed_frames_max_size_in_bytes)
     : Base(cache_policy, max_size_in_bytes, 0, size_ratio)
 {
+    if (compressed_frames_max_size_in_bytes)
+        compressed_frames = std::make_unique<CompressedFrameCache>(cache_policy, compressed_frames_max_size_in_bytes, 0, size_ratio);
 }
 }
@@ -12,6 +12,8 @@ namespace ProfileEvents
     extern const Event UncompressedCacheHits;
     extern const Event UncompressedCacheMisses;
     extern const Event UncompressedCacheWeightLost;
+    extern const Event CompressedFrameCacheHits;
+    extern const Event CompressedFrameCacheMisses;
 }
 
 namespace DB
@@ -33,17 +35,41 @@ struct UncompressedSizeWeightFunction
     }
 };
 
+/// Entry of the optional second tier: the compressed frame of a block as it is stored on disk
+/// (without the checksum), so it is several times denser than the decompressed first tier.
+struct CompressedFrameCell
+{
+    Memory<> data;
+    size_t compressed_size;
+};
+
+struct CompressedFrameWeightFunction
+{
+    size_t operator()(const CompressedFrameCell & x) const
+    {
+        return x.data.size();
+    }
+};
+
 extern template class CacheBase<UInt128, UncompressedCacheCell, UInt128TrivialHash, UncompressedSizeWeightFunction>;
+extern template class CacheBase<UInt128, CompressedFrameCell, UInt128TrivialHash, CompressedFrameWeightFunction>;
 
 /** Cache of decompressed blocks for implementation of CachedCompressedReadBuffer. thread-safe.
+  *
+  * Optionally has a second tier that keeps blocks compressed in memory: when a decompressed block is
+  * evicted from the first tier but its compressed frame is still in the second one, a later read of
+  * the same (file, offset) is served by decompressing from RAM instead of going back to disk.
   */
 class UncompressedCache : public CacheBase<UInt128, UncompressedCacheCell, UInt128TrivialHash, UncompressedSizeWeightFunction>
 {
 private:
     using Base = CacheBase<UInt128, UncompressedCacheCell, UInt128TrivialHash, UncompressedSizeWeightFunction>;
+    using CompressedFrameCache = CacheBase<UInt128, CompressedFrameCell, UInt128TrivialHash, CompressedFrameWeightFunction>;
 
 public:
-    UncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio);
+    using CompressedFrameCellPtr = std::shared_ptr<CompressedFrameCell>;
+
+    UncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio, size_t compressed_frames_max_size_in_bytes = 0);
 
     /// Calculate key from path to file and offset.
     static UInt128 hash(const String & path_to_file, size_t offset)
@@ -68,11 +94,44 @@ public:
         return result.first;
     }
 
+    bool hasCompressedFrameTier() const { return compressed_frames != nullptr; }
+
+    CompressedFrameCellPtr getCompressedFrame(const Key & key)
+    {
+        if (!compressed_frames)
+            return nullptr;
+
+        auto cell = compressed_frames->get(key);
+
+        if (cell)
+            ProfileEvents::increment(ProfileEvents::CompressedFrameCacheHits);
+        else
+            ProfileEvents::increment(ProfileEvents::CompressedFrameCacheMisses);
+
+        return cell;
+    }
+
+    void setCompressedFrame(const Key & key, CompressedFrameCellPtr cell)
+    {
+        if (compressed_frames)
+            compressed_frames->set(key, std::move(cell));
+    }
+
+    void clear()
+    {
+        Base::clear();
+        if (compressed_frames)
+            compressed_frames->clear();
+    }
+
 private:
     void onRemoveOverflowWeightLoss(size_t weight_loss) override
     {
         ProfileEvents::increment(ProfileEvents::UncompressedCacheWeightLost, weight_loss);
     }
+
+    /// Second tier, disabled unless compressed_block_cache_size is set in the server config.
+    std::unique_ptr<CompressedFrameCache> compressed_frames;
 };
 
 using UncompressedCachePtr = std::shared_ptr<UncompressedCache>;
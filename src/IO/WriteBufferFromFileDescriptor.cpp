@@ -1,4 +1,5 @@
 #include <unistd.h>
+#include <fcntl.h>
 #include <cerrno>
 #include <cassert>
 #include <sys/stat.h>
@@ -83,6 +84,30 @@ void WriteBufferFromFileDescriptor::nextImpl()
 
     ProfileEvents::increment(ProfileEvents::DiskWriteElapsedMicroseconds, watch.elapsedMicroseconds());
     ProfileEvents::increment(ProfileEvents::WriteBufferFromFileDescriptorWriteBytes, bytes_written);
+
+#if defined(OS_LINUX)
+    if (evict_written_data_from_page_cache)
+    {
+        /// Once a window of data is accumulated, start its writeback asynchronously and evict the
+        /// previous window, whose writeback was requested last time and is likely complete by now.
+        /// Both calls are best-effort hints, so errors are deliberately ignored.
+        static constexpr size_t eviction_window = 4 * 1024 * 1024;
+
+        total_bytes_written += bytes_written;
+        if (total_bytes_written - writeback_up_to >= eviction_window)
+        {
+            ::sync_file_range(fd, writeback_up_to, total_bytes_written - writeback_up_to, SYNC_FILE_RANGE_WRITE);
+
+            if (writeback_up_to > evicted_up_to)
+            {
+                ::posix_fadvise(fd, evicted_up_to, writeback_up_to - evicted_up_to, POSIX_FADV_DONTNEED);
+                evicted_up_to = writeback_up_to;
+            }
+
+            writeback_up_to = total_bytes_written;
+        }
+    }
+#endif
 }
 
 /// NOTE: This class can be used as a very low-level building block, for example
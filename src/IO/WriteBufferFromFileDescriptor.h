@@ -47,6 +47,14 @@ public:
 
     off_t size() const;
 
+    /// Periodically start writeback of written data and evict it from the OS page cache.
+    /// For bulk sequential writes (e.g. merges) that should not displace hot data of concurrent queries.
+    /// Assumes the file is written sequentially from the beginning, without seeks.
+    void setEvictWrittenDataFromPageCache()
+    {
+        evict_written_data_from_page_cache = true;
+    }
+
 protected:
     void nextImpl() override;
 
@@ -57,6 +65,15 @@ protected:
     std::string file_name;
 
     void finalizeImpl() override;
+
+private:
+    bool evict_written_data_from_page_cache = false;
+
+    /// Bookkeeping for page cache eviction: [0, evicted_up_to) has been dropped from the cache,
+    /// [evicted_up_to, writeback_up_to) has writeback in progress, the rest is not yet flushed.
+    size_t total_bytes_written = 0;
+    size_t writeback_up_to = 0;
+    size_t evicted_up_to = 0;
 };
 
 }
@@ -25,6 +25,9 @@ struct WriteSettings
     bool s3_allow_parallel_part_upload = true;
     bool azure_allow_parallel_part_upload = true;
 
+    /// Evict written data from the OS page cache as the write progresses. Only affects local disks.
+    bool evict_written_data_from_page_cache = false;
+
     bool operator==(const WriteSettings & other) const = default;
 };
 
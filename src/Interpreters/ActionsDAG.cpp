@@ -19,7 +19,9 @@
 
 #include <stack>
 #include <base/sort.h>
+#include <Common/FieldVisitorToString.h>
 #include <Common/JSONBuilder.h>
+#include <Common/SipHash.h>
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/inlined_vector.h>
@@ -1328,6 +1330,44 @@ std::string ActionsDAG::dumpDAG() const
     return out.str();
 }
 
+void ActionsDAG::updateHash(SipHash & hash) const
+{
+    std::unordered_map<const Node *, size_t> map;
+    for (const auto & node : nodes)
+    {
+        size_t idx = map.size();
+        map[&node] = idx;
+    }
+
+    hash.update(nodes.size());
+    for (const auto & node : nodes)
+    {
+        hash.update(node.type);
+        hash.update(node.result_name);
+        hash.update(node.result_type ? node.result_type->getName() : "");
+        hash.update(node.function_base ? node.function_base->getName() : "");
+
+        hash.update(node.children.size());
+        for (const auto * child : node.children)
+            hash.update(map.at(child));
+
+        hash.update(node.column != nullptr);
+        if (node.column)
+        {
+            /// The value of a constant is a part of the fingerprint, not only its type and name.
+            if (isColumnConst(*node.column))
+                hash.update(applyVisitor(FieldVisitorToString(), (*node.column)[0]));
+            else
+                for (size_t i = 0; i < node.column->size(); ++i)
+                    node.column->updateHashWithValue(i, hash);
+        }
+    }
+
+    hash.update(outputs.size());
+    for (const auto * node : outputs)
+        hash.update(map.at(node));
+}
+
 bool ActionsDAG::hasArrayJoin() const
 {
     for (const auto & node : nodes)
@@ -8,6 +8,8 @@
 
 #include "config.h"
 
+class SipHash;
+
 namespace DB
 {
 
@@ -260,6 +262,13 @@ public:
     void assertDeterministic() const; /// Throw if not isDeterministic.
     bool hasNonDeterministic() const;
 
+    /// Update the hash with a fingerprint of the DAG: its structure and the values of constant
+    /// columns. Unlike a hash of dumpDAG(), it distinguishes folded constants whose result name
+    /// does not reflect the value (e.g. `now()` keeps its name while the value changes between
+    /// queries), so it is suitable as a part of a cache key. Callers that cache results across
+    /// queries must additionally reject DAGs with hasNonDeterministic().
+    void updateHash(SipHash & hash) const;
+
 #if USE_EMBEDDED_COMPILER
     void compileExpressions(size_t min_count_to_compile_expression, const std::unordered_set<const Node *> & lazy_executed_nodes = {});
 #endif
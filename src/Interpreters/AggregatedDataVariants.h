@@ -57,6 +57,7 @@ struct AggregatedDataVariants : private boost::noncopyable
 
     std::unique_ptr<AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt64Key>>         key32;
     std::unique_ptr<AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64Key>>         key64;
+    std::unique_ptr<AggregationMethodOneNumber<UInt128, AggregatedDataWithKeys128>>         key128;
     std::unique_ptr<AggregationMethodStringNoCache<AggregatedDataWithShortStringKey>>               key_string;
     std::unique_ptr<AggregationMethodFixedStringNoCache<AggregatedDataWithShortStringKey>>          key_fixed_string;
     std::unique_ptr<AggregationMethodKeysFixed<AggregatedDataWithUInt16Key, false, false, false>>  keys16;
@@ -71,6 +72,7 @@ struct AggregatedDataVariants : private boost::noncopyable
 
     std::unique_ptr<AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt64KeyTwoLevel>> key32_two_level;
     std::unique_ptr<AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>> key64_two_level;
+    std::unique_ptr<AggregationMethodOneNumber<UInt128, AggregatedDataWithKeys128TwoLevel>> key128_two_level;
     std::unique_ptr<AggregationMethodStringNoCache<AggregatedDataWithShortStringKeyTwoLevel>>       key_string_two_level;
     std::unique_ptr<AggregationMethodFixedStringNoCache<AggregatedDataWithShortStringKeyTwoLevel>>  key_fixed_string_two_level;
     std::unique_ptr<AggregationMethodKeysFixed<AggregatedDataWithUInt32KeyTwoLevel>>           keys32_two_level;
@@ -134,6 +136,7 @@ struct AggregatedDataVariants : private boost::noncopyable
         M(key16,                      false) \
         M(key32,                      false) \
         M(key64,                      false) \
+        M(key128,                     false) \
         M(key_string,                 false) \
         M(key_fixed_string,           false) \
         M(keys16,                    false) \
@@ -147,6 +150,7 @@ struct AggregatedDataVariants : private boost::noncopyable
         M(nullable_prealloc_serialized, false) \
         M(key32_two_level,            true) \
         M(key64_two_level,            true) \
+        M(key128_two_level,           true) \
         M(key_string_two_level,       true) \
         M(key_fixed_string_two_level, true) \
         M(keys32_two_level,          true) \
@@ -198,6 +202,7 @@ struct AggregatedDataVariants : private boost::noncopyable
     #define APPLY_FOR_VARIANTS_CONVERTIBLE_TO_TWO_LEVEL(M) \
         M(key32)            \
         M(key64)            \
+        M(key128)           \
         M(key_string)       \
         M(key_fixed_string) \
         M(keys32)           \
@@ -249,6 +254,7 @@ struct AggregatedDataVariants : private boost::noncopyable
     #define APPLY_FOR_VARIANTS_TWO_LEVEL(M) \
         M(key32_two_level)            \
         M(key64_two_level)            \
+        M(key128_two_level)           \
         M(key_string_two_level)       \
         M(key_fixed_string_two_level) \
         M(keys32_two_level)           \
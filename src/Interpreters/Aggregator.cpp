@@ -491,6 +491,11 @@ Aggregator::Aggregator(const Block & header_, const Params & params_)
         if (auto * memory_tracker = memory_tracker_child->getParent())
             memory_usage_before_aggregation = memory_tracker->get();
 
+    /// Spilling the hash table implies an extra merge pass later, so aggregations are
+    /// more expensive victims than sorts (priority 1).
+    if (tmp_data)
+        spill_participant = SpillManager::instance().enroll(/* priority */ 2);
+
     aggregate_functions.resize(params.aggregates_size);
     for (size_t i = 0; i < params.aggregates_size; ++i)
         aggregate_functions[i] = params.aggregates[i].function.get();
@@ -747,8 +752,11 @@ AggregatedDataVariants::Type Aggregator::chooseAggregationMethod()
 
     /// No key has been found to be nullable.
 
-    /// Single numeric key.
-    if (params.keys_size == 1 && types_removed_nullable[0]->isValueRepresentedByNumber())
+    /// Single numeric key. UUID and IPv6 are not "represented by number", but they are
+    /// stored in ColumnVector as well, so their values can be used as hash table keys directly.
+    if (params.keys_size == 1
+        && (types_removed_nullable[0]->isValueRepresentedByNumber() || isUUID(types_removed_nullable[0])
+            || isIPv6(types_removed_nullable[0])))
     {
         size_t size_of_field = types_removed_nullable[0]->getSizeOfValueInMemory();
 
@@ -777,8 +785,11 @@ AggregatedDataVariants::Type Aggregator::chooseAggregationMethod()
             return AggregatedDataVariants::Type::key32;
         if (size_of_field == 8)
             return AggregatedDataVariants::Type::key64;
+        /// Note: key128 partitions keys into two-level buckets exactly as keys128 did
+        /// (the same 16 bytes of the key hashed with the same CRC32-based function),
+        /// so distributed two-level merge stays compatible with older servers.
         if (size_of_field == 16)
-            return AggregatedDataVariants::Type::keys128;
+            return AggregatedDataVariants::Type::key128;
         if (size_of_field == 32)
             return AggregatedDataVariants::Type::keys256;
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Numeric column has sizeOfField not in 1, 2, 4, 8, 16, 32.");
@@ -793,6 +804,8 @@ AggregatedDataVariants::Type Aggregator::chooseAggregationMethod()
     }
 
     /// If all keys fits in N bits, will use hash table with all keys packed (placed contiguously) to single N-bit key.
+    /// Note: key8, key16 (above) and keys16 are not really hash tables: FixedHashMap is a directly indexed
+    /// array of 2^8 or 2^16 slots, so aggregation by small integer keys does no hashing or collision checks.
     if (params.keys_size == num_fixed_contiguous_keys)
     {
         if (has_low_cardinality)
@@ -1214,6 +1227,19 @@ void NO_INLINE Aggregator::executeImplBatch(
         for (size_t i = key_start; i < key_end; ++i)
         {
             AggregateDataPtr aggregate_data = nullptr;
+
+            if constexpr (prefetch && HasPrefetchMemberFunc<decltype(method.data), KeyHolder>)
+            {
+                if (i == key_start + PrefetchingHelper::iterationsToMeasure())
+                    prefetch_look_ahead = prefetching.calcPrefetchLookAhead();
+
+                if (i + prefetch_look_ahead < row_end)
+                {
+                    auto && key_holder = state.getKeyHolder(i + prefetch_look_ahead, *aggregates_pool);
+                    method.data.prefetch(std::move(key_holder));
+                }
+            }
+
             /// Add only if the key already exists.
             auto find_result = state.findKey(method.data, i, *aggregates_pool);
             if (find_result.isFound())
@@ -1645,16 +1671,24 @@ bool Aggregator::executeOnBlock(Columns columns,
     if (!checkLimits(result_size, no_more_keys))
         return false;
 
+    if (spill_participant)
+        spill_participant->setReclaimableBytes(result_size_bytes);
+
     /** Flush data to disk if too much RAM is consumed.
       * Data can only be flushed to disk if a two-level aggregation structure is used.
+      * Besides the per-operator threshold, the server-wide spill manager may pick
+      * this aggregation as a victim under memory pressure.
       */
-    if (params.max_bytes_before_external_group_by
-        && result.isTwoLevel()
-        && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by)
-        && worth_convert_to_two_level)
+    if (result.isTwoLevel()
+        && worth_convert_to_two_level
+        && ((params.max_bytes_before_external_group_by
+                && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by))
+            || (spill_participant && spill_participant->shouldSpill())))
     {
         size_t size = current_memory_usage + params.min_free_disk_space;
         writeToTemporaryFile(result, size);
+        if (spill_participant)
+            spill_participant->setReclaimableBytes(0);
     }
 
     return true;
@@ -1669,16 +1703,27 @@ void Aggregator::writeToTemporaryFile(AggregatedDataVariants & data_variants, si
     Stopwatch watch;
     size_t rows = data_variants.size();
 
-    auto & out_stream = tmp_data->createStream(getHeader(false), max_temp_file_size);
+    /// Each spilled part is split into several independently compressed streams, each covering
+    /// a contiguous range of two-level buckets. Blocks inside a stream are written in bucket order,
+    /// so the memory efficient merge can consume them per-bucket, and separate streams can be read
+    /// by separate threads without coordination.
+    size_t num_spill_streams = std::clamp<size_t>(params.max_threads, 1, 16);
+
+    std::vector<TemporaryFileStream *> out_streams;
+    out_streams.reserve(num_spill_streams);
+    for (size_t i = 0; i < num_spill_streams; ++i)
+        out_streams.push_back(&tmp_data->createStream(getHeader(false), max_temp_file_size));
+
     ProfileEvents::increment(ProfileEvents::ExternalAggregationWritePart);
 
-    LOG_DEBUG(log, "Writing part of aggregation data into temporary file {}", out_stream.getPath());
+    LOG_DEBUG(log, "Writing part of aggregation data into {} temporary files, first is {}",
+        out_streams.size(), out_streams.front()->getPath());
 
     /// Flush only two-level data and possibly overflow data.
 
 #define M(NAME) \
     else if (data_variants.type == AggregatedDataVariants::Type::NAME) \
-        writeToTemporaryFileImpl(data_variants, *data_variants.NAME, out_stream);
+        writeToTemporaryFileImpl(data_variants, *data_variants.NAME, out_streams);
 
     if (false) {} // NOLINT
     APPLY_FOR_VARIANTS_TWO_LEVEL(M)
@@ -1697,16 +1742,23 @@ void Aggregator::writeToTemporaryFile(AggregatedDataVariants & data_variants, si
         data_variants.without_key = place;
     }
 
-    auto stat = out_stream.finishWriting();
+    size_t sum_compressed_size = 0;
+    size_t sum_uncompressed_size = 0;
+    for (auto * out_stream : out_streams)
+    {
+        auto stat = out_stream->finishWriting();
+        sum_compressed_size += stat.compressed_size;
+        sum_uncompressed_size += stat.uncompressed_size;
+    }
 
-    ProfileEvents::increment(ProfileEvents::ExternalAggregationCompressedBytes, stat.compressed_size);
-    ProfileEvents::increment(ProfileEvents::ExternalAggregationUncompressedBytes, stat.uncompressed_size);
-    ProfileEvents::increment(ProfileEvents::ExternalProcessingCompressedBytesTotal, stat.compressed_size);
-    ProfileEvents::increment(ProfileEvents::ExternalProcessingUncompressedBytesTotal, stat.uncompressed_size);
+    ProfileEvents::increment(ProfileEvents::ExternalAggregationCompressedBytes, sum_compressed_size);
+    ProfileEvents::increment(ProfileEvents::ExternalAggregationUncompressedBytes, sum_uncompressed_size);
+    ProfileEvents::increment(ProfileEvents::ExternalProcessingCompressedBytesTotal, sum_compressed_size);
+    ProfileEvents::increment(ProfileEvents::ExternalProcessingUncompressedBytesTotal, sum_uncompressed_size);
 
     double elapsed_seconds = watch.elapsedSeconds();
-    double compressed_size = stat.compressed_size;
-    double uncompressed_size = stat.uncompressed_size;
+    double compressed_size = sum_compressed_size;
+    double uncompressed_size = sum_uncompressed_size;
     LOG_DEBUG(log,
         "Written part in {:.3f} sec., {} rows, {} uncompressed, {} compressed,"
         " {:.3f} uncompressed bytes per row, {:.3f} compressed bytes per row, compression rate: {:.3f}"
@@ -1793,7 +1845,7 @@ template <typename Method>
 void Aggregator::writeToTemporaryFileImpl(
     AggregatedDataVariants & data_variants,
     Method & method,
-    TemporaryFileStream & out) const
+    std::vector<TemporaryFileStream *> & out_streams) const
 {
     size_t max_temporary_block_size_rows = 0;
     size_t max_temporary_block_size_bytes = 0;
@@ -1810,14 +1862,15 @@ void Aggregator::writeToTemporaryFileImpl(
     for (UInt32 bucket = 0; bucket < Method::Data::NUM_BUCKETS; ++bucket)
     {
         Block block = convertOneBucketToBlock(data_variants, method, data_variants.aggregates_pool, false, bucket);
-        out.write(block);
+        /// Contiguous bucket ranges go to the same stream, so each stream is a run sorted by bucket.
+        out_streams[bucket * out_streams.size() / Method::Data::NUM_BUCKETS]->write(block);
         update_max_sizes(block);
     }
 
     if (params.overflow_row)
     {
         Block block = prepareBlockAndFillWithoutKey(data_variants, false, true);
-        out.write(block);
+        out_streams.front()->write(block);
         update_max_sizes(block);
     }
 
@@ -3056,16 +3109,24 @@ bool Aggregator::mergeOnBlock(Block block, AggregatedDataVariants & result, bool
     if (!checkLimits(result_size, no_more_keys))
         return false;
 
+    if (spill_participant)
+        spill_participant->setReclaimableBytes(result_size_bytes);
+
     /** Flush data to disk if too much RAM is consumed.
       * Data can only be flushed to disk if a two-level aggregation structure is used.
+      * Besides the per-operator threshold, the server-wide spill manager may pick
+      * this aggregation as a victim under memory pressure.
       */
-    if (params.max_bytes_before_external_group_by
-        && result.isTwoLevel()
-        && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by)
-        && worth_convert_to_two_level)
+    if (result.isTwoLevel()
+        && worth_convert_to_two_level
+        && ((params.max_bytes_before_external_group_by
+                && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by))
+            || (spill_participant && spill_participant->shouldSpill())))
     {
         size_t size = current_memory_usage + params.min_free_disk_space;
         writeToTemporaryFile(result, size);
+        if (spill_participant)
+            spill_participant->setReclaimableBytes(0);
     }
 
     return true;
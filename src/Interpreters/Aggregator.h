@@ -16,6 +16,7 @@
 
 #include <Common/ThreadPool.h>
 #include <Common/ColumnsHashing.h>
+#include <Common/SpillManager.h>
 #include <Common/assert_cast.h>
 #include <Common/filesystemHelpers.h>
 #include <Core/ColumnNumbers.h>
@@ -362,6 +363,10 @@ private:
     /// For external aggregation.
     TemporaryDataOnDiskPtr tmp_data;
 
+    /// Lets the server-wide spill manager pick this aggregation as a spill victim
+    /// under memory pressure. Only set when external aggregation is possible.
+    SpillManager::ParticipantPtr spill_participant;
+
     size_t min_bytes_for_prefetch = 0;
 
 #if USE_EMBEDDED_COMPILER
@@ -461,7 +466,7 @@ private:
     void writeToTemporaryFileImpl(
         AggregatedDataVariants & data_variants,
         Method & method,
-        TemporaryFileStream & out) const;
+        std::vector<TemporaryFileStream *> & out_streams) const;
 
     /// Merge NULL key data from hash table `src` into `dst`.
     template <typename Method, typename Table>
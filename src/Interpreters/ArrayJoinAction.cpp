@@ -189,6 +189,12 @@ Block ArrayJoinResultIterator::next()
     size_t max_block_size = array_join->max_block_size;
     const auto & offsets = any_array->getOffsets();
 
+    /// A single row with large arrays would produce one block of the size of the arrays regardless
+    /// of max_block_size. Expand such a row into bounded pieces so that the downstream steps never
+    /// see (and the transform never materializes) the fully replicated block at once.
+    if (current_row_expanded > 0 || offsets[current_row] - offsets[current_row - 1] > max_block_size)
+        return nextPartOfCurrentRow();
+
     /// Make sure output block rows do not exceed max_block_size.
     size_t next_row = current_row;
     for (; next_row < total_rows; ++next_row)
@@ -261,4 +267,69 @@ Block ArrayJoinResultIterator::next()
     return res;
 }
 
+Block ArrayJoinResultIterator::nextPartOfCurrentRow()
+{
+    size_t max_block_size = array_join->max_block_size;
+    const auto & offsets = any_array->getOffsets();
+
+    size_t row_element_begin = offsets[current_row - 1] + current_row_expanded;
+    size_t num_elements = std::min<size_t>(max_block_size, offsets[current_row] - row_element_begin);
+
+    Block res;
+    size_t num_columns = block.columns();
+    const auto & columns = array_join->columns;
+    bool is_unaligned = array_join->is_unaligned;
+    bool is_left = array_join->is_left;
+
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        ColumnWithTypeAndName current = block.safeGetByPosition(i);
+
+        if (columns.contains(current.name))
+        {
+            if (const auto & type = getArrayJoinDataType(current.type))
+            {
+                ColumnPtr array_ptr;
+                if (typeid_cast<const DataTypeArray *>(current.type.get()))
+                {
+                    array_ptr = (is_left && !is_unaligned) ? non_empty_array_columns[current.name] : current.column;
+                    array_ptr = array_ptr->convertToFullColumnIfConst();
+                }
+                else
+                {
+                    ColumnPtr map_ptr = current.column->convertToFullColumnIfConst();
+                    const ColumnMap & map = typeid_cast<const ColumnMap &>(*map_ptr);
+                    array_ptr = (is_left && !is_unaligned) ? non_empty_array_columns[current.name] : map.getNestedColumnPtr();
+                }
+
+                const ColumnArray & array = typeid_cast<const ColumnArray &>(*array_ptr);
+                if (!is_unaligned && !array.hasEqualOffsets(*any_array))
+                    throw Exception(ErrorCodes::SIZES_OF_ARRAYS_DONT_MATCH, "Sizes of ARRAY-JOIN-ed arrays do not match");
+
+                /// Take only a piece of the data of the arrays of the current row.
+                current.column = array.getDataPtr()->cut(row_element_begin, num_elements);
+                current.type = type->getNestedType();
+            }
+            else
+                throw Exception(ErrorCodes::TYPE_MISMATCH, "ARRAY JOIN of not array nor map: {}", current.name);
+        }
+        else
+        {
+            IColumn::Offsets replicate_offsets{num_elements};
+            current.column = current.column->cut(current_row, 1)->replicate(replicate_offsets);
+        }
+
+        res.insert(std::move(current));
+    }
+
+    current_row_expanded += num_elements;
+    if (row_element_begin + num_elements == offsets[current_row])
+    {
+        current_row_expanded = 0;
+        ++current_row;
+    }
+
+    return res;
+}
+
 }
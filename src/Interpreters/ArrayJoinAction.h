@@ -57,6 +57,9 @@ public:
     bool hasNext() const;
 
 private:
+    /// Expand the next at most max_block_size elements of the arrays of the current row.
+    Block nextPartOfCurrentRow();
+
     const ArrayJoinAction * array_join;
     Block block;
 
@@ -67,5 +70,8 @@ private:
 
     size_t total_rows;
     size_t current_row;
+    /// Number of array elements of the current row already returned.
+    /// Non-zero while a row with large arrays is being expanded in parts.
+    size_t current_row_expanded = 0;
 };
 }
@@ -27,6 +27,7 @@
 #include <QueryPipeline/Pipe.h>
 #include <QueryPipeline/QueryPipeline.h>
 #include <Storages/IStorage.h>
+#include <Storages/MergeTree/MergeTreeData.h>
 #include <Common/CurrentThread.h>
 #include <Common/DateLUT.h>
 #include <Common/FieldVisitorHash.h>
@@ -382,6 +383,14 @@ AsynchronousInsertQueue::pushDataChunk(ASTPtr query, DataChunk chunk, ContextPtr
     /// in INSERT query. Replace it to put all such queries into one bucket in queue.
     if (data_kind == DataKind::Preprocessed)
         insert_query.format = "Native";
+    /// Each entry keeps its own format, so inserts that differ only in format
+    /// can share one bucket in the queue and be flushed as a single insert.
+    else if (settings.async_insert_merge_formats)
+        insert_query.format.clear();
+
+    double merge_backlog_ratio = 0.0;
+    if (settings.async_insert_busy_timeout_use_merge_backlog)
+        merge_backlog_ratio = getMergeBacklogRatio(insert_query, query_context);
 
     InsertQuery key{query, query_context->getUserID(), query_context->getCurrentRoles(), settings, data_kind};
     InsertDataPtr data_to_process;
@@ -408,7 +417,22 @@ AsynchronousInsertQueue::pushDataChunk(ASTPtr query, DataChunk chunk, ContextPtr
         }
 
         if (inserted)
-            it->second = shard.queue.emplace(now + timeout_ms, Container{key, std::make_unique<InsertData>(timeout_ms)}).first;
+        {
+            /// Stretch the timeout for this batch towards the maximum proportionally to the
+            /// parts backlog of the destination table: the longer we collect data, the fewer
+            /// parts are created while merges are catching up. The per-shard adaptive timeout
+            /// is left intact, so the stretching does not outlive the backlog.
+            auto data_timeout_ms = timeout_ms;
+            if (merge_backlog_ratio > 0.0)
+            {
+                const auto max_ms = Milliseconds(settings.async_insert_busy_timeout_max_ms);
+                if (timeout_ms < max_ms)
+                    data_timeout_ms = std::min(max_ms,
+                        timeout_ms + std::chrono::duration_cast<Milliseconds>((max_ms - timeout_ms) * merge_backlog_ratio));
+            }
+
+            it->second = shard.queue.emplace(now + data_timeout_ms, Container{key, std::make_unique<InsertData>(data_timeout_ms)}).first;
+        }
 
         auto queue_it = it->second;
         auto & data = queue_it->second.data;
@@ -526,6 +550,24 @@ AsynchronousInsertQueue::Milliseconds AsynchronousInsertQueue::getBusyWaitTimeou
     return normalize(shard.busy_timeout_ms);
 }
 
+double AsynchronousInsertQueue::getMergeBacklogRatio(const ASTInsertQuery & insert_query, const ContextPtr & query_context) const
+{
+    if (!insert_query.table_id)
+        return 0.0;
+
+    auto table = DatabaseCatalog::instance().tryGetTable(insert_query.table_id, query_context);
+    const auto * merge_tree = dynamic_cast<const MergeTreeData *>(table.get());
+    if (!merge_tree)
+        return 0.0;
+
+    size_t parts_to_delay = merge_tree->getSettings()->parts_to_delay_insert;
+    if (!parts_to_delay)
+        return 0.0;
+
+    auto [parts_count_in_partition, _] = merge_tree->getMaxPartsCountAndSizeForPartition();
+    return std::min(1.0, static_cast<double>(parts_count_in_partition) / parts_to_delay);
+}
+
 void AsynchronousInsertQueue::validateSettings(const Settings & settings, LoggerPtr log)
 {
     const auto max_ms = std::chrono::milliseconds(settings.async_insert_busy_timeout_max_ms);
@@ -941,20 +983,22 @@ Chunk AsynchronousInsertQueue::processEntriesWithParsing(
     LogFunc && add_to_async_insert_log)
 {
     size_t total_rows = 0;
+    size_t rows_in_current_format = 0;
     InsertData::EntryPtr current_entry;
     String current_exception;
 
     const auto & insert_query = assert_cast<const ASTInsertQuery &>(*key.query);
-    auto format = getInputFormatFromASTInsertQuery(key.query, false, header, insert_context, nullptr);
-    std::shared_ptr<ISimpleTransform> adding_defaults_transform;
+
+    StorageMetadataPtr metadata_snapshot;
+    const ColumnsDescription * columns_with_defaults = nullptr;
 
     if (insert_context->getSettingsRef().input_format_defaults_for_omitted_fields && insert_query.table_id)
     {
         StoragePtr storage = DatabaseCatalog::instance().getTable(insert_query.table_id, insert_context);
-        auto metadata_snapshot = storage->getInMemoryMetadataPtr();
+        metadata_snapshot = storage->getInMemoryMetadataPtr();
         const auto & columns = metadata_snapshot->getColumns();
         if (columns.hasDefaults())
-            adding_defaults_transform = std::make_shared<AddingDefaultsTransform>(header, columns, *format, insert_context);
+            columns_with_defaults = &columns;
     }
 
     auto on_error = [&](const MutableColumns & result_columns, Exception & e)
@@ -964,42 +1008,87 @@ Chunk AsynchronousInsertQueue::processEntriesWithParsing(
             key.query_str, current_entry->query_id, current_exception);
 
         for (const auto & column : result_columns)
-            if (column->size() > total_rows)
-                column->popBack(column->size() - total_rows);
+            if (column->size() > rows_in_current_format)
+                column->popBack(column->size() - rows_in_current_format);
 
         current_entry->finish(std::current_exception());
         return 0;
     };
 
-    StreamingFormatExecutor executor(header, format, std::move(on_error), std::move(adding_defaults_transform));
+    /// Entries may be written in different formats when async_insert_merge_formats
+    /// is enabled. Group them by format, so that each group is parsed by its own
+    /// input format, and flush all groups as a single insert.
+    std::vector<std::pair<String, std::vector<InsertData::EntryPtr>>> entries_by_format;
+    for (const auto & entry : data->entries)
+    {
+        auto it = std::find_if(entries_by_format.begin(), entries_by_format.end(),
+            [&](const auto & group) { return group.first == entry->format; });
+
+        if (it == entries_by_format.end())
+            it = entries_by_format.emplace(entries_by_format.end(), entry->format, std::vector<InsertData::EntryPtr>{});
+
+        it->second.push_back(entry);
+    }
+
+    MutableColumns result_columns;
     auto chunk_info = std::make_shared<AsyncInsertInfo>();
-    auto query_for_logging = serializeQuery(*key.query, insert_context->getSettingsRef().log_queries_cut_to_length);
 
-    for (const auto & entry : data->entries)
+    for (const auto & [format_name, entries] : entries_by_format)
     {
-        current_entry = entry;
+        auto query = key.query->clone();
+        assert_cast<ASTInsertQuery &>(*query).format = format_name;
 
-        const auto * bytes = entry->chunk.asString();
-        if (!bytes)
-            throw Exception(ErrorCodes::LOGICAL_ERROR,
-                "Expected entry with data kind Parsed. Got: {}", entry->chunk.getDataKind());
+        auto format = getInputFormatFromASTInsertQuery(query, false, header, insert_context, nullptr);
 
-        auto buffer = std::make_unique<ReadBufferFromString>(*bytes);
+        std::shared_ptr<ISimpleTransform> adding_defaults_transform;
+        if (columns_with_defaults)
+            adding_defaults_transform = std::make_shared<AddingDefaultsTransform>(header, *columns_with_defaults, *format, insert_context);
 
-        size_t num_bytes = bytes->size();
-        size_t num_rows = executor.execute(*buffer);
+        StreamingFormatExecutor executor(header, format, on_error, std::move(adding_defaults_transform));
+        auto query_for_logging = serializeQuery(*query, insert_context->getSettingsRef().log_queries_cut_to_length);
+        rows_in_current_format = 0;
 
-        total_rows += num_rows;
-        chunk_info->offsets.push_back(total_rows);
-        chunk_info->tokens.push_back(entry->async_dedup_token);
+        for (const auto & entry : entries)
+        {
+            current_entry = entry;
 
-        add_to_async_insert_log(entry, query_for_logging, current_exception, num_rows, num_bytes, data->timeout_ms);
+            const auto * bytes = entry->chunk.asString();
+            if (!bytes)
+                throw Exception(ErrorCodes::LOGICAL_ERROR,
+                    "Expected entry with data kind Parsed. Got: {}", entry->chunk.getDataKind());
 
-        current_exception.clear();
-        entry->resetChunk();
+            auto buffer = std::make_unique<ReadBufferFromString>(*bytes);
+
+            size_t num_bytes = bytes->size();
+            size_t num_rows = executor.execute(*buffer);
+
+            rows_in_current_format += num_rows;
+            total_rows += num_rows;
+            chunk_info->offsets.push_back(total_rows);
+            chunk_info->tokens.push_back(entry->async_dedup_token);
+
+            add_to_async_insert_log(entry, query_for_logging, current_exception, num_rows, num_bytes, data->timeout_ms);
+
+            current_exception.clear();
+            entry->resetChunk();
+        }
+
+        auto columns = executor.getResultColumns();
+        if (result_columns.empty())
+        {
+            result_columns = std::move(columns);
+        }
+        else
+        {
+            for (size_t i = 0; i < result_columns.size(); ++i)
+                result_columns[i]->insertRangeFrom(*columns[i], 0, columns[i]->size());
+        }
     }
 
-    Chunk chunk(executor.getResultColumns(), total_rows);
+    if (result_columns.empty())
+        result_columns = header.cloneEmptyColumns();
+
+    Chunk chunk(std::move(result_columns), total_rows);
     chunk.setChunkInfo(std::move(chunk_info));
     return chunk;
 }
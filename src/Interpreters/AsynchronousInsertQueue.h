@@ -16,6 +16,8 @@
 namespace DB
 {
 
+class ASTInsertQuery;
+
 /// A queue, that stores data for insert queries and periodically flushes it to tables.
 /// The data is grouped by table, format and settings of insert query.
 class AsynchronousInsertQueue : public WithContext
@@ -268,6 +270,11 @@ private:
         const QueueShardFlushTimeHistory::TimePoints & flush_time_points,
         std::chrono::steady_clock::time_point now) const;
 
+    /// Returns how close the most loaded partition of the destination table is
+    /// to the 'parts_to_delay_insert' threshold, in [0, 1].
+    /// Used to stretch the flush timeout when merges fall behind inserts.
+    double getMergeBacklogRatio(const ASTInsertQuery & insert_query, const ContextPtr & query_context) const;
+
     void preprocessInsertQuery(const ASTPtr & query, const ContextPtr & query_context);
 
     void processBatchDeadlines(size_t shard_num);
@@ -13,6 +13,7 @@
 #include <Parsers/TokenIterator.h>
 #include <Parsers/formatAST.h>
 #include <Parsers/parseDatabaseAndTableName.h>
+#include <Storages/MergeTree/MergeTreeData.h>
 #include <Common/ProfileEvents.h>
 #include <Common/SipHash.h>
 #include <Common/TTLCachePolicy.h>
@@ -126,6 +127,69 @@ bool astContainsSystemTables(ASTPtr ast, ContextPtr context)
 namespace
 {
 
+struct CollectTablesMatcher
+{
+    struct Data
+    {
+        const ContextPtr context;
+        std::set<QualifiedTableName> table_names;
+    };
+
+    static bool needChildVisit(const ASTPtr &, const ASTPtr &) { return true; }
+
+    static void visit(const ASTPtr & node, Data & data)
+    {
+        if (const auto * table_identifier = node->as<ASTTableIdentifier>())
+        {
+            auto table_id = table_identifier->getTableId();
+            QualifiedTableName table_name{table_id.database_name, table_id.table_name};
+            if (table_name.database.empty())
+                table_name.database = data.context->getCurrentDatabase();
+            data.table_names.insert(std::move(table_name));
+        }
+    }
+};
+
+using CollectTablesVisitor = InDepthNodeVisitor<CollectTablesMatcher, true>;
+
+bool tableVersionsAreCurrent(const QueryCache::Key::TableVersions & table_versions, const ContextPtr & context)
+{
+    for (const auto & [table_name, partition_versions] : table_versions)
+    {
+        auto table = DatabaseCatalog::instance().tryGetTable(StorageID{table_name.database, table_name.table}, context);
+        const auto * merge_tree = dynamic_cast<const MergeTreeData *>(table.get());
+        if (!merge_tree)
+            return false;
+
+        if (merge_tree->getPartitionDataVersions() != partition_versions)
+            return false;
+    }
+    return true;
+}
+
+}
+
+QueryCache::Key::TableVersions collectQueryCacheTableVersions(ASTPtr ast, ContextPtr context)
+{
+    CollectTablesMatcher::Data finder_data{context};
+    CollectTablesVisitor(finder_data).visit(ast);
+
+    QueryCache::Key::TableVersions table_versions;
+    for (const auto & table_name : finder_data.table_names)
+    {
+        auto table = DatabaseCatalog::instance().tryGetTable(StorageID{table_name.database, table_name.table}, context);
+        const auto * merge_tree = dynamic_cast<const MergeTreeData *>(table.get());
+        if (!merge_tree)
+            continue;
+
+        table_versions.emplace(table_name, merge_tree->getPartitionDataVersions());
+    }
+    return table_versions;
+}
+
+namespace
+{
+
 bool isQueryCacheRelatedSetting(const String & setting_name)
 {
     return setting_name.starts_with("query_cache_") || setting_name.ends_with("_query_cache");
@@ -280,7 +344,8 @@ QueryCache::Writer::Writer(
     size_t max_entry_size_in_bytes_, size_t max_entry_size_in_rows_,
     std::chrono::milliseconds min_query_runtime_,
     bool squash_partial_results_,
-    size_t max_block_size_)
+    size_t max_block_size_,
+    ContextPtr context_)
     : cache(cache_)
     , key(key_)
     , max_entry_size_in_bytes(max_entry_size_in_bytes_)
@@ -291,8 +356,16 @@ QueryCache::Writer::Writer(
 {
     if (auto entry = cache.getWithKey(key); entry.has_value() && !IsStale()(entry->key))
     {
-        skip_insert = true; /// Key already contained in cache and did not expire yet --> don't replace it
-        LOG_TRACE(logger, "Skipped insert because the cache contains a non-stale query result for query {}", doubleQuoteString(key.query_string));
+        /// An existing entry which became stale because a read partition changed must be replaced, otherwise
+        /// a long TTL would keep the cache unusable for this query until it expires.
+        const bool versions_current
+            = !context_ || entry->key.table_versions.empty() || tableVersionsAreCurrent(entry->key.table_versions, context_);
+
+        if (versions_current)
+        {
+            skip_insert = true; /// Key already contained in cache and did not expire yet --> don't replace it
+            LOG_TRACE(logger, "Skipped insert because the cache contains a non-stale query result for query {}", doubleQuoteString(key.query_string));
+        }
     }
 }
 
@@ -487,7 +560,7 @@ void QueryCache::Reader::buildSourceFromChunks(Block header, Chunks && chunks, c
     }
 }
 
-QueryCache::Reader::Reader(Cache & cache_, const Key & key, const std::lock_guard<std::mutex> &)
+QueryCache::Reader::Reader(Cache & cache_, const Key & key, ContextPtr context, const std::lock_guard<std::mutex> &)
 {
     auto entry = cache_.getWithKey(key);
 
@@ -514,6 +587,12 @@ QueryCache::Reader::Reader(Cache & cache_, const Key & key, const std::lock_guar
         return;
     }
 
+    if (context && !entry_key.table_versions.empty() && !tableVersionsAreCurrent(entry_key.table_versions, context))
+    {
+        LOG_TRACE(logger, "Query result for query {} is stale because a read partition changed", doubleQuoteString(key.query_string));
+        return;
+    }
+
     if (!entry_key.is_compressed)
     {
         // Cloning chunks isn't exactly great. It could be avoided by another indirection, i.e. wrapping Entry's members chunks, totals and
@@ -593,13 +672,13 @@ void QueryCache::updateConfiguration(size_t max_size_in_bytes, size_t max_entrie
     max_entry_size_in_rows = max_entry_size_in_rows_;
 }
 
-QueryCache::Reader QueryCache::createReader(const Key & key)
+QueryCache::Reader QueryCache::createReader(const Key & key, ContextPtr context)
 {
     std::lock_guard lock(mutex);
-    return Reader(cache, key, lock);
+    return Reader(cache, key, context, lock);
 }
 
-QueryCache::Writer QueryCache::createWriter(const Key & key, std::chrono::milliseconds min_query_runtime, bool squash_partial_results, size_t max_block_size, size_t max_query_cache_size_in_bytes_quota, size_t max_query_cache_entries_quota)
+QueryCache::Writer QueryCache::createWriter(const Key & key, std::chrono::milliseconds min_query_runtime, bool squash_partial_results, size_t max_block_size, size_t max_query_cache_size_in_bytes_quota, size_t max_query_cache_entries_quota, ContextPtr context)
 {
     /// Update the per-user cache quotas with the values stored in the query context. This happens per query which writes into the query
     /// cache. Obviously, this is overkill but I could find the good place to hook into which is called when the settings profiles in
@@ -609,7 +688,7 @@ QueryCache::Writer QueryCache::createWriter(const Key & key, std::chrono::millis
         cache.setQuotaForUser(*key.user_id, max_query_cache_size_in_bytes_quota, max_query_cache_entries_quota);
 
     std::lock_guard lock(mutex);
-    return Writer(cache, key, max_entry_size_in_bytes, max_entry_size_in_rows, min_query_runtime, squash_partial_results, max_block_size);
+    return Writer(cache, key, max_entry_size_in_bytes, max_entry_size_in_rows, min_query_runtime, squash_partial_results, max_block_size, context);
 }
 
 void QueryCache::clear()
@@ -3,6 +3,7 @@
 #include <Common/CacheBase.h>
 #include <Common/logger_useful.h>
 #include <Core/Block.h>
+#include <Core/QualifiedTableName.h>
 #include <Parsers/IAST.h>
 #include <Processors/Chunk.h>
 #include <Processors/Sources/SourceFromChunks.h>
@@ -29,6 +30,10 @@ bool astContainsSystemTables(ASTPtr ast, ContextPtr context);
 /// returned. In order to still obtain sufficiently up-to-date query results, a expiry time (TTL) must be specified for each cache entry
 /// after which it becomes stale and is ignored. Stale entries are removed opportunistically from the cache, they are only evicted when a
 /// new entry is inserted and the cache has insufficient capacity.
+///
+/// Additionally (setting 'query_cache_partition_invalidation'), an entry can record the partitions of the MergeTree tables it read
+/// together with their versions. Such an entry is also considered stale as soon as one of these partitions gains, loses or mutates data,
+/// which allows a much longer TTL for queries over append-only tables.
 class QueryCache
 {
 public:
@@ -88,6 +93,13 @@ public:
         /// SYSTEM.QUERY_CACHE.
         const String query_string;
 
+        /// Maximum data version per partition of each MergeTree table the query read (see collectQueryCacheTableVersions()).
+        /// If non-empty, the entry is considered stale as soon as the current versions differ from the recorded ones,
+        /// in addition to the TTL check.
+        using PartitionVersions = std::map<String, Int64>;
+        using TableVersions = std::map<QualifiedTableName, PartitionVersions>;
+        TableVersions table_versions;
+
         /// Ctor to construct a Key for writing into query cache.
         Key(ASTPtr ast_,
             const String & current_database,
@@ -171,7 +183,8 @@ public:
             size_t max_entry_size_in_bytes_, size_t max_entry_size_in_rows_,
             std::chrono::milliseconds min_query_runtime_,
             bool squash_partial_results_,
-            size_t max_block_size_);
+            size_t max_block_size_,
+            ContextPtr context_);
 
         friend class QueryCache; /// for createWriter()
     };
@@ -187,7 +200,7 @@ public:
         std::unique_ptr<SourceFromChunks> getSourceTotals();
         std::unique_ptr<SourceFromChunks> getSourceExtremes();
     private:
-        Reader(Cache & cache_, const Key & key, const std::lock_guard<std::mutex> &);
+        Reader(Cache & cache_, const Key & key, ContextPtr context, const std::lock_guard<std::mutex> &);
         void buildSourceFromChunks(Block header, Chunks && chunks, const std::optional<Chunk> & totals, const std::optional<Chunk> & extremes);
         std::unique_ptr<SourceFromChunks> source_from_chunks;
         std::unique_ptr<SourceFromChunks> source_from_chunks_totals;
@@ -200,8 +213,8 @@ public:
 
     void updateConfiguration(size_t max_size_in_bytes, size_t max_entries, size_t max_entry_size_in_bytes_, size_t max_entry_size_in_rows_);
 
-    Reader createReader(const Key & key);
-    Writer createWriter(const Key & key, std::chrono::milliseconds min_query_runtime, bool squash_partial_results, size_t max_block_size, size_t max_query_cache_size_in_bytes_quota, size_t max_query_cache_entries_quota);
+    Reader createReader(const Key & key, ContextPtr context = nullptr);
+    Writer createWriter(const Key & key, std::chrono::milliseconds min_query_runtime, bool squash_partial_results, size_t max_block_size, size_t max_query_cache_size_in_bytes_quota, size_t max_query_cache_entries_quota, ContextPtr context = nullptr);
 
     void clear();
 
@@ -232,4 +245,10 @@ private:
 
 using QueryCachePtr = std::shared_ptr<QueryCache>;
 
+/// Collect the current partition versions of the MergeTree tables referenced by the query,
+/// for partition-level invalidation of query cache entries. Tables that cannot be resolved
+/// to a MergeTree table (e.g. views or table functions) are skipped, for them the TTL
+/// remains the only invalidation mechanism.
+QueryCache::Key::TableVersions collectQueryCacheTableVersions(ASTPtr ast, ContextPtr context);
+
 }
@@ -0,0 +1,96 @@
+#include <Interpreters/Cache/ScalarSubqueryCache.h>
+
+#include <Core/Settings.h>
+#include <IO/WriteHelpers.h>
+#include <Interpreters/Context.h>
+#include <Common/ProfileEvents.h>
+
+namespace ProfileEvents
+{
+    extern const Event ScalarSubqueriesServerCacheHit;
+}
+
+namespace DB
+{
+
+namespace
+{
+
+String makeKey(const String & subquery_hash, const ContextPtr & context)
+{
+    /// The subquery hash is computed before name resolution, so the same text can refer to different tables
+    /// depending on the current database, and row policies may give different users different results.
+    /// Row policies also attach to roles, so the same user gets a separate entry after SET ROLE.
+    String key = context->getUserName();
+    key += '\0';
+    for (const auto & role_id : context->getEnabledRoles())
+    {
+        key += toString(role_id);
+        key += ',';
+    }
+    key += '\0';
+    key += context->getCurrentDatabase();
+    key += '\0';
+    key += subquery_hash;
+    return key;
+}
+
+}
+
+ScalarSubqueryCache & ScalarSubqueryCache::instance()
+{
+    static ScalarSubqueryCache cache;
+    return cache;
+}
+
+std::optional<Block> ScalarSubqueryCache::get(const String & subquery_hash, const ASTPtr & subquery_ast, ContextPtr context)
+{
+    auto key = makeKey(subquery_hash, context);
+
+    Entry entry;
+    {
+        std::lock_guard lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end())
+            return std::nullopt;
+
+        if (std::chrono::steady_clock::now() > it->second.expires_at)
+        {
+            entries.erase(it);
+            return std::nullopt;
+        }
+
+        entry = it->second;
+    }
+
+    /// Recollecting the versions takes catalog locks, don't do it under the cache mutex.
+    /// A dropped or changed table produces different versions and invalidates the entry.
+    if (collectQueryCacheTableVersions(subquery_ast, context) != entry.table_versions)
+    {
+        std::lock_guard lock(mutex);
+        entries.erase(key);
+        return std::nullopt;
+    }
+
+    ProfileEvents::increment(ProfileEvents::ScalarSubqueriesServerCacheHit);
+    return entry.scalar;
+}
+
+void ScalarSubqueryCache::set(const String & subquery_hash, const ASTPtr & subquery_ast, const Block & scalar, ContextPtr context)
+{
+    auto table_versions = collectQueryCacheTableVersions(subquery_ast, context);
+    auto expires_at = std::chrono::steady_clock::now() + std::chrono::seconds(context->getSettingsRef().scalar_subquery_cache_ttl.totalSeconds());
+
+    std::lock_guard lock(mutex);
+    if (entries.size() >= max_entries && !entries.contains(makeKey(subquery_hash, context)))
+    {
+        /// Dropping expired entries is usually enough; otherwise start over rather than track usage.
+        std::erase_if(entries, [now = std::chrono::steady_clock::now()](const auto & elem) { return now > elem.second.expires_at; });
+        if (entries.size() >= max_entries)
+            entries.clear();
+    }
+
+    entries[makeKey(subquery_hash, context)] = Entry{scalar, std::move(table_versions), expires_at};
+}
+
+}
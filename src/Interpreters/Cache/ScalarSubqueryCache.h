@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Core/Block.h>
+#include <Interpreters/Cache/QueryCache.h>
+#include <Interpreters/Context_fwd.h>
+#include <Parsers/IAST_fwd.h>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace DB
+{
+
+/// Server-wide cache of scalar subquery results (setting 'use_scalar_subquery_cache').
+///
+/// The per-query scalar caches (Context scalars, the maps in ExecuteScalarSubqueriesVisitor and QueryAnalyzer) deduplicate
+/// identical scalar subqueries within one query but not across queries, so workloads where thousands of queries per minute
+/// share literally identical subqueries like '(SELECT max(date) FROM calendar)' re-execute them every time. This cache keeps
+/// the result across queries, keyed by the same subquery hash the per-query caches use, plus the current user and database
+/// (the hash is computed before name resolution, and row policies may give users different results).
+///
+/// An entry records the partition versions of the MergeTree tables the subquery reads - the same versioning the query cache
+/// uses for partition-level invalidation (see collectQueryCacheTableVersions()) - and is ignored as soon as one of these
+/// partitions gains, loses or mutates data. Tables that cannot be resolved to MergeTree fall back to the TTL
+/// (setting 'scalar_subquery_cache_ttl'), which also bounds the reuse of non-deterministic subqueries.
+class ScalarSubqueryCache
+{
+public:
+    static ScalarSubqueryCache & instance();
+
+    /// Returns the cached scalar for the subquery with the given hash, or nothing if there is no entry,
+    /// the entry expired, or the partitions read by the subquery changed since the entry was stored.
+    std::optional<Block> get(const String & subquery_hash, const ASTPtr & subquery_ast, ContextPtr context);
+
+    /// Stores the scalar together with the current partition versions of the tables the subquery reads.
+    void set(const String & subquery_hash, const ASTPtr & subquery_ast, const Block & scalar, ContextPtr context);
+
+private:
+    struct Entry
+    {
+        Block scalar;
+        QueryCache::Key::TableVersions table_versions;
+        std::chrono::steady_clock::time_point expires_at;
+    };
+
+    /// Scalar blocks are single rows, so a simple bound on the number of entries is enough.
+    static constexpr size_t max_entries = 1024;
+
+    std::mutex mutex;
+    std::unordered_map<String, Entry> entries;
+};
+
+}
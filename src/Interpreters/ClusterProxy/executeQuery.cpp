@@ -488,7 +488,9 @@ void executeQueryWithParallelReplicas(
     }
 
     auto coordinator = std::make_shared<ParallelReplicasReadingCoordinator>(
-        new_cluster->getShardsInfo().begin()->getAllNodeCount(), settings.parallel_replicas_mark_segment_size);
+        new_cluster->getShardsInfo().begin()->getAllNodeCount(),
+        settings.parallel_replicas_mark_segment_size,
+        settings.parallel_replicas_adaptive_scheduling);
     auto external_tables = new_context->getExternalTables();
     auto read_from_remote = std::make_unique<ReadFromParallelRemoteReplicasStep>(
         query_ast,
@@ -21,6 +21,7 @@
 #include <Common/scope_guard_safe.h>
 #include <Common/setThreadName.h>
 #include <Common/typeid_cast.h>
+#include <base/getThreadId.h>
 
 namespace CurrentMetrics
 {
@@ -126,6 +127,8 @@ ConcurrentHashJoin::~ConcurrentHashJoin()
 
 bool ConcurrentHashJoin::addBlockToJoin(const Block & right_block, bool check_limits)
 {
+    updateRuntimeFilters(right_block);
+
     Blocks dispatched_blocks = dispatchBlock(table_join->getOnlyClause().key_names_right, right_block);
 
     size_t blocks_left = 0;
@@ -137,11 +140,18 @@ bool ConcurrentHashJoin::addBlockToJoin(const Block & right_block, bool check_li
         }
     }
 
+    /// Start from a shard derived from the thread id, so that concurrent inserting threads
+    /// do not convoy on shard 0 and each thread keeps returning to the same shards.
+    /// The latter also improves memory locality of the build side: a shard's arena pages
+    /// tend to be first-touched (and thus placed) by a small set of threads.
+    const size_t shard_offset = getThreadId() % dispatched_blocks.size();
+
     while (blocks_left > 0)
     {
         /// insert blocks into corresponding HashJoin instances
-        for (size_t i = 0; i < dispatched_blocks.size(); ++i)
+        for (size_t shard = 0; shard < dispatched_blocks.size(); ++shard)
         {
+            size_t i = (shard_offset + shard) % dispatched_blocks.size();
             auto & hash_join = hash_joins[i];
             auto & dispatched_block = dispatched_blocks[i];
 
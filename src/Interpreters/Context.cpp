@@ -25,6 +25,9 @@
 #include <Databases/IDatabase.h>
 #include <Server/ServerType.h>
 #include <Storages/MarkCache.h>
+#include <Storages/MergeTree/SkippingIndexResultCache.h>
+#include <Storages/MergeTree/FilteredGranuleCache.h>
+#include <Storages/MergeTree/ApproximateNearestNeighborIndexCache.h>
 #include <Storages/MergeTree/MergeList.h>
 #include <Storages/MergeTree/MovesList.h>
 #include <Storages/MergeTree/ReplicatedFetchList.h>
@@ -50,6 +53,7 @@
 #include <Interpreters/SessionTracker.h>
 #include <Core/ServerSettings.h>
 #include <Interpreters/PreparedSets.h>
+#include <Analyzer/QueryTreeCache.h>
 #include <Core/Settings.h>
 #include <Core/SettingsQuirks.h>
 #include <Access/AccessControl.h>
@@ -74,6 +78,7 @@
 #include <Interpreters/ProcessList.h>
 #include <Interpreters/InterserverCredentials.h>
 #include <Interpreters/Cluster.h>
+#include <Interpreters/ExternalTablesDedupCache.h>
 #include <Interpreters/InterserverIOHandler.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/DDLWorker.h>
@@ -292,7 +297,14 @@ struct ContextSharedPart : boost::noncopyable
     mutable std::unique_ptr<ThreadPool> prefetch_threadpool;    /// Threadpool for loading marks cache.
     mutable UncompressedCachePtr index_uncompressed_cache TSA_GUARDED_BY(mutex);      /// The cache of decompressed blocks for MergeTree indices.
     mutable QueryCachePtr query_cache TSA_GUARDED_BY(mutex);                          /// Cache of query results.
+    mutable SubquerySetCachePtr subquery_set_cache TSA_GUARDED_BY(mutex);             /// Cache of sets built from IN subqueries.
+    mutable QueryTreeCachePtr query_tree_cache TSA_GUARDED_BY(mutex);                 /// Cache of analyzed query trees.
     mutable MarkCachePtr index_mark_cache TSA_GUARDED_BY(mutex);                      /// Cache of marks in compressed files of MergeTree indices.
+    mutable OnceFlag external_tables_dedup_cache_initialized;
+    mutable ExternalTablesDedupCachePtr external_tables_dedup_cache;                  /// Content-addressed cache of external tables received from initiators.
+    mutable SkippingIndexResultCachePtr skipping_index_result_cache TSA_GUARDED_BY(mutex); /// Cache of the results of evaluating skipping indexes over MergeTree data parts.
+    mutable FilteredGranuleCachePtr filtered_granule_cache TSA_GUARDED_BY(mutex);     /// Cache of decoded and filtered results of MergeTree read tasks.
+    mutable ApproximateNearestNeighborIndexCachePtr ann_index_cache TSA_GUARDED_BY(mutex); /// Cache of deserialized granules of approximate nearest neighbor indexes.
     mutable MMappedFileCachePtr mmap_cache TSA_GUARDED_BY(mutex);                     /// Cache of mmapped files to avoid frequent open/map/unmap/close and to reuse from several threads.
     AsynchronousMetrics * asynchronous_metrics TSA_GUARDED_BY(mutex) = nullptr;       /// Points to asynchronous metrics
     mutable PageCachePtr page_cache TSA_GUARDED_BY(mutex);                            /// Userspace page cache.
@@ -741,12 +753,12 @@ struct ContextSharedPart : boost::noncopyable
         return trace_collector.has_value();
     }
 
-    void initializeTraceCollector(std::shared_ptr<TraceLog> trace_log)
+    void initializeTraceCollector(std::shared_ptr<TraceLog> trace_log, bool fold_profiler_samples)
     {
         if (!trace_collector.has_value())
             throw Exception(ErrorCodes::LOGICAL_ERROR, "TraceCollector needs to be first created before initialization");
 
-        trace_collector->initialize(trace_log);
+        trace_collector->initialize(trace_log, fold_profiler_samples);
     }
 
     void createTraceCollector()
@@ -959,7 +971,7 @@ Strings Context::getWarnings() const
     }
     /// Make setting's name ordered
     std::set<String> obsolete_settings;
-    for (const auto & setting : settings)
+    for (const auto & setting : getSettingsRef())
     {
         if (setting.isValueChanged() && setting.isObsolete())
             obsolete_settings.emplace(setting.getName());
@@ -1433,7 +1445,7 @@ std::shared_ptr<const ContextAccess> Context::getAccess() const
         /// If setUserID() was never called then this must be the global context with the full access.
         bool full_access = !user_id;
 
-        return ContextAccessParams{user_id, full_access, /* use_default_roles= */ false, current_roles, settings, current_database, client_info};
+        return ContextAccessParams{user_id, full_access, /* use_default_roles= */ false, current_roles, *settings, current_database, client_info};
     };
 
     /// Check if the current access rights are still valid, otherwise get parameters for recalculating access rights.
@@ -1515,7 +1527,7 @@ void Context::setCurrentProfilesWithLock(const SettingsProfilesInfo & profiles_i
         checkSettingsConstraintsWithLock(profiles_info.settings, SettingSource::PROFILE);
     applySettingsChangesWithLock(profiles_info.settings, lock);
     settings_constraints_and_current_profiles = profiles_info.getConstraintsAndProfileIDs(settings_constraints_and_current_profiles);
-    contextSanityClampSettingsWithLock(*this, settings, lock);
+    contextSanityClampSettingsWithLock(*this, getMutableSettings(), lock);
 }
 
 void Context::setCurrentProfile(const String & profile_name, bool check_constraints)
@@ -2123,15 +2135,40 @@ bool Context::displaySecretsInShowAndSelect() const
 Settings Context::getSettings() const
 {
     SharedLockGuard lock(mutex);
-    return settings;
+    return *settings;
+}
+
+Settings & Context::getMutableSettings()
+{
+    /// The settings may still be shared with the context this one was copied from (or with its
+    /// copies): clone them on the first modification. The reference count can only grow via
+    /// createCopy() of this context, which is serialized with modifications by `mutex`, so a
+    /// unique pointer cannot become shared under our feet.
+    if (settings.use_count() > 1)
+    {
+        /// The replaced object is retained: references taken via getSettingsRef() before the
+        /// clone must stay valid for the lifetime of the context.
+        retained_settings.push_back(settings);
+        settings = std::make_shared<Settings>(*settings);
+        current_settings = settings.get();
+    }
+    return *settings;
+}
+
+void Context::unshareSettings()
+{
+    std::lock_guard lock(mutex);
+    getMutableSettings();
 }
 
 void Context::setSettings(const Settings & settings_)
 {
     std::lock_guard lock(mutex);
-    settings = settings_;
+    retained_settings.push_back(std::move(settings));
+    settings = std::make_shared<Settings>(settings_);
+    current_settings = settings.get();
     need_recalculate_access = true;
-    contextSanityClampSettings(*this, settings);
+    contextSanityClampSettings(*this, *settings);
 }
 
 void Context::setSettingWithLock(std::string_view name, const String & value, const std::lock_guard<ContextSharedMutex> & lock)
@@ -2141,10 +2178,10 @@ void Context::setSettingWithLock(std::string_view name, const String & value, co
         setCurrentProfileWithLock(value, true /*check_constraints*/, lock);
         return;
     }
-    settings.set(name, value);
+    getMutableSettings().set(name, value);
     if (ContextAccessParams::dependsOnSettingName(name))
         need_recalculate_access = true;
-    contextSanityClampSettingsWithLock(*this, settings, lock);
+    contextSanityClampSettingsWithLock(*this, getMutableSettings(), lock);
 }
 
 void Context::setSettingWithLock(std::string_view name, const Field & value, const std::lock_guard<ContextSharedMutex> & lock)
@@ -2154,7 +2191,7 @@ void Context::setSettingWithLock(std::string_view name, const Field & value, con
         setCurrentProfileWithLock(value.safeGet<String>(), true /*check_constraints*/, lock);
         return;
     }
-    settings.set(name, value);
+    getMutableSettings().set(name, value);
     if (ContextAccessParams::dependsOnSettingName(name))
         need_recalculate_access = true;
 }
@@ -2164,7 +2201,7 @@ void Context::applySettingChangeWithLock(const SettingChange & change, const std
     try
     {
         setSettingWithLock(change.name, change.value, lock);
-        contextSanityClampSettingsWithLock(*this, settings, lock);
+        contextSanityClampSettingsWithLock(*this, getMutableSettings(), lock);
     }
     catch (Exception & e)
     {
@@ -2179,7 +2216,7 @@ void Context::applySettingsChangesWithLock(const SettingsChanges & changes, cons
 {
     for (const SettingChange & change : changes)
         applySettingChangeWithLock(change, lock);
-    applySettingsQuirks(settings);
+    applySettingsQuirks(getMutableSettings());
 }
 
 void Context::setSetting(std::string_view name, const String & value)
@@ -2192,7 +2229,7 @@ void Context::setSetting(std::string_view name, const Field & value)
 {
     std::lock_guard lock(mutex);
     setSettingWithLock(name, value, lock);
-    contextSanityClampSettingsWithLock(*this, settings, lock);
+    contextSanityClampSettingsWithLock(*this, getMutableSettings(), lock);
 }
 
 void Context::applySettingChange(const SettingChange & change)
@@ -2219,37 +2256,37 @@ void Context::applySettingsChanges(const SettingsChanges & changes)
 
 void Context::checkSettingsConstraintsWithLock(const SettingsProfileElements & profile_elements, SettingSource source)
 {
-    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(settings, profile_elements, source);
+    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(*settings, profile_elements, source);
     if (getApplicationType() == ApplicationType::LOCAL || getApplicationType() == ApplicationType::SERVER)
-        doSettingsSanityCheckClamp(settings, getLogger("SettingsSanity"));
+        doSettingsSanityCheckClamp(getMutableSettings(), getLogger("SettingsSanity"));
 }
 
 void Context::checkSettingsConstraintsWithLock(const SettingChange & change, SettingSource source)
 {
-    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(settings, change, source);
+    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(*settings, change, source);
     if (getApplicationType() == ApplicationType::LOCAL || getApplicationType() == ApplicationType::SERVER)
-        doSettingsSanityCheckClamp(settings, getLogger("SettingsSanity"));
+        doSettingsSanityCheckClamp(getMutableSettings(), getLogger("SettingsSanity"));
 }
 
 void Context::checkSettingsConstraintsWithLock(const SettingsChanges & changes, SettingSource source)
 {
-    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(settings, changes, source);
+    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(*settings, changes, source);
     if (getApplicationType() == ApplicationType::LOCAL || getApplicationType() == ApplicationType::SERVER)
-        doSettingsSanityCheckClamp(settings, getLogger("SettingsSanity"));
+        doSettingsSanityCheckClamp(getMutableSettings(), getLogger("SettingsSanity"));
 }
 
 void Context::checkSettingsConstraintsWithLock(SettingsChanges & changes, SettingSource source)
 {
-    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(settings, changes, source);
+    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(*settings, changes, source);
     if (getApplicationType() == ApplicationType::LOCAL || getApplicationType() == ApplicationType::SERVER)
-        doSettingsSanityCheckClamp(settings, getLogger("SettingsSanity"));
+        doSettingsSanityCheckClamp(getMutableSettings(), getLogger("SettingsSanity"));
 }
 
 void Context::clampToSettingsConstraintsWithLock(SettingsChanges & changes, SettingSource source)
 {
-    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.clamp(settings, changes, source);
+    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.clamp(*settings, changes, source);
     if (getApplicationType() == ApplicationType::LOCAL || getApplicationType() == ApplicationType::SERVER)
-        doSettingsSanityCheckClamp(settings, getLogger("SettingsSanity"));
+        doSettingsSanityCheckClamp(getMutableSettings(), getLogger("SettingsSanity"));
 }
 
 void Context::checkMergeTreeSettingsConstraintsWithLock(const MergeTreeSettings & merge_tree_settings, const SettingsChanges & changes) const
@@ -2272,8 +2309,8 @@ void Context::checkSettingsConstraints(const SettingChange & change, SettingSour
 void Context::checkSettingsConstraints(const SettingsChanges & changes, SettingSource source)
 {
     SharedLockGuard lock(mutex);
-    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(settings, changes, source);
-    doSettingsSanityCheckClamp(settings, getLogger("SettingsSanity"));
+    getSettingsConstraintsAndCurrentProfilesWithLock()->constraints.check(*settings, changes, source);
+    doSettingsSanityCheckClamp(getMutableSettings(), getLogger("SettingsSanity"));
 }
 
 void Context::checkSettingsConstraints(SettingsChanges & changes, SettingSource source)
@@ -2297,8 +2334,9 @@ void Context::checkMergeTreeSettingsConstraints(const MergeTreeSettings & merge_
 void Context::resetSettingsToDefaultValue(const std::vector<String> & names)
 {
     std::lock_guard lock(mutex);
+    auto & mutable_settings = getMutableSettings();
     for (const String & name: names)
-        settings.setDefaultValue(name);
+        mutable_settings.setDefaultValue(name);
 }
 
 std::shared_ptr<const SettingsConstraintsAndProfileIDs> Context::getSettingsConstraintsAndCurrentProfilesWithLock() const
@@ -2808,14 +2846,14 @@ QueryStatusPtr Context::getProcessListElementSafe() const
     return {};
 }
 
-void Context::setUncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio)
+void Context::setUncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio, size_t compressed_frames_max_size_in_bytes)
 {
     std::lock_guard lock(shared->mutex);
 
     if (shared->uncompressed_cache)
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Uncompressed cache has been already created.");
 
-    shared->uncompressed_cache = std::make_shared<UncompressedCache>(cache_policy, max_size_in_bytes, size_ratio);
+    shared->uncompressed_cache = std::make_shared<UncompressedCache>(cache_policy, max_size_in_bytes, size_ratio, compressed_frames_max_size_in_bytes);
 }
 
 void Context::updateUncompressedCacheConfiguration(const Poco::Util::AbstractConfiguration & config)
@@ -2897,6 +2935,16 @@ MarkCachePtr Context::getMarkCache() const
     return shared->mark_cache;
 }
 
+ExternalTablesDedupCachePtr Context::getExternalTablesDedupCache() const
+{
+    callOnce(shared->external_tables_dedup_cache_initialized, [&] {
+        size_t max_size_in_bytes = getConfigRef().getUInt64("external_tables_dedup_cache_size", DEFAULT_EXTERNAL_TABLES_DEDUP_CACHE_MAX_SIZE);
+        shared->external_tables_dedup_cache = std::make_shared<ExternalTablesDedupCache>(max_size_in_bytes);
+    });
+
+    return shared->external_tables_dedup_cache;
+}
+
 void Context::clearMarkCache() const
 {
     std::lock_guard lock(shared->mutex);
@@ -2988,6 +3036,111 @@ void Context::clearIndexMarkCache() const
         shared->index_mark_cache->clear();
 }
 
+void Context::setSkippingIndexResultCache(const String & cache_policy, size_t max_cache_size_in_bytes, double size_ratio)
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (shared->skipping_index_result_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Skipping index result cache has been already created.");
+
+    shared->skipping_index_result_cache = std::make_shared<SkippingIndexResultCache>(cache_policy, max_cache_size_in_bytes, size_ratio);
+}
+
+void Context::updateSkippingIndexResultCacheConfiguration(const Poco::Util::AbstractConfiguration & config)
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (!shared->skipping_index_result_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Skipping index result cache was not created yet.");
+
+    size_t max_size_in_bytes = config.getUInt64("skipping_index_result_cache_size", DEFAULT_SKIPPING_INDEX_RESULT_CACHE_MAX_SIZE);
+    shared->skipping_index_result_cache->setMaxSizeInBytes(max_size_in_bytes);
+}
+
+SkippingIndexResultCachePtr Context::getSkippingIndexResultCache() const
+{
+    SharedLockGuard lock(shared->mutex);
+    return shared->skipping_index_result_cache;
+}
+
+void Context::clearSkippingIndexResultCache() const
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (shared->skipping_index_result_cache)
+        shared->skipping_index_result_cache->clear();
+}
+
+void Context::setFilteredGranuleCache(const String & cache_policy, size_t max_cache_size_in_bytes, double size_ratio)
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (shared->filtered_granule_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Filtered granule cache has been already created.");
+
+    shared->filtered_granule_cache = std::make_shared<FilteredGranuleCache>(cache_policy, max_cache_size_in_bytes, size_ratio);
+}
+
+void Context::updateFilteredGranuleCacheConfiguration(const Poco::Util::AbstractConfiguration & config)
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (!shared->filtered_granule_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Filtered granule cache was not created yet.");
+
+    size_t max_size_in_bytes = config.getUInt64("filtered_granule_cache_size", DEFAULT_FILTERED_GRANULE_CACHE_MAX_SIZE);
+    shared->filtered_granule_cache->setMaxSizeInBytes(max_size_in_bytes);
+}
+
+FilteredGranuleCachePtr Context::getFilteredGranuleCache() const
+{
+    SharedLockGuard lock(shared->mutex);
+    return shared->filtered_granule_cache;
+}
+
+void Context::clearFilteredGranuleCache() const
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (shared->filtered_granule_cache)
+        shared->filtered_granule_cache->clear();
+}
+
+void Context::setApproximateNearestNeighborIndexCache(const String & cache_policy, size_t max_cache_size_in_bytes, double size_ratio)
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (shared->ann_index_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Approximate nearest neighbor index cache has been already created.");
+
+    shared->ann_index_cache = std::make_shared<ApproximateNearestNeighborIndexCache>(cache_policy, max_cache_size_in_bytes, size_ratio);
+}
+
+void Context::updateApproximateNearestNeighborIndexCacheConfiguration(const Poco::Util::AbstractConfiguration & config)
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (!shared->ann_index_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Approximate nearest neighbor index cache was not created yet.");
+
+    size_t max_size_in_bytes = config.getUInt64("approximate_nearest_neighbor_index_cache_size", DEFAULT_ANN_INDEX_CACHE_MAX_SIZE);
+    shared->ann_index_cache->setMaxSizeInBytes(max_size_in_bytes);
+}
+
+ApproximateNearestNeighborIndexCachePtr Context::getApproximateNearestNeighborIndexCache() const
+{
+    SharedLockGuard lock(shared->mutex);
+    return shared->ann_index_cache;
+}
+
+void Context::clearApproximateNearestNeighborIndexCache() const
+{
+    std::lock_guard lock(shared->mutex);
+
+    if (shared->ann_index_cache)
+        shared->ann_index_cache->clear();
+}
+
 void Context::setMMappedFileCache(size_t max_cache_size_in_num_entries)
 {
     std::lock_guard lock(shared->mutex);
@@ -3061,6 +3214,48 @@ void Context::clearQueryCache() const
         shared->query_cache->clear();
 }
 
+SubquerySetCachePtr Context::getSubquerySetCache() const
+{
+    /// Read the configuration before taking the lock, getConfigRef() locks the shared mutex itself.
+    const auto & config = getConfigRef();
+    size_t max_size_in_bytes = config.getUInt64("subquery_set_cache.max_size_in_bytes", 1ul << 30);
+    size_t max_entries = config.getUInt64("subquery_set_cache.max_entries", 128);
+
+    std::lock_guard lock(shared->mutex);
+
+    if (!shared->subquery_set_cache)
+        shared->subquery_set_cache = std::make_shared<SubquerySetCache>(max_size_in_bytes, max_entries);
+
+    return shared->subquery_set_cache;
+}
+
+void Context::clearSubquerySetCache() const
+{
+    std::lock_guard lock(shared->mutex);
+
+    shared->subquery_set_cache.reset();
+}
+
+QueryTreeCachePtr Context::getQueryTreeCache() const
+{
+    /// Read the configuration before taking the lock, getConfigRef() locks the shared mutex itself.
+    size_t max_entries = getConfigRef().getUInt64("query_tree_cache.max_entries", 128);
+
+    std::lock_guard lock(shared->mutex);
+
+    if (!shared->query_tree_cache)
+        shared->query_tree_cache = std::make_shared<QueryTreeCache>(max_entries);
+
+    return shared->query_tree_cache;
+}
+
+void Context::clearQueryTreeCache() const
+{
+    std::lock_guard lock(shared->mutex);
+
+    shared->query_tree_cache.reset();
+}
+
 void Context::clearCaches() const
 {
     std::lock_guard lock(shared->mutex);
@@ -3081,6 +3276,18 @@ void Context::clearCaches() const
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Index mark cache was not created yet.");
     shared->index_mark_cache->clear();
 
+    if (!shared->skipping_index_result_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Skipping index result cache was not created yet.");
+    shared->skipping_index_result_cache->clear();
+
+    if (!shared->filtered_granule_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Filtered granule cache was not created yet.");
+    shared->filtered_granule_cache->clear();
+
+    if (!shared->ann_index_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Approximate nearest neighbor index cache was not created yet.");
+    shared->ann_index_cache->clear();
+
     if (!shared->mmap_cache)
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Mmapped file cache was not created yet.");
     shared->mmap_cache->clear();
@@ -3795,7 +4002,7 @@ void Context::reloadClusterConfig() const
         }
 
         const auto & config = cluster_config ? *cluster_config : getConfigRef();
-        auto new_clusters = std::make_shared<Clusters>(config, settings, getMacros());
+        auto new_clusters = std::make_shared<Clusters>(config, getSettingsRef(), getMacros());
 
         {
             std::lock_guard lock(shared->clusters_mutex);
@@ -3830,7 +4037,7 @@ std::shared_ptr<Clusters> Context::getClustersImpl(std::lock_guard<std::mutex> &
     if (!shared->clusters)
     {
         const auto & config = shared->clusters_config ? *shared->clusters_config : getConfigRef();
-        shared->clusters = std::make_shared<Clusters>(config, settings, getMacros());
+        shared->clusters = std::make_shared<Clusters>(config, getSettingsRef(), getMacros());
     }
 
     return shared->clusters;
@@ -3862,9 +4069,9 @@ void Context::setClustersConfig(const ConfigurationPtr & config, bool enable_dis
     shared->clusters_config = config;
 
     if (!shared->clusters)
-        shared->clusters = std::make_shared<Clusters>(*shared->clusters_config, settings, getMacros(), config_name);
+        shared->clusters = std::make_shared<Clusters>(*shared->clusters_config, getSettingsRef(), getMacros(), config_name);
     else
-        shared->clusters->updateClusters(*shared->clusters_config, settings, config_name, old_clusters_config);
+        shared->clusters->updateClusters(*shared->clusters_config, getSettingsRef(), config_name, old_clusters_config);
 
     ++shared->clusters_version;
 }
@@ -3907,7 +4114,7 @@ void Context::createTraceCollector()
 
 void Context::initializeTraceCollector()
 {
-    shared->initializeTraceCollector(getTraceLog());
+    shared->initializeTraceCollector(getTraceLog(), getConfigRef().getBool("trace_log.fold_profiler_samples", false));
 }
 
 /// Call after unexpected crash happen.
@@ -4117,7 +4324,7 @@ std::shared_ptr<BackupLog> Context::getBackupLog() const
 
 std::shared_ptr<BlobStorageLog> Context::getBlobStorageLog() const
 {
-    bool enable_blob_storage_log = settings.enable_blob_storage_log;
+    bool enable_blob_storage_log = getSettingsRef().enable_blob_storage_log;
     if (hasQueryContext())
         enable_blob_storage_log = getQueryContext()->getSettingsRef().enable_blob_storage_log;
 
@@ -4548,8 +4755,8 @@ void Context::setDefaultProfiles(const Poco::Util::AbstractConfiguration & confi
     shared->system_profile_name = config.getString("system_profile", shared->default_profile_name);
     setCurrentProfile(shared->system_profile_name);
 
-    applySettingsQuirks(settings, getLogger("SettingsQuirks"));
-    doSettingsSanityCheckClamp(settings, getLogger("SettingsSanity"));
+    applySettingsQuirks(getMutableSettings(), getLogger("SettingsQuirks"));
+    doSettingsSanityCheckClamp(getMutableSettings(), getLogger("SettingsSanity"));
 
     shared->buffer_profile_name = config.getString("buffer_profile", shared->system_profile_name);
     buffer_context = Context::createCopy(shared_from_this());
@@ -5076,6 +5283,17 @@ void Context::setMergeTreeReadTaskCallback(MergeTreeReadTaskCallback && callback
 }
 
 
+std::shared_ptr<SortThresholdSlot> Context::getSortThresholdSlot() const
+{
+    return sort_threshold_slot;
+}
+
+void Context::setSortThresholdSlot(std::shared_ptr<SortThresholdSlot> slot)
+{
+    sort_threshold_slot = std::move(slot);
+}
+
+
 MergeTreeAllRangesCallback Context::getMergeTreeAllRangesCallback() const
 {
     if (!merge_tree_all_ranges_callback.has_value())
@@ -5118,11 +5336,11 @@ AsynchronousInsertQueue * Context::tryGetAsynchronousInsertQueue() const
 
 void Context::setAsynchronousInsertQueue(const std::shared_ptr<AsynchronousInsertQueue> & ptr)
 {
-    AsynchronousInsertQueue::validateSettings(settings, getLogger("Context"));
+    AsynchronousInsertQueue::validateSettings(getSettingsRef(), getLogger("Context"));
 
     SharedLockGuard lock(shared->mutex);
 
-    if (std::chrono::milliseconds(settings.async_insert_poll_timeout_ms) == std::chrono::milliseconds::zero())
+    if (std::chrono::milliseconds(getSettingsRef().async_insert_poll_timeout_ms) == std::chrono::milliseconds::zero())
         throw Exception(ErrorCodes::INVALID_SETTING_VALUE, "Setting async_insert_poll_timeout_ms can't be zero");
 
     shared->async_insert_queue = ptr;
@@ -5154,6 +5372,8 @@ void Context::initializeBackgroundExecutorsIfNeeded()
         CurrentMetrics::BackgroundMergesAndMutationsPoolSize,
         background_merges_mutations_scheduling_policy
     );
+    if (size_t concurrency_limit = server_settings.background_merges_mutations_concurrency_limit)
+        shared->merge_mutate_executor->setConcurrencyLimit(concurrency_limit);
     LOG_INFO(shared->log, "Initialized background executor for merges and mutations with num_threads={}, num_tasks={}, scheduling_policy={}",
         background_pool_size, background_pool_max_tasks_count, background_merges_mutations_scheduling_policy);
 
@@ -5244,7 +5464,7 @@ IAsynchronousReader & Context::getThreadPoolReader(FilesystemReaderType type) co
 IOUringReader & Context::getIOUringReader() const
 {
     callOnce(shared->io_uring_reader_initialized, [&] {
-        shared->io_uring_reader = createIOUringReader();
+        shared->io_uring_reader = createIOUringReader(getConfigRef());
     });
 
     return *shared->io_uring_reader;
@@ -5269,69 +5489,71 @@ ReadSettings Context::getReadSettings() const
 {
     ReadSettings res;
 
-    std::string_view read_method_str = settings.local_filesystem_read_method.value;
+    std::string_view read_method_str = settings->local_filesystem_read_method.value;
 
     if (auto opt_method = magic_enum::enum_cast<LocalFSReadMethod>(read_method_str))
         res.local_fs_method = *opt_method;
     else
         throw Exception(ErrorCodes::UNKNOWN_READ_METHOD, "Unknown read method '{}' for local filesystem", read_method_str);
 
-    read_method_str = settings.remote_filesystem_read_method.value;
+    read_method_str = settings->remote_filesystem_read_method.value;
 
     if (auto opt_method = magic_enum::enum_cast<RemoteFSReadMethod>(read_method_str))
         res.remote_fs_method = *opt_method;
     else
         throw Exception(ErrorCodes::UNKNOWN_READ_METHOD, "Unknown read method '{}' for remote filesystem", read_method_str);
 
-    res.local_fs_prefetch = settings.local_filesystem_read_prefetch;
-    res.remote_fs_prefetch = settings.remote_filesystem_read_prefetch;
+    res.local_fs_prefetch = settings->local_filesystem_read_prefetch;
+    res.remote_fs_prefetch = settings->remote_filesystem_read_prefetch;
 
-    res.load_marks_asynchronously = settings.load_marks_asynchronously;
+    res.load_marks_asynchronously = settings->load_marks_asynchronously;
 
-    res.enable_filesystem_read_prefetches_log = settings.enable_filesystem_read_prefetches_log;
+    res.enable_filesystem_read_prefetches_log = settings->enable_filesystem_read_prefetches_log;
 
-    res.remote_fs_read_max_backoff_ms = settings.remote_fs_read_max_backoff_ms;
-    res.remote_fs_read_backoff_max_tries = settings.remote_fs_read_backoff_max_tries;
-    res.enable_filesystem_cache = settings.enable_filesystem_cache;
-    res.read_from_filesystem_cache_if_exists_otherwise_bypass_cache = settings.read_from_filesystem_cache_if_exists_otherwise_bypass_cache;
-    res.enable_filesystem_cache_log = settings.enable_filesystem_cache_log;
-    res.filesystem_cache_segments_batch_size = settings.filesystem_cache_segments_batch_size;
-    res.filesystem_cache_reserve_space_wait_lock_timeout_milliseconds = settings.filesystem_cache_reserve_space_wait_lock_timeout_milliseconds;
+    res.remote_fs_read_max_backoff_ms = settings->remote_fs_read_max_backoff_ms;
+    res.remote_fs_read_backoff_max_tries = settings->remote_fs_read_backoff_max_tries;
+    res.enable_filesystem_cache = settings->enable_filesystem_cache;
+    res.read_from_filesystem_cache_if_exists_otherwise_bypass_cache = settings->read_from_filesystem_cache_if_exists_otherwise_bypass_cache;
+    res.enable_filesystem_cache_log = settings->enable_filesystem_cache_log;
+    res.filesystem_cache_segments_batch_size = settings->filesystem_cache_segments_batch_size;
+    res.filesystem_cache_reserve_space_wait_lock_timeout_milliseconds = settings->filesystem_cache_reserve_space_wait_lock_timeout_milliseconds;
 
-    res.filesystem_cache_max_download_size = settings.filesystem_cache_max_download_size;
-    res.skip_download_if_exceeds_query_cache = settings.skip_download_if_exceeds_query_cache;
+    res.filesystem_cache_max_download_size = settings->filesystem_cache_max_download_size;
+    res.skip_download_if_exceeds_query_cache = settings->skip_download_if_exceeds_query_cache;
 
     res.page_cache = getPageCache();
-    res.use_page_cache_for_disks_without_file_cache = settings.use_page_cache_for_disks_without_file_cache;
-    res.read_from_page_cache_if_exists_otherwise_bypass_cache = settings.read_from_page_cache_if_exists_otherwise_bypass_cache;
-    res.page_cache_inject_eviction = settings.page_cache_inject_eviction;
+    res.use_page_cache_for_disks_without_file_cache = settings->use_page_cache_for_disks_without_file_cache;
+    res.read_from_page_cache_if_exists_otherwise_bypass_cache = settings->read_from_page_cache_if_exists_otherwise_bypass_cache;
+    res.page_cache_inject_eviction = settings->page_cache_inject_eviction;
 
-    res.remote_read_min_bytes_for_seek = settings.remote_read_min_bytes_for_seek;
+    res.remote_read_min_bytes_for_seek = settings->remote_read_min_bytes_for_seek;
+    res.remote_read_adaptive_min_bytes_for_seek = settings->remote_read_adaptive_min_bytes_for_seek;
+    res.remote_read_adaptive_prefetch = settings->remote_read_adaptive_prefetch;
 
     /// Zero read buffer will not make progress.
-    if (!settings.max_read_buffer_size)
+    if (!settings->max_read_buffer_size)
     {
         throw Exception(ErrorCodes::INVALID_SETTING_VALUE,
-            "Invalid value '{}' for max_read_buffer_size", settings.max_read_buffer_size);
+            "Invalid value '{}' for max_read_buffer_size", settings->max_read_buffer_size);
     }
 
     res.local_fs_buffer_size
-        = settings.max_read_buffer_size_local_fs ? settings.max_read_buffer_size_local_fs : settings.max_read_buffer_size;
+        = settings->max_read_buffer_size_local_fs ? settings->max_read_buffer_size_local_fs : settings->max_read_buffer_size;
     res.remote_fs_buffer_size
-        = settings.max_read_buffer_size_remote_fs ? settings.max_read_buffer_size_remote_fs : settings.max_read_buffer_size;
-    res.prefetch_buffer_size = settings.prefetch_buffer_size;
-    res.direct_io_threshold = settings.min_bytes_to_use_direct_io;
-    res.mmap_threshold = settings.min_bytes_to_use_mmap_io;
-    res.priority = Priority{settings.read_priority};
+        = settings->max_read_buffer_size_remote_fs ? settings->max_read_buffer_size_remote_fs : settings->max_read_buffer_size;
+    res.prefetch_buffer_size = settings->prefetch_buffer_size;
+    res.direct_io_threshold = settings->min_bytes_to_use_direct_io;
+    res.mmap_threshold = settings->min_bytes_to_use_mmap_io;
+    res.priority = Priority{settings->read_priority};
 
     res.remote_throttler = getRemoteReadThrottler();
     res.local_throttler = getLocalReadThrottler();
 
-    res.http_max_tries = settings.http_max_tries;
-    res.http_retry_initial_backoff_ms = settings.http_retry_initial_backoff_ms;
-    res.http_retry_max_backoff_ms = settings.http_retry_max_backoff_ms;
-    res.http_skip_not_found_url_for_globs = settings.http_skip_not_found_url_for_globs;
-    res.http_make_head_request = settings.http_make_head_request;
+    res.http_max_tries = settings->http_max_tries;
+    res.http_retry_initial_backoff_ms = settings->http_retry_initial_backoff_ms;
+    res.http_retry_max_backoff_ms = settings->http_retry_max_backoff_ms;
+    res.http_skip_not_found_url_for_globs = settings->http_skip_not_found_url_for_globs;
+    res.http_make_head_request = settings->http_make_head_request;
 
     res.mmap_cache = getMMappedFileCache().get();
 
@@ -5342,13 +5564,13 @@ WriteSettings Context::getWriteSettings() const
 {
     WriteSettings res;
 
-    res.enable_filesystem_cache_on_write_operations = settings.enable_filesystem_cache_on_write_operations;
-    res.enable_filesystem_cache_log = settings.enable_filesystem_cache_log;
-    res.throw_on_error_from_cache = settings.throw_on_error_from_cache_on_write_operations;
-    res.filesystem_cache_reserve_space_wait_lock_timeout_milliseconds = settings.filesystem_cache_reserve_space_wait_lock_timeout_milliseconds;
+    res.enable_filesystem_cache_on_write_operations = settings->enable_filesystem_cache_on_write_operations;
+    res.enable_filesystem_cache_log = settings->enable_filesystem_cache_log;
+    res.throw_on_error_from_cache = settings->throw_on_error_from_cache_on_write_operations;
+    res.filesystem_cache_reserve_space_wait_lock_timeout_milliseconds = settings->filesystem_cache_reserve_space_wait_lock_timeout_milliseconds;
 
-    res.s3_allow_parallel_part_upload = settings.s3_allow_parallel_part_upload;
-    res.azure_allow_parallel_part_upload = settings.azure_allow_parallel_part_upload;
+    res.s3_allow_parallel_part_upload = settings->s3_allow_parallel_part_upload;
+    res.azure_allow_parallel_part_upload = settings->azure_allow_parallel_part_upload;
 
     res.remote_throttler = getRemoteWriteThrottler();
     res.local_throttler = getLocalWriteThrottler();
@@ -5396,7 +5618,7 @@ bool Context::canUseParallelReplicasOnFollower() const
 
 bool Context::canUseParallelReplicasCustomKey(const Cluster & cluster) const
 {
-    return settings.max_parallel_replicas > 1 && getParallelReplicasMode() == Context::ParallelReplicasMode::CUSTOM_KEY
+    return settings->max_parallel_replicas > 1 && getParallelReplicasMode() == Context::ParallelReplicasMode::CUSTOM_KEY
         && cluster.getShardCount() == 1 && cluster.getShardsInfo()[0].getAllNodeCount() > 1;
 }
 
@@ -3,6 +3,7 @@
 #ifndef CLICKHOUSE_KEEPER_STANDALONE_BUILD
 
 #include <base/types.h>
+#include <Common/CopyableAtomic.h>
 #include <Common/isLocalAddress.h>
 #include <Common/MultiVersion.h>
 #include <Common/RemoteHostFilter.h>
@@ -78,6 +79,11 @@ class RefreshSet;
 class Cluster;
 class Compiler;
 class MarkCache;
+class ExternalTablesDedupCache;
+class SortThresholdSlot;
+class SkippingIndexResultCache;
+class FilteredGranuleCache;
+class ApproximateNearestNeighborIndexCache;
 class PageCache;
 class MMappedFileCache;
 class UncompressedCache;
@@ -89,6 +95,8 @@ struct Progress;
 struct FileProgress;
 class Clusters;
 class QueryCache;
+class SubquerySetCache;
+class QueryTreeCache;
 class ISystemLog;
 class QueryLog;
 class QueryThreadLog;
@@ -274,7 +282,16 @@ protected:
     mutable std::shared_ptr<const ContextAccess> access;
     mutable bool need_recalculate_access = true;
     String current_database;
-    Settings settings;  /// Setting for query execution.
+    /// Settings for query execution. Shared between the copies of a context and copied on first
+    /// modification (see Context::getMutableSettings()), so that creating a query context does not
+    /// pay for copying the whole structure. Must only be modified through getMutableSettings().
+    /// Lock-free readers go through `current_settings`, which is republished atomically whenever
+    /// the object is replaced; the replaced objects are retained in `retained_settings` so that
+    /// references taken via getSettingsRef() before a clone stay valid for the lifetime of the
+    /// context.
+    std::shared_ptr<Settings> settings = std::make_shared<Settings>();
+    CopyableAtomic<const Settings *> current_settings{settings.get()};
+    std::vector<std::shared_ptr<Settings>> retained_settings;
 
     using ProgressCallback = std::function<void(const Progress & progress)>;
     ProgressCallback progress_callback;  /// Callback for tracking progress of query execution.
@@ -312,6 +329,10 @@ protected:
     std::optional<MergeTreeAllRangesCallback> merge_tree_all_ranges_callback;
     UUID parallel_replicas_group_uuid{UUIDHelpers::Nil};
 
+    /// Used on the shards of a distributed ORDER BY ... LIMIT query. The initiator pushes
+    /// the current k-th sort key into the slot and sorting transforms discard rows above it.
+    std::shared_ptr<SortThresholdSlot> sort_threshold_slot;
+
     /// This parameter can be set by the HTTP client to tune the behavior of output formats for compatibility.
     UInt64 client_protocol_version = 0;
 
@@ -791,6 +812,12 @@ public:
     Settings getSettings() const;
     void setSettings(const Settings & settings_);
 
+    /// Make sure the settings are not shared with another context. Must be called before code that
+    /// first takes a reference via getSettingsRef() and later modifies settings through this
+    /// context: a modification of shared settings replaces the object (copy-on-write) and the
+    /// previously taken reference would keep pointing to the values from before the modification.
+    void unshareSettings();
+
     /// Set settings by name.
     void setSetting(std::string_view name, const String & value);
     void setSetting(std::string_view name, const Field & value);
@@ -910,7 +937,7 @@ public:
     void makeSessionContext();
     void makeGlobalContext();
 
-    const Settings & getSettingsRef() const { return settings; }
+    const Settings & getSettingsRef() const { return *current_settings.value.load(std::memory_order_acquire); }
 
     void setProgressCallback(ProgressCallback callback);
     /// Used in executeQuery() to pass it to the QueryPipeline.
@@ -990,7 +1017,7 @@ public:
 
     /// --- Caches ------------------------------------------------------------------------------------------
 
-    void setUncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio);
+    void setUncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio, size_t compressed_frames_max_size_in_bytes = 0);
     void updateUncompressedCacheConfiguration(const Poco::Util::AbstractConfiguration & config);
     std::shared_ptr<UncompressedCache> getUncompressedCache() const;
     void clearUncompressedCache() const;
@@ -1005,6 +1032,10 @@ public:
     void clearMarkCache() const;
     ThreadPool & getLoadMarksThreadpool() const;
 
+    /// Content-addressed cache of external tables received from initiators (created lazily,
+    /// sized by the external_tables_dedup_cache_size server setting).
+    std::shared_ptr<ExternalTablesDedupCache> getExternalTablesDedupCache() const;
+
     void setIndexUncompressedCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio);
     void updateIndexUncompressedCacheConfiguration(const Poco::Util::AbstractConfiguration & config);
     std::shared_ptr<UncompressedCache> getIndexUncompressedCache() const;
@@ -1015,6 +1046,21 @@ public:
     std::shared_ptr<MarkCache> getIndexMarkCache() const;
     void clearIndexMarkCache() const;
 
+    void setSkippingIndexResultCache(const String & cache_policy, size_t max_cache_size_in_bytes, double size_ratio);
+    void updateSkippingIndexResultCacheConfiguration(const Poco::Util::AbstractConfiguration & config);
+    std::shared_ptr<SkippingIndexResultCache> getSkippingIndexResultCache() const;
+    void clearSkippingIndexResultCache() const;
+
+    void setFilteredGranuleCache(const String & cache_policy, size_t max_cache_size_in_bytes, double size_ratio);
+    void updateFilteredGranuleCacheConfiguration(const Poco::Util::AbstractConfiguration & config);
+    std::shared_ptr<FilteredGranuleCache> getFilteredGranuleCache() const;
+    void clearFilteredGranuleCache() const;
+
+    void setApproximateNearestNeighborIndexCache(const String & cache_policy, size_t max_cache_size_in_bytes, double size_ratio);
+    void updateApproximateNearestNeighborIndexCacheConfiguration(const Poco::Util::AbstractConfiguration & config);
+    std::shared_ptr<ApproximateNearestNeighborIndexCache> getApproximateNearestNeighborIndexCache() const;
+    void clearApproximateNearestNeighborIndexCache() const;
+
     void setMMappedFileCache(size_t max_cache_size_in_num_entries);
     void updateMMappedFileCacheConfiguration(const Poco::Util::AbstractConfiguration & config);
     std::shared_ptr<MMappedFileCache> getMMappedFileCache() const;
@@ -1025,6 +1071,16 @@ public:
     std::shared_ptr<QueryCache> getQueryCache() const;
     void clearQueryCache() const;
 
+    /// Server-wide cache of sets built from IN subqueries (see setting 'use_subquery_set_cache').
+    /// Created lazily on first use.
+    std::shared_ptr<SubquerySetCache> getSubquerySetCache() const;
+    void clearSubquerySetCache() const;
+
+    /// Server-wide cache of analyzed query trees (see setting 'use_query_tree_cache').
+    /// Created lazily on first use.
+    std::shared_ptr<QueryTreeCache> getQueryTreeCache() const;
+    void clearQueryTreeCache() const;
+
     /** Clear the caches of the uncompressed blocks and marks.
       * This is usually done when renaming tables, changing the type of columns, deleting a table.
       *  - since caches are linked to file names, and become incorrect.
@@ -1242,6 +1298,9 @@ public:
     MergeTreeAllRangesCallback getMergeTreeAllRangesCallback() const;
     void setMergeTreeAllRangesCallback(MergeTreeAllRangesCallback && callback);
 
+    std::shared_ptr<SortThresholdSlot> getSortThresholdSlot() const;
+    void setSortThresholdSlot(std::shared_ptr<SortThresholdSlot> slot);
+
     UUID getParallelReplicasGroupUUID() const;
     void setParallelReplicasGroupUUID(UUID uuid);
 
@@ -1300,6 +1359,9 @@ private:
 
     void setCurrentRolesWithLock(const std::vector<UUID> & current_roles_, const std::lock_guard<ContextSharedMutex> & lock);
 
+    /// Copy-on-write access to the settings: clones them if they are still shared with another context.
+    Settings & getMutableSettings();
+
     void setSettingWithLock(std::string_view name, const String & value, const std::lock_guard<ContextSharedMutex> & lock);
 
     void setSettingWithLock(std::string_view name, const Field & value, const std::lock_guard<ContextSharedMutex> & lock);
@@ -22,7 +22,7 @@ void DNSCacheUpdater::run()
     auto & resolver = DNSResolver::instance();
 
     /// Reload cluster config if IP of any host has been changed since last update.
-    if (resolver.updateCache(max_consecutive_failures))
+    if (resolver.updateCache(max_consecutive_failures, update_period_seconds))
     {
         LOG_INFO(getLogger("DNSCacheUpdater"), "IPs of some hosts have been changed. Will reload cluster config.");
         try
@@ -5,6 +5,7 @@
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeTuple.h>
 #include <IO/WriteHelpers.h>
+#include <Interpreters/Cache/ScalarSubqueryCache.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/InterpreterSelectWithUnionQuery.h>
 #include <Interpreters/addTypeConversionToAST.h>
@@ -108,6 +109,7 @@ void ExecuteScalarSubqueriesMatcher::visit(const ASTSubquery & subquery, ASTPtr
     /// Save these fields to avoid use after move.
     String subquery_alias = subquery.alias;
     bool prefer_alias_to_column_name = subquery.prefer_alias_to_column_name;
+    ASTPtr subquery_ast = ast;
 
     auto hash = subquery.getTreeHash(/*ignore_aliases=*/ true);
     const auto scalar_query_hash_str = toString(hash);
@@ -162,6 +164,21 @@ void ExecuteScalarSubqueriesMatcher::visit(const ASTSubquery & subquery, ASTPtr
         }
     }
 
+    /// The server-wide cache shares scalar results across queries (see ScalarSubqueryCache.h).
+    /// It is consulted after the per-query caches because its entries have to be validated
+    /// against the current partition versions of the tables the subquery reads.
+    const bool use_scalar_subquery_cache = data.getContext()->getSettingsRef().use_scalar_subquery_cache
+        && !data.only_analyze && !data.getContext()->getViewSource();
+
+    if (!hit && use_scalar_subquery_cache)
+    {
+        if (auto cached_scalar = ScalarSubqueryCache::instance().get(scalar_query_hash_str, subquery_ast, data.getContext()))
+        {
+            hit = true;
+            scalar = std::move(*cached_scalar);
+        }
+    }
+
     if (!hit)
     {
         if (!interpreter)
@@ -262,6 +279,9 @@ void ExecuteScalarSubqueriesMatcher::visit(const ASTSubquery & subquery, ASTPtr
                 std::make_shared<DataTypeTuple>(block.getDataTypes()),
                 "tuple"});
         }
+
+        if (use_scalar_subquery_cache && !is_local)
+            ScalarSubqueryCache::instance().set(scalar_query_hash_str, subquery_ast, scalar, data.getContext());
     }
 
     const Settings & settings = data.getContext()->getSettingsRef();
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+
+#include <Common/CacheBase.h>
+#include <Common/HashTable/Hash.h>
+#include <Core/Block.h>
+
+
+namespace DB
+{
+
+/// Estimate of number of bytes a cached external table occupies.
+struct ExternalTableBlocksWeightFunction
+{
+    size_t operator()(const Blocks & blocks) const
+    {
+        size_t res = 0;
+        for (const auto & block : blocks)
+            res += block.allocatedBytes();
+        return res;
+    }
+};
+
+/** Content-addressed cache of external tables received from initiators.
+  * An initiator that supports it announces the content hashes of the external tables
+  * it is about to send (Protocol::Client::ExternalTablesHashes), and the server requests
+  * only the tables missing from this cache, skipping repeated transfers of e.g. the same
+  * GLOBAL JOIN right-hand side broadcast with every query.
+  */
+class ExternalTablesDedupCache : public CacheBase<UInt128, Blocks, UInt128TrivialHash, ExternalTableBlocksWeightFunction>
+{
+public:
+    explicit ExternalTablesDedupCache(size_t max_size_in_bytes)
+        : CacheBase(max_size_in_bytes)
+    {
+    }
+};
+
+using ExternalTablesDedupCachePtr = std::shared_ptr<ExternalTablesDedupCache>;
+
+}
@@ -625,6 +625,7 @@ IBlocksStreamPtr GraceHashJoin::getDelayedBlocks()
     for (bucket_idx = bucket_idx + 1; bucket_idx < buckets.size(); ++bucket_idx)
     {
         current_bucket = buckets[bucket_idx].get();
+        current_bucket_skewed = false;
         if (current_bucket->finished() || current_bucket->empty())
         {
             LOG_TRACE(log, "Skipping {} {} bucket {}",
@@ -701,7 +702,7 @@ void GraceHashJoin::addBlockToJoinImpl(Block block)
         auto prev_keys_num = hash_join->getTotalRowCount();
         hash_join->addBlockToJoin(current_block, /* check_limits = */ false);
 
-        if (!hasMemoryOverflow(hash_join))
+        if (!hasMemoryOverflow(hash_join) || current_bucket_skewed)
             return;
 
         current_block = {};
@@ -711,11 +712,13 @@ void GraceHashJoin::addBlockToJoinImpl(Block block)
         auto right_blocks = hash_join->releaseJoinedBlocks(/* restructure */ false);
         hash_join = nullptr;
 
+        size_t released_rows = 0;
         {
             Blocks current_blocks;
             current_blocks.reserve(right_blocks.size());
             for (const auto & right_block : right_blocks)
             {
+                released_rows += right_block.rows();
                 Blocks blocks = JoinCommon::scatterBlockByHash(right_key_names, right_block, buckets_snapshot.size());
                 flushBlocksToBuckets<JoinTableSide::Right>(blocks, buckets_snapshot, bucket_index);
                 current_blocks.emplace_back(std::move(blocks[bucket_index]));
@@ -727,6 +730,16 @@ void GraceHashJoin::addBlockToJoinImpl(Block block)
                 current_block = concatenateBlocks(current_blocks);
         }
 
+        /// If almost all rows stayed in this bucket, the keys are too skewed for repartitioning
+        /// to help (in the worst case all rows share one key). Stop rehashing for this bucket
+        /// and finish it in memory instead of re-spilling the same rows on every overflow.
+        if (current_block.rows() * 8 > released_rows * 7)
+        {
+            LOG_TRACE(log, "Rehash of bucket {} moved out only {} of {} rows, considering it skewed and keeping it in memory",
+                bucket_index, released_rows - current_block.rows(), released_rows);
+            current_bucket_skewed = true;
+        }
+
         hash_join = makeInMemoryJoin(fmt::format("grace{}", bucket_index), prev_keys_num);
 
         if (current_block.rows() > 0)
@@ -140,6 +140,11 @@ private:
 
     FileBucket * current_bucket = nullptr;
 
+    /// Set when a rehash barely moved any rows out of the current bucket (heavily skewed keys).
+    /// Further rehashes of this bucket would only re-spill the same rows, so they are suppressed
+    /// and the bucket is joined in memory even above the memory limit.
+    bool current_bucket_skewed = false;
+
     mutable std::mutex current_bucket_mutex;
 
     InMemoryJoinPtr hash_join;
@@ -34,6 +34,7 @@
 #include <Common/Exception.h>
 #include <Common/typeid_cast.h>
 #include <Common/assert_cast.h>
+#include <Common/WeakHash.h>
 #include <Common/formatReadable.h>
 #include "Core/Joins.h"
 #include "Interpreters/TemporaryDataOnDisk.h"
@@ -386,12 +387,17 @@ HashJoin::Type HashJoin::chooseMethod(JoinKind kind, const ColumnRawPtrs & key_c
         if (size_of_field == 8)
             return Type::key64;
         if (size_of_field == 16)
-            return Type::keys128;
+            return Type::key128;
         if (size_of_field == 32)
             return Type::keys256;
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Numeric column has sizeOfField not in 1, 2, 4, 8, 16, 32.");
     }
 
+    /// If there is one 16-byte key stored in a fixed contiguous column (UUID, IPv6, FixedString(16)),
+    /// its values can be used as hash table keys directly, without packing.
+    if (keys_size == 1 && key_columns[0]->isFixedAndContiguous() && key_columns[0]->sizeOfValueIfFixed() == 16)
+        return Type::key128;
+
     /// If the keys fit in N bits, we will use a hash table for N-bit-packed keys
     if (all_fixed && keys_bytes <= 16)
         return Type::keys128;
@@ -421,6 +427,16 @@ HashJoin::Type HashJoin::chooseMethod(JoinKind kind, const ColumnRawPtrs & key_c
     return Type::hashed;
 }
 
+/// Per-row hashes of the key columns for the key bloom filter.
+/// Build and probe sides must hash materialized key columns of the same types for the hashes to agree.
+static WeakHash32 calculateJoinKeyHashes(const ColumnRawPtrs & key_columns, size_t rows)
+{
+    WeakHash32 hash(rows);
+    for (const auto * key_column : key_columns)
+        key_column->updateWeakHash32(hash);
+    return hash;
+}
+
 template <typename KeyGetter, bool is_asof_join>
 static KeyGetter createKeyGetter(const ColumnRawPtrs & key_columns, const Sizes & key_sizes)
 {
@@ -477,6 +493,10 @@ template <typename Value, typename Mapped> struct KeyGetterForTypeImpl<HashJoin:
 {
     using Type = ColumnsHashing::HashMethodOneNumber<Value, Mapped, UInt64, false, use_offset>;
 };
+template <typename Value, typename Mapped> struct KeyGetterForTypeImpl<HashJoin::Type::key128, Value, Mapped>
+{
+    using Type = ColumnsHashing::HashMethodOneNumber<Value, Mapped, UInt128, false, use_offset>;
+};
 template <typename Value, typename Mapped> struct KeyGetterForTypeImpl<HashJoin::Type::key_string, Value, Mapped>
 {
     using Type = ColumnsHashing::HashMethodString<Value, Mapped, true, false, use_offset>;
@@ -784,6 +804,8 @@ bool HashJoin::addBlockToJoin(const Block & source_block_, bool check_limits)
     if (unlikely(source_block_.rows() > std::numeric_limits<RowRef::SizeT>::max()))
         throw Exception(ErrorCodes::NOT_IMPLEMENTED, "Too many rows in right table block for HashJoin: {}", source_block_.rows());
 
+    updateRuntimeFilters(source_block_);
+
     /** We do not allocate memory for stored blocks inside HashJoin, only for hash table.
       * In case when we have all the blocks allocated before the first `addBlockToJoin` call, will already be quite high.
       * In that case memory consumed by stored blocks will be underestimated.
@@ -891,6 +913,18 @@ bool HashJoin::addBlockToJoin(const Block & source_block_, bool check_limits)
             ConstNullMapPtr null_map{};
             ColumnPtr null_map_holder = extractNestedColumnsAndNullMap(key_columns, null_map);
 
+            /// Remember hashes of the inserted keys (a superset of them: rows filtered out by
+            /// the JOIN ON condition are added too), so that the probe side can skip lookups
+            /// for keys that are definitely absent. Only for a single join clause: with
+            /// disjuncts a key may be absent in one map but present in another.
+            if (onexprs.size() == 1 && kind != JoinKind::Cross && strictness != JoinStrictness::Asof)
+            {
+                const auto & hashes = calculateJoinKeyHashes(key_columns, rows).getData();
+                for (size_t i = 0; i < rows; ++i)
+                    if (!null_map || !(*null_map)[i])
+                        data->key_bloom_filter.add(intHash64(hashes[i]));
+            }
+
             /// If RIGHT or FULL save blocks with nulls for NotJoinedBlocks
             UInt8 save_nullmap = 0;
             if (isRightOrFull(kind) && null_map)
@@ -1048,6 +1082,10 @@ struct JoinOnKeyColumns
     /// Only rows where mask == true can be joined
     JoinCommon::JoinMask join_mask_column;
 
+    /// Rows whose key is definitely absent from the right table according to the key bloom filter.
+    /// They are treated as non-matching without probing the hash table.
+    IColumn::Filter bloom_filtered;
+
     Sizes key_sizes;
 
     explicit JoinOnKeyColumns(const Block & block, const Names & key_names_, const String & cond_column_name, const Sizes & key_sizes_)
@@ -1061,7 +1099,10 @@ struct JoinOnKeyColumns
     {
     }
 
-    bool isRowFiltered(size_t i) const { return join_mask_column.isRowFiltered(i); }
+    bool isRowFiltered(size_t i) const
+    {
+        return (!bloom_filtered.empty() && bloom_filtered[i]) || join_mask_column.isRowFiltered(i);
+    }
 };
 
 template <bool lazy>
@@ -2155,6 +2196,18 @@ Block HashJoin::joinBlockImpl(
         const auto & key_names = !is_join_get ? onexprs[i].key_names_left : onexprs[i].key_names_right;
         join_on_keys.emplace_back(block, key_names, onexprs[i].condColumnNames().first, key_sizes[i]);
     }
+
+    /// Pre-probe the key bloom filter: rows whose key is definitely absent from the right table
+    /// are marked as non-matching upfront and skip the hash table lookup entirely.
+    if (join_on_keys.size() == 1 && data->key_bloom_filter.enabled())
+    {
+        auto & join_keys = join_on_keys.front();
+        const auto & hashes = calculateJoinKeyHashes(join_keys.key_columns, block.rows()).getData();
+        join_keys.bloom_filtered.resize(hashes.size());
+        for (size_t i = 0; i < hashes.size(); ++i)
+            join_keys.bloom_filtered[i] = !data->key_bloom_filter.contains(intHash64(hashes[i]));
+    }
+
     size_t existing_columns = block.columns();
 
     /** If you use FULL or RIGHT JOIN, then the columns from the "left" table must be materialized.
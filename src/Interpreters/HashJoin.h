@@ -75,6 +75,52 @@ public:
     bool setUsedOnce(const T & f);
 };
 
+/** Blocked bloom filter over hashes of the right table keys.
+  * It is populated during the build phase with a superset of the keys stored in the hash table
+  * and allows the probe side to skip hash table lookups for rows whose key is definitely absent.
+  * Each key sets two bits within a single cache-resident 64-bit word, so a negative answer
+  * costs one memory access. The filter never gives false negatives; if too many keys are added
+  * for its fixed size, it disables itself instead of degrading to an all-ones filter.
+  */
+class JoinKeyBloomFilter
+{
+public:
+    void add(UInt64 hash)
+    {
+        if (words.empty())
+            words.resize_fill(NUM_WORDS);
+
+        if (++num_keys > MAX_KEYS)
+        {
+            words = {};
+            return;
+        }
+
+        words[wordIdx(hash)] |= wordMask(hash);
+    }
+
+    bool contains(UInt64 hash) const
+    {
+        UInt64 mask = wordMask(hash);
+        return (words[wordIdx(hash)] & mask) == mask;
+    }
+
+    /// The filter is usable only if at least one key was added and it was not overloaded.
+    bool enabled() const { return !words.empty() && num_keys <= MAX_KEYS; }
+
+private:
+    /// 256 KiB of bits; with the load limited to 8 bits of capacity per key
+    /// the false positive rate stays in the low percent range.
+    static constexpr size_t NUM_WORDS = (256 * 1024) / sizeof(UInt64);
+    static constexpr size_t MAX_KEYS = NUM_WORDS * 8;
+
+    static size_t wordIdx(UInt64 hash) { return (hash >> 32) & (NUM_WORDS - 1); }
+    static UInt64 wordMask(UInt64 hash) { return (1ULL << (hash & 63)) | (1ULL << ((hash >> 6) & 63)); }
+
+    PaddedPODArray<UInt64> words;
+    size_t num_keys = 0;
+};
+
 }
 
 /** Data structure for implementation of JOIN.
@@ -229,6 +275,7 @@ public:
         M(key16)                       \
         M(key32)                       \
         M(key64)                       \
+        M(key128)                      \
         M(key_string)                  \
         M(key_fixed_string)            \
         M(keys128)                     \
@@ -239,6 +286,7 @@ public:
     #define APPLY_FOR_HASH_JOIN_VARIANTS(M) \
         M(key32)                            \
         M(key64)                            \
+        M(key128)                           \
         M(key_string)                       \
         M(key_fixed_string)                 \
         M(keys128)                          \
@@ -274,6 +322,7 @@ public:
         std::unique_ptr<FixedHashMap<UInt16, Mapped>>                 key16;
         std::unique_ptr<HashMap<UInt32, Mapped, HashCRC32<UInt32>>>   key32;
         std::unique_ptr<HashMap<UInt64, Mapped, HashCRC32<UInt64>>>   key64;
+        std::unique_ptr<HashMap<UInt128, Mapped, UInt128HashCRC32>>   key128;
         std::unique_ptr<HashMapWithSavedHash<StringRef, Mapped>>      key_string;
         std::unique_ptr<HashMapWithSavedHash<StringRef, Mapped>>      key_fixed_string;
         std::unique_ptr<HashMap<UInt128, Mapped, UInt128HashCRC32>>   keys128;
@@ -376,6 +425,10 @@ public:
         /// Additional data - strings for string keys and continuation elements of single-linked lists of references to rows.
         Arena pool;
 
+        /// Filled with hashes of the right keys during the build phase (single join clause only),
+        /// lets the probe side skip lookups for keys that are definitely not in the table.
+        JoinStuff::JoinKeyBloomFilter key_bloom_filter;
+
         size_t blocks_allocated_size = 0;
         size_t blocks_nullmaps_allocated_size = 0;
     };
@@ -7,6 +7,7 @@
 #include <Core/Block.h>
 #include <Columns/IColumn.h>
 #include <Common/Exception.h>
+#include <Interpreters/JoinRuntimeFilter.h>
 
 namespace DB
 {
@@ -119,8 +120,31 @@ public:
     virtual IBlocksStreamPtr
         getNonJoinedBlocks(const Block & left_sample_block, const Block & result_sample_block, UInt64 max_block_size) const = 0;
 
+    /// Attach a runtime filter to be filled from build-side blocks.
+    /// Called at query plan time, before any data is processed. Honored only by joins
+    /// which call updateRuntimeFilters() from addBlockToJoin() (hash join family).
+    void addRuntimeFilter(JoinRuntimeFilterPtr filter) { runtime_filters.push_back(std::move(filter)); }
+    bool hasRuntimeFilters() const { return !runtime_filters.empty(); }
+
+    /// Called by JoiningTransform when the build side is complete and before any probe-side block is processed.
+    virtual void onBuildComplete()
+    {
+        for (const auto & filter : runtime_filters)
+            filter->finalize();
+    }
+
+protected:
+    /// Derived joins should call this for every build-side block.
+    void updateRuntimeFilters(const Block & block)
+    {
+        for (const auto & filter : runtime_filters)
+            if (const auto * column = block.findByName(filter->getBuildColumnName()))
+                filter->update(*column->column);
+    }
+
 private:
     Block totals;
+    JoinRuntimeFilters runtime_filters;
 };
 
 class IBlocksStream
@@ -93,24 +93,30 @@ BlockIO InterpreterExplainQuery::execute()
 }
 
 
-Block InterpreterExplainQuery::getSampleBlock(const ASTExplainQuery::ExplainKind kind)
+Block InterpreterExplainQuery::getSampleBlock(const ASTExplainQuery::ExplainKind kind, bool estimates_by_plan_node)
 {
     if (kind == ASTExplainQuery::ExplainKind::QueryEstimates)
     {
-        auto cols = NamesAndTypes{
-            {"database", std::make_shared<DataTypeString>()},
-            {"table", std::make_shared<DataTypeString>()},
-            {"parts", std::make_shared<DataTypeUInt64>()},
-            {"rows", std::make_shared<DataTypeUInt64>()},
-            {"marks", std::make_shared<DataTypeUInt64>()},
-        };
-        return Block({
-            {cols[0].type->createColumn(), cols[0].type, cols[0].name},
-            {cols[1].type->createColumn(), cols[1].type, cols[1].name},
-            {cols[2].type->createColumn(), cols[2].type, cols[2].name},
-            {cols[3].type->createColumn(), cols[3].type, cols[3].name},
-            {cols[4].type->createColumn(), cols[4].type, cols[4].name},
-        });
+        auto cols = estimates_by_plan_node
+            ? NamesAndTypes{
+                {"step", std::make_shared<DataTypeString>()},
+                {"description", std::make_shared<DataTypeString>()},
+                {"estimated_rows", std::make_shared<DataTypeUInt64>()},
+                {"estimated_bytes", std::make_shared<DataTypeUInt64>()},
+                {"estimated_memory_bytes", std::make_shared<DataTypeUInt64>()},
+                {"may_spill", std::make_shared<DataTypeUInt8>()},
+            }
+            : NamesAndTypes{
+                {"database", std::make_shared<DataTypeString>()},
+                {"table", std::make_shared<DataTypeString>()},
+                {"parts", std::make_shared<DataTypeUInt64>()},
+                {"rows", std::make_shared<DataTypeUInt64>()},
+                {"marks", std::make_shared<DataTypeUInt64>()},
+            };
+        Block block;
+        for (const auto & col : cols)
+            block.insert({col.type->createColumn(), col.type, col.name});
+        return block;
     }
     else
     {
@@ -231,6 +237,22 @@ struct QueryPipelineSettings
     std::unordered_map<std::string, std::reference_wrapper<Int64>> integer_settings;
 };
 
+struct QueryEstimatesSettings
+{
+    /// Report per-plan-step estimates (output cardinality, accumulated memory, possible spills)
+    /// instead of the per-table scan summary.
+    bool plan_nodes = false;
+
+    constexpr static char name[] = "ESTIMATE";
+
+    std::unordered_map<std::string, std::reference_wrapper<bool>> boolean_settings =
+    {
+            {"plan_nodes", plan_nodes},
+    };
+
+    std::unordered_map<std::string, std::reference_wrapper<Int64>> integer_settings;
+};
+
 template <typename Settings>
 struct ExplainSettings : public Settings
 {
@@ -351,7 +373,9 @@ QueryPipeline InterpreterExplainQuery::executeImpl()
 {
     const auto & ast = query->as<const ASTExplainQuery &>();
 
-    Block sample_block = getSampleBlock(ast.getKind());
+    bool estimates_by_plan_node = ast.getKind() == ASTExplainQuery::ExplainKind::QueryEstimates
+        && checkAndGetSettings<QueryEstimatesSettings>(ast.getSettings()).plan_nodes;
+    Block sample_block = getSampleBlock(ast.getKind(), estimates_by_plan_node);
     MutableColumns res_columns = sample_block.cloneEmptyColumns();
 
     WriteBufferFromOwnString buf;
@@ -537,7 +561,6 @@ QueryPipeline InterpreterExplainQuery::executeImpl()
             if (!dynamic_cast<const ASTSelectWithUnionQuery *>(ast.getExplainedQuery().get()))
                 throw Exception(ErrorCodes::INCORRECT_QUERY, "Only SELECT is supported for EXPLAIN ESTIMATE query");
 
-            auto settings = checkAndGetSettings<QueryPlanSettings>(ast.getSettings());
             QueryPlan plan;
             ContextPtr context = getContext();
 
@@ -561,7 +584,10 @@ QueryPipeline InterpreterExplainQuery::executeImpl()
                 QueryPlanOptimizationSettings::fromContext(context),
                 BuildQueryPipelineSettings::fromContext(context));
 
-            plan.explainEstimate(res_columns);
+            if (estimates_by_plan_node)
+                plan.explainEstimateSteps(res_columns);
+            else
+                plan.explainEstimate(res_columns);
             insert_buf = false;
             break;
         }
@@ -15,7 +15,7 @@ public:
 
     BlockIO execute() override;
 
-    static Block getSampleBlock(ASTExplainQuery::ExplainKind kind);
+    static Block getSampleBlock(ASTExplainQuery::ExplainKind kind, bool estimates_by_plan_node = false);
 
     bool supportsTransactions() const override { return true; }
 
@@ -3,6 +3,7 @@
 
 #include <Access/Common/AccessFlags.h>
 #include <Access/EnabledQuota.h>
+#include <Access/EnabledRowPolicies.h>
 #include <AggregateFunctions/AggregateFunctionFactory.h>
 #include <Columns/ColumnNullable.h>
 #include <Processors/Transforms/buildPushingToViewsChain.h>
@@ -16,8 +17,11 @@
 #include <Interpreters/getTableExpressions.h>
 #include <Interpreters/processColumnTransformers.h>
 #include <Interpreters/InterpreterSelectQueryAnalyzer.h>
+#include <Parsers/ASTAsterisk.h>
 #include <Parsers/ASTFunction.h>
 #include <Parsers/ASTInsertQuery.h>
+#include <Parsers/ASTLiteral.h>
+#include <Parsers/ASTPartition.h>
 #include <Parsers/ASTSelectQuery.h>
 #include <Parsers/ASTSelectWithUnionQuery.h>
 #include <Parsers/ASTTablesInSelectQuery.h>
@@ -30,6 +34,7 @@
 #include <Processors/Transforms/getSourceFromASTInsertQuery.h>
 #include <Processors/QueryPlan/QueryPlan.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
+#include <Storages/MergeTree/MergeTreeData.h>
 #include <Storages/StorageDistributed.h>
 #include <Storages/StorageMaterializedView.h>
 #include <Storages/WindowView/StorageWindowView.h>
@@ -271,6 +276,97 @@ static bool isTrivialSelect(const ASTPtr & select)
     return false;
 }
 
+/** For INSERT INTO t2 SELECT * FROM t1: the table whose data is read wholesale,
+  * without any transformation, filtering or reordering of rows and columns.
+  * Returns nullptr if the SELECT is anything more than that.
+  */
+static StoragePtr tryGetWholeTableSource(const ASTPtr & select, ContextPtr context)
+{
+    const auto * select_with_union = select->as<ASTSelectWithUnionQuery>();
+    if (!select_with_union || select_with_union->list_of_selects->children.size() != 1)
+        return nullptr;
+
+    const auto & single_select = select_with_union->list_of_selects->children.front();
+    if (!isTrivialSelect(single_select))
+        return nullptr;
+
+    const auto & select_query = single_select->as<ASTSelectQuery &>();
+    if (select_query.limitLength() || select_query.limitOffset() || select_query.with())
+        return nullptr;
+
+    /// The select list must be a bare asterisk.
+    const auto & select_expressions = select_query.select()->children;
+    if (select_expressions.size() != 1 || !select_expressions.front()->as<ASTAsterisk>())
+        return nullptr;
+
+    const auto & table_element = select_query.tables()->as<ASTTablesInSelectQuery &>().children.front()->as<ASTTablesInSelectQueryElement &>();
+    if (table_element.table_join || table_element.array_join)
+        return nullptr;
+
+    const auto & table_expr = table_element.table_expression->as<ASTTableExpression &>();
+    if (!table_expr.database_and_table_name || table_expr.final || table_expr.sample_size)
+        return nullptr;
+
+    auto table_id = context->resolveStorageID(table_expr.database_and_table_name);
+    return DatabaseCatalog::instance().tryGetTable(table_id, context);
+}
+
+std::optional<BlockIO> InterpreterInsertQuery::trySelectByCloningParts(const ASTInsertQuery & query, const StoragePtr & table)
+{
+    auto source = tryGetWholeTableSource(query.select, getContext());
+    if (!source || source.get() == table.get())
+        return {};
+
+    auto * dest_merge_tree = dynamic_cast<MergeTreeData *>(table.get());
+    if (!dest_merge_tree || !dynamic_cast<MergeTreeData *>(source.get()))
+        return {};
+
+    /// Pushing to dependent views needs the rows to flow through the pipeline.
+    if (!DatabaseCatalog::instance().getDependentViews(table->getStorageID()).empty())
+        return {};
+
+    /// Attaching parts is not transactional.
+    if (getContext()->getCurrentTransaction())
+        return {};
+
+    /// The same compatibility requirements as ALTER TABLE ... ATTACH PARTITION FROM:
+    /// identical columns, sorting key and partition key. Otherwise fall back to the
+    /// regular row-by-row insertion.
+    try
+    {
+        dest_merge_tree->checkStructureAndGetMergeTreeData(source, source->getInMemoryMetadataPtr(), table->getInMemoryMetadataPtr());
+    }
+    catch (const Exception &)
+    {
+        return {};
+    }
+
+    /// The regular path would check it while interpreting the SELECT.
+    getContext()->checkAccess(AccessType::SELECT, source->getStorageID(), source->getInMemoryMetadataPtr()->getColumns().getNamesOfPhysical());
+
+    /// A row policy on the source is applied by the SELECT pipeline, which this path bypasses:
+    /// attaching parts as-is would copy the rows the policy hides.
+    auto row_policy_filter = getContext()->getRowPolicyFilter(
+        source->getStorageID().getDatabaseName(), source->getStorageID().getTableName(), RowPolicyFilterType::SELECT_FILTER);
+    if (row_policy_filter && !row_policy_filter->empty())
+        return {};
+
+    auto partition_ids = dynamic_cast<MergeTreeData &>(*source).getAllPartitionIds();
+    LOG_DEBUG(
+        getLogger("InsertQuery"),
+        "Executing INSERT SELECT from {} to {} by attaching cloned parts of {} partitions",
+        source->getStorageID().getNameForLogs(), table->getStorageID().getNameForLogs(), partition_ids.size());
+
+    for (const auto & partition_id : partition_ids)
+    {
+        auto partition = std::make_shared<ASTPartition>();
+        partition->setPartitionID(std::make_shared<ASTLiteral>(partition_id));
+        dest_merge_tree->replacePartitionFrom(source, partition, /* replace */ false, getContext());
+    }
+
+    return BlockIO{};
+}
+
 Chain InterpreterInsertQuery::buildChain(
     const StoragePtr & table,
     const StorageMetadataPtr & metadata_snapshot,
@@ -422,6 +518,14 @@ BlockIO InterpreterInsertQuery::execute()
     if (!query.table_function)
         getContext()->checkAccess(AccessType::INSERT, query.table_id, query_sample_block.getNames());
 
+    /// INSERT INTO t2 SELECT * FROM t1 between MergeTree tables with identical structure
+    /// and keys can attach cloned (hard-linked) parts instead of rewriting every row.
+    if (query.select && !query.columns && !no_destination && settings.insert_select_clone_parts)
+    {
+        if (auto res = trySelectByCloningParts(query, table))
+            return std::move(*res);
+    }
+
     if (query.select && settings.parallel_distributed_insert_select)
         // Distributed INSERT SELECT
         distributed_pipeline = table->distributedWrite(query, getContext());
@@ -86,6 +86,11 @@ private:
         ThreadGroupPtr running_group,
         std::atomic_uint64_t * elapsed_counter_ms);
 
+    /// INSERT SELECT that reads a whole compatible MergeTree table without transformations
+    /// can be executed by attaching cloned parts (see the insert_select_clone_parts setting).
+    /// Returns an empty result if the fast path was taken, nothing to fall back.
+    std::optional<BlockIO> trySelectByCloningParts(const ASTInsertQuery & query, const StoragePtr & table);
+
     Chain buildPreSinkChain(
         const Block & subsequent_header,
         const StoragePtr & table,
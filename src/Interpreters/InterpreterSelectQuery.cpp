@@ -66,6 +66,7 @@
 #include <Processors/QueryPlan/RollupStep.h>
 #include <Processors/QueryPlan/TotalsHavingStep.h>
 #include <Processors/QueryPlan/WindowStep.h>
+#include <Processors/QueryPlan/Optimizations/Optimizations.h>
 #include <Processors/QueryPlan/Optimizations/QueryPlanOptimizationSettings.h>
 #include <Processors/Sources/NullSource.h>
 #include <Processors/Sources/SourceFromSingleChunk.h>
@@ -1745,7 +1746,26 @@ void InterpreterSelectQuery::executeImpl(QueryPlan & query_plan, std::optional<P
                         bool has_non_const_keys = has_non_const(query_plan.getCurrentDataStream().header, join_clause.key_names_left)
                             && has_non_const(joined_plan->getCurrentDataStream().header, join_clause.key_names_right);
 
-                        if (settings.max_rows_in_set_to_optimize_join > 0 && kind_allows_filtering && has_non_const_keys)
+                        /// If an input is already readable in the order of the join keys, the sort above it
+                        /// will be turned into a streaming FinishSorting by the read-in-order optimization.
+                        /// Filtering by on-the-fly sets would suppress that (see the note above) and relies
+                        /// on both sorts buffering their whole input, so reading in order is preferred.
+                        auto join_key_order_is_available = [&](QueryPlan & plan, const Names & key_names)
+                        {
+                            if (!settings.optimize_read_in_order || !settings.query_plan_read_in_order)
+                                return false;
+
+                            SortDescription description;
+                            description.reserve(key_names.size());
+                            for (const auto & key_name : key_names)
+                                description.emplace_back(key_name);
+
+                            return QueryPlanOptimizations::canSubtreeBeReadInOrder(*plan.getRootNode(), description);
+                        };
+
+                        if (settings.max_rows_in_set_to_optimize_join > 0 && kind_allows_filtering && has_non_const_keys
+                            && !join_key_order_is_available(query_plan, join_clause.key_names_left)
+                            && !join_key_order_is_available(*joined_plan, join_clause.key_names_right))
                         {
                             auto * left_set = add_create_set(query_plan, join_clause.key_names_left, JoinTableSide::Left);
                             auto * right_set = add_create_set(*joined_plan, join_clause.key_names_right, JoinTableSide::Right);
@@ -3224,6 +3244,11 @@ bool InterpreterSelectQuery::autoFinalOnQuery(ASTSelectQuery & query)
 
 void InterpreterSelectQuery::initSettings()
 {
+    /// The interpreter modifies settings of the context during planning (e.g. disables parallel
+    /// replicas) while holding references obtained from getSettingsRef(), so the settings must not
+    /// be shared with another context.
+    context->unshareSettings();
+
     auto & query = getSelectQuery();
     if (query.settings())
         InterpreterSetQuery(query.settings(), context).executeForCurrentContext(options.ignore_setting_constraints);
@@ -18,6 +18,7 @@
 #include <Storages/IStorage.h>
 
 #include <Analyzer/QueryTreeBuilder.h>
+#include <Analyzer/QueryTreeCache.h>
 #include <Analyzer/QueryTreePassManager.h>
 #include <Analyzer/IdentifierNode.h>
 #include <Analyzer/QueryNode.h>
@@ -128,6 +129,27 @@ QueryTreeNodePtr buildQueryTreeAndRunPasses(const ASTPtr & query,
     const ContextPtr & context,
     const StoragePtr & storage)
 {
+    /// For repeated top-level queries the analyzed tree can be taken from the server-wide cache,
+    /// skipping the pass stack below (see QueryTreeCache).
+    QueryTreeCachePtr query_tree_cache;
+    QueryTreeCache::Key cache_key{};
+
+    bool use_query_tree_cache = context->getSettingsRef().use_query_tree_cache
+        && !storage
+        && !select_query_options.only_analyze
+        && !select_query_options.ignore_ast_optimizations
+        && select_query_options.subquery_depth == 0
+        && context->getClientInfo().query_kind != ClientInfo::QueryKind::SECONDARY_QUERY;
+
+    if (use_query_tree_cache)
+    {
+        query_tree_cache = context->getQueryTreeCache();
+        cache_key = QueryTreeCache::makeKey(query, context);
+
+        if (auto cached_query_tree = query_tree_cache->find(cache_key, context))
+            return cached_query_tree;
+    }
+
     auto query_tree = buildQueryTree(query, context);
 
     QueryTreePassManager query_tree_pass_manager(context);
@@ -144,6 +166,9 @@ QueryTreeNodePtr buildQueryTreeAndRunPasses(const ASTPtr & query,
     if (storage)
         replaceStorageInQueryTree(query_tree, context, storage);
 
+    if (use_query_tree_cache)
+        query_tree_cache->add(cache_key, query_tree);
+
     return query_tree;
 }
 
@@ -0,0 +1,35 @@
+#include <Interpreters/JoinRuntimeFilter.h>
+
+#include <Columns/IColumn.h>
+#include <Common/FieldVisitorsAccurateComparison.h>
+
+namespace DB
+{
+
+void JoinRuntimeFilter::update(const IColumn & column)
+{
+    /// Extremes are defined only for full columns.
+    auto full_column = column.convertToFullColumnIfConst()->convertToFullColumnIfSparse();
+    if (full_column->empty())
+        return;
+
+    Field column_min;
+    Field column_max;
+    full_column->getExtremes(column_min, column_max);
+
+    std::lock_guard lock(mutex);
+    if (!has_rows)
+    {
+        min = std::move(column_min);
+        max = std::move(column_max);
+        has_rows = true;
+        return;
+    }
+
+    if (applyVisitor(FieldVisitorAccurateLess(), column_min, min))
+        min = std::move(column_min);
+    if (applyVisitor(FieldVisitorAccurateLess(), max, column_max))
+        max = std::move(column_max);
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Core/Field.h>
+#include <DataTypes/IDataType.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace DB
+{
+
+class IColumn;
+
+/// Min/max of a join key observed on the build (right) side of a hash join.
+///
+/// The filter is created by the addJoinRuntimeFilter plan optimization, filled by the join
+/// for every build-side block, and marked ready when the build side is complete. Since the
+/// probe side of a FillRightFirst join starts only after the build is finished (JoiningTransform
+/// does not pull left data before the filling side closes its signal port), the probe-side
+/// MergeTree scan can use the observed key range to prune mark ranges from the first read on.
+class JoinRuntimeFilter
+{
+public:
+    JoinRuntimeFilter(
+        String probe_column_name_, DataTypePtr probe_column_type_,
+        String build_column_name_, DataTypePtr build_column_type_)
+        : probe_column_name(std::move(probe_column_name_))
+        , probe_column_type(std::move(probe_column_type_))
+        , build_column_name(std::move(build_column_name_))
+        , build_column_type(std::move(build_column_type_))
+    {
+    }
+
+    /// Name and type of the key column in the probe-side scan.
+    const String & getProbeColumnName() const { return probe_column_name; }
+    const DataTypePtr & getProbeColumnType() const { return probe_column_type; }
+
+    /// Name and type of the key column in build-side blocks.
+    const String & getBuildColumnName() const { return build_column_name; }
+    const DataTypePtr & getBuildColumnType() const { return build_column_type; }
+
+    /// Merge min/max of the given build-side key column into the filter. Thread-safe.
+    void update(const IColumn & column);
+
+    /// Called when the build side is complete and no more updates will arrive.
+    void finalize() { ready.store(true, std::memory_order_release); }
+
+    bool isReady() const { return ready.load(std::memory_order_acquire); }
+
+    /// The following may be called only after the filter is ready.
+    /// If hasRows() is false, the build side is empty and the probe side can be skipped entirely.
+    bool hasRows() const { return has_rows; }
+    const Field & getMin() const { return min; }
+    const Field & getMax() const { return max; }
+
+private:
+    const String probe_column_name;
+    const DataTypePtr probe_column_type;
+    const String build_column_name;
+    const DataTypePtr build_column_type;
+
+    std::mutex mutex;
+    bool has_rows = false;
+    Field min;
+    Field max;
+
+    std::atomic<bool> ready{false};
+};
+
+using JoinRuntimeFilterPtr = std::shared_ptr<JoinRuntimeFilter>;
+using JoinRuntimeFilters = std::vector<JoinRuntimeFilterPtr>;
+
+}
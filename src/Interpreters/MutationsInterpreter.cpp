@@ -1,10 +1,12 @@
 #include <Functions/FunctionFactory.h>
 #include <Functions/IFunction.h>
+#include <Interpreters/ExpressionAnalyzer.h>
 #include <Interpreters/InterpreterSelectQuery.h>
 #include <Interpreters/MutationsInterpreter.h>
 #include <Interpreters/TreeRewriter.h>
 #include <Interpreters/MutationsNonDeterministicHelpers.h>
 #include <Storages/MergeTree/MergeTreeData.h>
+#include <Storages/MergeTree/MergeTreeDataSelectExecutor.h>
 #include <Storages/MergeTree/StorageFromMergeTreeDataPart.h>
 #include <Storages/StorageMergeTree.h>
 #include <Storages/MergeTree/MergeTreeVirtualColumns.h>
@@ -139,6 +141,48 @@ ColumnDependencies getAllColumnDependencies(
     return dependencies;
 }
 
+/// Try to prove by the primary key index that no rows of the part can satisfy the predicate,
+/// without reading any data. It allows to skip mutation of parts that are not affected by
+/// a selective ALTER UPDATE/DELETE ... WHERE without even executing the count() query on them.
+bool isPredicateAlwaysFalseByPrimaryKey(
+    const ASTPtr & predicate,
+    MergeTreeData::DataPartPtr source_part,
+    const StorageMetadataPtr & metadata_snapshot,
+    ContextPtr context)
+{
+    const auto & primary_key = metadata_snapshot->getPrimaryKey();
+    if (primary_key.column_names.empty())
+        return false;
+
+    /// TreeRewriter cannot resolve virtual or missing columns and the primary key
+    /// index cannot analyze predicates over them anyway.
+    IdentifierNameSet identifiers;
+    predicate->collectIdentifierNames(identifiers);
+    const auto & columns_desc = metadata_snapshot->getColumns();
+    for (const auto & identifier : identifiers)
+        if (!columns_desc.hasPhysical(identifier))
+            return false;
+
+    ASTPtr ast = predicate->clone();
+    auto syntax_result = TreeRewriter(context).analyze(ast, columns_desc.getAllPhysical());
+    auto filter_dag = ExpressionAnalyzer(ast, syntax_result, context).getActionsDAG(false);
+
+    KeyCondition key_condition(filter_dag, context, primary_key.column_names, primary_key.expression);
+    if (key_condition.alwaysUnknownOrTrue())
+        return false;
+
+    auto ranges = MergeTreeDataSelectExecutor::markRangesFromPKRange(
+        source_part,
+        metadata_snapshot,
+        key_condition,
+        /*part_offset_condition=*/ std::nullopt,
+        /*exact_ranges=*/ nullptr,
+        context->getSettingsRef(),
+        getLogger("isStorageTouchedByMutations"));
+
+    return ranges.empty();
+}
+
 }
 
 
@@ -168,13 +212,12 @@ bool isStorageTouchedByMutations(
             if (command.partition)
             {
                 const String partition_id = storage.getPartitionIDFromQuery(command.partition, context);
-                if (partition_id == source_part->info.partition_id)
-                    all_commands_can_be_skipped = false;
+                if (partition_id != source_part->info.partition_id)
+                    continue;
             }
-            else
-            {
+
+            if (!isPredicateAlwaysFalseByPrimaryKey(command.predicate, source_part, metadata_snapshot, context))
                 all_commands_can_be_skipped = false;
-            }
         }
     }
 
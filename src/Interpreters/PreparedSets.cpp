@@ -1,14 +1,19 @@
 #include <chrono>
 #include <variant>
+#include <Access/EnabledRowPolicies.h>
 #include <Interpreters/PreparedSets.h>
 #include <Interpreters/Set.h>
+#include <Interpreters/Context.h>
+#include <Interpreters/DatabaseCatalog.h>
 #include <Interpreters/InterpreterSelectWithUnionQuery.h>
 #include <IO/Operators.h>
 #include <Common/logger_useful.h>
+#include <Common/typeid_cast.h>
 #include <Processors/QueryPlan/CreatingSetsStep.h>
 #include <Processors/Executors/CompletedPipelineExecutor.h>
 #include <Processors/QueryPlan/BuildQueryPipelineSettings.h>
 #include <Processors/QueryPlan/Optimizations/QueryPlanOptimizationSettings.h>
+#include <Processors/QueryPlan/ReadFromMergeTree.h>
 #include <Processors/Sinks/EmptySink.h>
 #include <Processors/Sinks/NullSink.h>
 #include <Processors/QueryPlan/QueryPlan.h>
@@ -16,6 +21,7 @@
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <DataTypes/DataTypeLowCardinality.h>
 #include <QueryPipeline/SizeLimits.h>
+#include <Storages/MergeTree/MergeTreeData.h>
 
 namespace DB
 {
@@ -46,6 +52,88 @@ static bool equals(const DataTypes & lhs, const DataTypes & rhs)
 }
 
 
+/// Collect the storages the plan of a subquery reads from. Returns false if the plan reads from
+/// anything other than MergeTree tables, in which case the built set cannot be cached.
+static bool collectSubquerySourceTables(const QueryPlan::Node * node, std::vector<StorageID> & tables)
+{
+    if (node->children.empty())
+    {
+        const auto * reading = typeid_cast<const ReadFromMergeTree *>(node->step.get());
+        if (!reading)
+            return false;
+
+        tables.push_back(reading->getStorageID());
+        return true;
+    }
+
+    for (const auto * child : node->children)
+        if (!collectSubquerySourceTables(child, tables))
+            return false;
+
+    return true;
+}
+
+/// Current per-partition data versions of the tables the subquery plan reads from,
+/// or an empty map if the set cannot be cached (see collectSubquerySourceTables()).
+static SubquerySetCache::TableVersions collectSubquerySourceVersions(const QueryPlan & plan, const ContextPtr & context)
+{
+    std::vector<StorageID> tables;
+    if (!collectSubquerySourceTables(plan.getRootNode(), tables))
+        return {};
+
+    SubquerySetCache::TableVersions table_versions;
+    for (const auto & table_id : tables)
+    {
+        auto table = DatabaseCatalog::instance().tryGetTable(table_id, context);
+        const auto * merge_tree = dynamic_cast<const MergeTreeData *>(table.get());
+        if (!merge_tree)
+            return {};
+
+        /// The cache is server-wide while a row policy makes the content of the set depend on
+        /// the user and the enabled roles: such sets must not be shared across queries.
+        auto row_policy_filter = context->getRowPolicyFilter(
+            table_id.database_name, table_id.table_name, RowPolicyFilterType::SELECT_FILTER);
+        if (row_policy_filter && !row_policy_filter->empty())
+            return {};
+
+        table_versions.emplace(QualifiedTableName{table_id.database_name, table_id.table_name}, merge_tree->getPartitionDataVersions());
+    }
+    return table_versions;
+}
+
+
+SubquerySetCache::SubquerySetCache(size_t max_size_in_bytes, size_t max_entries)
+    : cache(max_size_in_bytes, max_entries)
+{
+}
+
+size_t SubquerySetCache::EntryWeight::operator()(const Entry & entry) const
+{
+    return entry.set ? entry.set->getTotalByteCount() : 0;
+}
+
+SetPtr SubquerySetCache::find(const String & key, const TableVersions & current_versions)
+{
+    auto entry = cache.get(key);
+    if (!entry)
+        return nullptr;
+
+    if (entry->versions != current_versions)
+    {
+        /// The source tables changed, the set has to be rebuilt.
+        cache.remove(key);
+        return nullptr;
+    }
+
+    return entry->set;
+}
+
+void SubquerySetCache::add(const String & key, SetPtr set, TableVersions versions)
+{
+    cache.set(key, std::make_shared<Entry>(Entry{std::move(set), std::move(versions)}));
+}
+
+
 FutureSetFromStorage::FutureSetFromStorage(SetPtr set_) : set(std::move(set_)) {}
 SetPtr FutureSetFromStorage::get() const { return set; }
 DataTypes FutureSetFromStorage::getTypes() const { return set->getElementsTypes(); }
@@ -155,6 +243,28 @@ std::unique_ptr<QueryPlan> FutureSetFromSubquery::build(const ContextPtr & conte
     if (!plan)
         return nullptr;
 
+    if (settings.use_subquery_set_cache && !external_table && !external_table_set)
+    {
+        auto table_versions = collectSubquerySourceVersions(*plan, context);
+        if (!table_versions.empty())
+        {
+            auto cache = context->getSubquerySetCache();
+            /// Sets with different NULL handling are not interchangeable, so it is part of the key.
+            auto cache_key = set_and_key->key + (settings.transform_null_in ? "_null_in" : "");
+
+            auto cached_set = cache->find(cache_key, table_versions);
+            if (cached_set && equals(cached_set->getElementsTypes(), set_and_key->set->getElementsTypes()))
+            {
+                set_and_key->set = std::move(cached_set);
+                return nullptr;
+            }
+
+            set_and_key->subquery_set_cache = std::move(cache);
+            set_and_key->subquery_set_cache_key = std::move(cache_key);
+            set_and_key->table_versions = std::move(table_versions);
+        }
+    }
+
     auto creating_set = std::make_unique<CreatingSetStep>(
             plan->getCurrentDataStream(),
             set_and_key,
@@ -2,10 +2,13 @@
 
 #include <Parsers/IAST.h>
 #include <DataTypes/IDataType.h>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 #include <future>
+#include <Common/CacheBase.h>
+#include <Core/QualifiedTableName.h>
 #include <Storages/IStorage_fwd.h>
 #include <Interpreters/Context_fwd.h>
 #include <Interpreters/SetKeys.h>
@@ -24,12 +27,55 @@ using QueryTreeNodePtr = std::shared_ptr<IQueryTreeNode>;
 
 struct Settings;
 
+/// Server-wide cache of sets built from IN subqueries, enabled by the setting 'use_subquery_set_cache'.
+/// Unlike PreparedSetsCache (see below), which is scoped to a single mutation, entries here outlive the
+/// query that created them. Each entry records the per-partition data versions of the MergeTree tables
+/// the subquery read (see MergeTreeData::getPartitionDataVersions()). A lookup succeeds only if the
+/// current versions still match, so a set is reused for as long as its source tables are unchanged and
+/// is transparently rebuilt otherwise.
+class SubquerySetCache
+{
+public:
+    using PartitionVersions = std::map<String, Int64>;
+    using TableVersions = std::map<QualifiedTableName, PartitionVersions>;
+
+    SubquerySetCache(size_t max_size_in_bytes, size_t max_entries);
+
+    /// Returns the cached set for the key, or nullptr if there is none or its recorded versions are outdated.
+    SetPtr find(const String & key, const TableVersions & current_versions);
+
+    /// Stores a fully built set together with the versions of the tables it was built from.
+    void add(const String & key, SetPtr set, TableVersions versions);
+
+private:
+    struct Entry
+    {
+        SetPtr set;
+        TableVersions versions;
+    };
+
+    struct EntryWeight
+    {
+        size_t operator()(const Entry & entry) const;
+    };
+
+    CacheBase<String, Entry, std::hash<String>, EntryWeight> cache;
+};
+
+using SubquerySetCachePtr = std::shared_ptr<SubquerySetCache>;
+
 /// This is a structure for prepared sets cache.
 /// SetPtr can be taken from cache, so we should pass holder for it.
 struct SetAndKey
 {
     String key;
     SetPtr set;
+
+    /// Filled in FutureSetFromSubquery::build() when the set qualifies for the server-wide subquery set
+    /// cache, so that CreatingSetsTransform can store the built set there.
+    SubquerySetCachePtr subquery_set_cache;
+    String subquery_set_cache_key;
+    SubquerySetCache::TableVersions table_versions;
 };
 
 using SetAndKeyPtr = std::shared_ptr<SetAndKey>;
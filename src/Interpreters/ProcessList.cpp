@@ -78,6 +78,38 @@ ProcessList::insert(const String & query_, const IAST * ast, ContextMutablePtr q
 
     bool is_unlimited_query = isUnlimitedQuery(ast);
 
+    /// Actualize thread group info and configure everything that does not depend on the per-user
+    /// process list before taking the lock: at high QPS of small queries the critical section
+    /// below is the bottleneck of query admission.
+    CurrentThread::attachQueryForLog(query_);
+    auto thread_group = CurrentThread::getGroup();
+    if (thread_group)
+    {
+        /// Set query-level memory trackers
+        thread_group->memory_tracker.setOrRaiseHardLimit(settings.max_memory_usage);
+        thread_group->memory_tracker.setSoftLimit(settings.memory_overcommit_ratio_denominator);
+
+        if (query_context->hasTraceCollector())
+        {
+            /// Set up memory profiling
+            thread_group->memory_tracker.setProfilerStep(settings.memory_profiler_step);
+
+            thread_group->memory_tracker.setSampleProbability(settings.memory_profiler_sample_probability);
+            thread_group->memory_tracker.setSampleMinAllocationSize(settings.memory_profiler_sample_min_allocation_size);
+            thread_group->memory_tracker.setSampleMaxAllocationSize(settings.memory_profiler_sample_max_allocation_size);
+            thread_group->performance_counters.setTraceProfileEvents(settings.trace_profile_events);
+        }
+
+        thread_group->memory_tracker.setDescription("(for query)");
+        if (settings.memory_tracker_fault_probability > 0.0)
+            thread_group->memory_tracker.setFaultProbability(settings.memory_tracker_fault_probability);
+
+        thread_group->memory_tracker.setOvercommitWaitingTime(settings.memory_usage_overcommit_max_wait_microseconds);
+
+        /// NOTE: Do not set the limit for thread-level memory tracker since it could show unreal values
+        ///  since allocation and deallocation could happen in different threads
+    }
+
     {
         auto [lock, overcommit_blocker] = safeLock(); // To avoid deadlock in case of OOM
         IAST::QueryKind query_kind = ast->getQueryKind();
@@ -209,9 +241,8 @@ ProcessList::insert(const String & query_, const IAST * ast, ContextMutablePtr q
         }
         ProcessListForUser & user_process_list = user_process_list_it->second;
 
-        /// Actualize thread group info
-        CurrentThread::attachQueryForLog(query_);
-        auto thread_group = CurrentThread::getGroup();
+        /// Attach the thread group to the per-user process list. The rest of its configuration
+        /// happened before the lock was taken (see above).
         if (thread_group)
         {
             thread_group->performance_counters.setParent(&user_process_list.user_performance_counters);
@@ -226,30 +257,6 @@ ProcessList::insert(const String & query_, const IAST * ast, ContextMutablePtr q
                 query_context->setTempDataOnDisk(std::make_shared<TemporaryDataOnDiskScope>(
                     user_process_list.user_temp_data_on_disk, std::move(temporary_data_on_disk_settings)));
             }
-
-            /// Set query-level memory trackers
-            thread_group->memory_tracker.setOrRaiseHardLimit(settings.max_memory_usage);
-            thread_group->memory_tracker.setSoftLimit(settings.memory_overcommit_ratio_denominator);
-
-            if (query_context->hasTraceCollector())
-            {
-                /// Set up memory profiling
-                thread_group->memory_tracker.setProfilerStep(settings.memory_profiler_step);
-
-                thread_group->memory_tracker.setSampleProbability(settings.memory_profiler_sample_probability);
-                thread_group->memory_tracker.setSampleMinAllocationSize(settings.memory_profiler_sample_min_allocation_size);
-                thread_group->memory_tracker.setSampleMaxAllocationSize(settings.memory_profiler_sample_max_allocation_size);
-                thread_group->performance_counters.setTraceProfileEvents(settings.trace_profile_events);
-            }
-
-            thread_group->memory_tracker.setDescription("(for query)");
-            if (settings.memory_tracker_fault_probability > 0.0)
-                thread_group->memory_tracker.setFaultProbability(settings.memory_tracker_fault_probability);
-
-            thread_group->memory_tracker.setOvercommitWaitingTime(settings.memory_usage_overcommit_max_wait_microseconds);
-
-            /// NOTE: Do not set the limit for thread-level memory tracker since it could show unreal values
-            ///  since allocation and deallocation could happen in different threads
         }
 
         auto process_it = processes.emplace(
@@ -299,13 +306,18 @@ ProcessList::insert(const String & query_, const IAST * ast, ContextMutablePtr q
 
 ProcessListEntry::~ProcessListEntry()
 {
+    /// Declared before the lock so that it outlives it: if this is the last reference, destroying
+    /// the QueryStatus notifies the overcommit trackers and releases the thread group and the query
+    /// context, which is too expensive to do inside the critical section.
+    QueryStatusPtr process_list_element_ptr;
+
     auto lock = parent.safeLock();
 
     String user = (*it)->getClientInfo().current_user;
     String query_id = (*it)->getClientInfo().current_query_id;
     IAST::QueryKind query_kind = (*it)->query_kind;
 
-    const QueryStatusPtr process_list_element_ptr = *it;
+    process_list_element_ptr = *it;
 
     auto user_process_list_it = parent.user_to_queries.find(user);
     if (user_process_list_it == parent.user_to_queries.end())
@@ -141,6 +141,11 @@ ColumnsDescription QueryLogElement::getColumnsDescription()
         {"query_cache_usage", std::move(query_cache_usage_datatype), "Usage of the query cache during query execution. Values: 'Unknown' = Status unknown, 'None' = The query result was neither written into nor read from the query cache, 'Write' = The query result was written into the query cache, 'Read' = The query result was read from the query cache."},
 
         {"asynchronous_read_counters", std::make_shared<DataTypeMap>(low_cardinality_string, std::make_shared<DataTypeUInt64>()), "Metrics for asynchronous reading."},
+
+        {"processors_elapsed_us", std::make_shared<DataTypeMap>(low_cardinality_string, std::make_shared<DataTypeUInt64>()),
+            "Total time in microseconds spent in work() of each processor type, aggregated over all processor instances and threads. "
+            "Gives a per-stage breakdown of the query execution time without joining with system.processors_profile_log. "
+            "Filled when the log_processors_profiles setting is enabled."},
     };
 }
 
@@ -300,6 +305,14 @@ void QueryLogElement::appendToBlock(MutableColumns & columns) const
         async_read_counters->dumpToMapColumn(columns[i++].get());
     else
         columns[i++]->insertDefault();
+
+    {
+        Map processors_map;
+        processors_map.reserve(processors_elapsed_us.size());
+        for (const auto & [processor_name, elapsed_us] : processors_elapsed_us)
+            processors_map.push_back(Tuple{processor_name, elapsed_us});
+        columns[i++]->insert(processors_map);
+    }
 }
 
 void QueryLogElement::appendClientInfo(const ClientInfo & client_info, MutableColumns & columns, size_t & i)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+
 #include <Common/ProfileEvents.h>
 #include <Core/NamesAndTypes.h>
 #include <Core/NamesAndAliases.h>
@@ -94,6 +96,9 @@ struct QueryLogElement
 
     std::vector<UInt64> thread_ids;
     UInt64 peak_threads_usage = 0;
+    /// Total time spent in work() of each processor type, aggregated over all instances
+    /// and threads. Filled on query finish when log_processors_profiles is enabled.
+    std::map<String, UInt64> processors_elapsed_us;
     std::shared_ptr<ProfileEvents::Counters::Snapshot> profile_counters;
     std::shared_ptr<AsyncReadCounters> async_read_counters;
     std::shared_ptr<Settings> query_settings;
@@ -9,6 +9,7 @@
 #include <Interpreters/Cache/QueryCache.h>
 #include <Interpreters/JIT/CompiledExpressionCache.h>
 
+#include <Common/CurrentMetrics.h>
 #include <Common/PageCache.h>
 
 #include <Databases/IDatabase.h>
@@ -20,9 +21,19 @@
 #include <Storages/StorageMergeTree.h>
 #include <Storages/StorageReplicatedMergeTree.h>
 #include <Storages/MarkCache.h>
+#include <Storages/MergeTree/SkippingIndexResultCache.h>
+#include <Storages/MergeTree/FilteredGranuleCache.h>
+#include <Storages/MergeTree/ApproximateNearestNeighborIndexCache.h>
 
 #include <Coordination/KeeperAsynchronousMetrics.h>
 
+namespace CurrentMetrics
+{
+    extern const Metric MergeTreeActiveDataBytes;
+    extern const Metric MergeTreeActiveDataRows;
+    extern const Metric MergeTreeActiveDataParts;
+}
+
 namespace DB
 {
 
@@ -55,9 +66,10 @@ ServerAsynchronousMetrics::ServerAsynchronousMetrics(
     ContextPtr global_context_,
     unsigned update_period_seconds,
     unsigned heavy_metrics_update_period_seconds,
-    const ProtocolServerMetricsFunc & protocol_server_metrics_func_)
+    const ProtocolServerMetricsFunc & protocol_server_metrics_func_,
+    double allocator_purge_rss_excess_ratio_)
     : WithContext(global_context_)
-    , AsynchronousMetrics(update_period_seconds, protocol_server_metrics_func_)
+    , AsynchronousMetrics(update_period_seconds, protocol_server_metrics_func_, allocator_purge_rss_excess_ratio_)
     , heavy_metric_update_period(heavy_metrics_update_period_seconds)
 {
     /// sanity check
@@ -103,6 +115,30 @@ void ServerAsynchronousMetrics::updateImpl(TimePoint update_time, TimePoint curr
         new_values["IndexMarkCacheFiles"] = { index_mark_cache->count(), "Total number of mark files cached in the mark cache for secondary indices." };
     }
 
+    if (auto skipping_index_result_cache = getContext()->getSkippingIndexResultCache())
+    {
+        new_values["SkippingIndexResultCacheBytes"] = { skipping_index_result_cache->sizeInBytes(),
+            "Total size of the cache of skipping index evaluation results in bytes." };
+        new_values["SkippingIndexResultCacheEntries"] = { skipping_index_result_cache->count(),
+            "Total number of entries in the cache of skipping index evaluation results. Each entry represents the set of mark ranges left after evaluating an index condition over a data part." };
+    }
+
+    if (auto filtered_granule_cache = getContext()->getFilteredGranuleCache())
+    {
+        new_values["FilteredGranuleCacheBytes"] = { filtered_granule_cache->sizeInBytes(),
+            "Total size of the cache of decoded and filtered results of MergeTree read tasks in bytes." };
+        new_values["FilteredGranuleCacheEntries"] = { filtered_granule_cache->count(),
+            "Total number of entries in the cache of decoded and filtered results of MergeTree read tasks. Each entry represents the chunks produced for one combination of part, mark ranges and filtering conditions." };
+    }
+
+    if (auto ann_index_cache = getContext()->getApproximateNearestNeighborIndexCache())
+    {
+        new_values["ApproximateNearestNeighborIndexCacheBytes"] = { ann_index_cache->sizeInBytes(),
+            "Total size of the cache of deserialized approximate nearest neighbor index granules in bytes." };
+        new_values["ApproximateNearestNeighborIndexCacheEntries"] = { ann_index_cache->count(),
+            "Total number of entries in the cache of deserialized approximate nearest neighbor index granules. Each entry represents the in-memory search structure built over one index granule of a data part." };
+    }
+
     if (auto index_uncompressed_cache = getContext()->getIndexUncompressedCache())
     {
         new_values["IndexUncompressedCacheBytes"] = { index_uncompressed_cache->sizeInBytes(),
@@ -264,149 +300,21 @@ void ServerAsynchronousMetrics::updateImpl(TimePoint update_time, TimePoint curr
     {
         auto databases = DatabaseCatalog::instance().getDatabases();
 
-        size_t max_queue_size = 0;
-        size_t max_inserts_in_queue = 0;
-        size_t max_merges_in_queue = 0;
-
-        size_t sum_queue_size = 0;
-        size_t sum_inserts_in_queue = 0;
-        size_t sum_merges_in_queue = 0;
-
-        size_t max_absolute_delay = 0;
-        size_t max_relative_delay = 0;
-
-        size_t max_part_count_for_partition = 0;
-
         size_t number_of_databases = 0;
         for (const auto & [db_name, _] : databases)
             if (db_name != DatabaseCatalog::TEMPORARY_DATABASE)
                 ++number_of_databases; /// filter out the internal database for temporary tables, system table "system.databases" behaves the same way
 
-        size_t total_number_of_tables = 0;
-
-        size_t total_number_of_bytes = 0;
-        size_t total_number_of_rows = 0;
-        size_t total_number_of_parts = 0;
-
-        size_t total_number_of_tables_system = 0;
-
-        size_t total_number_of_bytes_system = 0;
-        size_t total_number_of_rows_system = 0;
-        size_t total_number_of_parts_system = 0;
-
-        size_t total_primary_key_bytes_memory = 0;
-        size_t total_primary_key_bytes_memory_allocated = 0;
-
-        for (const auto & db : databases)
-        {
-            /// Check if database can contain MergeTree tables
-            if (!db.second->canContainMergeTreeTables())
-                continue;
-
-            bool is_system = db.first == DatabaseCatalog::SYSTEM_DATABASE;
-
-            // Note that we skip not yet loaded tables, so metrics could possibly be lower than expected on fully loaded database just after server start if `async_load_databases = true`.
-            for (auto iterator = db.second->getTablesIterator(getContext(), {}, /*skip_not_loaded=*/true); iterator->isValid(); iterator->next())
-            {
-                ++total_number_of_tables;
-                if (is_system)
-                    ++total_number_of_tables_system;
-
-                const auto & table = iterator->table();
-                if (!table)
-                    continue;
-
-                if (MergeTreeData * table_merge_tree = dynamic_cast<MergeTreeData *>(table.get()))
-                {
-                    const auto & settings = getContext()->getSettingsRef();
-
-                    calculateMax(max_part_count_for_partition, table_merge_tree->getMaxPartsCountAndSizeForPartition().first);
-
-                    size_t bytes = table_merge_tree->totalBytes(settings).value();
-                    size_t rows = table_merge_tree->totalRows(settings).value();
-                    size_t parts = table_merge_tree->getActivePartsCount();
-
-                    total_number_of_bytes += bytes;
-                    total_number_of_rows += rows;
-                    total_number_of_parts += parts;
-
-                    if (is_system)
-                    {
-                        total_number_of_bytes_system += bytes;
-                        total_number_of_rows_system += rows;
-                        total_number_of_parts_system += parts;
-                    }
-
-                    // only fetch the parts which are in active state
-                    auto all_parts = table_merge_tree->getDataPartsVectorForInternalUsage();
-
-                    for (const auto & part : all_parts)
-                    {
-                        total_primary_key_bytes_memory += part->getIndexSizeInBytes();
-                        total_primary_key_bytes_memory_allocated += part->getIndexSizeInAllocatedBytes();
-                    }
-                }
-
-                if (StorageReplicatedMergeTree * table_replicated_merge_tree = typeid_cast<StorageReplicatedMergeTree *>(table.get()))
-                {
-                    ReplicatedTableStatus status;
-                    table_replicated_merge_tree->getStatus(status, false);
-
-                    calculateMaxAndSum(max_queue_size, sum_queue_size, status.queue.queue_size);
-                    calculateMaxAndSum(max_inserts_in_queue, sum_inserts_in_queue, status.queue.inserts_in_queue);
-                    calculateMaxAndSum(max_merges_in_queue, sum_merges_in_queue, status.queue.merges_in_queue);
-
-                    if (!status.is_readonly)
-                    {
-                        try
-                        {
-                            time_t absolute_delay = 0;
-                            time_t relative_delay = 0;
-                            table_replicated_merge_tree->getReplicaDelays(absolute_delay, relative_delay);
-
-                            calculateMax(max_absolute_delay, absolute_delay);
-                            calculateMax(max_relative_delay, relative_delay);
-                        }
-                        catch (...)
-                        {
-                            tryLogCurrentException(__PRETTY_FUNCTION__,
-                                "Cannot get replica delay for table: " + backQuoteIfNeed(db.first) + "." + backQuoteIfNeed(iterator->name()));
-                        }
-                    }
-                }
-            }
-        }
-
-        new_values["ReplicasMaxQueueSize"] = { max_queue_size, "Maximum queue size (in the number of operations like get, merge) across Replicated tables." };
-        new_values["ReplicasMaxInsertsInQueue"] = { max_inserts_in_queue, "Maximum number of INSERT operations in the queue (still to be replicated) across Replicated tables." };
-        new_values["ReplicasMaxMergesInQueue"] = { max_merges_in_queue, "Maximum number of merge operations in the queue (still to be applied) across Replicated tables." };
-
-        new_values["ReplicasSumQueueSize"] = { sum_queue_size, "Sum queue size (in the number of operations like get, merge) across Replicated tables." };
-        new_values["ReplicasSumInsertsInQueue"] = { sum_inserts_in_queue, "Sum of INSERT operations in the queue (still to be replicated) across Replicated tables." };
-        new_values["ReplicasSumMergesInQueue"] = { sum_merges_in_queue, "Sum of merge operations in the queue (still to be applied) across Replicated tables." };
-
-        new_values["ReplicasMaxAbsoluteDelay"] = { max_absolute_delay, "Maximum difference in seconds between the most fresh replicated part and the most fresh data part still to be replicated, across Replicated tables. A very high value indicates a replica with no data." };
-        new_values["ReplicasMaxRelativeDelay"] = { max_relative_delay, "Maximum difference between the replica delay and the delay of the most up-to-date replica of the same table, across Replicated tables." };
-
-        new_values["MaxPartCountForPartition"] = { max_part_count_for_partition, "Maximum number of parts per partition across all partitions of all tables of MergeTree family. Values larger than 300 indicates misconfiguration, overload, or massive data loading." };
-
         new_values["NumberOfDatabases"] = { number_of_databases, "Total number of databases on the server." };
-        new_values["NumberOfTables"] = { total_number_of_tables, "Total number of tables summed across the databases on the server, excluding the databases that cannot contain MergeTree tables."
-            " The excluded database engines are those who generate the set of tables on the fly, like `Lazy`, `MySQL`, `PostgreSQL`, `SQlite`."};
 
-        new_values["TotalBytesOfMergeTreeTables"] = { total_number_of_bytes, "Total amount of bytes (compressed, including data and indices) stored in all tables of MergeTree family." };
-        new_values["TotalRowsOfMergeTreeTables"] = { total_number_of_rows, "Total amount of rows (records) stored in all tables of MergeTree family." };
-        new_values["TotalPartsOfMergeTreeTables"] = { total_number_of_parts, "Total amount of data parts in all tables of MergeTree family."
+        /// These counters are maintained incrementally by MergeTree tables on part state changes,
+        /// so reporting them does not require iterating over tables (which is expensive with many
+        /// tables and contends with DDL queries). The remaining per-table metrics are calculated
+        /// by updateTablesStats() with the heavy metrics period.
+        new_values["TotalBytesOfMergeTreeTables"] = { CurrentMetrics::get(CurrentMetrics::MergeTreeActiveDataBytes), "Total amount of bytes (compressed, including data and indices) stored in all tables of MergeTree family." };
+        new_values["TotalRowsOfMergeTreeTables"] = { CurrentMetrics::get(CurrentMetrics::MergeTreeActiveDataRows), "Total amount of rows (records) stored in all tables of MergeTree family." };
+        new_values["TotalPartsOfMergeTreeTables"] = { CurrentMetrics::get(CurrentMetrics::MergeTreeActiveDataParts), "Total amount of data parts in all tables of MergeTree family."
             " Numbers larger than 10 000 will negatively affect the server startup time and it may indicate unreasonable choice of the partition key." };
-
-        new_values["NumberOfTablesSystem"] = { total_number_of_tables_system, "Total number of tables in the system database on the server stored in tables of MergeTree family." };
-
-        new_values["TotalBytesOfMergeTreeTablesSystem"] = { total_number_of_bytes_system, "Total amount of bytes (compressed, including data and indices) stored in tables of MergeTree family in the system database." };
-        new_values["TotalRowsOfMergeTreeTablesSystem"] = { total_number_of_rows_system, "Total amount of rows (records) stored in tables of MergeTree family in the system database." };
-        new_values["TotalPartsOfMergeTreeTablesSystem"] = { total_number_of_parts_system, "Total amount of data parts in tables of MergeTree family in the system database." };
-
-        new_values["TotalPrimaryKeyBytesInMemory"] = { total_primary_key_bytes_memory, "The total amount of memory (in bytes) used by primary key values (only takes active parts into account)." };
-        new_values["TotalPrimaryKeyBytesInMemoryAllocated"] = { total_primary_key_bytes_memory_allocated, "The total amount of memory (in bytes) reserved for primary key values (only takes active parts into account)." };
     }
 
 #if USE_NURAFT
@@ -461,6 +369,85 @@ void ServerAsynchronousMetrics::updateDetachedPartsStats()
     detached_parts_stats = current_values;
 }
 
+void ServerAsynchronousMetrics::updateTablesStats()
+{
+    TablesStats current_values{};
+
+    for (const auto & db : DatabaseCatalog::instance().getDatabases())
+    {
+        /// Check if database can contain MergeTree tables
+        if (!db.second->canContainMergeTreeTables())
+            continue;
+
+        bool is_system = db.first == DatabaseCatalog::SYSTEM_DATABASE;
+
+        // Note that we skip not yet loaded tables, so metrics could possibly be lower than expected on fully loaded database just after server start if `async_load_databases = true`.
+        for (auto iterator = db.second->getTablesIterator(getContext(), {}, /*skip_not_loaded=*/true); iterator->isValid(); iterator->next())
+        {
+            ++current_values.number_of_tables;
+            if (is_system)
+                ++current_values.number_of_tables_system;
+
+            const auto & table = iterator->table();
+            if (!table)
+                continue;
+
+            if (MergeTreeData * table_merge_tree = dynamic_cast<MergeTreeData *>(table.get()))
+            {
+                const auto & settings = getContext()->getSettingsRef();
+
+                calculateMax(current_values.max_part_count_for_partition, table_merge_tree->getMaxPartsCountAndSizeForPartition().first);
+
+                if (is_system)
+                {
+                    current_values.total_number_of_bytes_system += table_merge_tree->totalBytes(settings).value();
+                    current_values.total_number_of_rows_system += table_merge_tree->totalRows(settings).value();
+                    current_values.total_number_of_parts_system += table_merge_tree->getActivePartsCount();
+                }
+
+                // only fetch the parts which are in active state
+                auto all_parts = table_merge_tree->getDataPartsVectorForInternalUsage();
+
+                for (const auto & part : all_parts)
+                {
+                    current_values.total_primary_key_bytes_memory += part->getIndexSizeInBytes();
+                    current_values.total_primary_key_bytes_memory_allocated += part->getIndexSizeInAllocatedBytes();
+                }
+            }
+
+            if (StorageReplicatedMergeTree * table_replicated_merge_tree = typeid_cast<StorageReplicatedMergeTree *>(table.get()))
+            {
+                ReplicatedTableStatus status;
+                table_replicated_merge_tree->getStatus(status, false);
+
+                calculateMaxAndSum(current_values.max_queue_size, current_values.sum_queue_size, status.queue.queue_size);
+                calculateMaxAndSum(current_values.max_inserts_in_queue, current_values.sum_inserts_in_queue, status.queue.inserts_in_queue);
+                calculateMaxAndSum(current_values.max_merges_in_queue, current_values.sum_merges_in_queue, status.queue.merges_in_queue);
+
+                if (!status.is_readonly)
+                {
+                    try
+                    {
+                        time_t absolute_delay = 0;
+                        time_t relative_delay = 0;
+                        table_replicated_merge_tree->getReplicaDelays(absolute_delay, relative_delay);
+
+                        calculateMax(current_values.max_absolute_delay, absolute_delay);
+                        calculateMax(current_values.max_relative_delay, relative_delay);
+                    }
+                    catch (...)
+                    {
+                        tryLogCurrentException(__PRETTY_FUNCTION__,
+                            "Cannot get replica delay for table: " + backQuoteIfNeed(db.first) + "." + backQuoteIfNeed(iterator->name()));
+                    }
+                }
+            }
+        }
+    }
+
+    tables_stats = current_values;
+}
+
 void ServerAsynchronousMetrics::updateHeavyMetricsIfNeeded(TimePoint current_time, TimePoint update_time, bool force_update, bool first_run, AsynchronousMetricValues & new_values)
 {
     const auto time_since_previous_update = current_time - heavy_metric_previous_update_time;
@@ -478,6 +465,9 @@ void ServerAsynchronousMetrics::updateHeavyMetricsIfNeeded(TimePoint current_tim
         /// Test shows that listing 100000 entries consuming around 0.15 sec.
         updateDetachedPartsStats();
 
+        /// Iterating over all tables. The result is cached between the updates.
+        updateTablesStats();
+
         watch.stop();
 
         /// Normally heavy metrics don't delay the rest of the metrics calculation
@@ -503,6 +493,31 @@ void ServerAsynchronousMetrics::updateHeavyMetricsIfNeeded(TimePoint current_tim
 
     new_values["NumberOfDetachedParts"] = { detached_parts_stats.count, "The total number of parts detached from MergeTree tables. A part can be detached by a user with the `ALTER TABLE DETACH` query or by the server itself it the part is broken, unexpected or unneeded. The server does not care about detached parts and they can be removed." };
     new_values["NumberOfDetachedByUserParts"] = { detached_parts_stats.detached_by_user, "The total number of parts detached from MergeTree tables by users with the `ALTER TABLE DETACH` query (as opposed to unexpected, broken or ignored parts). The server does not care about detached parts and they can be removed." };
+
+    new_values["ReplicasMaxQueueSize"] = { tables_stats.max_queue_size, "Maximum queue size (in the number of operations like get, merge) across Replicated tables." };
+    new_values["ReplicasMaxInsertsInQueue"] = { tables_stats.max_inserts_in_queue, "Maximum number of INSERT operations in the queue (still to be replicated) across Replicated tables." };
+    new_values["ReplicasMaxMergesInQueue"] = { tables_stats.max_merges_in_queue, "Maximum number of merge operations in the queue (still to be applied) across Replicated tables." };
+
+    new_values["ReplicasSumQueueSize"] = { tables_stats.sum_queue_size, "Sum queue size (in the number of operations like get, merge) across Replicated tables." };
+    new_values["ReplicasSumInsertsInQueue"] = { tables_stats.sum_inserts_in_queue, "Sum of INSERT operations in the queue (still to be replicated) across Replicated tables." };
+    new_values["ReplicasSumMergesInQueue"] = { tables_stats.sum_merges_in_queue, "Sum of merge operations in the queue (still to be applied) across Replicated tables." };
+
+    new_values["ReplicasMaxAbsoluteDelay"] = { tables_stats.max_absolute_delay, "Maximum difference in seconds between the most fresh replicated part and the most fresh data part still to be replicated, across Replicated tables. A very high value indicates a replica with no data." };
+    new_values["ReplicasMaxRelativeDelay"] = { tables_stats.max_relative_delay, "Maximum difference between the replica delay and the delay of the most up-to-date replica of the same table, across Replicated tables." };
+
+    new_values["MaxPartCountForPartition"] = { tables_stats.max_part_count_for_partition, "Maximum number of parts per partition across all partitions of all tables of MergeTree family. Values larger than 300 indicates misconfiguration, overload, or massive data loading." };
+
+    new_values["NumberOfTables"] = { tables_stats.number_of_tables, "Total number of tables summed across the databases on the server, excluding the databases that cannot contain MergeTree tables."
+        " The excluded database engines are those who generate the set of tables on the fly, like `Lazy`, `MySQL`, `PostgreSQL`, `SQlite`."};
+
+    new_values["NumberOfTablesSystem"] = { tables_stats.number_of_tables_system, "Total number of tables in the system database on the server stored in tables of MergeTree family." };
+
+    new_values["TotalBytesOfMergeTreeTablesSystem"] = { tables_stats.total_number_of_bytes_system, "Total amount of bytes (compressed, including data and indices) stored in tables of MergeTree family in the system database." };
+    new_values["TotalRowsOfMergeTreeTablesSystem"] = { tables_stats.total_number_of_rows_system, "Total amount of rows (records) stored in tables of MergeTree family in the system database." };
+    new_values["TotalPartsOfMergeTreeTablesSystem"] = { tables_stats.total_number_of_parts_system, "Total amount of data parts in tables of MergeTree family in the system database." };
+
+    new_values["TotalPrimaryKeyBytesInMemory"] = { tables_stats.total_primary_key_bytes_memory, "The total amount of memory (in bytes) used by primary key values (only takes active parts into account)." };
+    new_values["TotalPrimaryKeyBytesInMemoryAllocated"] = { tables_stats.total_primary_key_bytes_memory_allocated, "The total amount of memory (in bytes) reserved for primary key values (only takes active parts into account)." };
 }
 
 }
@@ -14,7 +14,8 @@ public:
         ContextPtr global_context_,
         unsigned update_period_seconds,
         unsigned heavy_metrics_update_period_seconds,
-        const ProtocolServerMetricsFunc & protocol_server_metrics_func_);
+        const ProtocolServerMetricsFunc & protocol_server_metrics_func_,
+        double allocator_purge_rss_excess_ratio_ = 0.);
     ~ServerAsynchronousMetrics() override;
 
 private:
@@ -33,7 +34,38 @@ private:
 
     DetachedPartsStats detached_parts_stats{};
 
+    /// Per-table metrics that require iterating over all tables. Expensive with many tables,
+    /// therefore calculated with the heavy metrics period and cached between the updates.
+    struct TablesStats
+    {
+        size_t number_of_tables = 0;
+        size_t number_of_tables_system = 0;
+
+        size_t total_number_of_bytes_system = 0;
+        size_t total_number_of_rows_system = 0;
+        size_t total_number_of_parts_system = 0;
+
+        size_t total_primary_key_bytes_memory = 0;
+        size_t total_primary_key_bytes_memory_allocated = 0;
+
+        size_t max_queue_size = 0;
+        size_t max_inserts_in_queue = 0;
+        size_t max_merges_in_queue = 0;
+
+        size_t sum_queue_size = 0;
+        size_t sum_inserts_in_queue = 0;
+        size_t sum_merges_in_queue = 0;
+
+        size_t max_absolute_delay = 0;
+        size_t max_relative_delay = 0;
+
+        size_t max_part_count_for_partition = 0;
+    };
+
+    TablesStats tables_stats{};
+
     void updateDetachedPartsStats();
+    void updateTablesStats();
     void updateHeavyMetricsIfNeeded(TimePoint current_time, TimePoint update_time, bool force_update, bool first_run, AsynchronousMetricValues & new_values);
 };
 
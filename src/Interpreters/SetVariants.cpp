@@ -139,12 +139,18 @@ typename SetVariantsTemplate<Variant>::Type SetVariantsTemplate<Variant>::choose
         if (size_of_field == 8)
             return Type::key64;
         if (size_of_field == 16)
-            return Type::keys128;
+            return Type::key128;
         if (size_of_field == 32)
             return Type::keys256;
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Numeric column has sizeOfField not in 1, 2, 4, 8, 16, 32.");
     }
 
+    /// If there is one 16-byte key stored in a fixed contiguous column (UUID, IPv6, FixedString(16)),
+    /// its values can be used as hash table keys directly, without packing.
+    if (keys_size == 1 && !nested_key_columns[0]->lowCardinality() && nested_key_columns[0]->isFixedAndContiguous()
+        && nested_key_columns[0]->sizeOfValueIfFixed() == 16)
+        return Type::key128;
+
     /// If the keys fit in N bits, we will use a hash table for N-bit-packed keys
     if (all_fixed && keys_bytes <= 16)
         return Type::keys128;
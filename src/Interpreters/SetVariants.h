@@ -195,6 +195,7 @@ struct NonClearableSet
       */
     std::unique_ptr<SetMethodOneNumber<UInt32, HashSet<UInt32, HashCRC32<UInt32>>>>          key32;
     std::unique_ptr<SetMethodOneNumber<UInt64, HashSet<UInt64, HashCRC32<UInt64>>>>          key64;
+    std::unique_ptr<SetMethodOneNumber<UInt128, HashSet<UInt128, UInt128HashCRC32>>>         key128;
     std::unique_ptr<SetMethodString<HashSetWithSavedHash<StringRef>>>                        key_string;
     std::unique_ptr<SetMethodFixedString<HashSetWithSavedHash<StringRef>>>                   key_fixed_string;
     std::unique_ptr<SetMethodKeysFixed<HashSet<UInt128, UInt128HashCRC32>>>                  keys128;
@@ -217,6 +218,7 @@ struct ClearableSet
 
     std::unique_ptr<SetMethodOneNumber<UInt32, ClearableHashSet<UInt32, HashCRC32<UInt32>>>>         key32;
     std::unique_ptr<SetMethodOneNumber<UInt64, ClearableHashSet<UInt64, HashCRC32<UInt64>>>>         key64;
+    std::unique_ptr<SetMethodOneNumber<UInt128, ClearableHashSet<UInt128, UInt128HashCRC32>>>        key128;
     std::unique_ptr<SetMethodString<ClearableHashSetWithSavedHash<StringRef>>>                       key_string;
     std::unique_ptr<SetMethodFixedString<ClearableHashSetWithSavedHash<StringRef>>>                  key_fixed_string;
     std::unique_ptr<SetMethodKeysFixed<ClearableHashSet<UInt128, UInt128HashCRC32>>>                 keys128;
@@ -242,6 +244,7 @@ struct SetVariantsTemplate: public Variant
         M(key16)                \
         M(key32)                \
         M(key64)                \
+        M(key128)               \
         M(key_string)           \
         M(key_fixed_string)     \
         M(keys128)              \
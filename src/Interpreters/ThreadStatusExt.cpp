@@ -25,7 +25,11 @@
 
 #if defined(OS_LINUX)
 #   include <Common/hasLinuxCapability.h>
+#   include <IO/ReadBufferFromFile.h>
+#   include <IO/ReadHelpers.h>
 
+#   include <filesystem>
+#   include <sched.h>
 #   include <sys/time.h>
 #   include <sys/resource.h>
 #endif
@@ -41,8 +45,40 @@ namespace ErrorCodes
 {
     extern const int LOGICAL_ERROR;
     extern const int CANNOT_SET_THREAD_PRIORITY;
+    extern const int CANNOT_SET_THREAD_AFFINITY;
 }
 
+#if defined(OS_LINUX)
+/// Fill the set with the CPUs of a NUMA node, parsed from its sysfs CPU list (e.g. "0-15,32-47").
+/// Returns false if the node does not exist.
+static bool getNumaNodeCpuSet(Int64 numa_node, cpu_set_t & cpu_set)
+{
+    CPU_ZERO(&cpu_set);
+
+    auto path = fmt::format("/sys/devices/system/node/node{}/cpulist", numa_node);
+    if (!std::filesystem::exists(path))
+        return false;
+
+    ReadBufferFromFile in(path);
+    while (!in.eof())
+    {
+        UInt64 from;
+        readIntText(from, in);
+        UInt64 to = from;
+        if (checkChar('-', in))
+            readIntText(to, in);
+
+        for (UInt64 cpu = from; cpu <= to && cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &cpu_set);
+
+        if (!checkChar(',', in))
+            break;
+    }
+
+    return CPU_COUNT(&cpu_set) > 0;
+}
+#endif
+
 ThreadGroup::ThreadGroup(ContextPtr query_context_, FatalErrorCallback fatal_error_callback_)
     : master_thread_id(CurrentThread::get().thread_id)
     , query_context(query_context_)
@@ -226,6 +262,24 @@ void ThreadStatus::applyQuerySettings()
 
         os_thread_priority = new_os_thread_priority;
     }
+
+    /// Bind the thread to the CPUs of one NUMA node if required, so that the memory it allocates
+    /// and accesses stays local to that node. All threads of a query see the same setting value
+    /// and therefore end up on the same node.
+    Int64 numa_node = settings.os_thread_numa_node;
+    if (numa_node >= 0)
+    {
+        LOG_TRACE(log, "Binding thread to NUMA node {}", numa_node);
+
+        cpu_set_t cpu_set;
+        if (!getNumaNodeCpuSet(numa_node, cpu_set))
+            throw Exception(ErrorCodes::CANNOT_SET_THREAD_AFFINITY, "NUMA node {} does not exist or has no CPUs", numa_node);
+
+        if (0 != sched_setaffinity(static_cast<pid_t>(thread_id), sizeof(cpu_set), &cpu_set))
+            throw ErrnoException(ErrorCodes::CANNOT_SET_THREAD_AFFINITY, "Cannot 'sched_setaffinity'");
+
+        os_thread_numa_node_bound = true;
+    }
 #endif
 }
 
@@ -290,6 +344,22 @@ void ThreadStatus::detachFromGroup()
 
         os_thread_priority = 0;
     }
+
+    if (os_thread_numa_node_bound)
+    {
+        LOG_TRACE(log, "Resetting CPU affinity");
+
+        /// The kernel intersects the mask with the CPUs available to the process.
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &cpu_set);
+
+        if (0 != sched_setaffinity(static_cast<pid_t>(thread_id), sizeof(cpu_set), &cpu_set))
+            LOG_ERROR(log, "Cannot reset CPU affinity: {}", errnoToString());
+
+        os_thread_numa_node_bound = false;
+    }
 #endif
 }
 
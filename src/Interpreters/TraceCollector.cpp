@@ -9,6 +9,9 @@
 #include <Common/setThreadName.h>
 #include <Common/logger_useful.h>
 
+#include <map>
+#include <tuple>
+
 
 namespace DB
 {
@@ -31,12 +34,13 @@ TraceCollector::TraceCollector()
     thread = ThreadFromGlobalPool(&TraceCollector::run, this);
 }
 
-void TraceCollector::initialize(std::shared_ptr<TraceLog> trace_log_)
+void TraceCollector::initialize(std::shared_ptr<TraceLog> trace_log_, bool fold_profiler_samples_)
 {
     if (is_trace_log_initialized)
         throw DB::Exception(ErrorCodes::LOGICAL_ERROR, "TraceCollector is already initialized");
 
     trace_log_ptr = trace_log_;
+    fold_profiler_samples = fold_profiler_samples_;
     is_trace_log_initialized.store(true, std::memory_order_release);
 }
 
@@ -94,6 +98,32 @@ void TraceCollector::run()
 
     ReadBufferFromFileDescriptor in(TraceSender::pipe.fds_rw[0]);
 
+    /// Identical samples folded within a time window, keyed by everything that
+    /// distinguishes two profiler samples except the sampling moment.
+    /// Only used when fold_profiler_samples is enabled.
+    using SampleKey = std::tuple<UInt8 /* trace_type */, UInt64 /* thread_id */, String /* query_id */, Array /* trace */>;
+    std::map<SampleKey, TraceLogElement> folded_samples;
+    UInt64 last_fold_flush_time_ns = 0;
+
+    /// One row per distinct stack per window keeps trace_log orders of magnitude
+    /// smaller under continuous profiling. The window matches the default flush
+    /// interval of trace_log; the size cap bounds memory for pathological workloads
+    /// with very many distinct stacks.
+    static constexpr UInt64 fold_flush_interval_ns = 7500ULL * 1'000'000;
+    static constexpr size_t fold_max_entries = 64 * 1024;
+
+    auto flush_folded_samples = [&]
+    {
+        if (folded_samples.empty())
+            return;
+
+        if (auto trace_log = getTraceLog())
+            for (auto & [_, sample] : folded_samples)
+                trace_log->add(std::move(sample));
+
+        folded_samples.clear();
+    };
+
     try
     {
         while (true)
@@ -101,7 +131,11 @@ void TraceCollector::run()
             char is_last;
             readChar(is_last, in);
             if (is_last)
+            {
+                /// Do not lose the tail of the folded samples on server shutdown.
+                flush_folded_samples();
                 break;
+            }
 
             std::string query_id;
             UInt8 query_id_size = 0;
@@ -151,7 +185,29 @@ void TraceCollector::run()
                 UInt64 time_in_microseconds = static_cast<UInt64>((ts.tv_sec * 1000000LL) + (ts.tv_nsec / 1000));
 
                 TraceLogElement element{time_t(time / 1000000000), time_in_microseconds, time, trace_type, thread_id, query_id, trace, size, ptr, event, increment};
-                trace_log->add(std::move(element));
+
+                if (fold_profiler_samples && (trace_type == TraceType::Real || trace_type == TraceType::CPU))
+                {
+                    /// Memory and ProfileEvent traces carry a payload in every sample;
+                    /// only the wall-clock and CPU samples are pure (stack, count) data.
+                    /// The folded row keeps the timestamps of the first sample in the window.
+                    SampleKey key{static_cast<UInt8>(trace_type), thread_id, query_id, element.trace};
+                    auto [it, inserted] = folded_samples.try_emplace(std::move(key), std::move(element));
+                    if (!inserted)
+                        ++it->second.samples;
+
+                    /// Flushing is driven by sample arrival, which is fine for a sampling
+                    /// profiler: while it is enabled, samples keep coming.
+                    if (last_fold_flush_time_ns == 0)
+                        last_fold_flush_time_ns = time;
+                    if (time - last_fold_flush_time_ns >= fold_flush_interval_ns || folded_samples.size() >= fold_max_entries)
+                    {
+                        flush_folded_samples();
+                        last_fold_flush_time_ns = time;
+                    }
+                }
+                else
+                    trace_log->add(std::move(element));
             }
         }
     }
@@ -20,7 +20,7 @@ public:
     TraceCollector();
     ~TraceCollector();
 
-    void initialize(std::shared_ptr<TraceLog> trace_log_);
+    void initialize(std::shared_ptr<TraceLog> trace_log_, bool fold_profiler_samples_);
 
 private:
     std::shared_ptr<TraceLog> getTraceLog();
@@ -28,6 +28,11 @@ private:
     std::atomic<bool> is_trace_log_initialized = false;
     std::shared_ptr<TraceLog> trace_log_ptr;
 
+    /// Fold identical Real and CPU samples into (stack, count) rows instead of writing
+    /// every sample to trace_log. Written before is_trace_log_initialized is published
+    /// and only read afterwards, so it needs no synchronization of its own.
+    bool fold_profiler_samples = false;
+
     ThreadFromGlobalPool thread;
 
     void tryClosePipe();
@@ -51,6 +51,8 @@ ColumnsDescription TraceLogElement::getColumnsDescription()
         {"ptr", std::make_shared<DataTypeUInt64>(), "The address of the allocated chunk."},
         {"event", std::make_shared<DataTypeLowCardinality>(std::make_shared<DataTypeString>()), "For trace type ProfileEvent is the name of updated profile event, for other trace types is an empty string."},
         {"increment", std::make_shared<DataTypeInt64>(), "For trace type ProfileEvent is the amount of increment of profile event, for other trace types is 0."},
+        {"samples", std::make_shared<DataTypeUInt64>(), "Number of identical samples folded into this row. "
+            "Greater than 1 only for trace types Real and CPU when the fold_profiler_samples option of trace_log is enabled."},
     };
 }
 
@@ -89,6 +91,7 @@ void TraceLogElement::appendToBlock(MutableColumns & columns) const
 
     columns[i++]->insert(event_name);
     columns[i++]->insert(increment);
+    columns[i++]->insert(samples);
 }
 
 }
@@ -36,6 +36,9 @@ struct TraceLogElement
     ProfileEvents::Event event{ProfileEvents::end()};
     /// Increment of profile event for TraceType::ProfileEvent.
     ProfileEvents::Count increment{};
+    /// Number of identical samples folded into this row. Greater than 1 only for
+    /// TraceType::Real and TraceType::CPU when trace_log.fold_profiler_samples is enabled.
+    UInt64 samples{1};
 
     static std::string name() { return "TraceLog"; }
     static ColumnsDescription getColumnsDescription();
@@ -425,14 +425,14 @@ void logQueryFinish(
 
         elem.query_cache_usage = query_cache_usage;
 
-        if (log_queries && elem.type >= log_queries_min_type
-            && static_cast<Int64>(elem.query_duration_ms) >= log_queries_min_query_duration_ms)
-        {
-            if (auto query_log = context->getQueryLog())
-                query_log->add(elem);
-        }
         if (log_processors_profiles)
         {
+            /// Aggregate the elapsed time of processors by their name, to get a per-stage
+            /// breakdown of the query right in query_log. This works even when the
+            /// processors profile log table itself is not configured.
+            for (const auto & processor : query_pipeline.getProcessors())
+                elem.processors_elapsed_us[processor->getName()] += processor->getElapsedUs();
+
             if (auto processors_profile_log = context->getProcessorsProfileLog())
             {
                 ProcessorProfileLogElement processor_elem;
@@ -477,6 +477,13 @@ void logQueryFinish(
                 }
             }
         }
+
+        if (log_queries && elem.type >= log_queries_min_type
+            && static_cast<Int64>(elem.query_duration_ms) >= log_queries_min_query_duration_ms)
+        {
+            if (auto query_log = context->getQueryLog())
+                query_log->add(elem);
+        }
     }
 
     if (query_span)
@@ -730,9 +737,11 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
     assert(internal || CurrentThread::get().getQueryContext());
     assert(internal || CurrentThread::get().getQueryContext()->getCurrentQueryId() == CurrentThread::getQueryId());
 
-    const Settings & settings = context->getSettingsRef();
+    /// NOTE: this reference is taken before the query is parsed: the SETTINGS clause of the
+    /// query is not applied yet, so only parser-related settings may be read through it.
+    const Settings & parse_settings = context->getSettingsRef();
 
-    size_t max_query_size = settings.max_query_size;
+    size_t max_query_size = parse_settings.max_query_size;
     /// Don't limit the size of internal queries or distributed subquery.
     if (internal || client_info.query_kind == ClientInfo::QueryKind::SECONDARY_QUERY)
         max_query_size = 0;
@@ -745,22 +754,22 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
     /// Parse the query from string.
     try
     {
-        if (settings.dialect == Dialect::kusto && !internal)
+        if (parse_settings.dialect == Dialect::kusto && !internal)
         {
-            ParserKQLStatement parser(end, settings.allow_settings_after_format_in_insert);
+            ParserKQLStatement parser(end, parse_settings.allow_settings_after_format_in_insert);
             /// TODO: parser should fail early when max_query_size limit is reached.
-            ast = parseKQLQuery(parser, begin, end, "", max_query_size, settings.max_parser_depth, settings.max_parser_backtracks);
+            ast = parseKQLQuery(parser, begin, end, "", max_query_size, parse_settings.max_parser_depth, parse_settings.max_parser_backtracks);
         }
-        else if (settings.dialect == Dialect::prql && !internal)
+        else if (parse_settings.dialect == Dialect::prql && !internal)
         {
-            ParserPRQLQuery parser(max_query_size, settings.max_parser_depth, settings.max_parser_backtracks);
-            ast = parseQuery(parser, begin, end, "", max_query_size, settings.max_parser_depth, settings.max_parser_backtracks);
+            ParserPRQLQuery parser(max_query_size, parse_settings.max_parser_depth, parse_settings.max_parser_backtracks);
+            ast = parseQuery(parser, begin, end, "", max_query_size, parse_settings.max_parser_depth, parse_settings.max_parser_backtracks);
         }
         else
         {
-            ParserQuery parser(end, settings.allow_settings_after_format_in_insert);
+            ParserQuery parser(end, parse_settings.allow_settings_after_format_in_insert);
             /// TODO: parser should fail early when max_query_size limit is reached.
-            ast = parseQuery(parser, begin, end, "", max_query_size, settings.max_parser_depth, settings.max_parser_backtracks);
+            ast = parseQuery(parser, begin, end, "", max_query_size, parse_settings.max_parser_depth, parse_settings.max_parser_backtracks);
 
 #ifndef NDEBUG
             /// Verify that AST formatting is consistent:
@@ -777,7 +786,7 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
                 ast2 = parseQuery(parser,
                     formatted1.data(),
                     formatted1.data() + formatted1.size(),
-                    "", new_max_query_size, settings.max_parser_depth, settings.max_parser_backtracks);
+                    "", new_max_query_size, parse_settings.max_parser_depth, parse_settings.max_parser_backtracks);
             }
             catch (const Exception & e)
             {
@@ -908,14 +917,19 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
         /// If it is used - do the random sampling and "collapse" the settings.
         /// It allows to consistently log queries with all the subqueries in distributed query processing
         /// (subqueries on remote nodes will receive these "collapsed" settings)
-        if (!internal && settings.log_queries && settings.log_queries_probability < 1.0)
+        if (!internal && context->getSettingsRef().log_queries && context->getSettingsRef().log_queries_probability < 1.0)
         {
-            std::bernoulli_distribution should_write_log{settings.log_queries_probability};
+            std::bernoulli_distribution should_write_log{context->getSettingsRef().log_queries_probability};
 
             context->setSetting("log_queries", should_write_log(thread_local_rng));
             context->setSetting("log_queries_probability", 1.0);
         }
 
+        /// The SETTINGS clause of the query and the log sampling above were the last modifications of
+        /// the settings of the context. The settings object is copied on the first write (it may be
+        /// shared with the session context), so the long-lived reference is taken only after them.
+        const Settings & settings = context->getSettingsRef();
+
         if (const auto * query_with_table_output = dynamic_cast<const ASTQueryWithTableAndOutput *>(ast.get()))
         {
             query_database = query_with_table_output->getDatabase();
@@ -1111,7 +1125,7 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
                 if (can_use_query_cache && settings.enable_reads_from_query_cache)
                 {
                     QueryCache::Key key(ast, context->getCurrentDatabase(), *settings_copy, context->getUserID(), context->getCurrentRoles());
-                    QueryCache::Reader reader = query_cache->createReader(key);
+                    QueryCache::Reader reader = query_cache->createReader(key, settings.query_cache_partition_invalidation ? context : nullptr);
                     if (reader.hasCacheEntryForKey())
                     {
                         QueryPipeline pipeline;
@@ -1241,6 +1255,9 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
                                 std::chrono::system_clock::now() + std::chrono::seconds(settings.query_cache_ttl),
                                 settings.query_cache_compress_entries);
 
+                            if (settings.query_cache_partition_invalidation)
+                                key.table_versions = collectQueryCacheTableVersions(ast, context);
+
                             const size_t num_query_runs = settings.query_cache_min_query_runs ? query_cache->recordQueryRun(key) : 1; /// try to avoid locking a mutex in recordQueryRun()
                             if (num_query_runs <= settings.query_cache_min_query_runs)
                             {
@@ -1256,7 +1273,8 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
                                                  settings.query_cache_squash_partial_results,
                                                  settings.max_block_size,
                                                  settings.query_cache_max_size_in_bytes,
-                                                 settings.query_cache_max_entries));
+                                                 settings.query_cache_max_entries,
+                                                 settings.query_cache_partition_invalidation ? context : nullptr));
                                 res.pipeline.writeResultIntoQueryCache(query_cache_writer);
                                 query_cache_usage = QueryCache::Usage::Write;
                             }
@@ -25,6 +25,8 @@
 #include <Common/logger_useful.h>
 #include <Common/CurrentMetrics.h>
 
+#include <Poco/Util/AbstractConfiguration.h>
+
 #include <filesystem>
 
 #define ORDINARY_TO_ATOMIC_PREFIX ".tmp_convert."
@@ -157,6 +159,58 @@ static void checkIncompleteOrdinaryToAtomicConversion(ContextPtr context, const
     }
 }
 
+/// Boost tables listed in the `hot_tables` config section into the foreground pool,
+/// so they are loaded and started up before everything else. Used together with
+/// `async_load_databases` to bound the restart time of nodes with many tables by the
+/// size of the hot set instead of the total table count: the rest of the tables keep
+/// loading in the background and are attached lazily on first access.
+static void prioritizeHotTables(ContextMutablePtr context, LoggerPtr log)
+{
+    const auto & config = context->getConfigRef();
+    if (!config.has("hot_tables"))
+        return;
+
+    Poco::Util::AbstractConfiguration::Keys keys;
+    config.keys("hot_tables", keys);
+
+    LoadTaskPtrs hot_tasks;
+    for (const auto & key : keys)
+    {
+        if (key != "table" && !key.starts_with("table["))
+            continue;
+
+        String qualified_name = config.getString("hot_tables." + key);
+        auto dot_pos = qualified_name.find('.');
+        if (dot_pos == String::npos)
+        {
+            LOG_WARNING(log, "Entry '{}' in hot_tables is not a qualified 'database.table' name, ignoring", qualified_name);
+            continue;
+        }
+
+        String database_name = qualified_name.substr(0, dot_pos);
+        String table_name = qualified_name.substr(dot_pos + 1);
+
+        auto database = DatabaseCatalog::instance().tryGetDatabase(database_name);
+        if (!database)
+        {
+            LOG_WARNING(log, "Database of entry '{}' in hot_tables does not exist, ignoring", qualified_name);
+            continue;
+        }
+
+        /// Prioritizing the startup task boosts its load dependency as well.
+        if (auto task = database->tryGetTableStartupTask(table_name))
+            hot_tasks.push_back(task);
+        else
+            LOG_WARNING(log, "Table of entry '{}' in hot_tables does not exist, ignoring", qualified_name);
+    }
+
+    if (!hot_tasks.empty())
+    {
+        LOG_INFO(log, "Prioritizing load and startup of {} tables from hot_tables", hot_tasks.size());
+        prioritizeLoad(TablesLoaderForegroundPoolId, hot_tasks);
+    }
+}
+
 LoadTaskPtrs loadMetadata(ContextMutablePtr context, const String & default_database_name, bool async_load_databases)
 {
     LoggerPtr log = getLogger("loadMetadata");
@@ -255,6 +309,8 @@ LoadTaskPtrs loadMetadata(ContextMutablePtr context, const String & default_data
         scheduleLoad(load_tasks);
         scheduleLoad(startup_tasks);
 
+        prioritizeHotTables(context, log);
+
         // Do NOT wait, just return tasks for continuation or later wait.
         return joinTasks(load_tasks, startup_tasks);
     }
@@ -3,7 +3,10 @@
 #include <Columns/ColumnConst.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnTuple.h>
+#include <Columns/ColumnVector.h>
+#include <Columns/RadixSortHelper.h>
 #include <Functions/FunctionHelpers.h>
+#include <Common/RadixSort.h>
 #include <Common/iota.h>
 
 #ifdef __SSE2__
@@ -117,6 +120,115 @@ ColumnsWithSortDescriptions getColumnsWithSortDescription(const Block & block, c
     return result;
 }
 
+/// Byte width of the column if it is an integer (or Date/Enum, which are stored as integers)
+/// that can participate in the packed-key radix sort, 0 otherwise.
+/// Floating point columns are excluded because of NaN ordering.
+size_t packedSortKeyWidth(const IColumn & column)
+{
+    if (typeid_cast<const ColumnVector<UInt8> *>(&column) || typeid_cast<const ColumnVector<Int8> *>(&column))
+        return 1;
+    if (typeid_cast<const ColumnVector<UInt16> *>(&column) || typeid_cast<const ColumnVector<Int16> *>(&column))
+        return 2;
+    if (typeid_cast<const ColumnVector<UInt32> *>(&column) || typeid_cast<const ColumnVector<Int32> *>(&column))
+        return 4;
+    if (typeid_cast<const ColumnVector<UInt64> *>(&column) || typeid_cast<const ColumnVector<Int64> *>(&column))
+        return 8;
+    return 0;
+}
+
+/// OR the order-preserving bit pattern of the column values into the packed keys at the given bit offset.
+/// Signed values get the sign bit flipped, descending columns are complemented within their width,
+/// so comparing packed keys as UInt64 matches the lexicographic comparison of the sort description.
+template <typename T>
+bool packSortKeyBitsTyped(const IColumn & column, size_t shift_bits, bool reverse, PaddedPODArray<UInt64> & keys)
+{
+    const auto * typed = typeid_cast<const ColumnVector<T> *>(&column);
+    if (!typed)
+        return false;
+
+    using Unsigned = make_unsigned_t<T>;
+    constexpr UInt64 sign_mask = is_signed_v<T> ? (UInt64(1) << (8 * sizeof(T) - 1)) : 0;
+    constexpr UInt64 value_mask = sizeof(T) == 8 ? ~UInt64(0) : ((UInt64(1) << (8 * sizeof(T))) - 1);
+
+    const auto & data = typed->getData();
+    size_t size = data.size();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        UInt64 bits = static_cast<UInt64>(static_cast<Unsigned>(data[i])) ^ sign_mask;
+        if (reverse)
+            bits ^= value_mask;
+        keys[i] |= bits << shift_bits;
+    }
+
+    return true;
+}
+
+bool packSortKeyBits(const IColumn & column, size_t shift_bits, bool reverse, PaddedPODArray<UInt64> & keys)
+{
+    return packSortKeyBitsTyped<UInt8>(column, shift_bits, reverse, keys)
+        || packSortKeyBitsTyped<Int8>(column, shift_bits, reverse, keys)
+        || packSortKeyBitsTyped<UInt16>(column, shift_bits, reverse, keys)
+        || packSortKeyBitsTyped<Int16>(column, shift_bits, reverse, keys)
+        || packSortKeyBitsTyped<UInt32>(column, shift_bits, reverse, keys)
+        || packSortKeyBitsTyped<Int32>(column, shift_bits, reverse, keys)
+        || packSortKeyBitsTyped<UInt64>(column, shift_bits, reverse, keys)
+        || packSortKeyBitsTyped<Int64>(column, shift_bits, reverse, keys);
+}
+
+/** Fast path for multi-column sort over fixed-width integer keys.
+  * When all key columns together fit into 8 bytes, pack them into one UInt64 key per row
+  * (first column in the most significant bits) and run a single LSD radix sort instead of
+  * per-column comparator passes. LSD radix sort over ascending keys is stable, so the result
+  * is a valid stable permutation; descending columns are handled by complementing their bits.
+  */
+bool tryGetSortPermutationOnPackedKeys(
+    const ColumnsWithSortDescriptions & columns, size_t rows, IColumn::Permutation & permutation)
+{
+    /// Same size thresholds as the radix sort path of ColumnVector::getPermutation.
+    if (rows < 256 || rows > std::numeric_limits<UInt32>::max())
+        return false;
+
+    size_t total_width = 0;
+    for (const auto & column : columns)
+    {
+        if (column.column_const)
+            continue;
+
+        if (isCollationRequired(column.description))
+            return false;
+
+        size_t width = packedSortKeyWidth(*column.column);
+        if (!width)
+            return false;
+
+        total_width += width;
+    }
+
+    if (total_width == 0 || total_width > 8)
+        return false;
+
+    PaddedPODArray<UInt64> keys(rows, 0);
+
+    size_t shift_bits = 64;
+    for (const auto & column : columns)
+    {
+        if (column.column_const)
+            continue;
+
+        shift_bits -= 8 * packedSortKeyWidth(*column.column);
+        packSortKeyBits(*column.column, shift_bits, column.description.direction == -1, keys);
+    }
+
+    PaddedPODArray<ValueWithIndex<UInt64>> pairs(rows);
+    for (UInt32 i = 0; i < static_cast<UInt32>(rows); ++i)
+        pairs[i] = {keys[i], i};
+
+    permutation.resize(rows);
+    RadixSort<RadixSortTraits<UInt64>>::executeLSD(pairs.data(), rows, false, permutation.data());
+    return true;
+}
+
 void getBlockSortPermutationImpl(const Block & block, const SortDescription & description, IColumn::PermutationSortStability stability, UInt64 limit, IColumn::Permutation & permutation)
 {
     if (!block)
@@ -155,6 +267,10 @@ void getBlockSortPermutationImpl(const Block & block, const SortDescription & de
     else
     {
         size_t size = block.rows();
+
+        if (!limit && tryGetSortPermutationOnPackedKeys(columns_with_sort_descriptions, size, permutation))
+            return;
+
         permutation.resize(size);
         iota(permutation.data(), size, IColumn::Permutation::value_type(0));
 
@@ -330,8 +446,66 @@ bool isAlreadySorted(const Block & block, const SortDescription & description)
         return isAlreadySortedImpl(rows, less);
     }
 
-    PartialSortingLess less(columns_with_sort_desc);
-    return isAlreadySortedImpl(rows, less);
+    if (rows <= 1)
+        return true;
+
+    /// If the rows are not too few, then let's make a quick attempt to verify that the block is not sorted.
+    static constexpr size_t num_rows_to_try = 10;
+    if (rows > num_rows_to_try * 5)
+    {
+        PartialSortingLess less(columns_with_sort_desc);
+        for (size_t i = 1; i < num_rows_to_try; ++i)
+        {
+            size_t prev_position = rows * (i - 1) / num_rows_to_try;
+            size_t curr_position = rows * i / num_rows_to_try;
+
+            if (less(curr_position, prev_position))
+                return false;
+        }
+    }
+
+    /// Check columns one by one instead of rows one by one: the leading column of the sort key
+    /// is scanned sequentially and every following column only looks at the positions where all
+    /// previous columns compared equal. For a mostly-unique leading column the following columns
+    /// are barely touched, and per-column passes are much more cache-friendly than per-row ones.
+    PaddedPODArray<size_t> equal_positions;
+
+    for (size_t col_idx = 0; col_idx < columns_with_sort_desc.size(); ++col_idx)
+    {
+        const auto & column = *columns_with_sort_desc[col_idx].column;
+        int direction = columns_with_sort_desc[col_idx].description.direction;
+        int nulls_direction = columns_with_sort_desc[col_idx].description.nulls_direction;
+
+        if (col_idx == 0)
+        {
+            for (size_t i = 1; i < rows; ++i)
+            {
+                int res = direction * column.compareAt(i, i - 1, column, nulls_direction);
+                if (res < 0)
+                    return false;
+                if (res == 0)
+                    equal_positions.push_back(i);
+            }
+        }
+        else
+        {
+            size_t still_equal = 0;
+            for (size_t i : equal_positions)
+            {
+                int res = direction * column.compareAt(i, i - 1, column, nulls_direction);
+                if (res < 0)
+                    return false;
+                if (res == 0)
+                    equal_positions[still_equal++] = i;
+            }
+            equal_positions.resize(still_equal);
+        }
+
+        if (equal_positions.empty())
+            break;
+    }
+
+    return true;
 }
 
 }
@@ -137,8 +137,7 @@ Token Lexer::nextTokenImpl()
         case '\v':
         {
             ++pos;
-            while (pos < end && isWhitespaceASCII(*pos))
-                ++pos;
+            pos = find_first_not_symbols<' ', '\t', '\n', '\r', '\f', '\v'>(pos, end);
             return Token(TokenType::Whitespace, token_begin, pos);
         }
 
@@ -155,14 +154,35 @@ Token Lexer::nextTokenImpl()
         {
             /// The task is not to parse a number or check correctness, but only to skip it.
 
+            /// Decimal digits form long runs in large VALUES lists and array literals,
+            /// so they are scanned with a vectorized search; only the possible number
+            /// separators between runs need the scalar check.
+            const auto skip_decimal_digits = [&](bool start_of_block_)
+            {
+                while (pos < end)
+                {
+                    const char * run_end = find_first_not_symbols<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'>(pos, end);
+                    if (run_end != pos)
+                        start_of_block_ = false;
+                    pos = run_end;
+
+                    if (pos < end && isNumberSeparator(start_of_block_, false, pos, end))
+                    {
+                        ++pos;
+                        start_of_block_ = false;
+                    }
+                    else
+                        break;
+                }
+            };
+
             /// Disambiguation: if previous token was dot, then we could parse only simple integer,
             ///  for chained tuple access operators (x.1.1) to work.
             //  Otherwise it will be tokenized as x . 1.1, not as x . 1 . 1
             if (prev_significant_token_type == TokenType::Dot)
             {
                 ++pos;
-                while (pos < end && (isNumericASCII(*pos) || isNumberSeparator(false, false, pos, end)))
-                    ++pos;
+                skip_decimal_digits(false);
             }
             else
             {
@@ -193,22 +213,32 @@ Token Lexer::nextTokenImpl()
                 else
                     ++pos;
 
-                while (pos < end && ((hex ? isHexDigit(*pos) : isNumericASCII(*pos)) || isNumberSeparator(start_of_block, hex, pos, end)))
+                if (hex)
                 {
-                    ++pos;
-                    start_of_block = false;
+                    while (pos < end && (isHexDigit(*pos) || isNumberSeparator(start_of_block, hex, pos, end)))
+                    {
+                        ++pos;
+                        start_of_block = false;
+                    }
                 }
+                else
+                    skip_decimal_digits(start_of_block);
 
                 /// decimal point
                 if (pos < end && *pos == '.')
                 {
                     start_of_block = true;
                     ++pos;
-                    while (pos < end && ((hex ? isHexDigit(*pos) : isNumericASCII(*pos)) || isNumberSeparator(start_of_block, hex, pos, end)))
+                    if (hex)
                     {
-                        ++pos;
-                        start_of_block = false;
+                        while (pos < end && (isHexDigit(*pos) || isNumberSeparator(start_of_block, hex, pos, end)))
+                        {
+                            ++pos;
+                            start_of_block = false;
+                        }
                     }
+                    else
+                        skip_decimal_digits(start_of_block);
                 }
 
                 /// exponentiation (base 10 or base 2)
@@ -221,11 +251,7 @@ Token Lexer::nextTokenImpl()
                     if (pos + 1 < end && (*pos == '-' || *pos == '+'))
                         ++pos;
 
-                    while (pos < end && (isNumericASCII(*pos) || isNumberSeparator(start_of_block, false, pos, end)))
-                    {
-                        ++pos;
-                        start_of_block = false;
-                    }
+                    skip_decimal_digits(start_of_block);
                 }
             }
 
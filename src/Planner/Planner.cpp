@@ -1167,6 +1167,11 @@ PlannerContextPtr buildPlannerContext(const QueryTreeNodePtr & query_tree_node,
             query_tree_node->formatASTForErrorMessage());
 
     auto & mutable_context = query_node ? query_node->getMutableContext() : union_node->getMutableContext();
+
+    /// Planning modifies settings of the context (e.g. disables parallel replicas) while references
+    /// obtained from getSettingsRef() are held, so the settings must not be shared with another context.
+    mutable_context->unshareSettings();
+
     size_t max_subquery_depth = mutable_context->getSettingsRef().max_subquery_depth;
     if (max_subquery_depth && select_query_options.subquery_depth > max_subquery_depth)
         throw Exception(ErrorCodes::TOO_DEEP_SUBQUERIES,
@@ -40,6 +40,7 @@
 #include <Processors/Sources/NullSource.h>
 #include <Processors/QueryPlan/SortingStep.h>
 #include <Processors/QueryPlan/CreateSetAndFilterOnTheFlyStep.h>
+#include <Processors/QueryPlan/Optimizations/Optimizations.h>
 #include <Processors/QueryPlan/ReadFromPreparedSource.h>
 #include <Processors/QueryPlan/ExpressionStep.h>
 #include <Processors/QueryPlan/FilterStep.h>
@@ -1503,7 +1504,26 @@ JoinTreeQueryPlan buildQueryPlanForJoinNode(const QueryTreeNodePtr & join_table_
             bool has_non_const_keys = has_non_const(left_plan.getCurrentDataStream().header, join_clause.key_names_left)
                 && has_non_const(right_plan.getCurrentDataStream().header, join_clause.key_names_right);
 
-            if (settings.max_rows_in_set_to_optimize_join > 0 && kind_allows_filtering && has_non_const_keys)
+            /// If an input is already readable in the order of the join keys, the sort above it
+            /// will be turned into a streaming FinishSorting by the read-in-order optimization.
+            /// Filtering by on-the-fly sets would suppress that (see the note above) and relies
+            /// on both sorts buffering their whole input, so reading in order is preferred.
+            auto join_key_order_is_available = [&](QueryPlan & plan, const Names & key_names)
+            {
+                if (!settings.optimize_read_in_order || !settings.query_plan_read_in_order)
+                    return false;
+
+                SortDescription description;
+                description.reserve(key_names.size());
+                for (const auto & key_name : key_names)
+                    description.emplace_back(key_name);
+
+                return QueryPlanOptimizations::canSubtreeBeReadInOrder(*plan.getRootNode(), description);
+            };
+
+            if (settings.max_rows_in_set_to_optimize_join > 0 && kind_allows_filtering && has_non_const_keys
+                && !join_key_order_is_available(left_plan, join_clause.key_names_left)
+                && !join_key_order_is_available(right_plan, join_clause.key_names_right))
             {
                 auto * left_set = add_create_set(left_plan, join_clause.key_names_left, JoinTableSide::Left);
                 auto * right_set = add_create_set(right_plan, join_clause.key_names_right, JoinTableSide::Right);
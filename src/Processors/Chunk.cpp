@@ -96,6 +96,9 @@ MutableColumns Chunk::mutateColumns()
 
 MutableColumns Chunk::cloneEmptyColumns() const
 {
+    if (auto recycled = ChunkRecyclePool::instance().tryGetColumns(columns); !recycled.empty())
+        return recycled;
+
     size_t num_columns = columns.size();
     MutableColumns mutable_columns(num_columns);
     for (size_t i = 0; i < num_columns; ++i)
@@ -103,6 +106,90 @@ MutableColumns Chunk::cloneEmptyColumns() const
     return mutable_columns;
 }
 
+ChunkRecyclePool & ChunkRecyclePool::instance()
+{
+    static thread_local ChunkRecyclePool pool;
+    return pool;
+}
+
+void ChunkRecyclePool::setEnabled(bool enabled_)
+{
+    enabled = enabled_;
+    if (!enabled)
+    {
+        entries.clear();
+        total_bytes = 0;
+    }
+}
+
+void ChunkRecyclePool::recycle(Chunk && chunk)
+{
+    if (!enabled || entries.size() >= max_entries || !chunk.hasColumns())
+        return;
+
+    Columns columns = chunk.detachColumns();
+    MutableColumns emptied;
+    emptied.reserve(columns.size());
+    size_t allocated_bytes = 0;
+
+    for (auto & column : columns)
+    {
+        /// The column may be shared with a downstream chunk or cached somewhere; do not touch it then.
+        /// Constant columns carry no buffers worth keeping.
+        if (!column || column->use_count() != 1 || isColumnConst(*column))
+            return;
+
+        auto mutable_column = IColumn::mutate(std::move(column));
+        if (size_t rows = mutable_column->size())
+            mutable_column->popBack(rows);   /// Keeps the allocated buffers.
+        allocated_bytes += mutable_column->allocatedBytes();
+        emptied.push_back(std::move(mutable_column));
+    }
+
+    /// Oversized buffers are freed rather than pooled: pipeline threads outlive queries,
+    /// and a few peak-size chunks would otherwise stay pinned until the pool is purged.
+    if (allocated_bytes > max_entry_bytes || total_bytes + allocated_bytes > max_total_bytes)
+        return;
+
+    total_bytes += allocated_bytes;
+    entries.push_back({std::move(emptied), allocated_bytes});
+}
+
+MutableColumns ChunkRecyclePool::tryGetColumns(const Columns & prototypes)
+{
+    if (!enabled)
+        return {};
+
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        auto & entry = it->columns;
+        if (entry.size() != prototypes.size())
+            continue;
+
+        bool matches = true;
+        for (size_t i = 0; i < entry.size(); ++i)
+        {
+            /// Compare full type names: typeid alone is not enough for composite columns
+            /// (Array(UInt8) and Array(String) are both ColumnArray).
+            if (typeid(*entry[i]) != typeid(*prototypes[i]) || entry[i]->getName() != prototypes[i]->getName())
+            {
+                matches = false;
+                break;
+            }
+        }
+
+        if (!matches)
+            continue;
+
+        MutableColumns res = std::move(entry);
+        total_bytes -= it->allocated_bytes;
+        entries.erase(it);
+        return res;
+    }
+
+    return {};
+}
+
 Columns Chunk::detachColumns()
 {
     num_rows = 0;
@@ -114,6 +114,56 @@ private:
 
 using Chunks = std::vector<Chunk>;
 
+/** Thread-local pool of empty columns recycled from exhausted chunks.
+  *
+  * Steady-state pipelines allocate and free column buffers for every chunk. The pool keeps
+  * the buffers of a few recently consumed chunks alive (emptied with popBack, so the
+  * allocations are retained) and hands them out to code that needs fresh columns of the
+  * same layout, typically via Chunk::cloneEmptyColumns. It is thread local, so no
+  * synchronization is involved; pipeline executor threads each get their own pool.
+  *
+  * Only columns that are not referenced from anywhere else are recycled.
+  *
+  * The pool is disabled by default and enabled by the pipeline executor for the duration
+  * of one query when the recycle_chunk_buffers setting is on. Disabling purges the pooled
+  * buffers: executor threads are reused across queries, and memory allocated under one
+  * query's memory tracker must not stay pinned after the query is gone. Entries are also
+  * bounded in bytes, so a query with huge chunks does not park hundreds of megabytes of
+  * reserved buffers per thread.
+  */
+class ChunkRecyclePool
+{
+public:
+    static ChunkRecyclePool & instance();
+
+    /// Enabling is done per executor thread for the duration of one query.
+    /// Disabling frees everything the pool holds.
+    void setEnabled(bool enabled_);
+
+    /// Offer the columns of an exhausted chunk for reuse. Columns referenced elsewhere
+    /// or chunks that do not fit into the pool are simply destroyed as before.
+    void recycle(Chunk && chunk);
+
+    /// Return empty columns matching the given ones by type, with buffers retained from
+    /// a previously recycled chunk. Empty result means nothing suitable is pooled.
+    MutableColumns tryGetColumns(const Columns & prototypes);
+
+private:
+    static constexpr size_t max_entries = 8;
+    static constexpr size_t max_entry_bytes = 16 * 1024 * 1024;
+    static constexpr size_t max_total_bytes = 64 * 1024 * 1024;
+
+    struct Entry
+    {
+        MutableColumns columns;
+        size_t allocated_bytes = 0;
+    };
+
+    bool enabled = false;
+    size_t total_bytes = 0;
+    std::vector<Entry> entries;
+};
+
 /// AsyncInsert needs two kinds of information:
 /// - offsets of different sub-chunks
 /// - tokens of different sub-chunks, which are assigned by setting `insert_deduplication_token`.
@@ -3,6 +3,7 @@
 #include <Common/CurrentThread.h>
 #include <Common/CurrentMetrics.h>
 #include <Common/setThreadName.h>
+#include <Processors/Chunk.h>
 #include <Processors/Executors/PipelineExecutor.h>
 #include <Processors/Executors/ExecutingGraph.h>
 #include <QueryPipeline/printPipeline.h>
@@ -41,6 +42,8 @@ PipelineExecutor::PipelineExecutor(std::shared_ptr<Processors> & processors, Que
     {
         profile_processors = process_list_element->getContext()->getSettingsRef().log_processors_profiles;
         trace_processors = process_list_element->getContext()->getSettingsRef().opentelemetry_trace_processors;
+        allow_preemption = process_list_element->getContext()->getSettingsRef().concurrency_control_preemption;
+        recycle_chunk_buffers = process_list_element->getContext()->getSettingsRef().recycle_chunk_buffers;
     }
     try
     {
@@ -144,7 +147,13 @@ bool PipelineExecutor::executeStep(std::atomic_bool * yield_flag)
             return true;
     }
 
-    executeStepImpl(0, yield_flag);
+    {
+        /// Step-wise execution happens on the caller's thread; keep the pool scoped to
+        /// one step so nothing stays pinned while control is outside the executor.
+        ChunkRecyclePool::instance().setEnabled(recycle_chunk_buffers);
+        SCOPE_EXIT_SAFE(ChunkRecyclePool::instance().setEnabled(false));
+        executeStepImpl(0, yield_flag);
+    }
 
     if (!tasks.isFinished())
         return true;
@@ -235,6 +244,11 @@ void PipelineExecutor::finalizeExecution()
 
 void PipelineExecutor::executeSingleThread(size_t thread_num)
 {
+    /// The pool lives in the executor thread, which is reused across queries:
+    /// disabling on exit purges it, so no buffers survive this query.
+    ChunkRecyclePool::instance().setEnabled(recycle_chunk_buffers);
+    SCOPE_EXIT_SAFE(ChunkRecyclePool::instance().setEnabled(false));
+
     executeStepImpl(thread_num);
 
 #ifndef NDEBUG
@@ -259,6 +273,12 @@ void PipelineExecutor::executeStepImpl(size_t thread_num, std::atomic_bool * yie
 
     while (!tasks.isFinished() && !yield)
     {
+        /// Cooperative preemption: if other queries are waiting for CPU slots, release this
+        /// thread's slot between tasks instead of keeping it until the query finishes.
+        /// The remaining threads keep executing the query, and the last one is never preempted.
+        if (allow_preemption && !context.hasTask() && cpu_slots->isPreemptionRequested() && preemptThread())
+            break;
+
         /// First, find any processor to execute.
         /// Just traverse graph and prepare any processor.
         while (!tasks.isFinished() && !context.hasTask())
@@ -350,6 +370,7 @@ void PipelineExecutor::spawnThreads()
     while (auto slot = cpu_slots->tryAcquire())
     {
         size_t thread_num = threads.fetch_add(1);
+        active_threads.fetch_add(1);
 
         /// Count of threads in use should be updated for proper finish() condition.
         /// NOTE: this will not decrease `use_threads` below initially granted count
@@ -381,6 +402,18 @@ void PipelineExecutor::spawnThreads()
     }
 }
 
+bool PipelineExecutor::preemptThread()
+{
+    /// Keep at least one thread running to guarantee progress of the query.
+    size_t count = active_threads.load();
+    while (count > 1)
+    {
+        if (active_threads.compare_exchange_weak(count, count - 1))
+            return true;
+    }
+    return false;
+}
+
 void PipelineExecutor::executeImpl(size_t num_threads, bool concurrency_control)
 {
     initializeExecution(num_threads, concurrency_control);
@@ -74,6 +74,10 @@ private:
     AcquiredSlotPtr single_thread_cpu_slot; // cpu slot for single-thread mode to work using executeStep()
     std::unique_ptr<ThreadPool> pool;
     std::atomic_size_t threads = 0;
+    /// Number of threads currently executing the pipeline. Decremented on cooperative preemption.
+    std::atomic_size_t active_threads = 0;
+    /// Release CPU slots between tasks when other queries are waiting for them (see `concurrency_control_preemption` setting).
+    bool allow_preemption = false;
 
     /// Flag that checks that initializeExecution was called.
     bool is_execution_initialized = false;
@@ -81,6 +85,8 @@ private:
     bool profile_processors = false;
     /// system.opentelemetry_span_log
     bool trace_processors = false;
+    /// Enable the thread-local ChunkRecyclePool on executor threads for this query.
+    bool recycle_chunk_buffers = false;
 
     std::atomic_bool cancelled = false;
     std::atomic_bool cancelled_reading = false;
@@ -100,6 +106,7 @@ private:
     void initializeExecution(size_t num_threads, bool concurrency_control); /// Initialize executor contexts and task_queue.
     void finalizeExecution(); /// Check all processors are finished.
     void spawnThreads();
+    bool preemptThread(); /// Try to account the current thread as preempted. Never preempts the last thread.
 
     /// Methods connected to execution.
     void executeImpl(size_t num_threads, bool concurrency_control);
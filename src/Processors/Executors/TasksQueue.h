@@ -40,9 +40,33 @@ public:
         throw Exception(ErrorCodes::LOGICAL_ERROR, "TaskQueue is empty");
     }
 
+    /// The thread that owns the deepest queue. On skewed pipelines (one huge part, many tiny
+    /// ones) a single thread accumulates most of the ready tasks; stealing from it spreads the
+    /// backlog fastest and keeps the other threads from re-entering here immediately.
+    size_t getThreadWithMostTasks() const
+    {
+        if (num_tasks == 0)
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "TaskQueue is empty");
+
+        size_t max_thread = 0;
+        size_t max_size = 0;
+
+        for (size_t i = 0; i < queues.size(); ++i)
+        {
+            if (queues[i].size() > max_size)
+            {
+                max_size = queues[i].size();
+                max_thread = i;
+            }
+        }
+
+        return max_thread;
+    }
+
     Task * pop(size_t thread_num)
     {
-        auto thread_with_tasks = getAnyThreadWithTasks(thread_num);
+        /// Prefer the thread's own queue; steal from the most loaded thread otherwise.
+        auto thread_with_tasks = queues[thread_num].empty() ? getThreadWithMostTasks() : thread_num;
 
         Task * task = queues[thread_with_tasks].front();
         queues[thread_with_tasks].pop();
@@ -11,7 +11,11 @@
 #include <IO/Operators.h>
 #include <IO/ReadHelpers.h>
 #include <IO/HTTPCommon.h>
+#include <IO/NullWriteBuffer.h>
+#include <IO/ReadBufferFromMemory.h>
 #include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromVector.h>
+#include <IO/copyData.h>
 
 #include <Formats/FormatFactory.h>
 
@@ -59,6 +63,13 @@
 #include <Poco/URI.h>
 
 
+namespace CurrentMetrics
+{
+    extern const Metric AvroDecoderThreads;
+    extern const Metric AvroDecoderThreadsActive;
+    extern const Metric AvroDecoderThreadsScheduled;
+}
+
 namespace DB
 {
 
@@ -957,6 +968,250 @@ size_t AvroRowInputFormat::countRows(size_t max_block_size)
     return num_rows;
 }
 
+static constexpr size_t AVRO_SYNC_MARKER_SIZE = 16;
+
+/// Read an Avro zigzag-encoded long, mirroring the consumed raw bytes into `copy`.
+static Int64 readAvroLong(ReadBuffer & in, WriteBuffer & copy)
+{
+    UInt64 encoded = 0;
+    UInt32 shift = 0;
+    UInt8 byte;
+    do
+    {
+        if (shift > 63)
+            throw Exception(ErrorCodes::INCORRECT_DATA, "Malformed varint in Avro file");
+        readBinary(byte, in);
+        copy.write(static_cast<char>(byte));
+        encoded |= static_cast<UInt64>(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    return static_cast<Int64>(encoded >> 1) ^ -static_cast<Int64>(encoded & 1);
+}
+
+AvroParallelBlockInputFormat::AvroParallelBlockInputFormat(
+    const Block & header_, ReadBuffer & in_, const FormatSettings & format_settings_, size_t max_decoding_threads_)
+    : IInputFormat(header_, &in_), format_settings(format_settings_), max_decoding_threads(max_decoding_threads_)
+{
+}
+
+AvroParallelBlockInputFormat::~AvroParallelBlockInputFormat()
+{
+    waitForAllBlocks();
+}
+
+void AvroParallelBlockInputFormat::waitForAllBlocks()
+{
+    for (auto & block : pending_blocks)
+    {
+        if (block.valid())
+        {
+            try
+            {
+                block.wait();
+            }
+            catch (...) /// NOLINT(bugprone-empty-catch)
+            {
+            }
+        }
+    }
+    pending_blocks.clear();
+}
+
+void AvroParallelBlockInputFormat::resetParser()
+{
+    waitForAllBlocks();
+    initialized = false;
+    end_of_input = false;
+    header_buffer.clear();
+    schema.reset();
+    block_missing_values.clear();
+    IInputFormat::resetParser();
+}
+
+void AvroParallelBlockInputFormat::initialize()
+{
+    initialized = true;
+
+    if (in->eof())
+    {
+        end_of_input = true;
+        return;
+    }
+
+    /// Capture the raw header (magic, metadata map, sync marker), parsing just enough
+    /// of the framing to find where it ends. See the Avro object container file spec.
+    WriteBufferFromVector<std::vector<char>> copy(header_buffer);
+
+    char magic[4];
+    in->readStrict(magic, sizeof(magic));
+    copy.write(magic, sizeof(magic));
+    if (memcmp(magic, "Obj\x01", sizeof(magic)) != 0)
+        throw Exception(ErrorCodes::INCORRECT_DATA, "Invalid magic bytes, not an Avro object container file");
+
+    while (true)
+    {
+        Int64 num_entries = readAvroLong(*in, copy);
+        if (num_entries == 0)
+            break;
+        if (num_entries < 0)
+        {
+            /// A negative count is followed by the byte size of the map block.
+            readAvroLong(*in, copy);
+            num_entries = -num_entries;
+        }
+        for (Int64 i = 0; i < num_entries * 2; ++i)
+        {
+            Int64 length = readAvroLong(*in, copy);
+            if (length < 0)
+                throw Exception(ErrorCodes::INCORRECT_DATA, "Malformed metadata in Avro file");
+            copyData(*in, copy, length);
+        }
+    }
+    copyData(*in, copy, AVRO_SYNC_MARKER_SIZE);
+    copy.finalize();
+
+    /// Let the avro library parse the captured header to get the schema (and validate the codec).
+    ReadBufferFromMemory header_in(header_buffer.data(), header_buffer.size());
+    avro::DataFileReaderBase header_reader(std::make_unique<AvroInputStreamReadBufferAdapter>(header_in));
+    schema = header_reader.dataSchema();
+
+    pool = std::make_unique<ThreadPool>(
+        CurrentMetrics::AvroDecoderThreads,
+        CurrentMetrics::AvroDecoderThreadsActive,
+        CurrentMetrics::AvroDecoderThreadsScheduled,
+        max_decoding_threads);
+    runner = threadPoolCallbackRunnerUnsafe<DecodedBlock>(*pool, "AvroDecoder");
+}
+
+bool AvroParallelBlockInputFormat::readNextRawBlock(std::vector<char> & out)
+{
+    if (end_of_input || in->eof())
+    {
+        end_of_input = true;
+        return false;
+    }
+
+    out.assign(header_buffer.begin(), header_buffer.end());
+    WriteBufferFromVector<std::vector<char>> copy(out, AppendModeTag{});
+
+    Int64 num_rows = readAvroLong(*in, copy);
+    Int64 data_size = readAvroLong(*in, copy);
+    if (num_rows < 0 || data_size < 0)
+        throw Exception(ErrorCodes::INCORRECT_DATA, "Malformed block header in Avro file");
+    copyData(*in, copy, data_size);
+    copyData(*in, copy, AVRO_SYNC_MARKER_SIZE);
+    copy.finalize();
+    return true;
+}
+
+std::unique_ptr<AvroDeserializer> AvroParallelBlockInputFormat::takeDeserializer()
+{
+    {
+        std::lock_guard lock(deserializers_mutex);
+        if (!idle_deserializers.empty())
+        {
+            auto deserializer = std::move(idle_deserializers.back());
+            idle_deserializers.pop_back();
+            return deserializer;
+        }
+    }
+    return std::make_unique<AvroDeserializer>(
+        getPort().getHeader(), *schema, format_settings.avro.allow_missing_fields, format_settings.null_as_default, format_settings);
+}
+
+void AvroParallelBlockInputFormat::returnDeserializer(std::unique_ptr<AvroDeserializer> deserializer)
+{
+    std::lock_guard lock(deserializers_mutex);
+    idle_deserializers.push_back(std::move(deserializer));
+}
+
+AvroParallelBlockInputFormat::DecodedBlock AvroParallelBlockInputFormat::decodeBlock(const std::vector<char> & buffer)
+{
+    auto deserializer = takeDeserializer();
+
+    ReadBufferFromMemory block_in(buffer.data(), buffer.size());
+    avro::DataFileReaderBase block_reader(std::make_unique<AvroInputStreamReadBufferAdapter>(block_in));
+    block_reader.init();
+
+    const auto & header = getPort().getHeader();
+    MutableColumns columns = header.cloneEmptyColumns();
+    DecodedBlock result;
+    RowReadExtension ext;
+    size_t num_rows = 0;
+    while (block_reader.hasMore() && !is_stopped)
+    {
+        block_reader.decr();
+        deserializer->deserializeRow(columns, block_reader.decoder(), ext);
+        for (size_t i = 0; i < ext.read_columns.size(); ++i)
+        {
+            if (!ext.read_columns[i])
+                result.missing_values.setBit(i, num_rows);
+        }
+        ++num_rows;
+    }
+
+    returnDeserializer(std::move(deserializer));
+    result.chunk = Chunk(std::move(columns), num_rows);
+    return result;
+}
+
+void AvroParallelBlockInputFormat::scheduleBlocks()
+{
+    while (!end_of_input && pending_blocks.size() < max_decoding_threads + 2)
+    {
+        std::vector<char> buffer;
+        if (!readNextRawBlock(buffer))
+            break;
+
+        pending_blocks.push_back(
+            runner([this, block = std::make_shared<std::vector<char>>(std::move(buffer))] { return decodeBlock(*block); }, Priority{}));
+    }
+}
+
+Chunk AvroParallelBlockInputFormat::read()
+{
+    if (is_stopped)
+        return {};
+
+    block_missing_values.clear();
+
+    if (!initialized)
+        initialize();
+
+    if (need_only_count && pending_blocks.empty())
+    {
+        /// Block headers carry the row count, so counting does not need decoding at all.
+        NullWriteBuffer null_out;
+        size_t total_rows = 0;
+        while (!end_of_input && !in->eof())
+        {
+            Int64 num_rows = readAvroLong(*in, null_out);
+            Int64 data_size = readAvroLong(*in, null_out);
+            if (num_rows < 0 || data_size < 0)
+                throw Exception(ErrorCodes::INCORRECT_DATA, "Malformed block header in Avro file");
+            in->ignore(data_size + AVRO_SYNC_MARKER_SIZE);
+            total_rows += num_rows;
+        }
+        end_of_input = true;
+        return total_rows ? getChunkForCount(total_rows) : Chunk{};
+    }
+
+    scheduleBlocks();
+
+    if (pending_blocks.empty())
+        return {};
+
+    auto decoded = pending_blocks.front().get();
+    pending_blocks.pop_front();
+
+    /// Refill the pipeline before handing the chunk to the query.
+    scheduleBlocks();
+
+    block_missing_values = std::move(decoded.missing_values);
+    return std::move(decoded.chunk);
+}
+
 class AvroConfluentRowInputFormat::SchemaRegistry
 {
 public:
@@ -1302,7 +1557,15 @@ void registerInputFormatAvro(FormatFactory & factory)
         const RowInputFormatParams & params,
         const FormatSettings & settings)
     {
-        return std::make_shared<AvroRowInputFormat>(sample, buf, params, settings);
+        InputFormatPtr res;
+        /// The parallel decoder does not support skipping broken rows, so it is used
+        /// only when parse errors are not tolerated.
+        if (settings.avro.parallel_block_decoding && settings.max_threads > 1
+            && params.allow_errors_num == 0 && params.allow_errors_ratio == 0.0)
+            res = std::make_shared<AvroParallelBlockInputFormat>(sample, buf, settings, settings.max_threads);
+        else
+            res = std::make_shared<AvroRowInputFormat>(sample, buf, params, settings);
+        return res;
     });
 
     factory.markFormatSupportsSubsetOfColumns("Avro");
@@ -4,11 +4,13 @@
 
 #if USE_AVRO
 
+#include <deque>
 #include <unordered_map>
 #include <map>
 #include <vector>
 
 #include <Core/Block.h>
+#include <Common/threadPoolCallbackRunner.h>
 #include <Formats/FormatSettings.h>
 #include <Formats/FormatSchemaInfo.h>
 #include <Processors/Formats/IRowInputFormat.h>
@@ -168,6 +170,75 @@ private:
     FormatSettings format_settings;
 };
 
+/// Decodes Avro object container files block by block in a thread pool.
+/// The container format is block-structured (each block is compressed independently and
+/// followed by a sync marker), so the caller thread only splits the raw blocks, and every
+/// worker decodes its block through its own DataFileReaderBase over the captured file
+/// header plus the block bytes. Chunks are returned in file order.
+class AvroParallelBlockInputFormat final : public IInputFormat
+{
+public:
+    AvroParallelBlockInputFormat(const Block & header_, ReadBuffer & in_, const FormatSettings & format_settings_, size_t max_decoding_threads_);
+
+    ~AvroParallelBlockInputFormat() override;
+
+    String getName() const override { return "AvroParallelBlockInputFormat"; }
+
+    void resetParser() override;
+
+    const BlockMissingValues & getMissingValues() const override { return block_missing_values; }
+
+protected:
+    Chunk read() override;
+
+    void onCancel() override
+    {
+        is_stopped = 1;
+    }
+
+private:
+    struct DecodedBlock
+    {
+        Chunk chunk;
+        BlockMissingValues missing_values;
+    };
+
+    /// Parse and capture the raw file header, extract the schema, create the thread pool.
+    void initialize();
+    /// Read the raw bytes of the next container block into a buffer prefixed with the file header.
+    bool readNextRawBlock(std::vector<char> & out);
+    /// Keep up to max_decoding_threads + 2 blocks in flight.
+    void scheduleBlocks();
+    DecodedBlock decodeBlock(const std::vector<char> & buffer);
+    void waitForAllBlocks();
+
+    std::unique_ptr<AvroDeserializer> takeDeserializer();
+    void returnDeserializer(std::unique_ptr<AvroDeserializer> deserializer);
+
+    FormatSettings format_settings;
+    size_t max_decoding_threads;
+
+    bool initialized = false;
+    bool end_of_input = false;
+
+    /// Raw bytes of the container header (magic, metadata, sync marker); prepended to every block.
+    std::vector<char> header_buffer;
+    std::optional<avro::ValidSchema> schema;
+
+    std::unique_ptr<ThreadPool> pool;
+    ThreadPoolCallbackRunnerUnsafe<DecodedBlock> runner;
+    std::deque<std::future<DecodedBlock>> pending_blocks;
+
+    /// Deserializers are stateful (they keep scratch buffers), so every in-flight block
+    /// uses its own instance; finished instances are reused.
+    std::mutex deserializers_mutex;
+    std::vector<std::unique_ptr<AvroDeserializer>> idle_deserializers;
+
+    BlockMissingValues block_missing_values;
+
+    std::atomic<int> is_stopped{0};
+};
+
 /// Confluent framing + Avro binary datum encoding. Mainly used for Kafka.
 /// Uses 3 caches:
 /// 1. global: schema registry cache (base_url -> SchemaRegistry)
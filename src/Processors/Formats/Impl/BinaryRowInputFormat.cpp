@@ -5,6 +5,8 @@
 #include <Formats/registerWithNamesAndTypes.h>
 #include <DataTypes/DataTypeFactory.h>
 
+#include <bit>
+
 namespace DB
 {
 
@@ -27,6 +29,84 @@ BinaryRowInputFormat<with_defaults>::BinaryRowInputFormat(ReadBuffer & in_, cons
 {
 }
 
+template <bool with_defaults>
+void BinaryRowInputFormat<with_defaults>::resetParser()
+{
+    RowInputFormatWithNamesAndTypes::resetParser();
+
+    /// The column mapping may change after reset (e.g. a new file with a different names header).
+    fused_fields.clear();
+    fused_row_size = 0;
+    fused_row_prepared = false;
+    use_fused_row = false;
+}
+
+template <bool with_defaults>
+bool BinaryRowInputFormat<with_defaults>::readRow(MutableColumns & columns, RowReadExtension & ext)
+{
+    /// RowBinaryWithDefaults prepends every field with an is-default byte, so rows are not fixed-width.
+    if constexpr (!with_defaults)
+    {
+        if (!fused_row_prepared)
+            prepareFusedRow();
+
+        /// The fast path requires the whole row to be in the buffer; rows that cross the buffer
+        /// boundary (and the last rows before EOF) go through the generic field-by-field path.
+        if (use_fused_row && in->available() >= fused_row_size)
+        {
+            const char * pos = in->position();
+            for (const auto & field : fused_fields)
+            {
+                columns[field.column_index]->insertData(pos, field.size);
+                pos += field.size;
+            }
+            in->position() += fused_row_size;
+
+            ext.read_columns.assign(columns.size(), true);
+            return true;
+        }
+    }
+
+    return RowInputFormatWithNamesAndTypes::readRow(columns, ext);
+}
+
+template <bool with_defaults>
+void BinaryRowInputFormat<with_defaults>::prepareFusedRow()
+{
+    fused_row_prepared = true;
+
+    /// On big-endian platforms the little-endian binary representation differs from the in-memory one.
+    if constexpr (std::endian::native != std::endian::little)
+        return;
+
+    /// All columns must be present in the data, otherwise defaults must be inserted per row.
+    if (!column_mapping->not_presented_columns.empty())
+        return;
+
+    for (const auto & column_index : column_mapping->column_indexes_for_input_fields)
+    {
+        if (!column_index)
+            return;
+
+        const auto & type = data_types[*column_index];
+        /// Types whose RowBinary representation is the raw in-memory value, so that
+        /// deserializeBinary is equivalent to IColumn::insertData of a fixed number of bytes.
+        WhichDataType which(type);
+        bool is_raw_fixed_width = which.isNativeInt() || which.isNativeUInt() || which.isFloat()
+            || which.isDate() || which.isDate32() || which.isDateTime() || which.isDateTime64()
+            || which.isEnum() || which.isDecimal() || which.isUUID() || which.isIPv4() || which.isIPv6()
+            || which.isFixedString();
+        if (!is_raw_fixed_width)
+            return;
+
+        size_t size = type->getSizeOfValueInMemory();
+        fused_fields.push_back({*column_index, size});
+        fused_row_size += size;
+    }
+
+    use_fused_row = !fused_fields.empty();
+}
+
 template <bool with_defaults>
 BinaryFormatReader<with_defaults>::BinaryFormatReader(ReadBuffer & in_, const FormatSettings & format_settings_) : FormatWithNamesAndTypesReader(in_, format_settings_)
 {
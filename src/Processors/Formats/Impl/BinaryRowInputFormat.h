@@ -24,6 +24,27 @@ public:
     /// in this format we cannot provide any DiagnosticInfo, because here we have
     /// just binary data.
     std::string getDiagnosticInfo() override { return {}; }
+
+    void resetParser() override;
+
+private:
+    bool readRow(MutableColumns & columns, RowReadExtension & ext) override;
+
+    /// If the row consists only of fixed-width values whose binary representation matches
+    /// the in-memory one, deserialization of the whole row is fused into one flat loop with
+    /// a single bounds check and no virtual dispatch per field. Prepared lazily on the first
+    /// row, when the column mapping is already known.
+    void prepareFusedRow();
+
+    struct FusedField
+    {
+        size_t column_index;
+        size_t size;
+    };
+    std::vector<FusedField> fused_fields;
+    size_t fused_row_size = 0;
+    bool fused_row_prepared = false;
+    bool use_fused_row = false;
 };
 
 template <bool with_defaults = false>
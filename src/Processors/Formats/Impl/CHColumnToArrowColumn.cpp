@@ -110,6 +110,60 @@ namespace DB
         return res;
     }
 
+    /// arrow::Buffer that aliases the PODArray of a fixed-width column instead of copying it.
+    /// Holds a reference to the column, so the data outlives any Arrow array built on top.
+    class ColumnBackedArrowBuffer : public arrow::Buffer
+    {
+    public:
+        ColumnBackedArrowBuffer(ColumnPtr column_, const uint8_t * data_, int64_t size_)
+            : arrow::Buffer(data_, size_), column(std::move(column_))
+        {
+        }
+
+    private:
+        ColumnPtr column;
+    };
+
+    template <typename NumericType>
+    static std::shared_ptr<arrow::Array> wrapNumericColumnZeroCopy(
+        const ColumnPtr & column, const std::shared_ptr<arrow::DataType> & arrow_type)
+    {
+        const auto * typed_column = typeid_cast<const ColumnVector<NumericType> *>(column.get());
+        if (!typed_column)
+            return {};
+
+        const auto & data = typed_column->getData();
+        auto buffer = std::make_shared<ColumnBackedArrowBuffer>(
+            column, reinterpret_cast<const uint8_t *>(data.data()), data.size() * sizeof(NumericType));
+
+        auto array_data = arrow::ArrayData::Make(arrow_type, data.size(), {nullptr, std::move(buffer)}, /*null_count=*/ 0);
+        return arrow::MakeArray(array_data);
+    }
+
+    /** Zero-copy conversion of a whole top-level column: when the ClickHouse in-memory layout
+      * matches the Arrow layout of the target type exactly (fixed-width integers and floats,
+      * no nulls), the column buffer is wrapped as an arrow::Buffer and the conversion becomes
+      * metadata-only. Returns nullptr when the builder-based path has to be used.
+      */
+    static std::shared_ptr<arrow::Array> tryCHColumnToArrowArrayZeroCopy(
+        const ColumnPtr & column, const std::shared_ptr<arrow::DataType> & arrow_type)
+    {
+        switch (arrow_type->id())
+        {
+            case arrow::Type::UINT8: return wrapNumericColumnZeroCopy<UInt8>(column, arrow_type);
+            case arrow::Type::INT8: return wrapNumericColumnZeroCopy<Int8>(column, arrow_type);
+            case arrow::Type::UINT16: return wrapNumericColumnZeroCopy<UInt16>(column, arrow_type);
+            case arrow::Type::INT16: return wrapNumericColumnZeroCopy<Int16>(column, arrow_type);
+            case arrow::Type::UINT32: return wrapNumericColumnZeroCopy<UInt32>(column, arrow_type);
+            case arrow::Type::INT32: return wrapNumericColumnZeroCopy<Int32>(column, arrow_type);
+            case arrow::Type::UINT64: return wrapNumericColumnZeroCopy<UInt64>(column, arrow_type);
+            case arrow::Type::INT64: return wrapNumericColumnZeroCopy<Int64>(column, arrow_type);
+            case arrow::Type::FLOAT: return wrapNumericColumnZeroCopy<Float32>(column, arrow_type);
+            case arrow::Type::DOUBLE: return wrapNumericColumnZeroCopy<Float64>(column, arrow_type);
+            default: return {};
+        }
+    }
+
     template <typename NumericType, typename ArrowBuilderType>
     static void fillArrowArrayWithNumericColumnData(
         ColumnPtr write_column,
@@ -1026,26 +1080,30 @@ namespace DB
                     arrow_fields.emplace_back(std::make_shared<arrow::Field>(header_column.name, arrow_type, is_column_nullable));
                 }
 
-                arrow::MemoryPool * pool = ArrowMemoryPool::instance();
-                std::unique_ptr<arrow::ArrayBuilder> array_builder;
-                arrow::Status status = MakeBuilder(pool, arrow_fields[column_i]->type(), &array_builder);
-                checkStatus(status, column->getName(), format_name);
-
-                fillArrowArray(
-                    header_column.name,
-                    column,
-                    header_column.type,
-                    nullptr,
-                    array_builder.get(),
-                    format_name,
-                    0,
-                    column->size(),
-                    settings,
-                    dictionary_values);
-
-                std::shared_ptr<arrow::Array> arrow_array;
-                status = array_builder->Finish(&arrow_array);
-                checkStatus(status, column->getName(), format_name);
+                std::shared_ptr<arrow::Array> arrow_array = tryCHColumnToArrowArrayZeroCopy(column, arrow_fields[column_i]->type());
+
+                if (!arrow_array)
+                {
+                    arrow::MemoryPool * pool = ArrowMemoryPool::instance();
+                    std::unique_ptr<arrow::ArrayBuilder> array_builder;
+                    arrow::Status status = MakeBuilder(pool, arrow_fields[column_i]->type(), &array_builder);
+                    checkStatus(status, column->getName(), format_name);
+
+                    fillArrowArray(
+                        header_column.name,
+                        column,
+                        header_column.type,
+                        nullptr,
+                        array_builder.get(),
+                        format_name,
+                        0,
+                        column->size(),
+                        settings,
+                        dictionary_values);
+
+                    status = array_builder->Finish(&arrow_array);
+                    checkStatus(status, column->getName(), format_name);
+                }
 
                 table_data.at(column_i).emplace_back(std::move(arrow_array));
             }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/Block.h>
+#include <Common/PODArray.h>
 #include <IO/WriteBuffer.h>
 #include <Processors/Formats/OutputFormatWithUTF8ValidationAdaptor.h>
 #include <Processors/Formats/RowOutputFormatWithExceptionHandlerAdaptor.h>
@@ -28,6 +29,10 @@ public:
 private:
     void writePrefix() override;
 
+    /// Serializes whole columns into reusable buffers and then interleaves the row fragments,
+    /// which is much faster than the row-by-row path for wide chunks.
+    void consume(Chunk chunk) override;
+
     void writeTotals(const Columns & columns, size_t row_num) override;
 
     void writeField(const IColumn & column, const ISerialization & serialization, size_t row_num) override;
@@ -48,6 +53,15 @@ private:
     bool with_types;
     bool yield_strings;
 
+    /// Per-column serialization results of the current chunk. The arrays keep their
+    /// capacity between chunks, so the steady state does not allocate.
+    struct ColumnBuffer
+    {
+        PODArray<char> data;
+        PODArray<UInt64> offsets;   /// End position of each value in data.
+    };
+    std::vector<ColumnBuffer> column_buffers;
+
     WriteBuffer * ostr;
 };
 }
@@ -13,6 +13,13 @@
 #    include "ArrowFieldIndexUtil.h"
 #    include "NativeORCBlockInputFormat.h"
 
+namespace CurrentMetrics
+{
+    extern const Metric ORCDecoderThreads;
+    extern const Metric ORCDecoderThreadsActive;
+    extern const Metric ORCDecoderThreadsScheduled;
+}
+
 namespace DB
 {
 
@@ -27,6 +34,33 @@ ORCBlockInputFormat::ORCBlockInputFormat(ReadBuffer & in_, Block header_, const
 {
 }
 
+ORCBlockInputFormat::~ORCBlockInputFormat()
+{
+    waitForPrefetch();
+}
+
+void ORCBlockInputFormat::prefetchNextStripe()
+{
+    if (!decode_pool)
+        return;
+
+    int next_stripe = stripe_current;
+    while (next_stripe < stripe_total && skip_stripes.contains(next_stripe))
+        ++next_stripe;
+    if (next_stripe >= stripe_total)
+        return;
+
+    prefetched_batch = decode_runner([this, next_stripe] { return file_reader->ReadStripe(next_stripe, include_indices); }, Priority{});
+    prefetched_stripe = next_stripe;
+}
+
+void ORCBlockInputFormat::waitForPrefetch()
+{
+    if (prefetched_batch.valid())
+        prefetched_batch.wait();
+    prefetched_stripe = -1;
+}
+
 Chunk ORCBlockInputFormat::read()
 {
     block_missing_values.clear();
@@ -46,7 +80,19 @@ Chunk ORCBlockInputFormat::read()
     if (need_only_count)
         return getChunkForCount(file_reader->GetRawORCReader()->getStripe(stripe_current++)->getNumberOfRows());
 
-    auto batch_result = file_reader->ReadStripe(stripe_current, include_indices);
+    arrow::Result<std::shared_ptr<arrow::RecordBatch>> batch_result;
+    if (prefetched_stripe == stripe_current)
+    {
+        batch_result = prefetched_batch.get();
+        prefetched_stripe = -1;
+    }
+    else
+    {
+        /// The file reader is not thread-safe, so make sure no background task touches it.
+        waitForPrefetch();
+        batch_result = file_reader->ReadStripe(stripe_current, include_indices);
+    }
+
     if (!batch_result.ok())
         throw Exception(ErrorCodes::CANNOT_READ_ALL_DATA, "Failed to create batch reader: {}", batch_result.status().ToString());
 
@@ -71,6 +117,9 @@ Chunk ORCBlockInputFormat::read()
     approx_bytes_read_for_chunk = file_reader->GetRawORCReader()->getStripe(stripe_current)->getDataLength();
     ++stripe_current;
 
+    /// Start decoding the next stripe while the current batch is converted below and consumed by the query.
+    prefetchNextStripe();
+
     /// If defaults_for_omitted_fields is true, calculate the default values from default expression for omitted fields.
     /// Otherwise fill the missing columns with zero values of its type.
     BlockMissingValues * block_missing_values_ptr = format_settings.defaults_for_omitted_fields ? &block_missing_values : nullptr;
@@ -81,6 +130,7 @@ void ORCBlockInputFormat::resetParser()
 {
     IInputFormat::resetParser();
 
+    waitForPrefetch();
     file_reader.reset();
     include_indices.clear();
     block_missing_values.clear();
@@ -140,6 +190,16 @@ void ORCBlockInputFormat::prepareReader()
         if (getPort().getHeader().has(name, ignore_case) || nested_table_names.contains(ignore_case ? boost::to_lower_copy(name) : name))
             include_indices.push_back(i);
     }
+
+    if (format_settings.orc.decode_stripe_ahead && stripe_total > 1 && !need_only_count)
+    {
+        decode_pool = std::make_unique<ThreadPool>(
+            CurrentMetrics::ORCDecoderThreads,
+            CurrentMetrics::ORCDecoderThreadsActive,
+            CurrentMetrics::ORCDecoderThreadsScheduled,
+            /* max_threads */ 1);
+        decode_runner = threadPoolCallbackRunnerUnsafe<arrow::Result<std::shared_ptr<arrow::RecordBatch>>>(*decode_pool, "ORCDecoder");
+    }
 }
 
 ORCSchemaReader::ORCSchemaReader(ReadBuffer & in_, const FormatSettings & format_settings_)
@@ -5,6 +5,7 @@
 #include <Processors/Formats/IInputFormat.h>
 #include <Processors/Formats/ISchemaReader.h>
 #include <Formats/FormatSettings.h>
+#include <Common/threadPoolCallbackRunner.h>
 
 #include <arrow/adapters/orc/adapter.h>
 
@@ -23,6 +24,8 @@ class ORCBlockInputFormat : public IInputFormat
 public:
     ORCBlockInputFormat(ReadBuffer & in_, Block header_, const FormatSettings & format_settings_);
 
+    ~ORCBlockInputFormat() override;
+
     String getName() const override { return "ORCBlockInputFormat"; }
 
     void resetParser() override;
@@ -42,6 +45,11 @@ protected:
 private:
     void prepareReader();
 
+    /// Schedule decoding of the next non-skipped stripe in the background thread.
+    void prefetchNextStripe();
+    /// Wait for the in-flight background decoding, if any, and discard its result.
+    void waitForPrefetch();
+
     // TODO: check that this class implements every part of its parent
 
     std::unique_ptr<arrow::adapters::orc::ORCFileReader> file_reader;
@@ -60,6 +68,13 @@ private:
     int stripe_total = 0;
     int stripe_current = 0;
 
+    /// Decodes the stripe following the one being consumed, so that IO and decompression
+    /// overlap with conversion to ClickHouse columns. At most one task is in flight.
+    std::unique_ptr<ThreadPool> decode_pool;
+    ThreadPoolCallbackRunnerUnsafe<arrow::Result<std::shared_ptr<arrow::RecordBatch>>> decode_runner;
+    std::future<arrow::Result<std::shared_ptr<arrow::RecordBatch>>> prefetched_batch;
+    int prefetched_stripe = -1;
+
     std::atomic<int> is_stopped{0};
 };
 
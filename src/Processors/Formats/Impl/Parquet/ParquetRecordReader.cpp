@@ -1,6 +1,7 @@
 #include "ParquetRecordReader.h"
 
 #include <bit>
+#include <cstring>
 
 #include <Columns/ColumnDecimal.h>
 #include <Columns/ColumnString.h>
@@ -17,6 +18,7 @@
 
 #include <arrow/status.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/column_page.h>
 #include <parquet/column_reader.h>
 #include <parquet/properties.h>
 
@@ -296,6 +298,105 @@ std::unique_ptr<ParquetColumnReader> ColReaderFactory::makeReader()
     return throwUnsupported();
 }
 
+/// Decodes a plain-encoded dictionary page into Fields comparable by KeyCondition, mirroring
+/// the Field kinds that the row group statistics are converted to for the row group filter.
+/// Returns false for physical types that are not pruned by.
+bool decodeDictionaryValues(
+    const parquet::ColumnDescriptor & col_descriptor,
+    const parquet::DictionaryPage & dict_page,
+    std::vector<Field> & values)
+{
+    if (dict_page.encoding() != parquet::Encoding::PLAIN
+        && dict_page.encoding() != parquet::Encoding::PLAIN_DICTIONARY)
+        return false;
+
+    const auto * data = reinterpret_cast<const char *>(dict_page.data());
+    const size_t size = static_cast<size_t>(dict_page.size());
+    const size_t num_values = static_cast<size_t>(dict_page.num_values());
+    values.reserve(num_values);
+
+    bool is_unsigned = false;
+    if (col_descriptor.logical_type()->is_int())
+        is_unsigned = !dynamic_cast<const parquet::IntLogicalType &>(*col_descriptor.logical_type()).is_signed();
+
+    switch (col_descriptor.physical_type())
+    {
+        case parquet::Type::INT32:
+        {
+            if (size < num_values * sizeof(Int32))
+                return false;
+            for (size_t i = 0; i < num_values; ++i)
+            {
+                Int32 value;
+                memcpy(&value, data + i * sizeof(Int32), sizeof(Int32));
+                if (is_unsigned)
+                    values.emplace_back(static_cast<UInt64>(static_cast<UInt32>(value)));
+                else
+                    values.emplace_back(static_cast<Int64>(value));
+            }
+            return true;
+        }
+        case parquet::Type::INT64:
+        {
+            if (size < num_values * sizeof(Int64))
+                return false;
+            for (size_t i = 0; i < num_values; ++i)
+            {
+                Int64 value;
+                memcpy(&value, data + i * sizeof(Int64), sizeof(Int64));
+                if (is_unsigned)
+                    values.emplace_back(static_cast<UInt64>(value));
+                else
+                    values.emplace_back(value);
+            }
+            return true;
+        }
+        case parquet::Type::FLOAT:
+        {
+            if (size < num_values * sizeof(Float32))
+                return false;
+            for (size_t i = 0; i < num_values; ++i)
+            {
+                Float32 value;
+                memcpy(&value, data + i * sizeof(Float32), sizeof(Float32));
+                values.emplace_back(static_cast<Float64>(value));
+            }
+            return true;
+        }
+        case parquet::Type::DOUBLE:
+        {
+            if (size < num_values * sizeof(Float64))
+                return false;
+            for (size_t i = 0; i < num_values; ++i)
+            {
+                Float64 value;
+                memcpy(&value, data + i * sizeof(Float64), sizeof(Float64));
+                values.emplace_back(value);
+            }
+            return true;
+        }
+        case parquet::Type::BYTE_ARRAY:
+        {
+            size_t pos = 0;
+            for (size_t i = 0; i < num_values; ++i)
+            {
+                UInt32 length;
+                if (pos + sizeof(UInt32) > size)
+                    return false;
+                memcpy(&length, data + pos, sizeof(UInt32));
+                pos += sizeof(UInt32);
+                if (pos + length > size)
+                    return false;
+                values.emplace_back(String(data + pos, length));
+                pos += length;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
 } // anonymous namespace
 
 ParquetRecordReader::ParquetRecordReader(
@@ -305,13 +406,15 @@ ParquetRecordReader::ParquetRecordReader(
     std::shared_ptr<::arrow::io::RandomAccessFile> arrow_file,
     const FormatSettings & format_settings,
     std::vector<int> row_groups_indices_,
-    std::shared_ptr<parquet::FileMetaData> metadata)
+    std::shared_ptr<parquet::FileMetaData> metadata,
+    std::shared_ptr<const KeyCondition> key_condition_)
     : file_reader(createFileReader(std::move(arrow_file), reader_properties_, std::move(metadata)))
     , arrow_properties(arrow_properties_)
     , header(std::move(header_))
     , max_block_size(format_settings.parquet.max_block_size)
     , row_groups_indices(std::move(row_groups_indices_))
     , left_rows(getTotalRows(*file_reader->metadata()))
+    , key_condition(std::move(key_condition_))
 {
     log = &Poco::Logger::get("ParquetRecordReader");
 
@@ -348,12 +451,14 @@ ParquetRecordReader::ParquetRecordReader(
 
 Chunk ParquetRecordReader::readChunk()
 {
-    if (!left_rows)
-    {
-        return Chunk{};
-    }
-    if (!cur_row_group_left_rows)
+    /// Row groups whose dictionaries contradict the key condition are skipped here without
+    /// decoding, so several iterations may be needed to reach one with data to read.
+    while (!cur_row_group_left_rows)
     {
+        if (!left_rows)
+        {
+            return Chunk{};
+        }
         loadNextRowGroup();
     }
 
@@ -376,6 +481,14 @@ void ParquetRecordReader::loadNextRowGroup()
     Stopwatch watch(CLOCK_MONOTONIC);
     cur_row_group_reader = file_reader->RowGroup(row_groups_indices[next_row_group_idx]);
 
+    if (key_condition && canSkipRowGroupByDictionaries())
+    {
+        LOG_DEBUG(log, "skipped row group {} by dictionary values", row_groups_indices[next_row_group_idx]);
+        left_rows -= cur_row_group_reader->metadata()->num_rows();
+        ++next_row_group_idx;
+        return;
+    }
+
     column_readers.clear();
     for (size_t i = 0; i < parquet_col_indice.size(); i++)
     {
@@ -395,6 +508,76 @@ void ParquetRecordReader::loadNextRowGroup()
     cur_row_group_left_rows = cur_row_group_reader->metadata()->num_rows();
 }
 
+bool ParquetRecordReader::canSkipRowGroupByDictionaries() const
+{
+    /// Bound the work done per column: huge dictionaries are unlikely to prove anything anyway.
+    static constexpr size_t max_dictionary_values_to_check = 8192;
+
+    for (size_t i = 0; i < parquet_col_indice.size(); ++i)
+    {
+        auto meta = cur_row_group_reader->metadata()->ColumnChunk(parquet_col_indice[i]);
+        if (!meta->has_dictionary_page())
+            continue;
+
+        const auto & col_descriptor = *file_reader->metadata()->schema()->Column(parquet_col_indice[i]);
+
+        /// The dictionary does not describe NULL rows, so it is exhaustive only for non-nullable
+        /// flat columns whose every data page actually uses dictionary encoding.
+        if (col_descriptor.max_definition_level() != 0 || col_descriptor.max_repetition_level() != 0)
+            continue;
+
+        const auto & encoding_stats = meta->encoding_stats();
+        if (encoding_stats.empty())
+            continue;
+
+        bool all_data_pages_use_dictionary = true;
+        for (const auto & stat : encoding_stats)
+        {
+            if ((stat.page_type == parquet::PageType::DATA_PAGE || stat.page_type == parquet::PageType::DATA_PAGE_V2)
+                && stat.encoding != parquet::Encoding::PLAIN_DICTIONARY
+                && stat.encoding != parquet::Encoding::RLE_DICTIONARY)
+            {
+                all_data_pages_use_dictionary = false;
+                break;
+            }
+        }
+        if (!all_data_pages_use_dictionary)
+            continue;
+
+        auto page_reader = cur_row_group_reader->GetColumnPageReader(parquet_col_indice[i]);
+        auto page = page_reader->NextPage();
+        if (!page || page->type() != parquet::PageType::DICTIONARY_PAGE)
+            continue;
+
+        const auto & dict_page = static_cast<const parquet::DictionaryPage &>(*page);
+        if (static_cast<size_t>(dict_page.num_values()) > max_dictionary_values_to_check)
+            continue;
+
+        std::vector<Field> dictionary_values;
+        if (!decodeDictionaryValues(col_descriptor, dict_page, dictionary_values) || dictionary_values.empty())
+            continue;
+
+        /// The row group can be skipped if the condition is false for every value the column takes,
+        /// with all other columns unconstrained.
+        Hyperrectangle hyperrectangle(header.columns(), Range::createWholeUniverse());
+        bool may_be_true = false;
+        for (const auto & value : dictionary_values)
+        {
+            hyperrectangle[i] = Range(value);
+            if (key_condition->checkInHyperrectangle(hyperrectangle, header.getDataTypes()).can_be_true)
+            {
+                may_be_true = true;
+                break;
+            }
+        }
+
+        if (!may_be_true)
+            return true;
+    }
+
+    return false;
+}
+
 Int64 ParquetRecordReader::getTotalRows(const parquet::FileMetaData & meta_data)
 {
     Int64 res = 0;
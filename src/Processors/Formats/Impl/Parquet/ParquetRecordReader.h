@@ -4,6 +4,7 @@
 #include <Formats/FormatSettings.h>
 #include <Processors/Chunk.h>
 #include <Processors/Formats/Impl/Parquet/ParquetColumnReader.h>
+#include <Storages/MergeTree/KeyCondition.h>
 
 #include <arrow/io/interfaces.h>
 #include <parquet/file_reader.h>
@@ -24,7 +25,8 @@ public:
         std::shared_ptr<::arrow::io::RandomAccessFile> arrow_file,
         const FormatSettings & format_settings,
         std::vector<int> row_groups_indices_,
-        std::shared_ptr<parquet::FileMetaData> metadata = nullptr);
+        std::shared_ptr<parquet::FileMetaData> metadata = nullptr,
+        std::shared_ptr<const KeyCondition> key_condition_ = nullptr);
 
     Chunk readChunk();
 
@@ -45,9 +47,14 @@ private:
     UInt64 cur_row_group_left_rows = 0;
     int next_row_group_idx = 0;
 
+    /// If set, row groups whose dictionaries prove the condition to be always false are skipped
+    /// without decoding any values.
+    std::shared_ptr<const KeyCondition> key_condition;
+
     Poco::Logger * log;
 
     void loadNextRowGroup();
+    bool canSkipRowGroupByDictionaries() const;
     Int64 getTotalRows(const parquet::FileMetaData & meta_data);
 };
 
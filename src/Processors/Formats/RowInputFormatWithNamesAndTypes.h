@@ -53,9 +53,10 @@ protected:
     DataTypes data_types;
     bool end_of_stream = false;
 
-private:
+    /// Protected to allow derived formats to wrap it with a fast path (see BinaryRowInputFormat).
     bool readRow(MutableColumns & columns, RowReadExtension & ext) override;
 
+private:
     size_t countRows(size_t max_block_size) override;
 
     bool parseRowAndPrintDiagnosticInfo(MutableColumns & columns, WriteBuffer & out) override;
@@ -1,9 +1,33 @@
 #include <Processors/ISimpleTransform.h>
+#include <Common/Stopwatch.h>
 
 
 namespace DB
 {
 
+namespace
+{
+
+/// Cuts the first num_rows rows of the chunk into a separate chunk, leaving the rest in place.
+Chunk cutFirstRows(Chunk & chunk, size_t num_rows)
+{
+    size_t total_rows = chunk.getNumRows();
+    auto columns = chunk.detachColumns();
+
+    Columns head;
+    head.reserve(columns.size());
+    for (auto & column : columns)
+    {
+        head.push_back(column->cut(0, num_rows));
+        column = column->cut(num_rows, total_rows - num_rows);
+    }
+
+    chunk.setColumns(std::move(columns), total_rows - num_rows);
+    return Chunk(std::move(head), num_rows);
+}
+
+}
+
 ISimpleTransform::ISimpleTransform(Block input_header_, Block output_header_, bool skip_empty_chunks_)
     : IProcessor({std::move(input_header_)}, {std::move(output_header_)})
     , input(inputs.front())
@@ -84,9 +108,34 @@ void ISimpleTransform::work()
         return;
     }
 
+    Chunk * transform_input = &input_data.chunk;
+    Chunk split_piece;
+    bool is_split = false;
+
+    if (adaptive_input_splitting && input_data.chunk && !input_data.chunk.getChunkInfo())
+    {
+        size_t num_rows = input_data.chunk.getNumRows();
+        if (transform_ns_per_row * num_rows > 2 * adaptive_split_target_ns)
+        {
+            size_t piece_rows = std::max(adaptive_split_min_rows, static_cast<size_t>(adaptive_split_target_ns / transform_ns_per_row));
+            if (piece_rows < num_rows)
+            {
+                split_piece = cutFirstRows(input_data.chunk, piece_rows);
+                transform_input = &split_piece;
+                is_split = true;
+            }
+        }
+    }
+
+    std::optional<Stopwatch> watch;
+    if (adaptive_input_splitting)
+        watch.emplace();
+
+    size_t transformed_rows = transform_input->getNumRows();
+
     try
     {
-        transform(input_data.chunk, output_data.chunk);
+        transform(*transform_input, output_data.chunk);
     }
     catch (DB::Exception &)
     {
@@ -96,7 +145,26 @@ void ISimpleTransform::work()
         return;
     }
 
-    has_input = !needInputData();
+    if (adaptive_input_splitting && transformed_rows)
+    {
+        double ns_per_row = static_cast<double>(watch->elapsed()) / transformed_rows;
+        transform_ns_per_row = transform_ns_per_row == 0.0 ? ns_per_row : 0.875 * transform_ns_per_row + 0.125 * ns_per_row;
+    }
+
+    if (is_split)
+    {
+        /// The rest of the input chunk is still to be processed.
+        has_input = true;
+    }
+    else
+    {
+        has_input = !needInputData();
+
+        /// The consumed input chunk is exhausted now; offer its buffers for reuse
+        /// instead of freeing them, new chunks of the same layout will pick them up.
+        if (!has_input && input_data.chunk)
+            ChunkRecyclePool::instance().recycle(std::move(input_data.chunk));
+    }
 
     if (!skip_empty_chunks || output_data.chunk)
         has_output = true;
@@ -27,6 +27,16 @@ protected:
     /// This allows to escape caching chunks in input port, which can lead to uneven data distribution.
     bool set_input_not_needed_after_read = true;
 
+    /// See enableAdaptiveInputSplitting().
+    bool adaptive_input_splitting = false;
+    /// Exponential moving average of the measured transform() cost, in nanoseconds per row.
+    double transform_ns_per_row = 0.0;
+
+    /// Target wall time of a single transform() call when adaptive splitting is enabled.
+    /// Chunks are split only when they are estimated to cost at least twice the target.
+    static constexpr double adaptive_split_target_ns = 5'000'000;
+    static constexpr size_t adaptive_split_min_rows = 8192;
+
     virtual void transform(Chunk & input_chunk, Chunk & output_chunk)
     {
         transform(input_chunk);
@@ -48,6 +58,13 @@ public:
     OutputPort & getOutputPort() { return output; }
 
     void setInputNotNeededAfterRead(bool value) { set_input_not_needed_after_read = value; }
+
+    /// Measure the per-row cost of transform() and feed expensive transforms with smaller
+    /// pieces of the input chunk, so that the produced data stays cache-resident for the
+    /// downstream processor instead of being sized by max_block_size alone.
+    /// Only valid for transforms which produce the same result when the input is re-chunked
+    /// (e.g. per-row expressions and filters). Chunks carrying ChunkInfo are never split.
+    void enableAdaptiveInputSplitting() { adaptive_input_splitting = true; }
 };
 
 }
@@ -185,6 +185,15 @@ void AggregatingStep::transformPipeline(QueryPipelineBuilder & pipeline, const B
     const auto src_header = pipeline.getHeader();
     auto transform_params = std::make_shared<AggregatingTransformParams>(src_header, std::move(params), final);
 
+    /// Not applied to grouping sets and in-order aggregation: the former shares the flagless
+    /// per-set params below, the latter relies on the key order of the produced stream
+    /// (and in-order aggregation is streaming already).
+    transform_params->adaptive_passthrough = settings.enable_adaptive_aggregation_passthrough
+        && !final
+        && transform_params->params.keys_size != 0
+        && grouping_sets_params.empty()
+        && sort_description_for_merging.empty();
+
     if (!grouping_sets_params.empty())
     {
         const size_t grouping_sets_size = grouping_sets_params.size();
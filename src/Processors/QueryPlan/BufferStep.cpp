@@ -0,0 +1,49 @@
+#include <Processors/QueryPlan/BufferStep.h>
+#include <Processors/Transforms/BufferChunksTransform.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <IO/Operators.h>
+#include <Common/JSONBuilder.h>
+
+namespace DB
+{
+
+static ITransformingStep::Traits getTraits()
+{
+    return ITransformingStep::Traits
+    {
+        {
+            .returns_single_stream = false,
+            .preserves_number_of_streams = true,
+            .preserves_sorting = true,
+        },
+        {
+            .preserves_number_of_rows = true,
+        }
+    };
+}
+
+BufferStep::BufferStep(const DataStream & input_stream_, size_t max_bytes_to_buffer_)
+    : ITransformingStep(input_stream_, input_stream_.header, getTraits())
+    , max_bytes_to_buffer(max_bytes_to_buffer_)
+{
+}
+
+void BufferStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &)
+{
+    pipeline.addSimpleTransform([&](const Block & header)
+    {
+        return std::make_shared<BufferChunksTransform>(header, max_bytes_to_buffer);
+    });
+}
+
+void BufferStep::describeActions(FormatSettings & settings) const
+{
+    settings.out << String(settings.offset, ' ') << "Max bytes to buffer: " << max_bytes_to_buffer << '\n';
+}
+
+void BufferStep::describeActions(JSONBuilder::JSONMap & map) const
+{
+    map.add("Max Bytes To Buffer", max_bytes_to_buffer);
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <Processors/QueryPlan/ITransformingStep.h>
+
+namespace DB
+{
+
+/// Buffers chunks up to the limit in bytes per stream while the downstream part of the
+/// pipeline is not ready to accept data. See BufferChunksTransform.
+/// It is inserted below the first consumer of a set being created by CreatingSetsStep,
+/// so that the part of the pipeline that does not need the set can run while it is built.
+class BufferStep : public ITransformingStep
+{
+public:
+    BufferStep(const DataStream & input_stream_, size_t max_bytes_to_buffer_);
+
+    String getName() const override { return "Buffer"; }
+
+    void transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &) override;
+
+    void describeActions(JSONBuilder::JSONMap & map) const override;
+    void describeActions(FormatSettings & settings) const override;
+
+private:
+    void updateOutputStream() override
+    {
+        output_stream = createOutputStream(input_streams.front(), input_streams.front().header, getDataStreamTraits());
+    }
+
+    size_t max_bytes_to_buffer;
+};
+
+}
@@ -12,6 +12,9 @@ BuildQueryPipelineSettings BuildQueryPipelineSettings::fromContext(ContextPtr fr
     settings.actions_settings = ExpressionActionsSettings::fromSettings(from->getSettingsRef(), CompileExpressions::yes);
     settings.process_list_element = from->getProcessListElement();
     settings.progress_callback = from->getProgressCallback();
+    settings.adaptive_block_splitting = from->getSettingsRef().adaptive_block_splitting;
+    settings.window_functions_sliding_aggregation = from->getSettingsRef().window_functions_sliding_aggregation;
+    settings.enable_adaptive_aggregation_passthrough = from->getSettingsRef().enable_adaptive_aggregation_passthrough;
     return settings;
 }
 
@@ -19,6 +19,18 @@ struct BuildQueryPipelineSettings
     QueryStatusPtr process_list_element;
     ProgressCallback progress_callback = nullptr;
 
+    /// Feed expensive expression and filter transforms with smaller pieces of input blocks,
+    /// based on the measured per-row cost. See ISimpleTransform::enableAdaptiveInputSplitting().
+    bool adaptive_block_splitting = false;
+
+    /// Evaluate aggregate functions over moving window frames with two stacks of partial
+    /// states instead of re-aggregating the frame for every row.
+    bool window_functions_sliding_aggregation = false;
+
+    /// Let the first stage of two-stage aggregation switch to streaming per-block aggregated
+    /// data when the observed reduction is poor. See AggregatingTransform::consume().
+    bool enable_adaptive_aggregation_passthrough = false;
+
     const ExpressionActionsSettings & getActionsSettings() const { return actions_settings; }
     static BuildQueryPipelineSettings fromContext(ContextPtr from);
 };
@@ -0,0 +1,71 @@
+#include <Processors/QueryPlan/DuplicatingStep.h>
+#include <Processors/Transforms/CopyTransform.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <IO/Operators.h>
+#include <Common/JSONBuilder.h>
+
+namespace DB
+{
+
+static ITransformingStep::Traits getTraits()
+{
+    return ITransformingStep::Traits
+    {
+        {
+            .returns_single_stream = false,
+            .preserves_number_of_streams = false,
+            /// Every copy of a stream is sorted the same way the original was,
+            /// but the copies together are not.
+            .preserves_sorting = false,
+        },
+        {
+            .preserves_number_of_rows = false,
+        }
+    };
+}
+
+DuplicatingStep::DuplicatingStep(const DataStream & input_stream_, size_t num_copies_)
+    : ITransformingStep(input_stream_, input_stream_.header, getTraits())
+    , num_copies(num_copies_)
+{
+    setStepDescription("x" + std::to_string(num_copies));
+}
+
+void DuplicatingStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &)
+{
+    if (num_copies == 1)
+        return;
+
+    auto input_header = pipeline.getHeader();
+    pipeline.transform([&](OutputPortRawPtrs ports)
+    {
+        Processors copiers;
+        copiers.reserve(ports.size());
+
+        for (auto * port : ports)
+        {
+            auto copier = std::make_shared<CopyTransform>(input_header, num_copies);
+            connect(*port, copier->getInputPort());
+            copiers.push_back(copier);
+        }
+
+        return copiers;
+    });
+}
+
+void DuplicatingStep::describeActions(FormatSettings & settings) const
+{
+    settings.out << String(settings.offset, settings.indent_char) << "Copies: " << num_copies << '\n';
+}
+
+void DuplicatingStep::describeActions(JSONBuilder::JSONMap & map) const
+{
+    map.add("Copies", num_copies);
+}
+
+void DuplicatingStep::updateOutputStream()
+{
+    output_stream = createOutputStream(input_streams.front(), input_streams.front().header, getDataStreamTraits());
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <Processors/QueryPlan/ITransformingStep.h>
+
+namespace DB
+{
+
+/// Copies every stream of the input pipeline `num_copies` times.
+/// The result is equivalent (as a multiset of rows) to uniting `num_copies` identical
+/// copies of the input. Used to execute identical UNION ALL branches only once.
+class DuplicatingStep : public ITransformingStep
+{
+public:
+    DuplicatingStep(const DataStream & input_stream_, size_t num_copies_);
+
+    String getName() const override { return "Duplicating"; }
+
+    void transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &) override;
+
+    void describeActions(FormatSettings & settings) const override;
+    void describeActions(JSONBuilder::JSONMap & map) const override;
+
+private:
+    void updateOutputStream() override;
+
+    size_t num_copies;
+};
+
+}
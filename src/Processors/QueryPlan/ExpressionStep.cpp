@@ -40,7 +40,10 @@ void ExpressionStep::transformPipeline(QueryPipelineBuilder & pipeline, const Bu
 
     pipeline.addSimpleTransform([&](const Block & header)
     {
-        return std::make_shared<ExpressionTransform>(header, expression);
+        auto transform = std::make_shared<ExpressionTransform>(header, expression);
+        if (settings.adaptive_block_splitting)
+            transform->enableAdaptiveInputSplitting();
+        return transform;
     });
 
     if (!blocksHaveEqualStructure(pipeline.getHeader(), output_stream->header))
@@ -61,7 +61,10 @@ void FilterStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQ
     pipeline.addSimpleTransform([&](const Block & header, QueryPipelineBuilder::StreamType stream_type)
     {
         bool on_totals = stream_type == QueryPipelineBuilder::StreamType::Totals;
-        return std::make_shared<FilterTransform>(header, expression, filter_column_name, remove_filter_column, on_totals);
+        auto transform = std::make_shared<FilterTransform>(header, expression, filter_column_name, remove_filter_column, on_totals);
+        if (settings.adaptive_block_splitting)
+            transform->enableAdaptiveInputSplitting();
+        return transform;
     });
 
     if (!blocksHaveEqualStructure(pipeline.getHeader(), output_stream->header))
@@ -1,4 +1,5 @@
 #pragma once
+#include <Core/SortDescription.h>
 #include <Processors/QueryPlan/QueryPlan.h>
 #include <Processors/QueryPlan/Optimizations/QueryPlanOptimizationSettings.h>
 #include <array>
@@ -16,7 +17,7 @@ void optimizeTreeFirstPass(const QueryPlanOptimizationSettings & settings, Query
 void optimizeTreeSecondPass(const QueryPlanOptimizationSettings & optimization_settings, QueryPlan::Node & root, QueryPlan::Nodes & nodes);
 /// Third pass is used to apply filters such as key conditions and skip indexes to the storages that support them.
 /// After that it add CreateSetsStep for the subqueries that has not be used in the filters.
-void optimizeTreeThirdPass(QueryPlan & plan, QueryPlan::Node & root, QueryPlan::Nodes & nodes);
+void optimizeTreeThirdPass(const QueryPlanOptimizationSettings & optimization_settings, QueryPlan & plan, QueryPlan::Node & root, QueryPlan::Nodes & nodes);
 
 /// Optimization (first pass) is a function applied to QueryPlan::Node.
 /// It can read and update subtree of specified node.
@@ -46,6 +47,10 @@ size_t trySplitFilter(QueryPlan::Node * node, QueryPlan::Nodes & nodes);
 /// Replace chain `FilterStep -> ExpressionStep` to single FilterStep
 size_t tryMergeExpressions(QueryPlan::Node * parent_node, QueryPlan::Nodes &);
 
+/// Replace chain `FilterStep -> FilterStep` to single FilterStep
+/// Note: this breaks short-circuit logic, so it is disabled for now.
+size_t tryMergeFilters(QueryPlan::Node * parent_node, QueryPlan::Nodes &);
+
 /// Move FilterStep down if possible.
 /// May split FilterStep and push down only part of it.
 size_t tryPushDownFilter(QueryPlan::Node * parent_node, QueryPlan::Nodes & nodes);
@@ -79,18 +84,27 @@ size_t tryLiftUpUnion(QueryPlan::Node * parent_node, QueryPlan::Nodes & nodes);
 
 size_t tryAggregatePartitionsIndependently(QueryPlan::Node * node, QueryPlan::Nodes &);
 
+/// Execute identical UNION ALL branches only once and duplicate the result.
+size_t tryMergeIdenticalUnionBranches(QueryPlan::Node * parent_node, QueryPlan::Nodes & nodes);
+
+/// Attach runtime filters built from the hash join build side to probe-side MergeTree scans.
+size_t tryAddJoinRuntimeFilter(QueryPlan::Node * parent_node, QueryPlan::Nodes & nodes);
+
 inline const auto & getOptimizations()
 {
-    static const std::array<Optimization, 11> optimizations = {{
+    static const std::array<Optimization, 14> optimizations = {{
         {tryLiftUpArrayJoin, "liftUpArrayJoin", &QueryPlanOptimizationSettings::lift_up_array_join},
         {tryPushDownLimit, "pushDownLimit", &QueryPlanOptimizationSettings::push_down_limit},
         {trySplitFilter, "splitFilter", &QueryPlanOptimizationSettings::split_filter},
         {tryMergeExpressions, "mergeExpressions", &QueryPlanOptimizationSettings::merge_expressions},
+        {tryMergeFilters, "mergeFilters", &QueryPlanOptimizationSettings::merge_filters},
         {tryPushDownFilter, "pushDownFilter", &QueryPlanOptimizationSettings::filter_push_down},
         {tryConvertOuterJoinToInnerJoin, "convertOuterJoinToInnerJoin", &QueryPlanOptimizationSettings::convert_outer_join_to_inner_join},
+        {tryAddJoinRuntimeFilter, "addJoinRuntimeFilter", &QueryPlanOptimizationSettings::join_runtime_filter},
         {tryExecuteFunctionsAfterSorting, "liftUpFunctions", &QueryPlanOptimizationSettings::execute_functions_after_sorting},
         {tryReuseStorageOrderingForWindowFunctions, "reuseStorageOrderingForWindowFunctions", &QueryPlanOptimizationSettings::reuse_storage_ordering_for_window_functions},
         {tryLiftUpUnion, "liftUpUnion", &QueryPlanOptimizationSettings::lift_up_union},
+        {tryMergeIdenticalUnionBranches, "mergeIdenticalUnionBranches", &QueryPlanOptimizationSettings::merge_identical_union_branches},
         {tryAggregatePartitionsIndependently, "aggregatePartitionsIndependently", &QueryPlanOptimizationSettings::aggregate_partitions_independently},
         {tryRemoveRedundantDistinct, "removeRedundantDistinct", &QueryPlanOptimizationSettings::remove_redundant_distinct},
     }};
@@ -112,12 +126,21 @@ void optimizePrewhere(Stack & stack, QueryPlan::Nodes & nodes);
 void optimizeReadInOrder(QueryPlan::Node & node, QueryPlan::Nodes & nodes);
 void optimizeAggregationInOrder(QueryPlan::Node & node, QueryPlan::Nodes &);
 
+/// Returns true if the plan subtree can provide rows sorted by the whole description
+/// by reading the underlying storage in order. Does not modify the plan. Used by the
+/// planner to step aside from optimizations that would prevent reading in order.
+bool canSubtreeBeReadInOrder(QueryPlan::Node & node, const SortDescription & description);
+
 /// Returns the name of used projection or nullopt if no projection is used.
 std::optional<String> optimizeUseAggregateProjections(QueryPlan::Node & node, QueryPlan::Nodes & nodes, bool allow_implicit_projections);
 std::optional<String> optimizeUseNormalProjections(Stack & stack, QueryPlan::Nodes & nodes);
 
 bool addPlansForSets(QueryPlan & plan, QueryPlan::Node & node, QueryPlan::Nodes & nodes);
 
+/// Insert buffers below the first consumers of sets created by CreatingSetsStep,
+/// so that the rest of the main pipeline can run while the sets are being built.
+size_t bufferProbeSideWhileCreatingSets(QueryPlan::Node & node, QueryPlan::Nodes & nodes, size_t max_bytes_to_buffer);
+
 /// Enable memory bound merging of aggregation states for remote queries
 /// in case it was enabled for local plan
 void enableMemoryBoundMerging(QueryPlan::Node & node, QueryPlan::Nodes &);
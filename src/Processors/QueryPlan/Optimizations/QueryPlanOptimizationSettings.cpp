@@ -20,10 +20,14 @@ QueryPlanOptimizationSettings QueryPlanOptimizationSettings::fromSettings(const
 
     settings.merge_expressions = from.query_plan_enable_optimizations && from.query_plan_merge_expressions;
 
+    settings.merge_filters = from.query_plan_enable_optimizations && from.query_plan_merge_filters;
+
     settings.filter_push_down = from.query_plan_enable_optimizations && from.query_plan_filter_push_down;
 
     settings.convert_outer_join_to_inner_join = from.query_plan_enable_optimizations && from.query_plan_convert_outer_join_to_inner_join;
 
+    settings.join_runtime_filter = from.query_plan_enable_optimizations && from.query_plan_join_runtime_filter;
+
     settings.optimize_prewhere = from.query_plan_enable_optimizations && from.query_plan_optimize_prewhere;
 
     settings.execute_functions_after_sorting = from.query_plan_enable_optimizations && from.query_plan_execute_functions_after_sorting;
@@ -32,6 +36,8 @@ QueryPlanOptimizationSettings QueryPlanOptimizationSettings::fromSettings(const
 
     settings.lift_up_union = from.query_plan_enable_optimizations && from.query_plan_lift_up_union;
 
+    settings.merge_identical_union_branches = from.query_plan_enable_optimizations && from.query_plan_merge_identical_union_branches;
+
     settings.distinct_in_order = from.query_plan_enable_optimizations && from.optimize_distinct_in_order;
 
     settings.read_in_order = from.query_plan_enable_optimizations && from.optimize_read_in_order && from.query_plan_read_in_order;
@@ -44,6 +50,8 @@ QueryPlanOptimizationSettings QueryPlanOptimizationSettings::fromSettings(const
 
     settings.remove_redundant_distinct = from.query_plan_enable_optimizations && from.query_plan_remove_redundant_distinct;
 
+    settings.max_bytes_to_buffer_while_creating_sets = from.max_bytes_to_buffer_while_creating_sets;
+
     settings.optimize_projection = from.optimize_use_projections;
     settings.force_use_projection = settings.optimize_projection && from.force_optimize_projection;
     settings.force_projection_name = settings.optimize_projection ? from.force_optimize_projection_name.value : "";
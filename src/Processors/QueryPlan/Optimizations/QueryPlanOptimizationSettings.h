@@ -31,12 +31,18 @@ struct QueryPlanOptimizationSettings
     /// If merge-expressions optimization is enabled.
     bool merge_expressions = true;
 
+    /// If merge-filters optimization is enabled.
+    bool merge_filters = false;
+
     /// If filter push down optimization is enabled.
     bool filter_push_down = true;
 
     /// If convert OUTER JOIN to INNER JOIN optimization is enabled.
     bool convert_outer_join_to_inner_join = true;
 
+    /// If pruning of probe-side mark ranges with hash join build-side extremes is enabled.
+    bool join_runtime_filter = false;
+
     /// If reorder-functions-after-sorting optimization is enabled.
     bool execute_functions_after_sorting = true;
 
@@ -46,6 +52,9 @@ struct QueryPlanOptimizationSettings
     /// If lifting-unions-up optimization is enabled.
     bool lift_up_union = true;
 
+    /// If merging of identical UNION ALL branches is enabled.
+    bool merge_identical_union_branches = false;
+
     /// if distinct in order optimization is enabled
     bool distinct_in_order = false;
 
@@ -64,6 +73,10 @@ struct QueryPlanOptimizationSettings
     /// If remove-redundant-distinct-steps optimization is enabled.
     bool remove_redundant_distinct = true;
 
+    /// If non-zero, buffer up to this many bytes per stream below the first consumers
+    /// of sets created by CreatingSetsStep, to overlap set creation with the main pipeline.
+    size_t max_bytes_to_buffer_while_creating_sets = 0;
+
     bool optimize_prewhere = true;
 
     /// If reading from projection can be applied
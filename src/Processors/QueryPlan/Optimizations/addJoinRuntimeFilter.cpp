@@ -0,0 +1,122 @@
+#include <Processors/QueryPlan/Optimizations/Optimizations.h>
+#include <Processors/QueryPlan/ExpressionStep.h>
+#include <Processors/QueryPlan/FilterStep.h>
+#include <Processors/QueryPlan/JoinStep.h>
+#include <Processors/QueryPlan/ReadFromMergeTree.h>
+#include <Interpreters/ConcurrentHashJoin.h>
+#include <Interpreters/HashJoin.h>
+#include <Interpreters/TableJoin.h>
+#include <DataTypes/IDataType.h>
+
+namespace DB::QueryPlanOptimizations
+{
+
+namespace
+{
+
+bool isSupportedKeyType(const DataTypePtr & type)
+{
+    WhichDataType which(type);
+    /// Floats are excluded: in a hash join NaN is equal to NaN, but column extremes ignore NaNs.
+    /// Nullable and LowCardinality keys are excluded as well, they do not pass this whitelist.
+    return which.isNativeInt() || which.isNativeUInt()
+        || which.isDate() || which.isDate32() || which.isDateTime() || which.isDateTime64()
+        || which.isEnum() || which.isDecimal();
+}
+
+/// Find the MergeTree scan below `node` to which the column `name` is passed through unchanged.
+/// Only Expression and Filter steps are traversed: they commute with pruning of rows which
+/// cannot match the join, while e.g. Limit or Sorting below the join do not.
+ReadFromMergeTree * traceColumnToMergeTreeScan(QueryPlan::Node * node, const String & name)
+{
+    while (true)
+    {
+        if (auto * read = typeid_cast<ReadFromMergeTree *>(node->step.get()))
+            return read;
+
+        if (node->children.size() != 1)
+            return nullptr;
+
+        ActionsDAGPtr dag;
+        if (auto * expression = typeid_cast<ExpressionStep *>(node->step.get()))
+            dag = expression->getExpression();
+        else if (auto * filter = typeid_cast<FilterStep *>(node->step.get()))
+            dag = filter->getExpression();
+        else
+            return nullptr;
+
+        const auto * output = dag->tryFindInOutputs(name);
+        if (!output || output->type != ActionsDAG::ActionType::INPUT)
+            return nullptr;
+
+        node = node->children.front();
+    }
+}
+
+}
+
+size_t tryAddJoinRuntimeFilter(QueryPlan::Node * parent_node, QueryPlan::Nodes &)
+{
+    auto * join_step = typeid_cast<JoinStep *>(parent_node->step.get());
+    if (!join_step || parent_node->children.size() != 2)
+        return 0;
+
+    const auto & join = join_step->getJoin();
+    if (join->hasRuntimeFilters())
+        return 0;
+
+    /// Only the hash join family fills runtime filters during the build phase.
+    if (!typeid_cast<HashJoin *>(join.get()) && !typeid_cast<ConcurrentHashJoin *>(join.get()))
+        return 0;
+
+    const auto & table_join = join->getTableJoin();
+
+    /// Left rows without a match must not reach the result, otherwise they cannot be pruned.
+    if (table_join.kind() != JoinKind::Inner && table_join.kind() != JoinKind::Right)
+        return 0;
+
+    if (table_join.getClauses().size() != 1)
+        return 0;
+
+    const auto & clause = table_join.getClauses().front();
+
+    /// The last ASOF key is matched by inequality.
+    size_t num_equi_keys = clause.key_names_left.size();
+    if (table_join.strictness() == JoinStrictness::Asof && num_equi_keys > 0)
+        --num_equi_keys;
+
+    const auto & right_header = join_step->getInputStreams()[1].header;
+
+    size_t num_filters = 0;
+    for (size_t i = 0; i < num_equi_keys; ++i)
+    {
+        const auto & left_name = clause.key_names_left[i];
+        const auto & right_name = clause.key_names_right[i];
+
+        auto * read = traceColumnToMergeTreeScan(parent_node->children.front(), left_name);
+        if (!read)
+            continue;
+
+        const auto * left_column = read->getOutputStream().header.findByName(left_name);
+        const auto * right_column = right_header.findByName(right_name);
+        if (!left_column || !right_column)
+            continue;
+
+        if (!isSupportedKeyType(left_column->type) || !isSupportedKeyType(right_column->type))
+            continue;
+
+        /// Only primary key columns allow to prune mark ranges.
+        const auto primary_key_columns = read->getStorageMetadata()->getPrimaryKeyColumns();
+        if (std::find(primary_key_columns.begin(), primary_key_columns.end(), left_name) == primary_key_columns.end())
+            continue;
+
+        auto filter = std::make_shared<JoinRuntimeFilter>(left_name, left_column->type, right_name, right_column->type);
+        join->addRuntimeFilter(filter);
+        read->addJoinRuntimeFilter(std::move(filter));
+        ++num_filters;
+    }
+
+    return num_filters ? 1 : 0;
+}
+
+}
@@ -0,0 +1,129 @@
+#include <Columns/ColumnSet.h>
+#include <Interpreters/ActionsDAG.h>
+#include <Processors/QueryPlan/BufferStep.h>
+#include <Processors/QueryPlan/CreatingSetsStep.h>
+#include <Processors/QueryPlan/ExpressionStep.h>
+#include <Processors/QueryPlan/FilterStep.h>
+#include <Processors/QueryPlan/Optimizations/Optimizations.h>
+#include <Processors/QueryPlan/ReadFromMergeTree.h>
+#include <Storages/SelectQueryInfo.h>
+#include <Common/typeid_cast.h>
+
+namespace DB::QueryPlanOptimizations
+{
+
+namespace
+{
+
+bool usesUnbuiltSet(const ActionsDAGPtr & dag)
+{
+    if (!dag)
+        return false;
+
+    for (const auto & node : dag->getNodes())
+    {
+        if (node.type != ActionsDAG::ActionType::COLUMN)
+            continue;
+
+        const auto * column_set = typeid_cast<const ColumnSet *>(node.column.get());
+        if (!column_set)
+            continue;
+
+        auto future_set = column_set->getData();
+        if (future_set && !future_set->get())
+            return true;
+    }
+
+    return false;
+}
+
+/// Whether the step itself is guaranteed not to read any of the sets that are being
+/// created. Per-row execution of `IN` with a not-ready set throws, so unknown step
+/// types are conservatively treated as potential set consumers.
+bool stepIsSetFree(const IQueryPlanStep * step)
+{
+    if (const auto * expression = typeid_cast<const ExpressionStep *>(step))
+        return !usesUnbuiltSet(expression->getExpression());
+
+    if (const auto * filter = typeid_cast<const FilterStep *>(step))
+        return !usesUnbuiltSet(filter->getExpression());
+
+    if (const auto * read = typeid_cast<const ReadFromMergeTree *>(step))
+    {
+        const auto & prewhere_info = read->getPrewhereInfo();
+        return !prewhere_info
+            || (!usesUnbuiltSet(prewhere_info->row_level_filter) && !usesUnbuiltSet(prewhere_info->prewhere_actions));
+    }
+
+    return false;
+}
+
+bool subtreeIsSetFree(const QueryPlan::Node * node)
+{
+    if (!stepIsSetFree(node->step.get()))
+        return false;
+
+    for (const auto * child : node->children)
+        if (!subtreeIsSetFree(child))
+            return false;
+
+    return true;
+}
+
+void insertBufferAbove(QueryPlan::Node *& child, QueryPlan::Nodes & nodes, size_t max_bytes)
+{
+    auto buffer_step = std::make_unique<BufferStep>(child->step->getOutputStream(), max_bytes);
+    buffer_step->setStepDescription("Buffer while sets are created");
+
+    auto & buffer_node = nodes.emplace_back(QueryPlan::Node{std::move(buffer_step), {child}});
+    child = &buffer_node;
+}
+
+/// Insert buffers on every edge from the set-consuming part of the subtree to a
+/// set-free part below it, i.e. as high as possible but below every consumer.
+size_t insertBuffersBelowSetConsumers(QueryPlan::Node * node, QueryPlan::Nodes & nodes, size_t max_bytes)
+{
+    size_t num_inserted = 0;
+    for (auto & child : node->children)
+    {
+        if (subtreeIsSetFree(child))
+        {
+            insertBufferAbove(child, nodes, max_bytes);
+            ++num_inserted;
+        }
+        else
+            num_inserted += insertBuffersBelowSetConsumers(child, nodes, max_bytes);
+    }
+
+    return num_inserted;
+}
+
+}
+
+size_t bufferProbeSideWhileCreatingSets(QueryPlan::Node & node, QueryPlan::Nodes & nodes, size_t max_bytes_to_buffer)
+{
+    if (!max_bytes_to_buffer)
+        return 0;
+
+    const auto * creating_sets = typeid_cast<const CreatingSetsStep *>(node.step.get());
+    if (!creating_sets || node.children.size() < 2)
+        return 0;
+
+    /// The main output ports are delayed until every set is built (see
+    /// QueryPipelineBuilder::addPipelineBefore), so without buffering no processor of the
+    /// main pipeline can run before that. A buffer lets the part of the pipeline below the
+    /// first consumer of a set (typically the scan) run concurrently with set creation.
+    auto & main_node = node.children.front();
+
+    if (subtreeIsSetFree(main_node))
+    {
+        /// The sets are only used at query analysis time (e.g. by the primary key
+        /// condition), the whole main pipeline may run ahead.
+        insertBufferAbove(main_node, nodes, max_bytes_to_buffer);
+        return 1;
+    }
+
+    return insertBuffersBelowSetConsumers(main_node, nodes, max_bytes_to_buffer);
+}
+
+}
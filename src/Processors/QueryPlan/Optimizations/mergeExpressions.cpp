@@ -2,10 +2,25 @@
 #include <Processors/QueryPlan/FilterStep.h>
 #include <Processors/QueryPlan/ExpressionStep.h>
 #include <Interpreters/ActionsDAG.h>
+#include <Functions/FunctionsLogical.h>
+#include <Functions/IFunctionAdaptors.h>
 
 namespace DB::QueryPlanOptimizations
 {
 
+static void removeFromOutputs(ActionsDAG & dag, const ActionsDAG::Node & node)
+{
+    auto & outputs = dag.getOutputs();
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        if (&node == outputs[i])
+        {
+            outputs.erase(outputs.begin() + i);
+            return;
+        }
+    }
+}
+
 size_t tryMergeExpressions(QueryPlan::Node * parent_node, QueryPlan::Nodes &)
 {
     if (parent_node->children.size() != 1)
@@ -64,4 +79,57 @@ size_t tryMergeExpressions(QueryPlan::Node * parent_node, QueryPlan::Nodes &)
     return 0;
 }
 
+size_t tryMergeFilters(QueryPlan::Node * parent_node, QueryPlan::Nodes &)
+{
+    if (parent_node->children.size() != 1)
+        return 0;
+
+    QueryPlan::Node * child_node = parent_node->children.front();
+
+    auto & parent = parent_node->step;
+    auto & child = child_node->step;
+
+    auto * parent_filter = typeid_cast<FilterStep *>(parent.get());
+    auto * child_filter = typeid_cast<FilterStep *>(child.get());
+
+    if (parent_filter && child_filter)
+    {
+        const auto & child_actions = child_filter->getExpression();
+        const auto & parent_actions = parent_filter->getExpression();
+
+        if (child_actions->hasArrayJoin())
+            return 0;
+
+        auto actions = child_actions->clone();
+        const auto & child_filter_node = actions->findInOutputs(child_filter->getFilterColumnName());
+        if (child_filter->removesFilterColumn())
+            removeFromOutputs(*actions, child_filter_node);
+
+        actions->mergeInplace(std::move(*parent_actions->clone()));
+
+        const auto & parent_filter_node = actions->findInOutputs(parent_filter->getFilterColumnName());
+        if (parent_filter->removesFilterColumn())
+            removeFromOutputs(*actions, parent_filter_node);
+
+        FunctionOverloadResolverPtr func_builder_and = std::make_unique<FunctionToOverloadResolverAdaptor>(std::make_shared<FunctionAnd>());
+        const auto & condition = actions->addFunction(func_builder_and, {&child_filter_node, &parent_filter_node}, {});
+        auto & outputs = actions->getOutputs();
+        outputs.insert(outputs.begin(), &condition);
+
+        actions->removeUnusedActions(false);
+
+        auto filter = std::make_unique<FilterStep>(child_filter->getInputStreams().front(),
+                                                   actions,
+                                                   condition.result_name,
+                                                   true);
+        filter->setStepDescription("(" + parent_filter->getStepDescription() + " + " + child_filter->getStepDescription() + ")");
+
+        parent_node->step = std::move(filter);
+        parent_node->children.swap(child_node->children);
+        return 1;
+    }
+
+    return 0;
+}
+
 }
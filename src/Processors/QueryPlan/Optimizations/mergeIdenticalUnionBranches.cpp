@@ -0,0 +1,134 @@
+#include <Processors/QueryPlan/Optimizations/Optimizations.h>
+#include <Processors/QueryPlan/AggregatingStep.h>
+#include <Processors/QueryPlan/DistinctStep.h>
+#include <Processors/QueryPlan/DuplicatingStep.h>
+#include <Processors/QueryPlan/ExpressionStep.h>
+#include <Processors/QueryPlan/FilterStep.h>
+#include <Processors/QueryPlan/LimitStep.h>
+#include <Processors/QueryPlan/ReadFromMergeTree.h>
+#include <Processors/QueryPlan/SortingStep.h>
+#include <Processors/QueryPlan/UnionStep.h>
+#include <Parsers/queryToString.h>
+#include <IO/Operators.h>
+#include <IO/WriteBufferFromString.h>
+
+namespace DB::QueryPlanOptimizations
+{
+
+namespace
+{
+
+/// Steps whose textual representation is detailed enough to serve as their identity.
+/// Steps with partially printed state (e.g. reads from external storages or remote
+/// shards) must not be fingerprinted: two semantically different subtrees could
+/// produce the same text, and a false match changes query results.
+bool isFingerprintableStep(const IQueryPlanStep & step)
+{
+    return typeid_cast<const ExpressionStep *>(&step)
+        || typeid_cast<const FilterStep *>(&step)
+        || typeid_cast<const AggregatingStep *>(&step)
+        || typeid_cast<const DistinctStep *>(&step)
+        || typeid_cast<const LimitStep *>(&step)
+        || typeid_cast<const SortingStep *>(&step)
+        || typeid_cast<const UnionStep *>(&step)
+        || typeid_cast<const ReadFromMergeTree *>(&step);
+}
+
+/// Writes an identity of the subtree into `out`.
+/// Returns false if the subtree contains a step which cannot be fingerprinted.
+bool writeSubtreeFingerprint(const QueryPlan::Node & node, WriteBuffer & out)
+{
+    if (!isFingerprintableStep(*node.step))
+        return false;
+
+    out << node.step->getName() << '\n'
+        << node.step->getStepDescription() << '\n'
+        << node.step->getOutputStream().header.dumpStructure() << '\n';
+
+    if (const auto * read = typeid_cast<const ReadFromMergeTree *>(node.step.get()))
+    {
+        /// Do not use describeActions() here: it triggers index analysis, which is
+        /// premature during the first optimization pass. The query AST of the branch
+        /// fully covers the parts of the read that the plan above may not (FINAL,
+        /// SAMPLE, PREWHERE), at the cost of being over-strict.
+        const auto & query = read->getQueryInfo().query;
+        if (!query)
+            return false;
+        out << queryToString(query) << '\n';
+    }
+    else
+    {
+        IQueryPlanStep::FormatSettings settings{.out = out};
+        node.step->describeActions(settings);
+    }
+
+    out << "children: " << node.children.size() << '\n';
+
+    for (const auto * child : node.children)
+        if (!writeSubtreeFingerprint(*child, out))
+            return false;
+
+    return true;
+}
+
+}
+
+size_t tryMergeIdenticalUnionBranches(QueryPlan::Node * parent_node, QueryPlan::Nodes & nodes)
+{
+    auto * union_step = typeid_cast<UnionStep *>(parent_node->step.get());
+    if (!union_step || parent_node->children.size() < 2)
+        return 0;
+
+    std::unordered_map<String, size_t> branch_by_fingerprint;
+    std::vector<QueryPlan::Node *> merged_children;
+    std::vector<size_t> num_copies;
+
+    for (auto * child : parent_node->children)
+    {
+        WriteBufferFromOwnString buf;
+        if (writeSubtreeFingerprint(*child, buf))
+        {
+            auto [it, inserted] = branch_by_fingerprint.emplace(buf.str(), merged_children.size());
+            if (!inserted)
+            {
+                ++num_copies[it->second];
+                continue;
+            }
+        }
+
+        merged_children.push_back(child);
+        num_copies.push_back(1);
+    }
+
+    if (merged_children.size() == parent_node->children.size())
+        return 0;
+
+    DataStreams input_streams;
+    input_streams.reserve(merged_children.size());
+
+    for (size_t i = 0; i < merged_children.size(); ++i)
+    {
+        if (num_copies[i] > 1)
+        {
+            auto & duplicating_node = nodes.emplace_back();
+            duplicating_node.children.push_back(merged_children[i]);
+            duplicating_node.step = std::make_unique<DuplicatingStep>(
+                merged_children[i]->step->getOutputStream(), num_copies[i]);
+
+            merged_children[i] = &duplicating_node;
+        }
+
+        input_streams.push_back(merged_children[i]->step->getOutputStream());
+    }
+
+    const size_t max_threads = union_step->getMaxThreads();
+    auto step_description = union_step->getStepDescription();
+
+    parent_node->step = std::make_unique<UnionStep>(std::move(input_streams), max_threads);
+    parent_node->step->setStepDescription(std::move(step_description));
+    parent_node->children = std::move(merged_children);
+
+    return 2;
+}
+
+}
@@ -902,6 +902,38 @@ AggregationInputOrder buildInputOrderInfo(AggregatingStep & aggregating, QueryPl
     return {};
 }
 
+bool canSubtreeBeReadInOrder(QueryPlan::Node & node, const SortDescription & description)
+{
+    if (description.empty())
+        return false;
+
+    StepStack backward_path;
+    QueryPlan::Node * reading_node = findReadingStep(node, backward_path);
+    if (!reading_node)
+        return false;
+
+    size_t limit = 0;
+    ActionsDAGPtr dag;
+    FixedColumns fixed_columns;
+    buildSortingDAG(node, dag, fixed_columns, limit);
+
+    if (dag && !fixed_columns.empty())
+        enreachFixedColumns(*dag, fixed_columns);
+
+    /// Unlike optimizeReadInOrder, only check what order the reading step could
+    /// provide, without requesting it: the actual rewrite is still done by
+    /// optimizeReadInOrder when it reaches the sorting step above.
+    InputOrderInfoPtr order_info;
+    if (const auto * reading = typeid_cast<const ReadFromMergeTree *>(reading_node->step.get()))
+        order_info = buildInputOrderInfo(reading, fixed_columns, dag, description, /*limit=*/ 0);
+    else if (auto * merge = typeid_cast<ReadFromMerge *>(reading_node->step.get()))
+        order_info = buildInputOrderInfo(merge, fixed_columns, dag, description, /*limit=*/ 0);
+
+    /// A partial prefix would still need a buffering sort on top, so require the
+    /// order to cover the whole description.
+    return order_info && order_info->sort_description_for_merging.size() == description.size();
+}
+
 void optimizeReadInOrder(QueryPlan::Node & node, QueryPlan::Nodes & nodes)
 {
     if (node.children.size() != 1)
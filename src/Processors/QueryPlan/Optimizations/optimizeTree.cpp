@@ -216,7 +216,7 @@ void optimizeTreeSecondPass(const QueryPlanOptimizationSettings & optimization_s
              optimization_settings.force_projection_name);
 }
 
-void optimizeTreeThirdPass(QueryPlan & plan, QueryPlan::Node & root, QueryPlan::Nodes & nodes)
+void optimizeTreeThirdPass(const QueryPlanOptimizationSettings & optimization_settings, QueryPlan & plan, QueryPlan::Node & root, QueryPlan::Nodes & nodes)
 {
     Stack stack;
     stack.push_back({.node = &root});
@@ -237,6 +237,8 @@ void optimizeTreeThirdPass(QueryPlan & plan, QueryPlan::Node & root, QueryPlan::
 
         addPlansForSets(plan, *frame.node, nodes);
 
+        bufferProbeSideWhileCreatingSets(*frame.node, nodes, optimization_settings.max_bytes_to_buffer_while_creating_sets);
+
         stack.pop_back();
     }
 }
@@ -138,6 +138,17 @@ public:
 
         for (const auto & index : indices)
             loaded_columns = std::min(loaded_columns, index->size());
+
+        /// Exact per-granule byte sizes are not recorded, so approximate them with the part's
+        /// average uncompressed row width. Parts with wide rows then contribute proportionally
+        /// more to a layer's budget than parts with narrow rows.
+        parts_avg_bytes_per_row.reserve(parts.size());
+        for (const auto & part : parts)
+        {
+            size_t rows_count = part.data_part->rows_count;
+            size_t bytes_uncompressed = part.data_part->getBytesUncompressedOnDisk();
+            parts_avg_bytes_per_row.push_back(rows_count ? std::max<size_t>(bytes_uncompressed / rows_count, 1) : 1);
+        }
     }
 
     Values getValue(size_t part_idx, size_t mark) const
@@ -210,9 +221,24 @@ public:
     {
         return parts[part_idx].data_part->index_granularity.getMarkRows(mark);
     }
+
+    /// Approximate number of bytes in a mark (see the comment about average row width in the constructor).
+    size_t getMarkBytes(size_t part_idx, size_t mark) const
+    {
+        return getMarkRows(part_idx, mark) * parts_avg_bytes_per_row[part_idx];
+    }
+
+    size_t getTotalBytesInRanges() const
+    {
+        size_t result = 0;
+        for (size_t part_idx = 0; part_idx < parts.size(); ++part_idx)
+            result += parts[part_idx].getRowsCount() * parts_avg_bytes_per_row[part_idx];
+        return result;
+    }
 private:
     const RangesInDataParts & parts;
     std::vector<IMergeTreeDataPart::Index> indices;
+    std::vector<size_t> parts_avg_bytes_per_row;
     size_t loaded_columns = std::numeric_limits<size_t>::max();
 };
 
@@ -654,7 +680,9 @@ std::pair<std::vector<RangesInDataParts>, std::vector<Values>> splitIntersecting
     const LoggerPtr & logger)
 {
     /** We will advance the iterator pointing to the mark with the smallest PK value until
-      * there will be not less than rows_per_layer rows in the current layer (roughly speaking).
+      * there will be not less than bytes_per_layer bytes in the current layer (roughly speaking).
+      * Layers are equalized by (approximate) bytes rather than rows, so that streams processing
+      * them do comparable amounts of work even when parts have very different row widths.
       * Then we choose the last observed value as the new border, so the current layer will consists
       * of granules with values greater than the previous mark and less or equal than the new border.
       *
@@ -694,14 +722,14 @@ std::pair<std::vector<RangesInDataParts>, std::vector<Values>> splitIntersecting
     std::vector<Values> borders;
     std::vector<RangesInDataParts> result_layers;
 
-    size_t total_intersecting_rows_count = intersecting_ranges_in_data_parts.getRowsCountAllParts();
-    const size_t rows_per_layer = std::max<size_t>(total_intersecting_rows_count / max_layers, 1);
+    size_t total_intersecting_bytes = index_access.getTotalBytesInRanges();
+    const size_t bytes_per_layer = std::max<size_t>(total_intersecting_bytes / max_layers, 1);
 
     while (!parts_ranges_queue.empty())
     {
         // New layer should include last granules of still open ranges from the previous layer,
         // because they may already contain values greater than the last border.
-        size_t rows_in_current_layer = 0;
+        size_t bytes_in_current_layer = 0;
         size_t marks_in_current_layer = 0;
 
         // Intersection between the current and next layers is just the last observed marks of each still open part range. Ratio is empirical.
@@ -714,7 +742,7 @@ std::pair<std::vector<RangesInDataParts>, std::vector<Values>> splitIntersecting
         RangesInDataPartsBuilder current_layer_builder(intersecting_ranges_in_data_parts);
         result_layers.emplace_back();
 
-        while (rows_in_current_layer < rows_per_layer || layers_intersection_is_too_big() || result_layers.size() == max_layers)
+        while (bytes_in_current_layer < bytes_per_layer || layers_intersection_is_too_big() || result_layers.size() == max_layers)
         {
             // We're advancing iterators until a new value showed up.
             Values last_value;
@@ -735,7 +763,7 @@ std::pair<std::vector<RangesInDataParts>, std::vector<Values>> splitIntersecting
                 }
 
                 last_value = std::move(current.value);
-                rows_in_current_layer += index_access.getMarkRows(part_index, current.range.begin);
+                bytes_in_current_layer += index_access.getMarkBytes(part_index, current.range.begin);
                 ++marks_in_current_layer;
 
                 current_part_range_begin.try_emplace(current_range_index, current.range.begin);
@@ -752,7 +780,7 @@ std::pair<std::vector<RangesInDataParts>, std::vector<Values>> splitIntersecting
             if (parts_ranges_queue.empty())
                 break;
 
-            if (rows_in_current_layer >= rows_per_layer && !layers_intersection_is_too_big() && result_layers.size() < max_layers)
+            if (bytes_in_current_layer >= bytes_per_layer && !layers_intersection_is_too_big() && result_layers.size() < max_layers)
                 borders.push_back(last_value);
         }
 
@@ -8,8 +8,14 @@
 #include <IO/Operators.h>
 #include <IO/WriteBuffer.h>
 
+#include <Interpreters/TableJoin.h>
+#include <Processors/QueryPlan/AggregatingStep.h>
 #include <Processors/QueryPlan/BuildQueryPipelineSettings.h>
+#include <Processors/QueryPlan/FilterStep.h>
 #include <Processors/QueryPlan/IQueryPlanStep.h>
+#include <Processors/QueryPlan/JoinStep.h>
+#include <Processors/QueryPlan/LimitStep.h>
+#include <Processors/QueryPlan/SortingStep.h>
 #include <Processors/QueryPlan/Optimizations/Optimizations.h>
 #include <Processors/QueryPlan/Optimizations/QueryPlanOptimizationSettings.h>
 #include <Processors/QueryPlan/QueryPlan.h>
@@ -504,7 +510,7 @@ void QueryPlan::optimize(const QueryPlanOptimizationSettings & optimization_sett
 
     QueryPlanOptimizations::optimizeTreeFirstPass(optimization_settings, *root, nodes);
     QueryPlanOptimizations::optimizeTreeSecondPass(optimization_settings, *root, nodes);
-    QueryPlanOptimizations::optimizeTreeThirdPass(*this, *root, nodes);
+    QueryPlanOptimizations::optimizeTreeThirdPass(optimization_settings, *this, *root, nodes);
 
     updateDataStreams(*root);
 }
@@ -560,6 +566,151 @@ void QueryPlan::explainEstimate(MutableColumns & columns)
     }
 }
 
+namespace
+{
+
+/// Rough size of one output row of the step; variable-sized columns (String, Array, ...) are counted with a guess.
+size_t estimateRowWidth(const Block & header)
+{
+    size_t width = 0;
+    for (const auto & column : header)
+        width += column.type->haveMaximumSizeOfValue() ? column.type->getMaximumSizeOfValue() : 32;
+    return std::max<size_t>(width, 1);
+}
+
+struct StepEstimate
+{
+    UInt64 rows = 0;  /// 0 means unknown.
+    UInt64 bytes = 0;
+    UInt64 memory_bytes = 0;  /// High-water estimate of state the step accumulates (hash tables, sort buffers).
+    bool may_spill = false;  /// Whether the accumulated state is estimated to exceed the step's external threshold.
+};
+
+StepEstimate estimateStep(const QueryPlan::Node * node, std::unordered_map<const QueryPlan::Node *, StepEstimate> & estimates)
+{
+    std::vector<StepEstimate> children;
+    children.reserve(node->children.size());
+    for (const auto * child : node->children)
+        children.push_back(estimateStep(child, estimates));
+
+    const Block & header = node->step->getOutputStream().header;
+    StepEstimate estimate;
+
+    if (const auto * reading = dynamic_cast<const ReadFromMergeTree *>(node->step.get()))
+    {
+        /// Counters are filled during pipeline build, the caller is expected to have built it.
+        estimate.rows = reading->getSelectedRows();
+        estimate.bytes = estimate.rows * estimateRowWidth(header);
+    }
+    else if (typeid_cast<const FilterStep *>(node->step.get()))
+    {
+        /// Without per-condition statistics assume the default selectivity the condition estimator uses.
+        estimate.rows = static_cast<UInt64>(children.at(0).rows * 0.5);
+        estimate.bytes = estimate.rows * estimateRowWidth(header);
+    }
+    else if (const auto * limit = typeid_cast<const LimitStep *>(node->step.get()))
+    {
+        estimate = children.at(0);
+        if (size_t limit_and_offset = limit->getLimitForSorting(); limit_and_offset && limit_and_offset < estimate.rows)
+        {
+            estimate.rows = limit_and_offset;
+            estimate.bytes = estimate.rows * estimateRowWidth(header);
+        }
+        estimate.memory_bytes = 0;
+        estimate.may_spill = false;
+    }
+    else if (const auto * sorting = typeid_cast<const SortingStep *>(node->step.get()))
+    {
+        estimate.rows = children.at(0).rows;
+        if (UInt64 limit = sorting->getLimit(); limit && limit < estimate.rows)
+            estimate.rows = limit;
+        estimate.bytes = estimate.rows * estimateRowWidth(header);
+        /// Only a full sort buffers its whole input; merging already sorted streams is streaming.
+        if (sorting->getType() == SortingStep::Type::Full)
+        {
+            estimate.memory_bytes = children.at(0).bytes;
+            size_t external_threshold = sorting->getSettings().max_bytes_before_external_sort;
+            estimate.may_spill = external_threshold && estimate.memory_bytes > external_threshold;
+        }
+    }
+    else if (const auto * aggregating = typeid_cast<const AggregatingStep *>(node->step.get()))
+    {
+        const auto & params = aggregating->getParams();
+        /// Without ndv statistics of the keys, the input cardinality is the upper bound.
+        estimate.rows = params.keys_size ? children.at(0).rows : 1;
+        estimate.bytes = estimate.rows * estimateRowWidth(header);
+        if (params.keys_size)
+        {
+            estimate.memory_bytes = children.at(0).bytes;
+            estimate.may_spill = params.max_bytes_before_external_group_by
+                && estimate.memory_bytes > params.max_bytes_before_external_group_by;
+        }
+    }
+    else if (const auto * join = typeid_cast<const JoinStep *>(node->step.get()))
+    {
+        const auto & left = children.at(0);
+        const auto & right = children.at(1);
+        /// An upper bound for equi joins; only a cross join multiplies the cardinalities.
+        if (isCrossOrComma(join->getJoin()->getTableJoin().kind()))
+            estimate.rows = left.rows * right.rows;
+        else
+            estimate.rows = std::max(left.rows, right.rows);
+        estimate.bytes = estimate.rows * estimateRowWidth(header);
+        /// The right side is buffered in the hash table.
+        estimate.memory_bytes = right.bytes;
+    }
+    else if (children.size() == 1)
+    {
+        estimate.rows = children.front().rows;
+        estimate.bytes = estimate.rows * estimateRowWidth(header);
+    }
+    else if (!children.empty())
+    {
+        /// Union and the like: an overestimate is safer for admission control.
+        for (const auto & child : children)
+        {
+            estimate.rows += child.rows;
+            estimate.bytes += child.bytes;
+        }
+    }
+
+    estimates[node] = estimate;
+    return estimate;
+}
+
+}
+
+void QueryPlan::explainEstimateSteps(MutableColumns & columns)
+{
+    checkInitialized();
+
+    std::unordered_map<const Node *, StepEstimate> estimates;
+    estimateStep(root, estimates);
+
+    /// Top-down, same order as EXPLAIN PLAN.
+    std::stack<const Node *> stack;
+    stack.push(root);
+    while (!stack.empty())
+    {
+        const auto * node = stack.top();
+        stack.pop();
+
+        const auto & estimate = estimates.at(node);
+        size_t index = 0;
+        auto name = node->step->getName();
+        columns[index++]->insertData(name.data(), name.size());
+        const auto & description = node->step->getStepDescription();
+        columns[index++]->insertData(description.data(), description.size());
+        columns[index++]->insert(estimate.rows);
+        columns[index++]->insert(estimate.bytes);
+        columns[index++]->insert(estimate.memory_bytes);
+        columns[index++]->insert(static_cast<UInt8>(estimate.may_spill));
+
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+            stack.push(*it);
+    }
+}
+
 std::pair<QueryPlan::Nodes, QueryPlanResourceHolder> QueryPlan::detachNodesAndResources(QueryPlan && plan)
 {
     return {std::move(plan.nodes), std::move(plan.resources)};
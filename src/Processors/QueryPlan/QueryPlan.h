@@ -84,6 +84,9 @@ public:
     void explainPlan(WriteBuffer & buffer, const ExplainPlanOptions & options, size_t indent = 0);
     void explainPipeline(WriteBuffer & buffer, const ExplainPipelineOptions & options);
     void explainEstimate(MutableColumns & columns);
+    /// One row per plan step with estimated output cardinality and accumulated memory,
+    /// derived bottom-up from the rows selected by the reading steps (EXPLAIN ESTIMATE plan_nodes = 1).
+    void explainEstimateSteps(MutableColumns & columns);
 
     /// Do not allow to change the table while the pipeline alive.
     void addTableLock(TableLockHolder lock) { resources.table_locks.emplace_back(std::move(lock)); }
@@ -38,6 +38,7 @@
 #include <base/sort.h>
 #include <Poco/Logger.h>
 #include <Common/JSONBuilder.h>
+#include <Common/SipHash.h>
 #include <Common/isLocalAddress.h>
 #include <Common/logger_useful.h>
 #include <Processors/QueryPlan/IQueryPlanStep.h>
@@ -145,9 +146,11 @@ static MergeTreeReaderSettings getMergeTreeReaderSettings(
         .checksum_on_read = settings.checksum_on_read,
         .read_in_order = query_info.input_order_info != nullptr,
         .apply_deleted_mask = settings.apply_deleted_mask,
+        .use_deleted_mask_summary = settings.use_deleted_mask_summary,
         .use_asynchronous_read_from_pool = settings.allow_asynchronous_read_from_io_pool_for_merge_tree
             && (settings.max_streams_to_max_threads_ratio > 1 || settings.max_streams_for_merge_tree_reading > 1),
         .enable_multiple_prewhere_read_steps = settings.enable_multiple_prewhere_read_steps,
+        .filtered_granule_cache = settings.use_filtered_granule_cache ? context->getFilteredGranuleCache() : nullptr,
     };
 }
 
@@ -382,6 +385,9 @@ Pipe ReadFromMergeTree::readFromPoolParallelReplicas(
             pool, std::move(algorithm), prewhere_info,
             actions_settings, block_size_copy, reader_settings);
 
+        if (!join_runtime_filters.empty())
+            processor->setJoinRuntimeFilters(join_runtime_filters, metadata_for_reading, context);
+
         auto source = std::make_shared<MergeTreeSource>(std::move(processor));
         pipes.emplace_back(std::move(source));
     }
@@ -412,30 +418,33 @@ Pipe ReadFromMergeTree::readFromPool(
             / block_size.max_block_size_rows * block_size.max_block_size_rows / fixed_index_granularity;
     }
 
-    bool all_parts_are_remote = true;
-    bool all_parts_are_local = true;
+    bool has_remote_parts = false;
+    bool has_local_parts = false;
     for (const auto & part : parts_with_range)
     {
         const bool is_remote = part.data_part->isStoredOnRemoteDisk();
-        all_parts_are_local &= !is_remote;
-        all_parts_are_remote &= is_remote;
+        has_local_parts |= !is_remote;
+        has_remote_parts |= is_remote;
     }
 
     MergeTreeReadPoolPtr pool;
 
-    bool allow_prefetched_remote = all_parts_are_remote
-        && settings.allow_prefetched_read_pool_for_remote_filesystem
+    bool allow_prefetched_remote = settings.allow_prefetched_read_pool_for_remote_filesystem
         && MergeTreePrefetchedReadPool::checkReadMethodAllowed(reader_settings.read_settings.remote_fs_method);
 
-    bool allow_prefetched_local = all_parts_are_local
-        && settings.allow_prefetched_read_pool_for_local_filesystem
+    bool allow_prefetched_local = settings.allow_prefetched_read_pool_for_local_filesystem
         && MergeTreePrefetchedReadPool::checkReadMethodAllowed(reader_settings.read_settings.local_fs_method);
 
     /** Do not use prefetched read pool if query is trivial limit query.
       * Because time spend during filling per thread tasks can be greater than whole query
       * execution for big tables with small limit.
+      * A scan over mixed storage (e.g. a tiered storage policy with both local and remote
+      * disks) can use the prefetched pool as long as every class of parts present allows it.
       */
-    bool use_prefetched_read_pool = query_info.limit == 0 && (allow_prefetched_remote || allow_prefetched_local);
+    bool use_prefetched_read_pool = query_info.limit == 0
+        && (has_remote_parts || has_local_parts)
+        && (!has_remote_parts || allow_prefetched_remote)
+        && (!has_local_parts || allow_prefetched_local);
 
     if (use_prefetched_read_pool)
     {
@@ -481,6 +490,9 @@ Pipe ReadFromMergeTree::readFromPool(
             pool, std::move(algorithm), prewhere_info,
             actions_settings, block_size_copy, reader_settings);
 
+        if (!join_runtime_filters.empty())
+            processor->setJoinRuntimeFilters(join_runtime_filters, metadata_for_reading, context);
+
         auto source = std::make_shared<MergeTreeSource>(std::move(processor));
 
         if (i == 0)
@@ -591,6 +603,9 @@ Pipe ReadFromMergeTree::readInOrder(
             pool, std::move(algorithm), prewhere_info,
             actions_settings, block_size, reader_settings);
 
+        if (!join_runtime_filters.empty())
+            processor->setJoinRuntimeFilters(join_runtime_filters, metadata_for_reading, context);
+
         processor->addPartLevelToChunk(isQueryWithFinal());
 
         auto source = std::make_shared<MergeTreeSource>(std::move(processor));
@@ -718,6 +733,138 @@ struct PartRangesReadInfo
     }
 };
 
+/// For `ORDER BY primary_key_prefix LIMIT n` reading in forward order, drop mark ranges
+/// which provably cannot contain any of the first n rows.
+///
+/// A watermark is computed from the primary index: for every part, walk the selected granules
+/// in key order and find the index entry right after the first `limit` rows. All these rows
+/// have keys not greater than that entry. The smallest such entry over all parts bounds the
+/// n-th smallest key of the whole result, so any granule whose first key is above it can be
+/// skipped. Rows equal to the watermark are always kept, which makes the pruning correct even
+/// when the query sorts by extra columns beyond the in-order prefix.
+///
+/// The caller must ensure that no rows are dropped between reading and LIMIT
+/// (no filters, no sampling, no FINAL).
+void pruneRangesByLimitWatermark(RangesInDataParts & parts_with_ranges, size_t prefix_size, UInt64 limit, const LoggerPtr & log)
+{
+    /// The deleted-rows mask is applied during reading and can drop rows below the watermark.
+    for (const auto & part : parts_with_ranges)
+        if (part.data_part->hasLightweightDelete())
+            return;
+
+    /// Keep the loaded indexes alive while pruning.
+    std::vector<IMergeTreeDataPart::Index> indexes;
+    indexes.reserve(parts_with_ranges.size());
+    for (const auto & part : parts_with_ranges)
+    {
+        indexes.push_back(part.data_part->getIndex());
+        /// The comparison prefix must be present in every index.
+        prefix_size = std::min(prefix_size, indexes.back()->size());
+    }
+
+    if (prefix_size == 0)
+        return;
+
+    auto watermark_less = [&](const Columns & lhs, size_t lhs_row, const Columns & rhs, size_t rhs_row)
+    {
+        for (size_t i = 0; i < prefix_size; ++i)
+        {
+            int cmp = lhs[i]->compareAt(lhs_row, rhs_row, *rhs[i], /*nan_direction_hint=*/ 1);
+            if (cmp != 0)
+                return cmp < 0;
+        }
+        return false;
+    };
+
+    const Columns * watermark_index = nullptr;
+    size_t watermark_row = 0;
+
+    for (size_t part_idx = 0; part_idx < parts_with_ranges.size(); ++part_idx)
+    {
+        const auto & part = parts_with_ranges[part_idx];
+        const auto & index = *indexes[part_idx];
+        const size_t index_rows = index.empty() ? 0 : index.front()->size();
+
+        UInt64 accumulated_rows = 0;
+        std::optional<size_t> bound_row;
+
+        for (const auto & range : part.ranges)
+        {
+            for (size_t mark = range.begin; mark < range.end && !bound_row; ++mark)
+            {
+                accumulated_rows += part.data_part->index_granularity.getMarkRows(mark);
+                if (accumulated_rows >= limit)
+                {
+                    /// All accumulated rows have keys not greater than the first key of the next granule.
+                    if (mark + 1 < index_rows)
+                        bound_row = mark + 1;
+                }
+            }
+            if (accumulated_rows >= limit)
+                break;
+        }
+
+        if (bound_row && (!watermark_index || watermark_less(index, *bound_row, *watermark_index, watermark_row)))
+        {
+            watermark_index = &index;
+            watermark_row = *bound_row;
+        }
+    }
+
+    if (!watermark_index)
+        return;
+
+    RangesInDataParts pruned_parts;
+    pruned_parts.reserve(parts_with_ranges.size());
+    size_t marks_before = 0;
+    size_t marks_after = 0;
+
+    for (size_t part_idx = 0; part_idx < parts_with_ranges.size(); ++part_idx)
+    {
+        auto & part = parts_with_ranges[part_idx];
+        const auto & index = *indexes[part_idx];
+        const size_t index_rows = index.empty() ? 0 : index.front()->size();
+
+        MarkRanges pruned_ranges;
+        for (const auto & range : part.ranges)
+        {
+            marks_before += range.end - range.begin;
+
+            /// Find the first granule whose first key is above the watermark.
+            /// Everything in it and beyond cannot contain rows below or equal to the watermark.
+            size_t lo = range.begin;
+            size_t hi = std::min<size_t>(range.end, index_rows);
+            while (lo < hi)
+            {
+                size_t mid = lo + (hi - lo) / 2;
+                if (watermark_less(*watermark_index, watermark_row, index, mid))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+
+            /// Marks not covered by the index (if any) are kept.
+            size_t new_end = range.end <= index_rows ? lo : range.end;
+
+            if (new_end > range.begin)
+            {
+                pruned_ranges.emplace_back(range.begin, new_end);
+                marks_after += new_end - range.begin;
+            }
+        }
+
+        if (!pruned_ranges.empty())
+            pruned_parts.emplace_back(part.data_part, part.alter_conversions, part.part_index_in_query, std::move(pruned_ranges));
+    }
+
+    if (marks_after < marks_before)
+    {
+        LOG_DEBUG(log, "LIMIT watermark pruned mark ranges for reading in order: {} -> {} marks in {} -> {} parts",
+            marks_before, marks_after, parts_with_ranges.size(), pruned_parts.size());
+        parts_with_ranges = std::move(pruned_parts);
+    }
+}
+
 }
 
 Pipe ReadFromMergeTree::spreadMarkRangesAmongStreams(RangesInDataParts && parts_with_ranges, size_t num_streams, const Names & column_names)
@@ -1453,6 +1600,19 @@ static void buildIndexes(
     using Key = std::pair<String, size_t>;
     std::map<Key, size_t> merged;
 
+    /// Fingerprint of the filter used as a part of the skipping index result cache key.
+    /// The hash covers the values of folded constants, and filters with non-deterministic
+    /// functions (e.g. rand()) are not cached at all, since their results must not be reused
+    /// across queries. Vector search conditions are not covered either: they are built from
+    /// the whole query, not from the filter.
+    UInt64 filter_actions_dag_hash = 0;
+    if (filter_actions_dag && !filter_actions_dag->hasNonDeterministic())
+    {
+        SipHash hash;
+        filter_actions_dag->updateHash(hash);
+        filter_actions_dag_hash = hash.get64();
+    }
+
     for (const auto & index : metadata_snapshot->getSecondaryIndices())
     {
         if (!ignored_index_names.contains(index.name))
@@ -1472,6 +1632,7 @@ static void buildIndexes(
             else
             {
                 MergeTreeIndexConditionPtr condition;
+                UInt64 condition_hash = 0;
                 if (index_helper->isVectorSearch())
                 {
 #ifdef ENABLE_ANNOY
@@ -1486,10 +1647,13 @@ static void buildIndexes(
                         throw Exception(ErrorCodes::LOGICAL_ERROR, "Unknown vector search index {}", index_helper->index.name);
                 }
                 else
+                {
                     condition = index_helper->createIndexCondition(filter_actions_dag, context);
+                    condition_hash = filter_actions_dag_hash;
+                }
 
                 if (!condition->alwaysUnknownOrTrue())
-                    skip_indexes.useful_indices.emplace_back(index_helper, condition);
+                    skip_indexes.useful_indices.emplace_back(index_helper, condition, condition_hash);
             }
         }
     }
@@ -1881,8 +2045,17 @@ Pipe ReadFromMergeTree::spreadMarkRanges(
     }
     else if (query_info.input_order_info)
     {
+        const auto & input_order_info = query_info.input_order_info;
+
+        /// The limit is non-zero only if no steps between reading and sorting may drop rows,
+        /// the remaining row-dropping mechanisms are checked here explicitly.
+        if (context->getSettingsRef().read_in_order_limit_pruning
+            && input_order_info->limit && input_order_info->direction == 1
+            && !is_parallel_reading_from_replicas && !prewhere_info && !result.sampling.use_sampling)
+            pruneRangesByLimitWatermark(parts_with_ranges, input_order_info->used_prefix_of_sorting_key_size, input_order_info->limit, log);
+
         return spreadMarkRangesAmongStreamsWithOrder(
-            std::move(parts_with_ranges), num_streams, column_names_to_read, result_projection, query_info.input_order_info);
+            std::move(parts_with_ranges), num_streams, column_names_to_read, result_projection, input_order_info);
     }
     else
     {
@@ -1976,6 +2149,21 @@ void ReadFromMergeTree::initializePipeline(QueryPipelineBuilder & pipeline, cons
     selected_marks = result.selected_marks;
     selected_rows = result.selected_rows;
     selected_parts = result.selected_parts;
+
+    /// A large scan should not be allowed to flush the hot working set of point queries out of
+    /// the filesystem cache. If this read is estimated to be big enough, the segments it touches
+    /// keep their eviction priority: they are still cached, but do not get promoted.
+    if (size_t scan_min_bytes = context->getSettingsRef().filesystem_cache_scan_resistant_read_min_bytes;
+        scan_min_bytes && reader_settings.read_settings.enable_filesystem_cache)
+    {
+        size_t estimated_bytes_to_read = 0;
+        for (const auto & part : result.parts_with_ranges)
+            if (size_t part_marks = part.data_part->getMarksCount())
+                estimated_bytes_to_read += part.data_part->getBytesOnDisk() * part.getMarksCount() / part_marks;
+
+        if (estimated_bytes_to_read >= scan_min_bytes)
+            reader_settings.read_settings.filesystem_cache_scan_resistant_read = true;
+    }
     /// Projection, that needed to drop columns, which have appeared by execution
     /// of some extra expressions, and to allow execute the same expressions later.
     /// NOTE: It may lead to double computation of expressions.
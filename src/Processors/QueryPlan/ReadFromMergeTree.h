@@ -1,4 +1,5 @@
 #pragma once
+#include <Interpreters/JoinRuntimeFilter.h>
 #include <Processors/QueryPlan/SourceStepWithFilter.h>
 #include <Storages/MergeTree/RangesInDataPart.h>
 #include <Storages/MergeTree/RequestResponse.h>
@@ -33,8 +34,12 @@ struct UsefulSkipIndexes
         MergeTreeIndexPtr index;
         MergeTreeIndexConditionPtr condition;
 
-        DataSkippingIndexAndCondition(MergeTreeIndexPtr index_, MergeTreeIndexConditionPtr condition_)
-            : index(index_), condition(condition_)
+        /// Fingerprint of the filter the condition was built from.
+        /// Zero means the condition cannot be fingerprinted and its results must not be cached.
+        UInt64 condition_hash = 0;
+
+        DataSkippingIndexAndCondition(MergeTreeIndexPtr index_, MergeTreeIndexConditionPtr condition_, UInt64 condition_hash_ = 0)
+            : index(index_), condition(condition_), condition_hash(condition_hash_)
         {
         }
     };
@@ -173,6 +178,10 @@ public:
 
     StorageMetadataPtr getStorageMetadata() const { return metadata_for_reading; }
 
+    /// Attach a runtime filter from the build side of a hash join over this scan.
+    /// It is used to prune mark ranges once the build side is complete.
+    void addJoinRuntimeFilter(JoinRuntimeFilterPtr filter) { join_runtime_filters.push_back(std::move(filter)); }
+
     /// Returns `false` if requested reading cannot be performed.
     bool requestReadingInOrder(size_t prefix_size, int direction, size_t limit);
     bool readsInOrder() const;
@@ -218,6 +227,8 @@ private:
 
     StorageMetadataPtr metadata_for_reading;
 
+    JoinRuntimeFilters join_runtime_filters;
+
     const MergeTreeReadTask::BlockSizeParams block_size;
 
     size_t requested_num_streams;
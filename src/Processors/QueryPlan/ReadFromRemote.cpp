@@ -13,6 +13,7 @@
 #include <Processors/Transforms/ExpressionTransform.h>
 #include <Processors/Transforms/MaterializingTransform.h>
 #include <Interpreters/ActionsDAG.h>
+#include <Interpreters/InterpreterSelectQuery.h>
 #include <Common/logger_useful.h>
 #include <Common/checkStackSize.h>
 #include <Core/QueryProcessingStage.h>
@@ -138,6 +139,34 @@ void ReadFromRemote::enforceAggregationInOrder()
     DB::enforceAggregationInOrder(stage, *context);
 }
 
+void ReadFromRemote::createSortThresholdExchangeIfNeeded()
+{
+    if (!context->getSettingsRef().distributed_sort_threshold_exchange || shards.size() < 2)
+        return;
+
+    const auto * select = shards.front().query->as<ASTSelectQuery>();
+    if (!select)
+        return;
+
+    /// getLimitForSorting() returns 0 when the limit cannot be used to prune sorting
+    /// (DISTINCT, LIMIT BY, WITH TIES, ARRAY JOIN).
+    UInt64 limit = InterpreterSelectQuery::getLimitForSorting(*select, context);
+    if (!limit)
+        return;
+
+    SortDescription description = InterpreterSelectQuery::getSortDescription(*select, context);
+    if (description.empty())
+        return;
+
+    /// Thresholds are compared on the shards without collation, and WITH FILL
+    /// generates rows that a threshold would cut off.
+    for (const auto & column_description : description)
+        if (column_description.collator || column_description.with_fill)
+            return;
+
+    sort_threshold_exchange = std::make_shared<SortThresholdExchange>(std::move(description), limit);
+}
+
 void ReadFromRemote::addLazyPipe(Pipes & pipes, const ClusterProxy::SelectStreamFactory::Shard & shard)
 {
     bool add_agg_info = stage == QueryProcessingStage::WithMergeableState;
@@ -158,6 +187,7 @@ void ReadFromRemote::addLazyPipe(Pipes & pipes, const ClusterProxy::SelectStream
             my_main_table = main_table, my_table_func_ptr = table_func_ptr,
             my_scalars = scalars, my_external_tables = external_tables,
             my_stage = stage, local_delay = shard.local_delay,
+            my_sort_threshold_exchange = sort_threshold_exchange,
             add_agg_info, add_totals, add_extremes, async_read, async_query_sending]() mutable
         -> QueryPipelineBuilder
     {
@@ -214,6 +244,9 @@ void ReadFromRemote::addLazyPipe(Pipes & pipes, const ClusterProxy::SelectStream
             auto remote_query_executor = std::make_shared<RemoteQueryExecutor>(
                 std::move(connections), query_string, header, my_context, my_throttler, my_scalars, my_external_tables, my_stage);
 
+            if (my_sort_threshold_exchange)
+                remote_query_executor->setSortThresholdExchange(my_sort_threshold_exchange);
+
             auto pipe = createRemoteSourcePipe(remote_query_executor, add_agg_info, add_totals, add_extremes, async_read, async_query_sending);
             QueryPipelineBuilder builder;
             builder.init(std::move(pipe));
@@ -298,6 +331,9 @@ void ReadFromRemote::addPipe(Pipes & pipes, const ClusterProxy::SelectStreamFact
             remote_query_executor->setLogger(log);
             remote_query_executor->setPoolMode(PoolMode::GET_ONE);
 
+            if (sort_threshold_exchange)
+                remote_query_executor->setSortThresholdExchange(sort_threshold_exchange);
+
             if (!table_func_ptr)
                 remote_query_executor->setMainTable(shard.main_table ? shard.main_table : main_table);
 
@@ -314,6 +350,9 @@ void ReadFromRemote::addPipe(Pipes & pipes, const ClusterProxy::SelectStreamFact
             shard.shard_info.pool, query_string, shard.header, context, throttler, scalars, external_tables, stage);
         remote_query_executor->setLogger(log);
 
+        if (sort_threshold_exchange)
+            remote_query_executor->setSortThresholdExchange(sort_threshold_exchange);
+
         if (context->canUseTaskBasedParallelReplicas())
         {
             // when doing parallel reading from replicas (ParallelReplicasMode::READ_TASKS) on a shard:
@@ -338,6 +377,8 @@ void ReadFromRemote::addPipe(Pipes & pipes, const ClusterProxy::SelectStreamFact
 
 void ReadFromRemote::initializePipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &)
 {
+    createSortThresholdExchangeIfNeeded();
+
     Pipes pipes;
 
     for (const auto & shard : shards)
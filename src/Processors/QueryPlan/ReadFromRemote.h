@@ -5,6 +5,7 @@
 #include <Storages/IStorage_fwd.h>
 #include <Interpreters/StorageID.h>
 #include <Interpreters/ClusterProxy/SelectStreamFactory.h>
+#include <QueryPipeline/SortThresholdExchange.h>
 #include <Core/UUID.h>
 
 namespace DB
@@ -57,7 +58,11 @@ private:
     UInt32 shard_count;
     const String cluster_name;
     std::optional<GetPriorityForLoadBalancing> priority_func_factory;
+    /// For distributed ORDER BY ... LIMIT queries: shared between the shards' executors,
+    /// pushes the current k-th sort key back to the shards. See SortThresholdExchange.
+    SortThresholdExchangePtr sort_threshold_exchange;
 
+    void createSortThresholdExchangeIfNeeded();
     void addLazyPipe(Pipes & pipes, const ClusterProxy::SelectStreamFactory::Shard & shard);
     void addPipe(Pipes & pipes, const ClusterProxy::SelectStreamFactory::Shard & shard);
 };
@@ -38,6 +38,7 @@ SortingStep::Settings::Settings(const Context & context)
     tmp_data = context.getTempDataOnDisk();
     min_free_disk_space = settings.min_free_disk_space_for_temporary_data;
     max_block_bytes = settings.prefer_external_sort_block_bytes;
+    sort_threshold_slot = context.getSortThresholdSlot();
 }
 
 SortingStep::Settings::Settings(size_t max_block_size_)
@@ -311,7 +312,7 @@ void SortingStep::fullSortStreams(
                 if (stream_type != QueryPipelineBuilder::StreamType::Main)
                     return nullptr;
 
-                return std::make_shared<PartialSortingTransform>(header, result_sort_desc, limit_);
+                return std::make_shared<PartialSortingTransform>(header, result_sort_desc, limit_, sort_settings.sort_threshold_slot);
             });
 
         StreamLocalLimits limits;
@@ -376,6 +377,13 @@ void SortingStep::transformPipeline(QueryPipelineBuilder & pipeline, const Build
         {
             finishSorting(pipeline, prefix_description, result_description, limit);
         }
+
+        /// A sort for a window with PARTITION BY that was converted to finish sorting
+        /// (the input is read in order) produces a single stream. Scatter it back into
+        /// one stream per thread, so that the window transforms run in parallel:
+        /// the scatter splits chunks in order, so every output stream stays sorted
+        /// and holds its PARTITION BY groups wholly.
+        scatterByPartitionIfNeeded(pipeline);
         return;
     }
 
@@ -393,6 +401,8 @@ void SortingStep::transformPipeline(QueryPipelineBuilder & pipeline, const Build
                     "{}",
                     pipeline.getNumStreams());
 
+            /// Parallelize window execution over the already sorted stream, see the comment for FinishSorting.
+            scatterByPartitionIfNeeded(pipeline);
             return;
         }
 
@@ -400,6 +410,8 @@ void SortingStep::transformPipeline(QueryPipelineBuilder & pipeline, const Build
         if (input_sort_mode == DataStream::SortScope::Stream && input_sort_desc.hasPrefix(result_description))
         {
             mergingSorted(pipeline, result_description, limit);
+            /// Parallelize window execution over the already sorted stream, see the comment for FinishSorting.
+            scatterByPartitionIfNeeded(pipeline);
             return;
         }
 
@@ -2,6 +2,7 @@
 #include <Processors/QueryPlan/ITransformingStep.h>
 #include <Core/SortDescription.h>
 #include <QueryPipeline/SizeLimits.h>
+#include <QueryPipeline/SortThresholdExchange.h>
 #include <Interpreters/TemporaryDataOnDisk.h>
 
 namespace DB
@@ -28,6 +29,8 @@ public:
         TemporaryDataOnDiskScopePtr tmp_data = nullptr;
         size_t min_free_disk_space = 0;
         size_t max_block_bytes = 0;
+        /// Sort key thresholds pushed by the initiator of a distributed query, if any.
+        SortThresholdSlotPtr sort_threshold_slot = nullptr;
 
         explicit Settings(const Context & context);
         explicit Settings(size_t max_block_size_);
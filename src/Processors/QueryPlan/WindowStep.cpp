@@ -60,7 +60,7 @@ WindowStep::WindowStep(
 
 }
 
-void WindowStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &)
+void WindowStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings & settings)
 {
     auto num_threads = pipeline.getNumThreads();
 
@@ -74,7 +74,8 @@ void WindowStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQ
         [&](const Block & /*header*/)
         {
             return std::make_shared<WindowTransform>(
-                input_streams.front().header, output_stream->header, window_description, window_functions);
+                input_streams.front().header, output_stream->header, window_description, window_functions,
+                settings.window_functions_sliding_aggregation);
         });
 
     if (streams_fan_out)
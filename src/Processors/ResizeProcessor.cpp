@@ -188,7 +188,7 @@ IProcessor::Status ResizeProcessor::prepare(const PortNumbers & updated_inputs,
             if (output.status != OutputStatus::NeedData)
             {
                 output.status = OutputStatus::NeedData;
-                waiting_outputs.push(output_number);
+                waiting_outputs.push_back(output_number);
             }
         }
     }
@@ -233,13 +233,28 @@ IProcessor::Status ResizeProcessor::prepare(const PortNumbers & updated_inputs,
 
     while (!waiting_outputs.empty() && !inputs_with_data.empty())
     {
-        auto & waiting_output = output_ports[waiting_outputs.front()];
-        waiting_outputs.pop();
+        /// Route the chunk to the least-loaded of the ready outputs. Plain FIFO order
+        /// is fair in the number of chunks but not in bytes: with uneven chunk sizes a
+        /// single slow downstream (e.g. a skewed aggregation) keeps receiving large
+        /// chunks while its siblings are ready as well, and eventually stalls the whole
+        /// pipeline. Outputs that are not ready are never chosen, so a blocked consumer
+        /// naturally receives nothing. The number of outputs is small (about the number
+        /// of threads), so a linear scan is fine.
+        size_t least_loaded_pos = 0;
+        for (size_t i = 1; i < waiting_outputs.size(); ++i)
+            if (output_ports[waiting_outputs[i]].bytes_pushed < output_ports[waiting_outputs[least_loaded_pos]].bytes_pushed)
+                least_loaded_pos = i;
+
+        auto & waiting_output = output_ports[waiting_outputs[least_loaded_pos]];
+        waiting_outputs[least_loaded_pos] = waiting_outputs.back();
+        waiting_outputs.pop_back();
 
         auto & input_with_data = input_ports[inputs_with_data.front()];
         inputs_with_data.pop();
 
-        waiting_output.port->pushData(input_with_data.port->pullData());
+        auto data = input_with_data.port->pullData();
+        waiting_output.bytes_pushed += data.chunk.bytes();
+        waiting_output.port->pushData(std::move(data));
         input_with_data.status = InputStatus::NotActive;
         waiting_output.status = OutputStatus::NotActive;
 
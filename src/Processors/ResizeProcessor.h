@@ -40,7 +40,9 @@ private:
 
     size_t num_finished_inputs = 0;
     size_t num_finished_outputs = 0;
-    std::queue<UInt64> waiting_outputs;
+    /// Outputs which are ready to accept a chunk. Not a queue: the next chunk is routed
+    /// to the ready output with the least amount of data pushed so far, see prepare().
+    std::vector<UInt64> waiting_outputs;
     std::queue<UInt64> inputs_with_data;
     bool initialized = false;
     bool is_reading_started = false;
@@ -69,6 +71,8 @@ private:
     {
         OutputPort * port;
         OutputStatus status;
+        /// Total bytes pushed to this output, used to balance the load between outputs.
+        UInt64 bytes_pushed = 0;
     };
 
     std::vector<InputPortWithStatus> input_ports;
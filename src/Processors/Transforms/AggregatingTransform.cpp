@@ -42,6 +42,13 @@ Chunk convertToChunk(const Block & block)
 
 namespace
 {
+    /// The adaptive passthrough decision (see AggregatingTransform::consume()) is made after this
+    /// many input rows: early enough to matter, late enough for the reduction ratio to be credible.
+    constexpr UInt64 adaptive_passthrough_min_src_rows = 100'000;
+
+    /// The reduction is considered poor when the number of groups exceeds this fraction of the input rows.
+    constexpr double adaptive_passthrough_min_reduction = 0.9;
+
     const AggregatedChunkInfo * getInfoFromChunk(const Chunk & chunk)
     {
         const auto & info = chunk.getChunkInfo();
@@ -280,16 +287,23 @@ private:
 /// ConvertingAggregatedToChunksWithMergingSource -> ConvertingAggregatedToChunksTransform -> AggregatingTransform
 /// ConvertingAggregatedToChunksWithMergingSource ->
 ///
-/// Result chunks guaranteed to be sorted by bucket number.
+/// If produce_results_in_order_of_bucket_number is set, result chunks are guaranteed to be sorted
+/// by bucket number. Otherwise buckets are emitted as soon as they are merged, so a large skewed
+/// bucket does not delay the buckets merged after it.
 class ConvertingAggregatedToChunksTransform : public IProcessor
 {
 public:
-    ConvertingAggregatedToChunksTransform(AggregatingTransformParamsPtr params_, ManyAggregatedDataVariantsPtr data_, size_t num_threads_)
+    ConvertingAggregatedToChunksTransform(
+        AggregatingTransformParamsPtr params_,
+        ManyAggregatedDataVariantsPtr data_,
+        size_t num_threads_,
+        bool produce_results_in_order_of_bucket_number_)
         : IProcessor({}, {params_->getHeader()})
         , params(std::move(params_))
         , data(std::move(data_))
         , shared_data(std::make_shared<ConvertingAggregatedToChunksWithMergingSource::SharedData>())
         , num_threads(num_threads_)
+        , produce_results_in_order_of_bucket_number(produce_results_in_order_of_bucket_number_)
     {
     }
 
@@ -405,6 +419,36 @@ private:
     {
         auto & output = outputs.front();
 
+        if (!produce_results_in_order_of_bucket_number)
+        {
+            /// Push merged buckets as they arrive, whatever their number.
+            bool all_inputs_finished = true;
+            for (auto & input : inputs)
+            {
+                if (input.isFinished())
+                    continue;
+
+                all_inputs_finished = false;
+                if (input.hasData())
+                {
+                    auto chunk = input.pull();
+                    if (chunk.hasRows())
+                    {
+                        output.push(std::move(chunk));
+                        return Status::PortFull;
+                    }
+                }
+            }
+
+            if (all_inputs_finished)
+            {
+                output.finish();
+                return Status::Finished;
+            }
+
+            return Status::NeedData;
+        }
+
         for (auto & input : inputs)
         {
             if (!input.isFinished() && input.hasData())
@@ -444,6 +488,7 @@ private:
     ConvertingAggregatedToChunksWithMergingSource::SharedDataPtr shared_data;
 
     size_t num_threads;
+    bool produce_results_in_order_of_bucket_number;
 
     bool is_initialized = false;
     bool finished = false;
@@ -588,6 +633,14 @@ IProcessor::Status AggregatingTransform::prepare()
         return Status::PortFull;
     }
 
+    /// Flush blocks aggregated alone in passthrough mode (see consume()).
+    if (!passthrough_chunks.empty())
+    {
+        output.push(std::move(passthrough_chunks.front()));
+        passthrough_chunks.pop_front();
+        return Status::PortFull;
+    }
+
     /// Finish data processing, prepare to generating.
     if (is_consume_finished && !is_generate_initialized.test())
     {
@@ -697,7 +750,31 @@ void AggregatingTransform::consume(Chunk chunk)
     }
     else
     {
-        if (!params->aggregator.executeOnBlock(chunk.detachColumns(), 0, num_rows, variants, key_columns, aggregate_columns, no_more_keys))
+        /// Pre-aggregation that barely reduces the cardinality only burns CPU and memory on hash
+        /// table growth while the merging stage still has to combine almost all input rows. Once
+        /// enough rows were seen to judge the reduction, switch to aggregating every block alone:
+        /// the result is in the same mergeable-state format, keeps whatever reduction exists within
+        /// a block, and the hash table size is bounded by the block size.
+        if (params->adaptive_passthrough && !is_passthrough && !no_more_keys && src_rows >= adaptive_passthrough_min_src_rows)
+        {
+            size_t result_rows = variants.sizeWithoutOverflowRow();
+            if (result_rows > src_rows * adaptive_passthrough_min_reduction)
+            {
+                is_passthrough = true;
+                LOG_DEBUG(log, "Aggregation reduced {} rows only to {}, switching to passthrough of per-block aggregated data", src_rows, result_rows);
+            }
+        }
+
+        if (is_passthrough)
+        {
+            AggregatedDataVariants block_variants;
+            bool block_no_more_keys = false;
+            if (!params->aggregator.executeOnBlock(chunk.detachColumns(), 0, num_rows, block_variants, key_columns, aggregate_columns, block_no_more_keys))
+                is_consume_finished = true;
+            for (auto & block : params->aggregator.convertToBlocks(block_variants, /* final */ false, /* max_threads */ 1))
+                passthrough_chunks.emplace_back(convertToChunk(block));
+        }
+        else if (!params->aggregator.executeOnBlock(chunk.detachColumns(), 0, num_rows, variants, key_columns, aggregate_columns, no_more_keys))
             is_consume_finished = true;
     }
 }
@@ -749,8 +826,8 @@ void AggregatingTransform::initGenerate()
         {
             auto prepared_data = params->aggregator.prepareVariantsToMerge(std::move(many_data->variants));
             auto prepared_data_ptr = std::make_shared<ManyAggregatedDataVariants>(std::move(prepared_data));
-            processors.emplace_back(
-                std::make_shared<ConvertingAggregatedToChunksTransform>(params, std::move(prepared_data_ptr), max_threads));
+            processors.emplace_back(std::make_shared<ConvertingAggregatedToChunksTransform>(
+                params, std::move(prepared_data_ptr), max_threads, should_produce_results_in_order_of_bucket_number));
         }
         else
         {
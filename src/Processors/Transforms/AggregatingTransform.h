@@ -4,6 +4,8 @@
 #include <Interpreters/Aggregator.h>
 #include <Processors/IAccumulatingTransform.h>
 #include <Common/Stopwatch.h>
+
+#include <deque>
 #include <Common/setThreadName.h>
 #include <Common/scope_guard_safe.h>
 #include <Common/CurrentMetrics.h>
@@ -46,6 +48,12 @@ struct AggregatingTransformParams
     Aggregator & aggregator;
     bool final;
 
+    /// Allow AggregatingTransform to stop filling its hash table mid-query and stream per-block
+    /// aggregated data instead when the key cardinality turns out to be close to the number of
+    /// input rows. Only valid for the first stage of two-stage aggregation (final = false),
+    /// the merging stage combines the groups anyway.
+    bool adaptive_passthrough = false;
+
     AggregatingTransformParams(const Block & header, const Aggregator::Params & params_, bool final_)
         : params(params_)
         , aggregator_list_ptr(std::make_shared<AggregatorList>())
@@ -188,6 +196,12 @@ private:
      */
     bool no_more_keys = false;
 
+    /// Set when params->adaptive_passthrough decided that building the shared hash table
+    /// does not pay off. From then on every block is aggregated alone and immediately
+    /// emitted in the same mergeable-state format (see consume()).
+    bool is_passthrough = false;
+    std::deque<Chunk> passthrough_chunks;
+
     ManyAggregatedDataPtr many_data;
     AggregatedDataVariants & variants;
     size_t max_threads = 1;
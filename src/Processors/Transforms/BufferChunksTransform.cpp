@@ -0,0 +1,68 @@
+#include <Processors/Transforms/BufferChunksTransform.h>
+
+namespace DB
+{
+
+BufferChunksTransform::BufferChunksTransform(const Block & header_, size_t max_bytes_to_buffer_)
+    : IProcessor({header_}, {header_})
+    , input(inputs.front())
+    , output(outputs.front())
+    , max_bytes_to_buffer(max_bytes_to_buffer_)
+{
+}
+
+IProcessor::Status BufferChunksTransform::prepare()
+{
+    if (output.isFinished())
+    {
+        chunks = {};
+        input.close();
+        return Status::Finished;
+    }
+
+    if (output.canPush())
+    {
+        input.setNeeded();
+
+        if (!chunks.empty())
+        {
+            auto chunk = std::move(chunks.front());
+            chunks.pop();
+
+            num_buffered_bytes -= chunk.bytes();
+            output.push(std::move(chunk));
+            return Status::PortFull;
+        }
+
+        if (input.hasData())
+        {
+            output.push(input.pull());
+            return Status::PortFull;
+        }
+    }
+    else if (input.hasData() && num_buffered_bytes < max_bytes_to_buffer)
+    {
+        auto chunk = input.pull();
+        num_buffered_bytes += chunk.bytes();
+        chunks.push(std::move(chunk));
+    }
+
+    if (input.isFinished())
+    {
+        if (!chunks.empty())
+            return Status::PortFull;
+
+        output.finish();
+        return Status::Finished;
+    }
+
+    if (num_buffered_bytes < max_bytes_to_buffer)
+    {
+        input.setNeeded();
+        return Status::NeedData;
+    }
+
+    return Status::PortFull;
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Processors/IProcessor.h>
+#include <queue>
+
+namespace DB
+{
+
+/// Transform that buffers incoming chunks up to the limit in bytes while its
+/// output port is not ready to accept data. It lets the upstream part of the
+/// pipeline run ahead of a temporarily blocked consumer.
+///
+/// It is used to overlap building of sets for IN / GLOBAL JOIN with the main
+/// query pipeline: the main output ports are delayed until every set is built
+/// (see QueryPipelineBuilder::addPipelineBefore), and without buffering no
+/// processor of the main pipeline can make progress until that moment.
+class BufferChunksTransform : public IProcessor
+{
+public:
+    BufferChunksTransform(const Block & header_, size_t max_bytes_to_buffer_);
+
+    String getName() const override { return "BufferChunks"; }
+    Status prepare() override;
+
+private:
+    InputPort & input;
+    OutputPort & output;
+
+    size_t max_bytes_to_buffer;
+    size_t num_buffered_bytes = 0;
+    std::queue<Chunk> chunks;
+};
+
+}
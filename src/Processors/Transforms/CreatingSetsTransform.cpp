@@ -209,7 +209,10 @@ void CreatingSetsTransform::consume(Chunk chunk)
     if (!done_with_set)
     {
         if (!set_and_key->set->insertFromBlock(block.getColumnsWithTypeAndName()))
+        {
             done_with_set = true;
+            set_limits_exceeded = true;
+        }
     }
 
     if (!done_with_table)
@@ -239,6 +242,11 @@ Chunk CreatingSetsTransform::generate()
             promise_to_build->set_value(set_and_key->set);
             promise_to_build.reset();
         }
+
+        /// A set truncated by size limits must not be shared across queries.
+        if (set_and_key->subquery_set_cache && !set_limits_exceeded)
+            set_and_key->subquery_set_cache->add(
+                set_and_key->subquery_set_cache_key, set_and_key->set, std::move(set_and_key->table_versions));
     }
 
     if (table_out.initialized())
@@ -51,6 +51,7 @@ private:
     std::unique_ptr<PushingPipelineExecutor> executor;
     UInt64 read_rows = 0;
     bool set_from_cache = false;
+    bool set_limits_exceeded = false;
     Stopwatch watch;
 
     bool done_with_set = true;
@@ -1,4 +1,9 @@
 #include <Processors/Transforms/DistinctTransform.h>
+#include <Common/HashTable/Prefetching.h>
+
+#ifdef OS_LINUX
+#    include <unistd.h>
+#endif
 
 namespace DB
 {
@@ -8,6 +13,32 @@ namespace ErrorCodes
     extern const int SET_SIZE_LIMIT_EXCEEDED;
 }
 
+namespace
+{
+
+template <typename HashTable, typename KeyHolder>
+concept HasPrefetchMemberFunc = requires
+{
+    {std::declval<HashTable>().prefetch(std::declval<KeyHolder>())};
+};
+
+/// Same empirical threshold as in Aggregator: prefetching pays off only after
+/// the hash table has outgrown the CPU caches.
+size_t getMinBytesForPrefetch()
+{
+    size_t l2_size = 0;
+
+#if defined(OS_LINUX) && defined(_SC_LEVEL2_CACHE_SIZE)
+    if (auto ret = sysconf(_SC_LEVEL2_CACHE_SIZE); ret != -1)
+        l2_size = ret;
+#endif
+
+    /// 256KB looks like a reasonable default L2 size. 4 is empirical constant.
+    return 4 * std::max<size_t>(l2_size, 256 * 1024);
+}
+
+}
+
 DistinctTransform::DistinctTransform(
     const Block & header_,
     const SizeLimits & set_size_limits_,
@@ -38,6 +69,39 @@ void DistinctTransform::buildFilter(
 {
     typename Method::State state(columns, key_sizes, nullptr);
 
+    using KeyHolder = decltype(state.getKeyHolder(0, std::declval<Arena &>()));
+
+    /// For a high-cardinality DISTINCT the set quickly outgrows the CPU caches and every emplace
+    /// stalls on a memory load. Explicitly prefetch the hash table cells a few rows ahead,
+    /// the same way the Aggregator does for GROUP BY (see Aggregator::executeImplBatch).
+    if constexpr (Method::State::has_cheap_key_calculation && HasPrefetchMemberFunc<decltype(method.data), KeyHolder>)
+    {
+        static const size_t min_bytes_for_prefetch = getMinBytesForPrefetch();
+        if (method.data.getBufferSizeInBytes() > min_bytes_for_prefetch)
+        {
+            /// During processing of row #i we will prefetch the cell for row #(i + prefetch_look_ahead).
+            PrefetchingHelper prefetching;
+            size_t prefetch_look_ahead = PrefetchingHelper::getInitialLookAheadValue();
+
+            for (size_t i = 0; i < rows; ++i)
+            {
+                if (i == PrefetchingHelper::iterationsToMeasure())
+                    prefetch_look_ahead = prefetching.calcPrefetchLookAhead();
+
+                if (i + prefetch_look_ahead < rows)
+                {
+                    auto && key_holder = state.getKeyHolder(i + prefetch_look_ahead, variants.string_pool);
+                    method.data.prefetch(std::move(key_holder));
+                }
+
+                auto emplace_result = state.emplaceKey(method.data, i, variants.string_pool);
+                filter[i] = emplace_result.isInserted();
+            }
+
+            return;
+        }
+    }
+
     for (size_t i = 0; i < rows; ++i)
     {
         auto emplace_result = state.emplaceKey(method.data, i, variants.string_pool);
@@ -102,10 +166,18 @@ void DistinctTransform::transform(Chunk & chunk)
     if (!set_size_limits.check(new_set_size, data.getTotalByteCount(), "DISTINCT", ErrorCodes::SET_SIZE_LIMIT_EXCEEDED))
         return;
 
-    for (auto & column : columns)
-        column = column->filter(filter, -1);
+    /// If every row of the chunk is new, pass the columns through as is instead of copying them through the filter.
+    if (new_set_size - old_set_size == num_rows)
+    {
+        chunk.setColumns(std::move(columns), num_rows);
+    }
+    else
+    {
+        for (auto & column : columns)
+            column = column->filter(filter, -1);
 
-    chunk.setColumns(std::move(columns), new_set_size - old_set_size);
+        chunk.setColumns(std::move(columns), new_set_size - old_set_size);
+    }
 
     /// Stop reading if we already reach the limit
     if (limit_hint && new_set_size >= limit_hint)
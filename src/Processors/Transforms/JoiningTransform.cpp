@@ -92,6 +92,13 @@ IProcessor::Status JoiningTransform::prepare()
 
             return Status::NeedData;
         }
+
+        /// The signal port is finished, so the build side is complete and the probe side is about to start.
+        if (!build_complete_reported)
+        {
+            build_complete_reported = true;
+            join->onBuildComplete();
+        }
     }
 
     if (has_input)
@@ -70,6 +70,8 @@ private:
     bool has_output = false;
     bool stop_reading = false;
     bool process_non_joined = true;
+    /// Whether join->onBuildComplete() was already called from this transform.
+    bool build_complete_reported = false;
 
     JoinPtr join;
     bool on_totals;
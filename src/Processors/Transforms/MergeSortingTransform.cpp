@@ -4,6 +4,7 @@
 #include <Common/ProfileEvents.h>
 #include <Common/formatReadable.h>
 #include <Common/logger_useful.h>
+#include <Common/threadPoolCallbackRunner.h>
 #include <IO/WriteBufferFromFile.h>
 #include <IO/ReadBufferFromFile.h>
 #include <Compression/CompressedReadBuffer.h>
@@ -23,6 +24,13 @@ namespace ProfileEvents
     extern const Event ExternalProcessingUncompressedBytesTotal;
 }
 
+namespace CurrentMetrics
+{
+    extern const Metric ExternalSortReadAheadThreads;
+    extern const Metric ExternalSortReadAheadThreadsActive;
+    extern const Metric ExternalSortReadAheadThreadsScheduled;
+}
+
 
 namespace DB
 {
@@ -39,6 +47,13 @@ public:
         ProfileEvents::increment(ProfileEvents::ExternalSortWritePart);
     }
 
+    ~BufferingToFileTransform() override
+    {
+        /// Could be cancelled with a read-ahead still in flight.
+        if (read_ahead_block.valid())
+            read_ahead_block.wait();
+    }
+
     String getName() const override { return "BufferingToFileTransform"; }
 
     void consume(Chunk chunk) override
@@ -60,12 +75,31 @@ public:
 
             LOG_INFO(log, "Done writing part of data into temporary file {}, compressed {}, uncompressed {} ",
                 tmp_stream.getPath(), ReadableSize(static_cast<double>(stat.compressed_size)), ReadableSize(static_cast<double>(stat.uncompressed_size)));
+
+            /// During the final merge the next block of this stream is requested only after the merge
+            /// has consumed the previous one, so decompression of the spilled run would sit on the
+            /// critical path of the merge. Read one block ahead in a background thread instead.
+            read_pool = std::make_unique<ThreadPool>(
+                CurrentMetrics::ExternalSortReadAheadThreads,
+                CurrentMetrics::ExternalSortReadAheadThreadsActive,
+                CurrentMetrics::ExternalSortReadAheadThreadsScheduled,
+                1);
+            read_runner = threadPoolCallbackRunnerUnsafe<Block>(*read_pool, "ExtSortReadAhd");
         }
 
-        Block block = tmp_stream.read();
+        Block block;
+        if (read_ahead_block.valid())
+            block = read_ahead_block.get();
+        else
+            block = tmp_stream.read();
+
         if (!block)
             return {};
 
+        /// TemporaryFileStream is not thread-safe, so at most one read is in flight;
+        /// the next generate() waits for it before scheduling another one.
+        read_ahead_block = read_runner([this] { return tmp_stream.read(); }, Priority{});
+
         UInt64 num_rows = block.rows();
         return Chunk(block.getColumns(), num_rows);
     }
@@ -74,6 +108,10 @@ private:
     TemporaryFileStream & tmp_stream;
 
     LoggerPtr log;
+
+    std::unique_ptr<ThreadPool> read_pool;
+    ThreadPoolCallbackRunnerUnsafe<Block> read_runner;
+    std::future<Block> read_ahead_block;
 };
 
 MergeSortingTransform::MergeSortingTransform(
@@ -96,6 +134,10 @@ MergeSortingTransform::MergeSortingTransform(
     , min_free_disk_space(min_free_disk_space_)
     , max_block_bytes(max_block_bytes_)
 {
+    /// Writing sorted blocks to disk is cheap to undo (one extra merge input),
+    /// so sorts are the preferred spill victims.
+    if (tmp_data)
+        spill_participant = SpillManager::instance().enroll(/* priority */ 1);
 }
 
 Processors MergeSortingTransform::expandPipeline()
@@ -150,6 +192,9 @@ void MergeSortingTransform::consume(Chunk chunk)
     sum_bytes_in_blocks += chunk.allocatedBytes();
     chunks.push_back(std::move(chunk));
 
+    if (spill_participant)
+        spill_participant->setReclaimableBytes(sum_bytes_in_blocks);
+
     /** If significant amount of data was accumulated, perform preliminary merging step.
       */
     if (chunks.size() > 1
@@ -164,9 +209,11 @@ void MergeSortingTransform::consume(Chunk chunk)
 
     /** If too many of them and if external sorting is enabled,
       *  will merge blocks that we have in memory at this moment and write merged stream to temporary (compressed) file.
+      * The server-wide spill manager may also pick this sort as a victim under memory pressure.
       * NOTE. It's possible to check free space in filesystem.
       */
-    if (max_bytes_before_external_sort && sum_bytes_in_blocks > max_bytes_before_external_sort)
+    if ((max_bytes_before_external_sort && sum_bytes_in_blocks > max_bytes_before_external_sort)
+        || (spill_participant && spill_participant->shouldSpill()))
     {
         /// If there's less free disk space than reserve_size, an exception will be thrown
         size_t reserve_size = sum_bytes_in_blocks + min_free_disk_space;
@@ -209,6 +256,9 @@ void MergeSortingTransform::consume(Chunk chunk)
         stage = Stage::Serialize;
         sum_bytes_in_blocks = 0;
         sum_rows_in_blocks = 0;
+
+        if (spill_participant)
+            spill_participant->setReclaimableBytes(0);
     }
 }
 
@@ -2,6 +2,7 @@
 
 #include <Processors/Transforms/SortingTransform.h>
 #include <Core/SortDescription.h>
+#include <Common/SpillManager.h>
 #include <Common/filesystemHelpers.h>
 #include <Disks/TemporaryFileOnDisk.h>
 #include <Interpreters/TemporaryDataOnDisk.h>
@@ -52,6 +53,10 @@ private:
     size_t sum_rows_in_blocks = 0;
     size_t sum_bytes_in_blocks = 0;
 
+    /// Lets the server-wide spill manager pick this sort as a spill victim
+    /// under memory pressure. Only set when external sorting is possible.
+    SpillManager::ParticipantPtr spill_participant;
+
     LoggerPtr log = getLogger("MergeSortingTransform");
 
     /// If remerge doesn't save memory at least several times, mark it as useless and don't do it anymore.
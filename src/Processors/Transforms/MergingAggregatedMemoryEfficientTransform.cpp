@@ -363,6 +363,17 @@ void MergingAggregatedBucketTransform::transform(Chunk & chunk)
     res_info->chunk_num = chunks_to_merge->chunk_num;
     chunk.setChunkInfo(std::move(res_info));
 
+    /// A bucket fed by a single stream needs no merging when the states are not finalized here:
+    /// the keys inside one aggregated block are already distinct, so rebuilding the hash table
+    /// would reproduce the same rows.
+    if (!params->final && blocks_list.size() == 1 && required_sort_description.empty())
+    {
+        auto & single_block = blocks_list.front();
+        size_t num_rows = single_block.rows();
+        chunk.setColumns(single_block.getColumns(), num_rows);
+        return;
+    }
+
     auto block = params->aggregator.mergeBlocks(blocks_list, params->final, is_cancelled);
 
     if (!required_sort_description.empty())
@@ -84,10 +84,11 @@ bool compareWithThreshold(const ColumnRawPtrs & raw_block_columns, size_t min_bl
 }
 
 PartialSortingTransform::PartialSortingTransform(
-    const Block & header_, const SortDescription & description_, UInt64 limit_)
+    const Block & header_, const SortDescription & description_, UInt64 limit_, SortThresholdSlotPtr external_threshold_slot_)
     : ISimpleTransform(header_, header_, false)
     , description(description_)
     , limit(limit_)
+    , external_threshold_slot(std::move(external_threshold_slot_))
 {
     // Sorting by no columns doesn't make sense.
     assert(!description_.empty());
@@ -96,8 +97,45 @@ PartialSortingTransform::PartialSortingTransform(
         description_with_positions.emplace_back(column_sort_desc, header_.getPositionByName(column_sort_desc.column_name));
 }
 
+void PartialSortingTransform::applyExternalThreshold(const Block & threshold_row)
+{
+    if (threshold_row.rows() != 1)
+        return;
+
+    const auto & header = getInputPort().getHeader();
+
+    Columns external_columns;
+    external_columns.reserve(description.size());
+    for (size_t i = 0; i < description.size(); ++i)
+    {
+        const auto * column = threshold_row.findByName(description[i].column_name);
+        /// The threshold was computed by the initiator of a distributed query. If its
+        /// stream structure somehow diverged from ours, ignore the threshold: it only
+        /// exists to discard rows early, correctness does not depend on it.
+        if (!column || !column->type->equals(*header.getByPosition(description_with_positions[i].column_number).type))
+            return;
+
+        external_columns.push_back(column->column->convertToFullColumnIfConst()->convertToFullColumnIfSparse());
+    }
+
+    ColumnRawPtrs external_raw_columns(external_columns.size());
+    for (size_t i = 0; i < external_columns.size(); ++i)
+        external_raw_columns[i] = external_columns[i].get();
+
+    /// Use the external threshold only if it is stricter than the one collected locally.
+    if (sort_description_threshold_columns.empty()
+        || compareWithThreshold(external_raw_columns, 0, sort_description_threshold_columns, description))
+        sort_description_threshold_columns = std::move(external_columns);
+}
+
 void PartialSortingTransform::transform(Chunk & chunk)
 {
+    if (external_threshold_slot)
+    {
+        if (Block threshold_row = external_threshold_slot->get(external_threshold_version))
+            applyExternalThreshold(threshold_row);
+    }
+
     if (chunk.getNumRows())
     {
         // The following code works with Blocks and will lose the number of
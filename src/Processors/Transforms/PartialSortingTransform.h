@@ -2,6 +2,7 @@
 #include <Processors/ISimpleTransform.h>
 #include <Processors/RowsBeforeLimitCounter.h>
 #include <Core/SortDescription.h>
+#include <QueryPipeline/SortThresholdExchange.h>
 #include <Common/PODArray.h>
 
 namespace DB
@@ -13,10 +14,13 @@ class PartialSortingTransform : public ISimpleTransform
 {
 public:
     /// limit - if not 0, then you can sort each block not completely, but only `limit` first rows by order.
+    /// external_threshold_slot - if set, rows greater than the threshold the initiator
+    /// of a distributed query pushed into the slot are discarded as well.
     PartialSortingTransform(
         const Block & header_,
         const SortDescription & description_,
-        UInt64 limit_ = 0);
+        UInt64 limit_ = 0,
+        SortThresholdSlotPtr external_threshold_slot_ = nullptr);
 
     String getName() const override { return "PartialSortingTransform"; }
 
@@ -33,6 +37,12 @@ private:
 
     Columns sort_description_threshold_columns;
 
+    /// Merge the threshold row from the slot into sort_description_threshold_columns.
+    void applyExternalThreshold(const Block & threshold_row);
+
+    SortThresholdSlotPtr external_threshold_slot;
+    UInt64 external_threshold_version = 0;
+
     /// This are just buffers which reserve memory to reduce the number of allocations.
     PaddedPODArray<UInt64> rows_to_compare;
     PaddedPODArray<Int8> compare_results;
@@ -284,12 +284,14 @@ else \
 WindowTransform::WindowTransform(const Block & input_header_,
         const Block & output_header_,
         const WindowDescription & window_description_,
-        const std::vector<WindowFunctionDescription> & functions)
+        const std::vector<WindowFunctionDescription> & functions,
+        bool sliding_aggregation_enabled_)
     : IProcessor({input_header_}, {output_header_})
     , input(inputs.front())
     , output(outputs.front())
     , input_header(input_header_)
     , window_description(window_description_)
+    , sliding_aggregation_enabled(sliding_aggregation_enabled_)
 {
     // Materialize all columns in header, because we materialize all columns
     // in chunks and it's convenient if they match.
@@ -338,6 +340,11 @@ WindowTransform::WindowTransform(const Block & input_header_,
             aggregate_function->alignOfData());
         aggregate_function->create(workspace.aggregate_function_state.data());
 
+        if (sliding_aggregation_enabled && !workspace.window_function_impl)
+            workspace.sliding_scratch_state.reset(
+                aggregate_function->sizeOfData(),
+                aggregate_function->alignOfData());
+
         workspaces.push_back(std::move(workspace));
     }
 
@@ -406,6 +413,8 @@ WindowTransform::WindowTransform(const Block & input_header_,
 
 WindowTransform::~WindowTransform()
 {
+    deactivateSlidingAggregation();
+
     // Some states may be not created yet if the creation failed.
     for (auto & ws : workspaces)
     {
@@ -957,46 +966,76 @@ void WindowTransform::updateAggregationState()
     assert(partition_start <= frame_start);
     assert(frame_end <= partition_end);
 
-    // We might have to reset aggregation state and/or add some rows to it.
-    // Figure out what to do.
-    bool reset_aggregation = false;
-    RowNumber rows_to_add_start;
-    RowNumber rows_to_add_end;
+    // Once the sliding aggregation is active, it does all the bookkeeping.
+    if (sliding_aggregation_active)
+    {
+        updateAggregationStateSliding();
+        return;
+    }
+
     if (frame_start == prev_frame_start)
     {
         // The frame start didn't change, add the tail rows.
-        reset_aggregation = false;
-        rows_to_add_start = prev_frame_end;
-        rows_to_add_end = frame_end;
+        addRangeToAggregateStates(prev_frame_end, frame_end);
+        return;
     }
-    else
+
+    if (sliding_aggregation_enabled
+        && rowsBetween(frame_start, frame_end) >= sliding_aggregation_min_frame_rows)
     {
-        // The frame start changed, reset the state and aggregate over the
-        // entire frame. This can be made per-function after we learn to
-        // subtract rows from some types of aggregation states, but for now we
-        // always have to reset when the frame start changes.
-        reset_aggregation = true;
-        rows_to_add_start = frame_start;
-        rows_to_add_end = frame_end;
+        // The frame is large enough for the two-stack sliding aggregation.
+        // Start with an empty front and an empty back at the frame start,
+        // the sliding update below aggregates the whole frame into the back.
+        sliding_aggregation_active = true;
+        sliding_front_row = frame_start;
+        sliding_front_end = frame_start;
+        sliding_front_count = 0;
+        sliding_front_consumed = 0;
+        sliding_back_end = frame_start;
+
+        for (auto & ws : workspaces)
+        {
+            if (ws.window_function_impl)
+                continue;
+
+            const auto * a = ws.aggregate_function.get();
+            auto * buf = ws.aggregate_function_state.data();
+            a->destroy(buf);
+            a->create(buf);
+        }
+
+        updateAggregationStateSliding();
+        return;
     }
 
+    // Reset the state and aggregate over the entire frame.
     for (auto & ws : workspaces)
     {
         if (ws.window_function_impl)
-        {
-            // No need to do anything for true window functions.
             continue;
-        }
 
         const auto * a = ws.aggregate_function.get();
         auto * buf = ws.aggregate_function_state.data();
+        a->destroy(buf);
+        a->create(buf);
+    }
 
-        if (reset_aggregation)
+    addRangeToAggregateStates(frame_start, frame_end);
+}
+
+void WindowTransform::addRangeToAggregateStates(const RowNumber & rows_to_add_start, const RowNumber & rows_to_add_end)
+{
+    for (auto & ws : workspaces)
+    {
+        if (ws.window_function_impl)
         {
-            a->destroy(buf);
-            a->create(buf);
+            // No need to do anything for true window functions.
+            continue;
         }
 
+        const auto * a = ws.aggregate_function.get();
+        auto * buf = ws.aggregate_function_state.data();
+
         // To achieve better performance, we will have to loop over blocks and
         // rows manually, instead of using advanceRowNumber().
         // For this purpose, the past-the-end block can be different than the
@@ -1038,6 +1077,148 @@ void WindowTransform::updateAggregationState()
     }
 }
 
+size_t WindowTransform::rowsBetween(RowNumber from, const RowNumber & to) const
+{
+    size_t result = 0;
+    while (from < to)
+    {
+        if (from.block == to.block)
+        {
+            result += to.row - from.row;
+            break;
+        }
+
+        result += blockRowsNumber(from) - from.row;
+        ++from.block;
+        from.row = 0;
+    }
+    return result;
+}
+
+static size_t slidingStateStride(const IAggregateFunction & a)
+{
+    const size_t alignment = a.alignOfData();
+    return (a.sizeOfData() + alignment - 1) / alignment * alignment;
+}
+
+static char * slidingFrontState(WindowFunctionWorkspace & ws, size_t index)
+{
+    return ws.sliding_front_states.data() + index * slidingStateStride(*ws.aggregate_function);
+}
+
+// The sliding update keeps the frame as two segments: the "front" is a stack
+// of suffix aggregation states built over some past range of rows, so popping
+// a row from the frame start is just a move to the next state; the "back" is
+// a single state the rows entering the frame are added to. The aggregate over
+// the frame is then merge(front top, back). When the front runs out, the rows
+// remaining in the back are re-aggregated into a new front and the back is
+// emptied. Every row is added once, re-aggregated at most once and merged a
+// constant number of times, so the work per row is amortized constant for any
+// aggregate function, instead of O(frame size) for functions that cannot
+// subtract rows from their state.
+void WindowTransform::updateAggregationStateSliding()
+{
+    // Pop the front states for the rows that left the frame.
+    while (sliding_front_consumed < sliding_front_count && sliding_front_row < frame_start)
+    {
+        for (auto & ws : workspaces)
+        {
+            if (!ws.window_function_impl)
+                ws.aggregate_function->destroy(slidingFrontState(ws, sliding_front_consumed));
+        }
+
+        ++sliding_front_consumed;
+        advanceRowNumber(sliding_front_row);
+    }
+
+    // If the frame start cut into the back, rebuild the front from the back
+    // rows that are still inside the frame, and empty the back.
+    if (sliding_front_end < frame_start)
+    {
+        const auto flip_begin = frame_start;
+        const auto flip_end = std::max(sliding_back_end, frame_start);
+        const size_t count = rowsBetween(flip_begin, flip_end);
+
+        for (auto & ws : workspaces)
+        {
+            if (ws.window_function_impl)
+                continue;
+
+            const auto * a = ws.aggregate_function.get();
+            const size_t stride = slidingStateStride(*a);
+
+            if (ws.sliding_front_states_capacity < count)
+            {
+                ws.sliding_front_states.reset(count * stride, a->alignOfData());
+                ws.sliding_front_states_capacity = count;
+            }
+
+            // Build the suffix states back to front: the state for a row
+            // aggregates the row itself and then the rows after it, so the
+            // merge order matches the row order.
+            auto * arena_ptr = arena.get();
+            RowNumber row = flip_end;
+            for (size_t i = count; i > 0; --i)
+            {
+                retreatRowNumber(row);
+
+                auto & block = blockAt(row);
+                if (ws.cached_block_number != row.block)
+                {
+                    for (size_t j = 0; j < ws.argument_column_indices.size(); ++j)
+                    {
+                        ws.argument_columns[j] = block.input_columns[
+                            ws.argument_column_indices[j]].get();
+                    }
+                    ws.cached_block_number = row.block;
+                }
+
+                char * state = slidingFrontState(ws, i - 1);
+                a->create(state);
+                a->add(state, ws.argument_columns.data(), row.row, arena_ptr);
+                if (i < count)
+                    a->merge(state, slidingFrontState(ws, i), arena_ptr);
+            }
+
+            auto * buf = ws.aggregate_function_state.data();
+            a->destroy(buf);
+            a->create(buf);
+        }
+
+        sliding_front_row = flip_begin;
+        sliding_front_end = flip_end;
+        sliding_front_count = count;
+        sliding_front_consumed = 0;
+        sliding_back_end = flip_end;
+    }
+
+    // Add the rows that entered the frame to the back.
+    if (sliding_back_end < frame_end)
+    {
+        addRangeToAggregateStates(sliding_back_end, frame_end);
+        sliding_back_end = frame_end;
+    }
+}
+
+void WindowTransform::deactivateSlidingAggregation()
+{
+    if (!sliding_aggregation_active)
+        return;
+
+    for (auto & ws : workspaces)
+    {
+        if (ws.window_function_impl)
+            continue;
+
+        for (size_t i = sliding_front_consumed; i < sliding_front_count; ++i)
+            ws.aggregate_function->destroy(slidingFrontState(ws, i));
+    }
+
+    sliding_front_count = 0;
+    sliding_front_consumed = 0;
+    sliding_aggregation_active = false;
+}
+
 void WindowTransform::writeOutCurrentRow()
 {
     assert(current_row < partition_end);
@@ -1057,6 +1238,29 @@ void WindowTransform::writeOutCurrentRow()
             IColumn * result_column = block.output_columns[wi].get();
             const auto * a = ws.aggregate_function.get();
             auto * buf = ws.aggregate_function_state.data();
+            bool destroy_buf = false;
+
+            if (sliding_aggregation_active)
+            {
+                // The frame aggregate is the front top state followed by the back.
+                const bool has_front = sliding_front_consumed < sliding_front_count;
+                const bool has_back = sliding_front_end < sliding_back_end;
+
+                if (has_front && has_back)
+                {
+                    buf = ws.sliding_scratch_state.data();
+                    a->create(buf);
+                    destroy_buf = true;
+                    a->merge(buf, slidingFrontState(ws, sliding_front_consumed), arena.get());
+                    a->merge(buf, ws.aggregate_function_state.data(), arena.get());
+                }
+                else if (has_front)
+                {
+                    buf = slidingFrontState(ws, sliding_front_consumed);
+                }
+                // Otherwise the back state covers the whole (possibly empty) frame.
+            }
+
             // FIXME does it also allocate the result on the arena?
             // We'll have to pass it out with blocks then...
 
@@ -1070,6 +1274,9 @@ void WindowTransform::writeOutCurrentRow()
             {
                 a->insertResultInto(buf, *result_column, arena.get());
             }
+
+            if (destroy_buf)
+                a->destroy(buf);
         }
     }
 }
@@ -1301,6 +1508,8 @@ void WindowTransform::appendChunk(Chunk & chunk)
 
         // Reinitialize the aggregate function states because the new partition
         // has started.
+        deactivateSlidingAggregation();
+
         for (auto & ws : workspaces)
         {
             if (ws.window_function_impl)
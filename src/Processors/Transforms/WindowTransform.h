@@ -41,6 +41,14 @@ struct WindowFunctionWorkspace
     // Will not be initialized for a pure window function.
     mutable AlignedBuffer aggregate_function_state;
 
+    // Sliding (two-stack) aggregation, see WindowTransform::updateAggregationState.
+    // Memory for the front-stack suffix states: sliding_front_states_capacity
+    // states, each of sizeOfData() rounded up to the alignment.
+    AlignedBuffer sliding_front_states;
+    size_t sliding_front_states_capacity = 0;
+    // Scratch state used to combine the front and the back for one output row.
+    AlignedBuffer sliding_scratch_state;
+
     // Argument columns. Be careful, this is a per-block cache.
     std::vector<const IColumn *> argument_columns;
     UInt64 cached_block_number = std::numeric_limits<UInt64>::max();
@@ -87,7 +95,8 @@ public:
             const Block & output_header_,
             const WindowDescription & window_description_,
             const std::vector<WindowFunctionDescription> &
-                functions);
+                functions,
+            bool sliding_aggregation_enabled_ = false);
 
     ~WindowTransform() override;
 
@@ -124,6 +133,10 @@ public:
     void advanceFrameEndRangeOffset();
 
     void updateAggregationState();
+    void updateAggregationStateSliding();
+    void addRangeToAggregateStates(const RowNumber & rows_to_add_start, const RowNumber & rows_to_add_end);
+    void deactivateSlidingAggregation();
+    size_t rowsBetween(RowNumber from, const RowNumber & to) const;
     void writeOutCurrentRow();
 
     Columns & inputAt(const RowNumber & x)
@@ -336,6 +349,25 @@ public:
     RowNumber prev_frame_start;
     RowNumber prev_frame_end;
 
+    // Two-stack sliding aggregation for frames with a moving start, see
+    // updateAggregationState. The frame is kept as the concatenation of the
+    // "front" (a stack of suffix aggregation states left from the last rebuild)
+    // and the "back" (the regular workspace state the new rows are added to).
+    const bool sliding_aggregation_enabled = false;
+    bool sliding_aggregation_active = false;
+    // The front suffix states that are not yet consumed cover the rows
+    // [sliding_front_row, sliding_front_end); the state at index
+    // sliding_front_consumed aggregates all of them.
+    RowNumber sliding_front_row;
+    RowNumber sliding_front_end;
+    size_t sliding_front_count = 0;
+    size_t sliding_front_consumed = 0;
+    // The back state aggregates the rows [sliding_front_end, sliding_back_end).
+    RowNumber sliding_back_end;
+    // Do not bother with the two stacks for small frames, the plain rebuild is
+    // cheaper there.
+    static constexpr size_t sliding_aggregation_min_frame_rows = 64;
+
     // Comparison function for RANGE OFFSET frames. We choose the appropriate
     // overload once, based on the type of the ORDER BY column. Choosing it for
     // each row would be slow.
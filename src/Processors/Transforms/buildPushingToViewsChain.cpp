@@ -5,6 +5,7 @@
 #include <Interpreters/InterpreterSelectQuery.h>
 #include <Interpreters/InterpreterSelectQueryAnalyzer.h>
 #include <Parsers/ASTInsertQuery.h>
+#include <Processors/Transforms/BufferChunksTransform.h>
 #include <Processors/Transforms/CountingTransform.h>
 #include <Processors/Transforms/SquashingChunksTransform.h>
 #include <Processors/Transforms/ExpressionTransform.h>
@@ -259,6 +260,15 @@ std::optional<Chain> generateViewChain(
     // be no parallel reading after (plus it is not a costless operation)
     select_context->setSetting("parallelize_output_from_storages", Field{false});
 
+    // The expression chains of the inner query are identical on every insert, so compiling them
+    // from the first block pays off: the modules are shared across inserts (and across views with
+    // the same expressions) through the server-wide compiled expression cache.
+    if (insert_settings.compile_expressions_for_materialized_views)
+    {
+        insert_context->setSetting("compile_expressions", Field{true});
+        insert_context->setSetting("min_count_to_compile_expression", UInt64(0));
+    }
+
     // Separate min_insert_block_size_rows/min_insert_block_size_bytes for children
     if (insert_settings.min_insert_block_size_rows_for_materialized_views)
         insert_context->setSetting("min_insert_block_size_rows", insert_settings.min_insert_block_size_rows_for_materialized_views.value);
@@ -540,7 +550,22 @@ Chain buildPushingToViewsChain(
         {
             max_parallel_streams += std::max<size_t>(chain.getNumThreads(), 1);
             result_chain.attachResources(chain.detachResources());
-            connect(*out, chain.getInputPort());
+
+            /// CopyingDataToViewsTransform pushes the next chunk only when every view has consumed
+            /// the previous one, so a single slow view stalls its siblings and the main insert.
+            /// An optional buffer in front of each view pipeline decouples them up to its size.
+            if (settings.materialized_views_buffer_max_bytes)
+            {
+                auto buffer = std::make_shared<BufferChunksTransform>(storage_header, settings.materialized_views_buffer_max_bytes);
+                connect(*out, buffer->getInputs().front());
+                connect(buffer->getOutputs().front(), chain.getInputPort());
+                processors.emplace_back(std::move(buffer));
+            }
+            else
+            {
+                connect(*out, chain.getInputPort());
+            }
+
             connect(chain.getOutputPort(), *in);
             ++in;
             ++out;
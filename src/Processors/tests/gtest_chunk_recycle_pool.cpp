@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <Processors/Chunk.h>
+
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+
+using namespace DB;
+
+namespace
+{
+
+Chunk makeChunk(size_t rows)
+{
+    auto numbers = ColumnUInt64::create();
+    auto strings = ColumnString::create();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        numbers->insertValue(i);
+        strings->insertData("some string payload", 19);
+    }
+
+    Columns columns;
+    columns.emplace_back(std::move(numbers));
+    columns.emplace_back(std::move(strings));
+    return Chunk(std::move(columns), rows);
+}
+
+/// Columns of the same layout as makeChunk() produces, not sharing anything with it.
+Columns makePrototype()
+{
+    Columns columns;
+    columns.emplace_back(ColumnUInt64::create());
+    columns.emplace_back(ColumnString::create());
+    return columns;
+}
+
+/// The pool is a thread-local singleton, so every test leaves it disabled (and thus empty).
+struct PoolGuard
+{
+    PoolGuard() { ChunkRecyclePool::instance().setEnabled(true); }
+    ~PoolGuard() { ChunkRecyclePool::instance().setEnabled(false); }
+};
+
+}
+
+TEST(ChunkRecyclePool, DisabledByDefault)
+{
+    auto & pool = ChunkRecyclePool::instance();
+
+    pool.recycle(makeChunk(100));
+    ASSERT_TRUE(pool.tryGetColumns(makePrototype()).empty());
+}
+
+TEST(ChunkRecyclePool, RoundtripKeepsBuffers)
+{
+    PoolGuard guard;
+    auto & pool = ChunkRecyclePool::instance();
+
+    pool.recycle(makeChunk(100));
+    auto recycled = pool.tryGetColumns(makePrototype());
+
+    ASSERT_EQ(recycled.size(), 2);
+    ASSERT_EQ(recycled[0]->size(), 0);
+    ASSERT_EQ(recycled[1]->size(), 0);
+    /// The point of the pool: the emptied columns keep their allocations.
+    ASSERT_GT(recycled[0]->allocatedBytes(), 0);
+    ASSERT_GT(recycled[1]->allocatedBytes(), 0);
+
+    /// The entry is handed out only once.
+    ASSERT_TRUE(pool.tryGetColumns(makePrototype()).empty());
+}
+
+TEST(ChunkRecyclePool, TypeMismatchIsNotReused)
+{
+    PoolGuard guard;
+    auto & pool = ChunkRecyclePool::instance();
+
+    pool.recycle(makeChunk(100));
+
+    Columns other_prototype;
+    other_prototype.emplace_back(ColumnUInt64::create());
+    other_prototype.emplace_back(ColumnUInt32::create());
+    ASSERT_TRUE(pool.tryGetColumns(other_prototype).empty());
+}
+
+TEST(ChunkRecyclePool, SharedColumnsAreNotPooled)
+{
+    PoolGuard guard;
+    auto & pool = ChunkRecyclePool::instance();
+
+    auto chunk = makeChunk(100);
+    ColumnPtr shared = chunk.getColumns()[0];
+
+    pool.recycle(std::move(chunk));
+    ASSERT_TRUE(pool.tryGetColumns(makePrototype()).empty());
+}
+
+TEST(ChunkRecyclePool, OversizedEntryIsNotPooled)
+{
+    PoolGuard guard;
+    auto & pool = ChunkRecyclePool::instance();
+
+    /// More than the 16 MiB per-entry cap worth of string data.
+    auto numbers = ColumnUInt64::create();
+    auto strings = ColumnString::create();
+    String payload(1024, 'x');
+    for (size_t i = 0; i < 20 * 1024; ++i)
+    {
+        numbers->insertValue(i);
+        strings->insertData(payload.data(), payload.size());
+    }
+    size_t rows = numbers->size();
+
+    Columns columns;
+    columns.emplace_back(std::move(numbers));
+    columns.emplace_back(std::move(strings));
+
+    pool.recycle(Chunk(std::move(columns), rows));
+    ASSERT_TRUE(pool.tryGetColumns(makePrototype()).empty());
+}
+
+TEST(ChunkRecyclePool, DisablingPurges)
+{
+    auto & pool = ChunkRecyclePool::instance();
+    pool.setEnabled(true);
+    pool.recycle(makeChunk(100));
+
+    pool.setEnabled(false);
+    pool.setEnabled(true);
+    ASSERT_TRUE(pool.tryGetColumns(makePrototype()).empty());
+    pool.setEnabled(false);
+}
@@ -573,7 +573,18 @@ RemoteQueryExecutor::ReadResult RemoteQueryExecutor::processPacket(Packet packet
             /// We can actually return it, and the first call to RemoteQueryExecutor::read
             /// will return earlier. We should consider doing it.
             if (packet.block && (packet.block.rows() > 0))
+            {
+                /// Blocks that are drained on finish()/cancel() never get here
+                /// and are never decompressed (see remote_exchange_lazy_decompression).
+                decompressBlockColumns(packet.block);
+
+                if (sort_threshold_exchange)
+                {
+                    sort_threshold_exchange->add(packet.block);
+                    sendSortThresholdIfUpdated();
+                }
                 return ReadResult(adaptBlockStructure(packet.block, header));
+            }
             break;  /// If the block is empty - we will receive other packets before EndOfStream.
 
         case Protocol::Server::Exception:
@@ -660,6 +671,18 @@ bool RemoteQueryExecutor::setPartUUIDs(const std::vector<UUID> & uuids)
     return true;
 }
 
+void RemoteQueryExecutor::sendSortThresholdIfUpdated()
+{
+    UInt64 version = sent_sort_threshold_version;
+    Block threshold = sort_threshold_exchange->getThreshold(version);
+
+    if (!threshold || version == sent_sort_threshold_version)
+        return;
+
+    sent_sort_threshold_version = version;
+    connections->sendSortThreshold(threshold);
+}
+
 void RemoteQueryExecutor::processReadTaskRequest()
 {
     if (!extension || !extension->task_iterator)
@@ -5,6 +5,7 @@
 #include <Client/ConnectionPool.h>
 #include <Client/IConnections.h>
 #include <Client/ConnectionPoolWithFailover.h>
+#include <QueryPipeline/SortThresholdExchange.h>
 #include <Storages/IStorage_fwd.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/StorageID.h>
@@ -212,6 +213,10 @@ public:
 
     void setMainTable(StorageID main_table_) { main_table = std::move(main_table_); }
 
+    /// Set the exchange shared by the executors of one distributed ORDER BY ... LIMIT query.
+    /// Received blocks are accounted in it and updated thresholds are pushed to the replicas.
+    void setSortThresholdExchange(SortThresholdExchangePtr exchange) { sort_threshold_exchange = std::move(exchange); }
+
     void setLogger(LoggerPtr logger) { log = logger; }
 
     const Block & getHeader() const { return header; }
@@ -268,6 +273,10 @@ private:
     std::vector<ExternalTablesData> external_tables_data;
     std::mutex external_tables_mutex;
 
+    /// See setSortThresholdExchange().
+    SortThresholdExchangePtr sort_threshold_exchange;
+    UInt64 sent_sort_threshold_version = 0;
+
     /// Connections to replicas are established, but no queries are sent yet
     bool established = false;
 
@@ -345,6 +354,10 @@ private:
     /// Process packet for read and return data block if possible.
     ReadResult processPacket(Packet packet);
 
+    /// Push the current sort key threshold to the replicas if it changed
+    /// since it was sent the last time.
+    void sendSortThresholdIfUpdated();
+
     /// Reads packet by packet
     Block readPackets();
 };
@@ -0,0 +1,127 @@
+#include <QueryPipeline/SortThresholdExchange.h>
+
+#include <Interpreters/sortBlock.h>
+
+namespace DB
+{
+
+SortThresholdExchange::SortThresholdExchange(SortDescription description_, size_t limit_)
+    : description(std::move(description_))
+    , limit(limit_)
+{
+}
+
+void SortThresholdExchange::add(const Block & block)
+{
+    if (!block.rows())
+        return;
+
+    std::lock_guard lock(mutex);
+
+    if (disabled)
+        return;
+
+    /// Keep only the sort key columns.
+    Block key_columns;
+    for (const auto & column_description : description)
+    {
+        const auto * column = block.findByName(column_description.column_name);
+        if (!column)
+        {
+            /// The shard stream does not carry the sort key, so no threshold can be computed.
+            disabled = true;
+            buffer.clear();
+            return;
+        }
+        key_columns.insert({column->column->convertToFullColumnIfConst(), column->type, column->name});
+    }
+
+    if (!buffer)
+    {
+        buffer = std::move(key_columns);
+    }
+    else
+    {
+        MutableColumns mutable_columns = buffer.mutateColumns();
+        for (size_t i = 0; i < mutable_columns.size(); ++i)
+            mutable_columns[i]->insertRangeFrom(*key_columns.getByPosition(i).column, 0, key_columns.rows());
+        buffer.setColumns(std::move(mutable_columns));
+    }
+
+    /// Cut the buffer down to the top `limit` rows once it has grown enough, so that
+    /// the cost of sorting is amortized over the appended rows.
+    if (buffer.rows() >= limit && (!threshold_row || buffer.rows() >= 2 * limit))
+        compact();
+}
+
+void SortThresholdExchange::compact()
+{
+    sortBlock(buffer, description, limit);
+
+    if (buffer.rows() > limit)
+    {
+        for (auto & column : buffer)
+            column.column = column.column->cut(0, limit);
+    }
+
+    /// The k-th smallest key seen so far is the last row of the buffer.
+    size_t threshold_index = buffer.rows() - 1;
+
+    bool changed = !threshold_row;
+    if (!changed)
+    {
+        for (size_t i = 0; i < buffer.columns(); ++i)
+        {
+            if (0 != buffer.getByPosition(i).column->compareAt(
+                threshold_index, 0, *threshold_row.getByPosition(i).column, description[i].nulls_direction))
+            {
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    if (!changed)
+        return;
+
+    Block new_threshold_row = buffer.cloneEmpty();
+    MutableColumns threshold_columns = new_threshold_row.mutateColumns();
+    for (size_t i = 0; i < threshold_columns.size(); ++i)
+        threshold_columns[i]->insertFrom(*buffer.getByPosition(i).column, threshold_index);
+    new_threshold_row.setColumns(std::move(threshold_columns));
+
+    threshold_row = std::move(new_threshold_row);
+    ++threshold_version;
+}
+
+Block SortThresholdExchange::getThreshold(UInt64 & version) const
+{
+    std::lock_guard lock(mutex);
+
+    if (disabled || !threshold_row)
+        return {};
+
+    version = threshold_version;
+    return threshold_row;
+}
+
+
+void SortThresholdSlot::set(Block threshold_row_)
+{
+    std::lock_guard lock(mutex);
+    threshold_row = std::move(threshold_row_);
+    version.fetch_add(1, std::memory_order_release);
+}
+
+Block SortThresholdSlot::get(UInt64 & last_seen_version) const
+{
+    UInt64 current_version = version.load(std::memory_order_acquire);
+    if (current_version == last_seen_version)
+        return {};
+
+    std::lock_guard lock(mutex);
+    last_seen_version = current_version;
+    return threshold_row;
+}
+
+}
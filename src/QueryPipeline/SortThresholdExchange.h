@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Core/Block.h>
+#include <Core/SortDescription.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace DB
+{
+
+/** Cooperative top-K for distributed ORDER BY ... LIMIT queries
+  * (see the distributed_sort_threshold_exchange setting).
+  *
+  * Initiator side. Shared between the RemoteQueryExecutors of one distributed query.
+  * Collects the sort key columns of every block received from the shards and maintains
+  * the k-th smallest key seen so far among all of them. Every row with a greater key
+  * cannot be a part of the result, so the threshold is pushed back to the shards
+  * (Protocol::Client::SortThreshold), where it tightens the filter
+  * of PartialSortingTransform.
+  *
+  * The threshold is only an upper bound on the k-th key of the final result: it is
+  * computed from rows that have already reached the initiator, so filtering by it
+  * on the shards can never drop a row the initiator still needs.
+  */
+class SortThresholdExchange
+{
+public:
+    SortThresholdExchange(SortDescription description_, size_t limit_);
+
+    /// Account a block received from a shard. If the block does not contain
+    /// all the sort key columns, the exchange disables itself.
+    void add(const Block & block);
+
+    /// Returns a single row block with the current k-th key and updates `version`,
+    /// or an empty block if fewer than `limit` rows have been seen so far.
+    /// The version allows callers to send each threshold at most once.
+    Block getThreshold(UInt64 & version) const;
+
+private:
+    void compact();
+
+    const SortDescription description;
+    const size_t limit;
+
+    mutable std::mutex mutex;
+    bool disabled = false;
+    /// Sort key columns of the accounted rows, periodically cut down to the top `limit`.
+    Block buffer;
+    Block threshold_row;
+    UInt64 threshold_version = 0;
+};
+
+using SortThresholdExchangePtr = std::shared_ptr<SortThresholdExchange>;
+
+
+/** Shard side. The latest threshold row pushed by the initiator, polled by
+  * PartialSortingTransform between chunks. Created per query by TCPHandler
+  * and passed to the sorting transforms through the query context.
+  */
+class SortThresholdSlot
+{
+public:
+    void set(Block threshold_row_);
+
+    /// Returns the threshold row if its version differs from `last_seen_version`
+    /// (and updates the latter), an empty block otherwise.
+    Block get(UInt64 & last_seen_version) const;
+
+private:
+    mutable std::mutex mutex;
+    Block threshold_row;
+    std::atomic<UInt64> version{0};
+};
+
+using SortThresholdSlotPtr = std::shared_ptr<SortThresholdSlot>;
+
+}
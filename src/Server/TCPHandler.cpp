@@ -21,12 +21,14 @@
 #include <Compression/CompressedWriteBuffer.h>
 #include <IO/ReadBufferFromPocoSocket.h>
 #include <IO/WriteBufferFromPocoSocket.h>
+#include <IO/WriteBufferFromString.h>
 #include <IO/LimitReadBuffer.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteHelpers.h>
 #include <Formats/NativeReader.h>
 #include <Formats/NativeWriter.h>
 #include <Interpreters/executeQuery.h>
+#include <Interpreters/ExternalTablesDedupCache.h>
 #include <Interpreters/TablesStatus.h>
 #include <Interpreters/InternalTextLogsQueue.h>
 #include <Interpreters/OpenTelemetrySpanLog.h>
@@ -419,6 +421,11 @@ void TCPHandler::runImpl()
             if (!is_interserver_mode)
                 session->checkIfUserIsStillValid();
 
+            /// The initiator of a distributed ORDER BY ... LIMIT query may push sort key
+            /// thresholds during execution (see Protocol::Client::SortThreshold).
+            state.sort_threshold_slot = std::make_shared<SortThresholdSlot>();
+            query_context->setSortThresholdSlot(state.sort_threshold_slot);
+
             query_context->setExternalTablesInitializer([this] (ContextPtr context)
             {
                 if (context != query_context)
@@ -1635,6 +1642,20 @@ bool TCPHandler::receivePacket()
                 receiveUnexpectedData(true);
             return receiveData(packet_type == Protocol::Client::Scalar);
 
+        case Protocol::Client::ExternalTablesHashes:
+            if (state.empty())
+                throw NetException(ErrorCodes::UNEXPECTED_PACKET_FROM_CLIENT,
+                    "Unexpected packet ExternalTablesHashes received from client");
+            receiveExternalTablesHashes();
+            return true;
+
+        case Protocol::Client::SortThreshold:
+            if (state.empty())
+                throw NetException(ErrorCodes::UNEXPECTED_PACKET_FROM_CLIENT,
+                    "Unexpected packet SortThreshold received from client");
+            receiveSortThreshold();
+            return false;
+
         case Protocol::Client::Ping:
             writeVarUInt(Protocol::Server::Pong, *out);
             out->next();
@@ -1948,6 +1969,65 @@ void TCPHandler::receiveUnexpectedQuery()
     throw NetException(ErrorCodes::UNEXPECTED_PACKET_FROM_CLIENT, "Unexpected packet Query received from client");
 }
 
+void TCPHandler::receiveExternalTablesHashes()
+{
+    size_t count = 0;
+    readVarUInt(count, *in);
+
+    std::vector<String> tables_to_send;
+    auto cache = query_context->getExternalTablesDedupCache();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        String table_name;
+        UInt128 hash;
+        readStringBinary(table_name, *in);
+        readPODBinary(hash, *in);
+
+        auto cached_blocks = cache->get(hash);
+        if (!cached_blocks)
+        {
+            /// Remember the hash to store the table into the cache when it is received.
+            state.external_table_hashes_to_store[table_name] = hash;
+            tables_to_send.push_back(table_name);
+            continue;
+        }
+
+        /// The table is already here: fill the temporary table from the cache, skipping the transfer.
+        NamesAndTypesList columns = cached_blocks->front().getNamesAndTypesList();
+        auto temporary_table = TemporaryTableHolder(query_context, ColumnsDescription{columns}, {});
+        StoragePtr storage = temporary_table.getTable();
+        query_context->addExternalTable(table_name, std::move(temporary_table));
+        auto metadata_snapshot = storage->getInMemoryMetadataPtr();
+
+        QueryPipeline temporary_table_out(storage->write(ASTPtr(), metadata_snapshot, query_context, /*async_insert=*/false));
+        PushingPipelineExecutor executor(temporary_table_out);
+        executor.start();
+        for (const auto & cached_block : *cached_blocks)
+            if (cached_block.rows())
+                executor.push(cached_block);
+        executor.finish();
+    }
+
+    writeVarUInt(Protocol::Server::ExternalTablesRequest, *out);
+    writeVarUInt(tables_to_send.size(), *out);
+    for (const auto & table_name : tables_to_send)
+        writeStringBinary(table_name, *out);
+    out->next();
+}
+
+
+void TCPHandler::receiveSortThreshold()
+{
+    /// The threshold is a single uncompressed row, see Connection::sendSortThreshold().
+    NativeReader reader(*in, client_tcp_protocol_version);
+    Block threshold_row = reader.read();
+
+    if (threshold_row && state.sort_threshold_slot)
+        state.sort_threshold_slot->set(std::move(threshold_row));
+}
+
+
 bool TCPHandler::receiveData(bool scalar)
 {
     initBlockInput();
@@ -1961,6 +2041,21 @@ bool TCPHandler::receiveData(bool scalar)
 
     if (!block)
     {
+        /// End of the data transfer: put the external tables the client was asked
+        /// to send into the dedup cache, so the following queries can skip them.
+        if (!state.external_table_hashes_to_store.empty())
+        {
+            auto cache = query_context->getExternalTablesDedupCache();
+            for (const auto & [table_name, hash] : state.external_table_hashes_to_store)
+            {
+                auto it = state.external_table_blocks_to_store.find(table_name);
+                if (it != state.external_table_blocks_to_store.end())
+                    cache->set(hash, std::make_shared<Blocks>(std::move(it->second)));
+            }
+            state.external_table_hashes_to_store.clear();
+            state.external_table_blocks_to_store.clear();
+        }
+
         state.read_all_data = true;
         return false;
     }
@@ -1995,6 +2090,10 @@ bool TCPHandler::receiveData(bool scalar)
         executor.start();
         executor.push(block);
         executor.finish();
+
+        /// The table was announced with a content hash: accumulate its blocks for the dedup cache.
+        if (state.external_table_hashes_to_store.contains(temporary_id.table_name))
+            state.external_table_blocks_to_store[temporary_id.table_name].push_back(block);
     }
     else if (state.need_receive_data_for_input)
     {
@@ -2075,13 +2174,37 @@ void TCPHandler::initBlockOutput(const Block & block)
             {
                 CompressionCodecFactory::instance().validateCodec(method, level, !query_settings.allow_suspicious_codecs, query_settings.allow_experimental_codecs, query_settings.enable_deflate_qpl_codec, query_settings.enable_zstd_qat_codec);
 
-                state.maybe_compressed_out = std::make_shared<CompressedWriteBuffer>(
-                    *out, CompressionCodecFactory::instance().get(method, level));
+                auto codec = CompressionCodecFactory::instance().get(method, level);
+                auto compressed_out = std::make_shared<CompressedWriteBuffer>(*out, codec);
+                /// Older clients don't expect the codec to change between frames.
+                if (query_settings.network_compression_adaptive
+                    && client_tcp_protocol_version >= DBMS_MIN_REVISION_WITH_ADAPTIVE_NETWORK_COMPRESSION)
+                {
+                    state.compressed_out = compressed_out.get();
+                    state.configured_network_codec = codec;
+                }
+                state.maybe_compressed_out = std::move(compressed_out);
             }
             else
                 state.maybe_compressed_out = out;
         }
 
+        /// Per-column compressed chunks that the client decompresses lazily. Totals and
+        /// extremes are small and keep the regular format (see Connection::receivePacket()).
+        if (query_settings.remote_exchange_lazy_decompression
+            && client_tcp_protocol_version >= DBMS_MIN_REVISION_WITH_LAZY_EXCHANGE_BLOCKS)
+        {
+            state.lazy_exchange_blocks = true;
+
+            std::string chunk_method = state.compression == Protocol::Compression::Enable
+                ? Poco::toUpper(query_settings.network_compression_method.toString())
+                : "NONE";
+            std::optional<int> chunk_level;
+            if (chunk_method == "ZSTD")
+                chunk_level = query_settings.network_zstd_compression_level;
+            state.lazy_exchange_codec = CompressionCodecFactory::instance().get(chunk_method, chunk_level);
+        }
+
         state.block_out = std::make_unique<NativeWriter>(
             *state.maybe_compressed_out,
             client_tcp_protocol_version,
@@ -2152,7 +2275,7 @@ QueryState::CancellationStatus TCPHandler::getQueryCancellationStatus()
 
     after_check_cancelled.restart();
 
-    /// During request execution the only packet that can come from the client is stopping the query.
+    /// During request execution the client can only stop the query or push a sort key threshold.
     if (static_cast<ReadBufferFromPocoSocket &>(*in).poll(0))
     {
         if (in->eof())
@@ -2176,6 +2299,10 @@ QueryState::CancellationStatus TCPHandler::getQueryCancellationStatus()
 
                 return state.cancellation_status;
 
+            case Protocol::Client::SortThreshold:
+                receiveSortThreshold();
+                return state.cancellation_status;
+
             default:
                 throw NetException(ErrorCodes::UNKNOWN_PACKET_FROM_CLIENT, "Unknown packet from client {}", toString(packet_type));
         }
@@ -2186,6 +2313,31 @@ QueryState::CancellationStatus TCPHandler::getQueryCancellationStatus()
 
 
 void TCPHandler::sendData(const Block & block)
+{
+    /// Split oversized blocks into several Data packets, so that neither side has to keep
+    /// the whole block resident on top of the wire buffers. Multiple Data packets are valid
+    /// for any client, so no protocol negotiation is needed.
+    size_t max_bytes = query_context ? query_context->getSettingsRef().max_block_bytes_for_tcp_data_packet : 0;
+    if (max_bytes != 0 && block.rows() > 1 && block.bytes() > max_bytes)
+    {
+        const size_t num_pieces = (block.bytes() + max_bytes - 1) / max_bytes;
+        const size_t rows_per_piece = std::max<size_t>(1, (block.rows() + num_pieces - 1) / num_pieces);
+
+        for (size_t offset = 0; offset < block.rows(); offset += rows_per_piece)
+        {
+            const size_t length = std::min(rows_per_piece, block.rows() - offset);
+            Columns columns = block.getColumns();
+            for (auto & column : columns)
+                column = column->cut(offset, length);
+            sendDataPacket(block.cloneWithColumns(std::move(columns)));
+        }
+        return;
+    }
+
+    sendDataPacket(block);
+}
+
+void TCPHandler::sendDataPacket(const Block & block)
 {
     initBlockOutput(block);
 
@@ -2215,9 +2367,16 @@ void TCPHandler::sendData(const Block & block)
             std::this_thread::sleep_for(ms);
         }
 
-        state.block_out->write(block);
+        Stopwatch send_watch;
+        if (state.lazy_exchange_blocks)
+            writeLazyExchangeBlock(block);
+        else
+            state.block_out->write(block);
         state.maybe_compressed_out->next();
         out->next();
+
+        if (state.compressed_out && !state.lazy_exchange_blocks)
+            adaptOutputCompression(out->count() - prev_bytes_written_out, send_watch.elapsedSeconds());
     }
     catch (...)
     {
@@ -2243,6 +2402,65 @@ void TCPHandler::sendData(const Block & block)
 }
 
 
+void TCPHandler::writeLazyExchangeBlock(const Block & block)
+{
+    /// Instead of a single compressed frame with interleaved structure and data, write the
+    /// block header uncompressed and every column as a self-contained compressed chunk.
+    /// This allows the client to wrap the columns into lazily decompressed ones and never
+    /// pay for the blocks (or columns) it throws away. See Connection::receiveLazyData().
+    block.info.write(*out);
+
+    writeVarUInt(block.columns(), *out);
+    writeVarUInt(block.rows(), *out);
+
+    for (const auto & elem : block)
+    {
+        writeStringBinary(elem.name, *out);
+        writeStringBinary(elem.type->getName(), *out);
+
+        String chunk;
+        {
+            WriteBufferFromString chunk_out(chunk);
+            CompressedWriteBuffer compressed_chunk_out(chunk_out, state.lazy_exchange_codec);
+            NativeWriter::writeData(
+                *elem.type->getDefaultSerialization(),
+                elem.column->convertToFullColumnIfSparse(),
+                compressed_chunk_out,
+                0,
+                0);
+            compressed_chunk_out.finalize();
+        }
+        writeStringBinary(chunk, *out);
+    }
+}
+
+
+void TCPHandler::adaptOutputCompression(size_t bytes_on_wire, double elapsed_seconds)
+{
+    /// Too little data to give a meaningful throughput estimate.
+    if (bytes_on_wire < 65536 || elapsed_seconds <= 0.)
+        return;
+
+    const double sample = bytes_on_wire / elapsed_seconds;
+    auto & ewma = state.network_bytes_per_second_ewma;
+    /// Weight 1/4 for the new sample to smooth out single fast or slow packets.
+    ewma = ewma > 0. ? ewma * 0.75 + sample * 0.25 : sample;
+
+    /// Above this rate the link is clearly not the bottleneck and compression only burns CPU.
+    static constexpr double uncompressed_threshold_bytes_per_second = 500'000'000.;
+    /// Below this rate the link is saturated or distant and it pays off to compress harder.
+    static constexpr double zstd_threshold_bytes_per_second = 50'000'000.;
+
+    auto & factory = CompressionCodecFactory::instance();
+    if (ewma > uncompressed_threshold_bytes_per_second)
+        state.compressed_out->setCodec(factory.get("NONE", {}));
+    else if (ewma < zstd_threshold_bytes_per_second)
+        state.compressed_out->setCodec(factory.get("ZSTD", static_cast<int>(query_context->getSettingsRef().network_zstd_compression_level)));
+    else
+        state.compressed_out->setCodec(state.configured_network_codec);
+}
+
+
 void TCPHandler::sendLogData(const Block & block)
 {
     initLogsBlockOutput(block);
@@ -19,6 +19,8 @@
 #include <Interpreters/ProfileEventsExt.h>
 #include <Formats/NativeReader.h>
 #include <Formats/NativeWriter.h>
+#include <Compression/ICompressionCodec.h>
+#include <QueryPipeline/SortThresholdExchange.h>
 
 #include "IServer.h"
 #include "Interpreters/AsynchronousInsertQueue.h"
@@ -44,6 +46,7 @@ struct ProfileInfo;
 class TCPServer;
 class NativeWriter;
 class NativeReader;
+class CompressedWriteBuffer;
 
 /// State of query processing.
 struct QueryState
@@ -72,6 +75,28 @@ struct QueryState
     std::unique_ptr<NativeWriter> block_out;
     Block block_for_insert;
 
+    /// External tables dedup (see receiveExternalTablesHashes()): content hashes of the tables
+    /// the client was asked to send and their blocks, accumulated to be put into the cache
+    /// when the external tables data transfer ends.
+    std::unordered_map<String, UInt128> external_table_hashes_to_store;
+    std::unordered_map<String, Blocks> external_table_blocks_to_store;
+
+    /// Sort key thresholds pushed by the initiator of a distributed ORDER BY ... LIMIT
+    /// query, polled by the sorting transforms of the pipeline.
+    SortThresholdSlotPtr sort_threshold_slot;
+
+    /// For adaptive network compression: the compressed stream (if compression is enabled),
+    /// the codec configured by network_compression_method and the observed rate of the
+    /// outgoing stream. See TCPHandler::adaptOutputCompression().
+    CompressedWriteBuffer * compressed_out = nullptr;
+    CompressionCodecPtr configured_network_codec;
+    double network_bytes_per_second_ewma = 0.;
+
+    /// Send Data packets as per-column compressed chunks, so that the client can
+    /// decompress the columns lazily. See TCPHandler::writeLazyExchangeBlock().
+    bool lazy_exchange_blocks = false;
+    CompressionCodecPtr lazy_exchange_codec;
+
     /// Query text.
     String query;
     /// Parsed query
@@ -258,6 +283,13 @@ private:
     String receiveReadTaskResponseAssumeLocked();
     std::optional<ParallelReadResponse> receivePartitionMergeTreeReadTaskResponseAssumeLocked();
     bool receiveData(bool scalar);
+    /// Read the content hashes of the external tables the client is about to send and
+    /// reply with the names of the ones missing from the dedup cache; fill the temporary
+    /// tables the server already holds from the cache.
+    void receiveExternalTablesHashes();
+    /// Read a sort key threshold pushed by the initiator of a distributed query
+    /// and make it visible to the sorting transforms of the running pipeline.
+    void receiveSortThreshold();
     bool readDataNext();
     void readData();
     void skipData();
@@ -280,7 +312,12 @@ private:
     void processTablesStatusRequest();
 
     void sendHello();
-    void sendData(const Block & block);    /// Write a block to the network.
+    void sendData(const Block & block);    /// Write a block to the network, splitting it if it is too large.
+    void sendDataPacket(const Block & block);    /// Write a single Data packet.
+    /// Write the block as per-column compressed chunks that can be decompressed lazily.
+    void writeLazyExchangeBlock(const Block & block);
+    /// Pick the codec for the following Data packets based on the observed rate of the outgoing stream.
+    void adaptOutputCompression(size_t bytes_on_wire, double elapsed_seconds);
     void sendLogData(const Block & block);
     void sendTableColumns(const ColumnsDescription & columns);
     void sendException(const Exception & e, bool with_stack_trace);
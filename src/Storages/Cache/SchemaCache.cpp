@@ -1,6 +1,14 @@
 #include <Storages/Cache/SchemaCache.h>
 #include <Common/ProfileEvents.h>
+#include <Common/SipHash.h>
+#include <Common/ZooKeeper/ZooKeeper.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteBufferFromString.h>
+#include <IO/WriteHelpers.h>
+#include <base/hex.h>
 #include <ctime>
+#include <filesystem>
 
 namespace ProfileEvents
 {
@@ -21,24 +29,66 @@ SchemaCache::SchemaCache(size_t max_elements_) : max_elements(max_elements_)
 {
 }
 
-void SchemaCache::addColumns(const Key & key, const ColumnsDescription & columns)
+void SchemaCache::enableDistributedCache(zkutil::GetZooKeeper get_zookeeper_, const String & zookeeper_path_)
 {
     std::lock_guard lock(mutex);
-    addUnlocked(key, columns, std::nullopt);
+    if (get_zookeeper)
+        return;
+
+    get_zookeeper = std::move(get_zookeeper_);
+    zookeeper_path = zookeeper_path_;
+    log = getLogger("SchemaCache");
+}
+
+void SchemaCache::addColumns(const Key & key, const ColumnsDescription & columns)
+{
+    SchemaInfo info;
+    {
+        std::lock_guard lock(mutex);
+        addUnlocked(key, columns, std::nullopt);
+        if (!get_zookeeper)
+            return;
+        auto it = data.find(key);
+        if (it == data.end())
+            return;
+        info = it->second.schema_info;
+    }
+    saveToKeeper(key, info);
 }
 
 
 void SchemaCache::addManyColumns(const Keys & keys, const ColumnsDescription & columns)
 {
-    std::lock_guard lock(mutex);
-    for (const auto & key : keys)
-        addUnlocked(key, columns, std::nullopt);
+    std::vector<std::pair<Key, SchemaInfo>> infos_to_share;
+    {
+        std::lock_guard lock(mutex);
+        for (const auto & key : keys)
+            addUnlocked(key, columns, std::nullopt);
+        if (!get_zookeeper)
+            return;
+        infos_to_share.reserve(keys.size());
+        for (const auto & key : keys)
+            if (auto it = data.find(key); it != data.end())
+                infos_to_share.emplace_back(key, it->second.schema_info);
+    }
+    for (const auto & [key, info] : infos_to_share)
+        saveToKeeper(key, info);
 }
 
 void SchemaCache::addNumRows(const DB::SchemaCache::Key & key, size_t num_rows)
 {
-    std::lock_guard lock(mutex);
-    addUnlocked(key, std::nullopt, num_rows);
+    SchemaInfo info;
+    {
+        std::lock_guard lock(mutex);
+        addUnlocked(key, std::nullopt, num_rows);
+        if (!get_zookeeper)
+            return;
+        auto it = data.find(key);
+        if (it == data.end())
+            return;
+        info = it->second.schema_info;
+    }
+    saveToKeeper(key, info);
 }
 
 void SchemaCache::addUnlocked(const Key & key, const std::optional<ColumnsDescription> & columns, std::optional<size_t> num_rows)
@@ -100,8 +150,37 @@ std::optional<size_t> SchemaCache::tryGetNumRows(const DB::SchemaCache::Key & ke
 
 std::optional<SchemaCache::SchemaInfo> SchemaCache::tryGetImpl(const Key & key, LastModificationTimeGetter get_last_mod_time)
 {
-    std::lock_guard lock(mutex);
+    std::unique_lock lock(mutex);
     auto it = data.find(key);
+    if (it == data.end() && get_zookeeper)
+    {
+        /// Fall back to the shared cache. The Keeper round trip must not be done under the mutex.
+        lock.unlock();
+        std::optional<SchemaInfo> shared_info;
+        try
+        {
+            shared_info = tryGetFromKeeper(key);
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, "Failed to get schema from the shared cache in Keeper");
+        }
+        lock.lock();
+
+        if (shared_info)
+        {
+            it = data.find(key);
+            if (it == data.end())
+            {
+                auto queue_it = queue.insert(queue.end(), key);
+                it = data.emplace(key, Cell{*shared_info, queue_it}).first;
+                checkOverflow();
+                /// The new key could be evicted right away if the cache capacity is zero.
+                it = data.find(key);
+            }
+        }
+    }
+
     if (it == data.end())
     {
         ProfileEvents::increment(ProfileEvents::SchemaInferenceCacheMisses);
@@ -138,6 +217,78 @@ std::optional<SchemaCache::SchemaInfo> SchemaCache::tryGetImpl(const Key & key,
     return schema_info;
 }
 
+String SchemaCache::getKeeperNodePath(const Key & key) const
+{
+    SipHash hash;
+    hash.update(key.source);
+    hash.update(key.format);
+    hash.update(key.additional_format_info);
+    hash.update(key.schema_inference_mode);
+    return std::filesystem::path(zookeeper_path) / getHexUIntLowercase(hash.get128());
+}
+
+std::optional<SchemaCache::SchemaInfo> SchemaCache::tryGetFromKeeper(const Key & key) const
+{
+    auto zookeeper = get_zookeeper();
+    String serialized;
+    if (!zookeeper->tryGet(getKeeperNodePath(key), serialized))
+        return std::nullopt;
+    return deserializeSchemaInfo(serialized);
+}
+
+void SchemaCache::saveToKeeper(const Key & key, const SchemaInfo & info) const
+{
+    try
+    {
+        auto zookeeper = get_zookeeper();
+        auto path = getKeeperNodePath(key);
+        zookeeper->createAncestors(path);
+        /// Another server may save the same entry concurrently, the contents are equivalent.
+        zookeeper->createOrUpdate(path, serializeSchemaInfo(info), zkutil::CreateMode::Persistent);
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log, "Failed to save schema to the shared cache in Keeper");
+    }
+}
+
+String SchemaCache::serializeSchemaInfo(const SchemaInfo & info)
+{
+    WriteBufferFromOwnString out;
+    writeCString("schema cache format version: 1\n", out);
+    writeText(info.registration_time, out);
+    writeChar('\n', out);
+    writeText(info.num_rows ? static_cast<Int64>(*info.num_rows) : Int64(-1), out);
+    writeChar('\n', out);
+    /// The rest of the node is the columns description.
+    if (info.columns)
+        writeString(info.columns->toString(), out);
+    return out.str();
+}
+
+SchemaCache::SchemaInfo SchemaCache::deserializeSchemaInfo(const String & str)
+{
+    ReadBufferFromString in(str);
+    assertString("schema cache format version: 1\n", in);
+
+    SchemaInfo info;
+    readText(info.registration_time, in);
+    assertChar('\n', in);
+
+    Int64 num_rows;
+    readText(num_rows, in);
+    assertChar('\n', in);
+    if (num_rows >= 0)
+        info.num_rows = static_cast<size_t>(num_rows);
+
+    String columns_str;
+    readStringUntilEOF(columns_str, in);
+    if (!columns_str.empty())
+        info.columns = ColumnsDescription::parse(columns_str);
+
+    return info;
+}
+
 void SchemaCache::clear()
 {
     std::lock_guard lock(mutex);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Storages/ColumnsDescription.h>
+#include <Common/ZooKeeper/Common.h>
+#include <Common/logger_useful.h>
 #include <unordered_map>
 #include <list>
 #include <mutex>
@@ -56,6 +58,12 @@ public:
 
     using LastModificationTimeGetter = std::function<std::optional<time_t>()>;
 
+    /// Share entries between servers through [Zoo]Keeper under the given path. On a local
+    /// miss the cache falls back to the shared entries, and new entries are mirrored there
+    /// best-effort, so a fleet of servers infers the schema of each new file only once.
+    /// Keeper unavailability never fails the query, it only disables sharing.
+    void enableDistributedCache(zkutil::GetZooKeeper get_zookeeper_, const String & zookeeper_path_);
+
     /// Add new key or update existing with a schema
     void addColumns(const Key & key, const ColumnsDescription & columns);
     /// Add/update many keys with the same schema (usually used for globs)
@@ -76,6 +84,13 @@ private:
     std::optional<SchemaInfo> tryGetImpl(const Key & key, LastModificationTimeGetter get_last_mod_time);
     void checkOverflow();
 
+    std::optional<SchemaInfo> tryGetFromKeeper(const Key & key) const;
+    void saveToKeeper(const Key & key, const SchemaInfo & info) const;
+    String getKeeperNodePath(const Key & key) const;
+
+    static String serializeSchemaInfo(const SchemaInfo & info);
+    static SchemaInfo deserializeSchemaInfo(const String & str);
+
     using Queue = std::list<Key>;
     using QueueIterator = Queue::iterator;
 
@@ -89,6 +104,12 @@ private:
     std::unordered_map<Key, Cell, KeyHash> data;
 
     size_t max_elements;
+
+    /// Set once by enableDistributedCache and never cleared.
+    zkutil::GetZooKeeper get_zookeeper;
+    String zookeeper_path;
+    LoggerPtr log;
+
     std::mutex mutex;
 };
 
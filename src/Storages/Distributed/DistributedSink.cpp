@@ -548,6 +548,9 @@ void DistributedSink::onFinish()
     if (isCancelled())
         return;
 
+    /// Write out per-shard files with blocks buffered by batched background INSERT.
+    flushPendingShardFiles();
+
     /// Pool finished means that some exception had been thrown before,
     /// and scheduling new jobs will return "Cannot schedule a task" error.
     if (insert_sync && pool && !pool->finished())
@@ -684,7 +687,7 @@ void DistributedSink::writeAsyncImpl(const Block & block, size_t shard_id)
                 settings.use_compact_format_in_distributed_parts_names);
             if (path.empty())
                 throw Exception(ErrorCodes::LOGICAL_ERROR, "Directory name for async inserts is empty");
-            writeToShard(shard_info, block_to_send, {path});
+            writeToShardBatched(shard_info, shard_id, std::move(block_to_send), {path});
         }
     }
     else
@@ -698,7 +701,7 @@ void DistributedSink::writeAsyncImpl(const Block & block, size_t shard_id)
                 dir_names.push_back(address.toFullString(settings.use_compact_format_in_distributed_parts_names));
 
         if (!dir_names.empty())
-            writeToShard(shard_info, block_to_send, dir_names);
+            writeToShardBatched(shard_info, shard_id, std::move(block_to_send), dir_names);
     }
 }
 
@@ -732,7 +735,48 @@ void DistributedSink::writeToLocal(const Cluster::ShardInfo & shard_info, const
 }
 
 
-void DistributedSink::writeToShard(const Cluster::ShardInfo & shard_info, const Block & block, const std::vector<std::string> & dir_names)
+void DistributedSink::writeToShardBatched(const Cluster::ShardInfo & shard_info, size_t shard_id, Block && block, const std::vector<std::string> & dir_names)
+{
+    size_t max_batch_bytes = context->getSettingsRef().distributed_background_insert_batch_bytes;
+    if (!max_batch_bytes)
+    {
+        Blocks single_block;
+        single_block.emplace_back(std::move(block));
+        writeToShard(shard_info, single_block, dir_names);
+        return;
+    }
+
+    if (pending_shard_files.empty())
+        pending_shard_files.resize(cluster->getShardsInfo().size());
+
+    auto & pending = pending_shard_files[shard_id];
+    pending.shard_info = &shard_info;
+    pending.dir_names = dir_names;
+    pending.bytes += block.bytes();
+    pending.blocks.emplace_back(std::move(block));
+
+    if (pending.bytes >= max_batch_bytes)
+    {
+        writeToShard(*pending.shard_info, pending.blocks, pending.dir_names);
+        pending = {};
+    }
+}
+
+
+void DistributedSink::flushPendingShardFiles()
+{
+    for (auto & pending : pending_shard_files)
+    {
+        if (pending.blocks.empty())
+            continue;
+
+        writeToShard(*pending.shard_info, pending.blocks, pending.dir_names);
+        pending = {};
+    }
+}
+
+
+void DistributedSink::writeToShard(const Cluster::ShardInfo & shard_info, const Blocks & blocks, const std::vector<std::string> & dir_names)
 {
     OpenTelemetry::SpanHolder span(__PRETTY_FUNCTION__);
     span.addAttribute("clickhouse.shard_num", shard_info.shard_num);
@@ -756,7 +800,16 @@ void DistributedSink::writeToShard(const Cluster::ShardInfo & shard_info, const
     /// and keep directory queue thread out from reading incomplete data
     std::string first_file_tmp_path;
 
-    auto reservation = storage.getStoragePolicy()->reserveAndCheck(block.bytes());
+    const Block header_block = blocks.front().cloneEmpty();
+    size_t total_rows = 0;
+    size_t total_bytes = 0;
+    for (const auto & block : blocks)
+    {
+        total_rows += block.rows();
+        total_bytes += block.bytes();
+    }
+
+    auto reservation = storage.getStoragePolicy()->reserveAndCheck(total_bytes);
     const auto disk = reservation->getDisk();
     auto disk_path = disk->getPath();
     auto data_path = storage.getRelativeDataPath();
@@ -795,7 +848,7 @@ void DistributedSink::writeToShard(const Cluster::ShardInfo & shard_info, const
 
             WriteBufferFromFile out{first_file_tmp_path};
             CompressedWriteBuffer compress{out, compression_codec};
-            NativeWriter stream{compress, DBMS_TCP_PROTOCOL_VERSION, block.cloneEmpty()};
+            NativeWriter stream{compress, DBMS_TCP_PROTOCOL_VERSION, header_block};
 
             /// Prepare the header.
             /// See also DistributedAsyncInsertHeader::read() in DistributedInsertQueue (for reading side)
@@ -819,14 +872,14 @@ void DistributedSink::writeToShard(const Cluster::ShardInfo & shard_info, const
                 context->getClientInfo().write(header_buf, DBMS_TCP_PROTOCOL_VERSION);
             }
 
-            writeVarUInt(block.rows(), header_buf);
-            writeVarUInt(block.bytes(), header_buf);
-            writeStringBinary(block.cloneEmpty().dumpStructure(), header_buf); /// obsolete
+            writeVarUInt(total_rows, header_buf);
+            writeVarUInt(total_bytes, header_buf);
+            writeStringBinary(header_block.dumpStructure(), header_buf); /// obsolete
             /// Write block header separately in the batch header.
             /// It is required for checking does conversion is required or not.
             {
-                NativeWriter header_stream{header_buf, DBMS_TCP_PROTOCOL_VERSION, block.cloneEmpty()};
-                header_stream.write(block.cloneEmpty());
+                NativeWriter header_stream{header_buf, DBMS_TCP_PROTOCOL_VERSION, header_block};
+                header_stream.write(header_block);
             }
 
             writeVarUInt(shard_info.shard_num, header_buf);
@@ -844,7 +897,8 @@ void DistributedSink::writeToShard(const Cluster::ShardInfo & shard_info, const
             writeStringBinary(header, out);
             writePODBinary(CityHash_v1_0_2::CityHash128(header.data(), header.size()), out);
 
-            stream.write(block);
+            for (const auto & block : blocks)
+                stream.write(block);
 
             compress.finalize();
             out.finalize();
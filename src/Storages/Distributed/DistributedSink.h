@@ -72,7 +72,15 @@ private:
     /// Increments finished_writings_count after each repeat.
     void writeToLocal(const Cluster::ShardInfo & shard_info, const Block & block, size_t repeats);
 
-    void writeToShard(const Cluster::ShardInfo & shard_info, const Block & block, const std::vector<std::string> & dir_names);
+    void writeToShard(const Cluster::ShardInfo & shard_info, const Blocks & blocks, const std::vector<std::string> & dir_names);
+
+    /// Coalesce consecutive blocks going to the same shard into a single file
+    /// (when distributed_background_insert_batch_bytes is set), flushing when
+    /// the buffered blocks grow too big. Fewer files mean fewer compression
+    /// streams, fsyncs and sends of small batches.
+    void writeToShardBatched(const Cluster::ShardInfo & shard_info, size_t shard_id, Block && block, const std::vector<std::string> & dir_names);
+
+    void flushPendingShardFiles();
 
 
     /// Performs synchronous insertion to remote nodes. If timeout_exceeded flag was set, throws.
@@ -105,6 +113,17 @@ private:
 
     bool is_first_chunk = true;
 
+    /// Per-shard buffers of consecutive blocks waiting to be written into one file
+    /// (only for background INSERT with distributed_background_insert_batch_bytes set).
+    struct PendingShardFile
+    {
+        Blocks blocks;
+        size_t bytes = 0;
+        const Cluster::ShardInfo * shard_info = nullptr;
+        std::vector<std::string> dir_names;
+    };
+    std::vector<PendingShardFile> pending_shard_files;
+
     /// Sync-related stuff
     UInt64 insert_timeout; // in seconds
     NameSet columns_to_send;
@@ -293,7 +293,10 @@ void KafkaConsumer::commit()
                 // also some other temporary issues like client-server connectivity problems are possible
                 consumer->commit();
                 committed = true;
-                print_offsets("Committed offset", consumer->get_offsets_committed(consumer->get_assignment()));
+                /// get_offsets_committed() is another blocking broker round trip made only for
+                /// this log line; after a successful synchronous commit it matches the local
+                /// position, so print that instead.
+                print_offsets("Committed offset", consumer->get_offsets_position(consumer->get_assignment()));
                 last_commit_timestamp_usec = static_cast<UInt64>(Poco::Timestamp().epochTime());
                 num_commits += 1;
             }
@@ -39,6 +39,7 @@
 #include <cppkafka/configuration.h>
 #include <librdkafka/rdkafka.h>
 #include <Poco/Util/AbstractConfiguration.h>
+#include <Common/threadPoolCallbackRunner.h>
 #include <Common/Exception.h>
 #include <Common/Macros.h>
 #include <Common/Stopwatch.h>
@@ -1145,10 +1146,26 @@ bool StorageKafka::streamToViews()
     }
 
     bool some_stream_is_stalled = false;
-    for (auto & source : sources)
+    if (sources.size() > 1)
     {
-        some_stream_is_stalled = some_stream_is_stalled || source->isStalled();
-        source->commit();
+        /// Each commit is a synchronous broker round trip, so with several consumers
+        /// commit them in parallel instead of paying the round trips one by one.
+        /// All offsets are committed only after the write to the views is confirmed.
+        ThreadPoolCallbackRunnerLocal<void, GlobalThreadPool> commit_runner(GlobalThreadPool::instance(), "KafkaCommit");
+        for (auto & source : sources)
+        {
+            some_stream_is_stalled = some_stream_is_stalled || source->isStalled();
+            commit_runner([&source] { source->commit(); });
+        }
+        commit_runner.waitForAllToFinishAndRethrowFirstError();
+    }
+    else
+    {
+        for (auto & source : sources)
+        {
+            some_stream_is_stalled = some_stream_is_stalled || source->isStalled();
+            source->commit();
+        }
     }
 
     UInt64 milliseconds = watch.elapsedMilliseconds();
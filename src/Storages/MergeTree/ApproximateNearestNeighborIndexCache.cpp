@@ -0,0 +1,11 @@
+#include <Storages/MergeTree/ApproximateNearestNeighborIndexCache.h>
+
+namespace DB
+{
+template class CacheBase<UInt128, IMergeTreeIndexGranule, UInt128TrivialHash, ApproximateNearestNeighborIndexWeightFunction>;
+
+ApproximateNearestNeighborIndexCache::ApproximateNearestNeighborIndexCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio)
+    : Base(cache_policy, max_size_in_bytes, 0, size_ratio)
+{
+}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+
+#include <Common/CacheBase.h>
+#include <Common/ProfileEvents.h>
+#include <Common/SipHash.h>
+#include <Common/HashTable/Hash.h>
+#include <Storages/MergeTree/MergeTreeIndices.h>
+
+
+namespace ProfileEvents
+{
+    extern const Event ApproximateNearestNeighborIndexCacheHits;
+    extern const Event ApproximateNearestNeighborIndexCacheMisses;
+}
+
+namespace DB
+{
+
+/// Memory occupied by a deserialized ANN index granule.
+struct ApproximateNearestNeighborIndexWeightFunction
+{
+    /// We spent additional bytes on key in hashmap, linked lists, shared pointers, etc ...
+    static constexpr size_t ANN_INDEX_CACHE_OVERHEAD = 128;
+
+    size_t operator()(const IMergeTreeIndexGranule & granule) const
+    {
+        return granule.memoryUsageBytes() + ANN_INDEX_CACHE_OVERHEAD;
+    }
+};
+
+extern template class CacheBase<UInt128, IMergeTreeIndexGranule, UInt128TrivialHash, ApproximateNearestNeighborIndexWeightFunction>;
+/** Cache of deserialized approximate nearest neighbor index granules (Annoy, USearch).
+  * Rebuilding the in-memory search structure from the serialized granule dominates the latency of
+  * repeated vector search queries, while searching the structure is cheap, so deserialized granules
+  * are kept in memory and shared between queries. The granule holds only the search structure
+  * (quantized according to the scalar kind of the index, e.g. 'f16' or 'i8'), the full vectors stay
+  * in the table on disk. Parts are immutable and identified by the total checksum, so entries of
+  * removed or mutated parts simply age out of the LRU.
+  */
+class ApproximateNearestNeighborIndexCache : public CacheBase<UInt128, IMergeTreeIndexGranule, UInt128TrivialHash, ApproximateNearestNeighborIndexWeightFunction>
+{
+private:
+    using Base = CacheBase<UInt128, IMergeTreeIndexGranule, UInt128TrivialHash, ApproximateNearestNeighborIndexWeightFunction>;
+
+public:
+    ApproximateNearestNeighborIndexCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio);
+
+    /// Calculate key from part checksum, index name and the index granule number.
+    static UInt128 hash(const UInt128 & part_checksum, const String & index_name, size_t index_mark)
+    {
+        SipHash hash;
+        hash.update(part_checksum);
+        hash.update(index_name.data(), index_name.size() + 1);
+        hash.update(index_mark);
+        return hash.get128();
+    }
+
+    template <typename LoadFunc>
+    MappedPtr getOrSet(const Key & key, LoadFunc && load)
+    {
+        auto result = Base::getOrSet(key, load);
+        if (result.second)
+            ProfileEvents::increment(ProfileEvents::ApproximateNearestNeighborIndexCacheMisses);
+        else
+            ProfileEvents::increment(ProfileEvents::ApproximateNearestNeighborIndexCacheHits);
+
+        return result.first;
+    }
+};
+
+using ApproximateNearestNeighborIndexCachePtr = std::shared_ptr<ApproximateNearestNeighborIndexCache>;
+
+}
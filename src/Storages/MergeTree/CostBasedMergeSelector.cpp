@@ -0,0 +1,172 @@
+#include <Storages/MergeTree/CostBasedMergeSelector.h>
+
+#include <base/interpolate.h>
+
+#include <cmath>
+
+
+namespace DB
+{
+
+namespace
+{
+
+/// See the comments in SimpleMergeSelector.cpp; the structure of the algorithm is the same
+/// and only the cost of a candidate range differs.
+
+double mapPiecewiseLinearToUnit(double value, double min, double max)
+{
+    return value <= min ? 0
+        : (value >= max ? 1
+        : ((value - min) / (max - min)));
+}
+
+struct Estimator
+{
+    using Iterator = CostBasedMergeSelector::PartsRange::const_iterator;
+
+    void consider(Iterator begin, Iterator end, size_t sum_size, size_t sum_read_hits, size_t sum_expired_bytes, const CostBasedMergeSelector::Settings & settings)
+    {
+        double count = end - begin;
+
+        /// Expired bytes are dropped by the merge, so they don't contribute to the cost of carrying
+        /// the resulting part; subtracting them prefers ranges where TTL reclaims the most data.
+        double effective_size = sum_size > sum_expired_bytes ? sum_size - sum_expired_bytes : 0;
+        double current_score = (effective_size + settings.size_fixed_cost_to_add * count) / (count - 1.9);
+
+        /// Reducing the number of parts pays off proportionally to how often they are read.
+        current_score /= 1.0 + log(1 + sum_read_hits);
+
+        if (min_score == 0.0 || current_score < min_score)
+        {
+            min_score = current_score;
+            best_begin = begin;
+            best_end = end;
+        }
+    }
+
+    CostBasedMergeSelector::PartsRange getBest() const
+    {
+        return CostBasedMergeSelector::PartsRange(best_begin, best_end);
+    }
+
+    double min_score = 0.0;
+    Iterator best_begin {};
+    Iterator best_end {};
+};
+
+bool allow(
+    double sum_size,
+    double max_size,
+    double min_age,
+    double range_size,
+    double partition_size,
+    double sum_read_hits,
+    double min_size_to_lower_base_log,
+    double max_size_to_lower_base_log,
+    const CostBasedMergeSelector::Settings & settings)
+{
+    if (settings.min_age_to_force_merge && min_age >= settings.min_age_to_force_merge)
+        return true;
+
+    double size_normalized = mapPiecewiseLinearToUnit(log(1 + sum_size), min_size_to_lower_base_log, max_size_to_lower_base_log);
+
+    double min_age_to_lower_base = interpolateLinear(settings.min_age_to_lower_base_at_min_size, settings.min_age_to_lower_base_at_max_size, size_normalized);
+    double max_age_to_lower_base = interpolateLinear(settings.max_age_to_lower_base_at_min_size, settings.max_age_to_lower_base_at_max_size, size_normalized);
+
+    double age_normalized = mapPiecewiseLinearToUnit(min_age, min_age_to_lower_base, max_age_to_lower_base);
+    double num_parts_normalized = mapPiecewiseLinearToUnit(partition_size, settings.min_parts_to_lower_base, settings.max_parts_to_lower_base);
+
+    /// The extra term compared to SimpleMergeSelector: read-hot ranges lower the base as well,
+    /// so fragmentation in hot partitions is repaired more eagerly than in cold ones.
+    double read_hits_normalized = mapPiecewiseLinearToUnit(
+        log(1 + sum_read_hits), settings.min_read_hits_to_lower_base_log, settings.max_read_hits_to_lower_base_log);
+
+    double combined_ratio = std::min(1.0, age_normalized + num_parts_normalized + read_hits_normalized);
+
+    double lowered_base = interpolateLinear(settings.base, 2.0, combined_ratio);
+
+    return (sum_size + range_size * settings.size_fixed_cost_to_add) / (max_size + settings.size_fixed_cost_to_add) >= lowered_base;
+}
+
+void selectWithinPartition(
+    const CostBasedMergeSelector::PartsRange & parts,
+    const size_t max_total_size_to_merge,
+    Estimator & estimator,
+    const CostBasedMergeSelector::Settings & settings,
+    double min_size_to_lower_base_log,
+    double max_size_to_lower_base_log)
+{
+    size_t parts_count = parts.size();
+    if (parts_count <= 1)
+        return;
+
+    /// Consider only last N parts to avoid quadratic behaviour on huge partitions
+    /// (see the comment in SimpleMergeSelector.cpp).
+    static constexpr size_t parts_threshold = 1000;
+    size_t begin = 0;
+    if (parts_count >= parts_threshold)
+        begin = parts_count - parts_threshold;
+
+    for (; begin < parts_count; ++begin)
+    {
+        if (!parts[begin].shall_participate_in_merges)
+            continue;
+
+        size_t sum_size = parts[begin].size;
+        size_t max_size = parts[begin].size;
+        size_t min_age = parts[begin].age;
+        size_t sum_read_hits = parts[begin].read_hits;
+        size_t sum_expired_bytes = parts[begin].bytes_expired_by_column_ttl;
+
+        for (size_t end = begin + 2; end <= parts_count; ++end)
+        {
+            if (settings.max_parts_to_merge_at_once && end - begin > settings.max_parts_to_merge_at_once)
+                break;
+
+            if (!parts[end - 1].shall_participate_in_merges)
+                break;
+
+            size_t cur_size = parts[end - 1].size;
+            size_t cur_age = parts[end - 1].age;
+
+            sum_size += cur_size;
+            max_size = std::max(max_size, cur_size);
+            min_age = std::min(min_age, cur_age);
+            sum_read_hits += parts[end - 1].read_hits;
+            sum_expired_bytes += parts[end - 1].bytes_expired_by_column_ttl;
+
+            if (max_total_size_to_merge && sum_size > max_total_size_to_merge)
+                break;
+
+            if (allow(sum_size, max_size, min_age, end - begin, parts_count, sum_read_hits, min_size_to_lower_base_log, max_size_to_lower_base_log, settings))
+                estimator.consider(
+                    parts.begin() + begin,
+                    parts.begin() + end,
+                    sum_size,
+                    sum_read_hits,
+                    sum_expired_bytes,
+                    settings);
+        }
+    }
+}
+
+}
+
+
+CostBasedMergeSelector::PartsRange CostBasedMergeSelector::select(
+    const PartsRanges & parts_ranges,
+    size_t max_total_size_to_merge)
+{
+    Estimator estimator;
+
+    const double min_size_to_lower_base_log = log(1 + settings.min_size_to_lower_base);
+    const double max_size_to_lower_base_log = log(1 + settings.max_size_to_lower_base);
+
+    for (const auto & part_range : parts_ranges)
+        selectWithinPartition(part_range, max_total_size_to_merge, estimator, settings, min_size_to_lower_base_log, max_size_to_lower_base_log);
+
+    return estimator.getBest();
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Storages/MergeTree/SimpleMergeSelector.h>
+
+
+namespace DB
+{
+
+/** Merge selector with the same write-amplification model as SimpleMergeSelector,
+  * but the cost of a candidate range additionally accounts for:
+  *
+  * 1. Read heat. Every read task over a part increments its read counter, and ranges
+  * with many reads get a better score. The reasoning: the number of parts matters for
+  * queries only where queries actually go, so the IO budget for merges should be spent
+  * on hot partitions first instead of compacting cold data nobody reads.
+  *
+  * 2. Bytes already expired by column TTL. Such bytes will be dropped by the merge,
+  * so they are excluded from the size of the range: the merge is cheaper than the sum
+  * of part sizes suggests and additionally reclaims space.
+  *
+  * Both signals are best-effort: read counters are in-memory only and reset when a part
+  * is re-loaded (e.g. server restart or merge), and expired bytes are estimated from
+  * whole-column TTL info. That is fine for a heuristic that only orders candidates.
+  */
+class CostBasedMergeSelector final : public IMergeSelector
+{
+public:
+    struct Settings : public SimpleMergeSelector::Settings
+    {
+        /** Read heat lowers the base the same way age and parts count do in SimpleMergeSelector:
+          * log(1 + read_hits) of the range is mapped to 0..1 between the two boundaries below.
+          * Hot ranges thus become eligible for merge earlier than the same-sized cold ranges.
+          */
+        double min_read_hits_to_lower_base_log = 3;     /// ~e^3 - 1 = 19 reads
+        double max_read_hits_to_lower_base_log = 10;    /// ~e^10 - 1 = 22025 reads
+    };
+
+    explicit CostBasedMergeSelector(const Settings & settings_) : settings(settings_) {}
+
+    PartsRange select(
+        const PartsRanges & parts_ranges,
+        size_t max_total_size_to_merge) override;
+
+private:
+    const Settings settings;
+};
+
+}
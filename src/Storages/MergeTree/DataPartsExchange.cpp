@@ -305,7 +305,6 @@ MergeTreeData::DataPart::Checksums Service::sendPartFromDisk(
         writeBinary(desc.file_size, out);
 
         auto file_in = desc.input_buffer_getter();
-        HashingWriteBuffer hashing_out(out);
 
         const auto & is_cancelled = blocker.getCounter();
         auto cancellation_hook = [&]()
@@ -320,21 +319,52 @@ MergeTreeData::DataPart::Checksums Service::sendPartFromDisk(
                     throw Exception(ErrorCodes::FAULT_INJECTED, "Failpoint replicated_sends_failpoint is triggered");
             });
         };
-        copyDataWithThrottler(*file_in, hashing_out, cancellation_hook, data.getSendsThrottler());
 
-        hashing_out.finalize();
+        /// If the streamed content is the file from checksums.txt as is, its hash is already known
+        /// and there is no need to recompute it while sending. The receiver hashes the stream anyway,
+        /// and comparing against the stored hash also catches on-disk corruption of the source replica.
+        /// For remote disks the streamed metadata files are not what the stored hashes describe,
+        /// so they are hashed as before.
+        const MergeTreeDataPartChecksum * stored_checksum = nullptr;
+        if (!from_remote_disk)
+        {
+            if (auto it = part->checksums.files.find(file_name); it != part->checksums.files.end() && it->second.file_size == desc.file_size)
+                stored_checksum = &it->second;
+        }
+
+        if (stored_checksum)
+        {
+            copyDataWithThrottler(*file_in, out, cancellation_hook, data.getSendsThrottler());
+
+            if (file_in->count() != desc.file_size)
+                throw Exception(
+                    ErrorCodes::BAD_SIZE_OF_FILE_IN_DATA_PART,
+                    "Unexpected size of file {}, expected {} got {}",
+                    std::string(fs::path(part->getDataPartStorage().getRelativePath()) / file_name),
+                    desc.file_size, file_in->count());
 
-        if (hashing_out.count() != desc.file_size)
-            throw Exception(
-                ErrorCodes::BAD_SIZE_OF_FILE_IN_DATA_PART,
-                "Unexpected size of file {}, expected {} got {}",
-                std::string(fs::path(part->getDataPartStorage().getRelativePath()) / file_name),
-                desc.file_size, hashing_out.count());
+            writePODBinary(stored_checksum->file_hash, out);
+            data_checksums.addFile(file_name, desc.file_size, stored_checksum->file_hash);
+        }
+        else
+        {
+            HashingWriteBuffer hashing_out(out);
+            copyDataWithThrottler(*file_in, hashing_out, cancellation_hook, data.getSendsThrottler());
 
-        writePODBinary(hashing_out.getHash(), out);
+            hashing_out.finalize();
 
-        if (!file_names_without_checksums.contains(file_name))
-            data_checksums.addFile(file_name, hashing_out.count(), hashing_out.getHash());
+            if (hashing_out.count() != desc.file_size)
+                throw Exception(
+                    ErrorCodes::BAD_SIZE_OF_FILE_IN_DATA_PART,
+                    "Unexpected size of file {}, expected {} got {}",
+                    std::string(fs::path(part->getDataPartStorage().getRelativePath()) / file_name),
+                    desc.file_size, hashing_out.count());
+
+            writePODBinary(hashing_out.getHash(), out);
+
+            if (!file_names_without_checksums.contains(file_name))
+                data_checksums.addFile(file_name, hashing_out.count(), hashing_out.getHash());
+        }
     }
 
     if (!from_remote_disk && isFullPartStorage(part->getDataPartStorage()))
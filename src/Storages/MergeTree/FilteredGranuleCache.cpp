@@ -0,0 +1,11 @@
+#include <Storages/MergeTree/FilteredGranuleCache.h>
+
+namespace DB
+{
+template class CacheBase<UInt128, FilteredGranuleResult, UInt128TrivialHash, FilteredGranuleWeightFunction>;
+
+FilteredGranuleCache::FilteredGranuleCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio)
+    : Base(cache_policy, max_size_in_bytes, 0, size_ratio)
+{
+}
+}
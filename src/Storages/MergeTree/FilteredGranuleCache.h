@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+
+#include <Common/CacheBase.h>
+#include <Common/ProfileEvents.h>
+#include <Common/SipHash.h>
+#include <Common/HashTable/Hash.h>
+#include <Processors/Chunk.h>
+#include <Storages/MergeTree/MarkRange.h>
+
+
+namespace ProfileEvents
+{
+    extern const Event FilteredGranuleCacheHits;
+    extern const Event FilteredGranuleCacheMisses;
+}
+
+namespace DB
+{
+
+/// The decoded and filtered result of one read task: the chunks a MergeTree select processor
+/// produced for a fixed combination of part, mark ranges and filtering actions.
+struct FilteredGranuleResult
+{
+    Chunks chunks;
+};
+
+using FilteredGranuleResultPtr = std::shared_ptr<FilteredGranuleResult>;
+
+/// Estimate of number of bytes in cache for the result of one read task.
+struct FilteredGranuleWeightFunction
+{
+    /// We spent additional bytes on key in hashmap, linked lists, shared pointers, etc ...
+    static constexpr size_t FILTERED_GRANULE_CACHE_OVERHEAD = 128;
+
+    size_t operator()(const FilteredGranuleResult & result) const
+    {
+        size_t res = FILTERED_GRANULE_CACHE_OVERHEAD;
+        for (const auto & chunk : result.chunks)
+            res += chunk.allocatedBytes();
+        return res;
+    }
+};
+
+extern template class CacheBase<UInt128, FilteredGranuleResult, UInt128TrivialHash, FilteredGranuleWeightFunction>;
+/** Cache of decoded, PREWHERE-filtered ranges of MergeTree parts, one level above the
+  * uncompressed block cache: where the block cache saves the read and decompression but
+  * re-evaluates the filter on every query, this cache stores the surviving rows as columns.
+  * It pays off for repeated selective queries over the same immutable granules, e.g.
+  * dashboards re-running the same conditions every few seconds.
+  * Parts are identified by the total checksum, so entries of removed or mutated parts
+  * simply age out of the LRU.
+  */
+class FilteredGranuleCache : public CacheBase<UInt128, FilteredGranuleResult, UInt128TrivialHash, FilteredGranuleWeightFunction>
+{
+private:
+    using Base = CacheBase<UInt128, FilteredGranuleResult, UInt128TrivialHash, FilteredGranuleWeightFunction>;
+
+public:
+    FilteredGranuleCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio);
+
+    /// Calculate key from part checksum, the mark ranges of the task and a fingerprint of
+    /// everything that shapes the result: columns, filtering actions (including the values
+    /// of constants folded into them), deleted mask handling.
+    /// The block size participates because it determines how the result is split into chunks.
+    static UInt128 hash(
+        const UInt128 & part_checksum,
+        const MarkRanges & ranges,
+        UInt64 result_fingerprint,
+        bool apply_deleted_mask,
+        UInt64 max_block_size_rows)
+    {
+        SipHash hash;
+        hash.update(part_checksum);
+        for (const auto & range : ranges)
+        {
+            hash.update(range.begin);
+            hash.update(range.end);
+        }
+        hash.update(result_fingerprint);
+        hash.update(apply_deleted_mask);
+        hash.update(max_block_size_rows);
+        return hash.get128();
+    }
+
+    MappedPtr get(const Key & key)
+    {
+        auto result = Base::get(key);
+        if (result)
+            ProfileEvents::increment(ProfileEvents::FilteredGranuleCacheHits);
+        else
+            ProfileEvents::increment(ProfileEvents::FilteredGranuleCacheMisses);
+
+        return result;
+    }
+};
+
+using FilteredGranuleCachePtr = std::shared_ptr<FilteredGranuleCache>;
+
+}
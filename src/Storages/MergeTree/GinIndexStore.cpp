@@ -416,21 +416,29 @@ void GinIndexStoreDeserializer::readSegmentDictionary(UInt32 segment_id)
     dict_file_stream->readStrict(reinterpret_cast<char *>(it->second->offsets.getData().data()), fst_size);
 }
 
+std::vector<std::pair<UInt32, GinSegmentDictionaryPtr>> GinIndexStoreDeserializer::sortedSegmentDictionaries() const
+{
+    std::vector<std::pair<UInt32, GinSegmentDictionaryPtr>> result(store->segment_dictionaries.begin(), store->segment_dictionaries.end());
+    std::sort(result.begin(), result.end(), [](const auto & lhs, const auto & rhs)
+    {
+        return lhs.second->postings_start_offset < rhs.second->postings_start_offset;
+    });
+    return result;
+}
+
 GinSegmentedPostingsListContainer GinIndexStoreDeserializer::readSegmentedPostingsLists(const String & term)
 {
     assert(postings_file_stream != nullptr);
 
     GinSegmentedPostingsListContainer container;
-    for (auto const & seg_dict : store->segment_dictionaries)
+    for (const auto & [segment_id, seg_dict] : sortedSegmentDictionaries())
     {
-        auto segment_id = seg_dict.first;
-
-        auto [offset, found] = seg_dict.second->offsets.getOutput(term);
+        auto [offset, found] = seg_dict->offsets.getOutput(term);
         if (!found)
             continue;
 
         // Set postings file pointer for reading postings list
-        postings_file_stream->seek(seg_dict.second->postings_start_offset + offset, SEEK_SET);
+        postings_file_stream->seek(seg_dict->postings_start_offset + offset, SEEK_SET);
 
         // Read posting list
         auto postings_list = GinIndexPostingsBuilder::deserialize(*postings_file_stream);
@@ -441,15 +449,41 @@ GinSegmentedPostingsListContainer GinIndexStoreDeserializer::readSegmentedPostin
 
 GinPostingsCachePtr GinIndexStoreDeserializer::createPostingsCacheFromTerms(const std::vector<String> & terms)
 {
+    assert(postings_file_stream != nullptr);
+
     auto postings_cache = std::make_shared<GinPostingsCache>();
+
+    // Make sure don't read for duplicated terms
+    std::vector<const String *> unique_terms;
+    unique_terms.reserve(terms.size());
     for (const auto & term : terms)
+        if (postings_cache->try_emplace(term).second)
+            unique_terms.push_back(&term);
+
+    /// Read the postings file segment by segment instead of term by term: all terms are looked up
+    /// in the segment's FST at once and their postings lists are then read in file order, so the
+    /// whole pass does forward-only seeks no matter how many segments the part has accumulated.
+    for (const auto & [segment_id, seg_dict] : sortedSegmentDictionaries())
     {
-        // Make sure don't read for duplicated terms
-        if (postings_cache->find(term) != postings_cache->end())
-            continue;
+        using OffsetAndTerm = std::pair<UInt64, const String *>;
+        std::vector<OffsetAndTerm> offsets_of_found_terms;
+        offsets_of_found_terms.reserve(unique_terms.size());
+
+        for (const String * term : unique_terms)
+        {
+            auto [offset, found] = seg_dict->offsets.getOutput(*term);
+            if (found)
+                offsets_of_found_terms.emplace_back(offset, term);
+        }
+
+        std::sort(offsets_of_found_terms.begin(), offsets_of_found_terms.end());
 
-        auto container = readSegmentedPostingsLists(term);
-        (*postings_cache)[term] = container;
+        for (const auto & [offset, term] : offsets_of_found_terms)
+        {
+            postings_file_stream->seek(seg_dict->postings_start_offset + offset, SEEK_SET);
+            auto postings_list = GinIndexPostingsBuilder::deserialize(*postings_file_stream);
+            (*postings_cache)[*term][segment_id] = postings_list;
+        }
     }
     return postings_cache;
 }
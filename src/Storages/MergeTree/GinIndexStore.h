@@ -251,6 +251,10 @@ private:
     /// Initialize gin index files
     void initFileStreams();
 
+    /// Segment dictionaries of the store ordered by their position in the postings file,
+    /// so that postings lists can be read with forward-only seeks
+    std::vector<std::pair<UInt32, GinSegmentDictionaryPtr>> sortedSegmentDictionaries() const;
+
     /// The store for the reader
     GinIndexStorePtr store;
 
@@ -23,7 +23,10 @@
 #include <Parsers/parseQuery.h>
 #include <Parsers/queryToString.h>
 #include <Storages/ColumnsDescription.h>
+#include <Storages/MergeTree/LoadedMergeTreeDataPartInfoForReader.h>
 #include <Storages/MergeTree/MergeTreeData.h>
+#include <Storages/MergeTree/MergeTreeDataPartCompact.h>
+#include <Storages/MergeTree/MergeTreeMarksLoader.h>
 #include <Storages/MergeTree/PartMetadataManagerOrdinary.h>
 #include <Storages/MergeTree/checkDataPart.h>
 #include <Storages/MergeTree/Backup.h>
@@ -628,6 +631,50 @@ UInt64 IMergeTreeDataPart::getMarksCount() const
     return index_granularity.getMarksCount();
 }
 
+void IMergeTreeDataPart::loadMarksToCache(MarkCache * mark_cache) const
+{
+    if (!mark_cache || !getMarksCount())
+        return;
+
+    auto info_for_read = std::make_shared<LoadedMergeTreeDataPartInfoForReader>(shared_from_this(), std::make_shared<AlterConversions>());
+    auto read_settings = storage.getContext()->getReadSettings();
+
+    /// (stream name, number of columns in one mark of that stream)
+    std::vector<std::pair<String, size_t>> streams;
+
+    if (part_type == MergeTreeDataPartType::Compact)
+    {
+        streams.emplace_back(MergeTreeDataPartCompact::DATA_FILE_NAME, getColumns().size());
+    }
+    else
+    {
+        for (const auto & column : getColumns())
+        {
+            getSerialization(column.name)->enumerateStreams([&](const ISerialization::SubstreamPath & substream_path)
+            {
+                if (auto stream_name = getStreamNameForColumn(column, substream_path, checksums))
+                    streams.emplace_back(*stream_name, 1);
+            });
+        }
+    }
+
+    for (const auto & [stream_name, num_columns_in_mark] : streams)
+    {
+        MergeTreeMarksLoader loader(
+            info_for_read,
+            mark_cache,
+            index_granularity_info.getMarksFilePath(stream_name),
+            getMarksCount(),
+            index_granularity_info,
+            /* save_marks_in_cache= */ true,
+            read_settings,
+            /* load_marks_threadpool= */ nullptr,
+            num_columns_in_mark);
+
+        loader.loadMarks();
+    }
+}
+
 UInt64 IMergeTreeDataPart::getExistingBytesOnDisk() const
 {
     if (storage.getSettings()->exclude_deleted_rows_for_part_size_in_merge && supportLightweightDeleteMutate() && hasLightweightDelete()
@@ -677,7 +724,8 @@ ColumnsStatistics IMergeTreeDataPart::loadStatistics() const
 {
     const auto & metadata_snaphost = storage.getInMemoryMetadata();
 
-    auto total_statistics = MergeTreeStatisticsFactory::instance().getMany(metadata_snaphost.getColumns());
+    auto total_statistics = MergeTreeStatisticsFactory::instance().getMany(
+        metadata_snaphost.getColumns(), storage.getSettings()->auto_statistics);
 
     ColumnsStatistics result;
     for (auto & stat : total_statistics)
@@ -1636,6 +1684,19 @@ bool IMergeTreeDataPart::hasLightweightDelete() const
     return columns.contains(RowExistsColumn::name);
 }
 
+MergeTreeDeletedMaskSummaryPtr IMergeTreeDataPart::getDeletedMaskSummary() const
+{
+    std::lock_guard lock(deleted_mask_summary_mutex);
+    return deleted_mask_summary;
+}
+
+void IMergeTreeDataPart::setDeletedMaskSummary(MergeTreeDeletedMaskSummaryPtr summary) const
+{
+    /// Concurrent readers may build the summary simultaneously, the results are identical.
+    std::lock_guard lock(deleted_mask_summary_mutex);
+    deleted_mask_summary = std::move(summary);
+}
+
 void IMergeTreeDataPart::assertHasVersionMetadata(MergeTreeTransaction * txn) const
 {
     TransactionID expected_tid = txn ? txn->tid : Tx::PrehistoricTID;
@@ -50,6 +50,9 @@ class MergeTreeTransaction;
 struct MergeTreeReadTaskInfo;
 using MergeTreeReadTaskInfoPtr = std::shared_ptr<const MergeTreeReadTaskInfo>;
 
+struct MergeTreeDeletedMaskSummary;
+using MergeTreeDeletedMaskSummaryPtr = std::shared_ptr<const MergeTreeDeletedMaskSummary>;
+
 enum class DataPartRemovalState : uint8_t
 {
     NOT_ATTEMPTED,
@@ -235,6 +238,10 @@ public:
     /// When the part is removed from the working set. Changes once.
     mutable std::atomic<time_t> remove_time { std::numeric_limits<time_t>::max() };
 
+    /// Number of read tasks created over this part. In-memory only: resets when the part
+    /// is re-loaded. Used by the cost-based merge selector as a measure of read heat.
+    mutable std::atomic<UInt64> read_hits_count {0};
+
     /// If true, the destructor will delete the directory with the part.
     /// FIXME Why do we need this flag? What's difference from Temporary and DeleteOnDestroy state? Can we get rid of this?
     bool is_temp = false;
@@ -376,6 +383,10 @@ public:
     UInt64 getMarksCount() const;
     UInt64 getIndexSizeFromFile() const;
 
+    /// Load marks of all column streams of this part into the mark cache.
+    /// Used to warm up the cache at startup, see the prewarm_mark_cache setting.
+    void loadMarksToCache(MarkCache * mark_cache) const;
+
     UInt64 getBytesOnDisk() const { return bytes_on_disk; }
     UInt64 getBytesUncompressedOnDisk() const { return bytes_uncompressed_on_disk; }
     void setBytesOnDisk(UInt64 bytes_on_disk_) { bytes_on_disk = bytes_on_disk_; }
@@ -528,6 +539,12 @@ public:
     /// True if here is lightweight deleted mask file in part.
     bool hasLightweightDelete() const;
 
+    /// Per-granule summary of the lightweight delete mask, built lazily on the first read
+    /// of the part and kept alongside it. Returns nullptr while not built yet.
+    /// See MergeTreeDeletedMaskSummary.h.
+    MergeTreeDeletedMaskSummaryPtr getDeletedMaskSummary() const;
+    void setDeletedMaskSummary(MergeTreeDeletedMaskSummaryPtr summary) const;
+
     /// Read existing rows count from _row_exists column
     UInt64 readExistingRowsCount();
 
@@ -592,6 +609,10 @@ protected:
     mutable Index index TSA_GUARDED_BY(index_mutex);
     mutable bool index_loaded TSA_GUARDED_BY(index_mutex) = false;
 
+    /// Per-granule summary of the lightweight delete mask, see getDeletedMaskSummary().
+    mutable std::mutex deleted_mask_summary_mutex;
+    mutable MergeTreeDeletedMaskSummaryPtr deleted_mask_summary TSA_GUARDED_BY(deleted_mask_summary_mutex);
+
     /// Total size of all columns, calculated once in calcuateColumnSizesOnDisk
     ColumnSize total_columns_size;
 
@@ -1,5 +1,6 @@
 #include <Storages/MergeTree/KeyCondition.h>
 #include <Storages/MergeTree/BoolMask.h>
+#include <boost/container/small_vector.hpp>
 #include <DataTypes/DataTypesNumber.h>
 #include <DataTypes/DataTypeLowCardinality.h>
 #include <DataTypes/DataTypeNullable.h>
@@ -2664,7 +2665,9 @@ BoolMask KeyCondition::checkInHyperrectangle(
     const Hyperrectangle & hyperrectangle,
     const DataTypes & data_types) const
 {
-    std::vector<BoolMask> rpn_stack;
+    /// This function runs once per visited mark range, so the evaluation stack must not
+    /// allocate on each call. RPN of realistic conditions is shallow; 16 covers it inline.
+    boost::container::small_vector<BoolMask, 16> rpn_stack;
     for (const auto & element : rpn)
     {
         if (element.argument_num_of_space_filling_curve.has_value())
@@ -2690,23 +2693,22 @@ BoolMask KeyCondition::checkInHyperrectangle(
             const Range * key_range = &hyperrectangle[element.key_column];
 
             /// The case when the column is wrapped in a chain of possibly monotonic functions.
-            Range transformed_range = Range::createWholeUniverse();
+            std::optional<Range> transformed_range;
             if (!element.monotonic_functions_chain.empty())
             {
-                std::optional<Range> new_range = applyMonotonicFunctionsChainToRange(
+                transformed_range = applyMonotonicFunctionsChainToRange(
                     *key_range,
                     element.monotonic_functions_chain,
                     data_types[element.key_column],
                     single_point
                 );
 
-                if (!new_range)
+                if (!transformed_range)
                 {
                     rpn_stack.emplace_back(true, true);
                     continue;
                 }
-                transformed_range = *new_range;
-                key_range = &transformed_range;
+                key_range = &*transformed_range;
             }
 
             bool intersects = element.range.intersectsRange(*key_range);
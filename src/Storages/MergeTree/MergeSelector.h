@@ -42,6 +42,14 @@ public:
         /// Depth of tree of merges by which this part was created. New parts has zero level.
         unsigned level = 0;
 
+        /// Number of read tasks created over this part since it was loaded into memory.
+        /// Used by CostBasedMergeSelector to prefer compaction of read-hot parts.
+        size_t read_hits = 0;
+
+        /// Bytes of columns which are fully expired by column TTL, i.e. a merge
+        /// of this part is expected to drop at least that much data.
+        size_t bytes_expired_by_column_ttl = 0;
+
         /// Opaque pointer to avoid dependencies (it is not possible to do forward declaration of typedef).
         const void * data = nullptr;
 
@@ -7,6 +7,9 @@
 
 #include <Common/logger_useful.h>
 #include <Common/ActionBlocker.h>
+#include <Common/threadPoolCallbackRunner.h>
+#include <DataTypes/NestedUtils.h>
+#include <IO/ReadBufferFromFile.h>
 #include <Processors/Transforms/CheckSortedTransform.h>
 #include <Storages/MergeTree/DataPartStorageOnDiskFull.h>
 #include <Compression/CompressedWriteBuffer.h>
@@ -37,6 +40,13 @@
 #include <Interpreters/MergeTreeTransaction.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
 
+namespace CurrentMetrics
+{
+    extern const Metric MergeTreeVerticalMergeThreads;
+    extern const Metric MergeTreeVerticalMergeThreadsActive;
+    extern const Metric MergeTreeVerticalMergeThreadsScheduled;
+}
+
 namespace DB
 {
 
@@ -50,7 +60,8 @@ namespace ErrorCodes
 
 static ColumnsStatistics getStatisticsForColumns(
     const NamesAndTypesList & columns_to_read,
-    const StorageMetadataPtr & metadata_snapshot)
+    const StorageMetadataPtr & metadata_snapshot,
+    bool auto_statistics)
 {
     ColumnsStatistics all_statistics;
     const auto & all_columns = metadata_snapshot->getColumns();
@@ -63,6 +74,11 @@ static ColumnsStatistics getStatisticsForColumns(
             auto statistics = MergeTreeStatisticsFactory::instance().get(desc->statistics);
             all_statistics.push_back(std::move(statistics));
         }
+        else if (desc && auto_statistics)
+        {
+            if (auto statistics = MergeTreeStatisticsFactory::instance().tryGetAuto(desc->name, desc->type))
+                all_statistics.push_back(std::move(statistics));
+        }
     }
     return all_statistics;
 }
@@ -265,6 +281,29 @@ bool MergeTask::ExecuteAndFinalizeHorizontalPart::prepare()
 
     SerializationInfoByName infos(global_ctx->storage_columns, info_settings);
 
+    /// Respect per-column overrides of the sparse serialization threshold,
+    /// so that the kind chosen for the merged part matches the one chosen on inserts.
+    for (const auto & column : global_ctx->storage_columns)
+    {
+        if (!column.type->supportsSparseSerialization())
+            continue;
+
+        const auto column_desc = global_ctx->metadata_snapshot->getColumns().tryGetColumnDescription(
+            GetColumnsOptions(GetColumnsOptions::AllPhysical), column.getNameInStorage());
+
+        if (!column_desc)
+            continue;
+
+        if (const auto * value = column_desc->settings.tryGet("ratio_of_defaults_for_sparse_serialization"))
+        {
+            SerializationInfo::Settings column_settings{SettingFieldFloat(*value).value, true};
+            if (column_settings.isAlwaysDefault())
+                infos.erase(column.name);
+            else
+                infos[column.name] = column.type->createSerializationInfo(column_settings);
+        }
+    }
+
     for (const auto & part : global_ctx->future_part->parts)
     {
         global_ctx->new_data_part->ttl_infos.update(part->ttl_infos);
@@ -364,20 +403,78 @@ bool MergeTask::ExecuteAndFinalizeHorizontalPart::prepare()
     /// Also note, that it is better to do this here, since in other places it
     /// will be too late (i.e. they will be written, and we will burn CPU/disk
     /// resources for this).
-    if (!ctx->need_remove_expired_values)
     {
         auto part_serialization_infos = global_ctx->new_data_part->getSerializationInfos();
 
         NameSet columns_to_remove;
         for (auto & [column_name, ttl] : global_ctx->new_data_part->ttl_infos.columns_ttl)
         {
-            if (ttl.finished())
-            {
-                global_ctx->new_data_part->expired_columns.insert(column_name);
-                LOG_TRACE(ctx->log, "Adding expired column {} for part {}", column_name, global_ctx->new_data_part->name);
+            /// A column can be dropped without reading and writing its data if a previous merge
+            /// has already replaced all its values with defaults (ttl.finished()), or if the
+            /// ttl infos accumulated over the source parts prove that every value is expired,
+            /// so TTLColumnAlgorithm would replace the whole column with defaults anyway.
+            /// The latter check is reliable only if TTL was calculated for all source parts.
+            bool all_values_expired = !ctx->force_ttl && ttl.max && ttl.max <= global_ctx->time_of_merge;
+            if (ttl.finished() || all_values_expired)
                 columns_to_remove.insert(column_name);
-                part_serialization_infos.erase(column_name);
+        }
+
+        /// If TTLTransform is going to be used, it will evaluate the TTL expressions and the
+        /// defaults of the remaining columns over the merged stream, so everything they require
+        /// must stay in the merge schema.
+        if (ctx->need_remove_expired_values && !columns_to_remove.empty())
+        {
+            NameSet required_by_ttl;
+            auto add_required = [&](const TTLDescription & description)
+            {
+                for (const auto & required_column : description.expression_columns)
+                    required_by_ttl.insert(required_column.name);
+                for (const auto & required_column : description.where_expression_columns)
+                    required_by_ttl.insert(required_column.name);
+                required_by_ttl.insert(description.group_by_keys.begin(), description.group_by_keys.end());
+                for (const auto & set_part : description.set_parts)
+                    for (const auto & required_column : set_part.expression->getRequiredColumns())
+                        required_by_ttl.insert(required_column);
+                for (const auto & aggregate : description.aggregate_descriptions)
+                    required_by_ttl.insert(aggregate.argument_names.begin(), aggregate.argument_names.end());
+            };
+
+            if (global_ctx->metadata_snapshot->hasRowsTTL())
+                add_required(global_ctx->metadata_snapshot->getRowsTTL());
+            for (const auto & entry : global_ctx->metadata_snapshot->getRowsWhereTTLs())
+                add_required(entry);
+            for (const auto & entry : global_ctx->metadata_snapshot->getGroupByTTLs())
+                add_required(entry);
+            for (const auto & entry : global_ctx->metadata_snapshot->getMoveTTLs())
+                add_required(entry);
+            for (const auto & entry : global_ctx->metadata_snapshot->getRecompressionTTLs())
+                add_required(entry);
+
+            const auto & column_defaults = global_ctx->metadata_snapshot->getColumns().getDefaults();
+            for (const auto & [name, entry] : global_ctx->metadata_snapshot->getColumnTTLs())
+            {
+                /// TTLColumnAlgorithm does nothing for a column absent from the stream.
+                if (columns_to_remove.contains(name))
+                    continue;
+
+                add_required(entry);
+                if (auto it = column_defaults.find(name); it != column_defaults.end())
+                {
+                    IdentifierNameSet identifiers;
+                    it->second.expression->collectIdentifierNames(identifiers);
+                    required_by_ttl.insert(identifiers.begin(), identifiers.end());
+                }
             }
+
+            for (const auto & name : required_by_ttl)
+                columns_to_remove.erase(name);
+        }
+
+        for (const auto & column_name : columns_to_remove)
+        {
+            global_ctx->new_data_part->expired_columns.insert(column_name);
+            LOG_TRACE(ctx->log, "Adding expired column {} for part {}", column_name, global_ctx->new_data_part->name);
+            part_serialization_infos.erase(column_name);
         }
 
         if (!columns_to_remove.empty())
@@ -393,17 +490,36 @@ bool MergeTask::ExecuteAndFinalizeHorizontalPart::prepare()
         }
     }
 
+    global_ctx->write_settings = global_ctx->context->getWriteSettings();
+
+    /// As with min_merge_bytes_to_use_direct_io on the read side, do not let big merges displace
+    /// hot data of running queries from the page cache while the new part is written.
+    if (const auto min_bytes = global_ctx->data->getSettings()->min_merge_bytes_to_evict_from_page_cache; min_bytes != 0)
+    {
+        size_t total_size = 0;
+        for (const auto & part : global_ctx->future_part->parts)
+            total_size += part->getBytesOnDisk();
+
+        if (total_size >= min_bytes)
+        {
+            LOG_DEBUG(ctx->log, "Will evict merged part data from the page cache as it is written");
+            global_ctx->write_settings.evict_written_data_from_page_cache = true;
+        }
+    }
+
     global_ctx->to = std::make_shared<MergedBlockOutputStream>(
         global_ctx->new_data_part,
         global_ctx->metadata_snapshot,
         global_ctx->merging_columns,
         MergeTreeIndexFactory::instance().getMany(global_ctx->merging_skip_indexes),
-        getStatisticsForColumns(global_ctx->merging_columns, global_ctx->metadata_snapshot),
+        getStatisticsForColumns(global_ctx->merging_columns, global_ctx->metadata_snapshot, global_ctx->data->getSettings()->auto_statistics),
         ctx->compression_codec,
         global_ctx->txn ? global_ctx->txn->tid : Tx::PrehistoricTID,
         /*reset_columns=*/ true,
         ctx->blocks_are_granules_size,
-        global_ctx->context->getWriteSettings());
+        global_ctx->write_settings,
+        /*computed_index_granularity=*/ {},
+        /*is_merge=*/ true);
 
     global_ctx->rows_written = 0;
     ctx->initial_reservation = global_ctx->space_reservation ? global_ctx->space_reservation->getSize() : 0;
@@ -584,11 +700,13 @@ bool MergeTask::VerticalMergeStage::prepareVerticalMergeForAllColumns() const
     }
 
     ctx->max_delayed_streams = max_delayed_streams;
+    ctx->max_parallel_gathering_columns = std::max<size_t>(global_ctx->data->getSettings()->vertical_merge_max_parallel_columns, 1);
 
     bool all_parts_on_remote_disks = std::ranges::all_of(global_ctx->future_part->parts, [](const auto & part) { return part->isStoredOnRemoteDisk(); });
     ctx->use_prefetch = all_parts_on_remote_disks && global_ctx->data->getSettings()->vertical_merge_remote_filesystem_prefetch;
 
-    if (ctx->use_prefetch && ctx->it_name_and_type != global_ctx->gathering_columns.end())
+    /// With parallel gathering each column creates its own pipe on its own thread, there is nothing to prefetch for.
+    if (ctx->use_prefetch && ctx->max_parallel_gathering_columns <= 1 && ctx->it_name_and_type != global_ctx->gathering_columns.end())
         ctx->prepared_pipe = createPipeForReadingOneColumn(ctx->it_name_and_type->name);
 
     return false;
@@ -686,9 +804,11 @@ void MergeTask::VerticalMergeStage::prepareVerticalMergeForOneColumn() const
         columns_list,
         ctx->compression_codec,
         indexes_to_recalc,
-        getStatisticsForColumns(columns_list, global_ctx->metadata_snapshot),
+        getStatisticsForColumns(columns_list, global_ctx->metadata_snapshot, global_ctx->data->getSettings()->auto_statistics),
         &global_ctx->written_offset_columns,
-        global_ctx->to->getIndexGranularity());
+        global_ctx->to->getIndexGranularity(),
+        /*index_granularity_info_=*/ nullptr,
+        global_ctx->write_settings);
 
     ctx->column_elems_written = 0;
 }
@@ -749,6 +869,178 @@ void MergeTask::VerticalMergeStage::finalizeVerticalMergeForOneColumn() const
 }
 
 
+void MergeTask::VerticalMergeStage::executeVerticalMergeForAllColumnsInParallel() const
+{
+    /// Columns of one Nested structure share the offsets stream, so they must be gathered
+    /// sequentially by one thread: the first of them writes the offsets and the rest skip
+    /// them (see WrittenOffsetColumns). Group such columns together, every other column
+    /// forms a single-element group.
+    std::vector<NamesAndTypesList> column_groups;
+    std::unordered_map<String, size_t> nested_table_to_group;
+
+    for (auto it = ctx->it_name_and_type; it != global_ctx->gathering_columns.end(); ++it)
+    {
+        auto [nested_table, subcolumn] = Nested::splitName(it->name);
+        if (!subcolumn.empty())
+        {
+            auto [group_it, inserted] = nested_table_to_group.emplace(nested_table, column_groups.size());
+            if (inserted)
+                column_groups.emplace_back();
+            column_groups[group_it->second].push_back(*it);
+        }
+        else
+        {
+            column_groups.push_back(NamesAndTypesList{*it});
+        }
+    }
+
+    /// Every thread replays row sources from its own read buffer over the same temporary file.
+    const String rows_sources_file_path = ctx->rows_sources_uncompressed_write_buf->getFileName();
+
+    ThreadPool pool(
+        CurrentMetrics::MergeTreeVerticalMergeThreads,
+        CurrentMetrics::MergeTreeVerticalMergeThreadsActive,
+        CurrentMetrics::MergeTreeVerticalMergeThreadsScheduled,
+        ctx->max_parallel_gathering_columns,
+        /* max_free_threads_ */ 0,
+        column_groups.size());
+
+    ThreadPoolCallbackRunnerLocal<void> runner(pool, "VerticalMerge");
+
+    for (const auto & column_group : column_groups)
+    {
+        runner([this, &column_group, &rows_sources_file_path]
+        {
+            CompressedReadBufferFromFile rows_sources_read_buf(std::make_unique<ReadBufferFromFile>(rows_sources_file_path));
+            IMergedBlockOutputStream::WrittenOffsetColumns written_offset_columns;
+
+            for (const auto & name_and_type : column_group)
+                gatherColumn(name_and_type, rows_sources_read_buf, written_offset_columns);
+        });
+    }
+
+    runner.waitForAllToFinishAndRethrowFirstError();
+
+    ctx->it_name_and_type = global_ctx->gathering_columns.end();
+}
+
+
+void MergeTask::VerticalMergeStage::gatherColumn(
+    const NameAndTypePair & name_and_type,
+    CompressedReadBufferFromFile & rows_sources_read_buf,
+    IMergedBlockOutputStream::WrittenOffsetColumns & written_offset_columns) const
+{
+    const auto & column_name = name_and_type.name;
+
+    Pipe pipe = createPipeForReadingOneColumn(column_name);
+
+    rows_sources_read_buf.seek(0, 0);
+    bool is_result_sparse = global_ctx->new_data_part->getSerialization(column_name)->getKind() == ISerialization::Kind::SPARSE;
+
+    const auto data_settings = global_ctx->data->getSettings();
+    auto transform = std::make_unique<ColumnGathererTransform>(
+        pipe.getHeader(),
+        pipe.numOutputPorts(),
+        rows_sources_read_buf,
+        data_settings->merge_max_block_size,
+        data_settings->merge_max_block_size_bytes,
+        is_result_sparse);
+
+    pipe.addTransform(std::move(transform));
+
+    MergeTreeIndices indexes_to_recalc;
+    auto indexes_it = global_ctx->skip_indexes_by_column.find(column_name);
+
+    if (indexes_it != global_ctx->skip_indexes_by_column.end())
+    {
+        indexes_to_recalc = MergeTreeIndexFactory::instance().getMany(indexes_it->second);
+
+        pipe.addTransform(std::make_shared<ExpressionTransform>(
+            pipe.getHeader(),
+            indexes_it->second.getSingleExpressionForIndices(global_ctx->metadata_snapshot->getColumns(),
+            global_ctx->data->getContext())));
+
+        pipe.addTransform(std::make_shared<MaterializingTransform>(pipe.getHeader()));
+    }
+
+    QueryPipeline column_parts_pipeline(std::move(pipe));
+
+    /// MergeProgressCallback shares non-atomic state between invocations, so per-block progress
+    /// is not reported in parallel mode and 'progress' advances only when a column is finished.
+    column_parts_pipeline.disableProfileEventUpdate();
+
+    PullingPipelineExecutor executor(column_parts_pipeline);
+    NamesAndTypesList columns_list = {name_and_type};
+
+    std::unique_ptr<MergedColumnOnlyOutputStream> column_to;
+    {
+        /// The output stream reads and updates serialization infos of the new part in its constructor.
+        std::lock_guard lock(ctx->parallel_gathering_mutex);
+        column_to = std::make_unique<MergedColumnOnlyOutputStream>(
+            global_ctx->new_data_part,
+            global_ctx->metadata_snapshot,
+            columns_list,
+            ctx->compression_codec,
+            indexes_to_recalc,
+            getStatisticsForColumns(columns_list, global_ctx->metadata_snapshot, global_ctx->data->getSettings()->auto_statistics),
+            &written_offset_columns,
+            global_ctx->to->getIndexGranularity(),
+            /*index_granularity_info_=*/ nullptr,
+            global_ctx->write_settings);
+    }
+
+    size_t column_elems_written = 0;
+
+    Block block;
+    while (!global_ctx->merges_blocker->isCancelled() && !global_ctx->merge_list_element_ptr->is_cancelled.load(std::memory_order_relaxed)
+        && executor.pull(block))
+    {
+        column_elems_written += block.rows();
+        column_to->write(block);
+    }
+
+    if (global_ctx->merges_blocker->isCancelled() || global_ctx->merge_list_element_ptr->is_cancelled.load(std::memory_order_relaxed))
+        throw Exception(ErrorCodes::ABORTED, "Cancelled merging parts");
+
+    if (global_ctx->rows_written != column_elems_written)
+    {
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Written {} elements of column {}, but {} rows of PK columns",
+                        toString(column_elems_written), column_name, toString(global_ctx->rows_written));
+    }
+
+    UInt64 rows = 0;
+    UInt64 bytes = 0;
+    column_parts_pipeline.tryGetResultRowsAndBytes(rows, bytes);
+
+    std::list<std::unique_ptr<MergedColumnOnlyOutputStream>> streams_to_finish;
+    {
+        std::lock_guard lock(ctx->parallel_gathering_mutex);
+
+        /// fillChecksums updates columns and serialization infos of the new part, so it must be serialized too.
+        auto changed_checksums = column_to->fillChecksums(global_ctx->new_data_part, global_ctx->checksums_gathered_columns);
+        global_ctx->checksums_gathered_columns.add(std::move(changed_checksums));
+
+        global_ctx->merge_list_element_ptr->columns_written += 1;
+        global_ctx->merge_list_element_ptr->bytes_written_uncompressed += bytes;
+
+        auto & progress = global_ctx->merge_list_element_ptr->progress;
+        progress.store(progress.load(std::memory_order_relaxed) + ctx->column_sizes->columnWeight(column_name), std::memory_order_relaxed);
+
+        ctx->delayed_streams.emplace_back(std::move(column_to));
+
+        while (ctx->delayed_streams.size() > ctx->max_delayed_streams)
+        {
+            streams_to_finish.emplace_back(std::move(ctx->delayed_streams.front()));
+            ctx->delayed_streams.pop_front();
+        }
+    }
+
+    /// Finishing a stream writes the remaining data of the column to disk, do it outside of the lock.
+    for (auto & stream : streams_to_finish)
+        stream->finish(ctx->need_sync);
+}
+
+
 bool MergeTask::VerticalMergeStage::finalizeVerticalMergeForAllColumns() const
 {
     for (auto & stream : ctx->delayed_streams)
@@ -918,6 +1210,12 @@ bool MergeTask::VerticalMergeStage::executeVerticalMergeForAllColumns() const
     if (ctx->it_name_and_type == global_ctx->gathering_columns.end())
         return false;
 
+    if (ctx->max_parallel_gathering_columns > 1)
+    {
+        executeVerticalMergeForAllColumnsInParallel();
+        return false;
+    }
+
     switch (ctx->vertical_merge_one_column_state)
     {
         case VerticalMergeRuntimeContext::State::NEED_PREPARE:
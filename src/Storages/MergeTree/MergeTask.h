@@ -2,6 +2,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 
 #include <Common/filesystemHelpers.h>
 
@@ -194,6 +195,9 @@ private:
         MergeTreeTransactionPtr txn;
         bool need_prefix;
 
+        /// Write settings for the new part, shared by the horizontal and vertical stages.
+        WriteSettings write_settings;
+
         scope_guard temporary_directory_lock;
     };
 
@@ -302,6 +306,11 @@ private:
         std::optional<Pipe> prepared_pipe;
         size_t max_delayed_streams = 0;
         bool use_prefetch = false;
+        /// If greater than 1, columns are gathered concurrently on a thread pool instead of one by one.
+        size_t max_parallel_gathering_columns = 1;
+        /// Guards the state shared between threads gathering different columns:
+        /// checksums of the new part, delayed streams and merge list counters.
+        std::mutex parallel_gathering_mutex;
         std::list<std::unique_ptr<MergedColumnOnlyOutputStream>> delayed_streams;
         size_t column_elems_written{0};
         QueryPipeline column_parts_pipeline;
@@ -342,6 +351,12 @@ private:
         bool executeVerticalMergeForOneColumn() const;
         void finalizeVerticalMergeForOneColumn() const;
 
+        void executeVerticalMergeForAllColumnsInParallel() const;
+        void gatherColumn(
+            const NameAndTypePair & name_and_type,
+            CompressedReadBufferFromFile & rows_sources_read_buf,
+            IMergedBlockOutputStream::WrittenOffsetColumns & written_offset_columns) const;
+
         Pipe createPipeForReadingOneColumn(const String & column_name) const;
 
         VerticalMergeRuntimeContextPtr ctx;
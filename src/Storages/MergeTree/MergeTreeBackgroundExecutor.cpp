@@ -3,6 +3,7 @@
 
 #include <algorithm>
 
+#include <base/scope_guard.h>
 #include <Common/ThreadPool.h>
 #include <Common/setThreadName.h>
 #include <Common/Exception.h>
@@ -120,6 +121,28 @@ size_t MergeTreeBackgroundExecutor<Queue>::getMaxThreads() const
     return threads_count;
 }
 
+template <class Queue>
+void MergeTreeBackgroundExecutor<Queue>::setConcurrencyLimit(size_t new_limit)
+{
+    std::lock_guard lock(mutex);
+
+    if (new_limit == concurrency_limit)
+        return;
+
+    LOG_INFO(log, "Set concurrency limit for {}Executor to {} (0 means limited only by the number of threads)", name, new_limit);
+    concurrency_limit = new_limit;
+
+    /// If the limit was raised, some waiting threads may take tasks now.
+    has_tasks.notify_all();
+}
+
+template <class Queue>
+size_t MergeTreeBackgroundExecutor<Queue>::getConcurrencyLimit() const
+{
+    std::lock_guard lock(mutex);
+    return concurrency_limit;
+}
+
 template <class Queue>
 size_t MergeTreeBackgroundExecutor<Queue>::getMaxTasksCount() const
 {
@@ -336,15 +359,26 @@ void MergeTreeBackgroundExecutor<Queue>::threadFunction()
             TaskRuntimeDataPtr item;
             {
                 std::unique_lock lock(mutex);
-                has_tasks.wait(lock, [this]() TSA_REQUIRES(mutex) { return !pending.empty() || shutdown; });
+                has_tasks.wait(lock, [this]() TSA_REQUIRES(mutex)
+                {
+                    return shutdown || (!pending.empty() && (concurrency_limit == 0 || busy_threads < concurrency_limit));
+                });
 
                 if (shutdown)
                     break;
 
                 item = std::move(pending.pop());
                 active.push_back(item);
+                ++busy_threads;
             }
 
+            SCOPE_EXIT({
+                std::lock_guard guard(mutex);
+                --busy_threads;
+                if (concurrency_limit)
+                    has_tasks.notify_one();
+            });
+
             routine(std::move(item));
         }
         catch (...)
@@ -272,6 +272,14 @@ public:
 
     size_t getMaxThreads() const;
 
+    /// Limit on the number of threads that actually execute tasks. Unlike the number of threads
+    /// it can be both increased and decreased at runtime: excess threads just stop taking new
+    /// tasks from the pending queue, running steps are never interrupted. It allows to shift
+    /// capacity between background operations and queries without restarting the server.
+    /// Zero means that concurrency is limited only by the number of threads.
+    void setConcurrencyLimit(size_t new_limit);
+    size_t getConcurrencyLimit() const;
+
     /// This method can return stale value of max_tasks_count (no mutex locking).
     /// It's okay because amount of tasks can be only increased and getting stale value
     /// can lead only to some postponing, not logical error.
@@ -291,6 +299,8 @@ public:
 private:
     String name;
     size_t threads_count TSA_GUARDED_BY(mutex) = 0;
+    size_t busy_threads TSA_GUARDED_BY(mutex) = 0;
+    size_t concurrency_limit TSA_GUARDED_BY(mutex) = 0;
     std::atomic<size_t> max_tasks_count = 0;
     CurrentMetrics::Metric metric;
     CurrentMetrics::Increment max_tasks_metric;
@@ -68,6 +68,7 @@
 #include <Processors/QueryPlan/QueryIdHolder.h>
 #include <Processors/QueryPlan/ReadFromMergeTree.h>
 #include <Storages/AlterCommands.h>
+#include <Storages/MarkCache.h>
 #include <Storages/MergeTree/MergeTreeVirtualColumns.h>
 #include <Storages/Freeze.h>
 #include <Storages/MergeTree/DataPartStorageOnDiskFull.h>
@@ -139,6 +140,9 @@ namespace ProfileEvents
 namespace CurrentMetrics
 {
     extern const Metric DelayedInserts;
+    extern const Metric MergeTreeActiveDataBytes;
+    extern const Metric MergeTreeActiveDataRows;
+    extern const Metric MergeTreeActiveDataParts;
 }
 
 
@@ -431,6 +435,14 @@ MergeTreeData::MergeTreeData(
     };
 }
 
+MergeTreeData::~MergeTreeData()
+{
+    /// Remove the contribution of this table from the server-wide data volume counters.
+    /// After DROP TABLE we get here with zeros (dropAllData resets the volume), but after
+    /// DETACH TABLE the parts stay on disk and only the storage object is destroyed.
+    setDataVolume(0, 0, 0);
+}
+
 VirtualColumnsDescription MergeTreeData::createVirtuals(const StorageInMemoryMetadata & metadata)
 {
     VirtualColumnsDescription desc;
@@ -1443,7 +1455,13 @@ MergeTreeData::LoadPartResult MergeTreeData::loadDataPart(
 
     try
     {
-        res.part->loadColumnsChecksumsIndexes(require_part_metadata, true);
+        /// Consistency checks stat every file of the part. Outdated parts are not queryable
+        /// and are usually about to be removed, so on tables with heavy merge churn the checks
+        /// can be skipped to make the table queryable sooner after startup.
+        bool check_consistency = to_state == MergeTreeDataPartState::Active
+            || getSettings()->check_consistency_of_outdated_parts_on_startup;
+
+        res.part->loadColumnsChecksumsIndexes(require_part_metadata, check_consistency);
     }
     catch (...)
     {
@@ -1978,6 +1996,42 @@ void MergeTreeData::loadDataParts(bool skip_sanity_checks, std::optional<std::un
 
     LOG_DEBUG(log, "Loaded data parts ({} items)", data_parts_indexes.size());
     data_parts_loading_finished = true;
+
+    if (settings->prewarm_mark_cache)
+        prewarmMarkCache();
+}
+
+void MergeTreeData::prewarmMarkCache()
+{
+    auto * mark_cache = getContext()->getMarkCache().get();
+    if (!mark_cache)
+        return;
+
+    auto data_parts = getDataPartsVectorForInternalUsage();
+
+    /// The most recently written parts are the most likely to be read right after startup.
+    std::sort(data_parts.begin(), data_parts.end(), [](const auto & lhs, const auto & rhs)
+    {
+        return lhs->modification_time > rhs->modification_time;
+    });
+
+    Stopwatch watch;
+    size_t warmed_parts = 0;
+
+    /// Leave some room in the cache for marks loaded by actual queries.
+    const size_t size_budget = mark_cache->maxSizeInBytes() * 9 / 10;
+
+    for (const auto & part : data_parts)
+    {
+        if (mark_cache->sizeInBytes() >= size_budget)
+            break;
+
+        part->loadMarksToCache(mark_cache);
+        ++warmed_parts;
+    }
+
+    LOG_DEBUG(log, "Prewarmed mark cache with {} parts, {} in cache, took {} ms",
+        warmed_parts, formatReadableSizeWithBinarySuffix(mark_cache->sizeInBytes()), watch.elapsedMilliseconds());
 }
 
 void MergeTreeData::loadUnexpectedDataParts()
@@ -4483,6 +4537,18 @@ size_t MergeTreeData::getMaxOutdatedPartsCountForPartition() const
 }
 
 
+std::map<String, Int64> MergeTreeData::getPartitionDataVersions() const
+{
+    std::map<String, Int64> partition_versions;
+    for (const auto & part : getDataPartsVectorForInternalUsage())
+    {
+        auto & version = partition_versions[part->info.partition_id];
+        version = std::max({version, part->info.max_block, part->info.mutation});
+    }
+    return partition_versions;
+}
+
+
 std::optional<Int64> MergeTreeData::getMinPartDataVersion() const
 {
     auto lock = lockParts();
@@ -4550,7 +4616,8 @@ void MergeTreeData::delayInsertOrThrowIfNeeded(Poco::Event * until, const Contex
             ProfileEvents::increment(ProfileEvents::RejectedInserts);
             throw Exception(
                 ErrorCodes::TOO_MANY_PARTS,
-                "Too many parts ({} with average size of {}) in table '{}'. Merges are processing significantly slower than inserts",
+                "Too many parts ({} with average size of {}) in table '{}'. Merges are processing significantly slower than inserts. "
+                "Consider batching inserts on the client or enabling the async_insert setting to batch small inserts on the server",
                 parts_count_in_partition,
                 ReadableSize(average_part_size),
                 getLogName());
@@ -8139,13 +8206,23 @@ void MergeTreeData::increaseDataVolume(ssize_t bytes, ssize_t rows, ssize_t part
     total_active_size_bytes.fetch_add(bytes, std::memory_order_acq_rel);
     total_active_size_rows.fetch_add(rows, std::memory_order_acq_rel);
     total_active_size_parts.fetch_add(parts, std::memory_order_acq_rel);
+
+    /// Also push the deltas to the server-wide counters, so the total data volume
+    /// can be reported without iterating over all tables.
+    CurrentMetrics::add(CurrentMetrics::MergeTreeActiveDataBytes, bytes);
+    CurrentMetrics::add(CurrentMetrics::MergeTreeActiveDataRows, rows);
+    CurrentMetrics::add(CurrentMetrics::MergeTreeActiveDataParts, parts);
 }
 
 void MergeTreeData::setDataVolume(size_t bytes, size_t rows, size_t parts)
 {
-    total_active_size_bytes.store(bytes, std::memory_order_release);
-    total_active_size_rows.store(rows, std::memory_order_release);
-    total_active_size_parts.store(parts, std::memory_order_release);
+    size_t prev_bytes = total_active_size_bytes.exchange(bytes, std::memory_order_acq_rel);
+    size_t prev_rows = total_active_size_rows.exchange(rows, std::memory_order_acq_rel);
+    size_t prev_parts = total_active_size_parts.exchange(parts, std::memory_order_acq_rel);
+
+    CurrentMetrics::add(CurrentMetrics::MergeTreeActiveDataBytes, static_cast<Int64>(bytes) - static_cast<Int64>(prev_bytes));
+    CurrentMetrics::add(CurrentMetrics::MergeTreeActiveDataRows, static_cast<Int64>(rows) - static_cast<Int64>(prev_rows));
+    CurrentMetrics::add(CurrentMetrics::MergeTreeActiveDataParts, static_cast<Int64>(parts) - static_cast<Int64>(prev_parts));
 }
 
 bool MergeTreeData::insertQueryIdOrThrow(const String & query_id, size_t max_queries) const
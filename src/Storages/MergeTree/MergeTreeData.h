@@ -392,6 +392,8 @@ public:
                   LoadingStrictnessLevel mode,
                   BrokenPartCallback broken_part_callback_ = [](const String &){});
 
+    ~MergeTreeData() override;
+
     /// Build a block of minmax and count values of a MergeTree table. These values are extracted
     /// from minmax_indices, the first expression of primary key, and part rows.
     ///
@@ -461,6 +463,10 @@ public:
     /// Load the set of data parts from disk. Call once - immediately after the object is created.
     void loadDataParts(bool skip_sanity_checks, std::optional<std::unordered_set<std::string>> expected_parts);
 
+    /// Load marks of the most recently modified active parts into the mark cache,
+    /// newest parts first, until the cache is almost full. See the prewarm_mark_cache setting.
+    void prewarmMarkCache();
+
     String getLogName() const { return log.loadName(); }
 
     Int64 getMaxBlockNumber() const;
@@ -557,6 +563,11 @@ public:
 
     size_t getMaxOutdatedPartsCountForPartition() const;
 
+    /// Returns the maximum data version per partition over all active parts. The version of a partition grows
+    /// when it gains a new part (insert) or is mutated and does not change when parts are merged.
+    /// Used for version-based invalidation of cached query results and subquery sets.
+    std::map<String, Int64> getPartitionDataVersions() const;
+
     /// Get min value of part->info.getDataVersion() for all active parts.
     /// Makes sense only for ordinary MergeTree engines because for them block numbering doesn't depend on partition.
     std::optional<Int64> getMinPartDataVersion() const;
@@ -3,6 +3,7 @@
 #include <Storages/MergeTree/MergedBlockOutputStream.h>
 #include <Storages/MergeTree/MergedColumnOnlyOutputStream.h>
 #include <Storages/MergeTree/SimpleMergeSelector.h>
+#include <Storages/MergeTree/CostBasedMergeSelector.h>
 #include <Storages/MergeTree/AllMergeSelector.h>
 #include <Storages/MergeTree/TTLMergeSelector.h>
 #include <Storages/MergeTree/MergeList.h>
@@ -408,8 +409,14 @@ MergeTreeDataMergerMutator::MergeSelectingInfo MergeTreeDataMergerMutator::getPo
         part_info.size = part->getExistingBytesOnDisk();
         part_info.age = res.current_time - part->modification_time;
         part_info.level = part->info.level;
+        part_info.read_hits = part->read_hits_count.load(std::memory_order_relaxed);
         part_info.data = &part;
         part_info.ttl_infos = &part->ttl_infos;
+
+        for (const auto & [column, ttl_info] : part->ttl_infos.columns_ttl)
+            if (ttl_info.max && ttl_info.max <= res.current_time && !ttl_info.finished())
+                part_info.bytes_expired_by_column_ttl += part->getColumnSize(column).data_compressed;
+
         part_info.compression_codec_desc = part->default_codec->getFullCodecDesc();
         part_info.shall_participate_in_merges = has_volumes_with_disabled_merges ? part->shallParticipateInMerges(storage_policy) : true;
 
@@ -495,6 +502,23 @@ SelectPartsDecision MergeTreeDataMergerMutator::selectPartsToMergeFromRanges(
         }
     }
 
+    if (parts_to_merge.empty() && data_settings->enable_cost_based_merge_selector)
+    {
+        CostBasedMergeSelector::Settings merge_settings;
+        merge_settings.max_parts_to_merge_at_once = data_settings->max_parts_to_merge_at_once;
+        if (!data_settings->min_age_to_force_merge_on_partition_only)
+            merge_settings.min_age_to_force_merge = data_settings->min_age_to_force_merge_seconds;
+
+        if (aggressive)
+            merge_settings.base = 1;
+
+        parts_to_merge = CostBasedMergeSelector(merge_settings)
+                            .select(parts_ranges, max_total_size_to_merge);
+
+        if (parts_to_merge.size() == 1)
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "Merge selector returned only one part to merge");
+    }
+
     if (parts_to_merge.empty())
     {
         SimpleMergeSelector::Settings merge_settings;
@@ -1,6 +1,8 @@
 #include <Storages/MergeTree/MergeTreeDataPartWriterCompact.h>
 #include <Storages/MergeTree/MergeTreeDataPartCompact.h>
 
+#include <boost/algorithm/string.hpp>
+
 namespace DB
 {
 
@@ -54,6 +56,62 @@ MergeTreeDataPartWriterCompact::MergeTreeDataPartWriterCompact(
         marks_source_hashing = std::make_unique<HashingWriteBuffer>(*marks_compressor);
     }
 
+    if (const auto & groups_str = storage_settings_->compact_parts_column_groups.value; !groups_str.empty())
+    {
+        std::vector<String> groups;
+        boost::split(groups, groups_str, boost::is_any_of(";"));
+        for (const auto & group : groups)
+        {
+            std::vector<String> group_columns;
+            boost::split(group_columns, group, boost::is_any_of(","));
+
+            size_t columns_in_group = 0;
+            for (auto name : group_columns)
+            {
+                boost::trim(name);
+                /// The part may contain only a subset of the table columns (e.g. in a mutation).
+                if (!name.empty() && columns_list.contains(name))
+                    columns_in_group += column_name_to_group.emplace(name, group_streams.size()).second;
+            }
+
+            /// Streams are created lazily in addStreams.
+            if (columns_in_group)
+                group_streams.emplace_back();
+        }
+    }
+
+    /// Within a granule the members of one group must be written one after another,
+    /// so that they end up in the same compressed block.
+    std::vector<const NameAndTypePair *> columns_by_position;
+    columns_by_position.reserve(columns_list.size());
+    for (const auto & column : columns_list)
+        columns_by_position.push_back(&column);
+
+    write_column_order.reserve(columns_by_position.size());
+    std::vector<bool> is_ordered(columns_by_position.size(), false);
+    for (size_t i = 0; i < columns_by_position.size(); ++i)
+    {
+        if (is_ordered[i])
+            continue;
+
+        write_column_order.push_back(i);
+        is_ordered[i] = true;
+
+        auto group_it = column_name_to_group.find(columns_by_position[i]->name);
+        if (group_it == column_name_to_group.end())
+            continue;
+
+        for (size_t j = i + 1; j < columns_by_position.size(); ++j)
+        {
+            auto other_group_it = column_name_to_group.find(columns_by_position[j]->name);
+            if (other_group_it != column_name_to_group.end() && other_group_it->second == group_it->second)
+            {
+                write_column_order.push_back(j);
+                is_ordered[j] = true;
+            }
+        }
+    }
+
     for (const auto & column : columns_list)
     {
         auto compression = getCodecDescOrDefault(column.name, default_codec);
@@ -88,6 +146,22 @@ void MergeTreeDataPartWriterCompact::addStreams(const NameAndTypePair & name_and
         if (compressed_streams.contains(stream_name))
             return;
 
+        /// All substreams of all members of one group share a single stream, so the whole group
+        /// ends up in one compressed block per granule. The block is compressed with the codec
+        /// of the first member of the group for which a stream was requested.
+        if (auto group_it = column_name_to_group.find(name_and_type.name); group_it != column_name_to_group.end())
+        {
+            auto & stream = group_streams[group_it->second];
+            if (!stream)
+            {
+                auto group_codec = CompressionCodecFactory::instance().get(effective_codec_desc, nullptr, default_codec, true);
+                stream = std::make_shared<CompressedStream>(plain_hashing, group_codec);
+            }
+
+            compressed_streams.emplace(stream_name, stream);
+            return;
+        }
+
         const auto & subtype = substream_path.back().data.type;
         CompressionCodecPtr compression_codec;
 
@@ -223,13 +297,25 @@ void MergeTreeDataPartWriterCompact::writeDataBlock(const Block & block, const G
 {
     WriteBuffer & marks_out = marks_source_hashing ? *marks_source_hashing : *marks_file_hashing;
 
+    std::vector<const NameAndTypePair *> columns_by_position;
+    columns_by_position.reserve(columns_list.size());
+    for (const auto & column : columns_list)
+        columns_by_position.push_back(&column);
+
     for (const auto & granule : granules)
     {
         data_written = true;
 
-        auto name_and_type = columns_list.begin();
-        for (size_t i = 0; i < columns_list.size(); ++i, ++name_and_type)
+        /// Data of a granule may be written out of the order of columns in the part (members of one
+        /// column group are written together), while marks are always in the order of columns,
+        /// so they are buffered and written after the granule.
+        std::vector<std::pair<UInt64, UInt64>> marks_per_column(columns_by_position.size());
+
+        for (size_t pos = 0; pos < write_column_order.size(); ++pos)
         {
+            size_t column_position = write_column_order[pos];
+            const auto & name_and_type = columns_by_position[column_position];
+
             /// Tricky part, because we share compressed streams between different columns substreams.
             /// Compressed streams write data to the single file, but with different compression codecs.
             /// So we flush each stream (using next()) before using new one, because otherwise we will override
@@ -253,16 +339,36 @@ void MergeTreeDataPartWriterCompact::writeDataBlock(const Block & block, const G
                 return &result_stream->hashing_buf;
             };
 
+            /// Members of a group other than the first are addressed by the offset
+            /// within the shared (not yet flushed) compressed block.
+            UInt64 offset_in_decompressed_block = 0;
+            auto group_it = column_name_to_group.find(name_and_type->name);
+            if (group_it != column_name_to_group.end() && group_streams[group_it->second])
+                offset_in_decompressed_block = group_streams[group_it->second]->hashing_buf.offset();
 
-            writeBinaryLittleEndian(plain_hashing.count(), marks_out);
-            writeBinaryLittleEndian(static_cast<UInt64>(0), marks_out);
+            marks_per_column[column_position] = {plain_hashing.count(), offset_in_decompressed_block};
 
             writeColumnSingleGranule(
                 block.getByName(name_and_type->name), getSerialization(name_and_type->name),
                 stream_getter, granule.start_row, granule.rows_to_write);
 
+            /// Don't cut the compressed block if the next column continues the same group.
+            bool next_column_in_same_group = false;
+            if (group_it != column_name_to_group.end() && pos + 1 < write_column_order.size())
+            {
+                auto next_group_it = column_name_to_group.find(columns_by_position[write_column_order[pos + 1]]->name);
+                next_column_in_same_group = next_group_it != column_name_to_group.end() && next_group_it->second == group_it->second;
+            }
+
             /// Each type always have at least one substream
-            prev_stream->hashing_buf.next();
+            if (!next_column_in_same_group)
+                prev_stream->hashing_buf.next();
+        }
+
+        for (const auto & [offset_in_compressed_file, offset_in_decompressed_block] : marks_per_column)
+        {
+            writeBinaryLittleEndian(offset_in_compressed_file, marks_out);
+            writeBinaryLittleEndian(offset_in_decompressed_block, marks_out);
         }
 
         writeBinaryLittleEndian(granule.rows_to_write, marks_out);
@@ -285,9 +391,11 @@ void MergeTreeDataPartWriterCompact::fillDataChecksums(MergeTreeDataPartChecksum
     }
 
 #ifndef NDEBUG
-    /// Offsets should be 0, because compressed block is written for every granule.
+    /// Offsets should be 0, because compressed block is written for every granule (for every group of columns in case of column groups).
     for (const auto & [_, stream] : streams_by_codec)
         assert(stream->hashing_buf.offset() == 0);
+    for (const auto & stream : group_streams)
+        assert(!stream || stream->hashing_buf.offset() == 0);
 #endif
 
     WriteBuffer & marks_out = marks_source_hashing ? *marks_source_hashing : *marks_file_hashing;
@@ -308,6 +416,15 @@ void MergeTreeDataPartWriterCompact::fillDataChecksums(MergeTreeDataPartChecksum
         stream->compressed_buf.finalize();
     }
 
+    for (const auto & stream : group_streams)
+    {
+        if (!stream)
+            continue;
+
+        stream->hashing_buf.finalize();
+        stream->compressed_buf.finalize();
+    }
+
     plain_hashing.finalize();
 
     plain_file->next();
@@ -387,14 +504,21 @@ void MergeTreeDataPartWriterCompact::addToChecksums(MergeTreeDataPartChecksums &
     size_t uncompressed_size = 0;
     CityHash_v1_0_2::uint128 uncompressed_hash{0, 0};
 
-    for (const auto & [_, stream] : streams_by_codec)
+    auto update_uncompressed_checksum = [&](const CompressedStream & stream)
     {
-        uncompressed_size += stream->hashing_buf.count();
-        auto stream_hash = stream->hashing_buf.getHash();
+        uncompressed_size += stream.hashing_buf.count();
+        auto stream_hash = stream.hashing_buf.getHash();
         transformEndianness<std::endian::little>(stream_hash);
         uncompressed_hash = CityHash_v1_0_2::CityHash128WithSeed(
             reinterpret_cast<const char *>(&stream_hash), sizeof(stream_hash), uncompressed_hash);
-    }
+    };
+
+    for (const auto & [_, stream] : streams_by_codec)
+        update_uncompressed_checksum(*stream);
+
+    for (const auto & stream : group_streams)
+        if (stream)
+            update_uncompressed_checksum(*stream);
 
     checksums.files[data_file_name].is_compressed = true;
     checksums.files[data_file_name].uncompressed_size = uncompressed_size;
@@ -94,6 +94,17 @@ private:
     /// Stream for each column's substreams path (look at addStreams).
     std::unordered_map<String, CompressedStreamPtr> compressed_streams;
 
+    /// Columns declared in one group (compact_parts_column_groups storage setting) write the granule
+    /// data into a single shared compressed block: reading the group costs one decompression while
+    /// columns outside the group are not decompressed at all, and small inserts produce fewer
+    /// compressed blocks. Marks of group members differ only in the offset in decompressed block.
+    std::unordered_map<String, size_t> column_name_to_group;
+    std::vector<CompressedStreamPtr> group_streams;
+
+    /// Order of writing columns within a granule: members of one group are adjacent,
+    /// the rest keep their positions. Marks are always written in the order of columns_list.
+    std::vector<size_t> write_column_order;
+
     /// If marks are uncompressed, the data is written to 'marks_file_hashing' for hash calculation and then to the 'marks_file'.
     std::unique_ptr<WriteBufferFromFileBase> marks_file;
     std::unique_ptr<HashingWriteBuffer> marks_file_hashing;
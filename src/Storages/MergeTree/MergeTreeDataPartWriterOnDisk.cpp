@@ -234,8 +234,8 @@ size_t MergeTreeDataPartWriterOnDisk::computeIndexGranularity(const Block & bloc
 {
     return computeIndexGranularityImpl(
             block,
-            storage_settings->index_granularity_bytes,
-            storage_settings->index_granularity,
+            settings.index_granularity_bytes,
+            settings.index_granularity,
             settings.blocks_are_granules_size,
             settings.can_use_adaptive_granularity);
 }
@@ -5,9 +5,18 @@
 #include <DataTypes/Serializations/ISerialization.h>
 #include <Common/escapeForFileName.h>
 #include <Columns/ColumnSparse.h>
+#include <Common/CurrentMetrics.h>
 #include <Common/logger_useful.h>
+#include <Common/threadPoolCallbackRunner.h>
 #include <Storages/ColumnsDescription.h>
 
+namespace CurrentMetrics
+{
+    extern const Metric MergeTreePartFinalizeThreads;
+    extern const Metric MergeTreePartFinalizeThreadsActive;
+    extern const Metric MergeTreePartFinalizeThreadsScheduled;
+}
+
 namespace DB
 {
 
@@ -676,11 +685,39 @@ void MergeTreeDataPartWriterWide::fillDataChecksums(MergeTreeDataPartChecksums &
 
 void MergeTreeDataPartWriterWide::finishDataSerialization(bool sync)
 {
-    for (auto & stream : column_streams)
+    /// On remote disks finalizing a stream completes its multipart upload with a synchronous
+    /// request, so finishing the streams of a wide part with hundreds of columns one at a time
+    /// can take as long as writing the data. The streams are independent at this point.
+    size_t num_threads = std::min<size_t>(settings.max_stream_finalize_threads, column_streams.size());
+    if (num_threads > 1 && getDataPartStorage().isStoredOnRemoteDisk())
+    {
+        ThreadPool pool(
+            CurrentMetrics::MergeTreePartFinalizeThreads,
+            CurrentMetrics::MergeTreePartFinalizeThreadsActive,
+            CurrentMetrics::MergeTreePartFinalizeThreadsScheduled,
+            num_threads, 0, column_streams.size());
+
+        ThreadPoolCallbackRunnerLocal<void> runner(pool, "PartFinalize");
+        for (auto & stream : column_streams)
+        {
+            runner([&my_stream = *stream.second, sync]
+            {
+                my_stream.finalize();
+                if (sync)
+                    my_stream.sync();
+            });
+        }
+
+        runner.waitForAllToFinishAndRethrowFirstError();
+    }
+    else
     {
-        stream.second->finalize();
-        if (sync)
-            stream.second->sync();
+        for (auto & stream : column_streams)
+        {
+            stream.second->finalize();
+            if (sync)
+                stream.second->sync();
+        }
     }
 
     column_streams.clear();
@@ -10,6 +10,8 @@
 #include <Storages/MergeTree/MergeTreeDataPartUUID.h>
 #include <Storages/MergeTree/StorageFromMergeTreeDataPart.h>
 #include <Storages/MergeTree/MergeTreeIndexFullText.h>
+#include <Storages/MergeTree/SkippingIndexResultCache.h>
+#include <Storages/MergeTree/ApproximateNearestNeighborIndexCache.h>
 #include <Storages/ReadInOrderOptimizer.h>
 #include <Storages/VirtualColumnUtils.h>
 #include <Parsers/ASTIdentifier.h>
@@ -649,6 +651,12 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
     {
         auto mark_cache = context->getIndexMarkCache();
         auto uncompressed_cache = context->getIndexUncompressedCache();
+        auto skipping_index_result_cache = context->getSettingsRef().use_skipping_index_result_cache
+            ? context->getSkippingIndexResultCache()
+            : nullptr;
+        auto ann_index_cache = context->getSettingsRef().use_approximate_nearest_neighbor_index_cache
+            ? context->getApproximateNearestNeighborIndexCache()
+            : nullptr;
 
         auto process_part = [&](size_t part_index)
         {
@@ -698,12 +706,15 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
                 ranges.ranges = filterMarksUsingIndex(
                     index_and_condition.index,
                     index_and_condition.condition,
+                    index_and_condition.condition_hash,
                     part,
                     ranges.ranges,
                     settings,
                     reader_settings,
                     mark_cache.get(),
                     uncompressed_cache.get(),
+                    skipping_index_result_cache.get(),
+                    ann_index_cache.get(),
                     log);
 
                 stat.granules_dropped.fetch_add(total_granules - ranges.ranges.getNumberOfMarks(), std::memory_order_relaxed);
@@ -1334,7 +1345,9 @@ MarkRanges MergeTreeDataSelectExecutor::markRangesFromPKRange(
 }
 
 
-MarkRanges MergeTreeDataSelectExecutor::filterMarksUsingIndex(
+/// The actual evaluation of an index over the granules covered by `ranges`.
+/// Factored out of filterMarksUsingIndex so that the result can be cached.
+static MarkRanges filterMarksUsingIndexImpl(
     MergeTreeIndexPtr index_helper,
     MergeTreeIndexConditionPtr condition,
     MergeTreeData::DataPartPtr part,
@@ -1343,15 +1356,8 @@ MarkRanges MergeTreeDataSelectExecutor::filterMarksUsingIndex(
     const MergeTreeReaderSettings & reader_settings,
     MarkCache * mark_cache,
     UncompressedCache * uncompressed_cache,
-    LoggerPtr log)
+    ApproximateNearestNeighborIndexCache * ann_index_cache)
 {
-    if (!index_helper->getDeserializedFormat(part->getDataPartStorage(), index_helper->getFileName()))
-    {
-        LOG_DEBUG(log, "File for index {} does not exist ({}.*). Skipping it.", backQuote(index_helper->index.name),
-            (fs::path(part->getDataPartStorage().getFullPath()) / index_helper->getFileName()).string());
-        return ranges;
-    }
-
     auto index_granularity = index_helper->index.granularity;
 
     const size_t min_marks_for_seek = roundRowsOrBytesToMarks(
@@ -1392,19 +1398,43 @@ MarkRanges MergeTreeDataSelectExecutor::filterMarksUsingIndex(
     if (dynamic_cast<const MergeTreeIndexFullText *>(index_helper.get()))
         cache_in_store.store = GinIndexStoreFactory::instance().get(index_helper->getFileName(), part->getDataPartStoragePtr());
 
+    auto ann_condition = std::dynamic_pointer_cast<IMergeTreeIndexConditionApproximateNearestNeighbor>(condition);
+
+    /// Deserializing an ANN granule rebuilds the whole in-memory search structure, which dominates
+    /// the latency of repeated vector search queries, so these granules are kept in a dedicated cache.
+    const bool use_ann_index_cache = ann_condition != nullptr && ann_index_cache != nullptr;
+    UInt128 part_checksum{};
+    if (use_ann_index_cache)
+        part_checksum = part->checksums.getTotalChecksumUInt128();
+
     for (size_t i = 0; i < ranges.size(); ++i)
     {
         const MarkRange & index_range = index_ranges[i];
 
-        if (last_index_mark != index_range.begin || !granule)
+        if (!use_ann_index_cache && (last_index_mark != index_range.begin || !granule))
             reader.seek(index_range.begin);
 
         for (size_t index_mark = index_range.begin; index_mark < index_range.end; ++index_mark)
         {
             if (index_mark != index_range.begin || !granule || last_index_mark != index_range.begin)
-                reader.read(granule);
+            {
+                if (use_ann_index_cache)
+                {
+                    auto key = ApproximateNearestNeighborIndexCache::hash(part_checksum, index_helper->index.name, index_mark);
+                    granule = ann_index_cache->getOrSet(key, [&]
+                    {
+                        /// On a cache hit the reader stays untouched, so it has to be positioned
+                        /// explicitly before every read.
+                        reader.seek(index_mark);
+                        MergeTreeIndexGranulePtr loaded;
+                        reader.read(loaded);
+                        return loaded;
+                    });
+                }
+                else
+                    reader.read(granule);
+            }
 
-            auto ann_condition = std::dynamic_pointer_cast<IMergeTreeIndexConditionApproximateNearestNeighbor>(condition);
             if (ann_condition != nullptr)
             {
                 /// An array of indices of useful ranges.
@@ -1451,6 +1481,54 @@ MarkRanges MergeTreeDataSelectExecutor::filterMarksUsingIndex(
     return res;
 }
 
+MarkRanges MergeTreeDataSelectExecutor::filterMarksUsingIndex(
+    MergeTreeIndexPtr index_helper,
+    MergeTreeIndexConditionPtr condition,
+    UInt64 condition_hash,
+    MergeTreeData::DataPartPtr part,
+    const MarkRanges & ranges,
+    const Settings & settings,
+    const MergeTreeReaderSettings & reader_settings,
+    MarkCache * mark_cache,
+    UncompressedCache * uncompressed_cache,
+    SkippingIndexResultCache * skipping_index_result_cache,
+    ApproximateNearestNeighborIndexCache * ann_index_cache,
+    LoggerPtr log)
+{
+    if (!index_helper->getDeserializedFormat(part->getDataPartStorage(), index_helper->getFileName()))
+    {
+        LOG_DEBUG(log, "File for index {} does not exist ({}.*). Skipping it.", backQuote(index_helper->index.name),
+            (fs::path(part->getDataPartStorage().getFullPath()) / index_helper->getFileName()).string());
+        return ranges;
+    }
+
+    /// Parts are immutable, so for a fixed part, index and condition the set of dropped granules is
+    /// deterministic and can be reused across queries. Conditions which cannot be fingerprinted
+    /// (non-deterministic filters, or vector search, which depends on the query beyond the filter)
+    /// come with condition_hash = 0 and bypass the cache.
+    if (skipping_index_result_cache && condition_hash)
+    {
+        auto key = SkippingIndexResultCache::hash(
+            part->checksums.getTotalChecksumUInt128(),
+            index_helper->index.name,
+            condition_hash,
+            settings.merge_tree_min_rows_for_seek,
+            settings.merge_tree_min_bytes_for_seek,
+            ranges);
+
+        auto result = skipping_index_result_cache->getOrSet(key, [&]
+        {
+            return std::make_shared<MarkRanges>(filterMarksUsingIndexImpl(
+                index_helper, condition, part, ranges, settings, reader_settings, mark_cache, uncompressed_cache, ann_index_cache));
+        });
+
+        return *result;
+    }
+
+    return filterMarksUsingIndexImpl(
+        index_helper, condition, part, ranges, settings, reader_settings, mark_cache, uncompressed_cache, ann_index_cache);
+}
+
 MarkRanges MergeTreeDataSelectExecutor::filterMarksUsingMergedIndex(
     MergeTreeIndices indices,
     MergeTreeIndexMergedConditionPtr condition,
@@ -12,6 +12,8 @@ namespace DB
 {
 
 class KeyCondition;
+class SkippingIndexResultCache;
+class ApproximateNearestNeighborIndexCache;
 struct QueryIdHolder;
 
 using PartitionIdToMaxBlock = std::unordered_map<String, Int64>;
@@ -87,12 +89,15 @@ private:
     static MarkRanges filterMarksUsingIndex(
         MergeTreeIndexPtr index_helper,
         MergeTreeIndexConditionPtr condition,
+        UInt64 condition_hash,
         MergeTreeData::DataPartPtr part,
         const MarkRanges & ranges,
         const Settings & settings,
         const MergeTreeReaderSettings & reader_settings,
         MarkCache * mark_cache,
         UncompressedCache * uncompressed_cache,
+        SkippingIndexResultCache * skipping_index_result_cache,
+        ApproximateNearestNeighborIndexCache * ann_index_cache,
         LoggerPtr log);
 
     static MarkRanges filterMarksUsingMergedIndex(
@@ -471,7 +471,7 @@ MergeTreeDataWriter::TemporaryPart MergeTreeDataWriter::writeTempPartImpl(
 
     ColumnsStatistics statistics;
     if (context->getSettingsRef().materialize_statistics_on_insert)
-        statistics = MergeTreeStatisticsFactory::instance().getMany(metadata_snapshot->getColumns());
+        statistics = MergeTreeStatisticsFactory::instance().getMany(metadata_snapshot->getColumns(), data.getSettings()->auto_statistics);
 
     /// If we need to calculate some columns to sort.
     if (metadata_snapshot->hasSortingKey() || metadata_snapshot->hasSecondaryIndices())
@@ -550,6 +550,29 @@ MergeTreeDataWriter::TemporaryPart MergeTreeDataWriter::writeTempPartImpl(
 
     SerializationInfo::Settings settings{data_settings->ratio_of_defaults_for_sparse_serialization, true};
     SerializationInfoByName infos(columns, settings);
+
+    /// The sparse serialization threshold may be overridden at column level.
+    for (const auto & column : columns)
+    {
+        if (!column.type->supportsSparseSerialization())
+            continue;
+
+        const auto column_desc = metadata_snapshot->getColumns().tryGetColumnDescription(
+            GetColumnsOptions(GetColumnsOptions::AllPhysical), column.getNameInStorage());
+
+        if (!column_desc)
+            continue;
+
+        if (const auto * value = column_desc->settings.tryGet("ratio_of_defaults_for_sparse_serialization"))
+        {
+            SerializationInfo::Settings column_settings{SettingFieldFloat(*value).value, true};
+            if (column_settings.isAlwaysDefault())
+                infos.erase(column.name);
+            else
+                infos[column.name] = column.type->createSerializationInfo(column_settings);
+        }
+    }
+
     infos.add(block);
 
     new_data_part->setColumns(columns, infos, metadata_snapshot->getMetadataVersion());
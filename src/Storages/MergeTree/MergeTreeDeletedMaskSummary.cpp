@@ -0,0 +1,75 @@
+#include <Storages/MergeTree/MergeTreeDeletedMaskSummary.h>
+
+#include <Columns/ColumnsCommon.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/assert_cast.h>
+#include <Storages/MergeTree/IMergeTreeDataPart.h>
+#include <Storages/MergeTree/MergeTreeVirtualColumns.h>
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int LOGICAL_ERROR;
+}
+
+MergeTreeDeletedMaskSummaryPtr buildDeletedMaskSummary(
+    const MergeTreeReadTaskInfoPtr & read_info, const MergeTreeReadTask::Extras & extras)
+{
+    const auto & part = *read_info->data_part;
+    const size_t marks_count = part.index_granularity.getMarksCountWithoutFinal();
+
+    MarkRanges all_ranges{MarkRange(0, marks_count)};
+
+    auto reader = part.getReader(
+        {{RowExistsColumn::name, RowExistsColumn::type}},
+        extras.storage_snapshot,
+        all_ranges,
+        read_info->const_virtual_fields,
+        extras.uncompressed_cache,
+        extras.mark_cache,
+        read_info->alter_conversions,
+        extras.reader_settings,
+        {},
+        {});
+
+    auto summary = std::make_shared<MergeTreeDeletedMaskSummary>();
+    summary->mark_states.reserve(marks_count);
+
+    for (size_t mark = 0; mark < marks_count; ++mark)
+    {
+        const size_t rows_in_mark = part.index_granularity.getMarkRows(mark);
+
+        Columns columns(1);
+        const size_t num_read = reader->readRows(mark, marks_count, /* continue_reading */ mark != 0, rows_in_mark, columns);
+        if (num_read != rows_in_mark)
+            throw Exception(ErrorCodes::LOGICAL_ERROR,
+                "Read {} rows of the deleted mask instead of {} for mark {} of part {}",
+                num_read, rows_in_mark, mark, part.name);
+
+        const auto & mask = assert_cast<const ColumnUInt8 &>(*columns[0]).getData();
+        const size_t alive_rows = countBytesInFilter(mask);
+
+        using MarkState = MergeTreeDeletedMaskSummary::MarkState;
+        MarkState state = MarkState::SomeDeleted;
+        if (alive_rows == rows_in_mark)
+            state = MarkState::NoneDeleted;
+        else if (alive_rows == 0)
+            state = MarkState::AllDeleted;
+
+        summary->mark_states.push_back(state);
+        summary->num_deleted_rows += rows_in_mark - alive_rows;
+
+        if (state == MarkState::AllDeleted)
+            ++summary->num_fully_deleted_marks;
+        else if (!summary->not_fully_deleted_ranges.empty() && summary->not_fully_deleted_ranges.back().end == mark)
+            ++summary->not_fully_deleted_ranges.back().end;
+        else
+            summary->not_fully_deleted_ranges.emplace_back(mark, mark + 1);
+    }
+
+    return summary;
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <Storages/MergeTree/MarkRange.h>
+#include <Storages/MergeTree/MergeTreeReadTask.h>
+
+namespace DB
+{
+
+/** Per-granule summary of the lightweight delete mask (_row_exists) of a data part.
+  *
+  * Lightweight deletes materialize _row_exists as a regular column, so by default the mask
+  * is read and applied row by row on every scan, even in parts where no row is deleted or
+  * in granules where every row is. The summary classifies each granule once, is attached
+  * to the (immutable) part and reused by all subsequent reads:
+  *  - granules where all rows are deleted are dropped from read tasks entirely;
+  *  - parts without deleted rows skip reading the mask altogether;
+  *  - only granules with a mix of deleted and surviving rows pay for the residual filter.
+  *
+  * It takes one byte per granule, so for the default index granularity the whole summary
+  * of a part is ~8000x smaller than the mask itself.
+  */
+struct MergeTreeDeletedMaskSummary
+{
+    enum class MarkState : UInt8
+    {
+        NoneDeleted,
+        SomeDeleted,
+        AllDeleted,
+    };
+
+    /// One state per mark of the part.
+    std::vector<MarkState> mark_states;
+    size_t num_deleted_rows = 0;
+    size_t num_fully_deleted_marks = 0;
+
+    /// Mark ranges with at least one surviving row, coalesced.
+    /// Read tasks are intersected with these ranges, see MergeTreeSelectProcessor.
+    MarkRanges not_fully_deleted_ranges;
+
+    bool hasDeletedRows() const { return num_deleted_rows != 0; }
+    bool hasFullyDeletedMarks() const { return num_fully_deleted_marks != 0; }
+};
+
+using MergeTreeDeletedMaskSummaryPtr = std::shared_ptr<const MergeTreeDeletedMaskSummary>;
+
+/// Builds the summary by reading the _row_exists column over all marks of the part.
+/// Called on the first read task of a part with a lightweight delete, the result is
+/// stored on the part (see IMergeTreeDataPart::setDeletedMaskSummary).
+MergeTreeDeletedMaskSummaryPtr buildDeletedMaskSummary(
+    const MergeTreeReadTaskInfoPtr & read_info, const MergeTreeReadTask::Extras & extras);
+
+}
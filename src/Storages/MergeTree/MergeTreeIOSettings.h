@@ -13,6 +13,9 @@ namespace DB
 class MMappedFileCache;
 using MMappedFileCachePtr = std::shared_ptr<MMappedFileCache>;
 
+class FilteredGranuleCache;
+using FilteredGranuleCachePtr = std::shared_ptr<FilteredGranuleCache>;
+
 enum class CompactPartsReadMethod : uint8_t
 {
     SingleBuffer,
@@ -38,6 +41,9 @@ struct MergeTreeReaderSettings
     bool allow_different_codecs = false;
     /// Deleted mask is applied to all reads except internal select from mutate some part columns.
     bool apply_deleted_mask = true;
+    /// Build and use per-granule summaries of the deleted mask, see MergeTreeDeletedMaskSummary.h.
+    /// Off by default so that internal reads (mutations, merges) don't build summaries.
+    bool use_deleted_mask_summary = false;
     /// Put reading task in a common I/O pool, return Async state on prepare()
     bool use_asynchronous_read_from_pool = false;
     /// If PREWHERE has multiple conditions combined with AND, execute them in separate read/filtering steps.
@@ -46,6 +52,8 @@ struct MergeTreeReaderSettings
     bool adjust_read_buffer_size = true;
     /// If true, it's allowed to read the whole part without reading marks.
     bool can_read_part_without_marks = false;
+    /// Cache of decoded and filtered results of read tasks, nullptr if not used for this read.
+    FilteredGranuleCachePtr filtered_granule_cache;
 };
 
 struct MergeTreeWriterSettings
@@ -58,12 +66,22 @@ struct MergeTreeWriterSettings
         const MergeTreeSettingsPtr & storage_settings,
         bool can_use_adaptive_granularity_,
         bool rewrite_primary_key_,
-        bool blocks_are_granules_size_ = false)
+        bool blocks_are_granules_size_ = false,
+        bool is_merge_ = false)
         : min_compress_block_size(
             storage_settings->min_compress_block_size ? storage_settings->min_compress_block_size : global_settings.min_compress_block_size)
         , max_compress_block_size(
               storage_settings->max_compress_block_size ? storage_settings->max_compress_block_size
                                                         : global_settings.max_compress_block_size)
+        /// Merges may rewrite data with a coarser granularity than inserts to trade point lookup
+        /// latency on fresh parts for lower mark overhead on merged ones. Only adaptive granularity
+        /// can deviate from the table-wide value: for non-adaptive marks readers assume the fixed one.
+        , index_granularity(
+              is_merge_ && can_use_adaptive_granularity_ && storage_settings->merge_index_granularity
+                  ? storage_settings->merge_index_granularity : storage_settings->index_granularity)
+        , index_granularity_bytes(
+              is_merge_ && can_use_adaptive_granularity_ && storage_settings->merge_index_granularity_bytes
+                  ? storage_settings->merge_index_granularity_bytes : storage_settings->index_granularity_bytes)
         , marks_compression_codec(storage_settings->marks_compression_codec)
         , marks_compress_block_size(storage_settings->marks_compress_block_size)
         , compress_primary_key(storage_settings->compress_primary_key)
@@ -76,12 +94,16 @@ struct MergeTreeWriterSettings
         , max_threads_for_annoy_index_creation(global_settings.max_threads_for_annoy_index_creation)
         , low_cardinality_max_dictionary_size(global_settings.low_cardinality_max_dictionary_size)
         , low_cardinality_use_single_dictionary_for_part(global_settings.low_cardinality_use_single_dictionary_for_part != 0)
+        , max_stream_finalize_threads(storage_settings->max_stream_finalize_threads)
     {
     }
 
     size_t min_compress_block_size;
     size_t max_compress_block_size;
 
+    size_t index_granularity;
+    size_t index_granularity_bytes;
+
     String marks_compression_codec;
     size_t marks_compress_block_size;
 
@@ -98,6 +120,8 @@ struct MergeTreeWriterSettings
 
     size_t low_cardinality_max_dictionary_size;
     bool low_cardinality_use_single_dictionary_for_part;
+
+    size_t max_stream_finalize_threads = 1;
 };
 
 }
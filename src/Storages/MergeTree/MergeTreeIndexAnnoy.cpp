@@ -74,6 +74,13 @@ size_t AnnoyIndexWithSerialization<Distance>::getDimensions() const
     return Base::get_f();
 }
 
+template<typename Distance>
+size_t AnnoyIndexWithSerialization<Distance>::memoryUsage() const
+{
+    /// Annoy does not account its own memory usage, but the flat array of nodes dominates it.
+    return Base::_s * Base::_n_nodes;
+}
+
 
 template <typename Distance>
 MergeTreeIndexGranuleAnnoy<Distance>::MergeTreeIndexGranuleAnnoy(const String & index_name_, const Block & index_sample_block_)
@@ -105,7 +105,9 @@ void MergeTreeIndexGranuleMinMax::deserializeBinary(ReadBuffer & istr, MergeTree
                 throw Exception(ErrorCodes::LOGICAL_ERROR, "Unknown index version {}.", version);
         }
 
-        hyperrectangle.emplace_back(min_val, true, max_val, true);
+        /// Fields are moved to avoid copying the values: with String or Array columns in the index
+        /// expression a copy per granule adds up on parts with hundreds of thousands of granules.
+        hyperrectangle.emplace_back(std::move(min_val), true, std::move(max_val), true);
     }
 }
 
@@ -132,7 +134,12 @@ void MergeTreeIndexAggregatorMinMax::update(const Block & block, size_t * pos, s
     for (size_t i = 0; i < index_sample_block.columns(); ++i)
     {
         auto index_column_name = index_sample_block.getByPosition(i).name;
-        const auto & column = block.getByName(index_column_name).column->cut(*pos, rows_read);
+        ColumnPtr column = block.getByName(index_column_name).column;
+
+        /// Do not copy the column when the granule covers the whole block.
+        if (*pos != 0 || rows_read != column->size())
+            column = column->cut(*pos, rows_read);
+
         if (const auto * column_nullable = typeid_cast<const ColumnNullable *>(column.get()))
             column_nullable->getExtremesNullLast(field_min, field_max);
         else
@@ -140,14 +147,15 @@ void MergeTreeIndexAggregatorMinMax::update(const Block & block, size_t * pos, s
 
         if (hyperrectangle.size() <= i)
         {
-            hyperrectangle.emplace_back(field_min, true, field_max, true);
+            hyperrectangle.emplace_back(std::move(field_min), true, std::move(field_max), true);
         }
         else
         {
-            hyperrectangle[i].left
-                = applyVisitor(FieldVisitorAccurateLess(), hyperrectangle[i].left, field_min) ? hyperrectangle[i].left : field_min;
-            hyperrectangle[i].right
-                = applyVisitor(FieldVisitorAccurateLess(), hyperrectangle[i].right, field_max) ? field_max : hyperrectangle[i].right;
+            /// Update the bounds in place: the ternary form would copy the Field even when the bound is kept.
+            if (applyVisitor(FieldVisitorAccurateLess(), field_min, hyperrectangle[i].left))
+                hyperrectangle[i].left = std::move(field_min);
+            if (applyVisitor(FieldVisitorAccurateLess(), hyperrectangle[i].right, field_max))
+                hyperrectangle[i].right = std::move(field_max);
         }
     }
 
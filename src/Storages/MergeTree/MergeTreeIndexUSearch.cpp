@@ -86,6 +86,12 @@ size_t USearchIndexWithSerialization<Metric>::getDimensions() const
     return Base::dimensions();
 }
 
+template <unum::usearch::metric_kind_t Metric>
+size_t USearchIndexWithSerialization<Metric>::memoryUsage() const
+{
+    return Base::memory_usage();
+}
+
 template <unum::usearch::metric_kind_t Metric>
 MergeTreeIndexGranuleUSearch<Metric>::MergeTreeIndexGranuleUSearch(
     const String & index_name_,
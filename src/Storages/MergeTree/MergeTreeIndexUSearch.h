@@ -24,6 +24,7 @@ public:
     void serialize(WriteBuffer & ostr) const;
     void deserialize(ReadBuffer & istr);
     size_t getDimensions() const;
+    size_t memoryUsage() const;
 };
 
 template <unum::usearch::metric_kind_t Metric>
@@ -42,6 +43,7 @@ struct MergeTreeIndexGranuleUSearch final : public IMergeTreeIndexGranule
     void deserializeBinary(ReadBuffer & istr, MergeTreeIndexVersion version) override;
 
     bool empty() const override { return !index.get(); }
+    size_t memoryUsageBytes() const override { return index ? index->memoryUsage() : 0; }
 
     const String index_name;
     const Block index_sample_block;
@@ -59,6 +59,12 @@ struct IMergeTreeIndexGranule
     virtual void deserializeBinary(ReadBuffer & istr, MergeTreeIndexVersion version) = 0;
 
     virtual bool empty() const = 0;
+
+    /// Approximate amount of memory occupied by the deserialized granule.
+    /// Used to account granules in caches of deserialized granules
+    /// (see ApproximateNearestNeighborIndexCache). Index types whose granules
+    /// are not cached may keep the default.
+    virtual size_t memoryUsageBytes() const { return 0; }
 };
 
 using MergeTreeIndexGranulePtr = std::shared_ptr<IMergeTreeIndexGranule>;
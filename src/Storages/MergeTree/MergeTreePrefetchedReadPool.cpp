@@ -11,6 +11,7 @@
 #include <Storages/MergeTree/RangesInDataPart.h>
 #include <Storages/MergeTree/MergeTreeVirtualColumns.h>
 #include <base/getThreadId.h>
+#include <Common/ConcurrencyControl.h>
 #include <Common/ElapsedTimeProfileEventIncrement.h>
 #include <Common/logger_useful.h>
 #include <Common/FailPoint.h>
@@ -448,6 +449,26 @@ void MergeTreePrefetchedReadPool::fillPerThreadTasks(size_t threads, size_t sum_
         ? std::optional<size_t>(settings.filesystem_prefetches_limit)
         : std::nullopt;
 
+    /// The prefetch depth is sized for `threads` reading streams, but when the server is CPU
+    /// saturated, ConcurrencyControl will not let the query run that many threads and the
+    /// extra in-flight prefetches only pin memory and IO bandwidth ahead of consumers that do
+    /// not exist. Scale the budget down to the concurrency the query can realistically get.
+    if (allowed_prefetches_num && settings.use_concurrency_control)
+    {
+        SlotCount available_cpu_slots = ConcurrencyControl::instance().getAvailableSlots();
+        /// The current thread is already running, so at least one consumer exists.
+        if (available_cpu_slots < threads)
+        {
+            size_t achievable_threads = std::max<size_t>(1, available_cpu_slots + 1);
+            size_t scaled_prefetches_num = std::max(achievable_threads, *allowed_prefetches_num * achievable_threads / threads);
+            LOG_DEBUG(
+                log,
+                "Lowering prefetches limit from {} to {} ({} available CPU slots for {} reading threads)",
+                *allowed_prefetches_num, scaled_prefetches_num, available_cpu_slots, threads);
+            allowed_prefetches_num = scaled_prefetches_num;
+        }
+    }
+
     per_thread_tasks.clear();
     size_t total_tasks = 0;
 
@@ -4,6 +4,7 @@
 #include <Columns/FilterDescription.h>
 #include <Columns/ColumnConst.h>
 #include <Columns/ColumnsCommon.h>
+#include <Common/Stopwatch.h>
 #include <Common/TargetSpecific.h>
 #include <Common/logger_useful.h>
 #include <Core/UUID.h>
@@ -523,6 +524,19 @@ void MergeTreeRangeReader::ReadResult::optimize(const FilterWithCachedCount & cu
     NumRows zero_tails;
     auto total_zero_rows_in_tails = countZeroTails(filter.getData(), zero_tails, can_read_incomplete_granules);
 
+    /// Check if some granules are filtered out entirely. Skipping them is always worth it, even when
+    /// the total number of skippable rows is small: the next read step will not decompress such
+    /// granules at all, which matters a lot for wide columns read after PREWHERE.
+    bool has_fully_filtered_granules = false;
+    for (auto i : collections::range(0, rows_per_granule.size()))
+    {
+        if (rows_per_granule[i] > 0 && zero_tails[i] == rows_per_granule[i])
+        {
+            has_fully_filtered_granules = true;
+            break;
+        }
+    }
+
     LOG_TEST(log, "ReadResult::optimize() before: {}", dumpInfo());
 
     SCOPE_EXIT(
@@ -545,8 +559,9 @@ void MergeTreeRangeReader::ReadResult::optimize(const FilterWithCachedCount & cu
         setFilterConstTrue();
         return;
     }
-    /// Just a guess. If only a few rows may be skipped, it's better not to skip at all.
-    else if (2 * total_zero_rows_in_tails > filter.size())
+    /// Just a guess. If only a few rows may be skipped, it's better not to skip at all,
+    /// unless whole granules can be dropped from the following read steps.
+    else if (2 * total_zero_rows_in_tails > filter.size() || has_fully_filtered_granules)
     {
         const NumRows rows_per_granule_previous = rows_per_granule;
         const size_t total_rows_per_granule_previous = total_rows_per_granule;
@@ -1459,6 +1474,8 @@ void MergeTreeRangeReader::executePrewhereActionsAndFilterColumns(ReadResult & r
     if (!prewhere_info)
         return;
 
+    Stopwatch execution_watch;
+
     const auto & header = read_sample_block;
     size_t num_columns = header.columns();
 
@@ -1526,6 +1543,18 @@ void MergeTreeRangeReader::executePrewhereActionsAndFilterColumns(ReadResult & r
         size_t filter_column_pos = block.getPositionByName(prewhere_info->filter_column_name);
         auto current_step_filter = result.columns[filter_column_pos];
 
+        if (prewhere_info->runtime_stats)
+        {
+            FilterWithCachedCount filter_for_stats(current_step_filter);
+            size_t rows_passed = filter_for_stats.alwaysTrue() ? result.num_rows
+                : (filter_for_stats.alwaysFalse() ? 0 : filter_for_stats.countBytesInFilter());
+
+            auto & stats = *prewhere_info->runtime_stats;
+            stats.rows_read.fetch_add(result.num_rows, std::memory_order_relaxed);
+            stats.rows_passed.fetch_add(rows_passed, std::memory_order_relaxed);
+            stats.elapsed_ns.fetch_add(execution_watch.elapsed(), std::memory_order_relaxed);
+        }
+
         /// In case when we are returning prewhere column the caller expects it to serve as a final filter:
         /// it must contain 0s not only from the current step but also from all the previous steps.
         /// One way to achieve this is to apply the final_filter if we know that the final_filter was not applied at
@@ -38,6 +38,18 @@ struct PrewhereExprStep
     /// Some PREWHERE steps should be executed without conversions.
     /// A step without alter conversion cannot be executed after step with alter conversions.
     bool perform_alter_conversions = false;
+
+    /// Runtime selectivity and cost of this step, accumulated over all range readers of the
+    /// query that share it. Used to reorder independent filter steps between read tasks so
+    /// that the most selective cheap condition runs first.
+    struct RuntimeStats
+    {
+        std::atomic<UInt64> rows_read{0};
+        std::atomic<UInt64> rows_passed{0};
+        std::atomic<UInt64> elapsed_ns{0};
+    };
+
+    std::shared_ptr<RuntimeStats> runtime_stats = std::make_shared<RuntimeStats>();
 };
 
 using PrewhereExprStepPtr = std::shared_ptr<PrewhereExprStep>;
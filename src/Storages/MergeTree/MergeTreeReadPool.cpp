@@ -84,7 +84,7 @@ MergeTreeReadPool::MergeTreeReadPool(
         }
     }
 
-    fillPerThreadInfo(pool_settings.threads, pool_settings.sum_marks);
+    fillPerThreadInfo(pool_settings.threads);
 }
 
 MergeTreeReadTaskPtr MergeTreeReadPool::getTask(size_t task_idx, MergeTreeReadTask * previous_task)
@@ -215,7 +215,7 @@ void MergeTreeReadPool::profileFeedback(ReadBufferFromFileBase::ProfileInfo info
     LOG_DEBUG(log, "Will lower number of threads to {}", backoff_state.current_threads);
 }
 
-void MergeTreeReadPool::fillPerThreadInfo(size_t threads, size_t sum_marks)
+void MergeTreeReadPool::fillPerThreadInfo(size_t threads)
 {
     if (threads > 1000000ull)
         throw Exception(ErrorCodes::CANNOT_SCHEDULE_TASK, "Too many threads ({}) requested", threads);
@@ -257,18 +257,37 @@ void MergeTreeReadPool::fillPerThreadInfo(size_t threads, size_t sum_marks)
 
     LOG_DEBUG(log, "min_marks_for_concurrent_read={}", min_marks_for_concurrent_read);
 
-    const size_t min_marks_per_thread = (sum_marks - 1) / threads + 1;
+    /// Parts may have very different average row widths (e.g. after column TTLs or in tables
+    /// with per-tenant blobs), so an equal number of marks per thread may mean very unequal
+    /// amounts of bytes to read. Weight marks of each part with its average compressed bytes
+    /// per mark and give every thread an approximately equal number of bytes.
+    std::vector<size_t> per_part_avg_mark_bytes(parts_ranges.size(), 1);
+    size_t sum_bytes = 0;
+
+    for (size_t i = 0; i < parts_ranges.size(); ++i)
+    {
+        const auto & part = *parts_ranges[i].data_part;
+        if (size_t marks_count = part.getMarksCount())
+            per_part_avg_mark_bytes[i] = std::max<size_t>(getApproxSizeOfPart(part, column_names) / marks_count, 1);
+
+        sum_bytes += per_part_sum_marks[i] * per_part_avg_mark_bytes[i];
+    }
+
+    const size_t min_bytes_per_thread = (sum_bytes - 1) / threads + 1;
 
     for (size_t i = 0; i < threads && !parts_queue.empty(); ++i)
     {
-        auto need_marks = min_marks_per_thread;
+        auto need_bytes = min_bytes_per_thread;
 
-        while (need_marks > 0 && !parts_queue.empty())
+        while (need_bytes > 0 && !parts_queue.empty())
         {
             auto & current_parts = parts_queue.front();
             auto & part_with_ranges = current_parts.back().part;
             size_t & marks_in_part = current_parts.back().sum_marks;
             const auto part_idx = current_parts.back().part_idx;
+            const size_t avg_mark_bytes = per_part_avg_mark_bytes[part_idx];
+
+            size_t need_marks = std::max<size_t>(need_bytes / avg_mark_bytes, 1);
 
             /// Do not get too few rows from part.
             if (marks_in_part >= min_marks_for_concurrent_read &&
@@ -289,7 +308,6 @@ void MergeTreeReadPool::fillPerThreadInfo(size_t threads, size_t sum_marks)
                 ranges_to_get_from_part = part_with_ranges.ranges;
                 marks_in_ranges = marks_in_part;
 
-                need_marks -= marks_in_part;
                 current_parts.pop_back();
                 if (current_parts.empty())
                     parts_queue.pop();
@@ -320,6 +338,8 @@ void MergeTreeReadPool::fillPerThreadInfo(size_t threads, size_t sum_marks)
             threads_tasks[i].sum_marks_in_parts.push_back(marks_in_ranges);
             if (marks_in_ranges != 0)
                 remaining_thread_tasks.insert(i);
+
+            need_bytes -= std::min(need_bytes, marks_in_ranges * avg_mark_bytes);
         }
 
         /// Before processing next thread, change disk if possible.
@@ -75,7 +75,7 @@ public:
     };
 
 private:
-    void fillPerThreadInfo(size_t threads, size_t sum_marks);
+    void fillPerThreadInfo(size_t threads);
 
     mutable std::mutex mutex;
     size_t min_marks_for_concurrent_read = 0;
@@ -53,6 +53,7 @@ void MergeTreeReadPoolBase::fillPerPartInfos()
         MergeTreeReadTaskInfo read_task_info;
 
         read_task_info.data_part = part_with_ranges.data_part;
+        read_task_info.data_part->read_hits_count.fetch_add(1, std::memory_order_relaxed);
 
         const auto & data_part = read_task_info.data_part;
         if (data_part->isProjectionPart())
@@ -52,9 +52,26 @@ MergeTreeReadTaskPtr MergeTreeReadPoolInOrder::getTask(size_t task_idx, MergeTre
     MarkRanges mark_ranges_for_task;
     if (read_type == MergeTreeReadType::InReverseOrder)
     {
-        /// Read ranges from right to left.
-        mark_ranges_for_task.emplace_back(std::move(all_mark_ranges.back()));
-        all_mark_ranges.pop_back();
+        /// Read ranges from right to left, carving at most one task's worth of marks from the tail
+        /// of the last range. The select algorithm has to buffer the whole task before it can emit
+        /// chunks in reverse order, so handing out a long coalesced range as a single task would
+        /// both buffer it entirely in memory and prevent a LIMIT from short-circuiting. With one
+        /// granule per task for small limits, "latest N" queries finish right after the part's tail.
+        auto & range = all_mark_ranges.back();
+        const size_t max_marks_per_task = has_limit_below_one_block
+            ? 1
+            : std::max<size_t>(pool_settings.min_marks_for_concurrent_read, 1);
+
+        if (range.getNumberOfMarks() > max_marks_per_task)
+        {
+            mark_ranges_for_task.emplace_back(range.end - max_marks_per_task, range.end);
+            range.end -= max_marks_per_task;
+        }
+        else
+        {
+            mark_ranges_for_task.emplace_back(std::move(range));
+            all_mark_ranges.pop_back();
+        }
     }
     else if (has_limit_below_one_block)
     {
@@ -1,8 +1,13 @@
 #include <Storages/MergeTree/MergeTreeReadTask.h>
 #include <Storages/MergeTree/MergeTreeBlockReadUtils.h>
+#include <Storages/MergeTree/MergeTreeDeletedMaskSummary.h>
 #include <Storages/MergeTree/MergeTreeVirtualColumns.h>
+#include <Interpreters/ExpressionActions.h>
 #include <Common/Exception.h>
 
+#include <algorithm>
+#include <numeric>
+
 namespace DB
 {
 
@@ -34,6 +39,28 @@ MergeTreeReadTask::MergeTreeReadTask(
 {
 }
 
+bool MergeTreeReadTask::filterMarkRanges(const MarkRanges & allowed)
+{
+    if (range_readers.main.isInitialized())
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Cannot filter mark ranges after range readers are initialized");
+
+    /// Both sets of ranges are non-overlapping and sorted by the mark number.
+    MarkRanges result;
+    auto allowed_it = allowed.begin();
+
+    for (const auto & range : mark_ranges)
+    {
+        while (allowed_it != allowed.end() && allowed_it->end <= range.begin)
+            ++allowed_it;
+
+        for (auto it = allowed_it; it != allowed.end() && it->begin < range.end; ++it)
+            result.emplace_back(std::max(range.begin, it->begin), std::min(range.end, it->end));
+    }
+
+    mark_ranges = std::move(result);
+    return !mark_ranges.empty();
+}
+
 MergeTreeReadTask::Readers MergeTreeReadTask::createReaders(
     const MergeTreeReadTaskInfoPtr & read_info, const Extras & extras, const MarkRanges & ranges)
 {
@@ -58,7 +85,22 @@ MergeTreeReadTask::Readers MergeTreeReadTask::createReaders(
 
     /// Add lightweight delete filtering step
     if (extras.reader_settings.apply_deleted_mask && read_info->data_part->hasLightweightDelete())
-        new_readers.prewhere.push_back(create_reader({{RowExistsColumn::name, RowExistsColumn::type}}));
+    {
+        MergeTreeDeletedMaskSummaryPtr summary;
+        if (extras.reader_settings.use_deleted_mask_summary)
+        {
+            summary = read_info->data_part->getDeletedMaskSummary();
+            if (!summary)
+            {
+                summary = buildDeletedMaskSummary(read_info, extras);
+                read_info->data_part->setDeletedMaskSummary(summary);
+            }
+        }
+
+        /// If the summary proved that the part has no deleted rows, the mask does not need to be read at all.
+        if (!summary || summary->hasDeletedRows())
+            new_readers.prewhere.push_back(create_reader({{RowExistsColumn::name, RowExistsColumn::type}}));
+    }
 
     for (const auto & pre_columns_per_step : read_info->task_columns.pre_columns)
         new_readers.prewhere.push_back(create_reader(pre_columns_per_step));
@@ -66,6 +108,87 @@ MergeTreeReadTask::Readers MergeTreeReadTask::createReaders(
     return new_readers;
 }
 
+namespace
+{
+
+/// Compute the order in which PREWHERE steps (and their readers) will be chained for this task.
+/// Steps that proved more selective per unit of cost on the granules read so far are moved
+/// earlier, so later, more expensive steps see fewer rows.
+/// Only mutually independent filter steps are permuted: a step participates in reordering
+/// only if all columns its actions require are read by its own reader, its filter column is
+/// removed afterwards, and swapping runs only within ranges of steps with the same
+/// alter-conversions mode. Everything else keeps its original position as a barrier.
+std::vector<size_t> getPrewhereStepsOrder(
+    const MergeTreeReadTask::Readers & task_readers, const PrewhereExprInfo & prewhere_actions)
+{
+    const size_t num_steps = prewhere_actions.steps.size();
+
+    std::vector<size_t> order(num_steps);
+    std::iota(order.begin(), order.end(), 0);
+
+    /// Do not reorder until a meaningful sample of rows has been observed.
+    constexpr UInt64 min_rows_to_reorder = 16384;
+
+    auto is_reorderable = [&](size_t i)
+    {
+        const auto & step = *prewhere_actions.steps[i];
+        if (step.type != PrewhereExprStep::Filter || !step.actions || !step.remove_filter_column)
+            return false;
+
+        if (!step.runtime_stats || step.runtime_stats->rows_read.load(std::memory_order_relaxed) < min_rows_to_reorder)
+            return false;
+
+        /// The step must depend only on columns read by its own reader.
+        NameSet reader_columns;
+        for (const auto & column : task_readers.prewhere[i]->getColumns())
+            reader_columns.insert(column.name);
+
+        for (const auto & required_column : step.actions->getRequiredColumns())
+            if (!reader_columns.contains(required_column))
+                return false;
+
+        return true;
+    };
+
+    auto step_rank = [&](size_t i)
+    {
+        const auto & stats = *prewhere_actions.steps[i]->runtime_stats;
+        UInt64 rows_read = stats.rows_read.load(std::memory_order_relaxed);
+        UInt64 rows_passed = stats.rows_passed.load(std::memory_order_relaxed);
+        UInt64 elapsed_ns = stats.elapsed_ns.load(std::memory_order_relaxed);
+
+        double selectivity = rows_read ? static_cast<double>(rows_passed) / rows_read : 1.0;
+        double cost_per_row = rows_read ? static_cast<double>(elapsed_ns) / rows_read : 0.0;
+        return std::make_pair(selectivity, cost_per_row);
+    };
+
+    /// Sort each maximal contiguous run of reorderable steps with the same alter-conversions mode.
+    size_t run_begin = 0;
+    while (run_begin < num_steps)
+    {
+        if (!is_reorderable(run_begin))
+        {
+            ++run_begin;
+            continue;
+        }
+
+        size_t run_end = run_begin + 1;
+        while (run_end < num_steps
+            && is_reorderable(run_end)
+            && prewhere_actions.steps[run_end]->perform_alter_conversions == prewhere_actions.steps[run_begin]->perform_alter_conversions)
+            ++run_end;
+
+        std::stable_sort(order.begin() + run_begin, order.begin() + run_end,
+            [&](size_t lhs, size_t rhs) { return step_rank(lhs) < step_rank(rhs); });
+
+        run_begin = run_end;
+    }
+
+    return order;
+}
+
+}
+
 MergeTreeReadTask::RangeReaders
 MergeTreeReadTask::createRangeReaders(const Readers & task_readers, const PrewhereExprInfo & prewhere_actions)
 {
@@ -79,9 +202,12 @@ MergeTreeReadTask::createRangeReaders(const Readers & task_readers, const Prewhe
     MergeTreeRangeReader * prev_reader = nullptr;
     bool last_reader = false;
 
-    for (size_t i = 0; i < prewhere_actions.steps.size(); ++i)
+    auto steps_order = getPrewhereStepsOrder(task_readers, prewhere_actions);
+
+    for (size_t pos = 0; pos < steps_order.size(); ++pos)
     {
-        last_reader = task_readers.main->getColumns().empty() && (i + 1 == prewhere_actions.steps.size());
+        size_t i = steps_order[pos];
+        last_reader = task_readers.main->getColumns().empty() && (pos + 1 == steps_order.size());
 
         MergeTreeRangeReader current_reader(
             task_readers.prewhere[i].get(), prev_reader, prewhere_actions.steps[i].get(), last_reader, /*main_reader_=*/false);
@@ -130,10 +130,15 @@ public:
 
     void initializeRangeReaders(const PrewhereExprInfo & prewhere_actions);
 
+    /// Leave only the part of mark_ranges that intersects `allowed`. Used by runtime join filters.
+    /// May be called only before range readers are initialized. Returns false if no ranges are left.
+    bool filterMarkRanges(const MarkRanges & allowed);
+
     BlockAndProgress read(const BlockSizeParams & params);
     bool isFinished() const { return mark_ranges.empty() && range_readers.main.isCurrentRangeFinished(); }
 
     const MergeTreeReadTaskInfo & getInfo() const { return *info; }
+    const MarkRanges & getMarkRanges() const { return mark_ranges; }
     const MergeTreeRangeReader & getMainRangeReader() const { return range_readers.main; }
     const IMergeTreeReader & getMainReader() const { return *readers.main; }
 
@@ -1,7 +1,12 @@
 #include <Storages/MergeTree/MergeTreeSelectProcessor.h>
+#include <Storages/MergeTree/MergeTreeDataSelectExecutor.h>
 #include <Storages/MergeTree/MergeTreeRangeReader.h>
 #include <Storages/MergeTree/IMergeTreeDataPart.h>
 #include <Storages/MergeTree/MergeTreeBlockReadUtils.h>
+#include <Storages/MergeTree/FilteredGranuleCache.h>
+#include <Storages/MergeTree/MergeTreeDeletedMaskSummary.h>
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/Context.h>
 #include <Columns/FilterDescription.h>
 #include <Common/ElapsedTimeProfileEventIncrement.h>
 #include <Common/logger_useful.h>
@@ -114,6 +119,20 @@ ChunkAndProgress MergeTreeSelectProcessor::read()
 {
     while (!is_cancelled)
     {
+        if (!staged_chunks.empty())
+        {
+            /// Replay a task result taken from the filtered granule cache.
+            auto chunk = std::move(staged_chunks.front());
+            staged_chunks.pop_front();
+
+            size_t num_rows = chunk.getNumRows();
+            return ChunkAndProgress{
+                .chunk = std::move(chunk),
+                .num_read_rows = num_rows,
+                .num_read_bytes = 0,
+                .is_finished = false};
+        }
+
         try
         {
             if (!task || algorithm->needNewTask(*task))
@@ -130,7 +149,49 @@ ChunkAndProgress MergeTreeSelectProcessor::read()
         }
 
         if (!task->getMainRangeReader().isInitialized())
+        {
+            if (reader_settings.apply_deleted_mask && reader_settings.use_deleted_mask_summary)
+            {
+                auto summary = task->getInfo().data_part->getDeletedMaskSummary();
+                if (summary && summary->hasFullyDeletedMarks())
+                {
+                    if (!task->filterMarkRanges(summary->not_fully_deleted_ranges))
+                    {
+                        /// All rows in the mark ranges of the task are deleted.
+                        task.reset();
+                        continue;
+                    }
+                }
+            }
+
+            if (reader_settings.filtered_granule_cache)
+            {
+                filtered_granule_cache_key = computeFilteredGranuleCacheKey(*task);
+                accumulated_chunks.clear();
+
+                if (filtered_granule_cache_key)
+                {
+                    if (auto cached = reader_settings.filtered_granule_cache->get(*filtered_granule_cache_key))
+                    {
+                        for (const auto & chunk : cached->chunks)
+                            staged_chunks.push_back(chunk.clone());
+
+                        filtered_granule_cache_key.reset();
+                        task.reset();
+                        continue;
+                    }
+                }
+            }
+
+            if (!applyJoinRuntimeFilters(*task))
+            {
+                /// All mark ranges of the task are pruned by the runtime filters.
+                task.reset();
+                continue;
+            }
+
             initializeRangeReaders();
+        }
 
         auto res = algorithm->readFromTask(*task, block_size_params);
 
@@ -145,14 +206,21 @@ ChunkAndProgress MergeTreeSelectProcessor::read()
                 ordered_columns.push_back(res.block.getByName(name).column);
             }
 
+            Chunk chunk(ordered_columns, res.row_count, add_part_level ? std::make_shared<MergeTreePartLevelInfo>(task->getInfo().data_part->info.level) : nullptr);
+
+            if (filtered_granule_cache_key)
+                accumulated_chunks.push_back(chunk.clone());
+            commitTaskToFilteredGranuleCache();
+
             return ChunkAndProgress{
-                .chunk = Chunk(ordered_columns, res.row_count, add_part_level ? std::make_shared<MergeTreePartLevelInfo>(task->getInfo().data_part->info.level) : nullptr),
+                .chunk = std::move(chunk),
                 .num_read_rows = res.num_read_rows,
                 .num_read_bytes = res.num_read_bytes,
                 .is_finished = false};
         }
         else
         {
+            commitTaskToFilteredGranuleCache();
             return {Chunk(), res.num_read_rows, res.num_read_bytes, false};
         }
     }
@@ -160,11 +228,164 @@ ChunkAndProgress MergeTreeSelectProcessor::read()
     return {Chunk(), 0, 0, true};
 }
 
+void MergeTreeSelectProcessor::setJoinRuntimeFilters(JoinRuntimeFilters filters, StorageMetadataPtr metadata_snapshot_, ContextPtr context_)
+{
+    join_runtime_filters = std::move(filters);
+    metadata_snapshot = std::move(metadata_snapshot_);
+    context = std::move(context_);
+}
+
+void MergeTreeSelectProcessor::buildJoinRuntimeFilterCondition()
+{
+    join_runtime_filters_initialized = true;
+
+    auto dag = std::make_shared<ActionsDAG>();
+    ActionsDAG::NodeRawConstPtrs conjuncts;
+
+    for (const auto & filter : join_runtime_filters)
+    {
+        if (!filter->hasRows())
+        {
+            /// The build side is empty: no row of the probe side can have a match.
+            join_runtime_filters_prune_all = true;
+            return;
+        }
+
+        const auto & key = dag->addInput(filter->getProbeColumnName(), filter->getProbeColumnType());
+        const auto & min_node = dag->addColumn(ColumnWithTypeAndName(
+            filter->getBuildColumnType()->createColumnConst(1, filter->getMin()),
+            filter->getBuildColumnType(),
+            "__join_filter_min_" + filter->getProbeColumnName()));
+        const auto & max_node = dag->addColumn(ColumnWithTypeAndName(
+            filter->getBuildColumnType()->createColumnConst(1, filter->getMax()),
+            filter->getBuildColumnType(),
+            "__join_filter_max_" + filter->getProbeColumnName()));
+
+        conjuncts.push_back(&dag->addFunction(FunctionFactory::instance().get("greaterOrEquals", context), {&key, &min_node}, {}));
+        conjuncts.push_back(&dag->addFunction(FunctionFactory::instance().get("lessOrEquals", context), {&key, &max_node}, {}));
+    }
+
+    const auto * condition = conjuncts.size() == 1
+        ? conjuncts.front()
+        : &dag->addFunction(FunctionFactory::instance().get("and", context), std::move(conjuncts), {});
+    dag->getOutputs() = {condition};
+
+    const auto & primary_key = metadata_snapshot->getPrimaryKey();
+    join_runtime_filters_condition.emplace(dag, context, primary_key.column_names, primary_key.expression);
+
+    LOG_DEBUG(log, "Using runtime join filter condition: {}", join_runtime_filters_condition->toString());
+}
+
+bool MergeTreeSelectProcessor::applyJoinRuntimeFilters(MergeTreeReadTask & current_task)
+{
+    if (join_runtime_filters.empty())
+        return true;
+
+    if (!join_runtime_filters_initialized)
+    {
+        /// Normally all filters are ready before the first probe-side read happens.
+        /// If the scan is used outside of a join for some reason, read everything.
+        for (const auto & filter : join_runtime_filters)
+            if (!filter->isReady())
+                return true;
+
+        buildJoinRuntimeFilterCondition();
+    }
+
+    if (join_runtime_filters_prune_all)
+        return false;
+
+    if (!join_runtime_filters_condition)
+        return true;
+
+    auto allowed_ranges = MergeTreeDataSelectExecutor::markRangesFromPKRange(
+        current_task.getInfo().data_part,
+        metadata_snapshot,
+        *join_runtime_filters_condition,
+        /*part_offset_condition=*/ {},
+        /*exact_ranges=*/ nullptr,
+        context->getSettingsRef(),
+        log);
+
+    return current_task.filterMarkRanges(allowed_ranges);
+}
+
+std::optional<UInt128> MergeTreeSelectProcessor::computeFilteredGranuleCacheKey(const MergeTreeReadTask & current_task) const
+{
+    /// Runtime join filters prune mark ranges per query, so the result is not reusable.
+    if (!join_runtime_filters.empty())
+        return std::nullopt;
+
+    const auto & info = current_task.getInfo();
+
+    /// On-fly alter conversions make the result differ from what is stored under this checksum.
+    if (info.alter_conversions && !info.alter_conversions->getRenameMap().empty())
+        return std::nullopt;
+
+    /// Values of virtual columns like _part_index depend on the set of parts in this query.
+    if (!info.const_virtual_fields.empty())
+        return std::nullopt;
+
+    SipHash fingerprint;
+
+    /// The part name participates for the _part virtual column: two parts with identical
+    /// content (and so identical checksums) must not share an entry.
+    fingerprint.update(info.data_part->name);
+    fingerprint.update(result_header.dumpStructure());
+
+    /// The fingerprint of the PREWHERE actions covers the values of folded constants: the
+    /// result name of e.g. now() stays the same between queries while its value changes.
+    /// Results of non-deterministic functions (e.g. rand()) must not be reused at all.
+    for (const auto & step : prewhere_actions.steps)
+    {
+        if (step->actions)
+        {
+            const auto & dag = step->actions->getActionsDAG();
+            if (dag.hasNonDeterministic())
+                return std::nullopt;
+            dag.updateHash(fingerprint);
+        }
+
+        fingerprint.update(step->filter_column_name);
+        fingerprint.update(step->remove_filter_column);
+        fingerprint.update(step->need_filter);
+    }
+
+    return FilteredGranuleCache::hash(
+        info.data_part->checksums.getTotalChecksumUInt128(),
+        current_task.getMarkRanges(),
+        fingerprint.get64(),
+        reader_settings.apply_deleted_mask,
+        block_size_params.max_block_size_rows);
+}
+
+void MergeTreeSelectProcessor::commitTaskToFilteredGranuleCache()
+{
+    if (!filtered_granule_cache_key || !task->isFinished())
+        return;
+
+    reader_settings.filtered_granule_cache->set(
+        *filtered_granule_cache_key,
+        std::make_shared<FilteredGranuleResult>(FilteredGranuleResult{std::move(accumulated_chunks)}));
+
+    filtered_granule_cache_key.reset();
+    accumulated_chunks.clear();
+}
+
 void MergeTreeSelectProcessor::initializeRangeReaders()
 {
     PrewhereExprInfo all_prewhere_actions;
     if (lightweight_delete_filter_step && task->getInfo().data_part->hasLightweightDelete())
-        all_prewhere_actions.steps.push_back(lightweight_delete_filter_step);
+    {
+        /// If the summary proved that the part has no deleted rows, the mask reader was not
+        /// created and the filtering step must be skipped as well, see MergeTreeReadTask::createReaders().
+        MergeTreeDeletedMaskSummaryPtr summary;
+        if (reader_settings.use_deleted_mask_summary)
+            summary = task->getInfo().data_part->getDeletedMaskSummary();
+
+        if (!summary || summary->hasDeletedRows())
+            all_prewhere_actions.steps.push_back(lightweight_delete_filter_step);
+    }
 
     for (const auto & step : prewhere_actions.steps)
         all_prewhere_actions.steps.push_back(step);
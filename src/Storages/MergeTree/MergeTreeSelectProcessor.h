@@ -1,10 +1,14 @@
 #pragma once
+#include <Interpreters/JoinRuntimeFilter.h>
+#include <Storages/MergeTree/KeyCondition.h>
 #include <Storages/MergeTree/MergeTreeData.h>
 #include <Storages/MergeTree/RequestResponse.h>
 #include <Storages/MergeTree/MergeTreeReadTask.h>
 #include <Storages/MergeTree/IMergeTreeReadPool.h>
 #include <Storages/MergeTree/MergeTreeSelectAlgorithms.h>
 #include <boost/core/noncopyable.hpp>
+#include <deque>
+#include <optional>
 
 
 namespace DB
@@ -59,10 +63,29 @@ public:
 
     void addPartLevelToChunk(bool add_part_level_) { add_part_level = add_part_level_; }
 
+    /// Attach runtime filters built from the join build side. Once the filters become
+    /// ready, mark ranges whose primary key range cannot match are skipped.
+    void setJoinRuntimeFilters(JoinRuntimeFilters filters, StorageMetadataPtr metadata_snapshot_, ContextPtr context_);
+
 private:
     /// Sets up range readers corresponding to data readers
     void initializeRangeReaders();
 
+    /// Prunes mark ranges of a fresh task with the runtime join filters.
+    /// Returns false if the whole task was pruned.
+    bool applyJoinRuntimeFilters(MergeTreeReadTask & current_task);
+
+    /// Builds the key condition from the ready runtime filters (once).
+    void buildJoinRuntimeFilterCondition();
+
+    /// Computes the filtered granule cache key of a fresh task,
+    /// or std::nullopt if the result of the task must not be cached.
+    std::optional<UInt128> computeFilteredGranuleCacheKey(const MergeTreeReadTask & current_task) const;
+
+    /// Stores the accumulated result of the current task into the filtered granule cache
+    /// once the task is finished. Unfinished tasks (e.g. on cancellation) are never stored.
+    void commitTaskToFilteredGranuleCache();
+
     const MergeTreeReadPoolPtr pool;
     const MergeTreeSelectAlgorithmPtr algorithm;
 
@@ -83,6 +106,22 @@ private:
     /// Should we add part level to produced chunk. Part level is useful for next steps if query has FINAL
     bool add_part_level = false;
 
+    /// Chunks taken from the filtered granule cache, returned from read() instead of reading.
+    std::deque<Chunk> staged_chunks;
+    /// Key of the task whose result is being accumulated for the filtered granule cache.
+    std::optional<UInt128> filtered_granule_cache_key;
+    /// Result chunks of the current task accumulated for the filtered granule cache.
+    Chunks accumulated_chunks;
+
+    /// Runtime filters from the build side of a hash join, see setJoinRuntimeFilters().
+    JoinRuntimeFilters join_runtime_filters;
+    StorageMetadataPtr metadata_snapshot;
+    ContextPtr context;
+    bool join_runtime_filters_initialized = false;
+    /// The build side is empty, so nothing on the probe side can match.
+    bool join_runtime_filters_prune_all = false;
+    std::optional<KeyCondition> join_runtime_filters_condition;
+
     LoggerPtr log = getLogger("MergeTreeSelectProcessor");
     std::atomic<bool> is_cancelled{false};
 };
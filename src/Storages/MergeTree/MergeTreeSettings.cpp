@@ -219,7 +219,8 @@ void MergeTreeColumnSettings::validate(const SettingsChanges & changes)
     static const std::set<String> allowed_column_level_settings =
     {
         "min_compress_block_size",
-        "max_compress_block_size"
+        "max_compress_block_size",
+        "ratio_of_defaults_for_sparse_serialization"
     };
 
     for (const auto & change : changes)
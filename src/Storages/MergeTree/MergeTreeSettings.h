@@ -37,12 +37,16 @@ struct Settings;
     M(Float, ratio_of_defaults_for_sparse_serialization, 0.9375f, "Minimal ratio of number of default values to number of all values in column to store it in sparse serializations. If >= 1, columns will be always written in full serialization.", 0) \
     M(Bool, replace_long_file_name_to_hash, true, "If the file name for column is too long (more than 'max_file_name_length' bytes) replace it to SipHash128", 0) \
     M(UInt64, max_file_name_length, 127, "The maximal length of the file name to keep it as is without hashing", 0) \
+    M(Bool, auto_statistics, false, "Automatically build tdigest and uniq statistics on inserts and merges for all columns of supported types, without STATISTICS declarations in the table definition. The statistics are stored in the parts and consumed by the condition selectivity estimator (see allow_statistics_optimize).", 0) \
     M(UInt64, min_bytes_for_full_part_storage, 0, "Only available in ClickHouse Cloud", 0) \
     M(UInt64, min_rows_for_full_part_storage, 0, "Only available in ClickHouse Cloud", 0) \
     M(UInt64, compact_parts_max_bytes_to_buffer, 128 * 1024 * 1024, "Only available in ClickHouse Cloud", 0) \
     M(UInt64, compact_parts_max_granules_to_buffer, 128, "Only available in ClickHouse Cloud", 0) \
     M(UInt64, compact_parts_merge_max_bytes_to_prefetch_part, 16 * 1024 * 1024, "Only available in ClickHouse Cloud", 0) \
+    M(String, compact_parts_column_groups, "", "Semicolon-separated groups of comma-separated column names, e.g. 'a,b;c,d'. Columns of one group share a single compressed block per granule in compact parts: small inserts produce fewer compressed blocks and reading the group costs one decompression, while columns outside the group are still not decompressed. The codec of the first column of a group is used for the whole group.", 0) \
     M(Bool, load_existing_rows_count_for_old_parts, false, "Whether to load existing_rows_count for existing parts. If false, existing_rows_count will be equal to rows_count for existing parts.", 0) \
+    M(Bool, prewarm_mark_cache, false, "If true, load marks of the most recently modified parts into the mark cache when the table starts up, newest parts first, until the mark cache is almost full. Reduces latency spikes right after a server restart.", 0) \
+    M(Bool, check_consistency_of_outdated_parts_on_startup, true, "Check consistency (existence and sizes of files) of outdated parts when loading them on startup. Can be disabled to speed up startup of tables with a large number of outdated parts.", 0) \
     \
     /** Merge settings. */ \
     M(UInt64, merge_max_block_size, 8192, "How many rows in blocks should be formed for merge operations. By default has the same value as `index_granularity`.", 0) \
@@ -66,6 +70,8 @@ struct Settings;
     M(Bool, fsync_part_directory, false, "Do fsync for part directory after all part operations (writes, renames, etc.).", 0) \
     M(UInt64, non_replicated_deduplication_window, 0, "How many last blocks of hashes should be kept on disk (0 - disabled).", 0) \
     M(UInt64, max_parts_to_merge_at_once, 100, "Max amount of parts which can be merged at once (0 - disabled). Doesn't affect OPTIMIZE FINAL query.", 0) \
+    M(Bool, enable_cost_based_merge_selector, false, "Select parts to merge taking into account per-part read frequency and bytes already expired by column TTL: read-hot parts are compacted more eagerly and merges that drop the most expired data are preferred.", 0) \
+    M(UInt64, shutdown_wait_for_running_merges_seconds, 0, "On shutdown, wait up to this many seconds for already running merges and mutations to finish instead of cancelling them and losing their progress. New merges are not started while waiting. 0 - cancel immediately. Only for non-replicated MergeTree.", 0) \
     M(UInt64, merge_selecting_sleep_ms, 5000, "Maximum sleep time for merge selecting, a lower setting will trigger selecting tasks in background_schedule_pool frequently which result in large amount of requests to zookeeper in large-scale clusters", 0) \
     M(UInt64, max_merge_selecting_sleep_ms, 60000, "Maximum sleep time for merge selecting, a lower setting will trigger selecting tasks in background_schedule_pool frequently which result in large amount of requests to zookeeper in large-scale clusters", 0) \
     M(Float, merge_selecting_sleep_slowdown_factor, 1.2f, "The sleep time for merge selecting task is multiplied by this factor when there's nothing to merge and divided when a merge was assigned", 0) \
@@ -150,6 +156,8 @@ struct Settings;
     M(UInt64, vertical_merge_algorithm_min_bytes_to_activate, 0, "Minimal (approximate) uncompressed size in bytes in merging parts to activate Vertical merge algorithm.", 0) \
     M(UInt64, vertical_merge_algorithm_min_columns_to_activate, 11, "Minimal amount of non-PK columns to activate Vertical merge algorithm.", 0) \
     M(Bool, vertical_merge_remote_filesystem_prefetch, true, "If true prefetching of data from remote filesystem is used for the next column during merge", 0) \
+    M(UInt64, vertical_merge_max_parallel_columns, 1, "If greater than 1, gather up to this many non-PK columns concurrently during Vertical merge. Columns of one Nested structure are still gathered sequentially by one thread because they share the offsets stream.", 0) \
+    M(UInt64, max_stream_finalize_threads, 8, "Maximum number of column file streams of one part to finalize concurrently when the part is written to a remote disk. Finalizing a stream there completes a multipart upload with a synchronous request, so finalizing a wide part with hundreds of columns one stream at a time can take as long as the merge itself. 1 finalizes sequentially.", 0) \
     M(UInt64, max_postpone_time_for_failed_mutations_ms, 5ULL * 60 * 1000, "The maximum postpone time for failed mutations.", 0) \
     \
     /** Compatibility settings */ \
@@ -159,8 +167,11 @@ struct Settings;
     M(Bool, use_minimalistic_part_header_in_zookeeper, true, "Store part header (checksums and columns) in a compact format and a single part znode instead of separate znodes (<part>/columns and <part>/checksums). This can dramatically reduce snapshot size in ZooKeeper. Before enabling check that all replicas support new format.", 0) \
     M(UInt64, finished_mutations_to_keep, 100, "How many records about mutations that are done to keep. If zero, then keep all of them.", 0) \
     M(UInt64, min_merge_bytes_to_use_direct_io, 10ULL * 1024 * 1024 * 1024, "Minimal amount of bytes to enable O_DIRECT in merge (0 - disabled).", 0) \
+    M(UInt64, min_merge_bytes_to_evict_from_page_cache, 10ULL * 1024 * 1024 * 1024, "Minimal amount of bytes in merge to evict the merged part from the OS page cache as it is written, so that big merges do not displace hot data of running queries (0 - disabled). Write-side counterpart of min_merge_bytes_to_use_direct_io.", 0) \
     M(UInt64, index_granularity_bytes, 10 * 1024 * 1024, "Approximate amount of bytes in single granule (0 - disabled).", 0) \
     M(UInt64, min_index_granularity_bytes, 1024, "Minimum amount of bytes in single granule.", 1024) \
+    M(UInt64, merge_index_granularity, 0, "How many rows correspond to one primary key value in parts written by merges. 0 means use index_granularity. Allows keeping freshly inserted parts at a finer granularity for point lookups while merged data gets coarser marks. Has effect only for parts with adaptive granularity.", 0) \
+    M(UInt64, merge_index_granularity_bytes, 0, "Approximate amount of bytes in single granule in parts written by merges. 0 means use index_granularity_bytes. Has effect only for parts with adaptive granularity.", 0) \
     M(Int64, merge_with_ttl_timeout, 3600 * 4, "Minimal time in seconds, when merge with delete TTL can be repeated.", 0) \
     M(Int64, merge_with_recompression_ttl_timeout, 3600 * 4, "Minimal time in seconds, when merge with recompression TTL can be repeated.", 0) \
     M(Bool, ttl_only_drop_parts, false, "Only drop altogether the expired parts and not partially prune them.", 0) \
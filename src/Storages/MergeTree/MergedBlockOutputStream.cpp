@@ -26,7 +26,8 @@ MergedBlockOutputStream::MergedBlockOutputStream(
     bool reset_columns_,
     bool blocks_are_granules_size,
     const WriteSettings & write_settings_,
-    const MergeTreeIndexGranularity & computed_index_granularity)
+    const MergeTreeIndexGranularity & computed_index_granularity,
+    bool is_merge)
     : IMergedBlockOutputStream(data_part->storage.getSettings(), data_part->getDataPartStoragePtr(), metadata_snapshot_, columns_list_, reset_columns_)
     , columns_list(columns_list_)
     , default_codec(default_codec_)
@@ -38,7 +39,8 @@ MergedBlockOutputStream::MergedBlockOutputStream(
         storage_settings,
         data_part->index_granularity_info.mark_type.adaptive,
         /* rewrite_primary_key = */ true,
-        blocks_are_granules_size);
+        blocks_are_granules_size,
+        is_merge);
 
     /// TODO: looks like isStoredOnDisk() is always true for MergeTreeDataPart
     if (data_part->isStoredOnDisk())
@@ -209,6 +211,10 @@ MergedBlockOutputStream::WrittenFiles MergedBlockOutputStream::finalizePartOnDis
     MergeTreeData::DataPart::Checksums & checksums)
 {
     /// NOTE: You do not need to call fsync here, since it will be called later for the all written_files.
+    ///
+    /// Invariant: every file of the part is hashed while it is written (through HashingWriteBuffer
+    /// here and in the writers' streams), so building checksums.txt must never re-read anything
+    /// from disk. Keep it that way when adding new files.
     WrittenFiles written_files;
 
     if (new_part->isProjectionPart())
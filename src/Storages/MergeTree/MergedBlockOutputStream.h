@@ -26,7 +26,8 @@ public:
         bool reset_columns_ = false,
         bool blocks_are_granules_size = false,
         const WriteSettings & write_settings = {},
-        const MergeTreeIndexGranularity & computed_index_granularity = {});
+        const MergeTreeIndexGranularity & computed_index_granularity = {},
+        bool is_merge = false);
 
     Block getHeader() const { return metadata_snapshot->getSampleBlock(); }
 
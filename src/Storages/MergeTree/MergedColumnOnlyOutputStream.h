@@ -2,6 +2,9 @@
 
 #include <Storages/MergeTree/IMergedBlockOutputStream.h>
 #include <Storages/Statistics/Statistics.h>
+#include <IO/WriteSettings.h>
+
+#include <optional>
 
 namespace DB
 {
@@ -23,7 +26,8 @@ public:
         const ColumnsStatistics & stats_to_recalc_,
         WrittenOffsetColumns * offset_columns_ = nullptr,
         const MergeTreeIndexGranularity & index_granularity = {},
-        const MergeTreeIndexGranularityInfo * index_granularity_info_ = nullptr);
+        const MergeTreeIndexGranularityInfo * index_granularity_info_ = nullptr,
+        std::optional<WriteSettings> write_settings_ = std::nullopt);
 
     void write(const Block & block) override;
 
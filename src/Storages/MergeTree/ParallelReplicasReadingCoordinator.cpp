@@ -21,6 +21,7 @@
 #include <Common/Exception.h>
 #include <Common/ProfileEvents.h>
 #include <Common/SipHash.h>
+#include <Common/Stopwatch.h>
 #include <Common/logger_useful.h>
 
 
@@ -210,9 +211,10 @@ using PartRefs = std::deque<Parts::iterator>;
 class DefaultCoordinator : public ParallelReplicasReadingCoordinator::ImplInterface
 {
 public:
-    explicit DefaultCoordinator(size_t replicas_count_, size_t mark_segment_size_)
+    explicit DefaultCoordinator(size_t replicas_count_, size_t mark_segment_size_, bool adaptive_scheduling_)
         : ParallelReplicasReadingCoordinator::ImplInterface(replicas_count_)
         , mark_segment_size(mark_segment_size_)
+        , adaptive_scheduling(adaptive_scheduling_)
         , replica_status(replicas_count_)
         , distribution_by_hash_queue(replicas_count_)
     {
@@ -232,6 +234,9 @@ private:
     /// This many granules will represent a single segment of marks that will be assigned to a replica
     const size_t mark_segment_size{0};
 
+    /// Scale the size of assignments by the observed throughput of each replica (see scaleRequestByThroughput()).
+    const bool adaptive_scheduling{false};
+
     bool state_initialized{false};
     size_t finished_replicas{0};
 
@@ -239,6 +244,12 @@ private:
     {
         bool is_finished{false};
         bool is_announcement_received{false};
+
+        /// For adaptive scheduling: how many marks the replica got last time and how long ago,
+        /// to estimate its throughput relative to the other replicas.
+        Stopwatch time_since_last_assignment;
+        size_t last_assigned_marks{0};
+        double marks_per_second_ewma{0.};
     };
     std::vector<ReplicaStatus> replica_status;
 
@@ -347,6 +358,10 @@ private:
     bool possiblyCanReadPart(size_t replica, const MergeTreePartInfo & info) const;
     void enqueueSegment(const MergeTreePartInfo & info, const MarkRange & segment, size_t owner);
     void enqueueToStealerOrStealingQueue(const MergeTreePartInfo & info, const MarkRange & segment);
+
+    /// Update the replica's throughput estimate and scale the amount of marks it asked for
+    /// proportionally to its throughput relative to the fastest replica.
+    size_t scaleRequestByThroughput(size_t replica_num, size_t min_number_of_marks);
 };
 
 
@@ -743,30 +758,76 @@ size_t DefaultCoordinator::computeConsistentHash(const std::string & part_name,
     return ConsistentHashing(hash.get64(), replicas_count);
 }
 
+size_t DefaultCoordinator::scaleRequestByThroughput(size_t replica_num, size_t min_number_of_marks)
+{
+    auto & status = replica_status[replica_num];
+
+    if (status.last_assigned_marks > 0)
+    {
+        const double elapsed_seconds = std::max(status.time_since_last_assignment.elapsedSeconds(), 1e-6);
+        const double sample = status.last_assigned_marks / elapsed_seconds;
+        /// Weight 1/4 for the new sample to smooth out single fast or slow batches.
+        status.marks_per_second_ewma = status.marks_per_second_ewma > 0. ? status.marks_per_second_ewma * 0.75 + sample * 0.25 : sample;
+    }
+
+    if (status.marks_per_second_ewma <= 0.)
+        return min_number_of_marks;
+
+    double fastest = 0.;
+    for (const auto & other : replica_status)
+        fastest = std::max(fastest, other.marks_per_second_ewma);
+
+    /// Let a slow replica pull a batch proportional to its observed throughput, so that most
+    /// of the remaining work stays in the queues where faster replicas can take or steal it,
+    /// instead of being stranded in a big assignment to the straggler until the end of the query.
+    /// Never hand out less than one segment to keep the request meaningful.
+    const size_t scaled = static_cast<size_t>(min_number_of_marks * (status.marks_per_second_ewma / fastest));
+    return std::clamp(scaled, std::min(mark_segment_size, min_number_of_marks), min_number_of_marks);
+}
+
 ParallelReadResponse DefaultCoordinator::handleRequest(ParallelReadRequest request)
 {
     LOG_TRACE(log, "Handling request from replica {}, minimal marks size is {}", request.replica_num, request.min_number_of_marks);
 
+    size_t min_number_of_marks = request.min_number_of_marks;
+    if (adaptive_scheduling)
+    {
+        min_number_of_marks = scaleRequestByThroughput(request.replica_num, min_number_of_marks);
+        if (min_number_of_marks != request.min_number_of_marks)
+            LOG_TEST(
+                log,
+                "Scaled the request of replica {} from {} to {} marks by its observed throughput",
+                request.replica_num,
+                request.min_number_of_marks,
+                min_number_of_marks);
+    }
+
     ParallelReadResponse response;
 
     size_t current_mark_size = 0;
 
     /// 1. Try to select ranges meant for this replica by consistent hash
     selectPartsAndRanges(
-        request.replica_num, ScanMode::TakeWhatsMineByHash, request.min_number_of_marks, current_mark_size, response.description);
+        request.replica_num, ScanMode::TakeWhatsMineByHash, min_number_of_marks, current_mark_size, response.description);
     const size_t assigned_to_me = current_mark_size;
 
     /// 2. Try to steal but with caching again (with different key)
     selectPartsAndRanges(
-        request.replica_num, ScanMode::TakeWhatsMineForStealing, request.min_number_of_marks, current_mark_size, response.description);
+        request.replica_num, ScanMode::TakeWhatsMineForStealing, min_number_of_marks, current_mark_size, response.description);
     const size_t stolen_by_hash = current_mark_size - assigned_to_me;
 
     /// 3. Try to steal with no preference. We're trying to postpone it as much as possible.
     if (current_mark_size == 0 && request.replica_num == source_replica_for_parts_snapshot)
         selectPartsAndRanges(
-            request.replica_num, ScanMode::TakeEverythingAvailable, request.min_number_of_marks, current_mark_size, response.description);
+            request.replica_num, ScanMode::TakeEverythingAvailable, min_number_of_marks, current_mark_size, response.description);
     const size_t stolen_unassigned = current_mark_size - stolen_by_hash - assigned_to_me;
 
+    if (adaptive_scheduling && current_mark_size > 0)
+    {
+        replica_status[request.replica_num].last_assigned_marks = current_mark_size;
+        replica_status[request.replica_num].time_since_last_assignment.restart();
+    }
+
     stats[request.replica_num].number_of_requests += 1;
     stats[request.replica_num].sum_marks += current_mark_size;
 
@@ -1035,7 +1096,7 @@ void ParallelReplicasReadingCoordinator::initialize(CoordinationMode mode)
     switch (mode)
     {
         case CoordinationMode::Default:
-            pimpl = std::make_unique<DefaultCoordinator>(replicas_count, mark_segment_size);
+            pimpl = std::make_unique<DefaultCoordinator>(replicas_count, mark_segment_size, adaptive_scheduling);
             break;
         case CoordinationMode::WithOrder:
             pimpl = std::make_unique<InOrderCoordinator<CoordinationMode::WithOrder>>(replicas_count);
@@ -1052,8 +1113,8 @@ void ParallelReplicasReadingCoordinator::initialize(CoordinationMode mode)
         pimpl->markReplicaAsUnavailable(replica);
 }
 
-ParallelReplicasReadingCoordinator::ParallelReplicasReadingCoordinator(size_t replicas_count_, size_t mark_segment_size_)
-    : replicas_count(replicas_count_), mark_segment_size(mark_segment_size_)
+ParallelReplicasReadingCoordinator::ParallelReplicasReadingCoordinator(size_t replicas_count_, size_t mark_segment_size_, bool adaptive_scheduling_)
+    : replicas_count(replicas_count_), mark_segment_size(mark_segment_size_), adaptive_scheduling(adaptive_scheduling_)
 {
 }
 
@@ -658,49 +658,58 @@ std::pair<int32_t, int32_t> ReplicatedMergeTreeQueue::pullLogsToQueue(zkutil::Zo
     {
         ::sort(log_entries.begin(), log_entries.end());
 
+        /// Split entries into batches in advance. The batch size grows exponentially,
+        /// so it will saturate to MAX_MULTI_OPS.
+        std::vector<std::pair<size_t, size_t>> batches;
         for (size_t entry_idx = 0, num_entries = log_entries.size(); entry_idx < num_entries;)
         {
-            auto begin = log_entries.begin() + entry_idx;
-            auto end = entry_idx + current_multi_batch_size >= log_entries.size()
-                ? log_entries.end()
-                : (begin + current_multi_batch_size);
-            auto last = end - 1;
+            size_t batch_end = std::min(entry_idx + current_multi_batch_size, num_entries);
+            batches.emplace_back(entry_idx, batch_end);
+            entry_idx = batch_end;
 
-            /// Increment entry_idx before batch size increase (we copied at most current_multi_batch_size entries)
-            entry_idx += current_multi_batch_size;
-
-            /// Increase the batch size exponentially, so it will saturate to MAX_MULTI_OPS.
             if (current_multi_batch_size < MAX_MULTI_OPS)
                 current_multi_batch_size = std::min<size_t>(MAX_MULTI_OPS, current_multi_batch_size * 2);
+        }
+
+        auto schedule_gets = [&](size_t batch_num)
+        {
+            const auto [batch_begin, batch_end] = batches[batch_num];
+            std::vector<std::future<Coordination::GetResponse>> futures;
+            futures.reserve(batch_end - batch_begin);
+
+            for (size_t i = batch_begin; i < batch_end; ++i)
+                futures.push_back(zookeeper->asyncGet(fs::path(zookeeper_path) / "log" / log_entries[i]));
+
+            return futures;
+        };
+
+        auto get_futures = schedule_gets(0);
+
+        for (size_t batch_num = 0; batch_num < batches.size(); ++batch_num)
+        {
+            const auto [batch_begin, batch_end] = batches[batch_num];
+            auto batch_futures = std::move(get_futures);
 
-            String last_entry = *last;
+            const String & last_entry = log_entries[batch_end - 1];
             if (!startsWith(last_entry, "log-"))
                 throw Exception(ErrorCodes::UNEXPECTED_NODE_IN_ZOOKEEPER, "Error in zookeeper data: unexpected node {} in {}/log",
                     last_entry, zookeeper_path);
 
             UInt64 last_entry_index = parse<UInt64>(last_entry.substr(strlen("log-")));
 
-            LOG_DEBUG(log, "Pulling {} entries to queue: {} - {}", (end - begin), *begin, *last);
-
-            Strings get_paths;
-            get_paths.reserve(end - begin);
-
-            for (auto it = begin; it != end; ++it)
-                get_paths.emplace_back(fs::path(zookeeper_path) / "log" / *it);
+            LOG_DEBUG(log, "Pulling {} entries to queue: {} - {}", batch_end - batch_begin, log_entries[batch_begin], last_entry);
 
             /// Simultaneously add all new entries to the queue and move the pointer to the log.
 
             Coordination::Requests ops;
             std::vector<LogEntryPtr> copied_entries;
-            copied_entries.reserve(end - begin);
+            copied_entries.reserve(batch_end - batch_begin);
 
-            std::optional<time_t> min_unprocessed_insert_time_changed;
-
-            auto get_results = zookeeper->get(get_paths);
-            auto get_num = get_results.size();
-            for (size_t i = 0; i < get_num; ++i)
+            /// Wait for the entries of the batch and parse them outside of state_mutex.
+            time_t min_create_time_in_batch = 0;
+            for (auto & future : batch_futures)
             {
-                auto res = get_results[i];
+                auto res = future.get();
 
                 copied_entries.emplace_back(LogEntry::parse(res.data, res.stat, format_version));
 
@@ -710,18 +719,29 @@ std::pair<int32_t, int32_t> ReplicatedMergeTreeQueue::pullLogsToQueue(zkutil::Zo
                 const auto & entry = *copied_entries.back();
                 if (entry.type == LogEntry::GET_PART || entry.type == LogEntry::ATTACH_PART)
                 {
-                    std::lock_guard state_lock(state_mutex);
-                    if (entry.create_time && (!min_unprocessed_insert_time || entry.create_time < min_unprocessed_insert_time))
-                    {
-                        min_unprocessed_insert_time.store(entry.create_time, std::memory_order_relaxed);
-                        min_unprocessed_insert_time_changed = min_unprocessed_insert_time;
-                    }
+                    if (entry.create_time && (!min_create_time_in_batch || entry.create_time < min_create_time_in_batch))
+                        min_create_time_in_batch = entry.create_time;
+                }
+            }
+
+            std::optional<time_t> min_unprocessed_insert_time_changed;
+            if (min_create_time_in_batch)
+            {
+                std::lock_guard state_lock(state_mutex);
+                if (!min_unprocessed_insert_time || min_create_time_in_batch < min_unprocessed_insert_time)
+                {
+                    min_unprocessed_insert_time.store(min_create_time_in_batch, std::memory_order_relaxed);
+                    min_unprocessed_insert_time_changed = min_unprocessed_insert_time;
                 }
             }
 
             ops.emplace_back(zkutil::makeSetRequest(
                 fs::path(replica_path) / "log_pointer", toString(last_entry_index + 1), -1));
 
+            /// Start fetching the next batch while the current one is being committed.
+            if (batch_num + 1 < batches.size())
+                get_futures = schedule_gets(batch_num + 1);
+
             if (min_unprocessed_insert_time_changed)
                 ops.emplace_back(zkutil::makeSetRequest(
                     fs::path(replica_path) / "min_unprocessed_insert_time", toString(*min_unprocessed_insert_time_changed), -1));
@@ -0,0 +1,11 @@
+#include <Storages/MergeTree/SkippingIndexResultCache.h>
+
+namespace DB
+{
+template class CacheBase<UInt128, MarkRanges, UInt128TrivialHash, SkippingIndexResultWeightFunction>;
+
+SkippingIndexResultCache::SkippingIndexResultCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio)
+    : Base(cache_policy, max_size_in_bytes, 0, size_ratio)
+{
+}
+}
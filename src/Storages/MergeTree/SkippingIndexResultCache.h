@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+
+#include <Common/CacheBase.h>
+#include <Common/ProfileEvents.h>
+#include <Common/SipHash.h>
+#include <Common/HashTable/Hash.h>
+#include <Storages/MergeTree/MarkRange.h>
+
+
+namespace ProfileEvents
+{
+    extern const Event SkippingIndexResultCacheHits;
+    extern const Event SkippingIndexResultCacheMisses;
+}
+
+namespace DB
+{
+
+/// Estimate of number of bytes in cache for a filtered set of mark ranges.
+struct SkippingIndexResultWeightFunction
+{
+    /// We spent additional bytes on key in hashmap, linked lists, shared pointers, etc ...
+    static constexpr size_t SKIPPING_INDEX_RESULT_CACHE_OVERHEAD = 128;
+
+    size_t operator()(const MarkRanges & ranges) const
+    {
+        return ranges.size() * sizeof(MarkRange) + SKIPPING_INDEX_RESULT_CACHE_OVERHEAD;
+    }
+};
+
+extern template class CacheBase<UInt128, MarkRanges, UInt128TrivialHash, SkippingIndexResultWeightFunction>;
+/** Cache of the mark ranges left after evaluating a skipping index condition over a data part.
+  * Parts are immutable, so for a fixed (part, index, condition) the result of dropping granules
+  * is deterministic and can be shared between queries. Parts are identified by the total checksum,
+  * so entries of removed or mutated parts simply age out of the LRU.
+  */
+class SkippingIndexResultCache : public CacheBase<UInt128, MarkRanges, UInt128TrivialHash, SkippingIndexResultWeightFunction>
+{
+private:
+    using Base = CacheBase<UInt128, MarkRanges, UInt128TrivialHash, SkippingIndexResultWeightFunction>;
+
+public:
+    SkippingIndexResultCache(const String & cache_policy, size_t max_size_in_bytes, double size_ratio);
+
+    /// Calculate key from part checksum, index name, condition fingerprint and the ranges to filter.
+    /// The seek-coalescing settings participate because they affect how the resulting ranges are glued.
+    static UInt128 hash(
+        const UInt128 & part_checksum,
+        const String & index_name,
+        UInt64 condition_hash,
+        UInt64 min_rows_for_seek,
+        UInt64 min_bytes_for_seek,
+        const MarkRanges & ranges)
+    {
+        SipHash hash;
+        hash.update(part_checksum);
+        hash.update(index_name.data(), index_name.size() + 1);
+        hash.update(condition_hash);
+        hash.update(min_rows_for_seek);
+        hash.update(min_bytes_for_seek);
+        for (const auto & range : ranges)
+        {
+            hash.update(range.begin);
+            hash.update(range.end);
+        }
+        return hash.get128();
+    }
+
+    template <typename LoadFunc>
+    MappedPtr getOrSet(const Key & key, LoadFunc && load)
+    {
+        auto result = Base::getOrSet(key, load);
+        if (result.second)
+            ProfileEvents::increment(ProfileEvents::SkippingIndexResultCacheMisses);
+        else
+            ProfileEvents::increment(ProfileEvents::SkippingIndexResultCacheHits);
+
+        return result.first;
+    }
+};
+
+using SkippingIndexResultCachePtr = std::shared_ptr<SkippingIndexResultCache>;
+
+}
@@ -1,5 +1,8 @@
 #include <Storages/ObjectStorage/StorageObjectStorage.h>
 
+#include <filesystem>
+
+#include <Interpreters/Context.h>
 #include <Formats/FormatFactory.h>
 #include <Parsers/ASTInsertQuery.h>
 #include <Formats/ReadSchemaUtils.h>
@@ -387,6 +390,24 @@ std::pair<ColumnsDescription, std::string> StorageObjectStorage::resolveSchemaAn
     return std::pair(columns, format);
 }
 
+/// If schema_inference_cache_zookeeper_path is set in the config, schema inference results
+/// for object storages are shared between servers through [Zoo]Keeper, so that a cluster
+/// infers the schema of each new file only once.
+static SchemaCache & maybeEnableDistributedSchemaCache(SchemaCache & schema_cache, const ContextPtr & context, const std::string & storage_type_name)
+{
+    auto zookeeper_path = context->getConfigRef().getString("schema_inference_cache_zookeeper_path", "");
+    if (!zookeeper_path.empty())
+    {
+        schema_cache.enableDistributedCache(
+            []
+            {
+                return Context::getGlobalContextInstance()->getZooKeeper();
+            },
+            std::filesystem::path(zookeeper_path) / storage_type_name);
+    }
+    return schema_cache;
+}
+
 SchemaCache & StorageObjectStorage::getSchemaCache(const ContextPtr & context, const std::string & storage_type_name)
 {
     if (storage_type_name == "s3")
@@ -395,7 +416,7 @@ SchemaCache & StorageObjectStorage::getSchemaCache(const ContextPtr & context, c
             context->getConfigRef().getUInt(
                 "schema_inference_cache_max_elements_for_s3",
                 DEFAULT_SCHEMA_CACHE_ELEMENTS));
-        return schema_cache;
+        return maybeEnableDistributedSchemaCache(schema_cache, context, storage_type_name);
     }
     else if (storage_type_name == "hdfs")
     {
@@ -403,7 +424,7 @@ SchemaCache & StorageObjectStorage::getSchemaCache(const ContextPtr & context, c
             context->getConfigRef().getUInt(
                 "schema_inference_cache_max_elements_for_hdfs",
                 DEFAULT_SCHEMA_CACHE_ELEMENTS));
-        return schema_cache;
+        return maybeEnableDistributedSchemaCache(schema_cache, context, storage_type_name);
     }
     else if (storage_type_name == "azure")
     {
@@ -411,7 +432,7 @@ SchemaCache & StorageObjectStorage::getSchemaCache(const ContextPtr & context, c
             context->getConfigRef().getUInt(
                 "schema_inference_cache_max_elements_for_azure",
                 DEFAULT_SCHEMA_CACHE_ELEMENTS));
-        return schema_cache;
+        return maybeEnableDistributedSchemaCache(schema_cache, context, storage_type_name);
     }
     else
         throw Exception(ErrorCodes::NOT_IMPLEMENTED, "Unsupported storage type: {}", storage_type_name);
@@ -121,6 +121,9 @@ S3QueueMetadata::S3QueueMetadata(const fs::path & zookeeper_path_, const S3Queue
     , log(getLogger("StorageS3Queue(" + zookeeper_path_.string() + ")"))
     , local_file_statuses(std::make_shared<LocalFileStatuses>())
 {
+    if (settings.mode == S3QueueMode::ORDERED)
+        max_processed_cache = std::make_shared<S3QueueOrderedFileMetadata::MaxProcessedCache>();
+
     if (settings.mode == S3QueueMode::UNORDERED
         && (settings.s3queue_tracked_files_limit || settings.s3queue_tracked_file_ttl_sec))
     {
@@ -177,7 +180,8 @@ S3QueueMetadata::FileMetadataPtr S3QueueMetadata::getFileMetadata(
                 bucket_info,
                 buckets_num,
                 settings.s3queue_loading_retries,
-                log);
+                log,
+                max_processed_cache);
         case S3QueueMode::UNORDERED:
             return std::make_shared<S3QueueUnorderedFileMetadata>(
                 zookeeper_path,
@@ -89,6 +89,9 @@ private:
 
     class LocalFileStatuses;
     std::shared_ptr<LocalFileStatuses> local_file_statuses;
+
+    /// Only for Ordered mode, shared between all file metadata objects of this table.
+    S3QueueOrderedFileMetadata::MaxProcessedCachePtr max_processed_cache;
 };
 
 }
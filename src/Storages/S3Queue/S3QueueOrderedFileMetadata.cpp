@@ -40,6 +40,28 @@ namespace
     }
 }
 
+bool S3QueueOrderedFileMetadata::MaxProcessedCache::isProcessed(
+    const std::string & processed_node_path_,
+    const std::string & file_path) const
+{
+    std::lock_guard lock(mutex);
+    auto it = max_processed_by_node.find(processed_node_path_);
+    return it != max_processed_by_node.end() && !it->second.empty() && file_path <= it->second;
+}
+
+void S3QueueOrderedFileMetadata::MaxProcessedCache::update(
+    const std::string & processed_node_path_,
+    const std::string & max_processed_file_path)
+{
+    if (max_processed_file_path.empty())
+        return;
+
+    std::lock_guard lock(mutex);
+    auto & current_max_processed = max_processed_by_node[processed_node_path_];
+    if (current_max_processed < max_processed_file_path)
+        current_max_processed = max_processed_file_path;
+}
+
 S3QueueOrderedFileMetadata::BucketHolder::BucketHolder(
     const Bucket & bucket_,
     int bucket_version_,
@@ -94,7 +116,8 @@ S3QueueOrderedFileMetadata::S3QueueOrderedFileMetadata(
     BucketInfoPtr bucket_info_,
     size_t buckets_num_,
     size_t max_loading_retries_,
-    LoggerPtr log_)
+    LoggerPtr log_,
+    MaxProcessedCachePtr max_processed_cache_)
     : S3QueueIFileMetadata(
         path_,
         /* processing_node_path */zk_path_ / "processing" / getNodeName(path_),
@@ -106,6 +129,7 @@ S3QueueOrderedFileMetadata::S3QueueOrderedFileMetadata(
     , buckets_num(buckets_num_)
     , zk_path(zk_path_)
     , bucket_info(bucket_info_)
+    , max_processed_cache(max_processed_cache_)
 {
 }
 
@@ -221,6 +245,14 @@ std::pair<bool, S3QueueIFileMetadata::FileStatus::State> S3QueueOrderedFileMetad
         CHECKED_MAX_PROCESSED_PATH = 6,
     };
 
+    /// If a previously seen max processed file already covers this path,
+    /// the file is processed for sure, no need to go to keeper at all.
+    if (max_processed_cache && max_processed_cache->isProcessed(processed_node_path, path))
+    {
+        LOG_TEST(log, "File {} is already processed according to local max processed cache", path);
+        return {false, FileStatus::State::Processed};
+    }
+
     const auto zk_client = getZooKeeper();
     processing_id = node_metadata.processing_id = getRandomASCIIString(10);
     auto processor_info = getProcessorInfo(processing_id.value());
@@ -235,6 +267,9 @@ std::pair<bool, S3QueueIFileMetadata::FileStatus::State> S3QueueOrderedFileMetad
             LOG_TEST(log, "Current max processed file {} from path: {}",
                         processed_node.file_path, processed_node_path);
 
+            if (max_processed_cache)
+                max_processed_cache->update(processed_node_path, processed_node.file_path);
+
             if (!processed_node.file_path.empty() && path <= processed_node.file_path)
             {
                 return {false, FileStatus::State::Processed};
@@ -331,6 +366,9 @@ void S3QueueOrderedFileMetadata::setProcessedRequests(
         LOG_TEST(log, "Current max processed file: {}, condition less: {}",
                  processed_node.file_path, bool(path <= processed_node.file_path));
 
+        if (max_processed_cache)
+            max_processed_cache->update(processed_node_path_, processed_node.file_path);
+
         if (!processed_node.file_path.empty() && path <= processed_node.file_path)
         {
             LOG_TRACE(log, "File {} is already processed, current max processed file: {}", path, processed_node.file_path);
@@ -384,6 +422,9 @@ void S3QueueOrderedFileMetadata::setProcessedImpl()
         auto code = zk_client->tryMulti(requests, responses);
         if (code == Coordination::Error::ZOK)
         {
+            if (max_processed_cache)
+                max_processed_cache->update(processed_node_path, path);
+
             if (max_loading_retries)
                 zk_client->tryRemove(failed_node_path + ".retriable", -1);
             return;
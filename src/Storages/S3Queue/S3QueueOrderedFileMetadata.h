@@ -3,6 +3,8 @@
 #include <Common/logger_useful.h>
 #include <Common/ZooKeeper/ZooKeeper.h>
 #include <filesystem>
+#include <mutex>
+#include <unordered_map>
 
 namespace DB
 {
@@ -21,6 +23,23 @@ public:
     };
     using BucketInfoPtr = std::shared_ptr<const BucketInfo>;
 
+    /// Process-local cache of the max processed file per "processed" znode.
+    /// In Ordered mode the max processed file path only moves forward, so a stale
+    /// cached value can never mark an unprocessed file as processed, it can only
+    /// miss. Allows to skip a Keeper round trip per file when a listing returns
+    /// mostly already processed files.
+    class MaxProcessedCache
+    {
+    public:
+        bool isProcessed(const std::string & processed_node_path_, const std::string & file_path) const;
+        void update(const std::string & processed_node_path_, const std::string & max_processed_file_path);
+
+    private:
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::string> max_processed_by_node;
+    };
+    using MaxProcessedCachePtr = std::shared_ptr<MaxProcessedCache>;
+
     explicit S3QueueOrderedFileMetadata(
         const std::filesystem::path & zk_path_,
         const std::string & path_,
@@ -28,7 +47,8 @@ public:
         BucketInfoPtr bucket_info_,
         size_t buckets_num_,
         size_t max_loading_retries_,
-        LoggerPtr log_);
+        LoggerPtr log_,
+        MaxProcessedCachePtr max_processed_cache_ = {});
 
     struct BucketHolder;
     using BucketHolderPtr = std::shared_ptr<BucketHolder>;
@@ -50,6 +70,7 @@ private:
     const size_t buckets_num;
     const std::string zk_path;
     const BucketInfoPtr bucket_info;
+    const MaxProcessedCachePtr max_processed_cache;
 
     std::pair<bool, FileStatus::State> setProcessingImpl() override;
     void setProcessedImpl() override;
@@ -7,6 +7,7 @@
 #include <Storages/Statistics/UniqStatistics.h>
 #include <Storages/StatisticsDescription.h>
 #include <Storages/ColumnsDescription.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteHelpers.h>
 #include <Common/Exception.h>
@@ -183,12 +184,33 @@ ColumnStatisticsPtr MergeTreeStatisticsFactory::get(const ColumnStatisticsDescri
     return column_stat;
 }
 
-ColumnsStatistics MergeTreeStatisticsFactory::getMany(const ColumnsDescription & columns) const
+ColumnStatisticsPtr MergeTreeStatisticsFactory::tryGetAuto(const String & column_name, DataTypePtr data_type) const
+{
+    /// The same restriction the tdigest and uniq validators impose on declared statistics.
+    if (!removeNullable(data_type)->isValueRepresentedByNumber())
+        return nullptr;
+
+    ColumnStatisticsDescription desc;
+    desc.column_name = column_name;
+    desc.data_type = data_type;
+    desc.types_to_desc.emplace(StatisticsType::TDigest, SingleStatisticsDescription(StatisticsType::TDigest, nullptr));
+    desc.types_to_desc.emplace(StatisticsType::Uniq, SingleStatisticsDescription(StatisticsType::Uniq, nullptr));
+    return get(desc);
+}
+
+ColumnsStatistics MergeTreeStatisticsFactory::getMany(const ColumnsDescription & columns, bool include_auto) const
 {
     ColumnsStatistics result;
     for (const auto & col : columns)
+    {
         if (!col.statistics.empty())
             result.push_back(get(col.statistics));
+        else if (include_auto)
+        {
+            if (auto stat = tryGetAuto(col.name, col.type))
+                result.push_back(std::move(stat));
+        }
+    }
     return result;
 }
 
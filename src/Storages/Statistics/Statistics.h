@@ -85,7 +85,14 @@ public:
 
     ColumnStatisticsPtr get(const ColumnStatisticsDescription & stats) const;
 
-    ColumnsStatistics getMany(const ColumnsDescription & columns) const;
+    /// Implicit tdigest + uniq statistics for a column without a hand-written STATISTICS declaration,
+    /// used when the auto_statistics merge tree setting is enabled. Returns nullptr if the column
+    /// type is not supported by the statistics.
+    ColumnStatisticsPtr tryGetAuto(const String & column_name, DataTypePtr data_type) const;
+
+    /// Statistics declared in the table definition; with include_auto also implicit statistics
+    /// for the remaining columns of supported types.
+    ColumnsStatistics getMany(const ColumnsDescription & columns, bool include_auto = false) const;
 
     void registerCreator(StatisticsType type, Creator creator);
     void registerValidator(StatisticsType type, Validator validator);
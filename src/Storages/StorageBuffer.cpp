@@ -673,33 +673,51 @@ public:
             least_busy_buffer = &storage.buffers[start_shard_num];
             least_busy_lock = least_busy_buffer->lockForWriting();
         }
-        insertIntoBuffer(block, *least_busy_buffer, metadata_snapshot->metadata_version);
+        bool flush_immediately = insertIntoBuffer(block, *least_busy_buffer, metadata_snapshot->metadata_version);
         least_busy_lock.unlock();
 
-        storage.reschedule();
+        /// If thresholds tripped, wake the background task right away so the buffer
+        /// is written to the destination table outside of the insert path.
+        if (flush_immediately)
+            storage.flush_handle->schedule();
+        else
+            storage.reschedule();
     }
 private:
     StorageBuffer & storage;
     StorageMetadataPtr metadata_snapshot;
 
-    void insertIntoBuffer(const Block & block, StorageBuffer::Buffer & buffer, int32_t metadata_version)
+    /// Returns true if the background flush should be scheduled without delay.
+    bool insertIntoBuffer(const Block & block, StorageBuffer::Buffer & buffer, int32_t metadata_version)
     {
         time_t current_time = time(nullptr);
+        bool schedule_flush = false;
 
         /// Sort the columns in the block. This is necessary to make it easier to concatenate the blocks later.
         Block sorted_block = block.sortColumns();
 
-        if (storage.checkThresholds(buffer, /* direct= */true, current_time, sorted_block.rows(), sorted_block.bytes()) ||
-            buffer.metadata_version != metadata_version)
+        if (buffer.metadata_version != metadata_version)
         {
-            /** If, after inserting the buffer, the constraints are exceeded, then we will reset the buffer.
-              * This also protects against unlimited consumption of RAM, since if it is impossible to write to the table,
-              *  an exception will be thrown, and new data will not be added to the buffer.
-              */
-
+            /// Structure changed: data accumulated under the old metadata cannot be
+            /// concatenated with the new block, flush it inline.
             storage.flushBuffer(buffer, false /* check_thresholds */, true /* locked */);
             buffer.metadata_version = metadata_version;
         }
+        else if (storage.checkThresholds(buffer, /* direct= */true, current_time, sorted_block.rows(), sorted_block.bytes()))
+        {
+            /** If, after inserting the buffer, the constraints are exceeded, the buffer must be reset.
+              * This is normally done by the background task which we wake up after appending, so the
+              * insert does not block on a write to the destination table while holding the shard lock.
+              * Only when the buffer has grown far beyond the limits - meaning background flushes
+              * cannot keep up or the destination table rejects data - we flush synchronously here.
+              * This protects against unlimited consumption of RAM, since if it is impossible to write
+              * to the table, an exception will be thrown, and new data will not be added to the buffer.
+              */
+            if (buffer.data.rows() > storage.max_thresholds.rows * 2 || buffer.data.bytes() > storage.max_thresholds.bytes * 2)
+                storage.flushBuffer(buffer, false /* check_thresholds */, true /* locked */);
+            else
+                schedule_flush = true;
+        }
 
         if (!buffer.first_write_time)
             buffer.first_write_time = current_time;
@@ -711,6 +729,8 @@ private:
 
         storage.total_writes.rows += (buffer.data.rows() - old_rows);
         storage.total_writes.bytes += (buffer.data.allocatedBytes() - old_bytes);
+
+        return schedule_flush;
     }
 };
 
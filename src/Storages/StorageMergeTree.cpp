@@ -174,7 +174,7 @@ void StorageMergeTree::startup()
     }
 }
 
-void StorageMergeTree::shutdown(bool)
+void StorageMergeTree::shutdown(bool is_drop)
 {
     if (shutdown_called.exchange(true))
         return;
@@ -187,6 +187,29 @@ void StorageMergeTree::shutdown(bool)
         mutation_wait_event.notify_all();
     }
 
+    /// Cancelling a merge loses all its progress, so optionally drain the already running
+    /// merges and mutations first. New ones are not scheduled because shutdown_called is set.
+    /// On DROP the results would be thrown away, so there is nothing worth waiting for.
+    if (size_t wait_timeout_seconds = getSettings()->shutdown_wait_for_running_merges_seconds; wait_timeout_seconds && !is_drop)
+    {
+        std::unique_lock lock(currently_processing_in_background_mutex);
+        if (!currently_merging_mutating_parts.empty())
+        {
+            LOG_INFO(log, "Waiting up to {} seconds for running merges and mutations ({} parts participating) to finish before shutdown",
+                wait_timeout_seconds, currently_merging_mutating_parts.size());
+
+            bool finished = currently_processing_in_background_condition.wait_for(
+                lock, std::chrono::seconds(wait_timeout_seconds),
+                [this] { return currently_merging_mutating_parts.empty(); });
+
+            if (finished)
+                LOG_INFO(log, "All running merges and mutations finished");
+            else
+                LOG_INFO(log, "Will cancel merges and mutations of {} parts that did not finish in time, their progress will be lost",
+                    currently_merging_mutating_parts.size());
+        }
+    }
+
     merger_mutator.merges_blocker.cancelForever();
     parts_mover.moves_blocker.cancelForever();
 
@@ -1205,7 +1228,18 @@ MergeMutateSelectedEntryPtr StorageMergeTree::selectPartsToMutate(
     CurrentlyMergingPartsTaggerPtr tagger;
 
     auto mutations_end_it = current_mutations_by_version.end();
-    for (const auto & part : getDataPartsVectorForInternalUsage())
+
+    auto candidate_parts = getDataPartsVectorForInternalUsage();
+
+    /// Mutate the most-read parts first: during long backfills (e.g. MATERIALIZE PROJECTION
+    /// after a bulk load) this makes the hot part of the data fully functional as early as
+    /// possible. Parts that were not read since loading keep their natural order.
+    std::stable_sort(candidate_parts.begin(), candidate_parts.end(), [](const auto & lhs, const auto & rhs)
+    {
+        return lhs->read_hits_count.load(std::memory_order_relaxed) > rhs->read_hits_count.load(std::memory_order_relaxed);
+    });
+
+    for (const auto & part : candidate_parts)
     {
         if (currently_merging_mutating_parts.contains(part))
             continue;
@@ -9,6 +9,10 @@
 #include <Disks/IDisk.h>
 #include <Common/formatReadable.h>
 #include <Common/StringUtils.h>
+#include <Common/ConcurrentBoundedQueue.h>
+#include <Common/CurrentMetrics.h>
+#include <Common/ThreadPool.h>
+#include <Common/getNumberOfPhysicalCPUCores.h>
 #include <Interpreters/Context.h>
 #include <IO/ReadBufferFromFileBase.h>
 #include <Common/logger_useful.h>
@@ -19,6 +23,12 @@
 
 namespace fs = std::filesystem;
 
+namespace CurrentMetrics
+{
+    extern const Metric StorageSetOrJoinRestoreThreads;
+    extern const Metric StorageSetOrJoinRestoreThreadsActive;
+    extern const Metric StorageSetOrJoinRestoreThreadsScheduled;
+}
 
 namespace DB
 {
@@ -266,14 +276,21 @@ void StorageSetOrJoinBase::restore()
         }
     }
 
-    /// Restore in the same order as blocks were written
-    /// It may be important for storage Join, user expect to get the first row (unless `join_any_take_last_row` setting is set)
-    /// but after restart we may have different order of blocks in memory.
+    Strings files_in_order;
+    files_in_order.reserve(backup_files.size());
     while (!backup_files.empty())
     {
-        restoreFromFile(backup_files.top().second);
+        files_in_order.emplace_back(backup_files.top().second);
         backup_files.pop();
     }
+
+    /// Restore in the same order as blocks were written
+    /// It may be important for storage Join, user expect to get the first row (unless `join_any_take_last_row` setting is set)
+    /// but after restart we may have different order of blocks in memory.
+    if (files_in_order.size() > 1)
+        restoreFromFilesParallel(files_in_order);
+    else if (!files_in_order.empty())
+        restoreFromFile(files_in_order.front());
 }
 
 
@@ -299,6 +316,102 @@ void StorageSetOrJoinBase::restoreFromFile(const String & file_path)
 }
 
 
+void StorageSetOrJoinBase::restoreFromFilesParallel(const Strings & file_paths)
+{
+    /// Decompression and deserialization dominate restore time and are independent
+    /// between backup files, so they run in a thread pool. Insertion stays on this
+    /// thread and consumes the files strictly in the order they were written,
+    /// see the comment in restore().
+
+    struct FileRestoreState
+    {
+        explicit FileRestoreState(const String & file_path_) : file_path(file_path_) {}
+
+        String file_path;
+        ConcurrentBoundedQueue<Block> blocks{8};
+        std::exception_ptr exception;
+    };
+
+    std::vector<std::shared_ptr<FileRestoreState>> states;
+    states.reserve(file_paths.size());
+    for (const auto & file_path : file_paths)
+        states.emplace_back(std::make_shared<FileRestoreState>(file_path));
+
+    size_t num_threads = std::min<size_t>(file_paths.size(), getNumberOfPhysicalCPUCores());
+    ThreadPool pool(
+        CurrentMetrics::StorageSetOrJoinRestoreThreads,
+        CurrentMetrics::StorageSetOrJoinRestoreThreadsActive,
+        CurrentMetrics::StorageSetOrJoinRestoreThreadsScheduled,
+        num_threads);
+
+    auto read_file = [this](const std::shared_ptr<FileRestoreState> & state)
+    {
+        try
+        {
+            auto backup_buf = disk->readFile(state->file_path);
+            CompressedReadBuffer compressed_backup_buf(*backup_buf);
+            NativeReader backup_stream(compressed_backup_buf, 0);
+
+            while (Block block = backup_stream.read())
+            {
+                /// Push fails only if the consumer gave up and finished the queue.
+                if (!state->blocks.push(std::move(block)))
+                    break;
+            }
+        }
+        catch (...)
+        {
+            state->exception = std::current_exception();
+        }
+
+        state->blocks.finish();
+    };
+
+    /// Keep only as many files in flight as there are threads to bound memory usage.
+    size_t next_file_to_schedule = 0;
+    try
+    {
+        for (; next_file_to_schedule < num_threads; ++next_file_to_schedule)
+            pool.scheduleOrThrowOnError([&read_file, state = states[next_file_to_schedule]] { read_file(state); });
+
+        ContextPtr ctx = nullptr;
+        for (const auto & state : states)
+        {
+            ProfileInfo info;
+            Block block;
+            while (state->blocks.pop(block))
+            {
+                info.update(block);
+                insertBlock(block, ctx);
+            }
+
+            if (state->exception)
+                std::rethrow_exception(state->exception);
+
+            finishInsert();
+            LOG_INFO(getLogger("StorageSetOrJoinBase"), "Loaded from backup file {}. {} rows, {}. State has {} unique rows.",
+                state->file_path, info.rows, ReadableSize(info.bytes), getSize(ctx));
+
+            if (next_file_to_schedule < states.size())
+            {
+                pool.scheduleOrThrowOnError([&read_file, state = states[next_file_to_schedule]] { read_file(state); });
+                ++next_file_to_schedule;
+            }
+        }
+    }
+    catch (...)
+    {
+        /// Unblock producers that wait on full queues.
+        for (const auto & state : states)
+            state->blocks.clearAndFinish();
+        pool.wait();
+        throw;
+    }
+
+    pool.wait();
+}
+
+
 void StorageSetOrJoinBase::rename(const String & new_path_to_table_data, const StorageID & new_table_id)
 {
     /// Rename directory with data.
@@ -50,6 +50,9 @@ protected:
 
 private:
     void restoreFromFile(const String & file_path);
+    /// Decompress and deserialize several backup files at once, inserting blocks
+    /// strictly in the order the files were written.
+    void restoreFromFilesParallel(const Strings & file_paths);
 
     /// Insert the block into the state.
     virtual void insertBlock(const Block & block, ContextPtr context) = 0;
@@ -87,6 +87,7 @@ void StorageSystemServerSettings::fillData(MutableColumns & res_columns, Context
     if (context->areBackgroundExecutorsInitialized())
     {
         changeable_settings.insert({"background_pool_size", {std::to_string(context->getMergeMutateExecutor()->getMaxThreads()), ChangeableWithoutRestart::IncreaseOnly}});
+        changeable_settings.insert({"background_merges_mutations_concurrency_limit", {std::to_string(context->getMergeMutateExecutor()->getConcurrencyLimit()), ChangeableWithoutRestart::Yes}});
         changeable_settings.insert({"background_move_pool_size", {std::to_string(context->getMovesExecutor()->getMaxThreads()), ChangeableWithoutRestart::IncreaseOnly}});
         changeable_settings.insert({"background_fetches_pool_size", {std::to_string(context->getFetchesExecutor()->getMaxThreads()), ChangeableWithoutRestart::IncreaseOnly}});
         changeable_settings.insert({"background_common_pool_size", {std::to_string(context->getCommonExecutor()->getMaxThreads()), ChangeableWithoutRestart::IncreaseOnly}});
@@ -0,0 +1,109 @@
+DROP TABLE IF EXISTS codec_delta_for;
+
+CREATE TABLE codec_delta_for (
+    key      UInt64,
+    ref_valueU64 UInt64,
+    ref_valueU32 UInt32,
+    ref_valueU16 UInt16,
+    ref_valueU8  UInt8,
+    ref_valueI64 Int64,
+    ref_valueI32 Int32,
+    ref_valueI16 Int16,
+    ref_valueI8  Int8,
+    valueU64 UInt64   CODEC(DeltaFOR),
+    valueU32 UInt32   CODEC(DeltaFOR),
+    valueU16 UInt16   CODEC(DeltaFOR),
+    valueU8  UInt8    CODEC(DeltaFOR),
+    valueI64 Int64    CODEC(DeltaFOR),
+    valueI32 Int32    CODEC(DeltaFOR),
+    valueI16 Int16    CODEC(DeltaFOR),
+    valueI8  Int8     CODEC(DeltaFOR)
+) Engine = MergeTree ORDER BY key SETTINGS min_bytes_for_wide_part = 0, ratio_of_defaults_for_sparse_serialization = 1;
+
+-- checking for overflow: deltas between extreme values wrap around in the unsigned domain
+INSERT INTO codec_delta_for (key, ref_valueU64, valueU64, ref_valueI64, valueI64)
+    VALUES (1, 18446744073709551615, 18446744073709551615, 9223372036854775807, 9223372036854775807), (2, 0, 0, -9223372036854775808, -9223372036854775808), (3, 18446744073709551615, 18446744073709551615, 9223372036854775807, 9223372036854775807);
+
+-- constant stride: frames of bit width 0
+INSERT INTO codec_delta_for (key, ref_valueU64, valueU64, ref_valueU32, valueU32, ref_valueU16, valueU16, ref_valueU8, valueU8, ref_valueI64, valueI64, ref_valueI32, valueI32, ref_valueI16, valueI16, ref_valueI8, valueI8)
+    SELECT number as n, n as v, v, v, v, v, v, v, v, v, v, v, v, v, v, v, v
+    FROM system.numbers LIMIT 101, 1000;
+
+-- random stride: frames of full bit width; 1009 rows leave a partially filled last frame
+INSERT INTO codec_delta_for (key, ref_valueU64, valueU64, ref_valueU32, valueU32, ref_valueU16, valueU16, ref_valueU8, valueU8, ref_valueI64, valueI64, ref_valueI32, valueI32, ref_valueI16, valueI16, ref_valueI8, valueI8)
+    SELECT number as n, n + (rand64() - 9223372036854775807)/1000 as v, v, v, v, v, v, v, v, v, v, v, v, v, v, v, v
+    FROM system.numbers LIMIT 2001, 1009;
+
+SELECT 'U64';
+SELECT
+    key,
+    ref_valueU64, valueU64, ref_valueU64 - valueU64 as dU64
+FROM codec_delta_for
+WHERE
+    dU64 != 0
+LIMIT 10;
+
+SELECT 'U32';
+SELECT
+    key,
+    ref_valueU32, valueU32, ref_valueU32 - valueU32 as dU32
+FROM codec_delta_for
+WHERE
+    dU32 != 0
+LIMIT 10;
+
+SELECT 'U16';
+SELECT
+    key,
+    ref_valueU16, valueU16, ref_valueU16 - valueU16 as dU16
+FROM codec_delta_for
+WHERE
+    dU16 != 0
+LIMIT 10;
+
+SELECT 'U8';
+SELECT
+    key,
+    ref_valueU8, valueU8, ref_valueU8 - valueU8 as dU8
+FROM codec_delta_for
+WHERE
+    dU8 != 0
+LIMIT 10;
+
+SELECT 'I64';
+SELECT
+    key,
+    ref_valueI64, valueI64, ref_valueI64 - valueI64 as dI64
+FROM codec_delta_for
+WHERE
+    dI64 != 0
+LIMIT 10;
+
+SELECT 'I32';
+SELECT
+    key,
+    ref_valueI32, valueI32, ref_valueI32 - valueI32 as dI32
+FROM codec_delta_for
+WHERE
+    dI32 != 0
+LIMIT 10;
+
+SELECT 'I16';
+SELECT
+    key,
+    ref_valueI16, valueI16, ref_valueI16 - valueI16 as dI16
+FROM codec_delta_for
+WHERE
+    dI16 != 0
+LIMIT 10;
+
+SELECT 'I8';
+SELECT
+    key,
+    ref_valueI8, valueI8, ref_valueI8 - valueI8 as dI8
+FROM codec_delta_for
+WHERE
+    dI8 != 0
+LIMIT 10;
+
+DROP TABLE IF EXISTS codec_delta_for;
@@ -0,0 +1,67 @@
+DROP TABLE IF EXISTS codec_gorilla_planar;
+
+SET cross_to_inner_join_rewrite = 1;
+
+CREATE TABLE codec_gorilla_planar (
+    key      UInt64,
+    name     String,
+    ref_valueF64 Float64,
+    ref_valueF32 Float32,
+    valueF64 Float64  CODEC(GorillaPlanar),
+    valueF32 Float32  CODEC(GorillaPlanar)
+) Engine = MergeTree ORDER BY key;
+
+-- best case - same value
+INSERT INTO codec_gorilla_planar (key, name, ref_valueF64, valueF64, ref_valueF32, valueF32)
+	SELECT number AS n, 'e()', e() AS v, v, v, v FROM system.numbers LIMIT 1, 100;
+
+-- good case - values that grow insignificantly
+INSERT INTO codec_gorilla_planar (key, name, ref_valueF64, valueF64, ref_valueF32, valueF32)
+	SELECT number AS n, 'log2(n)', log2(n) AS v, v, v, v FROM system.numbers LIMIT 101, 100;
+
+-- bad case - values differ significantly
+INSERT INTO codec_gorilla_planar (key, name, ref_valueF64, valueF64, ref_valueF32, valueF32)
+	SELECT number AS n, 'n*sqrt(n)', n*sqrt(n) AS v, v, v, v FROM system.numbers LIMIT 201, 100;
+
+-- worst case - almost like a random values
+INSERT INTO codec_gorilla_planar (key, name, ref_valueF64, valueF64, ref_valueF32, valueF32)
+	SELECT number AS n, 'sin(n*n*n)*n', sin(n * n * n * n* n) AS v, v, v, v FROM system.numbers LIMIT 301, 100;
+
+-- special values - zeroes of both signs, subnormals, infinities
+INSERT INTO codec_gorilla_planar (key, name, ref_valueF64, valueF64, ref_valueF32, valueF32)
+	VALUES (401, 'zero', 0, 0, 0, 0), (402, '-zero', -0., -0., -0., -0.), (403, 'denorm', 4.9406564584124654e-324, 4.9406564584124654e-324, 1.401298464324817e-45, 1.401298464324817e-45), (404, 'inf', inf, inf, inf, inf), (405, '-inf', -inf, -inf, -inf, -inf);
+
+
+-- These floating-point values are expected to be BINARY equal, so comparing by-value is Ok here.
+
+-- referencing previous row key, value, and case name to simplify debugging.
+SELECT 'F64';
+SELECT
+	c1.key, c1.name,
+	c1.ref_valueF64, c1.valueF64, c1.ref_valueF64 - c1.valueF64 AS dF64,
+	'prev:',
+	c2.key, c2.ref_valueF64
+FROM
+	codec_gorilla_planar as c1, codec_gorilla_planar as c2
+WHERE
+	dF64 != 0
+AND
+	c2.key = c1.key - 1
+LIMIT 10;
+
+
+SELECT 'F32';
+SELECT
+	c1.key, c1.name,
+	c1.ref_valueF32, c1.valueF32, c1.ref_valueF32 - c1.valueF32 AS dF32,
+	'prev:',
+	c2.key, c2.ref_valueF32
+FROM
+	codec_gorilla_planar as c1, codec_gorilla_planar as c2
+WHERE
+	dF32 != 0
+AND
+	c2.key = c1.key - 1
+LIMIT 10;
+
+DROP TABLE IF EXISTS codec_gorilla_planar;
@@ -0,0 +1,15 @@
+-- Aggregation with an 8-bit key goes through addBatchLookupTable8, which
+-- processes rows in unrolled blocks of 8 with a scalar tail. Check the results
+-- against a plain arithmetic formula for batch sizes that are not multiples of
+-- the unroll factor and for all 256 key values.
+
+SELECT s == intDiv(100002 * 100003, 2), c == 100003 FROM (SELECT toUInt8(0) AS k, sum(number) AS s, count() AS c FROM numbers(100003) GROUP BY k) SETTINGS max_threads = 1;
+
+SELECT count() == 256, sum(k) == 32640, min(c) >= 390, max(c) <= 391, sum(c) == 100003
+FROM (SELECT toUInt8(number % 256) AS k, count() AS c FROM numbers(100003) GROUP BY k);
+
+SELECT count() == 256, sum(s) == intDiv(99999 * 100000, 2)
+FROM (SELECT toUInt8(number) AS k, sum(number) AS s FROM numbers(100000) GROUP BY k);
+
+-- Small batches shorter than one unrolled block.
+SELECT k, c FROM (SELECT toInt8(number - 3) AS k, count() AS c FROM numbers(7) GROUP BY k) ORDER BY k;
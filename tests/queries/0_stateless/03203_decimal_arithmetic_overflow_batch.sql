@@ -0,0 +1,30 @@
+-- Decimal add/sub/mul accumulate the overflow flag over the whole batch and
+-- report it once after the loop. A single overflowing element anywhere in the
+-- batch must still fail the whole block, and blocks without overflow must
+-- produce exact results.
+
+SET decimal_check_overflow = 1;
+
+DROP TABLE IF EXISTS decimal_batch;
+CREATE TABLE decimal_batch (d32 Decimal32(2), d64 Decimal64(4)) ENGINE = Memory;
+INSERT INTO decimal_batch SELECT toDecimal32(number % 1000, 2), toDecimal64(number % 1000, 4) FROM numbers(65536);
+
+-- Exact results over batches with no overflow.
+SELECT sum(d32 + d32) == toDecimal64(2 * (65 * 499500 + intDiv(535 * 536, 2)), 2),
+       sum(d64 - d64) == 0,
+       sum(d32 * 2) == toDecimal64(2 * (65 * 499500 + intDiv(535 * 536, 2)), 2),
+       sum(d64 * d64) != 0
+FROM decimal_batch;
+
+-- A single overflowing element at the very end of the batch fails the block.
+SELECT if(number == 65535, toDecimal128('20000000000000000000', 0), toDecimal128(1, 0)) * toDecimal128('20000000000000000000', 0) FROM numbers(65536) FORMAT Null; -- { serverError DECIMAL_OVERFLOW }
+
+-- Overflow of the scale multiplier during alignment, vector-constant and constant-vector.
+SELECT materialize(toDecimal64(0.42, 18)) + 21 FROM numbers(1000) FORMAT Null; -- { serverError DECIMAL_OVERFLOW }
+SELECT 21 - materialize(toDecimal64(0.42, 18)) FROM numbers(1000) FORMAT Null; -- { serverError DECIMAL_OVERFLOW }
+
+-- With the check disabled the same expression wraps instead of throwing.
+SET decimal_check_overflow = 0;
+SELECT count() FROM (SELECT if(number == 65535, toDecimal128('20000000000000000000', 0), toDecimal128(1, 0)) * toDecimal128('20000000000000000000', 0) AS x FROM numbers(65536));
+
+DROP TABLE decimal_batch;
@@ -0,0 +1,28 @@
+-- Identical UNION ALL branches are executed once and duplicated when
+-- query_plan_merge_identical_union_branches is enabled. Check that the
+-- Duplicating step appears only for identical branches and that results
+-- match the unoptimized execution.
+
+DROP TABLE IF EXISTS union_branches;
+CREATE TABLE union_branches (key UInt32, value UInt32) ENGINE = MergeTree ORDER BY key;
+INSERT INTO union_branches SELECT number, number * 2 FROM numbers(1000);
+
+SET query_plan_merge_identical_union_branches = 1;
+
+-- Identical branches are merged: the plan contains a Duplicating step.
+SELECT count() FROM (EXPLAIN SELECT key FROM union_branches WHERE key < 100 UNION ALL SELECT key FROM union_branches WHERE key < 100) WHERE explain LIKE '%Duplicating%';
+
+-- Different branches are left alone.
+SELECT count() FROM (EXPLAIN SELECT key FROM union_branches WHERE key < 100 UNION ALL SELECT key FROM union_branches WHERE key < 200) WHERE explain LIKE '%Duplicating%';
+
+-- The setting is off by default.
+SELECT count() FROM (EXPLAIN SELECT key FROM union_branches WHERE key < 100 UNION ALL SELECT key FROM union_branches WHERE key < 100) WHERE explain LIKE '%Duplicating%' SETTINGS query_plan_merge_identical_union_branches = 0;
+
+-- Results are unchanged by the rewrite.
+SELECT count(), sum(key) FROM (SELECT key FROM union_branches WHERE key < 100 UNION ALL SELECT key FROM union_branches WHERE key < 100);
+SELECT count(), sum(key) FROM (SELECT key FROM union_branches WHERE key < 100 UNION ALL SELECT key FROM union_branches WHERE key < 100) SETTINGS query_plan_merge_identical_union_branches = 0;
+
+-- A pair of identical branches next to a different one.
+SELECT count(), sum(key) FROM (SELECT key FROM union_branches WHERE key < 100 UNION ALL SELECT key FROM union_branches WHERE key < 100 UNION ALL SELECT key FROM union_branches WHERE key < 50);
+
+DROP TABLE union_branches;
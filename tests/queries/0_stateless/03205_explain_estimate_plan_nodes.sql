@@ -0,0 +1,29 @@
+-- EXPLAIN ESTIMATE plan_nodes = 1 reports per-plan-step estimates instead of
+-- the classic per-table totals. Pin the output columns and the estimates for
+-- the steps whose numbers are derived from exact counters.
+
+DROP TABLE IF EXISTS estimate_t;
+CREATE TABLE estimate_t (key UInt32, value UInt64) ENGINE = MergeTree ORDER BY key;
+INSERT INTO estimate_t SELECT number % 100, number FROM numbers(10000);
+
+-- The classic mode is unchanged.
+SELECT database == currentDatabase(), table, parts, rows FROM (EXPLAIN ESTIMATE SELECT sum(value) FROM estimate_t);
+
+-- Top-down step order; aggregation by key is bounded by the input cardinality,
+-- the read reports the exact number of selected rows.
+SELECT step, estimated_rows, estimated_bytes > 0
+FROM (EXPLAIN ESTIMATE plan_nodes = 1 SELECT sum(value) FROM estimate_t GROUP BY key)
+WHERE step IN ('Aggregating', 'ReadFromMergeTree');
+
+-- LIMIT caps the estimate of its subtree.
+SELECT step, estimated_rows
+FROM (EXPLAIN ESTIMATE plan_nodes = 1 SELECT key FROM estimate_t LIMIT 10)
+WHERE step == 'Limit';
+
+-- An aggregation whose estimated state exceeds the external threshold is
+-- flagged as potentially spilling.
+SELECT step, estimated_memory_bytes > 0, may_spill
+FROM (EXPLAIN ESTIMATE plan_nodes = 1 SELECT sum(value) FROM estimate_t GROUP BY key SETTINGS max_bytes_before_external_group_by = 1)
+WHERE step == 'Aggregating';
+
+DROP TABLE estimate_t;
@@ -0,0 +1,11 @@
+-- With recycle_chunk_buffers enabled, pipeline transforms reuse the column
+-- buffers of exhausted chunks. Results must be identical to a plain run.
+
+SET recycle_chunk_buffers = 1;
+
+SELECT count(), sum(number) FROM (SELECT number FROM numbers_mt(1000000) WHERE number % 3 == 0);
+SELECT count(), sum(number) FROM (SELECT number FROM numbers(100000) WHERE number % 2 == 0);
+
+-- String buffers are the largest win and the easiest thing to corrupt.
+SELECT countDistinct(s), min(s), max(s), sum(length(s))
+FROM (SELECT toString(number) AS s FROM numbers(100000) WHERE number % 2 == 0);
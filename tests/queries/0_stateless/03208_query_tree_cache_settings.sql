@@ -0,0 +1,18 @@
+-- The query tree cache key includes the changed settings: the same query text
+-- analyzed under different analysis-affecting settings must not share a tree.
+
+SET allow_experimental_analyzer = 1;
+SET use_query_tree_cache = 1;
+
+SELECT k, toTypeName(k) FROM (SELECT number % 2 AS k FROM numbers(4) GROUP BY k WITH ROLLUP) ORDER BY k;
+
+SET group_by_use_nulls = 1;
+SELECT k, toTypeName(k) FROM (SELECT number % 2 AS k FROM numbers(4) GROUP BY k WITH ROLLUP) ORDER BY k;
+
+-- Going back must also not pick up the tree analyzed with nulls.
+SET group_by_use_nulls = 0;
+SELECT k, toTypeName(k) FROM (SELECT number % 2 AS k FROM numbers(4) GROUP BY k WITH ROLLUP) ORDER BY k;
+
+SELECT sum(number), toTypeName(sum(number)) FROM numbers(0);
+SET aggregate_functions_null_for_empty = 1;
+SELECT sum(number), toTypeName(sum(number)) FROM numbers(0);
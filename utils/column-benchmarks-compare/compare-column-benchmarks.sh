@@ -0,0 +1,89 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# Compares column kernel micro-benchmark results of two builds and flags regressions.
+#
+# Usage:
+#   compare-column-benchmarks.sh <baseline_binary> <candidate_binary> [benchmark args...]
+#
+# The binaries are the column_kernels targets (see src/Columns/benchmarks) built from
+# the two trees under comparison. Extra arguments are passed to both binaries, e.g.
+# --benchmark_filter=BM_filter. Exits with a non-zero code if any benchmark became
+# slower by more than THRESHOLD percent (3 by default); medians over REPETITIONS
+# runs (5 by default) are compared to reduce noise.
+
+THRESHOLD="${THRESHOLD:-3}"
+REPETITIONS="${REPETITIONS:-5}"
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 <baseline_binary> <candidate_binary> [benchmark args...]" >&2
+    exit 1
+fi
+
+baseline_binary="$1"
+candidate_binary="$2"
+shift 2
+
+baseline_json=$(mktemp)
+candidate_json=$(mktemp)
+trap 'rm -f "$baseline_json" "$candidate_json"' EXIT
+
+run_benchmark()
+{
+    local binary="$1"
+    local out="$2"
+    shift 2
+    "$binary" \
+        --benchmark_repetitions="$REPETITIONS" \
+        --benchmark_report_aggregates_only=true \
+        --benchmark_out_format=json \
+        --benchmark_out="$out" \
+        "$@"
+}
+
+echo "Running baseline $baseline_binary"
+run_benchmark "$baseline_binary" "$baseline_json" "$@"
+echo "Running candidate $candidate_binary"
+run_benchmark "$candidate_binary" "$candidate_json" "$@"
+
+python3 - "$baseline_json" "$candidate_json" "$THRESHOLD" <<'EOF'
+import json
+import sys
+
+baseline_path, candidate_path, threshold = sys.argv[1], sys.argv[2], float(sys.argv[3])
+
+def load_medians(path):
+    with open(path) as f:
+        report = json.load(f)
+    return {
+        b["name"]: b["real_time"]
+        for b in report["benchmarks"]
+        if b.get("aggregate_name") == "median"
+    }
+
+baseline = load_medians(baseline_path)
+candidate = load_medians(candidate_path)
+
+regressions = []
+name_width = max((len(name) for name in baseline), default=4)
+print(f"{'name':{name_width}} {'baseline':>12} {'candidate':>12} {'delta':>8}")
+for name, baseline_time in sorted(baseline.items()):
+    candidate_time = candidate.get(name)
+    if candidate_time is None:
+        print(f"{name:{name_width}} {baseline_time:12.1f} {'-':>12} {'-':>8}")
+        continue
+    delta = (candidate_time - baseline_time) / baseline_time * 100
+    mark = ""
+    if delta > threshold:
+        regressions.append(name)
+        mark = " REGRESSION"
+    print(f"{name:{name_width}} {baseline_time:12.1f} {candidate_time:12.1f} {delta:+7.1f}%{mark}")
+
+for name in sorted(set(candidate) - set(baseline)):
+    print(f"{name:{name_width}} {'-':>12} {candidate[name]:12.1f} {'-':>8}")
+
+if regressions:
+    print(f"\n{len(regressions)} benchmark(s) slower by more than {threshold}%")
+    sys.exit(1)
+print(f"\nNo benchmark slower by more than {threshold}%")
+EOF